@@ -181,8 +181,9 @@ CHIP_ERROR AppTask::RestoreBridgedDevices()
 	uint8_t count;
 	uint8_t indexes[Nrf::BridgeManager::kMaxBridgedDevices] = { 0 };
 	size_t indexesCount = 0;
+	const int64_t startTime = k_uptime_get();
 
-	if (!Nrf::BridgeStorageManager::Instance().LoadBridgedDevicesCount(count)) {
+	if (!Nrf::BridgeStorageManager::Instance().LoadBridgedDevicesCount(count) || count == 0) {
 		LOG_INF("No bridged devices to load from the storage.");
 		return CHIP_NO_ERROR;
 	}
@@ -216,6 +217,10 @@ CHIP_ERROR AppTask::RestoreBridgedDevices()
 							    chip::Optional<uint16_t>(device.mEndpointId));
 #endif
 	}
+
+	LOG_INF("Restored %u bridged devices in %lld ms", static_cast<unsigned>(indexesCount),
+		k_uptime_get() - startTime);
+
 	return CHIP_NO_ERROR;
 }
 #ifdef CONFIG_BRIDGE_SMART_PLUG_SUPPORT
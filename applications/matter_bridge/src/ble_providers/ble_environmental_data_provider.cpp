@@ -112,6 +112,42 @@ CHIP_ERROR BleEnvironmentalDataProvider::UpdateState(chip::ClusterId clusterId,
 	return CHIP_NO_ERROR;
 }
 
+int BleEnvironmentalDataProvider::RestoreDiscoveredData()
+{
+	/* Reuse the temperature and humidity handles and renew the subscriptions. The device is ready once all
+	 * subscriptions are confirmed. */
+	return Subscribe();
+}
+
+int BleEnvironmentalDataProvider::SaveDiscoveredData(uint8_t *data, size_t &size)
+{
+	const uint16_t handles[] = { mTemperatureCharacteristicHandle, mCccTemperatureHandle,
+				     mHumidityCharacteristicHandle, mCccHumidityHandle };
+
+	VerifyOrReturnValue(size >= sizeof(handles), -ENOMEM);
+
+	memcpy(data, handles, sizeof(handles));
+	size = sizeof(handles);
+
+	return 0;
+}
+
+int BleEnvironmentalDataProvider::LoadDiscoveredData(const uint8_t *data, size_t size)
+{
+	uint16_t handles[4];
+
+	VerifyOrReturnValue(size == sizeof(handles), -EINVAL);
+
+	memcpy(handles, data, sizeof(handles));
+	mTemperatureCharacteristicHandle = handles[0];
+	mCccTemperatureHandle = handles[1];
+	mHumidityCharacteristicHandle = handles[2];
+	/* The humidity CCC handle is 0 if the subscription is emulated. */
+	mCccHumidityHandle = handles[3];
+
+	return 0;
+}
+
 int BleEnvironmentalDataProvider::ParseDiscoveredData(bt_gatt_dm *discoveredData)
 {
 	VerifyOrReturnError(CHIP_NO_ERROR == ParseTemperatureCharacteristic(discoveredData), -ENXIO);
@@ -160,37 +196,85 @@ CHIP_ERROR BleEnvironmentalDataProvider::ParseHumidityCharacteristic(bt_gatt_dm
 	return CHIP_NO_ERROR;
 }
 
-void BleEnvironmentalDataProvider::Subscribe()
+void BleEnvironmentalDataProvider::GattSubscribeCallback(bt_conn *conn, uint8_t err, bt_gatt_subscribe_params *params)
+{
+	/* The callback is also called when the subscription is removed. */
+	VerifyOrReturn(params->value);
+
+	BleEnvironmentalDataProvider *provider = GetProvider(conn);
+
+	VerifyOrReturn(provider);
+
+	if (err) {
+		LOG_ERR("Subscription to characteristic %u failed with ATT error %u", params->value_handle, err);
+		provider->NotifyDiscoveredDataRestored(-EIO);
+		return;
+	}
+
+	provider->SubscriptionConfirmed();
+}
+
+void BleEnvironmentalDataProvider::SubscriptionConfirmed()
+{
+	if (atomic_dec(&mPendingSubscriptions) == 1) {
+		NotifyDiscoveredDataRestored(0);
+	}
+}
+
+int BleEnvironmentalDataProvider::SubscribeCharacteristic(bt_gatt_subscribe_params *params)
+{
+	atomic_inc(&mPendingSubscriptions);
+
+	int err = bt_gatt_subscribe(mDevice.mConn, params);
+
+	if (err) {
+		/* The subscription will not be confirmed. */
+		atomic_dec(&mPendingSubscriptions);
+	}
+
+	/* The subscription of the bonded device is renewed by the Bluetooth stack. */
+	return err == -EALREADY ? 0 : err;
+}
+
+int BleEnvironmentalDataProvider::Subscribe()
 {
-	VerifyOrReturn(mDevice.mConn, LOG_ERR("Invalid connection object"));
+	VerifyOrReturnValue(mDevice.mConn, -ENOTCONN, LOG_ERR("Invalid connection object"));
+
+	int ret = 0;
 
 	/* Configure subscription for the temperature characteristic */
 	mGattTemperatureSubscribeParams.ccc_handle = mCccTemperatureHandle;
 	mGattTemperatureSubscribeParams.value_handle = mTemperatureCharacteristicHandle;
 	mGattTemperatureSubscribeParams.value = BT_GATT_CCC_NOTIFY;
 	mGattTemperatureSubscribeParams.notify = BleEnvironmentalDataProvider::GattTemperatureNotifyCallback;
-	mGattTemperatureSubscribeParams.subscribe = nullptr;
+	mGattTemperatureSubscribeParams.subscribe = BleEnvironmentalDataProvider::GattSubscribeCallback;
 
 	/* Configure subscription for the humidity characteristic */
 	mGattHumiditySubscribeParams.ccc_handle = mCccHumidityHandle;
 	mGattHumiditySubscribeParams.value_handle = mHumidityCharacteristicHandle;
 	mGattHumiditySubscribeParams.value = BT_GATT_CCC_NOTIFY;
 	mGattHumiditySubscribeParams.notify = BleEnvironmentalDataProvider::GattHumidityNotifyCallback;
-	mGattHumiditySubscribeParams.subscribe = nullptr;
+	mGattHumiditySubscribeParams.subscribe = BleEnvironmentalDataProvider::GattSubscribeCallback;
+
+	/* The completion is not reported until all subscriptions are requested. */
+	atomic_set(&mPendingSubscriptions, 1);
 
 	if (CheckSubscriptionParameters(&mGattTemperatureSubscribeParams)) {
-		int err = bt_gatt_subscribe(mDevice.mConn, &mGattTemperatureSubscribeParams);
+		int err = SubscribeCharacteristic(&mGattTemperatureSubscribeParams);
 		if (err) {
 			LOG_ERR("Subscribe to temperature characteristic failed with error %d", err);
+			ret = err;
 		}
 	} else {
 		LOG_ERR("Invalid temperature subscription parameters provided");
+		ret = -EINVAL;
 	}
 
 	if (CheckSubscriptionParameters(&mGattHumiditySubscribeParams)) {
-		int err = bt_gatt_subscribe(mDevice.mConn, &mGattHumiditySubscribeParams);
+		int err = SubscribeCharacteristic(&mGattHumiditySubscribeParams);
 		if (err) {
 			LOG_ERR("Subscribe to humidity characteristic failed with error %d", err);
+			ret = ret ? ret : err;
 		}
 	} else {
 		LOG_INF("Invalid humidity subscription parameters provided, starting emulated subscription");
@@ -202,6 +286,12 @@ void BleEnvironmentalDataProvider::Subscribe()
 		sHumidityReadParams.by_uuid.uuid = sUuidHumidity;
 		StartHumidityTimer();
 	}
+
+	if (ret == 0) {
+		SubscriptionConfirmed();
+	}
+
+	return ret;
 }
 
 void BleEnvironmentalDataProvider::Unsubscribe()
@@ -21,13 +21,18 @@ public:
 	CHIP_ERROR UpdateState(chip::ClusterId clusterId, chip::AttributeId attributeId, uint8_t *buffer) override;
 	const bt_uuid *GetServiceUuid() override;
 	int ParseDiscoveredData(bt_gatt_dm *discoveredData) override;
+	int RestoreDiscoveredData() override;
+	int SaveDiscoveredData(uint8_t *data, size_t &size) override;
+	int LoadDiscoveredData(const uint8_t *data, size_t size) override;
 
 private:
 	static constexpr uint32_t kMeasurementsIntervalMs{ CONFIG_BRIDGE_BLE_DEVICE_POLLING_INTERVAL };
 
 	void StartHumidityTimer();
 	void StopHumidityTimer() { k_timer_stop(&mHumidityTimer); }
-	void Subscribe();
+	int Subscribe();
+	int SubscribeCharacteristic(bt_gatt_subscribe_params *params);
+	void SubscriptionConfirmed();
 	void Unsubscribe();
 	bool CheckSubscriptionParameters(bt_gatt_subscribe_params *params);
 
@@ -38,6 +43,7 @@ private:
 						     uint16_t length);
 	static uint8_t GattHumidityNotifyCallback(bt_conn *conn, bt_gatt_subscribe_params *params, const void *data,
 						  uint16_t length);
+	static void GattSubscribeCallback(bt_conn *conn, uint8_t err, bt_gatt_subscribe_params *params);
 	static void NotifyTemperatureAttributeChange(intptr_t context);
 	static void NotifyHumidityAttributeChange(intptr_t context);
 
@@ -58,6 +64,9 @@ private:
 	uint16_t mCccTemperatureHandle{};
 	uint16_t mCccHumidityHandle{};
 
+	/* Number of the subscriptions waiting for the confirmation, increased by one until all are requested. */
+	atomic_t mPendingSubscriptions{};
+
 	k_timer mHumidityTimer;
 
 	static bt_gatt_read_params sHumidityReadParams;
@@ -187,25 +187,83 @@ const bt_uuid *BleLBSDataProvider::GetServiceUuid()
 	return sServiceUuid;
 }
 
-void BleLBSDataProvider::Subscribe()
+void BleLBSDataProvider::GattSubscribeCallback(bt_conn *conn, uint8_t err, bt_gatt_subscribe_params *params)
 {
-	VerifyOrReturn(mDevice.mConn, LOG_ERR("Invalid connection object"));
+	/* The callback is also called when the subscription is removed. */
+	VerifyOrReturn(params->value);
+
+	BleLBSDataProvider *provider = static_cast<BleLBSDataProvider *>(
+		BLEConnectivityManager::Instance().FindBLEProvider(*bt_conn_get_dst(conn)));
+
+	VerifyOrReturn(provider);
+
+	if (err) {
+		LOG_ERR("Subscription to button characteristic failed with ATT error %u", err);
+	}
+
+	provider->NotifyDiscoveredDataRestored(err ? -EIO : 0);
+}
+
+int BleLBSDataProvider::Subscribe()
+{
+	VerifyOrReturnValue(mDevice.mConn, -ENOTCONN, LOG_ERR("Invalid connection object"));
 
 	/* Configure subscription for the button characteristic */
 	mGattSubscribeParams.ccc_handle = mCccHandle;
 	mGattSubscribeParams.value_handle = mButtonCharacteristicHandle;
 	mGattSubscribeParams.value = BT_GATT_CCC_NOTIFY;
 	mGattSubscribeParams.notify = BleLBSDataProvider::GattNotifyCallback;
-	mGattSubscribeParams.subscribe = nullptr;
+	mGattSubscribeParams.subscribe = BleLBSDataProvider::GattSubscribeCallback;
 
-	if (CheckSubscriptionParameters(&mGattSubscribeParams)) {
-		int err = bt_gatt_subscribe(mDevice.mConn, &mGattSubscribeParams);
-		if (err) {
-			LOG_ERR("Subscribe to button characteristic failed with error %d", err);
-		}
-	} else {
-		LOG_ERR("Invalid button subscription parameters provided");
+	VerifyOrReturnValue(CheckSubscriptionParameters(&mGattSubscribeParams), -EINVAL,
+			    LOG_ERR("Invalid button subscription parameters provided"));
+
+	int err = bt_gatt_subscribe(mDevice.mConn, &mGattSubscribeParams);
+
+	if (err == -EALREADY) {
+		/* The subscription of the bonded device is renewed by the Bluetooth stack. */
+		NotifyDiscoveredDataRestored(0);
+		return 0;
+	}
+
+	if (err) {
+		LOG_ERR("Subscribe to button characteristic failed with error %d", err);
 	}
+
+	return err;
+}
+
+int BleLBSDataProvider::RestoreDiscoveredData()
+{
+	/* The LED and button handles are still valid, only the button notifications need to be enabled again. The
+	 * device is ready once the subscription is confirmed. */
+	return Subscribe();
+}
+
+int BleLBSDataProvider::SaveDiscoveredData(uint8_t *data, size_t &size)
+{
+	const uint16_t handles[] = { mLedCharacteristicHandle, mButtonCharacteristicHandle, mCccHandle };
+
+	VerifyOrReturnValue(size >= sizeof(handles), -ENOMEM);
+
+	memcpy(data, handles, sizeof(handles));
+	size = sizeof(handles);
+
+	return 0;
+}
+
+int BleLBSDataProvider::LoadDiscoveredData(const uint8_t *data, size_t size)
+{
+	uint16_t handles[3];
+
+	VerifyOrReturnValue(size == sizeof(handles), -EINVAL);
+
+	memcpy(handles, data, sizeof(handles));
+	mLedCharacteristicHandle = handles[0];
+	mButtonCharacteristicHandle = handles[1];
+	mCccHandle = handles[2];
+
+	return 0;
 }
 
 int BleLBSDataProvider::ParseDiscoveredData(bt_gatt_dm *discoveredData)
@@ -32,12 +32,16 @@ public:
 	static void GattWriteCallback(bt_conn *conn, uint8_t err, bt_gatt_write_params *params);
 	static uint8_t GattNotifyCallback(bt_conn *conn, bt_gatt_subscribe_params *params, const void *data,
 					  uint16_t length);
+	static void GattSubscribeCallback(bt_conn *conn, uint8_t err, bt_gatt_subscribe_params *params);
 
 	const bt_uuid *GetServiceUuid() override;
 	int ParseDiscoveredData(bt_gatt_dm *discoveredData) override;
+	int RestoreDiscoveredData() override;
+	int SaveDiscoveredData(uint8_t *data, size_t &size) override;
+	int LoadDiscoveredData(const uint8_t *data, size_t size) override;
 
 private:
-	void Subscribe();
+	int Subscribe();
 	bool CheckSubscriptionParameters(bt_gatt_subscribe_params *params);
 
 	bool mOnOff = false;
@@ -8,6 +8,7 @@
 #include "platform/ConfigurationManager.h"
 
 #ifdef CONFIG_BRIDGED_DEVICE_BT
+#include "ble_bridged_device.h"
 #include "ble_bridged_device_factory.h"
 #include "ble_connectivity_manager.h"
 #else
@@ -125,6 +126,50 @@ static int RemoveBridgedDeviceHandler(const struct shell *shell, size_t argc, ch
 	return 0;
 }
 
+#ifdef CONFIG_BRIDGE_ATTRIBUTE_CACHE
+static int AttributeCacheStatsHandler(const struct shell *shell, size_t argc, char **argv)
+{
+	Nrf::BridgeManager::AttributeCacheStats stats;
+	const bool reset = argc > 1 && strcmp(argv[1], "reset") == 0;
+
+	Nrf::BridgeManager::Instance().GetAttributeCacheStats(stats, reset);
+
+	const uint32_t reads = stats.mHits + stats.mMisses;
+
+	shell_fprintf(shell, SHELL_INFO, "Attribute reads: %u\n", reads);
+	shell_fprintf(shell, SHELL_INFO, "Cache hits: %u (%u%%)\n", stats.mHits,
+		      reads ? static_cast<uint32_t>((100ull * stats.mHits) / reads) : 0);
+	shell_fprintf(shell, SHELL_INFO, "Cache misses: %u\n", stats.mMisses);
+	shell_fprintf(shell, SHELL_INFO, "Cache invalidations: %u\n", stats.mInvalidations);
+
+	return 0;
+}
+#endif /* CONFIG_BRIDGE_ATTRIBUTE_CACHE */
+
+#ifdef CONFIG_BRIDGED_DEVICE_SIMULATED
+static int PopulateBridgedDevicesHandler(const struct shell *shell, size_t argc, char **argv)
+{
+	int deviceType = strtoul(argv[1], NULL, 0);
+	size_t added = 0;
+	char uniqueID[chip::DeviceLayer::ConfigurationManager::kMaxUniqueIDLength];
+
+	/* Add devices until the bridge is full, to measure the restore time after the reboot. */
+	while (true) {
+		chip::DeviceLayer::ConfigurationMgrImpl().GenerateUniqueId(uniqueID, sizeof(uniqueID));
+
+		if (SimulatedBridgedDeviceFactory::CreateDevice(deviceType, uniqueID, nullptr) != CHIP_NO_ERROR) {
+			break;
+		}
+
+		added++;
+	}
+
+	shell_fprintf(shell, SHELL_INFO, "Added %u bridged devices\n", static_cast<unsigned>(added));
+
+	return 0;
+}
+#endif /* CONFIG_BRIDGED_DEVICE_SIMULATED */
+
 #ifdef CONFIG_BRIDGED_DEVICE_SIMULATED_ONOFF_SHELL
 static int SimulatedBridgedDeviceOnOffWriteHandler(const struct shell *shell, size_t argc, char **argv)
 {
@@ -231,6 +276,32 @@ static int InsertBridgedDevicePincodeHandler(const struct shell *shell, size_t a
 }
 #endif /* CONFIG_BT_SMP */
 
+static int ConnectionMetricsHandler(const struct shell *shell, size_t argc, char **argv)
+{
+	shell_fprintf(shell, SHELL_INFO, "Connection metrics:\n");
+	shell_fprintf(shell, SHELL_INFO, "-------------------------------------------------------------------------\n");
+	shell_fprintf(shell, SHELL_INFO, "|      Address      | Connect (ms) | Ready (ms) | Ready max (ms) | Cached \n");
+	shell_fprintf(shell, SHELL_INFO, "-------------------------------------------------------------------------\n");
+
+	for (uint8_t i = 0; i < Nrf::BLEConnectivityManager::kMaxConnectedDevices; i++) {
+		Nrf::BLEBridgedDeviceProvider *provider = Nrf::BLEConnectivityManager::Instance().GetBLEProvider(i);
+
+		if (!provider) {
+			continue;
+		}
+
+		const bt_addr_le_t address = provider->GetBtAddress();
+		const Nrf::BLEConnectionMetrics &metrics = provider->GetConnectionMetrics();
+
+		shell_fprintf(shell, SHELL_INFO, "| %02x:%02x:%02x:%02x:%02x:%02x | %12u | %10u | %14u | %u/%u\n",
+			      address.a.val[5], address.a.val[4], address.a.val[3], address.a.val[2],
+			      address.a.val[1], address.a.val[0], metrics.mConnectTimeMs, metrics.mTimeToReadyMs,
+			      metrics.mTimeToReadyMaxMs, metrics.mDiscoveryCacheHits, metrics.mReadyCount);
+	}
+
+	return 0;
+}
+
 static int ScanBridgedDeviceHandler(const struct shell *shell, size_t argc, char **argv)
 {
 	shell_fprintf(shell, SHELL_INFO, "Scanning for %d s ...\n", CONFIG_BRIDGE_BT_SCAN_TIMEOUT_MS / 1000);
@@ -265,6 +336,20 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 		"Usage: remove <bridged_device_endpoint_id>\n"
 		"* bridged_device_endpoint_id - the bridged device's endpoint on which it was previously created\n",
 		RemoveBridgedDeviceHandler, 2, 0),
+#ifdef CONFIG_BRIDGE_ATTRIBUTE_CACHE
+	SHELL_CMD_ARG(cache_stats, NULL,
+		      "Prints the attribute read cache statistics. \n"
+		      "Usage: cache_stats [reset]\n"
+		      "* reset - the optional argument to reset the statistics after printing them\n",
+		      AttributeCacheStatsHandler, 1, 1),
+#endif /* CONFIG_BRIDGE_ATTRIBUTE_CACHE */
+#ifdef CONFIG_BRIDGED_DEVICE_SIMULATED
+	SHELL_CMD_ARG(populate, NULL,
+		      "Adds bridged devices of the given type until the maximum number of bridged devices is reached. \n"
+		      "Usage: populate <bridged_device_type>\n"
+		      "* bridged_device_type - the bridged device's type, e.g. 256 - OnOff Light\n",
+		      PopulateBridgedDevicesHandler, 2, 0),
+#endif /* CONFIG_BRIDGED_DEVICE_SIMULATED */
 #ifdef CONFIG_BRIDGED_DEVICE_SIMULATED_ONOFF_SHELL
 	SHELL_CMD_ARG(
 		onoff, NULL,
@@ -284,6 +369,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 		SimulatedBridgedDeviceOnOffLightSwitchWriteHandler, 3, 0),
 #endif
 #ifdef CONFIG_BRIDGED_DEVICE_BT
+	SHELL_CMD_ARG(metrics, NULL,
+		      "Prints the connection metrics of the bridged Bluetooth LE devices. \n"
+		      "Usage: metrics\n",
+		      ConnectionMetricsHandler, 1, 0),
 	SHELL_CMD_ARG(scan, NULL,
 		      "Scan for Bluetooth LE devices to bridge. \n"
 		      "Usage: scan\n",
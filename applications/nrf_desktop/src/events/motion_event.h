@@ -25,6 +25,9 @@ struct motion_event {
 
 	int16_t dx;
 	int16_t dy;
+
+	/* Time of input sampling (hardware cycles, see k_cycle_get_32). */
+	uint32_t timestamp;
 };
 
 APP_EVENT_TYPE_DECLARE(motion_event);
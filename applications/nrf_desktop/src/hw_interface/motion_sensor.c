@@ -51,6 +51,7 @@ struct sensor_state {
 
 	enum state state;
 	bool sample;
+	uint32_t sample_ts;
 	uint8_t peer_count;
 	uint32_t option[MOTION_SENSOR_OPTION_COUNT];
 	uint32_t option_mask;
@@ -192,6 +193,7 @@ static void data_ready_handler(const struct device *dev, const struct sensor_tri
 	case STATE_IDLE:
 		state.state = STATE_FETCHING;
 		state.sample = true;
+		state.sample_ts = k_cycle_get_32();
 		/* Fall-through */
 
 	case STATE_DISCONNECTED:
@@ -223,7 +225,7 @@ static void data_ready_handler(const struct device *dev, const struct sensor_tri
 	k_spin_unlock(&state.lock, key);
 }
 
-static int motion_read(bool send_event)
+static int motion_read(bool send_event, uint32_t sample_ts)
 {
 	struct sensor_value value_x;
 	struct sensor_value value_y;
@@ -260,6 +262,7 @@ static int motion_read(bool send_event)
 
 	event->dx = value_x.val1;
 	event->dy = value_y.val1;
+	event->timestamp = sample_ts;
 	APP_EVENT_SUBMIT(event);
 
 	return err;
@@ -480,17 +483,19 @@ static void motion_thread_fn(void)
 
 	while (!err) {
 		bool send_event;
+		uint32_t sample_ts;
 		uint32_t option_bm;
 
 		k_sem_take(&sem, K_FOREVER);
 
 		k_spinlock_key_t key = k_spin_lock(&state.lock);
 		send_event = (state.state == STATE_FETCHING) && state.sample;
+		sample_ts = state.sample_ts;
 		state.sample = false;
 		option_bm = state.option_mask;
 		k_spin_unlock(&state.lock, key);
 
-		err = motion_read(send_event);
+		err = motion_read(send_event, sample_ts);
 
 		bool no_motion = (err == -ENODATA);
 		if (unlikely(no_motion)) {
@@ -545,6 +550,7 @@ static bool app_event_handler(const struct app_event_header *aeh)
 			k_spinlock_key_t key = k_spin_lock(&state.lock);
 			if (state.state == STATE_FETCHING) {
 				state.sample = true;
+				state.sample_ts = k_cycle_get_32();
 				k_sem_give(&sem);
 			}
 			k_spin_unlock(&state.lock, key);
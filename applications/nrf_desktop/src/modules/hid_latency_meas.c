@@ -0,0 +1,428 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+#include <nrf_profiler.h>
+
+#include "motion_event.h"
+#include "hid_event.h"
+#include "config_event.h"
+
+#define MODULE hid_latency_meas
+#include <caf/events/module_state_event.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(MODULE, CONFIG_DESKTOP_HID_LATENCY_MEAS_LOG_LEVEL);
+
+#define SUBSCRIBER_COUNT	CONFIG_DESKTOP_HID_LATENCY_MEAS_SUBSCRIBER_COUNT
+#define INFLIGHT_MAX		CONFIG_DESKTOP_HID_LATENCY_MEAS_INFLIGHT_MAX
+#define HIST_BUCKET_COUNT	CONFIG_DESKTOP_HID_LATENCY_MEAS_BUCKET_COUNT
+
+#define PROFILER_EVENT_NAME	"hid_latency"
+
+/* Bucket i gathers samples from range [2^(i-1), 2^i) us. Bucket 0 gathers 0 us samples and the
+ * last bucket gathers all of the samples that do not fit in the previous buckets.
+ */
+BUILD_ASSERT(HIST_BUCKET_COUNT <= 32);
+
+enum stage {
+	STAGE_INPUT,
+	STAGE_QUEUE,
+	STAGE_SEND,
+	STAGE_TOTAL,
+
+	STAGE_COUNT
+};
+
+enum latency_opt {
+	LATENCY_OPT_INPUT,
+	LATENCY_OPT_QUEUE,
+	LATENCY_OPT_SEND,
+	LATENCY_OPT_TOTAL,
+	LATENCY_OPT_RESET,
+
+	LATENCY_OPT_COUNT
+};
+
+static const char * const opt_descr[] = {
+	[LATENCY_OPT_INPUT] = "input",
+	[LATENCY_OPT_QUEUE] = "queue",
+	[LATENCY_OPT_SEND] = "send",
+	[LATENCY_OPT_TOTAL] = "total",
+	[LATENCY_OPT_RESET] = "reset",
+};
+
+BUILD_ASSERT(ARRAY_SIZE(opt_descr) == LATENCY_OPT_COUNT);
+
+struct latency_hist {
+	uint32_t bucket[HIST_BUCKET_COUNT];
+	uint32_t count;
+	uint32_t max_us;
+};
+
+struct inflight_report {
+	uint32_t input_ts;
+	uint32_t handled_ts;
+	uint32_t submit_ts;
+	uint8_t report_id;
+	bool has_input;
+};
+
+struct subscriber_data {
+	const void *id;
+	struct inflight_report report[INFLIGHT_MAX];
+	uint8_t head;
+	uint8_t count;
+};
+
+struct pending_input {
+	uint32_t input_ts;
+	uint32_t handled_ts;
+	bool valid;
+};
+
+static struct latency_hist hist[STAGE_COUNT];
+static struct subscriber_data subscribers[SUBSCRIBER_COUNT];
+static struct pending_input pending_input;
+static uint16_t profiler_event_id;
+
+
+static bool is_mouse_report(uint8_t report_id)
+{
+	return (report_id == REPORT_ID_MOUSE) || (report_id == REPORT_ID_BOOT_MOUSE);
+}
+
+static uint32_t cyc_diff_to_us(uint32_t from, uint32_t to)
+{
+	/* Unsigned arithmetic handles cycle counter overflow. */
+	return k_cyc_to_us_floor32(to - from);
+}
+
+static size_t us_to_bucket(uint32_t us)
+{
+	size_t idx = (us == 0) ? 0 : (32 - __builtin_clz(us));
+
+	return MIN(idx, HIST_BUCKET_COUNT - 1);
+}
+
+static uint32_t bucket_upper_bound_us(size_t idx)
+{
+	if (idx == HIST_BUCKET_COUNT - 1) {
+		return UINT32_MAX;
+	}
+
+	return BIT(idx) - 1;
+}
+
+static void hist_add(struct latency_hist *h, uint32_t us)
+{
+	h->bucket[us_to_bucket(us)]++;
+	h->count++;
+	h->max_us = MAX(h->max_us, us);
+}
+
+static uint32_t hist_percentile_us(const struct latency_hist *h, uint8_t percentile)
+{
+	if (h->count == 0) {
+		return 0;
+	}
+
+	/* Rounded up to make sure that the requested part of samples is covered. */
+	uint64_t threshold = DIV_ROUND_UP((uint64_t)h->count * percentile, 100);
+	uint64_t cnt = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(h->bucket); i++) {
+		cnt += h->bucket[i];
+
+		if (cnt >= threshold) {
+			return MIN(bucket_upper_bound_us(i), h->max_us);
+		}
+	}
+
+	return h->max_us;
+}
+
+static void reset_stats(void)
+{
+	memset(hist, 0, sizeof(hist));
+	LOG_INF("Latency statistics reset");
+}
+
+static struct subscriber_data *get_subscriber(const void *id, bool alloc)
+{
+	struct subscriber_data *free_slot = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(subscribers); i++) {
+		if (subscribers[i].id == id) {
+			return &subscribers[i];
+		}
+
+		if (!free_slot && !subscribers[i].id) {
+			free_slot = &subscribers[i];
+		}
+	}
+
+	if (alloc && free_slot) {
+		free_slot->id = id;
+		free_slot->head = 0;
+		free_slot->count = 0;
+		return free_slot;
+	}
+
+	return NULL;
+}
+
+static void profile_latency(uint8_t report_id, const uint32_t *stage_us)
+{
+	if (!IS_ENABLED(CONFIG_NRF_PROFILER) || !is_profiling_enabled(profiler_event_id)) {
+		return;
+	}
+
+	struct log_event_buf buf;
+
+	nrf_profiler_log_start(&buf);
+	nrf_profiler_log_encode_uint8(&buf, report_id);
+	for (size_t i = 0; i < STAGE_COUNT; i++) {
+		nrf_profiler_log_encode_uint32(&buf, stage_us[i]);
+	}
+	nrf_profiler_log_send(&buf, profiler_event_id);
+}
+
+static void register_profiler_event(void)
+{
+	static const char * const arg_names[] = {
+		"report_id", "input_us", "queue_us", "send_us", "total_us"
+	};
+	static const enum nrf_profiler_arg arg_types[] = {
+		NRF_PROFILER_ARG_U8, NRF_PROFILER_ARG_U32, NRF_PROFILER_ARG_U32,
+		NRF_PROFILER_ARG_U32, NRF_PROFILER_ARG_U32
+	};
+
+	BUILD_ASSERT(ARRAY_SIZE(arg_names) == ARRAY_SIZE(arg_types));
+	BUILD_ASSERT(ARRAY_SIZE(arg_names) == STAGE_COUNT + 1);
+
+	profiler_event_id = nrf_profiler_register_event_type(PROFILER_EVENT_NAME, arg_names,
+							     arg_types, ARRAY_SIZE(arg_names));
+}
+
+static void handle_motion_event(const struct motion_event *event)
+{
+	/* Report latency is measured from the oldest input that is not yet part of a report. */
+	if (!pending_input.valid) {
+		pending_input.input_ts = event->timestamp;
+		pending_input.handled_ts = k_cycle_get_32();
+		pending_input.valid = true;
+	}
+}
+
+static void handle_hid_report_event(const struct hid_report_event *event)
+{
+	uint8_t report_id = event->dyndata.data[0];
+
+	if (!is_mouse_report(report_id)) {
+		return;
+	}
+
+	struct subscriber_data *sub = get_subscriber(event->subscriber, true);
+
+	if (!sub) {
+		LOG_WRN("No space to track subscriber %p", event->subscriber);
+		return;
+	}
+
+	if (sub->count == ARRAY_SIZE(sub->report)) {
+		/* Subscriber did not confirm the reports. Start tracking from scratch. */
+		LOG_WRN("In-flight report tracking overflow");
+		sub->head = 0;
+		sub->count = 0;
+	}
+
+	struct inflight_report *rep =
+		&sub->report[(sub->head + sub->count) % ARRAY_SIZE(sub->report)];
+
+	rep->report_id = report_id;
+	rep->submit_ts = k_cycle_get_32();
+	rep->has_input = pending_input.valid;
+	rep->input_ts = pending_input.input_ts;
+	rep->handled_ts = pending_input.handled_ts;
+	sub->count++;
+
+	pending_input.valid = false;
+}
+
+static void handle_hid_report_sent_event(const struct hid_report_sent_event *event)
+{
+	if (!is_mouse_report(event->report_id)) {
+		return;
+	}
+
+	struct subscriber_data *sub = get_subscriber(event->subscriber, false);
+
+	if (!sub || (sub->count == 0)) {
+		return;
+	}
+
+	struct inflight_report *rep = &sub->report[sub->head];
+
+	sub->head = (sub->head + 1) % ARRAY_SIZE(sub->report);
+	sub->count--;
+
+	if (rep->report_id != event->report_id) {
+		LOG_WRN("Report sequence mismatch, drop sample");
+		return;
+	}
+
+	if (event->error) {
+		return;
+	}
+
+	uint32_t now = k_cycle_get_32();
+	uint32_t stage_us[STAGE_COUNT] = {0};
+
+	stage_us[STAGE_SEND] = cyc_diff_to_us(rep->submit_ts, now);
+	hist_add(&hist[STAGE_SEND], stage_us[STAGE_SEND]);
+
+	if (rep->has_input) {
+		stage_us[STAGE_INPUT] = cyc_diff_to_us(rep->input_ts, rep->handled_ts);
+		stage_us[STAGE_QUEUE] = cyc_diff_to_us(rep->handled_ts, rep->submit_ts);
+		stage_us[STAGE_TOTAL] = cyc_diff_to_us(rep->input_ts, now);
+
+		hist_add(&hist[STAGE_INPUT], stage_us[STAGE_INPUT]);
+		hist_add(&hist[STAGE_QUEUE], stage_us[STAGE_QUEUE]);
+		hist_add(&hist[STAGE_TOTAL], stage_us[STAGE_TOTAL]);
+	}
+
+	profile_latency(event->report_id, stage_us);
+}
+
+static void handle_hid_report_subscriber_event(const struct hid_report_subscriber_event *event)
+{
+	if (event->connected) {
+		return;
+	}
+
+	struct subscriber_data *sub = get_subscriber(event->subscriber, false);
+
+	if (sub) {
+		sub->id = NULL;
+		sub->head = 0;
+		sub->count = 0;
+	}
+}
+
+static void update_config(const uint8_t opt_id, const uint8_t *data, const size_t size)
+{
+	switch (opt_id) {
+	case LATENCY_OPT_RESET:
+		reset_stats();
+		break;
+
+	default:
+		LOG_WRN("Unsupported set opt_id: %" PRIu8, opt_id);
+		break;
+	}
+}
+
+static void fetch_config(const uint8_t opt_id, uint8_t *data, size_t *size)
+{
+	static const uint8_t opt_2_stage[] = {
+		[LATENCY_OPT_INPUT] = STAGE_INPUT,
+		[LATENCY_OPT_QUEUE] = STAGE_QUEUE,
+		[LATENCY_OPT_SEND] = STAGE_SEND,
+		[LATENCY_OPT_TOTAL] = STAGE_TOTAL,
+	};
+
+	if (opt_id >= ARRAY_SIZE(opt_2_stage)) {
+		LOG_WRN("Unsupported fetch opt_id: %" PRIu8, opt_id);
+		return;
+	}
+
+	const struct latency_hist *h = &hist[opt_2_stage[opt_id]];
+	size_t pos = 0;
+
+	BUILD_ASSERT(4 * sizeof(uint32_t) <= CONFIG_CHANNEL_FETCHED_DATA_MAX_SIZE);
+
+	/* Sample count, p50, p99 and maximum latency in microseconds. */
+	sys_put_le32(h->count, &data[pos]);
+	pos += sizeof(uint32_t);
+	sys_put_le32(hist_percentile_us(h, 50), &data[pos]);
+	pos += sizeof(uint32_t);
+	sys_put_le32(hist_percentile_us(h, 99), &data[pos]);
+	pos += sizeof(uint32_t);
+	sys_put_le32(h->max_us, &data[pos]);
+	pos += sizeof(uint32_t);
+
+	*size = pos;
+}
+
+static void init(void)
+{
+	static bool initialized;
+
+	__ASSERT_NO_MSG(!initialized);
+	initialized = true;
+
+	register_profiler_event();
+	module_set_state(MODULE_STATE_READY);
+}
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_motion_event(aeh)) {
+		handle_motion_event(cast_motion_event(aeh));
+
+		return false;
+	}
+
+	if (is_hid_report_event(aeh)) {
+		handle_hid_report_event(cast_hid_report_event(aeh));
+
+		return false;
+	}
+
+	if (is_hid_report_sent_event(aeh)) {
+		handle_hid_report_sent_event(cast_hid_report_sent_event(aeh));
+
+		return false;
+	}
+
+	if (is_hid_report_subscriber_event(aeh)) {
+		handle_hid_report_subscriber_event(cast_hid_report_subscriber_event(aeh));
+
+		return false;
+	}
+
+	if (is_module_state_event(aeh)) {
+		struct module_state_event *event = cast_module_state_event(aeh);
+
+		if (check_state(event, MODULE_ID(main), MODULE_STATE_READY)) {
+			init();
+		}
+
+		return false;
+	}
+
+	GEN_CONFIG_EVENT_HANDLERS(STRINGIFY(MODULE), opt_descr, update_config,
+				  fetch_config);
+
+	/* If event is unhandled, unsubscribe. */
+	__ASSERT_NO_MSG(false);
+
+	return false;
+}
+
+APP_EVENT_LISTENER(MODULE, app_event_handler);
+APP_EVENT_SUBSCRIBE(MODULE, module_state_event);
+APP_EVENT_SUBSCRIBE_EARLY(MODULE, motion_event);
+APP_EVENT_SUBSCRIBE_EARLY(MODULE, hid_report_event);
+APP_EVENT_SUBSCRIBE_EARLY(MODULE, hid_report_sent_event);
+APP_EVENT_SUBSCRIBE(MODULE, hid_report_subscriber_event);
+#if CONFIG_DESKTOP_CONFIG_CHANNEL_ENABLE
+APP_EVENT_SUBSCRIBE_EARLY(MODULE, config_event);
+#endif
@@ -84,19 +84,52 @@ static bool key_update(struct keys_state *ks, uint16_t usage_id, bool pressed)
 	return !err && update_needed;
 }
 
+static bool key_changed_in_report(const uint16_t *changed, size_t changed_cnt, uint16_t usage_id)
+{
+	for (size_t i = 0; i < changed_cnt; i++) {
+		if (changed[i] == usage_id) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 static void process_queued_keypress(struct report_data *rd)
 {
-	while (!rd->update_needed) {
+	/* Coalescing is possible only if all of the key state changes since the previous report
+	 * are known. A key cannot change its state twice within one report, because the key press
+	 * or release would not be noticed by the HID host.
+	 */
+	bool coalesce = IS_ENABLED(CONFIG_DESKTOP_HID_REPORT_PROVIDER_KEYBOARD_COALESCE) &&
+			!rd->update_needed;
+	uint16_t changed[KEYBOARD_REPORT_KEY_COUNT_MAX];
+	size_t changed_cnt = 0;
+
+	while (!rd->update_needed || coalesce) {
 		uint16_t usage_id;
 		bool pressed;
-		int err = hid_eventq_keypress_dequeue(&rd->eventq, &usage_id, &pressed);
+		int err = hid_eventq_keypress_peek(&rd->eventq, &usage_id, &pressed);
 
 		if (err) {
 			/* No keypress enqueued. */
 			break;
 		}
 
-		rd->update_needed = key_update(&rd->keys_state, usage_id, pressed);
+		if (rd->update_needed &&
+		    ((changed_cnt == ARRAY_SIZE(changed)) ||
+		     key_changed_in_report(changed, changed_cnt, usage_id))) {
+			/* Keypress must be sent in a subsequent report. */
+			break;
+		}
+
+		err = hid_eventq_keypress_dequeue(&rd->eventq, &usage_id, &pressed);
+		__ASSERT_NO_MSG(!err);
+
+		if (key_update(&rd->keys_state, usage_id, pressed)) {
+			rd->update_needed = true;
+			changed[changed_cnt++] = usage_id;
+		}
 		/* If no item was changed, try next event. */
 	}
 }
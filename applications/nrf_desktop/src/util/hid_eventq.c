@@ -147,6 +147,26 @@ int hid_eventq_keypress_dequeue(struct hid_eventq *q, uint16_t *id, bool *presse
 	return 0;
 }
 
+int hid_eventq_keypress_peek(const struct hid_eventq *q, uint16_t *id, bool *pressed)
+{
+	__ASSERT_NO_MSG(hid_eventq_is_initialized(q));
+	__ASSERT_NO_MSG(id);
+	__ASSERT_NO_MSG(pressed);
+
+	sys_snode_t *n = sys_slist_peek_head(&q->root);
+
+	if (!n) {
+		return -ENOENT;
+	}
+
+	const struct hid_eventq_event *evt = CONTAINER_OF(n, struct hid_eventq_event, node);
+
+	*id = evt->data.key_id;
+	*pressed = evt->data.pressed;
+
+	return 0;
+}
+
 static void hid_eventq_region_purge(struct hid_eventq *q, sys_snode_t *last_to_purge)
 {
 	sys_snode_t *tmp;
@@ -98,6 +98,21 @@ int hid_eventq_keypress_enqueue(struct hid_eventq *q, uint16_t id, bool pressed,
  */
 int hid_eventq_keypress_dequeue(struct hid_eventq *q, uint16_t *id, bool *pressed);
 
+/**
+ * @brief Peek an enqueued keypress event in HID event queue
+ *
+ * The function gets the first enqueued event from the HID event queue without removing it from
+ * the queue.
+ *
+ * @param[in] q			HID event queue object.
+ * @param[out] id		ID of the enqueued key.
+ * @param[out] pressed		Information if the key was pressed or released.
+ *
+ * @retval 0 when successful.
+ * @retval -ENOENT if there is no keypress event enqueued.
+ */
+int hid_eventq_keypress_peek(const struct hid_eventq *q, uint16_t *id, bool *pressed);
+
 /**
  * @brief Reset a HID event queue object instance.
  *
@@ -14,11 +14,68 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(hid_keymap, CONFIG_DESKTOP_HID_KEYMAP_LOG_LEVEL);
 
+/* Hash index uses linear probing. Table is twice as big as the keymap to keep probe sequences
+ * short. Zero marks an empty slot, other values store keymap entry index incremented by one.
+ */
+#define HASH_INDEX_SIZE		MAX(2 * ARRAY_SIZE(hid_keymap), 1)
+
+BUILD_ASSERT(ARRAY_SIZE(hid_keymap) < UINT16_MAX);
+
 static bool initialized;
 
+#if CONFIG_DESKTOP_HID_KEYMAP_HASH_INDEX
+static uint16_t hash_index[HASH_INDEX_SIZE];
+
+static size_t key_id_hash(uint16_t key_id)
+{
+	/* Multiplicative hashing spreads consecutive column and row numbers across the table. */
+	return ((uint32_t)key_id * 2654435761U) % HASH_INDEX_SIZE;
+}
+#endif
+
+static void hash_index_build(void)
+{
+#if CONFIG_DESKTOP_HID_KEYMAP_HASH_INDEX
+	for (size_t i = 0; i < ARRAY_SIZE(hid_keymap); i++) {
+		size_t slot = key_id_hash(hid_keymap[i].key_id);
+
+		while (hash_index[slot] != 0) {
+			slot = (slot + 1) % HASH_INDEX_SIZE;
+		}
+
+		hash_index[slot] = i + 1;
+	}
+#endif
+}
+
+static const struct hid_keymap *hash_index_get(uint16_t key_id)
+{
+#if CONFIG_DESKTOP_HID_KEYMAP_HASH_INDEX
+	__ASSERT_NO_MSG(initialized);
+
+	size_t slot = key_id_hash(key_id);
+
+	/* Table has at least one empty slot, so the loop always terminates. */
+	while (hash_index[slot] != 0) {
+		const struct hid_keymap *map = &hid_keymap[hash_index[slot] - 1];
+
+		if (map->key_id == key_id) {
+			return map;
+		}
+
+		slot = (slot + 1) % HASH_INDEX_SIZE;
+	}
+#endif
+	return NULL;
+}
+
 
 void hid_keymap_init(void)
 {
+	if (IS_ENABLED(CONFIG_DESKTOP_HID_KEYMAP_HASH_INDEX) && !initialized) {
+		hash_index_build();
+	}
+
 	if (IS_ENABLED(CONFIG_ASSERT) && !initialized) {
 		/* Validate the order of key IDs on the key map array. */
 		for (size_t i = 1; i < ARRAY_SIZE(hid_keymap); i++) {
@@ -32,9 +89,9 @@ void hid_keymap_init(void)
 				 (hid_keymap[i].report_id < REPORT_ID_COUNT),
 				 "Invalid report ID used in hid_keymap!");
 		}
-
-		initialized = true;
 	}
+
+	initialized = true;
 }
 
 /* Compare Key ID in HID Keymap entries. */
@@ -56,6 +113,11 @@ const struct hid_keymap *hid_keymap_get(uint16_t key_id)
 		return NULL;
 	}
 
+	if (IS_ENABLED(CONFIG_DESKTOP_HID_KEYMAP_HASH_INDEX)) {
+		/* Hash index lookup is faster than both cache check and binary search. */
+		return hash_index_get(key_id);
+	}
+
 	if (IS_ENABLED(CONFIG_DESKTOP_HID_KEYMAP_CACHE)) {
 		/* Return cached mapping if possible. */
 		if (map_cache->key_id == key_id) {
@@ -9,6 +9,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <zephyr/sys/__assert.h>
 
@@ -58,9 +59,7 @@ static struct active_key *alloc_key(struct keys_state *ks, uint8_t idx, uint16_t
 	__ASSERT_NO_MSG(idx <= ks->cnt);
 
 	/* Shift active keys to make space for the new key. */
-	for (uint8_t i = ks->cnt; i > idx; i--) {
-		ks->keys[i] = ks->keys[i - 1];
-	}
+	memmove(&ks->keys[idx + 1], &ks->keys[idx], (ks->cnt - idx) * sizeof(ks->keys[0]));
 
 	struct active_key *key = &ks->keys[idx];
 
@@ -76,17 +75,24 @@ static uint8_t get_key_idx(struct keys_state *ks, uint16_t key_id)
 {
 	BUILD_ASSERT(ARRAY_SIZE(ks->keys) <= INVALID_KEY_IDX);
 
-	uint8_t idx;
+	/* Find slot for provided key ID. Active keys are sorted ascending by key ID, binary search
+	 * returns index of the first active key with ID greater or equal to the provided one.
+	 */
+	uint8_t lo = 0;
+	uint8_t hi = ks->cnt;
+
+	while (lo < hi) {
+		uint8_t mid = lo + (hi - lo) / 2;
 
-	for (idx = 0; idx < ks->cnt; idx++) {
-		/* Find slot for provided key ID. Active keys are sorted ascending by key ID. */
-		if (key_id <= ks->keys[idx].id) {
-			break;
+		if (ks->keys[mid].id < key_id) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
 		}
 	}
 
-	__ASSERT_NO_MSG(idx <= ks->cnt_max);
-	return (idx == ks->cnt_max) ? INVALID_KEY_IDX : idx;
+	__ASSERT_NO_MSG(lo <= ks->cnt_max);
+	return (lo == ks->cnt_max) ? INVALID_KEY_IDX : lo;
 }
 
 static void free_key(struct keys_state *ks, uint8_t idx)
@@ -96,9 +102,7 @@ static void free_key(struct keys_state *ks, uint8_t idx)
 	LOG_DBG("ks:%p, key ID:0x%" PRIx16, (void *)ks, ks->keys[idx].id);
 
 	/* Shift active keys to maintain ascending order. */
-	for (uint8_t i = idx; i < (ks->cnt - 1); i++) {
-		ks->keys[i] = ks->keys[i + 1];
-	}
+	memmove(&ks->keys[idx], &ks->keys[idx + 1], (ks->cnt - idx - 1) * sizeof(ks->keys[0]));
 	ks->cnt--;
 
 	/* Free the last active key. */
@@ -4,11 +4,16 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <zephyr/kernel.h>
 #include <zephyr/drivers/flash.h>
 #include <zephyr/logging/log.h>
 #include <drivers/flash/flash_rpc.h>
 
+#if defined(CONFIG_MOCK_NRF_RPC_TRANSPORT)
+#include <mock_nrf_rpc_transport.h>
+#else
 #include <nrf_rpc/nrf_rpc_ipc.h>
+#endif
 #include <nrf_rpc_cbor.h>
 
 #include <zcbor_common.h>
@@ -23,7 +28,11 @@ LOG_MODULE_DECLARE(FLASH_RPC, CONFIG_FLASH_RPC_LOG_LEVEL);
 
 #define CBOR_BUF_FLASH_MSG_SIZE (sizeof(void *) + sizeof(size_t) + sizeof(off_t) + 32)
 
+#if defined(CONFIG_MOCK_NRF_RPC_TRANSPORT)
+#define flash_rpc_api_tr mock_nrf_rpc_tr
+#else
 NRF_RPC_IPC_TRANSPORT(flash_rpc_api_tr, DEVICE_DT_GET(DT_NODELABEL(ipc0)), "flash_rpc_api_ept");
+#endif
 NRF_RPC_GROUP_DEFINE(flash_rpc_api, "flash_rpc_api", &flash_rpc_api_tr, NULL, NULL, NULL);
 
 #if DT_NODE_HAS_STATUS(DT_INST(0, nordic_rpc_flash_controller), okay)
@@ -46,6 +55,223 @@ static const struct flash_parameters flash_rpc_parameters = {
 	.erase_value = 0xff,
 };
 
+#ifdef CONFIG_FLASH_RPC_PIPELINE
+/* Sequence number, offset and the byte string header. */
+#define CBOR_BUF_WRITE_EVT_SIZE (3 * (sizeof(uint32_t) + 1) + CONFIG_FLASH_RPC_PIPELINE_BUF_SIZE)
+
+static struct {
+	/* Serializes the writers, and protects the buffer. */
+	struct k_mutex lock;
+	/* One credit per write message that can be in flight. */
+	struct k_sem credits;
+	uint32_t next_seq;
+	uint32_t done_seq;
+	/* First error reported by the host since the last flush. */
+	atomic_t error;
+	off_t offset;
+	size_t len;
+	uint8_t buf[CONFIG_FLASH_RPC_PIPELINE_BUF_SIZE] __aligned(4);
+} pipeline;
+
+#ifdef CONFIG_FLASH_RPC_STATS
+static struct flash_rpc_stats stats;
+static struct k_spinlock stats_lock;
+static int64_t busy_start;
+#endif
+
+static void stats_write_add(void)
+{
+#ifdef CONFIG_FLASH_RPC_STATS
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	stats.write_cnt++;
+	k_spin_unlock(&stats_lock, key);
+#endif
+}
+
+static void stats_msg_sent(uint32_t in_flight, size_t len)
+{
+#ifdef CONFIG_FLASH_RPC_STATS
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	if (in_flight == 1) {
+		busy_start = k_uptime_ticks();
+	}
+
+	stats.msg_cnt++;
+	stats.byte_cnt += len;
+	stats.max_in_flight = MAX(stats.max_in_flight, in_flight);
+	k_spin_unlock(&stats_lock, key);
+#endif
+}
+
+static void stats_msg_done(uint32_t in_flight)
+{
+#ifdef CONFIG_FLASH_RPC_STATS
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	if (in_flight == 0) {
+		stats.busy_time_us += k_ticks_to_us_floor64(k_uptime_ticks() - busy_start);
+	}
+
+	k_spin_unlock(&stats_lock, key);
+#endif
+}
+
+/* Must be called with the pipeline lock held. */
+static int pipeline_submit(void)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	int err;
+
+	if (pipeline.len == 0) {
+		return 0;
+	}
+
+	k_sem_take(&pipeline.credits, K_FOREVER);
+
+	NRF_RPC_CBOR_ALLOC(&flash_rpc_api, ctx, CBOR_BUF_WRITE_EVT_SIZE);
+
+	if (!zcbor_uint32_put(ctx.zs, pipeline.next_seq) ||
+	    !zcbor_uint32_put(ctx.zs, (uint32_t)pipeline.offset) ||
+	    !zcbor_bstr_encode_ptr(ctx.zs, pipeline.buf, pipeline.len)) {
+		NRF_RPC_CBOR_DISCARD(&flash_rpc_api, ctx);
+		k_sem_give(&pipeline.credits);
+		return -EMSGSIZE;
+	}
+
+	LOG_DBG("seq: %u offset: 0x%"PRIx32", size: %zu", pipeline.next_seq,
+		(uint32_t)pipeline.offset, pipeline.len);
+
+	err = nrf_rpc_cbor_evt(&flash_rpc_api, RPC_EVENT_FLASH_WRITE, &ctx);
+	if (err) {
+		LOG_ERR("Failed to send RPC write event: %d", err);
+		k_sem_give(&pipeline.credits);
+		return -EIO;
+	}
+
+	pipeline.next_seq++;
+	stats_msg_sent(pipeline.next_seq - pipeline.done_seq, pipeline.len);
+	pipeline.len = 0;
+
+	return 0;
+}
+
+/* Send the buffered data and wait for the results of all sent writes. */
+static int pipeline_drain(void)
+{
+	int err;
+
+	k_mutex_lock(&pipeline.lock, K_FOREVER);
+
+	err = pipeline_submit();
+
+	/* All credits are available once all sent writes are done. */
+	for (int i = 0; i < CONFIG_FLASH_RPC_PIPELINE_DEPTH; i++) {
+		k_sem_take(&pipeline.credits, K_FOREVER);
+	}
+	for (int i = 0; i < CONFIG_FLASH_RPC_PIPELINE_DEPTH; i++) {
+		k_sem_give(&pipeline.credits);
+	}
+
+	k_mutex_unlock(&pipeline.lock);
+
+	return err;
+}
+
+static int pipeline_write(off_t offset, const void *data, size_t len)
+{
+	const uint8_t *src = data;
+	int err;
+
+	if ((offset < 0) || ((offset % FLASH_RPC_PROG_UNIT) != 0) ||
+	    ((len % FLASH_RPC_PROG_UNIT) != 0) || (len > FLASH_RPC_FLASH_SIZE) ||
+	    ((size_t)offset > (FLASH_RPC_FLASH_SIZE - len))) {
+		return -EINVAL;
+	}
+
+	stats_write_add();
+
+	k_mutex_lock(&pipeline.lock, K_FOREVER);
+
+	err = (int)atomic_clear(&pipeline.error);
+	if (err) {
+		goto exit;
+	}
+
+	while (len > 0) {
+		size_t chunk;
+
+		if ((pipeline.len > 0) && (offset != (pipeline.offset + pipeline.len))) {
+			err = pipeline_submit();
+			if (err) {
+				goto exit;
+			}
+		}
+
+		if (pipeline.len == 0) {
+			pipeline.offset = offset;
+		}
+
+		chunk = MIN(len, sizeof(pipeline.buf) - pipeline.len);
+		memcpy(&pipeline.buf[pipeline.len], src, chunk);
+		pipeline.len += chunk;
+		offset += chunk;
+		src += chunk;
+		len -= chunk;
+
+		if (pipeline.len == sizeof(pipeline.buf)) {
+			err = pipeline_submit();
+			if (err) {
+				goto exit;
+			}
+		}
+	}
+
+exit:
+	k_mutex_unlock(&pipeline.lock);
+
+	return err;
+}
+
+static void flash_rpc_write_done_handler(const struct nrf_rpc_group *group,
+					 struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
+{
+	uint32_t seq;
+	int32_t result;
+
+	ARG_UNUSED(handler_data);
+
+	if (!zcbor_uint32_decode(ctx->zs, &seq) || !zcbor_int32_decode(ctx->zs, &result)) {
+		nrf_rpc_cbor_decoding_done(group, ctx);
+		LOG_ERR("Unable to decode write result");
+		(void)atomic_cas(&pipeline.error, 0, -EBADMSG);
+		return;
+	}
+
+	nrf_rpc_cbor_decoding_done(group, ctx);
+
+	/* The host writes and reports the results in the order of sending. */
+	if (seq != pipeline.done_seq) {
+		LOG_ERR("Unexpected write result, seq: %u, expected: %u", seq,
+			pipeline.done_seq);
+		(void)atomic_cas(&pipeline.error, 0, -EIO);
+	}
+
+	if (result) {
+		LOG_ERR("Write %u failed: %d", seq, result);
+		(void)atomic_cas(&pipeline.error, 0, result);
+	}
+
+	pipeline.done_seq++;
+	stats_msg_done(pipeline.next_seq - pipeline.done_seq);
+	k_sem_give(&pipeline.credits);
+}
+
+NRF_RPC_CBOR_EVT_DECODER(flash_rpc_api, flash_write_done, RPC_EVENT_FLASH_WRITE_DONE,
+			 flash_rpc_write_done_handler, NULL);
+#endif /* CONFIG_FLASH_RPC_PIPELINE */
+
 static void flash_rpc_get_rsp(const struct nrf_rpc_group *group, struct nrf_rpc_cbor_ctx *ctx,
 				 void *handler_data)
 {
@@ -92,6 +318,12 @@ int flash_rpc_init(const struct device *dev)
 
 	ARG_UNUSED(dev_config);
 
+#ifdef CONFIG_FLASH_RPC_PIPELINE
+	k_mutex_init(&pipeline.lock);
+	k_sem_init(&pipeline.credits, CONFIG_FLASH_RPC_PIPELINE_DEPTH,
+		   CONFIG_FLASH_RPC_PIPELINE_DEPTH);
+#endif
+
 #ifndef CONFIG_FLASH_RPC_SYS_INIT
 	err = nrf_rpc_init(err_handler);
 	if (err) {
@@ -127,6 +359,13 @@ int flash_rpc_read(const struct device *dev, off_t offset, void *buffer, size_t
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_FLASH_RPC_PIPELINE
+	err = pipeline_drain();
+	if (err) {
+		return err;
+	}
+#endif
+
 	if (!encode_flash_msg(&ctx, &offset, buffer, &len)) {
 		LOG_ERR("Could not encode flash_rpc message");
 		return -EMSGSIZE;
@@ -159,6 +398,10 @@ int flash_rpc_write(const struct device *dev, off_t offset, const void *data, si
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_FLASH_RPC_PIPELINE
+	return pipeline_write(offset, data, len);
+#endif
+
 	if (!encode_flash_msg(&ctx, &offset, (void *)data, &len)) {
 		return -EMSGSIZE;
 	}
@@ -183,6 +426,13 @@ int flash_rpc_erase(const struct device *dev, off_t offset, size_t size)
 
 	struct nrf_rpc_cbor_ctx ctx;
 
+#ifdef CONFIG_FLASH_RPC_PIPELINE
+	err = pipeline_drain();
+	if (err) {
+		return err;
+	}
+#endif
+
 	if (!encode_flash_msg(&ctx, &offset, NULL, &size)) {
 		return -EMSGSIZE;
 	}
@@ -197,6 +447,60 @@ int flash_rpc_erase(const struct device *dev, off_t offset, size_t size)
 	return result;
 }
 
+int flash_rpc_flush(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+#ifdef CONFIG_FLASH_RPC_PIPELINE
+	int err = pipeline_drain();
+
+#ifdef CONFIG_FLASH_RPC_STATS
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	stats.flush_cnt++;
+	k_spin_unlock(&stats_lock, key);
+#endif
+
+	/* A write that failed on the host is reported before a send error. */
+	int write_err = (int)atomic_clear(&pipeline.error);
+
+	return write_err ? write_err : err;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int flash_rpc_stats_get(struct flash_rpc_stats *out, bool reset)
+{
+#ifdef CONFIG_FLASH_RPC_STATS
+	k_spinlock_key_t key;
+
+	if (out == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&stats_lock);
+	*out = stats;
+	if (reset) {
+		memset(&stats, 0, sizeof(stats));
+		if (pipeline.next_seq != pipeline.done_seq) {
+			busy_start = k_uptime_ticks();
+		}
+	}
+	k_spin_unlock(&stats_lock, key);
+
+	out->throughput = (out->busy_time_us > 0) ?
+		(uint32_t)(((uint64_t)out->byte_cnt * USEC_PER_SEC) / out->busy_time_us) : 0;
+
+	return 0;
+#else
+	ARG_UNUSED(out);
+	ARG_UNUSED(reset);
+
+	return -ENOTSUP;
+#endif
+}
+
 static const struct flash_parameters *flash_rpc_get_parameters(const struct device *dev)
 {
 	ARG_UNUSED(dev);
@@ -232,6 +536,10 @@ static const struct flash_driver_api flash_driver_rpc_api = {
 DEVICE_DT_INST_DEFINE(0, flash_rpc_init, NULL, NULL, NULL, POST_KERNEL,
 		      CONFIG_FLASH_RPC_DRIVER_INIT_PRIORITY, &flash_driver_rpc_api);
 
+/* With the mock transport, the test initializes the device after it sets up
+ * the expected nRF RPC packets.
+ */
+#ifndef CONFIG_MOCK_NRF_RPC_TRANSPORT
 static int controller_init(void)
 {
 	int err;
@@ -246,3 +554,4 @@ static int controller_init(void)
 }
 
 SYS_INIT(controller_init, APPLICATION, CONFIG_FLASH_RPC_DRIVER_INIT_PRIORITY);
+#endif
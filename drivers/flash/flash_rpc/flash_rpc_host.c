@@ -5,23 +5,35 @@
  */
 
 #include <zephyr/device.h>
+#include <zephyr/init.h>
 #include <zephyr/drivers/flash.h>
 #include <zephyr/logging/log.h>
 #include <drivers/flash/flash_rpc.h>
 
-#include <nrf_rpc_cbor.h>
+#if defined(CONFIG_MOCK_NRF_RPC_TRANSPORT)
+#include <mock_nrf_rpc_transport.h>
+#else
 #include <nrf_rpc/nrf_rpc_ipc.h>
+#endif
+#include <nrf_rpc_cbor.h>
 
 #include <zcbor_common.h>
 #include <zcbor_decode.h>
 #include <zcbor_encode.h>
 
-
+#ifndef CONFIG_FLASH_RPC_SYS_INIT
+LOG_MODULE_REGISTER(FLASH_RPC, CONFIG_FLASH_RPC_LOG_LEVEL);
+#else
 LOG_MODULE_DECLARE(FLASH_RPC, CONFIG_FLASH_RPC_LOG_LEVEL);
+#endif
 
 #define CBOR_BUF_FLASH_MSG_SIZE (sizeof(void *) + sizeof(size_t) + sizeof(off_t))
 
+#if defined(CONFIG_MOCK_NRF_RPC_TRANSPORT)
+#define flash_rpc_api_tr mock_nrf_rpc_tr
+#else
 NRF_RPC_IPC_TRANSPORT(flash_rpc_api_tr, DEVICE_DT_GET(DT_NODELABEL(ipc0)), "flash_rpc_api_ept");
+#endif
 NRF_RPC_GROUP_DEFINE(flash_rpc_api, "flash_rpc_api", &flash_rpc_api_tr, NULL, NULL, NULL);
 
 static const struct device *const flash_controller =
@@ -56,6 +68,133 @@ static void rsp_error_code_send(const struct nrf_rpc_group *group, int err_code)
 	nrf_rpc_cbor_rsp_no_err(group, &ctx);
 }
 
+#ifdef CONFIG_FLASH_RPC_PIPELINE
+/* Writes are buffered in slots indexed by the sequence number, so that they
+ * are written in the order of sending even if the events are decoded by
+ * several nRF RPC threads.
+ */
+struct write_slot {
+	struct k_sem free;
+	struct k_sem ready;
+	off_t offset;
+	size_t len;
+	/* Error reported instead of writing the slot. */
+	int err;
+	uint8_t data[CONFIG_FLASH_RPC_PIPELINE_BUF_SIZE] __aligned(4);
+};
+
+static struct write_slot write_slots[CONFIG_FLASH_RPC_PIPELINE_DEPTH];
+static atomic_t write_seq;
+
+static void write_done_send(uint32_t seq, int result)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	int err;
+
+	NRF_RPC_CBOR_ALLOC(&flash_rpc_api, ctx, 2 * (sizeof(uint32_t) + 1));
+
+	zcbor_uint32_put(ctx.zs, seq);
+	zcbor_int32_put(ctx.zs, result);
+
+	err = nrf_rpc_cbor_evt(&flash_rpc_api, RPC_EVENT_FLASH_WRITE_DONE, &ctx);
+	if (err) {
+		LOG_ERR("Failed to send RPC write result: %d", err);
+	}
+}
+
+static void flash_write_evt_handler(const struct nrf_rpc_group *group,
+				    struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
+{
+	struct zcbor_string data;
+	struct write_slot *slot;
+	uint32_t offset;
+	uint32_t seq;
+
+	ARG_UNUSED(handler_data);
+
+	if (!zcbor_uint32_decode(ctx->zs, &seq)) {
+		nrf_rpc_cbor_decoding_done(group, ctx);
+		/* Without the sequence number the write cannot be completed,
+		 * the controller keeps waiting for the result.
+		 */
+		LOG_ERR("Unable to decode flash_rpc write event");
+		return;
+	}
+
+	slot = &write_slots[seq % CONFIG_FLASH_RPC_PIPELINE_DEPTH];
+
+	/* Blocks when the controller sends more writes than there are slots. */
+	k_sem_take(&slot->free, K_FOREVER);
+
+	/* On error, the slot is still completed by the writer, so that the
+	 * following writes are not blocked and the results stay in order.
+	 */
+	slot->len = 0;
+
+	if (!zcbor_uint32_decode(ctx->zs, &offset) || !zcbor_bstr_decode(ctx->zs, &data)) {
+		LOG_ERR("Unable to decode flash_rpc write event");
+		slot->err = -EBADMSG;
+	} else if (data.len > CONFIG_FLASH_RPC_PIPELINE_BUF_SIZE) {
+		LOG_ERR("Write of %zu bytes exceeds the buffer size", data.len);
+		slot->err = -EMSGSIZE;
+	} else {
+		slot->offset = (off_t)offset;
+		slot->len = data.len;
+		slot->err = 0;
+		memcpy(slot->data, data.value, data.len);
+	}
+
+	nrf_rpc_cbor_decoding_done(group, ctx);
+
+	k_sem_give(&slot->ready);
+}
+
+static void flash_writer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		uint32_t seq = (uint32_t)atomic_get(&write_seq);
+		struct write_slot *slot = &write_slots[seq % CONFIG_FLASH_RPC_PIPELINE_DEPTH];
+		int err;
+
+		k_sem_take(&slot->ready, K_FOREVER);
+
+		LOG_DBG("seq: %u offset: 0x%"PRIx32", size: %zu", seq, (uint32_t)slot->offset,
+			slot->len);
+		err = slot->err;
+		if (!err) {
+			err = flash_write(flash_controller, slot->offset, slot->data, slot->len);
+		}
+
+		atomic_inc(&write_seq);
+		k_sem_give(&slot->free);
+
+		write_done_send(seq, err);
+	}
+}
+
+static int write_slots_init(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(write_slots); i++) {
+		k_sem_init(&write_slots[i].free, 1, 1);
+		k_sem_init(&write_slots[i].ready, 0, 1);
+	}
+
+	return 0;
+}
+
+SYS_INIT(write_slots_init, POST_KERNEL, 0);
+
+K_THREAD_DEFINE(flash_rpc_writer, CONFIG_FLASH_RPC_PIPELINE_STACK_SIZE, flash_writer,
+		NULL, NULL, NULL, K_PRIO_PREEMPT(CONFIG_NUM_PREEMPT_PRIORITIES - 1), 0, 0);
+
+NRF_RPC_CBOR_EVT_DECODER(flash_rpc_api, flash_write_evt, RPC_EVENT_FLASH_WRITE,
+			 flash_write_evt_handler, NULL);
+#endif /* CONFIG_FLASH_RPC_PIPELINE */
+
 static void flash_rpc_init_handler(const struct nrf_rpc_group *group,
 					   struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
 {
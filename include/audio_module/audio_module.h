@@ -124,6 +124,11 @@ struct audio_module_context;
  */
 struct audio_module_configuration;
 
+/**
+ * @brief Private reference counted audio data buffer.
+ */
+struct audio_module_buf_ref;
+
 /**
  * @brief Callback function for a response to a data_send as
  *        supplied by the module user.
@@ -314,12 +319,18 @@ struct audio_module_handle {
 	/* Number of destination modules. */
 	uint8_t dest_count;
 
+	/* Number of source modules connected to this module. */
+	uint8_t src_count;
+
 	/* Semaphore to count messages between modules and on a module's TX FIFO. */
 	struct k_sem sem;
 
 	/* Mutex to make the above destinations list thread safe. */
 	struct k_mutex dest_mutex;
 
+	/* Mutex held while the module processes audio data with the chain scheduler. */
+	struct k_mutex process_mutex;
+
 	/* Module's thread configuration. */
 	struct audio_module_thread_configuration thread;
 
@@ -339,6 +350,9 @@ struct audio_module_message {
 
 	/* Callback for when the audio data has been consumed. */
 	audio_module_response_cb response_cb;
+
+	/* Reference to the shared audio data buffer, NULL if the response callback is used. */
+	struct audio_module_buf_ref *buf_ref;
 };
 
 /**
@@ -434,6 +448,9 @@ int audio_module_start(struct audio_module_handle *handle);
 /**
  * @brief Stop processing audio data in the audio module given by handle.
  *
+ * @note With the chain scheduler, the function returns once the module, and the modules
+ *       chained after it, have finished processing the current audio data.
+ *
  * @param handle  [in/out]  The handle for the module to be stopped.
  *
  * @return 0 if successful, error otherwise.
@@ -337,6 +337,80 @@ void read_implementation_id_from_otp(uint8_t *buf);
  */
 int read_variable_data(enum variable_data_type data_type, uint8_t *buf, uint32_t *buf_len);
 
+#if defined(CONFIG_SB_VALIDATION_MARKER)
+
+/** Magic value of a written validation marker. */
+#define BL_VALIDATION_MARKER_MAGIC 0x4d564c42
+
+/** Length of the image digest stored in the validation marker. */
+#define BL_VALIDATION_MARKER_DIGEST_LEN 32
+
+/**
+ * @brief Validation marker of the last image that passed the full validation.
+ *
+ * The marker is stored in the b0_marker partition, which is written only by
+ * the bootloader and is write-protected before the next stage is booted.
+ * The marker is followed by a tally of boots that used the marker, one word
+ * per boot.
+ */
+struct bl_validation_marker {
+	/* Written last, so that a partially written marker is ignored. */
+	uint32_t magic;
+	uint32_t fw_address;
+	uint32_t fw_size;
+	uint32_t fw_version;
+	/* Monotonic counter value expected after the image is booted. */
+	uint32_t counter;
+	/* Index of the public key that verified the signature. */
+	uint32_t key_idx;
+	uint8_t digest[BL_VALIDATION_MARKER_DIGEST_LEN];
+};
+
+/**
+ * @brief Get the validation marker.
+ *
+ * @return Pointer to the marker in flash, or NULL if no marker is written.
+ */
+const struct bl_validation_marker *bl_validation_marker_get(void);
+
+/**
+ * @brief Replace the validation marker.
+ *
+ * Erases the b0_marker partition, including the boot tally, and writes
+ * @p marker to it.
+ *
+ * @param[in] marker Marker to write. The magic field is set by the function.
+ *
+ * @retval 0        Success.
+ * @retval -EINVAL  @p marker is NULL.
+ * @retval -EIO     The marker could not be written.
+ */
+int bl_validation_marker_write(const struct bl_validation_marker *marker);
+
+/**
+ * @brief Erase the validation marker.
+ *
+ * The next validation will be a full validation.
+ */
+void bl_validation_marker_erase(void);
+
+/**
+ * @brief Get the number of boots that used the validation marker.
+ *
+ * @return Number of boots counted since the marker was written.
+ */
+uint32_t bl_validation_marker_boots_get(void);
+
+/**
+ * @brief Count a boot that used the validation marker.
+ *
+ * @retval 0        Success.
+ * @retval -ENOMEM  The boot tally is full.
+ */
+int bl_validation_marker_boot_add(void);
+
+#endif /* CONFIG_SB_VALIDATION_MARKER */
+
   /** @} */
 
 #ifdef __cplusplus
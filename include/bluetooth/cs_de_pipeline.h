@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CS_DE_PIPELINE_H__
+#define CS_DE_PIPELINE_H__
+
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/cs.h>
+#include <bluetooth/cs_de.h>
+
+/** @file
+ *  @defgroup bt_cs_de_pipeline Channel Sounding Distance Estimation pipeline API
+ *  @{
+ *  @brief API for the multi-peer ranging pipeline from the Ranging Requestor to the
+ *         Channel Sounding Distance Estimation toolkit.
+ */
+
+/**
+ * @brief Distance estimation result callback.
+ *
+ * Called from the pipeline thread for every procedure for which both the local step data
+ * and the peer ranging data were received.
+ *
+ * @param[in] conn            Connection object of the peer.
+ * @param[in] ranging_counter Ranging counter of the procedure.
+ * @param[in] report          Distance estimation report. Valid only within the callback.
+ * @param[in] quality         Quality of the distance estimation.
+ */
+typedef void (*cs_de_pipeline_result_cb_t)(struct bt_conn *conn, uint16_t ranging_counter,
+					   cs_de_report_t *report, cs_de_quality_t quality);
+
+/**
+ * @brief Per-peer pipeline statistics.
+ */
+struct cs_de_pipeline_stats {
+	/** Number of procedures passed to the distance estimation. */
+	uint32_t procedures;
+
+	/** Number of procedures dropped because of missing buffers or reception errors. */
+	uint32_t dropped;
+
+	/** Number of received local step data and peer ranging data bytes. */
+	uint32_t rx_bytes;
+
+	/** Average rate of received bytes since the statistics reset, in bytes per second. */
+	uint32_t rx_rate;
+
+	/** Average time from receiving complete procedure data until the result callback
+	 *  returns, in microseconds.
+	 */
+	uint32_t latency_avg_us;
+
+	/** Maximum time from receiving complete procedure data until the result callback
+	 *  returns, in microseconds.
+	 */
+	uint32_t latency_max_us;
+};
+
+/**
+ * @brief Add a peer to the pipeline.
+ *
+ * The pipeline subscribes to the ranging data of the peer through the Ranging Requestor and
+ * requests on-demand ranging data on its own. The peer is removed automatically on
+ * disconnection.
+ *
+ * @note The function subscribes to GATT notifications and must not be called from
+ *       the Bluetooth RX thread.
+ *
+ * @param[in] conn      Connection object, which already has associated RREQ context.
+ * @param[in] role      Channel Sounding role of the local device.
+ * @param[in] realtime  Use real-time ranging data instead of on-demand ranging data.
+ * @param[in] result_cb Distance estimation result callback.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL If the parameters are invalid.
+ * @retval -EALREADY If the peer is already added.
+ * @retval -ENOMEM If there is no free peer context.
+ *           Otherwise, a negative error code from the Ranging Requestor is returned.
+ */
+int cs_de_pipeline_peer_add(struct bt_conn *conn, enum bt_conn_le_cs_role role, bool realtime,
+			    cs_de_pipeline_result_cb_t result_cb);
+
+/**
+ * @brief Remove a peer from the pipeline.
+ *
+ * Procedures of the peer that are not yet processed are dropped.
+ *
+ * @param[in] conn Connection object.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -ENOENT If the peer was not added.
+ */
+int cs_de_pipeline_peer_remove(struct bt_conn *conn);
+
+/**
+ * @brief Pass the local Channel Sounding subevent result to the pipeline.
+ *
+ * Call this function from the Channel Sounding subevent result callback.
+ *
+ * @param[in] conn   Connection object.
+ * @param[in] result Subevent result.
+ */
+void cs_de_pipeline_subevent_result(struct bt_conn *conn,
+				    struct bt_conn_le_cs_subevent_result *result);
+
+/**
+ * @brief Get the pipeline statistics of a peer.
+ *
+ * @param[in]  conn  Connection object.
+ * @param[out] stats Statistics of the peer.
+ * @param[in]  reset Reset the statistics after reading them.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL If @p stats is NULL.
+ * @retval -ENOENT If the peer was not added.
+ */
+int cs_de_pipeline_stats_get(struct bt_conn *conn, struct cs_de_pipeline_stats *stats,
+			     bool reset);
+
+/**
+ * @}
+ */
+
+#endif /* CS_DE_PIPELINE_H__ */
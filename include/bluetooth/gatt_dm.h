@@ -317,6 +317,50 @@ int bt_gatt_dm_continue(struct bt_gatt_dm *dm, void *context);
  */
 int bt_gatt_dm_data_release(struct bt_gatt_dm *dm);
 
+/** @brief Discovery statistics. */
+struct bt_gatt_dm_stats {
+	/** Number of discoveries performed over the air. */
+	uint32_t discovery_cnt;
+	/** Number of discoveries served from the discovery cache. */
+	uint32_t cache_hit_cnt;
+	/** Number of GATT procedures started by the Discovery Manager. */
+	uint32_t procedure_cnt;
+	/** Average time of a discovery performed over the air, in microseconds. */
+	uint32_t discovery_time_avg_us;
+	/** Maximum time of a discovery performed over the air, in microseconds. */
+	uint32_t discovery_time_max_us;
+	/** Average time of a discovery served from the cache, in microseconds. */
+	uint32_t cache_time_avg_us;
+};
+
+/** @brief Get the discovery statistics.
+ *
+ * The discovery time is measured from calling @ref bt_gatt_dm_start or
+ * @ref bt_gatt_dm_continue until the completed or service not found callback
+ * is called. Failed discoveries are not included.
+ *
+ * @param[out] stats Statistics.
+ * @param[in]  reset Reset the statistics after reading them.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL If @p stats is NULL.
+ * @retval -ENOTSUP If the statistics are disabled.
+ */
+int bt_gatt_dm_stats_get(struct bt_gatt_dm_stats *stats, bool reset);
+
+/** @brief Remove discovery results from the discovery cache.
+ *
+ * Cached results are validated with the Database Hash of the peer, so this
+ * function is needed only to free the cache, for example when the bond
+ * with the peer is removed.
+ *
+ * @param[in] addr Identity address of the peer or NULL to clear the whole cache.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -ENOTSUP If the discovery cache is disabled.
+ */
+int bt_gatt_dm_cache_clear(const bt_addr_le_t *addr);
+
 /** @brief Print service discovery data.
  *
  * This function prints GATT attributes that belong to the discovered service.
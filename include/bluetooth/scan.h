@@ -105,7 +105,7 @@ struct bt_scan_filter_info {
 	bool enabled;
 
 	/** Filter count. */
-	uint8_t cnt;
+	uint16_t cnt;
 };
 
 /**@brief Filter status structure.
@@ -516,6 +516,32 @@ int bt_scan_filter_add(enum bt_scan_filter_type type,
  */
 void bt_scan_filter_remove_all(void);
 
+/**@brief Advertising report deduplication cache statistics.
+ */
+struct bt_scan_dedup_stats {
+	/** Number of reports for which the cached filtering result was used. */
+	uint32_t hit;
+
+	/** Number of reports that were run through the filters. */
+	uint32_t miss;
+};
+
+/**@brief Function for getting the deduplication cache statistics.
+ *
+ * @details The deduplication cache stores the filtering result of recently
+ *          received advertising reports. A report with the same advertiser
+ *          address, advertising properties, and advertising data as a cached
+ *          one reuses the stored result instead of running the filters.
+ *
+ * @param[out] stats Pointer to the statistics structure.
+ * @param[in] reset Reset the statistics after reading them.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL If @p stats is NULL.
+ * @retval -ENOTSUP If the deduplication cache is disabled.
+ */
+int bt_scan_dedup_stats_get(struct bt_scan_dedup_stats *stats, bool reset);
+
 #endif /* CONFIG_BT_SCAN_FILTER_ENABLE */
 
 /**@brief Function for changing the scanning parameters.
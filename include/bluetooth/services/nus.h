@@ -66,6 +66,12 @@ struct bt_nus_cb {
 	 * The data has been sent as a notification and written on the NUS TX
 	 * Characteristic.
 	 *
+	 * If @kconfig{CONFIG_BT_NUS_TX_COALESCE} is enabled, the callback is
+	 * called once for every sent notification, not once for every
+	 * @ref bt_nus_send call. A notification can contain data from
+	 * multiple calls, and data from a single call can be split between
+	 * multiple notifications.
+	 *
 	 * @param[in] conn Pointer to connection object, or NULL if sent to all
 	 *                 connected peers.
 	 */
@@ -103,17 +109,85 @@ int bt_nus_init(struct bt_nus_cb *callbacks);
  * @details This function sends data to a connected peer, or all connected
  *          peers.
  *
+ *          If @kconfig{CONFIG_BT_NUS_TX_COALESCE} is enabled, the data is
+ *          queued and packed with other queued data into notifications of
+ *          the ATT MTU size. The queued data is sent when it fills
+ *          a notification, when the link is idle, after the coalescing
+ *          timeout, or on @ref bt_nus_flush. In this mode, the length of
+ *          the data is limited by the size of the TX queue
+ *          (@kconfig{CONFIG_BT_NUS_TX_COALESCE_BUF_SIZE}) instead of
+ *          the maximum notification length returned by @ref bt_nus_get_mtu.
+ *
  * @param[in] conn Pointer to connection object, or NULL to send to all
  *                 connected peers.
  * @param[in] data Pointer to a data buffer.
  * @param[in] len  Length of the data in the buffer.
  *
- * @retval 0 If the data is sent.
+ * @retval 0 If the data is sent, or queued if
+ *           @kconfig{CONFIG_BT_NUS_TX_COALESCE} is enabled.
+ * @retval -EINVAL If the peer has not enabled notifications.
+ * @retval -EMSGSIZE If the data is longer than the maximum notification
+ *                   length for @p conn or, if
+ *                   @kconfig{CONFIG_BT_NUS_TX_COALESCE} is enabled, than
+ *                   the TX queue.
+ * @retval -ENOMEM If @kconfig{CONFIG_BT_NUS_TX_COALESCE} is enabled and
+ *                 the data does not fit into the free space of the TX queue.
+ * @retval -ENOTCONN If @kconfig{CONFIG_BT_NUS_TX_COALESCE} is enabled,
+ *                   @p conn is NULL, and no connected peer has enabled
+ *                   notifications.
  *           Otherwise, a negative value is returned.
  */
 int bt_nus_send(struct bt_conn *conn, const uint8_t *data, uint16_t len);
 
+/** @brief NUS TX statistics. */
+struct bt_nus_tx_stats {
+	/** Number of sent bytes. */
+	uint32_t bytes;
+
+	/** Number of sent notifications. */
+	uint32_t notifications;
+
+	/** Ratio of sent bytes to the notification capacity, in percent. */
+	uint32_t fill_ratio;
+
+	/** Effective throughput since the statistics reset, in bytes per second. */
+	uint32_t throughput;
+};
+
+/**@brief Send the queued data immediately.
+ *
+ * @details Queued data is sent without waiting for the coalescing timeout.
+ *          The last notification can be partially filled.
+ *
+ * @note Available only if @kconfig{CONFIG_BT_NUS_TX_COALESCE} is enabled.
+ *
+ * @param[in] conn Pointer to connection object, or NULL to flush data of
+ *                 all connected peers.
+ *
+ * @retval 0 If the flush is scheduled.
+ * @retval -ENOTCONN If there is no data queued for the connection.
+ */
+int bt_nus_flush(struct bt_conn *conn);
+
+/**@brief Get TX statistics of the connection.
+ *
+ * @note Available only if @kconfig{CONFIG_BT_NUS_TX_COALESCE} is enabled.
+ *
+ * @param[in]  conn  Pointer to connection object.
+ * @param[out] stats TX statistics.
+ * @param[in]  reset Reset the statistics after reading them.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL If a parameter is NULL.
+ * @retval -ENOTCONN If no data was sent to the connection yet.
+ */
+int bt_nus_tx_stats_get(struct bt_conn *conn, struct bt_nus_tx_stats *stats, bool reset);
+
 /**@brief Get maximum data length that can be used for @ref bt_nus_send.
+ *
+ * @details The length is the maximum length of a single notification. If
+ *          @kconfig{CONFIG_BT_NUS_TX_COALESCE} is enabled, @ref bt_nus_send
+ *          accepts longer data and splits it between notifications.
  *
  * @param[in] conn Pointer to connection Object.
  *
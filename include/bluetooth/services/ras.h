@@ -543,6 +543,22 @@ int bt_ras_rreq_rd_overwritten_unsubscribe(struct bt_conn *conn);
 int bt_ras_rreq_realtime_rd_subscribe(struct bt_conn *conn, struct net_buf_simple *ranging_data_out,
 				      bt_ras_rreq_ranging_data_received_t data_received_cb);
 
+/** @brief Set the buffer for the subsequent real-time ranging data.
+ *
+ * Allows the application to hand over the buffer with complete ranging data to another
+ * context without copying it. Call this function from the data_received_cb callback
+ * of @ref bt_ras_rreq_realtime_rd_subscribe to store the next ranging data in a new buffer.
+ *
+ * @param[in] conn Connection Object that already has an associated RREQ context.
+ * @param[in] ranging_data_out Simple buffer to store received ranging data.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL If the RREQ context or buffer is missing.
+ * @retval -EACCES If not subscribed to real-time ranging data.
+ * @retval -EBUSY If ranging data reception is in progress.
+ */
+int bt_ras_rreq_realtime_rd_buf_set(struct bt_conn *conn, struct net_buf_simple *ranging_data_out);
+
 /** @brief Unsubscribe from real-time ranging data notifications.
  *
  * @note Calling from BT RX thread may return an error as bt_gatt_unsubscribe will not block if
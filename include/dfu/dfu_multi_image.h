@@ -37,6 +37,11 @@
  * 4. Call @c dfu_multi_image_done function to release open resources and verify that all
  *    data declared in the header have been written properly.
  *
+ * If @c CONFIG_DFU_MULTI_IMAGE_PIPELINE is enabled, the image data is copied to a pool of
+ * buffers and passed to the image writers from a dedicated thread. In that case, an error
+ * returned by an image writer is reported by a subsequent call to @c dfu_multi_image_write
+ * or by @c dfu_multi_image_done, which also waits until all the image data is written.
+ *
  * @{
  */
 
@@ -48,6 +53,9 @@
 extern "C" {
 #endif
 
+/** @brief Size of the image SHA-256 digest. */
+#define DFU_MULTI_IMAGE_SHA256_LEN 32
+
 typedef int (*dfu_image_open_t)(int image_id, size_t image_size);
 typedef int (*dfu_image_write_t)(const uint8_t *chunk, size_t chunk_size);
 typedef int (*dfu_image_close_t)(bool success);
@@ -87,12 +95,46 @@ struct dfu_image_writer {
 	 *
 	 * The function is indirectly called by @c dfu_multi_image_write or
 	 * @c dfu_multi_image_done and in the case of failure the error code is propagated
-	 * and returned from the latter function.
+	 * and returned from the latter function. It is called exactly once for each image
+	 * that has been opened.
 	 *
 	 * @return negative On failure.
 	 * @return 0        On success.
 	 */
 	dfu_image_close_t close;
+
+	/**
+	 * @brief Expected SHA-256 digest of the applicable image, or NULL.
+	 *
+	 * Only used if @c CONFIG_DFU_MULTI_IMAGE_SHA256 is enabled. The digest is computed
+	 * while the image is written and compared after the last byte of the image is
+	 * written. If the digests differ, the image is closed with a failure and -EBADMSG
+	 * is returned.
+	 */
+	const uint8_t *sha256;
+};
+
+/**
+ * @brief Write statistics of a single image.
+ */
+struct dfu_multi_image_stats {
+	/** @brief Number of bytes passed to the image writer. */
+	size_t bytes_written;
+
+	/** @brief Time from opening to closing the image, in microseconds. */
+	uint32_t total_time_us;
+
+	/** @brief Time spent in the write function of the image writer, in microseconds. */
+	uint32_t write_time_us;
+
+	/** @brief Time spent on computing the image digest, in microseconds. */
+	uint32_t hash_time_us;
+
+	/**
+	 * @brief Time that @c dfu_multi_image_write waited for a free pipeline buffer,
+	 *        in microseconds.
+	 */
+	uint32_t stall_time_us;
 };
 
 /**
@@ -165,7 +207,7 @@ size_t dfu_multi_image_offset(void);
 /**
  * @brief Complete DFU Multi Image package write.
  *
- * Close an open image writer if such exists. Additionally, if @c success argument is
+ * Close the image writers that are still open. Additionally, if @c success argument is
  * true, the function validates that all images listed in the package header have been
  * fully written.
  *
@@ -178,6 +220,37 @@ size_t dfu_multi_image_offset(void);
  */
 int dfu_multi_image_done(bool success);
 
+/**
+ * @brief Get the SHA-256 digest of a written image.
+ *
+ * The digest is available after the last byte of the image has been written, so it can
+ * be used to verify the image without reading it back.
+ *
+ * @param[in] image_id Identifier of the image.
+ * @param[out] digest Buffer of @c DFU_MULTI_IMAGE_SHA256_LEN bytes for the digest.
+ *
+ * @retval -EINVAL  If @c digest is NULL.
+ * @retval -ENOENT  If the image has not been fully written.
+ * @retval -ENOTSUP If @c CONFIG_DFU_MULTI_IMAGE_SHA256 is disabled.
+ * @return 0        On success.
+ */
+int dfu_multi_image_digest_get(int image_id, uint8_t *digest);
+
+/**
+ * @brief Get the write statistics of an image.
+ *
+ * The statistics are reset by @c dfu_multi_image_init.
+ *
+ * @param[in] image_id Identifier of the image.
+ * @param[out] stats Statistics of the image.
+ *
+ * @retval -EINVAL  If @c stats is NULL.
+ * @retval -ENOENT  If the image has not been opened.
+ * @retval -ENOTSUP If @c CONFIG_DFU_MULTI_IMAGE_STATS is disabled.
+ * @return 0        On success.
+ */
+int dfu_multi_image_stats_get(int image_id, struct dfu_multi_image_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
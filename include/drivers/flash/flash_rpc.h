@@ -7,6 +7,9 @@
 #ifndef FLASH_RPC_H_
 #define FLASH_RPC_H_
 
+#include <stdbool.h>
+#include <zephyr/device.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -18,6 +21,58 @@ enum flash_rpc_command {
 	RPC_COMMAND_FLASH_ERASE = 0x04,
 };
 
+enum flash_rpc_event {
+	/* Controller to host: sequence number, offset, and data to write. */
+	RPC_EVENT_FLASH_WRITE = 0x01,
+	/* Host to controller: sequence number and result of a write. */
+	RPC_EVENT_FLASH_WRITE_DONE = 0x02,
+};
+
+/** @brief Statistics of the pipelined writes. */
+struct flash_rpc_stats {
+	/** Number of flash_write() calls. */
+	uint32_t write_cnt;
+	/** Number of write messages sent to the host. */
+	uint32_t msg_cnt;
+	/** Number of written bytes. */
+	uint32_t byte_cnt;
+	/** Number of flash_rpc_flush() calls. */
+	uint32_t flush_cnt;
+	/** Maximum number of write messages in flight. */
+	uint32_t max_in_flight;
+	/** Time with at least one write message in flight, in microseconds. */
+	uint64_t busy_time_us;
+	/** Written bytes per second of busy time. */
+	uint32_t throughput;
+};
+
+/**
+ * @brief Wait until all written data is stored in the flash.
+ *
+ * Sends the buffered data to the host and waits until the host reports the
+ * result of all sent writes.
+ *
+ * @param dev Flash RPC device.
+ *
+ * @retval 0 All data is written.
+ * @retval -ENOTSUP Pipelined writes are disabled.
+ * @return Other negative error code of the first failed write since the last
+ *         flush.
+ */
+int flash_rpc_flush(const struct device *dev);
+
+/**
+ * @brief Get the statistics of the pipelined writes.
+ *
+ * @param[out] stats Statistics.
+ * @param reset Reset the statistics after reading them.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL @p stats is NULL.
+ * @retval -ENOTSUP Statistics are disabled.
+ */
+int flash_rpc_stats_get(struct flash_rpc_stats *stats, bool reset);
+
 #ifdef __cplusplus
 }
 #endif
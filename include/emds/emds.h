@@ -14,6 +14,7 @@
 #ifndef EMDS_H__
 #define EMDS_H__
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <sys/types.h>
 #include <zephyr/sys/util.h>
@@ -35,6 +36,11 @@ struct emds_entry {
 	uint8_t *data;
 	/** Length of data that will be stored. */
 	size_t len;
+	/** Store the entry in delta snapshots only when it is marked with
+	 *  @ref emds_entry_dirty_set. Entries without dirty tracking are stored
+	 *  in every snapshot.
+	 */
+	bool dirty_tracking;
 };
 
 /**
@@ -66,6 +72,27 @@ struct emds_dynamic_entry {
 		.len = _len,                                                   \
 	}
 
+/**
+ * @brief Define a static entry with dirty tracking.
+ *
+ * Same as @ref EMDS_STATIC_ENTRY_DEFINE, but with the
+ * @kconfig{CONFIG_EMDS_DELTA_SNAPSHOTS} option enabled, the entry is only
+ * stored in a delta snapshot if it has been marked with
+ * @ref emds_entry_dirty_set since the last snapshot.
+ *
+ * @param _name The entry name.
+ * @param _id Unique ID for the entry.
+ * @param _data Data pointer to be stored at emergency data store.
+ * @param _len Length of data to be stored at emergency data store.
+ */
+#define EMDS_STATIC_TRACKED_ENTRY_DEFINE(_name, _id, _data, _len)              \
+	static const STRUCT_SECTION_ITERABLE(emds_entry, emds_##_name) = {     \
+		.id = _id,                                                     \
+		.data = (uint8_t *)_data,                                      \
+		.len = _len,                                                   \
+		.dirty_tracking = true,                                        \
+	}
+
 /**
  * @typedef emds_store_cb_t
  * @brief Callback for application commands when storing has been executed.
@@ -110,6 +137,32 @@ int emds_init(emds_store_cb_t cb);
  */
 int emds_entry_add(struct emds_dynamic_entry *entry);
 
+/**
+ * @brief Mark an entry as changed since the last snapshot.
+ *
+ * With the @kconfig{CONFIG_EMDS_DELTA_SNAPSHOTS} option enabled, @ref emds_store
+ * only writes the entries with dirty tracking that are marked as changed since
+ * the last stored snapshot, and all the entries without dirty tracking. The
+ * application must call this function every time it changes the data of an
+ * entry with dirty tracking. The function can be called from an interrupt
+ * context.
+ *
+ * When the changed entries exceed @kconfig{CONFIG_EMDS_DELTA_DIRTY_BYTES_MAX},
+ * the function submits the compaction of the delta snapshots into a new full
+ * snapshot to the system workqueue. @ref emds_store is not available until
+ * the compaction is finished.
+ *
+ * For entries without dirty tracking, or without delta snapshots, the function
+ * only checks that the entry exists.
+ *
+ * @param id ID of the changed entry.
+ *
+ * @retval 0 Success
+ * @retval -ECANCELED errno code if it was called before @ref emds_init
+ * @retval -ENOENT errno code if there is no entry with the given ID
+ */
+int emds_entry_dirty_set(uint16_t id);
+
 /**
  * @brief Start the emergency data storage process.
  *
@@ -130,6 +183,11 @@ int emds_entry_add(struct emds_dynamic_entry *entry);
  * with MPSL, make sure to uninitialize the MPSL before this function is called.
  * Otherwise, an assertion may be triggered by the exit of the function.
  *
+ * With the @kconfig{CONFIG_EMDS_DELTA_SNAPSHOTS} option enabled, only the
+ * entries without dirty tracking and the entries marked with
+ * @ref emds_entry_dirty_set are stored when @ref emds_prepare has prepared a
+ * delta snapshot.
+ *
  * @retval 0 Success
  * @retval -ERRNO errno code if error
  */
@@ -143,10 +201,17 @@ int emds_store(void);
  * called before the @ref emds_prepare function which will delete all the
  * previously stored data.
  *
+ * If the freshest snapshot is a delta snapshot, the data of the full snapshot
+ * it is chained to is loaded first, followed by the data of all the delta
+ * snapshots in the order they were stored. If one of the delta snapshots is
+ * not valid, only the full snapshot and the delta snapshots stored before it
+ * are loaded, and the next @ref emds_prepare writes a new full snapshot.
+ *
  * @retval 0 Success
  * @retval -ECANCELED errno code if it was called before @ref emds_init
  * @retval -ENOENT errno code if no valid snapshot was found in any partition
- * @retval -EIO errno code if error during reading data
+ * @retval -EIO errno code if error during reading data or if the full snapshot
+ *              of the delta snapshot chain is not valid
  */
 int emds_load(void);
 
@@ -173,9 +238,18 @@ int emds_clear(void);
  * added. After this has been called emergency data storage should be ready to
  * store.
  *
+ * With the @kconfig{CONFIG_EMDS_DELTA_SNAPSHOTS} option enabled, this function
+ * prepares a delta snapshot chained to the freshest snapshot. If there is no
+ * snapshot to chain to, the chain has reached
+ * @kconfig{CONFIG_EMDS_DELTA_CHAIN_MAX} deltas, the changed entries exceed
+ * @kconfig{CONFIG_EMDS_DELTA_DIRTY_BYTES_MAX} or there is no space for the
+ * delta, the current data is written as a new full snapshot first. This write
+ * goes through the flash driver.
+ *
  * @retval 0 Success
  * @retval -ECANCELED errno code if it was called before @ref emds_init and @ref emds_load
  * @retval -ENOENT errno code if no valid snapshot was found in any partition
+ * @retval -ERRNO errno code if writing the full snapshot failed
  */
 int emds_prepare(void);
 
@@ -186,6 +260,13 @@ int emds_prepare(void);
  * registered in the entries. This value is dependent on the chip used, and
  * should be checked against the chip datasheet.
  *
+ * With the @kconfig{CONFIG_EMDS_DELTA_SNAPSHOTS} option enabled, the estimate
+ * covers the entries without dirty tracking and
+ * @kconfig{CONFIG_EMDS_DELTA_DIRTY_BYTES_MAX} of changed entries, plus the
+ * largest entry with dirty tracking, since the entry that exceeds the budget
+ * is stored if the power fails before the compaction starts. The estimate is
+ * never bigger than the time needed to store all entries.
+ *
  * @param store_time_us Pointer to a variable where the estimated time (in microseconds)
  *                      will be stored.
  *
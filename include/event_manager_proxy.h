@@ -23,6 +23,30 @@
  * @{
  */
 
+/**
+ * @brief Event forwarding statistics of a single remote.
+ */
+struct event_manager_proxy_stats {
+	/** Number of events sent to the remote. */
+	uint32_t forwarded;
+
+	/** Number of events that could not be sent to the remote. */
+	uint32_t dropped;
+
+	/** Number of IPC messages used to send the events. */
+	uint32_t messages;
+
+	/** Average time from the event processing until it is passed to the IPC service,
+	 *  in microseconds.
+	 */
+	uint32_t latency_avg_us;
+
+	/** Maximum time from the event processing until it is passed to the IPC service,
+	 *  in microseconds.
+	 */
+	uint32_t latency_max_us;
+};
+
 /**
  * @brief Subscribe for the remote event.
  *
@@ -112,5 +136,19 @@ int event_manager_proxy_start(void);
  */
 int event_manager_proxy_wait_for_remotes(k_timeout_t timeout);
 
+/**
+ * @brief Get the event forwarding statistics of a remote.
+ *
+ * @param instance Remote IPC instance.
+ * @param stats    Statistics of the remote.
+ * @param reset    Reset the statistics after reading them.
+ *
+ * @retval 0 On success.
+ * @retval -EINVAL @p stats is NULL.
+ * @retval -ENOENT Given remote instance was not added.
+ */
+int event_manager_proxy_stats_get(const struct device *instance,
+				  struct event_manager_proxy_stats *stats, bool reset);
+
 /** @} */
 #endif /* _EVENT_MANAGER_PROXY_H_ */
@@ -46,6 +46,45 @@ enum log_rpc_level {
 typedef void (*log_rpc_history_handler_t)(enum log_rpc_level level, const char *msg,
 					  size_t msg_len);
 
+/**
+ * @brief Dictionary-based log message handler.
+ *
+ * The type of a callback function that is invoked for each received log message
+ * in the binary dictionary-based format. The message can be decoded on the host
+ * using the Zephyr dictionary logging parser and the log database of the remote
+ * device firmware.
+ *
+ * @param msg		A pointer to the binary message.
+ * @param msg_len	The binary message length.
+ */
+typedef void (*log_rpc_dict_handler_t)(const uint8_t *msg, size_t msg_len);
+
+/**
+ * @brief nRF RPC logging backend statistics.
+ */
+struct log_rpc_stats {
+	/** Number of log messages sent. */
+	uint32_t sent_msgs;
+
+	/** Number of nRF RPC events used to send the log messages. */
+	uint32_t sent_events;
+
+	/** Number of bytes of formatted log messages sent. */
+	uint32_t sent_bytes;
+
+	/** Number of log messages from nRF RPC sources that were not sent. */
+	uint32_t filtered_msgs;
+
+	/** Number of log messages dropped by the logging subsystem. */
+	uint32_t dropped_msgs;
+
+	/** Number of log messages that could not be sent. */
+	uint32_t failed_msgs;
+
+	/** Maximum time spent sending a single nRF RPC event, in microseconds. */
+	uint32_t send_time_max_us;
+};
+
 /** @brief Log history threshold reached handler.
  *
  * The type of a callback function that is invoked when the log history usage
@@ -67,6 +106,31 @@ typedef void (*log_rpc_history_threshold_reached_handler_t)(void);
  */
 void log_rpc_set_stream_level(enum log_rpc_level level);
 
+/**
+ * @brief Sets the dictionary-based log message handler.
+ *
+ * The handler is invoked for each log message received from the remote device
+ * that uses the dictionary-based log output. Such messages are dropped if no
+ * handler is set.
+ *
+ * @param handler	Dictionary-based log message handler, see @ref log_rpc_dict_handler_t.
+ */
+void log_rpc_set_dict_handler(log_rpc_dict_handler_t handler);
+
+/**
+ * @brief Gets the nRF RPC logging backend statistics.
+ *
+ * This function issues an nRF RPC command that fetches the statistics of the
+ * logging backend on the remote device.
+ *
+ * @param stats		Output statistics, see @ref log_rpc_stats.
+ * @param reset		Reset the statistics on the remote device after reading them.
+ *
+ * @retval 0		On success.
+ * @retval -EBADMSG	The response could not be decoded.
+ */
+int log_rpc_get_stats(struct log_rpc_stats *stats, bool reset);
+
 /**
  * @brief Sets the log history verbosity level.
  *
@@ -64,6 +64,16 @@ enum location_req_mode {
 	LOCATION_REQ_MODE_FALLBACK = 0,
 	/** All requested methods are used sequentially. */
 	LOCATION_REQ_MODE_ALL,
+	/**
+	 * GNSS and cloud location (Wi-Fi, cellular or both combined) are used concurrently.
+	 *
+	 * The first location meeting @ref location_config.accuracy_threshold is returned and
+	 * the other method is cancelled. If no location meets the threshold, the most accurate
+	 * location is returned once both methods have completed.
+	 *
+	 * This mode can be used only if @kconfig{CONFIG_LOCATION_REQUEST_MODE_PARALLEL} is set.
+	 */
+	LOCATION_REQ_MODE_PARALLEL,
 };
 
 /** Event IDs. */
@@ -525,6 +535,8 @@ struct location_config {
 	 * these methods are handled together, if the following conditions are met:
 	 *   - Methods are one after the other in location request method list
 	 *   - @ref mode is @ref LOCATION_REQ_MODE_FALLBACK
+	 *
+	 * In @ref LOCATION_REQ_MODE_PARALLEL, Wi-Fi and cellular are always combined.
 	 */
 	struct location_method_config methods[CONFIG_LOCATION_METHODS_LIST_SIZE];
 
@@ -563,6 +575,18 @@ struct location_config {
 	 * location_config_defaults_set() function is called.
 	 */
 	enum location_req_mode mode;
+
+	/**
+	 * @brief Required accuracy (in meters) of the location.
+	 *
+	 * @details In @ref LOCATION_REQ_MODE_PARALLEL, the request completes with the first
+	 * location whose accuracy is this value or better. Cached locations that do not
+	 * meet this accuracy are not used, see @kconfig{CONFIG_LOCATION_RESULT_CACHE}.
+	 *
+	 * Default value is 0, which accepts any accuracy. It is applied when
+	 * location_config_defaults_set() function is called.
+	 */
+	float accuracy_threshold;
 };
 
 /**
@@ -625,6 +649,9 @@ int location_init(location_event_handler_t handler);
  * regardless of the outcome of any previous attempt. Periodic position updates can be
  * stopped by calling location_cancel().
  *
+ * If @kconfig{CONFIG_LOCATION_RESULT_CACHE} is set, a single position request may be
+ * answered with a recently acquired location without running any location method.
+ *
  * @param[in] config Used configuration or NULL to get a single position update with
  *                   the default configuration. Default configuration has the following
  *                   location methods in priority order (if they are enabled in library
@@ -747,6 +774,17 @@ void location_cloud_location_ext_result_set(
 	enum location_ext_result result,
 	struct location_data *location);
 
+/**
+ * @brief Clear the location result cache.
+ *
+ * @details Cached locations are discarded, so the next location request acquires
+ * a new location. This can be used, for example, when the application knows
+ * that the device has moved.
+ *
+ * This function is available only if @kconfig{CONFIG_LOCATION_RESULT_CACHE} is set.
+ */
+void location_cache_clear(void);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -64,6 +64,21 @@ typedef void (*mqtt_helper_on_connack_t)(enum mqtt_conn_return_code return_code,
 typedef void (*mqtt_helper_on_disconnect_t)(int result);
 typedef void (*mqtt_helper_on_publish_t)(struct mqtt_helper_buf topic_buf,
 					 struct mqtt_helper_buf payload_buf);
+
+/** @brief Handler invoked for every chunk of the payload of a received message.
+ *	   If this handler is set, it is used instead of the on_publish handler and the payload
+ *	   size is not limited by CONFIG_MQTT_HELPER_PAYLOAD_BUFFER_LEN.
+ *
+ *  @param topic_buf Topic of the message.
+ *  @param chunk_buf Chunk of the payload, at most CONFIG_MQTT_HELPER_PAYLOAD_BUFFER_LEN bytes.
+ *		     The buffer is only valid until the handler returns.
+ *  @param offset Offset of the chunk in the payload.
+ *  @param total_len Size of the whole payload. The last chunk is the one for which
+ *		     offset + chunk_buf.size equals total_len.
+ */
+typedef void (*mqtt_helper_on_publish_chunk_t)(struct mqtt_helper_buf topic_buf,
+					       struct mqtt_helper_buf chunk_buf,
+					       size_t offset, size_t total_len);
 typedef void (*mqtt_helper_on_puback_t)(uint16_t message_id, int result);
 typedef void (*mqtt_helper_on_suback_t)(uint16_t message_id, int result);
 typedef void (*mqtt_helper_on_pingresp_t)(void);
@@ -75,6 +90,7 @@ struct mqtt_helper_cfg {
 		mqtt_helper_on_connack_t on_connack;
 		mqtt_helper_on_disconnect_t on_disconnect;
 		mqtt_helper_on_publish_t on_publish;
+		mqtt_helper_on_publish_chunk_t on_publish_chunk;
 		mqtt_helper_on_puback_t on_puback;
 		mqtt_helper_on_suback_t on_suback;
 		mqtt_helper_on_pingresp_t on_pingresp;
@@ -136,9 +152,14 @@ int mqtt_helper_disconnect(void);
 int mqtt_helper_subscribe(struct mqtt_subscription_list *sub_list);
 
 /** @brief Publish an MQTT message.
+ *
+ *  If CONFIG_MQTT_HELPER_OUTBOX is enabled, a copy of a QoS 1 message is kept until the broker
+ *  acknowledges it, and the message is sent again after the next successful connection.
  *
  *  @retval 0 if successful.
  *  @retval -EOPNOTSUPP if operation is not supported in the current state.
+ *  @retval -ENOMEM if the outbox is full.
+ *  @retval -EMSGSIZE if the message does not fit in an outbox entry.
  *  @return Otherwise a negative error code.
  */
 int mqtt_helper_publish(const struct mqtt_publish_param *param);
@@ -154,6 +175,9 @@ uint16_t mqtt_helper_msg_id_get(void);
 
 /** @brief Deinitialize library. Must be called when all MQTT operations are done to
  *	   release resources and allow for a new client. The client must be in a disconnected state.
+ *	   The unacknowledged messages in the outbox are dropped from RAM. If
+ *	   CONFIG_MQTT_HELPER_OUTBOX_SETTINGS is enabled, the stored messages are kept and loaded
+ *	   again by the next mqtt_helper_init() call.
  *
  *  @retval 0 if successful.
  *  @retval -EOPNOTSUPP if operation is not supported in the current state.
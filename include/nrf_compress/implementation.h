@@ -75,16 +75,35 @@ typedef int (*nrf_compress_deinit_func_t)(void *inst);
 typedef int (*nrf_compress_reset_func_t)(void *inst, size_t decompressed_size);
 
 /**
- * @typedef		nrf_compress_compress_func_t
- * @brief		Placeholder function for future use, do not use.
+ * @typedef			nrf_compress_compress_func_t
+ * @brief			Compress portion of data. This function will need to be called one
+ *				or more times with uncompressed data to compress it.
  *
- * @param[in] inst	Implementation specific initialization context.
- *			Concrete implementation may cast it to predefined type.
+ * @param[in] inst		Implementation specific initialization context.
+ *				Concrete implementation may cast it to predefined type.
+ * @param[in] input		Input data buffer, containing the uncompressed data. Can be NULL
+ *				if @p input_size is 0.
+ * @param[in] input_size	Size of the input data buffer. Can be 0 only if @p last_part is
+ *				set, to finish the compressed data stream.
+ * @param[in] last_part		Last part of uncompressed data. This should be set to true if
+ *				this is the final part of the input data.
+ * @param[out] offset		Input data offset pointer. This will be updated with the amount of
+ *				bytes used from the input buffer. If this is less than
+ *				@p input_size, the next call to this function should be offset
+ *				the input data buffer by this amount of bytes.
+ * @param[out] output		Output data buffer pointer to pointer. This will be set to the
+ *				compression's output buffer when compressed data is available to
+ *				be used or copied. It is valid until the next call to the
+ *				implementation.
+ * @param[out] output_size	Size of data in output data buffer pointer. Data should only be
+ *				read when the value in this pointer is greater than 0.
  *
- * @retval		0 Success.
- * @retval		-errno Negative errno code on other failure.
+ * @retval			0 Success.
+ * @retval			-errno Negative errno code on other failure.
  */
-typedef int (*nrf_compress_compress_func_t)(void *inst);
+typedef int (*nrf_compress_compress_func_t)(void *inst, const uint8_t *input, size_t input_size,
+					    bool last_part, uint32_t *offset, uint8_t **output,
+					    size_t *output_size);
 
 /**
  * @brief		Return chunk size of data to provide to next call of
@@ -141,6 +160,9 @@ enum nrf_compress_types {
 	/** ARM thumb filter */
 	NRF_COMPRESS_TYPE_ARM_THUMB,
 
+	/** LZ4 frame */
+	NRF_COMPRESS_TYPE_LZ4,
+
 	/** Marks end/count of nRF supported filters */
 	NRF_COMPRESS_TYPE_COUNT,
 
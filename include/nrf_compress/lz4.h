@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file
+ * @brief LZ4 definitions for compression/decompression subsystem
+ */
+
+#ifndef NRF_COMPRESS_LZ4_H_
+#define NRF_COMPRESS_LZ4_H_
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup compression_decompression_subsystem
+ * @{
+ */
+
+/** Size of the LZ4 frame header written by the compressor. */
+#define NRF_COMPRESS_LZ4_FRAME_HEADER_SIZE 7
+
+/** Size of the LZ4 block header holding the block size. */
+#define NRF_COMPRESS_LZ4_BLOCK_HEADER_SIZE 4
+
+/** Size of the LZ4 frame end mark. */
+#define NRF_COMPRESS_LZ4_END_MARK_SIZE 4
+
+/** Worst case size of the compressed data for the given uncompressed data size. */
+#define NRF_COMPRESS_LZ4_COMPRESS_BOUND(size)							\
+	(NRF_COMPRESS_LZ4_FRAME_HEADER_SIZE + NRF_COMPRESS_LZ4_END_MARK_SIZE + (size) +		\
+	 NRF_COMPRESS_LZ4_BLOCK_HEADER_SIZE *							\
+		 (((size) + CONFIG_NRF_COMPRESS_LZ4_BLOCK_SIZE - 1) /				\
+		  CONFIG_NRF_COMPRESS_LZ4_BLOCK_SIZE))
+
+/** Size of the buffers used by the LZ4 compressor. */
+#define NRF_COMPRESS_LZ4_COMPRESS_MEMORY_SIZE							\
+	((sizeof(uint16_t) << CONFIG_NRF_COMPRESS_LZ4_HASH_BITS) +				\
+	 2 * CONFIG_NRF_COMPRESS_LZ4_BLOCK_SIZE + NRF_COMPRESS_LZ4_FRAME_HEADER_SIZE +		\
+	 NRF_COMPRESS_LZ4_BLOCK_HEADER_SIZE + NRF_COMPRESS_LZ4_END_MARK_SIZE)
+
+/** Size of the buffers used by the LZ4 decompressor. */
+#define NRF_COMPRESS_LZ4_DECOMPRESS_MEMORY_SIZE (2 * CONFIG_NRF_COMPRESS_LZ4_BLOCK_SIZE)
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_COMPRESS_LZ4_H_ */
@@ -44,6 +44,51 @@ extern "C" {
  */
 extern void nrf_rpc_uart_initialized_hook(const struct device *uart_dev);
 
+/**
+ * @brief nRF RPC UART transport statistics.
+ */
+struct nrf_rpc_uart_stats {
+	/** Number of sent packets, excluding retransmissions. */
+	uint32_t tx_frames;
+
+	/** Number of bytes in the sent packets, excluding retransmissions. */
+	uint32_t tx_bytes;
+
+	/** Number of packets passed to nRF RPC. */
+	uint32_t rx_frames;
+
+	/** Number of bytes in the packets passed to nRF RPC. */
+	uint32_t rx_bytes;
+
+	/** Number of packets retransmitted because of the acknowledgment timeout. */
+	uint32_t retransmits;
+
+	/** Number of packets dropped after the last transmission attempt. */
+	uint32_t tx_failures;
+
+	/** Number of received frames with an invalid checksum. */
+	uint32_t crc_errors;
+
+	/** Number of received duplicate packets. */
+	uint32_t duplicates;
+
+	/** Number of received bytes dropped because the RX ring buffer was full. */
+	uint32_t rx_overruns;
+};
+
+/**
+ * @brief Gets the statistics of the nRF RPC UART transport.
+ *
+ * @param transport The transport object, for example NRF_RPC_UART_TRANSPORT(DT_NODELABEL(uart1)).
+ * @param[out] stats The statistics of the transport.
+ * @param reset Reset the statistics after reading them.
+ *
+ * @retval 0 On success.
+ * @retval -EINVAL If a parameter is NULL.
+ */
+int nrf_rpc_uart_stats_get(const struct nrf_rpc_tr *transport, struct nrf_rpc_uart_stats *stats,
+			   bool reset);
+
 /**
  * @}
  */
@@ -52,6 +97,7 @@ extern void nrf_rpc_uart_initialized_hook(const struct device *uart_dev);
 	extern const struct nrf_rpc_tr NRF_RPC_UART_TRANSPORT(node_id);
 
 DT_FOREACH_STATUS_OKAY(nordic_nrf_uarte, _NRF_RPC_UART_TRANSPORT_DECLARE);
+DT_FOREACH_STATUS_OKAY(zephyr_uart_emul, _NRF_RPC_UART_TRANSPORT_DECLARE);
 
 #ifdef __cplusplus
 }
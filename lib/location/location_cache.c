@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <modem/location.h>
+#if defined(CONFIG_LTE_LINK_CONTROL)
+#include <modem/lte_lc.h>
+#endif
+
+#include "location_cache.h"
+
+LOG_MODULE_DECLARE(location, CONFIG_LOCATION_LOG_LEVEL);
+
+#define CELL_ID_INVALID UINT32_MAX
+
+struct location_cache_entry {
+	/** Uptime when the location was stored, zero if the entry is not used. */
+	int64_t timestamp;
+	/** Method used to acquire the location. */
+	enum location_method method;
+	/** Serving cell when the location was stored. */
+	uint32_t cell_id;
+	uint32_t tac;
+	struct location_data location;
+};
+
+static struct location_cache_entry cache[CONFIG_LOCATION_RESULT_CACHE_SIZE];
+
+/** Current serving cell, updated from LTE link controller events. */
+static uint32_t current_cell_id = CELL_ID_INVALID;
+static uint32_t current_tac = CELL_ID_INVALID;
+
+static struct k_spinlock cache_lock;
+
+#if defined(CONFIG_LTE_LINK_CONTROL)
+static void location_cache_lte_ind_handler(const struct lte_lc_evt *const evt)
+{
+	k_spinlock_key_t key;
+
+	if (evt->type != LTE_LC_EVT_CELL_UPDATE) {
+		return;
+	}
+
+	key = k_spin_lock(&cache_lock);
+	current_cell_id = evt->cell.id;
+	current_tac = evt->cell.tac;
+	k_spin_unlock(&cache_lock, key);
+}
+#endif
+
+static bool location_cache_method_requested(
+	const struct location_config *config,
+	enum location_method method)
+{
+	for (int i = 0; i < config->methods_count; i++) {
+		enum location_method requested = config->methods[i].method;
+
+		if (requested == method) {
+			return true;
+		}
+		/* Combined Wi-Fi and cellular location is used if either of them is requested */
+		if (method == LOCATION_METHOD_WIFI_CELLULAR &&
+		    (requested == LOCATION_METHOD_WIFI || requested == LOCATION_METHOD_CELLULAR)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void location_cache_store(enum location_method method, const struct location_data *location)
+{
+	struct location_cache_entry *entry = &cache[0];
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&cache_lock);
+
+	/* Replace an unused or the oldest entry */
+	for (int i = 1; i < ARRAY_SIZE(cache) && entry->timestamp != 0; i++) {
+		if (cache[i].timestamp < entry->timestamp) {
+			entry = &cache[i];
+		}
+	}
+
+	entry->timestamp = k_uptime_get();
+	entry->method = method;
+	entry->cell_id = current_cell_id;
+	entry->tac = current_tac;
+	entry->location = *location;
+
+	k_spin_unlock(&cache_lock, key);
+}
+
+bool location_cache_get(const struct location_config *config,
+			enum location_method *method,
+			struct location_data *location)
+{
+	const struct location_cache_entry *found = NULL;
+	int64_t now = k_uptime_get();
+	int64_t age = 0;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&cache_lock);
+
+	/* Without a known serving cell, the device may have moved since the location was stored */
+	for (int i = 0; i < ARRAY_SIZE(cache) && current_cell_id != CELL_ID_INVALID; i++) {
+		const struct location_cache_entry *entry = &cache[i];
+
+		if (entry->timestamp == 0 ||
+		    now - entry->timestamp >= CONFIG_LOCATION_RESULT_CACHE_VALIDITY * MSEC_PER_SEC) {
+			continue;
+		}
+		if (entry->cell_id != current_cell_id || entry->tac != current_tac) {
+			continue;
+		}
+		if (config->accuracy_threshold > 0 &&
+		    entry->location.accuracy > config->accuracy_threshold) {
+			continue;
+		}
+		if (!location_cache_method_requested(config, entry->method)) {
+			continue;
+		}
+		if (found == NULL || entry->timestamp > found->timestamp) {
+			found = entry;
+		}
+	}
+
+	if (found != NULL) {
+		*method = found->method;
+		*location = found->location;
+		age = now - found->timestamp;
+	}
+
+	k_spin_unlock(&cache_lock, key);
+
+	if (found == NULL) {
+		return false;
+	}
+
+	LOG_DBG("Using location cached %lld ms ago", age);
+
+	return true;
+}
+
+void location_cache_clear(void)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&cache_lock);
+	memset(cache, 0, sizeof(cache));
+	k_spin_unlock(&cache_lock, key);
+}
+
+void location_cache_init(void)
+{
+#if defined(CONFIG_LTE_LINK_CONTROL)
+	lte_lc_register_handler(location_cache_lte_ind_handler);
+#endif
+}
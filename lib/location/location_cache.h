@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef LOCATION_CACHE_H
+#define LOCATION_CACHE_H
+
+#include <modem/location.h>
+
+/**
+ * @brief Initialize the location result cache.
+ */
+void location_cache_init(void);
+
+/**
+ * @brief Store an acquired location into the cache.
+ *
+ * @details The location is stored together with the current uptime and LTE cell.
+ * The oldest entry is replaced if the cache is full.
+ *
+ * @param method Method used to acquire the location.
+ * @param location Acquired location.
+ */
+void location_cache_store(enum location_method method, const struct location_data *location);
+
+/**
+ * @brief Find a cached location usable for the given location request.
+ *
+ * @details A cached location is usable if it has not expired, it was acquired in the current
+ * LTE cell with one of the requested methods and it meets the requested accuracy.
+ *
+ * @param config Location request configuration.
+ * @param method Method that was used to acquire the cached location.
+ * @param location Cached location.
+ *
+ * @retval true      Usable location found.
+ * @retval false     No usable location in the cache.
+ */
+bool location_cache_get(const struct location_config *config,
+			enum location_method *method,
+			struct location_data *location);
+
+#endif /* LOCATION_CACHE_H */
@@ -24,6 +24,9 @@
 #if defined(CONFIG_LOCATION_METHOD_CELLULAR) || defined(CONFIG_LOCATION_METHOD_WIFI)
 #include "method_cloud_location.h"
 #endif
+#if defined(CONFIG_LOCATION_RESULT_CACHE)
+#include "location_cache.h"
+#endif
 
 LOG_MODULE_DECLARE(location, CONFIG_LOCATION_LOG_LEVEL);
 
@@ -40,6 +43,19 @@ K_THREAD_STACK_DEFINE(location_core_stack, LOCATION_CORE_STACK_SIZE);
 /** Work queue for location library. Location methods can run their tasks in it. */
 static struct k_work_q location_core_work_q;
 
+#if defined(CONFIG_LOCATION_REQUEST_MODE_PARALLEL)
+K_THREAD_STACK_DEFINE(location_core_cloud_stack, LOCATION_CORE_STACK_SIZE);
+
+/**
+ * Work queue for cloud location. GNSS may block the library work queue while waiting for
+ * LTE to become idle, so cloud location needs its own work queue to run concurrently.
+ */
+static struct k_work_q location_core_cloud_work_q;
+
+/** Spinlock protecting the state of concurrently running methods. */
+static struct k_spinlock location_core_parallel_lock;
+#endif
+
 /** Handler for periodic location requests. */
 static void location_core_periodic_work_fn(struct k_work *work);
 
@@ -64,6 +80,14 @@ static void location_core_event_cb_fn(struct k_work *work);
 /** Work item for location event callback. */
 K_WORK_DEFINE(location_event_cb_work, location_core_event_cb_fn);
 
+#if defined(CONFIG_LOCATION_REQUEST_MODE_PARALLEL)
+/** Handler for the outcomes of concurrently running methods. */
+static void location_core_parallel_work_fn(struct k_work *work);
+
+/** Work item for handling the outcomes of concurrently running methods. */
+K_WORK_DEFINE(location_core_parallel_work, location_core_parallel_work_fn);
+#endif
+
 /** Semaphore protecting the use of location requests. */
 K_SEM_DEFINE(location_core_sem, 1, 1);
 
@@ -213,6 +237,11 @@ int location_core_init(void)
 	struct k_work_queue_config cfg = {
 		.name = "location_api_workq",
 	};
+#if defined(CONFIG_LOCATION_REQUEST_MODE_PARALLEL)
+	struct k_work_queue_config cloud_cfg = {
+		.name = "location_cloud_workq",
+	};
+#endif
 
 	/* location_core_work_q shall not be used in method init functions.
 	 * It's initialized after methods because a second initialization after
@@ -240,6 +269,18 @@ int location_core_init(void)
 		LOCATION_CORE_PRIORITY,
 		&cfg);
 
+#if defined(CONFIG_LOCATION_REQUEST_MODE_PARALLEL)
+	k_work_queue_start(
+		&location_core_cloud_work_q,
+		location_core_cloud_stack,
+		K_THREAD_STACK_SIZEOF(location_core_cloud_stack),
+		LOCATION_CORE_PRIORITY,
+		&cloud_cfg);
+#endif
+#if defined(CONFIG_LOCATION_RESULT_CACHE)
+	location_cache_init();
+#endif
+
 	return 0;
 }
 
@@ -255,6 +296,18 @@ int location_core_validate_params(const struct location_config *config)
 		return -EINVAL;
 	}
 
+	if (config->mode == LOCATION_REQ_MODE_PARALLEL &&
+	    !IS_ENABLED(CONFIG_LOCATION_REQUEST_MODE_PARALLEL)) {
+		LOG_ERR("LOCATION_REQ_MODE_PARALLEL requires "
+			"CONFIG_LOCATION_REQUEST_MODE_PARALLEL");
+		return -EINVAL;
+	}
+
+	if (config->accuracy_threshold < 0) {
+		LOG_ERR("Invalid accuracy threshold");
+		return -EINVAL;
+	}
+
 	for (int i = 0; i < config->methods_count; i++) {
 		if (config->methods[i].method == LOCATION_METHOD_WIFI_CELLULAR) {
 			LOG_ERR("LOCATION_METHOD_WIFI_CELLULAR cannot be given in location config");
@@ -266,6 +319,16 @@ int location_core_validate_params(const struct location_config *config)
 			LOG_ERR("Location method (%d) not supported", config->methods[i].method);
 			return -EINVAL;
 		}
+		/* Concurrently running methods must be different */
+		if (config->mode == LOCATION_REQ_MODE_PARALLEL) {
+			for (int j = 0; j < i; j++) {
+				if (config->methods[j].method == config->methods[i].method) {
+					LOG_ERR("Location method (%d) given twice",
+						config->methods[i].method);
+					return -EINVAL;
+				}
+			}
+		}
 	}
 	return 0;
 }
@@ -282,6 +345,9 @@ void location_core_config_log(const struct location_config *config)
 	LOG_DBG("  Interval: %d", config->interval);
 	LOG_DBG("  Timeout: %dms", config->timeout);
 	LOG_DBG("  Mode: %d", config->mode);
+	if (config->mode == LOCATION_REQ_MODE_PARALLEL) {
+		LOG_DBG("  Accuracy threshold: %dm", (int)config->accuracy_threshold);
+	}
 	LOG_DBG("  List of methods:");
 
 	for (uint8_t i = 0; i < config->methods_count; i++) {
@@ -325,6 +391,112 @@ static void location_core_current_config_set(const struct location_config *confi
 	memcpy(&loc_req_info.config, config, sizeof(loc_req_info.config));
 }
 
+#if defined(CONFIG_LOCATION_RESULT_CACHE)
+static bool location_core_cached_location_get(void)
+{
+	enum location_method method;
+	struct location_data location;
+
+	/* Periodic requests and LOCATION_REQ_MODE_ALL always run the methods */
+	if (loc_req_info.config.interval > 0 ||
+	    loc_req_info.config.mode == LOCATION_REQ_MODE_ALL) {
+		return false;
+	}
+
+	if (!location_cache_get(&loc_req_info.config, &method, &location)) {
+		return false;
+	}
+
+	location_core_current_event_data_init(method);
+	loc_req_info.cached = true;
+	loc_req_info.execute_fallback = false;
+	loc_req_info.current_event_data.id = LOCATION_EVT_LOCATION;
+	loc_req_info.current_event_data.location = location;
+
+	k_work_submit_to_queue(&location_core_work_q, &location_event_cb_work);
+
+	return true;
+}
+#endif
+
+#if defined(CONFIG_LOCATION_REQUEST_MODE_PARALLEL)
+static int location_core_parallel_start(void)
+{
+	int err;
+	int count = 0;
+	k_spinlock_key_t key;
+
+	/* Cloud location is started last so that current_method refers to it when
+	 * the cloud location request is handled.
+	 */
+	key = k_spin_lock(&location_core_parallel_lock);
+	for (int i = 0; i < loc_req_info.methods_count; i++) {
+		if (loc_req_info.methods[i] == LOCATION_METHOD_GNSS) {
+			loc_req_info.parallel[count++].method = LOCATION_METHOD_GNSS;
+		}
+	}
+	for (int i = 0; i < loc_req_info.methods_count; i++) {
+		if (loc_req_info.methods[i] != LOCATION_METHOD_GNSS) {
+			loc_req_info.parallel[count++].method = loc_req_info.methods[i];
+		}
+	}
+	for (int i = 0; i < count; i++) {
+		memset(&loc_req_info.parallel[i].event_data, 0,
+		       sizeof(loc_req_info.parallel[i].event_data));
+		loc_req_info.parallel[i].running = true;
+	}
+	loc_req_info.parallel_count = count;
+	k_spin_unlock(&location_core_parallel_lock, key);
+
+	for (int i = 0; i < count; i++) {
+		struct location_parallel_method *parallel = &loc_req_info.parallel[i];
+
+		LOG_DBG("Requesting location with '%s' method concurrently",
+			(char *)location_method_api_get(parallel->method)->method_string);
+
+		location_core_current_event_data_init(parallel->method);
+		parallel->start_timestamp = loc_req_info.elapsed_time_method_start_timestamp;
+
+		err = location_method_api_get(parallel->method)->location_get(&loc_req_info);
+		if (err != 0) {
+			key = k_spin_lock(&location_core_parallel_lock);
+			loc_req_info.parallel_count = 0;
+			k_spin_unlock(&location_core_parallel_lock, key);
+
+			/* Stop the methods that have already been started */
+			for (int j = 0; j < i; j++) {
+				(void)location_method_api_get(
+					loc_req_info.parallel[j].method)->cancel();
+			}
+			return err;
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_LOCATION_DATA_DETAILS)) {
+		for (int i = 0; i < count; i++) {
+			struct location_event_data request_started = {
+				.id = LOCATION_EVT_STARTED,
+				.method = loc_req_info.parallel[i].method
+			};
+
+			location_utils_event_dispatch(&request_started);
+		}
+	}
+
+	return 0;
+}
+#endif
+
+static void location_core_request_timer_start(void)
+{
+	if (loc_req_info.config.timeout != SYS_FOREVER_MS &&
+	    loc_req_info.config.timeout > 0) {
+		LOG_DBG("Starting request timer with timeout=%d", loc_req_info.config.timeout);
+
+		k_work_schedule(&location_core_timeout_work, K_MSEC(loc_req_info.config.timeout));
+	}
+}
+
 static int location_core_location_get_pos(void)
 {
 	int err;
@@ -336,6 +508,25 @@ static int location_core_location_get_pos(void)
 		k_uptime_get() + loc_req_info.config.timeout : SYS_FOREVER_MS;
 	loc_req_info.execute_fallback = true;
 	loc_req_info.current_method_index = 0;
+	loc_req_info.cached = false;
+
+#if defined(CONFIG_LOCATION_RESULT_CACHE)
+	if (location_core_cached_location_get()) {
+		return 0;
+	}
+#endif
+#if defined(CONFIG_LOCATION_REQUEST_MODE_PARALLEL)
+	if (loc_req_info.config.mode == LOCATION_REQ_MODE_PARALLEL) {
+		err = location_core_parallel_start();
+		if (err != 0) {
+			return err;
+		}
+
+		location_core_request_timer_start();
+		return 0;
+	}
+#endif
+
 	requested_method = loc_req_info.methods[loc_req_info.current_method_index];
 	LOG_DBG("Requesting location with '%s' method",
 		(char *)location_method_api_get(requested_method)->method_string);
@@ -355,12 +546,7 @@ static int location_core_location_get_pos(void)
 		location_utils_event_dispatch(&request_started);
 	}
 
-	if (loc_req_info.config.timeout != SYS_FOREVER_MS &&
-	    loc_req_info.config.timeout > 0) {
-		LOG_DBG("Starting request timer with timeout=%d", loc_req_info.config.timeout);
-
-		k_work_schedule(&location_core_timeout_work, K_MSEC(loc_req_info.config.timeout));
-	}
+	location_core_request_timer_start();
 
 	return 0;
 }
@@ -403,6 +589,9 @@ static void location_request_info_create(const struct location_config *config)
 			LOG_DBG("Wi-Fi and cellular methods are not one after the other "
 				"in method list so they are not combined");
 		}
+	} else if (loc_req_info.config.mode == LOCATION_REQ_MODE_PARALLEL) {
+		/* Wi-Fi and cellular share the cloud location method so they are always combined */
+		combine_wifi_cell = loc_req_info.cellular != NULL && loc_req_info.wifi != NULL;
 	}
 
 	/* Compose a list of methods that are really used, including combined internal method */
@@ -461,18 +650,118 @@ int location_core_location_get(const struct location_config *config)
 	return location_core_location_get_pos();
 }
 
-void location_core_event_cb_error(void)
+#if defined(CONFIG_LOCATION_REQUEST_MODE_PARALLEL)
+/**
+ * Store the outcome of a concurrently running method.
+ *
+ * Returns true if the outcome was handled, that is, LOCATION_REQ_MODE_PARALLEL is used.
+ */
+static bool location_core_parallel_result(
+	enum location_method method,
+	enum location_event_id id,
+	const struct location_data *location)
 {
+	struct location_parallel_method *parallel = NULL;
+	k_spinlock_key_t key;
+
+	if (loc_req_info.config.mode != LOCATION_REQ_MODE_PARALLEL) {
+		return false;
+	}
+
+	key = k_spin_lock(&location_core_parallel_lock);
+	for (int i = 0; i < loc_req_info.parallel_count; i++) {
+		if (loc_req_info.parallel[i].method == method && loc_req_info.parallel[i].running) {
+			parallel = &loc_req_info.parallel[i];
+			break;
+		}
+	}
+	if (parallel != NULL) {
+		parallel->running = false;
+		parallel->event_data.id = id;
+		parallel->event_data.method = method;
+		if (location != NULL) {
+			parallel->event_data.location = *location;
+		}
+	}
+	k_spin_unlock(&location_core_parallel_lock, key);
+
+	if (parallel == NULL) {
+		LOG_DBG("Ignoring event %d from '%s' method that is not running",
+			id, (char *)location_method_api_get(method)->method_string);
+		return true;
+	}
+
+	/* Using system work queue, like the method timeout, because GNSS may block the library
+	 * work queue while waiting for LTE to become idle. The method that is still running
+	 * must be cancelled without waiting for it.
+	 */
+	k_work_submit(&location_core_parallel_work);
+
+	return true;
+}
+
+/**
+ * Stop all concurrently running methods. If timeout is set, the methods end with
+ * LOCATION_EVT_TIMEOUT.
+ */
+static void location_core_parallel_stop(bool timeout)
+{
+	enum location_method stopped[LOCATION_PARALLEL_METHODS_MAX];
+	int count = 0;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&location_core_parallel_lock);
+	for (int i = 0; i < loc_req_info.parallel_count; i++) {
+		if (loc_req_info.parallel[i].running) {
+			loc_req_info.parallel[i].running = false;
+			loc_req_info.parallel[i].event_data.id = LOCATION_EVT_TIMEOUT;
+			loc_req_info.parallel[i].event_data.method = loc_req_info.parallel[i].method;
+			stopped[count++] = loc_req_info.parallel[i].method;
+		}
+	}
+	k_spin_unlock(&location_core_parallel_lock, key);
+
+	for (int i = 0; i < count; i++) {
+		const struct location_method_api *method_api = location_method_api_get(stopped[i]);
+
+		LOG_DBG("Stopping '%s' method", (char *)method_api->method_string);
+		if (timeout) {
+			(void)method_api->timeout();
+		} else {
+			(void)method_api->cancel();
+		}
+	}
+}
+#else
+static bool location_core_parallel_result(
+	enum location_method method,
+	enum location_event_id id,
+	const struct location_data *location)
+{
+	return false;
+}
+#endif
+
+void location_core_event_cb_error(enum location_method method)
+{
+	if (location_core_parallel_result(method, LOCATION_EVT_ERROR, NULL)) {
+		return;
+	}
+
 	loc_req_info.current_event_data.id = LOCATION_EVT_ERROR;
 
-	location_core_event_cb(NULL);
+	location_core_event_cb(method, NULL);
 }
 
-void location_core_event_cb_timeout(void)
+void location_core_event_cb_timeout(enum location_method method)
 {
+	if (location_core_parallel_result(method, LOCATION_EVT_TIMEOUT, NULL)) {
+		return;
+	}
+
 	loc_req_info.current_event_data.id = LOCATION_EVT_TIMEOUT;
 
-	location_core_event_cb(NULL);
+	location_core_event_cb(method, NULL);
 }
 
 #if defined(CONFIG_LOCATION_SERVICE_EXTERNAL) && defined(CONFIG_NRF_CLOUD_AGNSS)
@@ -547,6 +836,15 @@ void location_core_cloud_location_ext_result_set(
 		result == LOCATION_EXT_RESULT_SUCCESS ? "success" :
 		result == LOCATION_EXT_RESULT_UNKNOWN ? "unknown" : "error");
 
+	if (location_core_parallel_result(
+		loc_req_info.current_method,
+		result == LOCATION_EXT_RESULT_SUCCESS ? LOCATION_EVT_LOCATION :
+		result == LOCATION_EXT_RESULT_UNKNOWN ? LOCATION_EVT_RESULT_UNKNOWN :
+		LOCATION_EVT_ERROR,
+		result == LOCATION_EXT_RESULT_SUCCESS ? location : NULL)) {
+		return;
+	}
+
 	switch (result) {
 	case LOCATION_EXT_RESULT_SUCCESS:
 		loc_req_info.current_event_data.id = LOCATION_EVT_LOCATION;
@@ -567,10 +865,12 @@ void location_core_cloud_location_ext_result_set(
 }
 #endif
 
-static void location_core_event_details_get(struct location_event_data *event)
+static void location_core_event_details_get(
+	struct location_event_data *event,
+	int64_t method_start_timestamp)
 {
 #if defined(CONFIG_LOCATION_DATA_DETAILS)
-	if (location_method_api_get(loc_req_info.current_method)->details_get != NULL) {
+	if (location_method_api_get(event->method)->details_get != NULL) {
 
 		struct location_data_details *details;
 
@@ -580,60 +880,198 @@ static void location_core_event_details_get(struct location_event_data *event)
 			details = &event->error.details;
 		}
 
-		location_method_api_get(loc_req_info.current_method)->details_get(details);
+		location_method_api_get(event->method)->details_get(details);
 
 		details->elapsed_time_method = (uint32_t)
-			(k_uptime_get() - loc_req_info.elapsed_time_method_start_timestamp);
+			(k_uptime_get() - method_start_timestamp);
 	}
 #endif
 }
 
-static void location_core_event_cb_fn(struct k_work *work)
+/** Log the acquired location and store it into the location result cache. */
+static void location_core_location_acquired(const struct location_event_data *event)
 {
 	char latitude_str[12];
 	char longitude_str[12];
 	char accuracy_str[12];
+
+	LOG_DBG("Location acquired successfully%s:", loc_req_info.cached ? " from cache" : "");
+	LOG_DBG("  method: %s (%d)", (char *)location_method_api_get(
+		event->method)->method_string,
+		event->method);
+	/* Logging v1 doesn't support double and float logging. Logging v2 would support
+	 * but that's up to application to configure.
+	 */
+	sprintf(latitude_str, "%.06f", event->location.latitude);
+	LOG_DBG("  latitude: %s", latitude_str);
+	sprintf(longitude_str, "%.06f", event->location.longitude);
+	LOG_DBG("  longitude: %s", longitude_str);
+	sprintf(accuracy_str, "%.01f", (double)event->location.accuracy);
+	LOG_DBG("  accuracy: %s m", accuracy_str);
+	if (event->location.datetime.valid) {
+		LOG_DBG("  date: %04d-%02d-%02d",
+			event->location.datetime.year,
+			event->location.datetime.month,
+			event->location.datetime.day);
+		LOG_DBG("  time: %02d:%02d:%02d.%03d UTC",
+			event->location.datetime.hour,
+			event->location.datetime.minute,
+			event->location.datetime.second,
+			event->location.datetime.ms);
+	}
+	LOG_DBG("  Google maps URL: https://maps.google.com/?q=%s,%s",
+		latitude_str, longitude_str);
+
+#if defined(CONFIG_LOCATION_RESULT_CACHE)
+	if (!loc_req_info.cached) {
+		location_cache_store(event->method, &event->location);
+	}
+#endif
+}
+
+/** Send the final event of the location request and continue with the next periodic request. */
+static void location_core_request_done(const struct location_event_data *event)
+{
+	location_utils_event_dispatch(event);
+
+	k_work_cancel_delayable(&location_core_timeout_work);
+
+	if (loc_req_info.config.interval > 0) {
+		k_work_schedule_for_queue(
+			location_core_work_queue_get(),
+			&location_periodic_work,
+			K_SECONDS(loc_req_info.config.interval));
+	} else {
+		location_core_current_config_clear();
+
+		k_sem_give(&location_core_sem);
+	}
+}
+
+#if defined(CONFIG_LOCATION_REQUEST_MODE_PARALLEL)
+static bool location_core_parallel_accuracy_met(const struct location_parallel_method *parallel)
+{
+	return parallel->event_data.id == LOCATION_EVT_LOCATION &&
+	       (loc_req_info.config.accuracy_threshold == 0 ||
+		parallel->event_data.location.accuracy <= loc_req_info.config.accuracy_threshold);
+}
+
+/**
+ * Handle the outcomes of concurrently running methods. The request completes with the first
+ * location meeting the accuracy threshold. Otherwise, the request completes once all methods
+ * are done, with the most accurate location or, if there is none, with a failure.
+ * Timeout has priority over other failures.
+ */
+static void location_core_parallel_work_fn(struct k_work *work)
+{
+	struct location_parallel_method *done = NULL;
+	struct location_parallel_method *best = NULL;
+	struct location_parallel_method *failed = NULL;
+	bool running = false;
+	bool timer_method_done = false;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(work);
+
+	key = k_spin_lock(&location_core_parallel_lock);
+	for (int i = 0; i < loc_req_info.parallel_count; i++) {
+		struct location_parallel_method *parallel = &loc_req_info.parallel[i];
+
+		if (parallel->running) {
+			running = true;
+		} else if (location_core_parallel_accuracy_met(parallel)) {
+			if (done == NULL ||
+			    parallel->event_data.location.accuracy <
+			    done->event_data.location.accuracy) {
+				done = parallel;
+			}
+		} else if (parallel->event_data.id == LOCATION_EVT_LOCATION) {
+			if (best == NULL ||
+			    parallel->event_data.location.accuracy <
+			    best->event_data.location.accuracy) {
+				best = parallel;
+			}
+		} else if (failed == NULL || parallel->event_data.id == LOCATION_EVT_TIMEOUT) {
+			failed = parallel;
+		}
+
+		if (!parallel->running && parallel->method == loc_req_info.timer_method) {
+			timer_method_done = true;
+		}
+	}
+	k_spin_unlock(&location_core_parallel_lock, key);
+
+	if (timer_method_done) {
+		k_work_cancel_delayable(&location_core_method_timeout_work);
+	}
+
+	if (done == NULL) {
+		if (running) {
+			/* Wait for the other methods */
+			return;
+		}
+		done = (best != NULL) ? best : failed;
+		if (done == NULL) {
+			/* Request has already completed */
+			return;
+		}
+	} else if (running) {
+		LOG_INF("LOCATION_REQ_MODE_PARALLEL: acquired location using '%s', "
+			"cancelling other methods",
+			(char *)location_method_api_get(done->method)->method_string);
+
+		location_core_parallel_stop(false);
+	}
+
+	loc_req_info.current_method = done->method;
+	loc_req_info.current_event_data = done->event_data;
+	location_core_event_details_get(&loc_req_info.current_event_data, done->start_timestamp);
+
+	key = k_spin_lock(&location_core_parallel_lock);
+	loc_req_info.parallel_count = 0;
+	k_spin_unlock(&location_core_parallel_lock, key);
+
+	/* Events are sent from the library work queue */
+	k_work_submit_to_queue(&location_core_work_q, &location_event_cb_work);
+}
+#endif
+
+static void location_core_event_cb_fn(struct k_work *work)
+{
 	enum location_method requested_method;
 	int err;
 
+#if defined(CONFIG_LOCATION_REQUEST_MODE_PARALLEL)
+	if (loc_req_info.config.mode == LOCATION_REQ_MODE_PARALLEL && !loc_req_info.cached) {
+		/* Outcome has been selected and details set in location_core_parallel_work_fn() */
+		if (loc_req_info.current_event_data.id == LOCATION_EVT_LOCATION) {
+			location_core_location_acquired(&loc_req_info.current_event_data);
+		} else if (loc_req_info.current_event_data.id != LOCATION_EVT_RESULT_UNKNOWN) {
+			LOG_ERR("Location acquisition failed with all methods");
+		}
+		location_core_request_done(&loc_req_info.current_event_data);
+		return;
+	}
+#endif
+
 	k_work_cancel_delayable(&location_core_method_timeout_work);
 	loc_req_info.current_event_data.method = loc_req_info.current_method;
 
-	/* Update the event structure with the details of the current method */
-	location_core_event_details_get(&loc_req_info.current_event_data);
+	/* Update the event structure with the details of the current method.
+	 * Cached locations have no details.
+	 */
+	if (!loc_req_info.cached) {
+		location_core_event_details_get(
+			&loc_req_info.current_event_data,
+			loc_req_info.elapsed_time_method_start_timestamp);
+	}
 
 	if (loc_req_info.current_event_data.id == LOCATION_EVT_LOCATION) {
 		/* Location was acquired properly.
 		 * Caller sets loc_req_info.current_event_data.location
 		 */
+		location_core_location_acquired(&loc_req_info.current_event_data);
 
-		LOG_DBG("Location acquired successfully:");
-		LOG_DBG("  method: %s (%d)", (char *)location_method_api_get(
-			loc_req_info.current_event_data.method)->method_string,
-			loc_req_info.current_event_data.method);
-		/* Logging v1 doesn't support double and float logging. Logging v2 would support
-		 * but that's up to application to configure.
-		 */
-		sprintf(latitude_str, "%.06f", loc_req_info.current_event_data.location.latitude);
-		LOG_DBG("  latitude: %s", latitude_str);
-		sprintf(longitude_str, "%.06f", loc_req_info.current_event_data.location.longitude);
-		LOG_DBG("  longitude: %s", longitude_str);
-		sprintf(accuracy_str, "%.01f",
-			(double)loc_req_info.current_event_data.location.accuracy);
-		LOG_DBG("  accuracy: %s m", accuracy_str);
-		if (loc_req_info.current_event_data.location.datetime.valid) {
-			LOG_DBG("  date: %04d-%02d-%02d",
-				loc_req_info.current_event_data.location.datetime.year,
-				loc_req_info.current_event_data.location.datetime.month,
-				loc_req_info.current_event_data.location.datetime.day);
-			LOG_DBG("  time: %02d:%02d:%02d.%03d UTC",
-				loc_req_info.current_event_data.location.datetime.hour,
-				loc_req_info.current_event_data.location.datetime.minute,
-				loc_req_info.current_event_data.location.datetime.second,
-				loc_req_info.current_event_data.location.datetime.ms);
-		}
-		LOG_DBG("  Google maps URL: https://maps.google.com/?q=%s,%s",
-			latitude_str, longitude_str);
 		if (loc_req_info.config.mode == LOCATION_REQ_MODE_ALL) {
 			/* Get possible next method */
 			loc_req_info.current_method_index++;
@@ -711,24 +1149,16 @@ static void location_core_event_cb_fn(struct k_work *work)
 		}
 	}
 
-	location_utils_event_dispatch(&loc_req_info.current_event_data);
-
-	k_work_cancel_delayable(&location_core_timeout_work);
-
-	if (loc_req_info.config.interval > 0) {
-		k_work_schedule_for_queue(
-			location_core_work_queue_get(),
-			&location_periodic_work,
-			K_SECONDS(loc_req_info.config.interval));
-	} else {
-		location_core_current_config_clear();
-
-		k_sem_give(&location_core_sem);
-	}
+	location_core_request_done(&loc_req_info.current_event_data);
 }
 
-void location_core_event_cb(const struct location_data *location)
+void location_core_event_cb(enum location_method method, const struct location_data *location)
 {
+	if (location != NULL &&
+	    location_core_parallel_result(method, LOCATION_EVT_LOCATION, location)) {
+		return;
+	}
+
 	if (location) {
 		loc_req_info.current_event_data.id = LOCATION_EVT_LOCATION;
 		loc_req_info.current_event_data.location = *location;
@@ -750,6 +1180,15 @@ struct k_work_q *location_core_work_queue_get(void)
 	return &location_core_work_q;
 }
 
+struct k_work_q *location_core_cloud_work_queue_get(void)
+{
+#if defined(CONFIG_LOCATION_REQUEST_MODE_PARALLEL)
+	return &location_core_cloud_work_q;
+#else
+	return &location_core_work_q;
+#endif
+}
+
 static void location_core_periodic_work_fn(struct k_work *work)
 {
 	ARG_UNUSED(work);
@@ -758,15 +1197,14 @@ static void location_core_periodic_work_fn(struct k_work *work)
 
 static void location_core_method_timeout_work_fn(struct k_work *work)
 {
-	enum location_method current_method =
-		loc_req_info.methods[loc_req_info.current_method_index];
+	enum location_method timer_method = loc_req_info.timer_method;
 
 	ARG_UNUSED(work);
 
 	LOG_INF("Method specific timeout expired");
 
-	location_method_api_get(current_method)->timeout();
-	location_core_event_cb_timeout();
+	location_method_api_get(timer_method)->timeout();
+	location_core_event_cb_timeout(timer_method);
 }
 
 static void location_core_timeout_work_fn(struct k_work *work)
@@ -778,20 +1216,30 @@ static void location_core_timeout_work_fn(struct k_work *work)
 
 	LOG_INF("Timeout for entire location request expired");
 
+#if defined(CONFIG_LOCATION_REQUEST_MODE_PARALLEL)
+	if (loc_req_info.config.mode == LOCATION_REQ_MODE_PARALLEL) {
+		location_core_parallel_stop(true);
+		k_work_submit(&location_core_parallel_work);
+		return;
+	}
+#endif
+
 	location_method_api_get(current_method)->timeout();
 	/* config->timeout needs to expire without fallbacks */
 
 	loc_req_info.current_event_data.id = LOCATION_EVT_TIMEOUT;
 	loc_req_info.execute_fallback = false;
 
-	location_core_event_cb(NULL);
+	location_core_event_cb(current_method, NULL);
 }
 
-void location_core_timer_start(int32_t timeout)
+void location_core_timer_start(enum location_method method, int32_t timeout)
 {
 	if (timeout != SYS_FOREVER_MS && timeout > 0) {
 		LOG_DBG("Starting timer with timeout=%d", timeout);
 
+		loc_req_info.timer_method = method;
+
 		/* Using different work queue that the actual methods are using.
 		 * In this case using system work queue while methods use location_core_work_q.
 		 * If timeout is handled in the same work queue as the methods use for
@@ -813,6 +1261,12 @@ int location_core_cancel(void)
 	k_work_cancel_delayable(&location_periodic_work);
 	k_work_cancel(&location_event_cb_work);
 
+#if defined(CONFIG_LOCATION_REQUEST_MODE_PARALLEL)
+	if (loc_req_info.config.mode == LOCATION_REQ_MODE_PARALLEL) {
+		k_work_cancel(&location_core_parallel_work);
+		location_core_parallel_stop(false);
+	} else
+#endif
 	/* Check if location has been requested using one of the methods */
 	if (current_method != 0) {
 		LOG_DBG("Cancelling location method for '%s' method",
@@ -7,6 +7,25 @@
 #ifndef LOCATION_CORE_H
 #define LOCATION_CORE_H
 
+#if defined(CONFIG_LOCATION_REQUEST_MODE_PARALLEL)
+/** Maximum number of concurrent methods: GNSS and cloud location. */
+#define LOCATION_PARALLEL_METHODS_MAX 2
+
+/** Method running concurrently with other methods in LOCATION_REQ_MODE_PARALLEL. */
+struct location_parallel_method {
+	enum location_method method;
+
+	/** Whether the method is still acquiring location. */
+	bool running;
+
+	/** Outcome of the method, valid when the method is no longer running. */
+	struct location_event_data event_data;
+
+	/** Uptime at the start of the method. */
+	int64_t start_timestamp;
+};
+#endif
+
 /** Information required to carry out a location request. */
 struct location_request_info {
 	const struct location_wifi_config *wifi;
@@ -43,6 +62,19 @@ struct location_request_info {
 	 * This is used in cloud location method to calculate timeout for the cloud operation.
 	 */
 	int64_t timeout_uptime;
+
+	/** Location method using the method timer. */
+	enum location_method timer_method;
+
+	/** Whether the location was taken from the location result cache. */
+	bool cached;
+
+#if defined(CONFIG_LOCATION_REQUEST_MODE_PARALLEL)
+	uint8_t parallel_count;
+
+	/** Concurrently running methods in LOCATION_REQ_MODE_PARALLEL. */
+	struct location_parallel_method parallel[LOCATION_PARALLEL_METHODS_MAX];
+#endif
 };
 
 struct location_method_api {
@@ -63,9 +95,9 @@ int location_core_validate_params(const struct location_config *config);
 int location_core_location_get(const struct location_config *config);
 int location_core_cancel(void);
 
-void location_core_event_cb(const struct location_data *location);
-void location_core_event_cb_error(void);
-void location_core_event_cb_timeout(void);
+void location_core_event_cb(enum location_method method, const struct location_data *location);
+void location_core_event_cb_error(enum location_method method);
+void location_core_event_cb_timeout(enum location_method method);
 #if defined(CONFIG_LOCATION_SERVICE_EXTERNAL) && defined(CONFIG_NRF_CLOUD_AGNSS)
 void location_core_event_cb_agnss_request(const struct nrf_modem_gnss_agnss_data_frame *request);
 #endif
@@ -81,7 +113,8 @@ void location_core_cloud_location_ext_result_set(
 #endif
 
 void location_core_config_log(const struct location_config *config);
-void location_core_timer_start(int32_t timeout);
+void location_core_timer_start(enum location_method method, int32_t timeout);
 struct k_work_q *location_core_work_queue_get(void);
+struct k_work_q *location_core_cloud_work_queue_get(void);
 
 #endif /* LOCATION_CORE_H */
@@ -12,6 +12,7 @@
  */
 
 #include "radio_nrf5.h"
+#include "radio_nrf5_rx_ring.h"
 
 #include <openthread/error.h>
 #define LOG_MODULE_NAME otPlat_nrf5_radio
@@ -107,7 +108,6 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME, CONFIG_OPENTHREAD_PLATFORM_LOG_LEVEL);
 #define LM_IE_SIZE (32) /* Buffer for LM IE: 2 bytes header + 30 bytes content */
 
 enum nrf5_pending_events {
-	PENDING_EVENT_FRAME_RECEIVED,	  /* Radio has received new frame */
 	PENDING_EVENT_RX_FAILED,	  /* The RX failed */
 	PENDING_EVENT_TX_DONE,		  /* Radio transmission finished */
 	PENDING_EVENT_DETECT_ENERGY,	  /* Requested to start Energy Detection procedure */
@@ -158,7 +158,6 @@ struct nrf5_header_ie {
 } __packed;
 
 struct nrf5_rx_frame {
-	void *fifo_reserved; /* 1st word reserved for use by fifo. */
 	uint8_t *psdu;	     /* Pointer to a received frame. The first byte is PHR (length)*/
 	uint64_t time;	     /* RX timestamp. */
 	uint8_t lqi;	     /* Last received frame LQI value. */
@@ -199,12 +198,12 @@ struct nrf5_data {
 
 	struct {
 		/* Buffers for passing received frame pointers and data to the
-		 * RX thread via rx fifo object.
+		 * RX thread. The slots are handed over through the RX ring.
 		 */
 		struct nrf5_rx_frame frames[CONFIG_NRF_802154_RX_BUFFERS];
 
-		/* RX fifo queue. */
-		struct k_fifo fifo;
+		/* RX ring of the frames slots. */
+		struct nrf5_rx_ring ring;
 
 		/* Frame pending bit value in ACK sent for the last received frame. */
 		bool last_frame_ack_fpb;
@@ -607,7 +606,7 @@ void platformRadioInit(void)
 
 	nrf5_get_eui64(nrf5_data.mac);
 
-	k_fifo_init(&nrf5_data.rx.fifo);
+	nrf5_rx_ring_init(&nrf5_data.rx.ring, ARRAY_SIZE(nrf5_data.rx.frames));
 
 	nrf5_data.tx.frame.mPsdu = PSDU_DATA(nrf5_data.tx.psdu);
 #if defined(CONFIG_OPENTHREAD_TIME_SYNC)
@@ -621,34 +620,29 @@ void platformRadioInit(void)
 	nrf5_data.capabilities = nrf5_get_caps();
 }
 
-static void openthread_handle_received_frame(otInstance *instance, struct nrf5_rx_frame *rx_frame)
+static void openthread_handle_received_frame(otInstance *instance, otRadioFrame *recv_frame,
+					    struct nrf5_rx_frame *rx_frame)
 {
-	otRadioFrame recv_frame;
 	uint8_t *psdu;
 
-	ARG_UNUSED(instance);
-
 	__ASSERT_NO_MSG(rx_frame->psdu != NULL);
 
-	memset(&recv_frame, 0, sizeof(otRadioFrame));
-
-	recv_frame.mPsdu = PSDU_DATA(rx_frame->psdu);
+	recv_frame->mPsdu = PSDU_DATA(rx_frame->psdu);
 	/* Length inc. CRC. */
-	recv_frame.mLength = PSDU_LENGTH(rx_frame->psdu);
-	recv_frame.mChannel = nrf5_data.channel;
-	recv_frame.mInfo.mRxInfo.mLqi = rx_frame->lqi;
-	recv_frame.mInfo.mRxInfo.mRssi = rx_frame->rssi;
-	recv_frame.mInfo.mRxInfo.mAckedWithFramePending = rx_frame->ack_fpb;
-	recv_frame.mInfo.mRxInfo.mTimestamp = rx_frame->time;
-	recv_frame.mInfo.mRxInfo.mAckedWithSecEnhAck = rx_frame->ack_seb;
+	recv_frame->mLength = PSDU_LENGTH(rx_frame->psdu);
+	recv_frame->mInfo.mRxInfo.mLqi = rx_frame->lqi;
+	recv_frame->mInfo.mRxInfo.mRssi = rx_frame->rssi;
+	recv_frame->mInfo.mRxInfo.mAckedWithFramePending = rx_frame->ack_fpb;
+	recv_frame->mInfo.mRxInfo.mTimestamp = rx_frame->time;
+	recv_frame->mInfo.mRxInfo.mAckedWithSecEnhAck = rx_frame->ack_seb;
 
-	LOG_DBG("RX %p len: %u, ch: %u, rssi: %d", (void *)recv_frame.mPsdu, recv_frame.mLength,
-		recv_frame.mChannel, recv_frame.mInfo.mRxInfo.mRssi);
+	LOG_DBG("RX %p len: %u, ch: %u, rssi: %d", (void *)recv_frame->mPsdu,
+		recv_frame->mLength, recv_frame->mChannel, recv_frame->mInfo.mRxInfo.mRssi);
 
 	if (IS_ENABLED(CONFIG_OPENTHREAD_DIAG) && otPlatDiagModeGet()) {
-		otPlatDiagRadioReceiveDone(instance, &recv_frame, OT_ERROR_NONE);
+		otPlatDiagRadioReceiveDone(instance, recv_frame, OT_ERROR_NONE);
 	} else {
-		otPlatRadioReceiveDone(instance, &recv_frame, OT_ERROR_NONE);
+		otPlatRadioReceiveDone(instance, recv_frame, OT_ERROR_NONE);
 	}
 
 	psdu = rx_frame->psdu;
@@ -743,11 +737,17 @@ static bool nrf5_tx_at(otRadioFrame *frame, uint8_t *payload)
 
 static void handle_frame_received(otInstance *aInstance)
 {
-	struct nrf5_rx_frame *rx_frame;
+	otRadioFrame recv_frame;
+	int slot;
 
-	while ((rx_frame = (struct nrf5_rx_frame *)k_fifo_get(&nrf5_data.rx.fifo, K_NO_WAIT)) !=
-	       NULL) {
-		openthread_handle_received_frame(aInstance, rx_frame);
+	/* Fields that are not set per frame are shared by the whole batch. */
+	memset(&recv_frame, 0, sizeof(otRadioFrame));
+	recv_frame.mChannel = nrf5_data.channel;
+
+	while ((slot = nrf5_rx_ring_peek(&nrf5_data.rx.ring)) >= 0) {
+		openthread_handle_received_frame(aInstance, &recv_frame,
+						 &nrf5_data.rx.frames[slot]);
+		nrf5_rx_ring_release(&nrf5_data.rx.ring);
 	}
 }
 
@@ -928,8 +928,7 @@ void platformRadioProcess(otInstance *aInstance)
 {
 	bool event_pending = false;
 
-	if (is_pending_event_set(PENDING_EVENT_FRAME_RECEIVED)) {
-		reset_pending_event(PENDING_EVENT_FRAME_RECEIVED);
+	if (!nrf5_rx_ring_is_empty(&nrf5_data.rx.ring)) {
 		handle_frame_received(aInstance);
 	}
 
@@ -1772,30 +1771,29 @@ otError platformRadioTransmitModulatedCarrier(otInstance *aInstance, bool aEnabl
 
 void nrf_802154_received_timestamp_raw(uint8_t *data, int8_t power, uint8_t lqi, uint64_t time)
 {
-	for (uint32_t i = 0; i < ARRAY_SIZE(nrf5_data.rx.frames); i++) {
-		if (nrf5_data.rx.frames[i].psdu != NULL) {
-			continue;
-		}
-
-		nrf5_data.rx.frames[i].psdu = data;
-		nrf5_data.rx.frames[i].rssi = power;
-		nrf5_data.rx.frames[i].lqi = lqi;
-
-		nrf5_data.rx.frames[i].time =
-			nrf_802154_timestamp_end_to_phr_convert(time, data[0]);
+	struct nrf5_rx_frame *rx_frame;
+	int slot = nrf5_rx_ring_acquire(&nrf5_data.rx.ring);
 
-		nrf5_data.rx.frames[i].ack_fpb = nrf5_data.rx.last_frame_ack_fpb;
-		nrf5_data.rx.frames[i].ack_seb = nrf5_data.rx.last_frame_ack_seb;
+	if (slot < 0) {
+		__ASSERT(false, "Not enough rx frames allocated for nrf5 radio");
 		nrf5_data.rx.last_frame_ack_fpb = false;
 		nrf5_data.rx.last_frame_ack_seb = false;
-
-		k_fifo_put(&nrf5_data.rx.fifo, &nrf5_data.rx.frames[i]);
-		set_pending_event(PENDING_EVENT_FRAME_RECEIVED);
-
+		nrf_802154_buffer_free_raw(data);
 		return;
 	}
 
-	__ASSERT(false, "Not enough rx frames allocated for nrf5 radio");
+	rx_frame = &nrf5_data.rx.frames[slot];
+	rx_frame->psdu = data;
+	rx_frame->rssi = power;
+	rx_frame->lqi = lqi;
+	rx_frame->time = nrf_802154_timestamp_end_to_phr_convert(time, data[0]);
+	rx_frame->ack_fpb = nrf5_data.rx.last_frame_ack_fpb;
+	rx_frame->ack_seb = nrf5_data.rx.last_frame_ack_seb;
+	nrf5_data.rx.last_frame_ack_fpb = false;
+	nrf5_data.rx.last_frame_ack_seb = false;
+
+	nrf5_rx_ring_commit(&nrf5_data.rx.ring);
+	otSysEventSignalPending();
 }
 
 void nrf_802154_receive_failed(nrf_802154_rx_error_t error, uint32_t id)
@@ -1953,3 +1951,26 @@ void openthread_platform_radio_set_eui64(uint8_t eui64[EXTENDED_ADDRESS_SIZE])
 {
 	memcpy(nrf5_data.mac, eui64, EXTENDED_ADDRESS_SIZE);
 }
+
+int openthread_platform_radio_rx_stats_get(struct openthread_platform_radio_rx_stats *stats,
+					   bool reset)
+{
+	struct nrf5_rx_ring *ring = &nrf5_data.rx.ring;
+
+	if (stats == NULL) {
+		return -EINVAL;
+	}
+
+	stats->received = ring->received;
+	stats->overflows = ring->overflows;
+	stats->high_watermark = ring->high_watermark;
+	stats->pending = nrf5_rx_ring_count(ring);
+
+	if (reset) {
+		ring->received = 0;
+		ring->overflows = 0;
+		ring->high_watermark = 0;
+	}
+
+	return 0;
+}
@@ -9,8 +9,27 @@
 
 #include <nrf_802154_const.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 
+/* Statistics of the frame reception. */
+struct openthread_platform_radio_rx_stats {
+	/* Number of frames passed to the RX ring. */
+	uint32_t received;
+	/* Number of frames dropped because all RX slots were in use. */
+	uint32_t overflows;
+	/* Highest number of RX slots in use. */
+	uint32_t high_watermark;
+	/* Number of frames waiting for processing. */
+	uint32_t pending;
+};
+
 void openthread_platform_radio_set_eui64(uint8_t eui64[EXTENDED_ADDRESS_SIZE]);
 
+/* Get the frame reception statistics and optionally reset the counters.
+ * Returns -EINVAL if @p stats is NULL.
+ */
+int openthread_platform_radio_rx_stats_get(struct openthread_platform_radio_rx_stats *stats,
+					   bool reset);
+
 #endif /* OT_PLATFORM_RADIO_NRF5_Hz */
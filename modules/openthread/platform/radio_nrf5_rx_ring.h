@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef OT_PLATFORM_RADIO_NRF5_RX_RING_H
+#define OT_PLATFORM_RADIO_NRF5_RX_RING_H
+
+#include <zephyr/sys/atomic.h>
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Single-producer, single-consumer ring of RX slot indices.
+ *
+ * The producer is the radio driver callback and the consumer is the OpenThread
+ * thread. The read and write positions run from 0 to twice the ring size, so
+ * that a full ring can be told apart from an empty one without a spare slot
+ * and without a power of two size requirement.
+ */
+struct nrf5_rx_ring {
+	/* Number of slots. */
+	uint32_t size;
+	/* Write position, only modified by the producer. */
+	atomic_t head;
+	/* Read position, only modified by the consumer. */
+	atomic_t tail;
+	/* Number of committed slots. */
+	uint32_t received;
+	/* Number of slots that could not be acquired because the ring was full. */
+	uint32_t overflows;
+	/* Highest number of slots in use. */
+	uint32_t high_watermark;
+};
+
+static inline uint32_t nrf5_rx_ring_next(const struct nrf5_rx_ring *ring, uint32_t pos)
+{
+	return (pos + 1 == 2 * ring->size) ? 0 : pos + 1;
+}
+
+static inline uint32_t nrf5_rx_ring_index(const struct nrf5_rx_ring *ring, uint32_t pos)
+{
+	return (pos < ring->size) ? pos : pos - ring->size;
+}
+
+static inline uint32_t nrf5_rx_ring_count(const struct nrf5_rx_ring *ring)
+{
+	uint32_t head = (uint32_t)atomic_get(&ring->head);
+	uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+
+	return (head >= tail) ? head - tail : head + 2 * ring->size - tail;
+}
+
+static inline void nrf5_rx_ring_init(struct nrf5_rx_ring *ring, uint32_t size)
+{
+	ring->size = size;
+	atomic_set(&ring->head, 0);
+	atomic_set(&ring->tail, 0);
+	ring->received = 0;
+	ring->overflows = 0;
+	ring->high_watermark = 0;
+}
+
+static inline bool nrf5_rx_ring_is_empty(const struct nrf5_rx_ring *ring)
+{
+	return atomic_get(&ring->head) == atomic_get(&ring->tail);
+}
+
+/* Get the index of the slot to be filled by the producer.
+ * Returns -ENOMEM if all slots are in use.
+ */
+static inline int nrf5_rx_ring_acquire(struct nrf5_rx_ring *ring)
+{
+	if (nrf5_rx_ring_count(ring) == ring->size) {
+		ring->overflows++;
+		return -ENOMEM;
+	}
+
+	return nrf5_rx_ring_index(ring, (uint32_t)atomic_get(&ring->head));
+}
+
+/* Pass the slot filled by the producer to the consumer. */
+static inline void nrf5_rx_ring_commit(struct nrf5_rx_ring *ring)
+{
+	uint32_t count;
+
+	atomic_set(&ring->head, nrf5_rx_ring_next(ring, (uint32_t)atomic_get(&ring->head)));
+
+	count = nrf5_rx_ring_count(ring);
+	ring->received++;
+
+	if (count > ring->high_watermark) {
+		ring->high_watermark = count;
+	}
+}
+
+/* Get the index of the oldest committed slot.
+ * Returns -ENOENT if there are no committed slots.
+ */
+static inline int nrf5_rx_ring_peek(const struct nrf5_rx_ring *ring)
+{
+	if (nrf5_rx_ring_is_empty(ring)) {
+		return -ENOENT;
+	}
+
+	return nrf5_rx_ring_index(ring, (uint32_t)atomic_get(&ring->tail));
+}
+
+/* Return the oldest committed slot to the producer. */
+static inline void nrf5_rx_ring_release(struct nrf5_rx_ring *ring)
+{
+	atomic_set(&ring->tail, nrf5_rx_ring_next(ring, (uint32_t)atomic_get(&ring->tail)));
+}
+
+#endif /* OT_PLATFORM_RADIO_NRF5_RX_RING_H */
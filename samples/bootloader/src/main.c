@@ -122,6 +122,15 @@ static void validate_and_boot(const struct fw_info *fw_info, counter_t slot)
 		}
 	}
 
+#if defined(CONFIG_SB_VALIDATION_MARKER)
+	/* The marker is trusted only if it is written by this bootloader. */
+	err = fprotect_area(PM_B0_MARKER_ADDRESS, PM_B0_MARKER_SIZE);
+	if (err) {
+		printk("Failed to protect the validation marker, cancel boot.\r\n");
+		return;
+	}
+#endif
+
 	bl_boot(fw_info);
 }
 
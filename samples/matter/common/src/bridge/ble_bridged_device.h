@@ -9,16 +9,34 @@
 #include "ble_connectivity_manager.h"
 #include "bridged_device_data_provider.h"
 
+#ifdef CONFIG_BRIDGE_BT_DISCOVERY_CACHE
+#include "ble_discovery_cache.h"
+#endif
+
 #include <bluetooth/gatt_dm.h>
 #include <zephyr/bluetooth/addr.h>
 #include <zephyr/bluetooth/conn.h>
 #include <zephyr/bluetooth/gatt.h>
+#include <zephyr/kernel.h>
 
 namespace Nrf
 {
 
 struct BLEBridgedDeviceProvider;
 
+struct BLEConnectionMetrics {
+	/* Time from creating the last connection until it was established, in milliseconds. */
+	uint32_t mConnectTimeMs;
+	/* Time from creating the last connection until the device was ready to use, in milliseconds. */
+	uint32_t mTimeToReadyMs;
+	/* Maximum time from creating a connection until the device was ready to use, in milliseconds. */
+	uint32_t mTimeToReadyMaxMs;
+	/* Number of times the device became ready to use. */
+	uint32_t mReadyCount;
+	/* Number of times the GATT discovery was skipped thanks to the handles discovered before. */
+	uint32_t mDiscoveryCacheHits;
+};
+
 struct BLEBridgedDevice {
 	bt_addr_le_t mAddr;
 	BLEConnectivityManager::DeviceConnectedCallback mFirstConnectionCallback;
@@ -40,6 +58,83 @@ public:
 	virtual const bt_uuid *GetServiceUuid() = 0;
 	virtual int ParseDiscoveredData(bt_gatt_dm *discoveredData) = 0;
 
+	/**
+	 * @brief Start using the bridged device with the GATT handles obtained during the previous discovery.
+	 *
+	 * The method is called instead of the GATT discovery when the bridged device reconnects. The provider should
+	 * restore the state set up in @ref ParseDiscoveredData, for example, subscribe to the characteristics again.
+	 * The bridged device is reported ready once the provider calls @ref NotifyDiscoveredDataRestored, for
+	 * example, when the subscriptions are confirmed.
+	 *
+	 * @return 0 on success
+	 * @return -ENOTSUP if the provider does not support it and the GATT discovery has to be performed
+	 * @return other negative error code on failure
+	 */
+	virtual int RestoreDiscoveredData() { return -ENOTSUP; }
+
+	/**
+	 * @brief Save the GATT handles obtained during the discovery, so that they can be restored after a reboot.
+	 *
+	 * @param data buffer to be filled with the GATT handles
+	 * @param size reference to the buffer size, to be overridden with the size of the saved data
+	 * @return 0 on success
+	 * @return -ENOTSUP if the provider does not support it
+	 * @return other negative error code on failure
+	 */
+	virtual int SaveDiscoveredData(uint8_t *data, size_t &size) { return -ENOTSUP; }
+
+	/**
+	 * @brief Load the GATT handles saved by @ref SaveDiscoveredData.
+	 *
+	 * @param data buffer with the GATT handles
+	 * @param size size of the data
+	 * @return 0 on success
+	 * @return -ENOTSUP if the provider does not support it
+	 * @return other negative error code on failure
+	 */
+	virtual int LoadDiscoveredData(const uint8_t *data, size_t size) { return -ENOTSUP; }
+
+	/**
+	 * @brief Check if the provider holds valid GATT handles from the previous discovery.
+	 */
+	bool HasDiscoveredData() { return mDiscoveredDataValid; }
+
+	/**
+	 * @brief Mark the GATT handles held by the provider as valid or invalid.
+	 */
+	void SetDiscoveredDataValid(bool valid) { mDiscoveredDataValid = valid; }
+
+	/**
+	 * @brief Get the connection metrics of the bridged device.
+	 */
+	const BLEConnectionMetrics &GetConnectionMetrics() { return mMetrics; }
+
+	/**
+	 * @brief Record that the connection to the bridged device has been requested.
+	 */
+	void MarkConnectionStart() { mConnectionStartTime = k_uptime_get(); }
+
+	/**
+	 * @brief Record that the connection to the bridged device has been established.
+	 */
+	void MarkConnected() { mMetrics.mConnectTimeMs = k_uptime_get() - mConnectionStartTime; }
+
+	/**
+	 * @brief Record that the bridged device is ready to use.
+	 *
+	 * @param cached true if the GATT discovery was skipped
+	 */
+	void MarkReady(bool cached)
+	{
+		mMetrics.mTimeToReadyMs = k_uptime_get() - mConnectionStartTime;
+		mMetrics.mTimeToReadyMaxMs = MAX(mMetrics.mTimeToReadyMaxMs, mMetrics.mTimeToReadyMs);
+		mMetrics.mReadyCount++;
+
+		if (cached) {
+			mMetrics.mDiscoveryCacheHits++;
+		}
+	}
+
 	BLEBridgedDevice &GetBLEBridgedDevice() { return mDevice; }
 	void SetConnectionObject(bt_conn *conn) { mDevice.mConn = conn; }
 	bt_conn *GetConnectionObject() { return mDevice.mConn; }
@@ -117,8 +212,40 @@ public:
 	void NotifySuccessfulRecovery() { mFailedRecoveryAttempts = 0; }
 
 protected:
+	/**
+	 * @brief Inform the manager that the state of the bridged device has been restored.
+	 *
+	 * The method can be called from any thread, also when the data is not being restored.
+	 *
+	 * @param err 0 on success, negative error code if the GATT discovery has to be performed
+	 */
+	void NotifyDiscoveredDataRestored(int err)
+	{
+		BLEConnectivityManager::Instance().DiscoveredDataRestored(this, err);
+	}
+
 	BLEBridgedDevice mDevice = { 0 };
 	uint16_t mFailedRecoveryAttempts = 0;
+	bool mDiscoveredDataValid = false;
+	int64_t mConnectionStartTime = 0;
+	BLEConnectionMetrics mMetrics = {};
+
+private:
+	friend class BLEConnectivityManager;
+
+#ifdef CONFIG_BRIDGE_BT_DISCOVERY_CACHE
+	/* The GATT handles of the previous discovery with the GATT database hash used to validate them. */
+	BLEDiscoveryCacheRecord mDiscoveryCache;
+	bt_gatt_read_params mDbHashReadParams = {};
+	uint8_t mDbHash[BLEDiscoveryCacheRecord::kDbHashSize] = {};
+	/* Size of the GATT database hash read from the device, 0 if it is not available. */
+	uint8_t mDbHashSize = 0;
+	/* The GATT database hash is read to validate the GATT handles before restoring them, not to save them. */
+	bool mDbHashReadToRestore = false;
+	/* The GATT handles have been restored and the manager waits for @ref NotifyDiscoveredDataRestored. */
+	bool mRestorePending = false;
+	int mRestoreError = 0;
+#endif
 };
 
 } /* namespace Nrf */
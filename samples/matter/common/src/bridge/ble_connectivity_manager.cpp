@@ -7,6 +7,10 @@
 #include "ble_connectivity_manager.h"
 #include "ble_bridged_device.h"
 
+#ifdef CONFIG_BRIDGE_BT_DISCOVERY_CACHE
+#include "bridge_storage_manager.h"
+#endif
+
 #include <bluetooth/gatt_dm.h>
 #include <bluetooth/scan.h>
 
@@ -48,6 +52,19 @@ static const struct bt_gatt_dm_cb discovery_cb = { .completed = Nrf::BLEConnecti
 
 static struct bt_conn_le_create_param *create_param = BT_CONN_LE_CREATE_CONN;
 
+namespace
+{
+/* The connection and discovery state is changed from the Bluetooth and Matter threads. The mutex is recursive, so
+ * the state handlers can call each other. */
+K_MUTEX_DEFINE(sStateMutex);
+
+/* RAII utility to lock the connection and discovery state in the current scope. */
+struct StateGuard {
+	StateGuard() { k_mutex_lock(&sStateMutex, K_FOREVER); }
+	~StateGuard() { k_mutex_unlock(&sStateMutex); }
+};
+} /* namespace */
+
 namespace Nrf
 {
 
@@ -88,18 +105,290 @@ void BLEConnectivityManager::FilterMatch(bt_scan_device_info *device_info, bt_sc
 
 int BLEConnectivityManager::StartGattDiscovery(bt_conn *conn, BLEBridgedDeviceProvider *provider)
 {
+#ifdef CONFIG_BRIDGE_BT_DISCOVERY_CACHE
+	if (RestoreGattDiscovery(conn, provider)) {
+		return 0;
+	}
+#endif
+
+	return DiscoverGattService(conn, provider);
+}
+
+int BLEConnectivityManager::DiscoverGattService(bt_conn *conn, BLEBridgedDeviceProvider *provider)
+{
+	StateGuard guard;
+
+	if (Instance().mActiveDiscovery) {
+		/* Another discovery is in progress, this one will be started once it finishes. */
+		if (!Instance().mRecovery.PutProvider(provider, &Instance().mListToDiscover)) {
+			LOG_ERR("Could not queue the discovery procedure");
+			return -ENOMEM;
+		}
+
+		return 0;
+	}
+
+	Instance().mActiveDiscovery = provider;
+
 	/* Start GATT discovery for the device's service UUID. */
 	int err = bt_gatt_dm_start(conn, provider->GetServiceUuid(), &discovery_cb, provider);
 	if (err) {
 		LOG_ERR("Could not start the discovery procedure, error "
 			"code: %d",
 			err);
+		Instance().mActiveDiscovery = nullptr;
 	}
 	return err;
 }
 
+void BLEConnectivityManager::StartNextGattDiscovery()
+{
+	StateGuard guard;
+
+	Instance().mActiveDiscovery = nullptr;
+	Instance().mActiveDiscoveryAborted = false;
+
+	while (!sys_slist_is_empty(&Instance().mListToDiscover)) {
+		BLEBridgedDeviceProvider *provider = Instance().mRecovery.GetProvider(&Instance().mListToDiscover);
+		bt_conn *conn = provider->GetConnectionObject();
+
+		/* The device may have been disconnected while waiting for the discovery. */
+		if (!conn) {
+			continue;
+		}
+
+		/* The queued discoveries have been already checked against the discovery cache. */
+		if (DiscoverGattService(conn, provider) != 0) {
+			DiscoveryError(conn, -EIO, provider);
+		} else if (Instance().mActiveDiscovery) {
+			return;
+		}
+	}
+}
+
+bool BLEConnectivityManager::IsDiscoveryAborted(BLEBridgedDeviceProvider *provider)
+{
+	StateGuard guard;
+
+	return provider == Instance().mActiveDiscovery && Instance().mActiveDiscoveryAborted;
+}
+
+#ifdef CONFIG_BRIDGE_BT_DISCOVERY_CACHE
+bool BLEConnectivityManager::RestoreGattDiscovery(bt_conn *conn, BLEBridgedDeviceProvider *provider)
+{
+	/* Only the GATT handles of bonded devices are cached. */
+	if (!provider->IsInitiallyConnected() || !bt_le_bond_exists(BT_ID_DEFAULT, bt_conn_get_dst(conn))) {
+		return false;
+	}
+
+	/* The cache is handled in the Matter thread, as it may have to be loaded from the persistent storage. */
+	CHIP_ERROR err = DeviceLayer::PlatformMgr().ScheduleWork(RestoreGattDiscoveryHandler,
+								 reinterpret_cast<intptr_t>(provider));
+
+	return err == CHIP_NO_ERROR;
+}
+
+void BLEConnectivityManager::RestoreGattDiscoveryHandler(intptr_t context)
+{
+	BLEBridgedDeviceProvider *provider = reinterpret_cast<BLEBridgedDeviceProvider *>(context);
+
+	/* The provider may have been removed before the work was run. */
+	VerifyOrReturn(Instance().IsProviderConnected(provider));
+	VerifyOrReturn(provider->GetConnectionObject());
+
+	if (!provider->HasDiscoveredData()) {
+		/* The handles are not held in RAM after a reboot, load the ones saved after the last discovery. */
+		BLEDiscoveryCacheRecord &record = provider->mDiscoveryCache;
+
+		if (!BridgeStorageManager::Instance().LoadBtDiscoveryCache(record, provider->GetBtAddress()) ||
+		    provider->LoadDiscoveredData(record.mData, record.mDataSize) != 0) {
+			FallBackToGattDiscovery(provider);
+			return;
+		}
+
+		provider->SetDiscoveredDataValid(true);
+	}
+
+	/* The handles are valid only if the GATT database of the device has not changed since the discovery. */
+	int ret = ReadDbHash(provider, true);
+
+	if (ret != 0) {
+		LOG_WRN("Cannot read the GATT database hash (%d), starting the discovery", ret);
+		FallBackToGattDiscovery(provider);
+	}
+}
+
+void BLEConnectivityManager::FallBackToGattDiscovery(BLEBridgedDeviceProvider *provider)
+{
+	bt_conn *conn = provider->GetConnectionObject();
+
+	provider->SetDiscoveredDataValid(false);
+
+	if (conn && DiscoverGattService(conn, provider) != 0) {
+		DiscoveryError(conn, -EIO, provider);
+	}
+}
+
+void BLEConnectivityManager::SaveGattDiscovery(BLEBridgedDeviceProvider *provider)
+{
+	BLEDiscoveryCacheRecord &record = provider->mDiscoveryCache;
+	size_t size = sizeof(record.mData);
+
+	record.mAddr = provider->GetBtAddress();
+
+	if (provider->mDbHashSize != sizeof(record.mDbHash)) {
+		/* The handles cannot be validated when the device reconnects, so they are not reused. */
+		LOG_INF("The GATT database hash is not available, the GATT discovery will not be skipped");
+		provider->SetDiscoveredDataValid(false);
+		BridgeStorageManager::Instance().RemoveBtDiscoveryCache(record.mAddr);
+		return;
+	}
+
+	memcpy(record.mDbHash, provider->mDbHash, sizeof(record.mDbHash));
+
+	/* If the provider cannot save the handles, they are reused only until the bridge reboots. */
+	VerifyOrReturn(provider->SaveDiscoveredData(record.mData, size) == 0 && size <= sizeof(record.mData));
+	record.mDataSize = size;
+
+	if (!BridgeStorageManager::Instance().StoreBtDiscoveryCache(record)) {
+		LOG_ERR("Cannot store the GATT discovered data");
+	}
+}
+
+int BLEConnectivityManager::ReadDbHash(BLEBridgedDeviceProvider *provider, bool restore)
+{
+	bt_gatt_read_params &params = provider->mDbHashReadParams;
+
+	provider->mDbHashReadToRestore = restore;
+	provider->mDbHashSize = 0;
+
+	params.func = DbHashReadCallback;
+	params.handle_count = 0;
+	params.by_uuid.uuid = BT_UUID_GATT_DB_HASH;
+	params.by_uuid.start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE;
+	params.by_uuid.end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE;
+
+	return bt_gatt_read(provider->GetConnectionObject(), &params);
+}
+
+uint8_t BLEConnectivityManager::DbHashReadCallback(bt_conn *conn, uint8_t err, bt_gatt_read_params *params,
+						   const void *data, uint16_t length)
+{
+	BLEBridgedDeviceProvider *provider = Instance().FindBLEProvider(*bt_conn_get_dst(conn));
+
+	VerifyOrReturnValue(provider, BT_GATT_ITER_STOP);
+
+	if (!err && data && length == sizeof(provider->mDbHash)) {
+		memcpy(provider->mDbHash, data, length);
+		provider->mDbHashSize = length;
+	} else {
+		LOG_DBG("GATT database hash not available, error: %u", err);
+	}
+
+	if (CHIP_NO_ERROR !=
+	    DeviceLayer::PlatformMgr().ScheduleWork(DbHashReadHandler, reinterpret_cast<intptr_t>(provider))) {
+		LOG_ERR("Cannot schedule the GATT database hash handling");
+	}
+
+	return BT_GATT_ITER_STOP;
+}
+
+void BLEConnectivityManager::DbHashReadHandler(intptr_t context)
+{
+	BLEBridgedDeviceProvider *provider = reinterpret_cast<BLEBridgedDeviceProvider *>(context);
+
+	/* The provider may have been removed or disconnected before the work was run. */
+	VerifyOrReturn(Instance().IsProviderConnected(provider));
+	VerifyOrReturn(provider->GetConnectionObject());
+
+	if (!provider->mDbHashReadToRestore) {
+		SaveGattDiscovery(provider);
+		return;
+	}
+
+	const BLEDiscoveryCacheRecord &record = provider->mDiscoveryCache;
+
+	if (!record.Matches(provider->GetBtAddress(), provider->mDbHash, provider->mDbHashSize)) {
+		LOG_INF("The GATT database has changed, starting the discovery");
+		BridgeStorageManager::Instance().RemoveBtDiscoveryCache(provider->GetBtAddress());
+		FallBackToGattDiscovery(provider);
+		return;
+	}
+
+	/* The device is reported ready once the provider confirms that its state has been restored. */
+	provider->mRestorePending = true;
+
+	int ret = provider->RestoreDiscoveredData();
+
+	if (ret != 0) {
+		LOG_WRN("Cannot restore the GATT discovered data (%d), starting the discovery", ret);
+		provider->mRestorePending = false;
+		FallBackToGattDiscovery(provider);
+	}
+}
+
+void BLEConnectivityManager::DiscoveredDataRestoredHandler(intptr_t context)
+{
+	BLEBridgedDeviceProvider *provider = reinterpret_cast<BLEBridgedDeviceProvider *>(context);
+
+	/* The provider may have been removed before the work was run, or its data may not be being restored. */
+	VerifyOrReturn(Instance().IsProviderConnected(provider) && provider->mRestorePending);
+
+	provider->mRestorePending = false;
+
+	VerifyOrReturn(provider->GetConnectionObject());
+
+	if (provider->mRestoreError != 0) {
+		LOG_WRN("Cannot restore the GATT discovered data (%d), starting the discovery",
+			provider->mRestoreError);
+		FallBackToGattDiscovery(provider);
+		return;
+	}
+
+	Instance().mRecovery.RemoveRecovered(provider);
+	provider->NotifySuccessfulRecovery();
+	Instance().NotifyDeviceReady(provider, true);
+
+	if (CHIP_NO_ERROR != provider->NotifyReachableStatusChange(true)) {
+		LOG_WRN("The device has not been notified about the status change.");
+	}
+
+	Instance().UpdateRecovery();
+}
+#endif /* CONFIG_BRIDGE_BT_DISCOVERY_CACHE */
+
+void BLEConnectivityManager::DiscoveredDataRestored(BLEBridgedDeviceProvider *provider, int err)
+{
+#ifdef CONFIG_BRIDGE_BT_DISCOVERY_CACHE
+	provider->mRestoreError = err;
+
+	if (CHIP_NO_ERROR != DeviceLayer::PlatformMgr().ScheduleWork(DiscoveredDataRestoredHandler,
+								     reinterpret_cast<intptr_t>(provider))) {
+		LOG_ERR("Cannot schedule the GATT discovered data handling");
+	}
+#endif /* CONFIG_BRIDGE_BT_DISCOVERY_CACHE */
+}
+
+void BLEConnectivityManager::NotifyDeviceReady(BLEBridgedDeviceProvider *provider, bool cached)
+{
+	char addrStr[BT_ADDR_LE_STR_LEN];
+	bt_addr_le_t addr = provider->GetBtAddress();
+
+	provider->MarkReady(cached);
+	bt_addr_le_to_str(&addr, addrStr, sizeof(addrStr));
+	LOG_INF("Bridged device %s ready in %u ms%s", addrStr, provider->GetConnectionMetrics().mTimeToReadyMs,
+		cached ? " (GATT discovery skipped)" : "");
+}
+
 void BLEConnectivityManager::UpdateRecovery()
 {
+	StateGuard guard;
+
+	if (Instance().mPendingConnection) {
+		/* Another connection is being created, the next one will be scheduled once it is established. */
+		return;
+	}
+
 	if (!sys_slist_is_empty(&Instance().mRecovery.mListToReconnect)) {
 		/* There is another provider to re-connect, schedule this operation. */
 		BLEBridgedDeviceProvider *providerToRecover =
@@ -111,6 +400,9 @@ void BLEConnectivityManager::UpdateRecovery()
 			reinterpret_cast<intptr_t>(providerToRecover));
 		/* We have still a device to recover, keep the LostDevice state active */
 		Instance().UpdateStateFlag(State::LostDevice, true);
+	} else if (Instance().mActiveDiscovery) {
+		/* Connected devices are still being discovered, update the recovery once the discovery finishes. */
+		return;
 	} else if (!sys_slist_is_empty(&Instance().mRecovery.mListToRecover)) {
 		/* There are pending providers to recover and no more scanned ones, schedule next scan operation. */
 		Instance().mRecovery.StartTimer();
@@ -122,6 +414,7 @@ void BLEConnectivityManager::UpdateRecovery()
 
 void BLEConnectivityManager::ConnectionHandler(bt_conn *conn, uint8_t conn_err)
 {
+	StateGuard guard;
 	const bt_addr_le_t *dstAddr = bt_conn_get_dst(conn);
 	BLEBridgedDeviceProvider *provider = nullptr;
 	int err = 0;
@@ -145,10 +438,26 @@ void BLEConnectivityManager::ConnectionHandler(bt_conn *conn, uint8_t conn_err)
 		return;
 	}
 
+	if (Instance().mPendingConnection == provider) {
+		Instance().mPendingConnection = nullptr;
+	}
+
 	/* If there was an error during the initial connection, we should notify the application */
 	bool firstConnFailed = (conn_err && !provider->IsInitiallyConnected());
 	VerifyOrExit(!firstConnFailed, err = conn_err);
 
+	if (conn_err) {
+		/* Reconnection failed, put the device back on the recovery list. */
+		LOG_ERR("The reconnection failed (%u)", conn_err);
+		bt_conn_unref(provider->GetConnectionObject());
+		provider->RemoveConnectionObject();
+		Instance().mRecovery.NotifyProviderToRecover(provider);
+		Instance().UpdateRecovery();
+		return;
+	}
+
+	provider->MarkConnected();
+
 	char addrStr[BT_ADDR_LE_STR_LEN];
 	bt_addr_le_to_str(dstAddr, addrStr, sizeof(addrStr));
 	LOG_INF("Connected: %s", addrStr);
@@ -170,6 +479,9 @@ void BLEConnectivityManager::ConnectionHandler(bt_conn *conn, uint8_t conn_err)
 	VerifyOrExit(err == 0, );
 #endif
 
+	/* Create the next connection while this device is being discovered. */
+	Instance().UpdateRecovery();
+
 	return;
 
 exit:
@@ -350,6 +662,14 @@ void BLEConnectivityManager::DiscoveryCompletedHandler(bt_gatt_dm *dm, void *con
 	const bt_gatt_dm_attr *gatt_service_attr = bt_gatt_dm_service_get(dm);
 	const bt_gatt_service_val *gatt_service = bt_gatt_dm_attr_service_val(gatt_service_attr);
 
+	if (IsDiscoveryAborted(provider)) {
+		/* The provider was removed while the discovery was in progress. */
+		bt_gatt_dm_data_release(dm);
+		StartNextGattDiscovery();
+		Instance().UpdateRecovery();
+		return;
+	}
+
 	VerifyOrExit(provider, );
 	bt_gatt_dm_data_print(dm);
 	VerifyOrExit(bt_uuid_cmp(gatt_service->uuid, provider->GetServiceUuid()) == 0, );
@@ -362,10 +682,15 @@ void BLEConnectivityManager::DiscoveryCompletedHandler(bt_gatt_dm *dm, void *con
 		provider->NotifySuccessfulRecovery();
 	}
 
+	Instance().NotifyDeviceReady(provider, false);
+
 exit:
 
 	Platform::UniquePtr<DiscoveryHandlerCtx> discoveryCtx(Platform::New<DiscoveryHandlerCtx>());
 	if (!discoveryCtx) {
+		bt_gatt_dm_data_release(dm);
+		StartNextGattDiscovery();
+		Instance().UpdateRecovery();
 		return;
 	}
 
@@ -375,6 +700,15 @@ exit:
 	CHIP_ERROR err = chip::DeviceLayer::PlatformMgr().ScheduleWork(
 		[](intptr_t context) {
 			Platform::UniquePtr<DiscoveryHandlerCtx> ctx(reinterpret_cast<DiscoveryHandlerCtx *>(context));
+
+			if (IsDiscoveryAborted(ctx->mProvider)) {
+				/* The provider was removed before the discovered data could be parsed. */
+				bt_gatt_dm_data_release(ctx->mDiscoveryData);
+				StartNextGattDiscovery();
+				Instance().UpdateRecovery();
+				return;
+			}
+
 			if (!ctx->mProvider->IsInitiallyConnected()) {
 				/* Provider is not initalized, so we need to call the first connection callback. */
 				CHIP_ERROR err = ctx->mProvider->GetBLEBridgedDevice().mFirstConnectionCallback(
@@ -382,17 +716,38 @@ exit:
 					ctx->mProvider->GetBLEBridgedDevice().mFirstConnectionCallbackContext);
 				ctx->mProvider->ConfirmInitialConnection();
 				VerifyOrReturn(CHIP_NO_ERROR == err, bt_gatt_dm_data_release(ctx->mDiscoveryData);
-					       Instance().RemoveBLEProvider(ctx->mProvider->GetBtAddress()););
+					       StartNextGattDiscovery();
+					       Instance().RemoveBLEProvider(ctx->mProvider->GetBtAddress());
+					       Instance().UpdateRecovery(););
 			}
 
 			if (CHIP_NO_ERROR != ctx->mProvider->NotifyReachableStatusChange(true)) {
 				LOG_WRN("The device has not been notified about the status change.");
 			}
 
-			if (0 != ctx->mProvider->ParseDiscoveredData(ctx->mDiscoveryData)) {
+			const bool parsed = (0 == ctx->mProvider->ParseDiscoveredData(ctx->mDiscoveryData));
+
+			if (!parsed) {
 				LOG_ERR("Cannot parse the GATT discovered data.");
 			}
+			ctx->mProvider->SetDiscoveredDataValid(parsed);
 			bt_gatt_dm_data_release(ctx->mDiscoveryData);
+
+#ifdef CONFIG_BRIDGE_BT_DISCOVERY_CACHE
+			bt_conn *conn = ctx->mProvider->GetConnectionObject();
+
+			/* Save the handles of the bonded device together with its GATT database hash. */
+			if (parsed && conn && bt_le_bond_exists(BT_ID_DEFAULT, bt_conn_get_dst(conn)) &&
+			    ReadDbHash(ctx->mProvider, false) != 0) {
+				LOG_WRN("Cannot read the GATT database hash, the discovery will not be skipped");
+				ctx->mProvider->SetDiscoveredDataValid(false);
+			}
+#endif
+
+			/* The discovery data was released, so the next discovery can be started. */
+			StartNextGattDiscovery();
+			/* The recovery is not updated while the discovery is in progress, so do it now. */
+			Instance().UpdateRecovery();
 		},
 		reinterpret_cast<intptr_t>(discoveryCtx.get()));
 
@@ -400,6 +755,7 @@ exit:
 		discoveryCtx.release();
 	} else {
 		bt_gatt_dm_data_release(dm);
+		StartNextGattDiscovery();
 	}
 
 	Instance().UpdateRecovery();
@@ -407,10 +763,26 @@ exit:
 
 void BLEConnectivityManager::DiscoveryNotFound(bt_conn *conn, void *context)
 {
+	StateGuard guard;
+
 	LOG_ERR("GATT service could not be found during the discovery");
 
 	BLEBridgedDeviceProvider *provider = reinterpret_cast<BLEBridgedDeviceProvider *>(context);
+
+	if (IsDiscoveryAborted(provider)) {
+		/* The provider was removed while the discovery was in progress. */
+		StartNextGattDiscovery();
+		Instance().UpdateRecovery();
+		return;
+	}
+
+	if (provider == Instance().mActiveDiscovery) {
+		StartNextGattDiscovery();
+	}
+
 	if (provider) {
+		provider->SetDiscoveredDataValid(false);
+
 		if (!provider->IsInitiallyConnected()) {
 			provider->GetBLEBridgedDevice().mFirstConnectionCallback(
 				false, provider->GetBLEBridgedDevice().mFirstConnectionCallbackContext);
@@ -424,10 +796,23 @@ void BLEConnectivityManager::DiscoveryNotFound(bt_conn *conn, void *context)
 
 void BLEConnectivityManager::DiscoveryError(bt_conn *conn, int err, void *context)
 {
+	StateGuard guard;
+
 	LOG_ERR("The GATT discovery procedure failed with %d", err);
 
 	BLEBridgedDeviceProvider *provider = reinterpret_cast<BLEBridgedDeviceProvider *>(context);
 
+	if (IsDiscoveryAborted(provider)) {
+		/* The provider was removed while the discovery was in progress. */
+		StartNextGattDiscovery();
+		Instance().UpdateRecovery();
+		return;
+	}
+
+	if (provider == Instance().mActiveDiscovery) {
+		StartNextGattDiscovery();
+	}
+
 	if (!provider->IsInitiallyConnected()) {
 		provider->GetBLEBridgedDevice().mFirstConnectionCallback(
 			false, provider->GetBLEBridgedDevice().mFirstConnectionCallbackContext);
@@ -574,19 +959,24 @@ void BLEConnectivityManager::Recovery::RemoveRecovered(BLEBridgedDeviceProvider
 		return;
 	}
 
+	RemoveProvider(provider, &Instance().mRecovery.mListToRecover);
+}
+
+void BLEConnectivityManager::Recovery::RemoveProvider(BLEBridgedDeviceProvider *provider, sys_slist_t *list)
+{
 	sys_snode_t *node;
 	sys_snode_t *tmpNodeSafe;
 	ListItem *item;
 
 	/* Iterate through the list of providers and remove the requested one. */
-	SYS_SLIST_FOR_EACH_NODE_SAFE (&Instance().mRecovery.mListToRecover, node, tmpNodeSafe) {
+	SYS_SLIST_FOR_EACH_NODE_SAFE (list, node, tmpNodeSafe) {
 		item = reinterpret_cast<ListItem *>(node);
 		if (!item) {
 			return;
 		}
 
 		if (item->mProvider == provider) {
-			sys_slist_find_and_remove(&Instance().mRecovery.mListToRecover, item);
+			sys_slist_find_and_remove(list, item);
 			Platform::Delete(item);
 			return;
 		}
@@ -695,6 +1085,14 @@ CHIP_ERROR BLEConnectivityManager::Reconnect(BLEBridgedDeviceProvider *provider)
 		return CHIP_ERROR_INVALID_ARGUMENT;
 	}
 
+	StateGuard guard;
+
+	if (mPendingConnection) {
+		/* Another connection is being created, try again once it is established. */
+		mRecovery.PutProvider(provider, &mRecovery.mListToReconnect);
+		return CHIP_NO_ERROR;
+	}
+
 	StopScan();
 
 	bt_conn *conn{};
@@ -703,6 +1101,7 @@ CHIP_ERROR BLEConnectivityManager::Reconnect(BLEBridgedDeviceProvider *provider)
 
 	if (!connParams) {
 		LOG_ERR("Failed to get conn params");
+		UpdateRecovery();
 		return CHIP_ERROR_INTERNAL;
 	}
 
@@ -715,10 +1114,16 @@ CHIP_ERROR BLEConnectivityManager::Reconnect(BLEBridgedDeviceProvider *provider)
 	char addrStr[BT_ADDR_LE_STR_LEN];
 	bt_addr_le_to_str(&provider->GetBLEBridgedDevice().mAddr, addrStr, sizeof(addrStr));
 
+	provider->MarkConnectionStart();
+	mPendingConnection = provider;
+
 	int err = bt_conn_le_create(&provider->GetBLEBridgedDevice().mAddr, create_param, connParams, &conn);
 
 	if (err) {
 		LOG_ERR("Creating reconnection failed (err %d) to %s", err, addrStr);
+		mPendingConnection = nullptr;
+		/* Continue with the remaining devices, this one will be recovered after the next scan. */
+		UpdateRecovery();
 		return System::MapErrorZephyr(err);
 	} else {
 		provider->SetConnectionObject(conn);
@@ -745,6 +1150,17 @@ CHIP_ERROR BLEConnectivityManager::Connect(BLEBridgedDeviceProvider *provider, C
 	Instance().UpdateStateFlag(State::Pairing, true);
 #endif /* CONFIG_BT_SMP */
 
+	StateGuard guard;
+
+	if (mPendingConnection) {
+		LOG_ERR("Another connection is being created");
+#ifdef CONFIG_BT_SMP
+		Instance().UpdateStateFlag(State::Pairing, false);
+#endif /* CONFIG_BT_SMP */
+		RemoveBLEProvider(provider->GetBtAddress());
+		return CHIP_ERROR_BUSY;
+	}
+
 	mRecovery.CancelTimer();
 	StopScan();
 
@@ -765,10 +1181,14 @@ CHIP_ERROR BLEConnectivityManager::Connect(BLEBridgedDeviceProvider *provider, C
 	}
 #endif
 
+	provider->MarkConnectionStart();
+	mPendingConnection = provider;
+
 	int err = bt_conn_le_create(&provider->GetBLEBridgedDevice().mAddr, create_param, connParams, &conn);
 
 	if (err) {
 		LOG_ERR("Creating connection failed (err %d)", err);
+		mPendingConnection = nullptr;
 		RemoveBLEProvider(btAddress);
 		return System::MapErrorZephyr(err);
 	} else {
@@ -784,6 +1204,8 @@ CHIP_ERROR BLEConnectivityManager::AddBLEProvider(BLEBridgedDeviceProvider *prov
 		return CHIP_ERROR_INVALID_ARGUMENT;
 	}
 
+	StateGuard guard;
+
 	if (mConnectedProvidersCounter >= kMaxConnectedDevices) {
 		return CHIP_ERROR_NO_MEMORY;
 	}
@@ -802,6 +1224,7 @@ CHIP_ERROR BLEConnectivityManager::AddBLEProvider(BLEBridgedDeviceProvider *prov
 
 CHIP_ERROR BLEConnectivityManager::RemoveBLEProvider(bt_addr_le_t address)
 {
+	StateGuard guard;
 	BLEBridgedDeviceProvider *provider = nullptr;
 
 	/* Find provider's address on the list and remove it. */
@@ -823,6 +1246,25 @@ CHIP_ERROR BLEConnectivityManager::RemoveBLEProvider(bt_addr_le_t address)
 		return CHIP_ERROR_NOT_FOUND;
 	}
 
+	if (mPendingConnection == provider) {
+		mPendingConnection = nullptr;
+	}
+
+	/* Drop all references to the provider, as it is deleted once removed. */
+	Recovery::RemoveProvider(provider, &mListToDiscover);
+	Recovery::RemoveProvider(provider, &mRecovery.mListToRecover);
+	Recovery::RemoveProvider(provider, &mRecovery.mListToReconnect);
+
+	if (mActiveDiscovery == provider) {
+		/* The discovery cannot be cancelled, the next one is started once its callback is called. */
+		mActiveDiscoveryAborted = true;
+	}
+
+#ifdef CONFIG_BRIDGE_BT_DISCOVERY_CACHE
+	/* The device is not bridged anymore, so its GATT handles will not be reused. */
+	BridgeStorageManager::Instance().RemoveBtDiscoveryCache(address);
+#endif
+
 	if (!provider->GetBLEBridgedDevice().mConn) {
 		return CHIP_ERROR_INTERNAL;
 	}
@@ -841,8 +1283,23 @@ CHIP_ERROR BLEConnectivityManager::RemoveBLEProvider(bt_addr_le_t address)
 	return CHIP_NO_ERROR;
 }
 
+bool BLEConnectivityManager::IsProviderConnected(BLEBridgedDeviceProvider *provider)
+{
+	StateGuard guard;
+
+	for (int i = 0; i < kMaxConnectedDevices; i++) {
+		if (mConnectedProviders[i] == provider) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 BLEBridgedDeviceProvider *BLEConnectivityManager::FindBLEProvider(bt_addr_le_t address)
 {
+	StateGuard guard;
+
 	/* Find BLE provider that matches given address. */
 	for (int i = 0; i < kMaxConnectedDevices; i++) {
 		if (!mConnectedProviders[i]) {
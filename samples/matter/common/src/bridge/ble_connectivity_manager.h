@@ -89,6 +89,7 @@ private:
 		static bool EntryExists(BLEBridgedDeviceProvider *provider, sys_slist_t *list);
 		static BLEBridgedDeviceProvider *GetProvider(sys_slist_t *list);
 		static bool PutProvider(BLEBridgedDeviceProvider *provider, sys_slist_t *list);
+		static void RemoveProvider(BLEBridgedDeviceProvider *provider, sys_slist_t *list);
 		bool IsNeeded() { return !sys_slist_is_empty(&mListToRecover); }
 		void StartTimer();
 		void CancelTimer() { k_timer_stop(&mRecoveryTimer); }
@@ -176,6 +177,18 @@ public:
 	 */
 	BLEBridgedDeviceProvider *FindBLEProvider(bt_addr_le_t address);
 
+	/**
+	 * @brief Get BLE provider stored under the specified index on the manager's list.
+	 *
+	 * @param index index of the provider on the list, in range from 0 to kMaxConnectedDevices - 1
+	 * @return address of provider on success
+	 * @return nullptr if there is no provider under the index
+	 */
+	BLEBridgedDeviceProvider *GetBLEProvider(uint8_t index)
+	{
+		return index < kMaxConnectedDevices ? mConnectedProviders[index] : nullptr;
+	}
+
 	/**
 	 * @brief Add the BLE provider's address to the manager's list.
 	 *
@@ -245,6 +258,20 @@ public:
 	static void DiscoveryNotFound(bt_conn *conn, void *context);
 	static void DiscoveryError(bt_conn *conn, int err, void *context);
 	static int StartGattDiscovery(bt_conn *conn, BLEBridgedDeviceProvider *provider);
+	static void StartNextGattDiscovery();
+	static bool IsDiscoveryAborted(BLEBridgedDeviceProvider *provider);
+	bool IsProviderConnected(BLEBridgedDeviceProvider *provider);
+
+	/**
+	 * @brief Complete restoring the GATT handles of the bridged device obtained during the previous discovery.
+	 *
+	 * The bridged device is reported ready on success. Otherwise, the GATT discovery is performed. The method can
+	 * be called from any thread.
+	 *
+	 * @param provider address of the provider that restored the GATT handles
+	 * @param err 0 on success, negative error code on failure
+	 */
+	void DiscoveredDataRestored(BLEBridgedDeviceProvider *provider, int err);
 #ifdef CONFIG_BRIDGE_FORCE_BT_CONNECTION_PARAMS
 	static bool ParamChangeRequestHandler(struct bt_conn *conn, struct bt_le_conn_param *param);
 #endif
@@ -277,6 +304,19 @@ private:
 	State GetCurrentState();
 	void UpdateStateFlag(State state, bool enabled);
 	void UpdateRecovery();
+	void NotifyDeviceReady(BLEBridgedDeviceProvider *provider, bool cached);
+	static int DiscoverGattService(bt_conn *conn, BLEBridgedDeviceProvider *provider);
+#ifdef CONFIG_BRIDGE_BT_DISCOVERY_CACHE
+	static bool RestoreGattDiscovery(bt_conn *conn, BLEBridgedDeviceProvider *provider);
+	static void RestoreGattDiscoveryHandler(intptr_t context);
+	static void DiscoveredDataRestoredHandler(intptr_t context);
+	static void FallBackToGattDiscovery(BLEBridgedDeviceProvider *provider);
+	static void SaveGattDiscovery(BLEBridgedDeviceProvider *provider);
+	static int ReadDbHash(BLEBridgedDeviceProvider *provider, bool restore);
+	static uint8_t DbHashReadCallback(bt_conn *conn, uint8_t err, bt_gatt_read_params *params, const void *data,
+					  uint16_t length);
+	static void DbHashReadHandler(intptr_t context);
+#endif
 
 	StateChangedCallback mStateChangedCb = nullptr;
 	uint8_t mStateBitmask = 0;
@@ -295,6 +335,14 @@ private:
 	ConnectionSecurityRequest mConnectionSecurityRequest;
 #endif /* CONFIG_BT_SMP */
 	Recovery mRecovery;
+	/* The fields below are accessed from the Bluetooth and Matter threads and are protected by a mutex. */
+	/* Only one connection can be created at a time, the following ones wait on the reconnect list. */
+	BLEBridgedDeviceProvider *mPendingConnection = nullptr;
+	/* The GATT Discovery Manager handles one discovery at a time, the following ones wait on the list. */
+	BLEBridgedDeviceProvider *mActiveDiscovery = nullptr;
+	/* The provider of the active discovery was removed, the pointer must not be dereferenced. */
+	bool mActiveDiscoveryAborted = false;
+	sys_slist_t mListToDiscover = {};
 };
 
 } /* namespace Nrf */
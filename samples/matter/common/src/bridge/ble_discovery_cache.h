@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#pragma once
+
+#include <zephyr/bluetooth/addr.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace Nrf
+{
+
+/*
+ * Record of the GATT handles discovered on a bonded bridged Bluetooth LE device. The record is persisted, so that the
+ * GATT discovery can be skipped also after the bridge reboots. The handles stay valid as long as the GATT database
+ * hash of the device matches the one read after the discovery.
+ *
+ * The record is stored under the key created from the device address and serialized with the following layout:
+ *
+ *	address (7 B) | database hash (16 B) | data size (1 B) | data
+ *
+ * The data holds the GATT handles in the format defined by the bridged device data provider.
+ */
+struct BLEDiscoveryCacheRecord {
+	static constexpr size_t kDbHashSize = 16;
+	static constexpr size_t kMaxDataSize = 32;
+	static constexpr size_t kHeaderSize = sizeof(bt_addr_le_t) + kDbHashSize + 1;
+	static constexpr size_t kMaxSize = kHeaderSize + kMaxDataSize;
+	/* The key holds the device address in the hex format. The address type is verified when loading the record. */
+	static constexpr size_t kKeyLength = 2 * sizeof(bt_addr_t);
+
+	/**
+	 * @brief Create the key under which the record of the device is stored.
+	 *
+	 * @param addr Bluetooth LE address of the device
+	 * @param key buffer to be filled with the null-terminated key
+	 */
+	static void MakeKey(const bt_addr_le_t &addr, char (&key)[kKeyLength + 1])
+	{
+		for (size_t i = 0; i < sizeof(addr.a.val); i++) {
+			snprintf(&key[2 * i], 3, "%02x", addr.a.val[sizeof(addr.a.val) - 1 - i]);
+		}
+	}
+
+	/**
+	 * @brief Serialize the record into the buffer.
+	 *
+	 * @return size of the serialized record or 0 if it does not fit in the buffer
+	 */
+	size_t Encode(uint8_t *buffer, size_t bufferSize) const
+	{
+		const size_t size = kHeaderSize + mDataSize;
+
+		if (mDataSize > kMaxDataSize || size > bufferSize) {
+			return 0;
+		}
+
+		memcpy(buffer, &mAddr, sizeof(mAddr));
+		memcpy(buffer + sizeof(mAddr), mDbHash, kDbHashSize);
+		buffer[kHeaderSize - 1] = mDataSize;
+		memcpy(buffer + kHeaderSize, mData, mDataSize);
+
+		return size;
+	}
+
+	/**
+	 * @brief Deserialize the record from the buffer.
+	 *
+	 * @return true if the buffer holds a complete record
+	 */
+	bool Decode(const uint8_t *buffer, size_t size)
+	{
+		if (size < kHeaderSize || buffer[kHeaderSize - 1] > kMaxDataSize ||
+		    size != kHeaderSize + buffer[kHeaderSize - 1]) {
+			return false;
+		}
+
+		memcpy(&mAddr, buffer, sizeof(mAddr));
+		memcpy(mDbHash, buffer + sizeof(mAddr), kDbHashSize);
+		mDataSize = buffer[kHeaderSize - 1];
+		memcpy(mData, buffer + kHeaderSize, mDataSize);
+
+		return true;
+	}
+
+	/**
+	 * @brief Check if the record holds valid GATT handles of the device.
+	 *
+	 * @param addr Bluetooth LE address of the device
+	 * @param dbHash GATT database hash read from the device
+	 * @param dbHashSize size of the database hash
+	 * @return true if the record belongs to the device and its GATT database has not changed
+	 */
+	bool Matches(const bt_addr_le_t &addr, const uint8_t *dbHash, size_t dbHashSize) const
+	{
+		return bt_addr_le_eq(&mAddr, &addr) && dbHashSize == kDbHashSize &&
+		       memcmp(mDbHash, dbHash, kDbHashSize) == 0;
+	}
+
+	bt_addr_le_t mAddr{};
+	uint8_t mDbHash[kDbHashSize] = {};
+	uint8_t mDataSize = 0;
+	uint8_t mData[kMaxDataSize] = {};
+};
+
+} /* namespace Nrf */
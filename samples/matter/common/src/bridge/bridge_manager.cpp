@@ -120,21 +120,46 @@ CHIP_ERROR BridgeManager::DoAddBridgedDevices(MatterBridgedDevice *devices[], Br
 
 CHIP_ERROR BridgeManager::RemoveBridgedDevice(uint16_t endpoint, uint8_t &devicesPairIndex)
 {
-	uint8_t index = 0;
-	while (index < kMaxBridgedDevices) {
-		if (mDevicesMap.Contains(index)) {
-			auto &devicePair = mDevicesMap[index];
-			if (devicePair.mDevice->GetEndpointId() == endpoint) {
-				LOG_INF("Removed dynamic endpoint %d (index=%d)", endpoint, index);
-				/* Free dynamically allocated memory */
-				emberAfClearDynamicEndpoint(index);
-				devicesPairIndex = index;
-				return SafelyRemoveDevice(index);
-			}
-		}
-		index++;
+	const uint16_t index = GetDeviceIndex(endpoint);
+
+	if (index == kInvalidDeviceIndex) {
+		return CHIP_ERROR_NOT_FOUND;
 	}
-	return CHIP_ERROR_NOT_FOUND;
+
+	LOG_INF("Removed dynamic endpoint %d (index=%d)", endpoint, index);
+	/* Free dynamically allocated memory */
+	emberAfClearDynamicEndpoint(index);
+	devicesPairIndex = index;
+	return SafelyRemoveDevice(index);
+}
+
+uint16_t BridgeManager::GetDeviceIndex(EndpointId endpoint)
+{
+	return mEndpointIndexes.Find(endpoint);
+}
+
+void BridgeManager::UpdateDeviceIndex(uint8_t index)
+{
+	if (index >= kMaxBridgedDevices) {
+		return;
+	}
+
+	if (mDevicePairs[index]) {
+		mEndpointIndexes.Erase(mDeviceEndpoints[index]);
+	}
+
+	if (mDevicesMap.Contains(index) && mDevicesMap[index].mDevice) {
+		mDevicePairs[index] = &mDevicesMap[index];
+		mDeviceEndpoints[index] = mDevicePairs[index]->mDevice->GetEndpointId();
+		mEndpointIndexes.Insert(mDeviceEndpoints[index], index);
+	} else {
+		mDevicePairs[index] = nullptr;
+	}
+
+#ifdef CONFIG_BRIDGE_ATTRIBUTE_CACHE
+	/* The index can be reused by another bridged device, so drop all values cached for the previous one. */
+	InvalidateCachedAttributes(index, kInvalidClusterId);
+#endif
 }
 
 CHIP_ERROR BridgeManager::SafelyRemoveDevice(uint8_t index)
@@ -166,7 +191,11 @@ CHIP_ERROR BridgeManager::SafelyRemoveDevice(uint8_t index)
 			}
 		}
 	}
-	if (mDevicesMap.Erase(index)) {
+	const bool erased = mDevicesMap.Erase(index);
+
+	UpdateDeviceIndex(index);
+
+	if (erased) {
 		if (removeProvider) {
 			mNumberOfProviders--;
 		}
@@ -321,6 +350,7 @@ CHIP_ERROR BridgeManager::CreateEndpoint(uint8_t index, uint16_t endpointId)
 	if (err == CHIP_NO_ERROR) {
 		LOG_INF("Added device to dynamic endpoint %d (index=%d)", endpointId, index);
 		storedDevice->Init(endpointId);
+		UpdateDeviceIndex(index);
 		return CHIP_NO_ERROR;
 	} else if (err != CHIP_ERROR_ENDPOINT_EXISTS) {
 		LOG_ERR("Failed to add dynamic endpoint: Internal error!");
@@ -376,9 +406,11 @@ CHIP_ERROR BridgeManager::HandleRead(uint16_t index, ClusterId clusterId,
 				     uint16_t maxReadLength)
 {
 	VerifyOrReturnError(attributeMetadata && buffer, CHIP_ERROR_INVALID_ARGUMENT);
-	VerifyOrReturnValue(Instance().mDevicesMap.Contains(index), CHIP_ERROR_INTERNAL);
 
-	auto *device = Instance().mDevicesMap[index].mDevice;
+	auto *devicePair = Instance().GetDevicePair(index);
+	VerifyOrReturnValue(devicePair, CHIP_ERROR_INTERNAL);
+
+	auto *device = devicePair->mDevice;
 
 	/* Handle reads for the generic information for all bridged devices. Provide a valid answer even if device state
 	 * is unreachable. */
@@ -395,20 +427,41 @@ CHIP_ERROR BridgeManager::HandleRead(uint16_t index, ClusterId clusterId,
 	/* Verify if the device is reachable or we should return prematurely. */
 	VerifyOrReturnError(device->GetIsReachable(), CHIP_ERROR_INCORRECT_STATE);
 
+#ifdef CONFIG_BRIDGE_ATTRIBUTE_CACHE
+	if (Instance().ReadCachedAttribute(index, clusterId, attributeMetadata, buffer, maxReadLength)) {
+		return CHIP_NO_ERROR;
+	}
+
+	CHIP_ERROR err = device->HandleRead(clusterId, attributeMetadata->attributeId, buffer, maxReadLength);
+
+	if (err == CHIP_NO_ERROR) {
+		Instance().StoreCachedAttribute(index, clusterId, attributeMetadata, buffer);
+	}
+
+	return err;
+#else
 	return device->HandleRead(clusterId, attributeMetadata->attributeId, buffer, maxReadLength);
+#endif
 }
 
 CHIP_ERROR BridgeManager::HandleWrite(uint16_t index, ClusterId clusterId,
 				      const EmberAfAttributeMetadata *attributeMetadata, uint8_t *buffer)
 {
 	VerifyOrReturnError(attributeMetadata && buffer, CHIP_ERROR_INVALID_ARGUMENT);
-	VerifyOrReturnValue(Instance().mDevicesMap.Contains(index), CHIP_ERROR_INTERNAL);
 
-	auto *device = Instance().mDevicesMap[index].mDevice;
+	auto *devicePair = Instance().GetDevicePair(index);
+	VerifyOrReturnValue(devicePair, CHIP_ERROR_INTERNAL);
+
+	auto *device = devicePair->mDevice;
 
 	/* Verify if the device is reachable or we should return prematurely. */
 	VerifyOrReturnError(device->GetIsReachable(), CHIP_ERROR_INCORRECT_STATE);
 
+#ifdef CONFIG_BRIDGE_ATTRIBUTE_CACHE
+	/* The write may change other attributes of the cluster as well. */
+	Instance().InvalidateCachedAttributes(index, clusterId);
+#endif
+
 	/* Handle Identify cluster write - for now it does not imply updating the provider's state */
 	if (clusterId == Clusters::Identify::Id) {
 		return device->HandleWriteIdentify(attributeMetadata->attributeId, buffer, attributeMetadata->size);
@@ -442,7 +495,7 @@ CHIP_ERROR BridgeManager::HandleWrite(uint16_t index, ClusterId clusterId,
 
 	/* After updating MatterBridgedDevice state, forward request to the non-Matter device. */
 	if (err == CHIP_NO_ERROR) {
-		CHIP_ERROR updateError = Instance().mDevicesMap[index].mProvider->UpdateState(
+		CHIP_ERROR updateError = devicePair->mProvider->UpdateState(
 			clusterId, attributeMetadata->attributeId, buffer);
 		/* This is acceptable that not all writable attributes can be reflected in the provider device. */
 		if (updateError != CHIP_ERROR_UNSUPPORTED_CHIP_FEATURE) {
@@ -464,6 +517,17 @@ void BridgeManager::HandleUpdate(BridgedDeviceDataProvider &dataProvider, Cluste
 			/* If the Bridged Device state was updated successfully, schedule sending Matter data
 			 * report. */
 			auto *device = item.value.mDevice;
+
+#ifdef CONFIG_BRIDGE_ATTRIBUTE_CACHE
+			/* The change may affect other attributes of the cluster as well. The values cached before
+			 * the device reachability changed may be outdated, so drop all values cached for the device.
+			 */
+			const bool reachableChange =
+				clusterId == Clusters::BridgedDeviceBasicInformation::Id &&
+				attributeId == Clusters::BridgedDeviceBasicInformation::Attributes::Reachable::Id;
+			Instance().InvalidateCachedAttributes(item.key, reachableChange ? kInvalidClusterId : clusterId);
+#endif
+
 			if (CHIP_NO_ERROR == device->HandleAttributeChange(clusterId, attributeId, data, dataSize)) {
 				MatterReportingAttributeChangeCallback(device->GetEndpointId(), clusterId, attributeId);
 			}
@@ -500,15 +564,90 @@ void BridgeManager::HandleCommand(BridgedDeviceDataProvider &dataProvider, Clust
 
 BridgedDeviceDataProvider *BridgeManager::GetProvider(EndpointId endpoint, uint16_t &deviceType)
 {
-	uint16_t endpointIndex = emberAfGetDynamicIndexFromEndpoint(endpoint);
-	if (Instance().mDevicesMap.Contains(endpointIndex)) {
-		BridgedDevicePair &bridgedDevices = Instance().mDevicesMap[endpointIndex];
-		deviceType = bridgedDevices.mDevice->GetDeviceType();
-		return bridgedDevices.mProvider;
+	BridgedDevicePair *bridgedDevices = GetDevicePair(GetDeviceIndex(endpoint));
+	if (bridgedDevices) {
+		deviceType = bridgedDevices->mDevice->GetDeviceType();
+		return bridgedDevices->mProvider;
 	}
 	return nullptr;
 }
 
+#ifdef CONFIG_BRIDGE_ATTRIBUTE_CACHE
+BridgeManager::AttributeCacheEntry &BridgeManager::GetAttributeCacheEntry(uint16_t index, ClusterId clusterId,
+									  AttributeId attributeId)
+{
+	/* Direct-mapped cache, the attribute ids of a cluster are mostly consecutive small numbers. */
+	const uint32_t hash = (clusterId * 31u) ^ (attributeId * 7u) ^ (index * 131u);
+
+	return mAttributeCache[hash % kAttributeCacheSize];
+}
+
+bool BridgeManager::ReadCachedAttribute(uint16_t index, ClusterId clusterId,
+					const EmberAfAttributeMetadata *attributeMetadata, uint8_t *buffer,
+					uint16_t maxReadLength)
+{
+	const AttributeCacheEntry &entry = GetAttributeCacheEntry(index, clusterId, attributeMetadata->attributeId);
+
+	if (entry.mIndex != index || entry.mClusterId != clusterId ||
+	    entry.mAttributeId != attributeMetadata->attributeId || entry.mSize > maxReadLength) {
+		mAttributeCacheStats.mMisses++;
+		return false;
+	}
+
+	memcpy(buffer, entry.mValue, entry.mSize);
+	mAttributeCacheStats.mHits++;
+
+	return true;
+}
+
+void BridgeManager::StoreCachedAttribute(uint16_t index, ClusterId clusterId,
+					 const EmberAfAttributeMetadata *attributeMetadata, const uint8_t *buffer)
+{
+	/* Only the fixed-size attributes are cached, as the size of the string attributes is known only to the
+	 * bridged device. */
+	switch (attributeMetadata->attributeType) {
+	case ZCL_OCTET_STRING_ATTRIBUTE_TYPE:
+	case ZCL_CHAR_STRING_ATTRIBUTE_TYPE:
+	case ZCL_LONG_OCTET_STRING_ATTRIBUTE_TYPE:
+	case ZCL_LONG_CHAR_STRING_ATTRIBUTE_TYPE:
+		return;
+	default:
+		break;
+	}
+
+	if (attributeMetadata->size > kAttributeCacheValueSize) {
+		return;
+	}
+
+	AttributeCacheEntry &entry = GetAttributeCacheEntry(index, clusterId, attributeMetadata->attributeId);
+
+	entry.mIndex = index;
+	entry.mClusterId = clusterId;
+	entry.mAttributeId = attributeMetadata->attributeId;
+	entry.mSize = attributeMetadata->size;
+	memcpy(entry.mValue, buffer, entry.mSize);
+}
+
+void BridgeManager::InvalidateCachedAttributes(uint16_t index, ClusterId clusterId)
+{
+	for (auto &entry : mAttributeCache) {
+		if (entry.mIndex == index && (clusterId == kInvalidClusterId || entry.mClusterId == clusterId)) {
+			entry.mIndex = kInvalidDeviceIndex;
+			mAttributeCacheStats.mInvalidations++;
+		}
+	}
+}
+
+void BridgeManager::GetAttributeCacheStats(AttributeCacheStats &stats, bool reset)
+{
+	stats = mAttributeCacheStats;
+
+	if (reset) {
+		mAttributeCacheStats = {};
+	}
+}
+#endif
+
 } /* namespace Nrf */
 
 Protocols::InteractionModel::Status
@@ -516,7 +655,7 @@ emberAfExternalAttributeReadCallback(EndpointId endpoint, ClusterId clusterId,
 				     const EmberAfAttributeMetadata *attributeMetadata, uint8_t *buffer,
 				     uint16_t maxReadLength)
 {
-	uint16_t endpointIndex = emberAfGetDynamicIndexFromEndpoint(endpoint);
+	uint16_t endpointIndex = Nrf::BridgeManager::Instance().GetDeviceIndex(endpoint);
 
 	if (CHIP_NO_ERROR == Nrf::BridgeManager::Instance().HandleRead(endpointIndex, clusterId, attributeMetadata,
 								       buffer, maxReadLength)) {
@@ -530,7 +669,7 @@ Protocols::InteractionModel::Status
 emberAfExternalAttributeWriteCallback(EndpointId endpoint, ClusterId clusterId,
 				      const EmberAfAttributeMetadata *attributeMetadata, uint8_t *buffer)
 {
-	uint16_t endpointIndex = emberAfGetDynamicIndexFromEndpoint(endpoint);
+	uint16_t endpointIndex = Nrf::BridgeManager::Instance().GetDeviceIndex(endpoint);
 
 	if (CHIP_NO_ERROR ==
 	    Nrf::BridgeManager::Instance().HandleWrite(endpointIndex, clusterId, attributeMetadata, buffer)) {
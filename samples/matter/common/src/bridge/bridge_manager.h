@@ -9,6 +9,7 @@
 #include "binding/binding_handler.h"
 #include "bridge_util.h"
 #include "util/finite_map.h"
+#include "util/index_map.h"
 #include "bridged_device_data_provider.h"
 #include "matter_bridged_device.h"
 
@@ -23,6 +24,17 @@ public:
 
 	using LoadStoredBridgedDevicesCallback = CHIP_ERROR (*)();
 
+#ifdef CONFIG_BRIDGE_ATTRIBUTE_CACHE
+	struct AttributeCacheStats {
+		/* Number of attribute reads served from the cache. */
+		uint32_t mHits;
+		/* Number of attribute reads forwarded to the bridged device. */
+		uint32_t mMisses;
+		/* Number of cache entries invalidated by the bridged device state changes. */
+		uint32_t mInvalidations;
+	};
+#endif
+
 	/**
 	 * @brief Initialize BridgeManager instance.
 	 *
@@ -109,6 +121,24 @@ public:
 	 */
 	BridgedDeviceDataProvider *GetProvider(chip::EndpointId endpoint, uint16_t &deviceType);
 
+	/**
+	 * @brief Get the index of the bridged device stored on the specified endpoint.
+	 *
+	 * @param endpoint endpoint on which the bridged device is stored
+	 * @return index of the bridged device or kInvalidDeviceIndex if there is no bridged device on the endpoint
+	 */
+	uint16_t GetDeviceIndex(chip::EndpointId endpoint);
+
+#ifdef CONFIG_BRIDGE_ATTRIBUTE_CACHE
+	/**
+	 * @brief Get the attribute read cache statistics.
+	 *
+	 * @param[out] stats object to be filled with the statistics
+	 * @param reset reset the statistics after reading them
+	 */
+	void GetAttributeCacheStats(AttributeCacheStats &stats, bool reset);
+#endif
+
 	static CHIP_ERROR HandleRead(uint16_t index, chip::ClusterId clusterId,
 				     const EmberAfAttributeMetadata *attributeMetadata, uint8_t *buffer,
 				     uint16_t maxReadLength);
@@ -125,6 +155,8 @@ public:
 		return sInstance;
 	}
 
+	static constexpr uint16_t kInvalidDeviceIndex = UINT16_MAX;
+
 private:
 	struct BridgedDevicePair {
 		BridgedDevicePair() : mDevice(nullptr), mProvider(nullptr) {}
@@ -246,7 +278,77 @@ private:
 	 */
 	CHIP_ERROR CreateEndpoint(uint8_t index, uint16_t endpointId);
 
+	/**
+	 * @brief Get the pair of bridged device and its data provider stored under the index.
+	 *
+	 * @param index index of the pair
+	 * @return pointer to the pair or nullptr if there is no pair under the index
+	 */
+	BridgedDevicePair *GetDevicePair(uint16_t index)
+	{
+		return index < kMaxBridgedDevices ? mDevicePairs[index] : nullptr;
+	}
+
+	/**
+	 * @brief Update the index of pairs and endpoints, and the endpoint lookup map after inserting or erasing the
+	 * pair under the index.
+	 *
+	 * @param index index of the pair
+	 */
+	void UpdateDeviceIndex(uint8_t index);
+
+#ifdef CONFIG_BRIDGE_ATTRIBUTE_CACHE
+	static constexpr size_t kAttributeCacheSize = CONFIG_BRIDGE_ATTRIBUTE_CACHE_SIZE;
+	static constexpr size_t kAttributeCacheValueSize = CONFIG_BRIDGE_ATTRIBUTE_CACHE_VALUE_SIZE;
+
+	struct AttributeCacheEntry {
+		chip::ClusterId mClusterId;
+		chip::AttributeId mAttributeId;
+		uint16_t mIndex{ kInvalidDeviceIndex };
+		uint8_t mSize;
+		uint8_t mValue[kAttributeCacheValueSize];
+	};
+
+	/**
+	 * @brief Get the cache entry to which the attribute of the bridged device is mapped.
+	 */
+	AttributeCacheEntry &GetAttributeCacheEntry(uint16_t index, chip::ClusterId clusterId,
+						    chip::AttributeId attributeId);
+
+	/**
+	 * @brief Read the attribute value from the cache.
+	 *
+	 * @return true if the value has been found in the cache and copied to the buffer
+	 */
+	bool ReadCachedAttribute(uint16_t index, chip::ClusterId clusterId,
+				 const EmberAfAttributeMetadata *attributeMetadata, uint8_t *buffer,
+				 uint16_t maxReadLength);
+
+	/**
+	 * @brief Store the attribute value read from the bridged device in the cache.
+	 */
+	void StoreCachedAttribute(uint16_t index, chip::ClusterId clusterId,
+				  const EmberAfAttributeMetadata *attributeMetadata, const uint8_t *buffer);
+
+	/**
+	 * @brief Invalidate cached attributes of the bridged device.
+	 *
+	 * @param index index of the bridged device
+	 * @param clusterId cluster of the attributes to be invalidated or chip::kInvalidClusterId to invalidate all
+	 * attributes of the bridged device
+	 */
+	void InvalidateCachedAttributes(uint16_t index, chip::ClusterId clusterId);
+
+	AttributeCacheEntry mAttributeCache[kAttributeCacheSize];
+	AttributeCacheStats mAttributeCacheStats{};
+#endif
+
 	DeviceMap mDevicesMap;
+	/* Pairs stored in mDevicesMap and their endpoints, indexed by the pair's index to avoid searching the map. */
+	BridgedDevicePair *mDevicePairs[kMaxBridgedDevices] = {};
+	chip::EndpointId mDeviceEndpoints[kMaxBridgedDevices];
+	/* Indexes of the pairs, keyed by the endpoint to find the pair without searching mDeviceEndpoints. */
+	IndexMap<chip::EndpointId, kMaxBridgedDevices> mEndpointIndexes;
 	uint16_t mNumberOfProviders{ 0 };
 	uint8_t mDevicesIndexes[BridgeManager::kMaxBridgedDevices] = { 0 };
 	uint8_t mDevicesIndexesCounter;
@@ -10,6 +10,8 @@
 
 #include <zephyr/logging/log.h>
 
+#include <algorithm>
+
 LOG_MODULE_DECLARE(app, CONFIG_CHIP_APP_LOG_LEVEL);
 
 namespace
@@ -31,13 +33,40 @@ Nrf::PersistentStorageNode CreateIndexNode(uint8_t bridgedDeviceIndex, Nrf::Pers
 	return Nrf::PersistentStorageNode(index, strlen(index), parent);
 }
 
+/* Offsets of the record fields, see BridgeStorageManager for the record layout. */
+constexpr size_t kRecordIndexOffset = 0;
+constexpr size_t kRecordEndpointIdOffset = 1;
+constexpr size_t kRecordDeviceTypeOffset = 3;
+constexpr size_t kRecordUniqueIDOffset = 5;
+
+/**
+ * @brief Get the size of the record at the beginning of the buffer.
+ *
+ * @return record size or 0 if the record is malformed
+ */
+size_t GetRecordSize(const uint8_t *record, size_t maxSize)
+{
+	size_t size = kRecordUniqueIDOffset;
+
+	/* Skip the unique id, node label and user data, each preceded by its length. */
+	for (int field = 0; field < 3; field++) {
+		if (size >= maxSize) {
+			return 0;
+		}
+
+		size += 1 + record[size];
+	}
+
+	return size <= maxSize ? size : 0;
+}
+
 } /* namespace */
 
 namespace Nrf
 {
 
 #ifdef CONFIG_BRIDGE_MIGRATE_VERSION_1
-template <> bool BridgeStorageManager::LoadBridgedDevice(BridgedDeviceV1 &device, uint8_t index)
+bool BridgeStorageManager::LoadLegacyBridgedDevice(BridgedDeviceV1 &device, uint8_t index)
 {
 	Nrf::PersistentStorageNode id = CreateIndexNode(index, &mBridgedDevice);
 	size_t readSize = 0;
@@ -104,7 +133,8 @@ template <> bool BridgeStorageManager::LoadBridgedDevice(BridgedDeviceV1 &device
 }
 #endif
 
-template <> bool BridgeStorageManager::LoadBridgedDevice(BridgedDeviceV2 &device, uint8_t index)
+#ifdef CONFIG_BRIDGE_MIGRATE_VERSION_2
+bool BridgeStorageManager::LoadLegacyBridgedDevice(BridgedDeviceV2 &device, uint8_t index)
 {
 	Nrf::PersistentStorageNode id = CreateIndexNode(index, &mBridgedDevice);
 	size_t readSize = 0;
@@ -185,6 +215,7 @@ template <> bool BridgeStorageManager::LoadBridgedDevice(BridgedDeviceV2 &device
 
 	return true;
 }
+#endif
 
 bool BridgeStorageManager::Init()
 {
@@ -194,6 +225,10 @@ bool BridgeStorageManager::Init()
 		return false;
 	}
 
+	if (!LoadRecords()) {
+		return false;
+	}
+
 	/* Perform data migration from previous data structure versions if needed. */
 	return MigrateData();
 }
@@ -201,6 +236,179 @@ bool BridgeStorageManager::Init()
 void BridgeStorageManager::FactoryReset()
 {
 	Nrf::GetPersistentStorage().NonSecureFactoryReset();
+
+	mRecordsSize = 0;
+	mRecordsCount = 0;
+}
+
+bool BridgeStorageManager::LoadRecords()
+{
+	size_t readSize = 0;
+	size_t offset = 0;
+
+	mRecordsSize = 0;
+	mRecordsCount = 0;
+
+	if (Nrf::GetPersistentStorage().NonSecureHasEntry(&mBridgedDevices) != PSErrorCode::Success) {
+		/* No bridged devices stored yet. */
+		return true;
+	}
+
+	if (Nrf::GetPersistentStorage().NonSecureLoad(&mBridgedDevices, mRecords, sizeof(mRecords), readSize) !=
+	    PSErrorCode::Success) {
+		return false;
+	}
+
+	/* Validate all records once, so that they can be accessed without further checks. */
+	while (offset < readSize) {
+		const size_t recordSize = GetRecordSize(mRecords + offset, readSize - offset);
+
+		if (recordSize == 0) {
+			LOG_ERR("Malformed bridged device record");
+			return false;
+		}
+
+		offset += recordSize;
+		mRecordsCount++;
+	}
+
+	mRecordsSize = readSize;
+
+	return true;
+}
+
+bool BridgeStorageManager::StoreRecords()
+{
+	PSErrorCode status;
+
+	if (mRecordsSize == 0) {
+		status = Nrf::GetPersistentStorage().NonSecureRemove(&mBridgedDevices);
+
+		/* Removing an entry that does not exist is not an error. */
+		return status == PSErrorCode::Success ||
+		       Nrf::GetPersistentStorage().NonSecureHasEntry(&mBridgedDevices) != PSErrorCode::Success;
+	}
+
+	status = Nrf::GetPersistentStorage().NonSecureStore(&mBridgedDevices, mRecords, mRecordsSize);
+
+	return status == PSErrorCode::Success;
+}
+
+uint8_t *BridgeStorageManager::FindRecord(uint8_t index, size_t &size)
+{
+	size_t offset = 0;
+
+	while (offset < mRecordsSize) {
+		uint8_t *record = mRecords + offset;
+
+		size = GetRecordSize(record, mRecordsSize - offset);
+
+		if (record[kRecordIndexOffset] == index) {
+			return record;
+		}
+
+		offset += size;
+	}
+
+	return nullptr;
+}
+
+bool BridgeStorageManager::DropRecord(uint8_t index)
+{
+	size_t size = 0;
+	uint8_t *record = FindRecord(index, size);
+
+	if (!record) {
+		return false;
+	}
+
+	memmove(record, record + size, mRecordsSize - (record - mRecords) - size);
+	mRecordsSize -= size;
+	mRecordsCount--;
+
+	return true;
+}
+
+bool BridgeStorageManager::PutRecord(const BridgedDevice &device, uint8_t index)
+{
+	const size_t userDataSize = device.mUserData ? device.mUserDataSize : 0;
+	const size_t recordSize =
+		kRecordHeaderSize + device.mUniqueIDLength + device.mNodeLabelLength + userDataSize;
+
+	if (device.mUniqueIDLength > sizeof(device.mUniqueID) || device.mNodeLabelLength > sizeof(device.mNodeLabel) ||
+	    userDataSize > kMaxUserDataSize) {
+		return false;
+	}
+
+	size_t oldSize = 0;
+	uint8_t *record = FindRecord(index, oldSize);
+
+	if (!record) {
+		/* Add a new record at the end. */
+		record = mRecords + mRecordsSize;
+		oldSize = 0;
+	}
+
+	if (mRecordsSize - oldSize + recordSize > sizeof(mRecords)) {
+		LOG_ERR("No space for the bridged device record");
+		return false;
+	}
+
+	/* Move the following records to fit the new record size. */
+	const size_t tailOffset = (record - mRecords) + oldSize;
+
+	memmove(record + recordSize, mRecords + tailOffset, mRecordsSize - tailOffset);
+
+	if (oldSize == 0) {
+		mRecordsCount++;
+	}
+
+	mRecordsSize = mRecordsSize - oldSize + recordSize;
+
+	/* Serialize data structure and insert it into the record. */
+	uint8_t *data = record;
+
+	*data++ = index;
+	memcpy(data, &device.mEndpointId, sizeof(device.mEndpointId));
+	data += sizeof(device.mEndpointId);
+	memcpy(data, &device.mDeviceType, sizeof(device.mDeviceType));
+	data += sizeof(device.mDeviceType);
+	*data++ = device.mUniqueIDLength;
+	memcpy(data, device.mUniqueID, device.mUniqueIDLength);
+	data += device.mUniqueIDLength;
+	*data++ = device.mNodeLabelLength;
+	memcpy(data, device.mNodeLabel, device.mNodeLabelLength);
+	data += device.mNodeLabelLength;
+	*data++ = userDataSize;
+
+	if (userDataSize > 0) {
+		memcpy(data, device.mUserData, userDataSize);
+	}
+
+	return true;
+}
+
+void BridgeStorageManager::RemoveLegacyData(uint8_t version, const uint8_t *indexes, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		if (version == 0) {
+#ifdef CONFIG_BRIDGE_MIGRATE_PRE_2_7_0
+			RemoveBridgedDeviceEndpointId(indexes[i]);
+			RemoveBridgedDeviceNodeLabel(indexes[i]);
+			RemoveBridgedDeviceType(indexes[i]);
+#ifdef CONFIG_BRIDGED_DEVICE_BT
+			RemoveBtAddress(indexes[i]);
+#endif
+#endif
+		} else {
+			Nrf::PersistentStorageNode id = CreateIndexNode(indexes[i], &mBridgedDevice);
+
+			Nrf::GetPersistentStorage().NonSecureRemove(&id);
+		}
+	}
+
+	Nrf::GetPersistentStorage().NonSecureRemove(&mBridgedDevicesIndexes);
+	Nrf::GetPersistentStorage().NonSecureRemove(&mBridgedDevicesCount);
 }
 
 #ifdef CONFIG_BRIDGE_MIGRATE_PRE_2_7_0
@@ -241,21 +449,8 @@ bool BridgeStorageManager::MigrateDataOldScheme(uint8_t bridgedDeviceIndex)
 	}
 	device.mUniqueIDLength = strlen(device.mUniqueID);
 
-	/* Store all information using a new scheme. */
-	if (!StoreBridgedDevice(device, bridgedDeviceIndex)) {
-		return false;
-	}
-
-	/* Remove all information described using an old scheme. */
-	RemoveBridgedDeviceEndpointId(bridgedDeviceIndex);
-	RemoveBridgedDeviceNodeLabel(bridgedDeviceIndex);
-	RemoveBridgedDeviceType(bridgedDeviceIndex);
-
-#ifdef CONFIG_BRIDGED_DEVICE_BT
-	RemoveBtAddress(bridgedDeviceIndex);
-#endif
-
-	return true;
+	/* Put all information into the records using a new scheme. */
+	return PutRecord(device, bridgedDeviceIndex);
 }
 #endif
 
@@ -274,7 +469,7 @@ bool BridgeStorageManager::MigrateDataVersion1(uint8_t bridgedDeviceIndex)
 #endif
 
 	/* Load all information from old scheme */
-	if (!LoadBridgedDevice(v1, bridgedDeviceIndex)) {
+	if (!LoadLegacyBridgedDevice(v1, bridgedDeviceIndex)) {
 		return false;
 	}
 
@@ -294,12 +489,33 @@ bool BridgeStorageManager::MigrateDataVersion1(uint8_t bridgedDeviceIndex)
 	}
 	device.mUniqueIDLength = strlen(device.mUniqueID);
 
-	/* Store all information using new scheme */
-	if (!StoreBridgedDevice(device, bridgedDeviceIndex)) {
+	/* Put all information into the records using new scheme */
+	return PutRecord(device, bridgedDeviceIndex);
+}
+#endif
+
+#ifdef CONFIG_BRIDGE_MIGRATE_VERSION_2
+bool BridgeStorageManager::MigrateDataVersion2(uint8_t bridgedDeviceIndex)
+{
+	BridgedDevice device;
+
+#ifdef CONFIG_BRIDGED_DEVICE_BT
+	bt_addr_le_t btAddr;
+
+	device.mUserDataSize = sizeof(btAddr);
+	device.mUserData = reinterpret_cast<uint8_t *>(&btAddr);
+#else
+	uint8_t userData[kMaxUserDataSize];
+
+	device.mUserDataSize = sizeof(userData);
+	device.mUserData = userData;
+#endif
+
+	if (!LoadLegacyBridgedDevice(device, bridgedDeviceIndex)) {
 		return false;
 	}
 
-	return true;
+	return PutRecord(device, bridgedDeviceIndex);
 }
 #endif
 
@@ -327,9 +543,14 @@ bool BridgeStorageManager::MigrateData()
 	uint8_t count;
 	uint8_t indexes[BridgeManager::kMaxBridgedDevices] = { 0 };
 	size_t indexesCount = 0;
+	const PSErrorCode countStatus = Nrf::GetPersistentStorage().NonSecureLoad(
+		&mBridgedDevicesIndexes, indexes, BridgeManager::kMaxBridgedDevices, indexesCount);
 
-	if (LoadBridgedDevicesCount(count) &&
-	    LoadBridgedDevicesIndexes(indexes, BridgeManager::kMaxBridgedDevices, indexesCount)) {
+	/* Drop records of an interrupted migration, the data is migrated again from the previous scheme. */
+	mRecordsSize = 0;
+	mRecordsCount = 0;
+
+	if (LoadDataToObject(&mBridgedDevicesCount, count) && countStatus == PSErrorCode::Success) {
 		/* Migrate all devices */
 		for (size_t i = 0; i < indexesCount; i++) {
 			if (!versionPresent) {
@@ -351,29 +572,54 @@ bool BridgeStorageManager::MigrateData()
 				/* Migration not enabled */
 				LOG_ERR("Migration of data scheme version 1 not enabled.");
 				return false;
+#endif
+			} else if (version == 2) {
+#ifdef CONFIG_BRIDGE_MIGRATE_VERSION_2
+				if (!MigrateDataVersion2(indexes[i])) {
+					return false;
+				}
+#else
+				/* Migration not enabled */
+				LOG_ERR("Migration of data scheme version 2 not enabled.");
+				return false;
 #endif
 			}
 		}
+	} else {
+		indexesCount = 0;
+	}
+
+	/* Store all devices using a single write. */
+	if (!StoreRecords()) {
+		return false;
 	}
 
 	/* Store current version */
+	const uint8_t previousVersion = versionPresent ? version : 0;
+
 	version = kCurrentVersion;
 	const PSErrorCode status = Nrf::GetPersistentStorage().NonSecureStore(&mVersion, &version, sizeof(version));
 
-	return status == PSErrorCode::Success;
+	if (status != PSErrorCode::Success) {
+		return false;
+	}
+
+	/* The data is not needed anymore once the version is updated. */
+	RemoveLegacyData(previousVersion, indexes, indexesCount);
+
+	return true;
 }
 
 bool BridgeStorageManager::StoreBridgedDevicesCount(uint8_t count)
 {
-	const PSErrorCode status =
-		Nrf::GetPersistentStorage().NonSecureStore(&mBridgedDevicesCount, &count, sizeof(count));
-
-	return status == PSErrorCode::Success;
+	return count == mRecordsCount;
 }
 
 bool BridgeStorageManager::LoadBridgedDevicesCount(uint8_t &count)
 {
-	return LoadDataToObject(&mBridgedDevicesCount, count);
+	count = mRecordsCount;
+
+	return true;
 }
 
 bool BridgeStorageManager::StoreBridgedDevicesIndexes(uint8_t *indexes, uint8_t count)
@@ -382,21 +628,61 @@ bool BridgeStorageManager::StoreBridgedDevicesIndexes(uint8_t *indexes, uint8_t
 		return false;
 	}
 
-	const PSErrorCode status = Nrf::GetPersistentStorage().NonSecureStore(&mBridgedDevicesIndexes, indexes, count);
+	size_t placedSize = 0;
+	uint8_t placedCount = 0;
+	bool changed = false;
 
-	return status == PSErrorCode::Success;
+	/* Order the records in place as given by the indexes, indexes without a record are skipped. */
+	for (uint8_t i = 0; i < count; i++) {
+		size_t offset = placedSize;
+
+		while (offset < mRecordsSize) {
+			uint8_t *record = mRecords + offset;
+			const size_t size = GetRecordSize(record, mRecordsSize - offset);
+
+			if (record[kRecordIndexOffset] == indexes[i]) {
+				if (offset != placedSize) {
+					std::rotate(mRecords + placedSize, record, record + size);
+					changed = true;
+				}
+
+				placedSize += size;
+				placedCount++;
+				break;
+			}
+
+			offset += size;
+		}
+	}
+
+	if (!changed && placedSize == mRecordsSize) {
+		/* Nothing changed. */
+		return true;
+	}
+
+	/* Drop records not present in the indexes. */
+	mRecordsSize = placedSize;
+	mRecordsCount = placedCount;
+
+	return StoreRecords();
 }
 
 bool BridgeStorageManager::LoadBridgedDevicesIndexes(uint8_t *indexes, uint8_t maxCount, size_t &count)
 {
+	size_t offset = 0;
+
 	if (!indexes) {
 		return false;
 	}
 
-	const PSErrorCode status =
-		Nrf::GetPersistentStorage().NonSecureLoad(&mBridgedDevicesIndexes, indexes, maxCount, count);
+	count = 0;
 
-	return status == PSErrorCode::Success;
+	while (offset < mRecordsSize && count < maxCount) {
+		indexes[count++] = mRecords[offset + kRecordIndexOffset];
+		offset += GetRecordSize(mRecords + offset, mRecordsSize - offset);
+	}
+
+	return true;
 }
 
 #ifdef CONFIG_BRIDGE_MIGRATE_PRE_2_7_0
@@ -448,51 +734,122 @@ bool BridgeStorageManager::RemoveBridgedDeviceType(uint8_t bridgedDeviceIndex)
 }
 #endif
 
-bool BridgeStorageManager::StoreBridgedDevice(BridgedDevice &device, uint8_t index)
+bool BridgeStorageManager::LoadBridgedDevice(BridgedDevice &device, uint8_t index)
 {
-	uint8_t buffer[sizeof(BridgedDevice) + kMaxUserDataSize];
-	uint16_t counter = 0;
-	Nrf::PersistentStorageNode id = CreateIndexNode(index, &mBridgedDevice);
+	size_t size = 0;
+	const uint8_t *record = FindRecord(index, size);
 
-	/* Serialize data structure and insert it into buffer. */
-	memcpy(buffer, &device.mEndpointId, sizeof(device.mEndpointId));
-	counter += sizeof(device.mEndpointId);
-	memcpy(buffer + counter, &device.mDeviceType, sizeof(device.mDeviceType));
-	counter += sizeof(device.mDeviceType);
-	memcpy(buffer + counter, &device.mUniqueIDLength, sizeof(device.mUniqueIDLength));
-	counter += sizeof(device.mUniqueIDLength);
-	memcpy(buffer + counter, device.mUniqueID, device.mUniqueIDLength);
-	counter += device.mUniqueIDLength;
-	memcpy(buffer + counter, &device.mNodeLabelLength, sizeof(device.mNodeLabelLength));
-	counter += sizeof(device.mNodeLabelLength);
-	memcpy(buffer + counter, device.mNodeLabel, device.mNodeLabelLength);
-	counter += device.mNodeLabelLength;
+	if (!record) {
+		return false;
+	}
 
-	/* Check if there are any user data to save. mUserData can be nullptr if not needed. */
-	if (device.mUserData && device.mUserDataSize > 0) {
-		if (device.mUserDataSize > kMaxUserDataSize) {
-			return false;
-		}
+	/* Deserialize data and copy it from the record into structure's fields. The record is validated on load. */
+	const uint8_t *data = record + kRecordEndpointIdOffset;
 
-		memcpy(buffer + counter, &device.mUserDataSize, sizeof(device.mUserDataSize));
-		counter += sizeof(device.mUserDataSize);
-		memcpy(buffer + counter, device.mUserData, device.mUserDataSize);
-		counter += device.mUserDataSize;
+	memcpy(&device.mEndpointId, data, sizeof(device.mEndpointId));
+	data = record + kRecordDeviceTypeOffset;
+	memcpy(&device.mDeviceType, data, sizeof(device.mDeviceType));
+	data = record + kRecordUniqueIDOffset;
+
+	device.mUniqueIDLength = *data++;
+	if (device.mUniqueIDLength > sizeof(device.mUniqueID)) {
+		return false;
 	}
+	memcpy(device.mUniqueID, data, device.mUniqueIDLength);
+	data += device.mUniqueIDLength;
 
-	const PSErrorCode status = Nrf::GetPersistentStorage().NonSecureStore(&id, buffer, counter);
+	device.mNodeLabelLength = *data++;
+	if (device.mNodeLabelLength > sizeof(device.mNodeLabel)) {
+		return false;
+	}
+	memcpy(device.mNodeLabel, data, device.mNodeLabelLength);
+	data += device.mNodeLabelLength;
 
-	return status == PSErrorCode::Success;
+	/* Check if user prepared a buffer for reading user data. It can be nullptr if not needed. */
+	if (!device.mUserData) {
+		device.mUserDataSize = 0;
+		return true;
+	}
+
+	const size_t userDataSize = *data++;
+
+	/* Validate that user data size value read from the storage is not bigger than the one expected by the user. */
+	if (device.mUserDataSize < userDataSize) {
+		return false;
+	}
+
+	device.mUserDataSize = userDataSize;
+	memcpy(device.mUserData, data, userDataSize);
+
+	return true;
+}
+
+bool BridgeStorageManager::StoreBridgedDevice(BridgedDevice &device, uint8_t index)
+{
+	if (!PutRecord(device, index)) {
+		return false;
+	}
+
+	return StoreRecords();
 }
 
 bool BridgeStorageManager::RemoveBridgedDevice(uint8_t index)
 {
-	Nrf::PersistentStorageNode id = CreateIndexNode(index, &mBridgedDevice);
-	const PSErrorCode status = Nrf::GetPersistentStorage().NonSecureRemove(&id);
+	if (!DropRecord(index)) {
+		/* Already removed, for example by StoreBridgedDevicesIndexes(). */
+		return true;
+	}
 
-	return status == PSErrorCode::Success;
+	return StoreRecords();
+}
+
+#ifdef CONFIG_BRIDGE_BT_DISCOVERY_CACHE
+bool BridgeStorageManager::StoreBtDiscoveryCache(const BLEDiscoveryCacheRecord &record)
+{
+	char key[BLEDiscoveryCacheRecord::kKeyLength + 1] = { 0 };
+	uint8_t data[BLEDiscoveryCacheRecord::kMaxSize];
+	const size_t size = record.Encode(data, sizeof(data));
+
+	if (size == 0) {
+		return false;
+	}
+
+	BLEDiscoveryCacheRecord::MakeKey(record.mAddr, key);
+	Nrf::PersistentStorageNode id(key, strlen(key), &mBtDiscoveryCache);
+
+	return Nrf::GetPersistentStorage().NonSecureStore(&id, data, size) == PSErrorCode::Success;
+}
+
+bool BridgeStorageManager::LoadBtDiscoveryCache(BLEDiscoveryCacheRecord &record, const bt_addr_le_t &addr)
+{
+	char key[BLEDiscoveryCacheRecord::kKeyLength + 1] = { 0 };
+	uint8_t data[BLEDiscoveryCacheRecord::kMaxSize];
+	size_t readSize = 0;
+
+	BLEDiscoveryCacheRecord::MakeKey(addr, key);
+	Nrf::PersistentStorageNode id(key, strlen(key), &mBtDiscoveryCache);
+
+	if (Nrf::GetPersistentStorage().NonSecureLoad(&id, data, sizeof(data), readSize) != PSErrorCode::Success) {
+		return false;
+	}
+
+	/* The key does not include the address type, so verify the whole address. */
+	return record.Decode(data, readSize) && bt_addr_le_eq(&record.mAddr, &addr);
 }
 
+bool BridgeStorageManager::RemoveBtDiscoveryCache(const bt_addr_le_t &addr)
+{
+	char key[BLEDiscoveryCacheRecord::kKeyLength + 1] = { 0 };
+
+	BLEDiscoveryCacheRecord::MakeKey(addr, key);
+	Nrf::PersistentStorageNode id(key, strlen(key), &mBtDiscoveryCache);
+
+	/* Removing an entry that does not exist is not an error. */
+	return Nrf::GetPersistentStorage().NonSecureRemove(&id) == PSErrorCode::Success ||
+	       Nrf::GetPersistentStorage().NonSecureHasEntry(&id) != PSErrorCode::Success;
+}
+#endif
+
 #ifdef CONFIG_BRIDGE_MIGRATE_PRE_2_7_0
 #ifdef CONFIG_BRIDGED_DEVICE_BT
 bool BridgeStorageManager::LoadBtAddress(bt_addr_le_t &addr, uint8_t bridgedDeviceIndex)
@@ -13,6 +13,10 @@
 #include <zephyr/bluetooth/addr.h>
 #endif
 
+#ifdef CONFIG_BRIDGE_BT_DISCOVERY_CACHE
+#include "ble_discovery_cache.h"
+#endif
+
 namespace Nrf
 {
 
@@ -20,6 +24,20 @@ namespace Nrf
  * The class implements the following key-values storage structure:
  *
  * /br/
+ *		/devs/ /<BridgedDeviceRecord[brd_cnt]>/
+ *		/ver/ <uint8_t>
+ *		/d/
+ *			/<Bluetooth LE address>/ /<BLEDiscoveryCacheRecord>/
+ *
+ * All bridged devices are stored in a single entry, which is loaded once during initialization and written
+ * atomically on every change. Each bridged device is serialized into a record with the following layout:
+ *
+ *	index (1 B) | endpoint id (2 B) | device type (2 B) | unique id length (1 B) | unique id |
+ *	node label length (1 B) | node label | user data size (1 B) | user data
+ *
+ * The data schemes used before version 3 keep the following structure and are migrated during initialization:
+ *
+ * /br/
  *		/brd_cnt/ /<uint8_t>/
  *		/brd_ids/ /<uint8_t[brd_cnt]>/
  * 		/brd/
@@ -38,7 +56,12 @@ public:
 	constexpr static auto kBridgedDevicesCountPrefix = "brd_cnt";
 	constexpr static auto kBridgedDevicesIndexesPrefix = "brd_ids";
 	constexpr static auto kBridgedDevicePrefix = "brd";
+	constexpr static auto kBridgedDevicesPrefix = "devs";
 	constexpr static auto kVersionPrefix = "ver";
+#ifdef CONFIG_BRIDGE_BT_DISCOVERY_CACHE
+	/* The prefix is short, so the key including the Bluetooth LE address fits in the maximum key length. */
+	constexpr static auto kBtDiscoveryCachePrefix = "d";
+#endif
 
 #ifdef CONFIG_BRIDGE_MIGRATE_PRE_2_7_0
 	constexpr static auto kBridgedDeviceEndpointIdPrefix = "eid";
@@ -73,16 +96,36 @@ public:
 	};
 
 	using BridgedDevice = BridgedDeviceV2;
-	static constexpr uint8_t kCurrentVersion = 2;
+	static constexpr uint8_t kCurrentVersion = 3;
 
 	static constexpr auto kMaxIndexLength = 3;
 
+	/* Size of the record fields other than the unique id, node label and user data. */
+	static constexpr size_t kRecordHeaderSize = 8;
+
+#ifdef CONFIG_BRIDGED_DEVICE_BT
+	static constexpr size_t kRecordUserDataReserve = sizeof(bt_addr_le_t);
+#else
+	static constexpr size_t kRecordUserDataReserve = 0;
+#endif
+
+	/* Space for the records of all bridged devices. A record with a bigger user data than reserved fits as long
+	 * as the other records leave enough space. */
+	static constexpr size_t kMaxRecordsSize =
+		CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT * (kRecordHeaderSize + MatterBridgedDevice::kUniqueIDSize +
+							     MatterBridgedDevice::kNodeLabelSize + kRecordUserDataReserve);
+
 	BridgeStorageManager()
 		: mBridge(kBridgePrefix, strlen(kBridgePrefix)),
 		  mBridgedDevicesCount(kBridgedDevicesCountPrefix, strlen(kBridgedDevicesCountPrefix), &mBridge),
 		  mBridgedDevicesIndexes(kBridgedDevicesIndexesPrefix, strlen(kBridgedDevicesIndexesPrefix), &mBridge),
 		  mBridgedDevice(kBridgedDevicePrefix, strlen(kBridgedDevicePrefix), &mBridge),
+		  mBridgedDevices(kBridgedDevicesPrefix, strlen(kBridgedDevicesPrefix), &mBridge),
 		  mVersion(kVersionPrefix, strlen(kVersionPrefix), &mBridge)
+#ifdef CONFIG_BRIDGE_BT_DISCOVERY_CACHE
+		  ,
+		  mBtDiscoveryCache(kBtDiscoveryCachePrefix, strlen(kBtDiscoveryCachePrefix), &mBridge)
+#endif
 #ifdef CONFIG_BRIDGE_MIGRATE_PRE_2_7_0
 		  ,
 		  mBridgedDeviceEndpointId(kBridgedDeviceEndpointIdPrefix, strlen(kBridgedDeviceEndpointIdPrefix),
@@ -121,8 +164,10 @@ public:
 	/**
 	 * @brief Store bridged devices count into settings
 	 *
+	 * The count is derived from the stored bridged devices, so the method only validates it.
+	 *
 	 * @param count count value to be stored
-	 * @return true if key has been written successfully
+	 * @return true if the count matches the number of stored bridged devices
 	 * @return false an error occurred
 	 */
 	bool StoreBridgedDevicesCount(uint8_t count);
@@ -139,6 +184,9 @@ public:
 	/**
 	 * @brief Store bridged devices indexes into settings
 	 *
+	 * The stored bridged devices are ordered as given by the indexes array. Stored bridged devices whose index is not
+	 * present in the array are removed. The settings are written only if the stored data changes.
+	 *
 	 * @param indexes address of array containing indexes to be stored
 	 * @param count size of indexes array to be stored
 	 * @return true if key has been written successfully
@@ -160,6 +208,9 @@ public:
 	/**
 	 * @brief Load bridged device from settings
 	 *
+	 * The bridged devices are loaded from settings once during initialization, so the method does not access the
+	 * persistent storage.
+	 *
 	 * If the caller wants to load the optional user data, the mUserData must be set to the valid buffer to store
 	 * data and mUserDataSize must be set to this data size. On success, the method overrides mUserDataSize with
 	 * the data size actually obtained from the storage.
@@ -169,7 +220,7 @@ public:
 	 * @return true if key has been loaded successfully
 	 * @return false an error occurred
 	 */
-	template <typename T = BridgedDevice> bool LoadBridgedDevice(T &device, uint8_t index);
+	bool LoadBridgedDevice(BridgedDevice &device, uint8_t index);
 
 	/**
 	 * @brief Store bridged device into settings. Helper method allowing to store endpoint id, node label and device
@@ -191,7 +242,81 @@ public:
 	 */
 	bool RemoveBridgedDevice(uint8_t bridgedDeviceIndex);
 
+#ifdef CONFIG_BRIDGE_BT_DISCOVERY_CACHE
+	/**
+	 * @brief Store the GATT discovery cache record of the bridged Bluetooth LE device into settings
+	 *
+	 * @param record record to be stored under the key created from the device address
+	 * @return true if key has been written successfully
+	 * @return false an error occurred
+	 */
+	bool StoreBtDiscoveryCache(const BLEDiscoveryCacheRecord &record);
+
+	/**
+	 * @brief Load the GATT discovery cache record of the bridged Bluetooth LE device from settings
+	 *
+	 * @param record reference to the record object to be filled with loaded data
+	 * @param addr Bluetooth LE address of the device
+	 * @return true if the record of the device has been loaded successfully
+	 * @return false an error occurred
+	 */
+	bool LoadBtDiscoveryCache(BLEDiscoveryCacheRecord &record, const bt_addr_le_t &addr);
+
+	/**
+	 * @brief Remove the GATT discovery cache record of the bridged Bluetooth LE device from settings
+	 *
+	 * @param addr Bluetooth LE address of the device
+	 * @return true if key entry has been removed successfully or it does not exist
+	 * @return false an error occurred
+	 */
+	bool RemoveBtDiscoveryCache(const bt_addr_le_t &addr);
+#endif
+
 private:
+	/**
+	 * @brief Load records of all bridged devices from settings.
+	 *
+	 * @return true if records have been loaded successfully or no records are stored
+	 * @return false an error occurred
+	 */
+	bool LoadRecords();
+
+	/**
+	 * @brief Store records of all bridged devices into settings.
+	 *
+	 * @return true if key has been written successfully
+	 * @return false an error occurred
+	 */
+	bool StoreRecords();
+
+	/**
+	 * @brief Find the record of bridged device at given index.
+	 *
+	 * @param index index describing specific bridged device
+	 * @param size reference to the object to be filled with the record size
+	 * @return pointer to the record or nullptr if the record has not been found
+	 */
+	uint8_t *FindRecord(uint8_t index, size_t &size);
+
+	/**
+	 * @brief Put bridged device record into the records buffer without writing it into settings.
+	 *
+	 * @param device instance of bridged device object to be stored
+	 * @param index index describing specific bridged device
+	 * @return true if the record fits into the buffer
+	 * @return false an error occurred
+	 */
+	bool PutRecord(const BridgedDevice &device, uint8_t index);
+
+	/**
+	 * @brief Remove bridged device record from the records buffer without writing it into settings.
+	 *
+	 * @param index index describing specific bridged device
+	 * @return true if the record has been found and removed
+	 * @return false the record has not been found
+	 */
+	bool DropRecord(uint8_t index);
+
 	/**
 	 * @brief Provides backward compatibility between non-compatible data scheme versions.
 	 *
@@ -199,19 +324,31 @@ private:
 	 * means that the old scheme is used - pre nRF Connect SDK 2.7.0) or if the version is different than
 	 * kCurrentVersion, the migration has to be done.
 	 *
+	 * The data of all bridged devices is stored using the current scheme in a single write, and the data stored
+	 * using the previous scheme is removed once the version key is updated.
+	 *
 	 * @return true if migration was successful
 	 * @return false an error occurred
 	 */
 	bool MigrateData();
 
+	/**
+	 * @brief Remove bridged device data stored using the previous data scheme.
+	 *
+	 * @param version data scheme version or 0 for pre nRF Connect SDK 2.7.0 scheme
+	 * @param indexes address of array containing indexes of migrated bridged devices
+	 * @param count size of indexes array
+	 */
+	void RemoveLegacyData(uint8_t version, const uint8_t *indexes, size_t count);
+
 #ifdef CONFIG_BRIDGE_MIGRATE_PRE_2_7_0
 	/**
 	 * @brief Migrate bridged device data at given index.
 	 *
 	 * It migrates bridge device structure from pre nRF Connect SDK 2.7.0 scheme to current one. Method loads the
-	 * data using key names from an old scheme, removes the old data and stores again using the new key names.
+	 * data using key names from an old scheme and puts it into the records buffer.
 	 *
-	 * @param bridgedDeviceIndex index describing specific bridged device to be removed
+	 * @param bridgedDeviceIndex index describing specific bridged device to be migrated
 	 * @return true if migration was successful
 	 * @return false an error occurred
 	 */
@@ -224,11 +361,44 @@ private:
 	 *
 	 * It migrates bridge device structure from version 1 to current one.
 	 *
-	 * @param bridgedDeviceIndex index describing specific bridged device to be removed
+	 * @param bridgedDeviceIndex index describing specific bridged device to be migrated
 	 * @return true if migration was successful
 	 * @return false an error occurred
 	 */
 	bool MigrateDataVersion1(uint8_t bridgedDeviceIndex);
+
+	/**
+	 * @brief Load bridged device stored using version 1 scheme from settings
+	 *
+	 * @param device instance of bridged device object to be filled with loaded data.
+	 * @param index index describing specific bridged device
+	 * @return true if key has been loaded successfully
+	 * @return false an error occurred
+	 */
+	bool LoadLegacyBridgedDevice(BridgedDeviceV1 &device, uint8_t index);
+#endif
+
+#ifdef CONFIG_BRIDGE_MIGRATE_VERSION_2
+	/**
+	 * @brief Migrate bridged device data at given index.
+	 *
+	 * It migrates bridge device structure from version 2 to current one.
+	 *
+	 * @param bridgedDeviceIndex index describing specific bridged device to be migrated
+	 * @return true if migration was successful
+	 * @return false an error occurred
+	 */
+	bool MigrateDataVersion2(uint8_t bridgedDeviceIndex);
+
+	/**
+	 * @brief Load bridged device stored using version 2 scheme from settings
+	 *
+	 * @param device instance of bridged device object to be filled with loaded data.
+	 * @param index index describing specific bridged device
+	 * @return true if key has been loaded successfully
+	 * @return false an error occurred
+	 */
+	bool LoadLegacyBridgedDevice(BridgedDeviceV2 &device, uint8_t index);
 #endif
 
 	/* The below methods are deprecated and used only for the migration purposes between the older scheme versions.
@@ -321,7 +491,15 @@ private:
 	Nrf::PersistentStorageNode mBridgedDevicesCount;
 	Nrf::PersistentStorageNode mBridgedDevicesIndexes;
 	Nrf::PersistentStorageNode mBridgedDevice;
+	Nrf::PersistentStorageNode mBridgedDevices;
 	Nrf::PersistentStorageNode mVersion;
+#ifdef CONFIG_BRIDGE_BT_DISCOVERY_CACHE
+	Nrf::PersistentStorageNode mBtDiscoveryCache;
+#endif
+
+	uint8_t mRecords[kMaxRecordsSize];
+	size_t mRecordsSize = 0;
+	uint8_t mRecordsCount = 0;
 
 #ifdef CONFIG_BRIDGE_MIGRATE_PRE_2_7_0
 	/* The below fields are deprecated and used only for the migration purposes between the older scheme versions.
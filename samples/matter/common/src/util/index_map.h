@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace Nrf
+{
+/*
+   IndexMap template container maps T-type unsigned integer keys to indexes of elements stored in an array of
+   N elements, for example Matter endpoint ids to the indexes of the bridged devices.
+   The keys are stored in an open addressing hash table with linear probing, which is at least twice as large as
+   the maximum number of stored keys. The key itself is used as the hash, so keys being consecutive numbers,
+   like the dynamic endpoint ids, are mapped to different slots and are found in constant time.
+   IndexMap's API offers basic operations like:
+     * inserting a new key with the index (Insert)
+     * erasing an existing key (Erase) - the following keys of the probe sequence are moved back, so the
+       erased slots do not make the lookups longer
+     * retrieving the index stored under a given key (Find)
+     * retrieving a number of stored keys (Size)
+	Prerequisites:
+     * T must be an unsigned integer type and its maximum numeric limit is reserved and assigned as an invalid key.
+*/
+template <typename T, uint16_t N> class IndexMap {
+	static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>);
+
+public:
+	static constexpr T kInvalidKey{ std::numeric_limits<T>::max() };
+	static constexpr uint16_t kInvalidIndex{ std::numeric_limits<uint16_t>::max() };
+
+	bool Insert(T key, uint16_t index)
+	{
+		if (key == kInvalidKey || mElementsCount >= N) {
+			return false;
+		}
+
+		std::size_t slot = FindSlot(key);
+
+		if (mSlots[slot].key == key) {
+			/* The key already exists in the map, return prematurely. */
+			return false;
+		}
+
+		mSlots[slot].key = key;
+		mSlots[slot].index = index;
+		mElementsCount++;
+
+		return true;
+	}
+
+	bool Erase(T key)
+	{
+		if (key == kInvalidKey) {
+			return false;
+		}
+
+		std::size_t slot = FindSlot(key);
+
+		if (mSlots[slot].key != key) {
+			return false;
+		}
+
+		/* Move back the following keys of the probe sequence that would not be found after emptying the slot. */
+		for (std::size_t next = NextSlot(slot); mSlots[next].key != kInvalidKey; next = NextSlot(next)) {
+			const std::size_t home = HomeSlot(mSlots[next].key);
+
+			if (((next - home) & kSlotMask) >= ((next - slot) & kSlotMask)) {
+				mSlots[slot] = mSlots[next];
+				slot = next;
+			}
+		}
+
+		mSlots[slot] = Slot{};
+		mElementsCount--;
+
+		return true;
+	}
+
+	uint16_t Find(T key) const
+	{
+		if (key == kInvalidKey) {
+			return kInvalidIndex;
+		}
+
+		const Slot &slot = mSlots[FindSlot(key)];
+
+		return slot.key == key ? slot.index : kInvalidIndex;
+	}
+
+	uint16_t Size() const { return mElementsCount; }
+
+private:
+	struct Slot {
+		T key{ kInvalidKey };
+		uint16_t index{ kInvalidIndex };
+	};
+
+	static constexpr std::size_t GetSlotsCount()
+	{
+		std::size_t count = 1;
+
+		/* Keep at least half of the slots empty to terminate the probe sequences early. */
+		while (count < 2 * static_cast<std::size_t>(N)) {
+			count <<= 1;
+		}
+
+		return count;
+	}
+
+	static constexpr std::size_t kSlotsCount{ GetSlotsCount() };
+	static constexpr std::size_t kSlotMask{ kSlotsCount - 1 };
+
+	static std::size_t HomeSlot(T key) { return static_cast<std::size_t>(key) & kSlotMask; }
+	static std::size_t NextSlot(std::size_t slot) { return (slot + 1) & kSlotMask; }
+
+	/* Find the slot storing the key, or the empty slot in which the key would be stored. */
+	std::size_t FindSlot(T key) const
+	{
+		std::size_t slot = HomeSlot(key);
+
+		while (mSlots[slot].key != key && mSlots[slot].key != kInvalidKey) {
+			slot = NextSlot(slot);
+		}
+
+		return slot;
+	}
+
+	Slot mSlots[kSlotsCount];
+	uint16_t mElementsCount{ 0 };
+};
+
+} /* namespace Nrf */
@@ -246,6 +246,30 @@ static int cmd_log_rpc_time(const struct shell *sh, size_t argc, char *argv[])
 	return 0;
 }
 
+static int cmd_log_rpc_stats(const struct shell *sh, size_t argc, char *argv[])
+{
+	struct log_rpc_stats stats;
+	bool reset = (argc > 1) && (strcmp(argv[1], "reset") == 0);
+	int rc;
+
+	rc = log_rpc_get_stats(&stats, reset);
+
+	if (rc) {
+		shell_error(sh, "Failed to get statistics: %d", rc);
+		return rc;
+	}
+
+	shell_print(sh, "Sent messages: %u", stats.sent_msgs);
+	shell_print(sh, "Sent events: %u", stats.sent_events);
+	shell_print(sh, "Sent bytes: %u", stats.sent_bytes);
+	shell_print(sh, "Filtered messages: %u", stats.filtered_msgs);
+	shell_print(sh, "Dropped messages: %u", stats.dropped_msgs);
+	shell_print(sh, "Failed messages: %u", stats.failed_msgs);
+	shell_print(sh, "Max send time: %u us", stats.send_time_max_us);
+
+	return 0;
+}
+
 SHELL_STATIC_SUBCMD_SET_CREATE(crash_cmds,
 			       SHELL_CMD_ARG(invalidate, NULL, "Invalidate crash dump",
 					     cmd_log_rpc_crash_invalidate, 1, 0),
@@ -269,6 +293,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 	SHELL_CMD_ARG(echo, NULL, "Generate log message on remote <0-4> <msg>", cmd_log_rpc_echo, 3,
 		      0),
 	SHELL_CMD_ARG(time, NULL, "Set current time <time_us|now>", cmd_log_rpc_time, 2, 0),
+	SHELL_CMD_ARG(stats, NULL, "Get logging backend statistics [reset]", cmd_log_rpc_stats, 1,
+		      1),
 	SHELL_SUBCMD_SET_END);
 
 SHELL_CMD_ARG_REGISTER(log_rpc, &log_rpc_cmds, "RPC logging commands", NULL, 1, 0);
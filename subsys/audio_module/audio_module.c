@@ -19,6 +19,52 @@ LOG_MODULE_REGISTER(audio_module, CONFIG_AUDIO_MODULE_LOG_LEVEL);
 /* Define a timeout to prevent system locking */
 #define LOCK_TIMEOUT_US (K_USEC(100))
 
+#if defined(CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER)
+/**
+ * @brief Reference counted audio data buffer, shared by all consumers of a module's output.
+ */
+struct audio_module_buf_ref {
+	/* Number of consumers still holding the buffer. */
+	atomic_t ref_count;
+
+	/* The slab the data buffer was taken from. */
+	struct k_mem_slab *data_slab;
+
+	/* The data buffer. */
+	void *data;
+};
+
+K_MEM_SLAB_DEFINE_STATIC(buf_ref_slab, sizeof(struct audio_module_buf_ref),
+			 CONFIG_AUDIO_MODULE_CHAIN_BUF_REF_NUM, 4);
+#endif /* CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER */
+
+/**
+ * @brief Wait until a module has finished processing audio data and keep it from starting again.
+ *
+ * @note With the chain scheduler, a module's destinations are processed while the module's lock
+ *       is held, so the lock of a module also waits for the rest of the chain after it.
+ *
+ * @param handle  [in/out]  The handle for the module.
+ */
+static void process_lock(struct audio_module_handle *handle)
+{
+#if defined(CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER)
+	(void)k_mutex_lock(&handle->process_mutex, K_FOREVER);
+#endif /* CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER */
+}
+
+/**
+ * @brief Allow a module to process audio data again.
+ *
+ * @param handle  [in/out]  The handle for the module.
+ */
+static void process_unlock(struct audio_module_handle *handle)
+{
+#if defined(CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER)
+	(void)k_mutex_unlock(&handle->process_mutex);
+#endif /* CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER */
+}
+
 /**
  * @brief Helper function to validate the module state.
  *
@@ -178,6 +224,12 @@ static int data_tx(struct audio_module_handle *tx_handle, struct audio_module_ha
 	int ret;
 	struct audio_module_message *data_msg_rx;
 
+	if (IS_ENABLED(CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER) && rx_handle->thread_id == NULL) {
+		LOG_ERR("Module %s is run by its source module and has no thread to receive data",
+			rx_handle->name);
+		return -ECANCELED;
+	}
+
 	if (rx_handle->state == AUDIO_MODULE_STATE_RUNNING) {
 		ret = data_fifo_pointer_first_vacant_get(rx_handle->thread.msg_rx,
 							 (void **)&data_msg_rx, K_NO_WAIT);
@@ -190,6 +242,7 @@ static int data_tx(struct audio_module_handle *tx_handle, struct audio_module_ha
 		memcpy(&(data_msg_rx->audio_data), audio_data, sizeof(struct audio_data));
 		data_msg_rx->tx_handle = tx_handle;
 		data_msg_rx->response_cb = data_in_response_cb;
+		data_msg_rx->buf_ref = NULL;
 
 		ret = data_fifo_block_lock(rx_handle->thread.msg_rx, (void **)&data_msg_rx,
 					   sizeof(struct audio_module_message));
@@ -217,11 +270,14 @@ static int data_tx(struct audio_module_handle *tx_handle, struct audio_module_ha
  *
  * @param handle      [in/out]  The handle for this modules instance.
  * @param audio_data  [in]      A pointer to the audio data.
+ * @param buf_ref     [in]      Reference to the shared audio data buffer, or NULL to release the
+ *                              audio data with the module's semaphore count.
  *
  * @return 0 if successful, error otherwise.
  */
 static int tx_fifo_put(struct audio_module_handle *handle,
-		       struct audio_data const *const audio_data)
+		       struct audio_data const *const audio_data,
+		       struct audio_module_buf_ref *buf_ref)
 {
 	int ret;
 	struct audio_module_message *data_msg_tx;
@@ -237,7 +293,8 @@ static int tx_fifo_put(struct audio_module_handle *handle,
 	/* Configure audio data. */
 	memcpy(&data_msg_tx->audio_data, audio_data, sizeof(struct audio_data));
 	data_msg_tx->tx_handle = handle;
-	data_msg_tx->response_cb = audio_data_release_cb;
+	data_msg_tx->response_cb = (buf_ref == NULL) ? audio_data_release_cb : NULL;
+	data_msg_tx->buf_ref = buf_ref;
 
 	/* Send audio data to modules output message queue. */
 	ret = data_fifo_block_lock(handle->thread.msg_tx, (void **)&data_msg_tx,
@@ -248,9 +305,11 @@ static int tx_fifo_put(struct audio_module_handle *handle,
 
 		data_fifo_block_free(handle->thread.msg_tx, (void *)data_msg_tx);
 
-		ret = k_sem_take(&handle->sem, K_NO_WAIT);
-		if (ret) {
-			LOG_ERR("Failed to take semaphore for TX FIFO put");
+		if (buf_ref == NULL) {
+			ret = k_sem_take(&handle->sem, K_NO_WAIT);
+			if (ret) {
+				LOG_ERR("Failed to take semaphore for TX FIFO put");
+			}
 		}
 
 		return ret;
@@ -261,6 +320,198 @@ static int tx_fifo_put(struct audio_module_handle *handle,
 	return 0;
 }
 
+#if defined(CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER)
+/**
+ * @brief Wrap a data buffer taken from a module's slab in a new buffer reference.
+ *
+ * @param data_slab  [in]  The slab the data buffer was taken from.
+ * @param data       [in]  The data buffer.
+ *
+ * @return Pointer to the buffer reference holding one reference, NULL if none is free.
+ */
+static struct audio_module_buf_ref *buf_ref_new(struct k_mem_slab *data_slab, void *data)
+{
+	int ret;
+	struct audio_module_buf_ref *buf_ref;
+
+	ret = k_mem_slab_alloc(&buf_ref_slab, (void **)&buf_ref, K_NO_WAIT);
+	if (ret) {
+		return NULL;
+	}
+
+	atomic_set(&buf_ref->ref_count, 1);
+	buf_ref->data_slab = data_slab;
+	buf_ref->data = data;
+
+	return buf_ref;
+}
+
+/**
+ * @brief Drop a reference to a shared data buffer, the buffer is freed with the last reference.
+ *
+ * @param buf_ref  [in/out]  The buffer reference.
+ */
+static void buf_ref_put(struct audio_module_buf_ref *buf_ref)
+{
+	if (atomic_dec(&buf_ref->ref_count) != 1) {
+		return;
+	}
+
+	k_mem_slab_free(buf_ref->data_slab, buf_ref->data);
+	k_mem_slab_free(&buf_ref_slab, (void *)buf_ref);
+}
+
+static int chain_process(struct audio_module_handle *handle,
+			 struct audio_data const *const audio_data_rx);
+
+/**
+ * @brief Pass a module's output to all its destinations within the calling thread.
+ *
+ * @note The destination modules all read the same data buffer, which is only freed once the
+ *       last destination, including the module's TX FIFO, has released it. A chained module has
+ *       a single source and no thread of its own, so it is only ever run by this thread.
+ *
+ * @param handle      [in/out]  The handle for the module that produced the audio data.
+ * @param audio_data  [in]      Pointer to the audio data, taken from the module's data slab.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+static int chain_send(struct audio_module_handle *handle, struct audio_data const *const audio_data)
+{
+	int ret;
+	struct audio_module_handle *handle_to;
+	struct audio_module_handle *handles_to[CONFIG_AUDIO_MODULE_CHAIN_DEST_NUM];
+	size_t handles_to_num = 0;
+	struct audio_module_buf_ref *buf_ref;
+
+	buf_ref = buf_ref_new(handle->thread.data_slab, audio_data->data);
+	if (buf_ref == NULL) {
+		LOG_ERR("No free buffer reference for module %s", handle->name);
+		k_mem_slab_free(handle->thread.data_slab, (void *)audio_data->data);
+		return -ENOMEM;
+	}
+
+	ret = k_mutex_lock(&handle->dest_mutex, LOCK_TIMEOUT_US);
+	if (ret) {
+		LOG_ERR("Failed to take MUTEX lock in time");
+		buf_ref_put(buf_ref);
+		return ret;
+	}
+
+	/* Take a copy of the destinations, so the lock is not held while they are processed. */
+	SYS_SLIST_FOR_EACH_CONTAINER(&handle->handle_dest_list, handle_to, node) {
+		if (handles_to_num == ARRAY_SIZE(handles_to)) {
+			break;
+		}
+
+		handles_to[handles_to_num++] = handle_to;
+	}
+
+	k_mutex_unlock(&handle->dest_mutex);
+
+	for (size_t i = 0; i < handles_to_num; i++) {
+		ret = chain_process(handles_to[i], audio_data);
+		if (ret) {
+			LOG_WRN("Module %s failed to process audio data from %s, ret %d",
+				handles_to[i]->name, handle->name, ret);
+		}
+	}
+
+	ret = 0;
+
+	/* The TX FIFO holds its own reference until the audio data is read out. */
+	if (handle->use_tx_queue && handle->thread.msg_tx) {
+		atomic_inc(&buf_ref->ref_count);
+
+		ret = tx_fifo_put(handle, audio_data, buf_ref);
+		if (ret) {
+			LOG_ERR("Failed to send audio data on module %s TX message queue",
+				handle->name);
+			buf_ref_put(buf_ref);
+		}
+	}
+
+	buf_ref_put(buf_ref);
+
+	return ret;
+}
+
+/**
+ * @brief Process audio data in a module and pass the result on, within the calling thread.
+ *
+ * @param handle         [in/out]  The handle for the module to run.
+ * @param audio_data_rx  [in]      Pointer to the input audio data.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+static int chain_process(struct audio_module_handle *handle,
+			 struct audio_data const *const audio_data_rx)
+{
+	int ret;
+	struct audio_data audio_data;
+	void *data;
+
+	/* Stopping or disconnecting the module waits until it is done. */
+	process_lock(handle);
+
+	if (!state_running(handle->state)) {
+		LOG_WRN("Receiving module %s is in an invalid state %d", handle->name,
+			handle->state);
+		ret = -ECANCELED;
+		goto out;
+	}
+
+	if (handle->description->type == AUDIO_MODULE_TYPE_OUTPUT) {
+		ret = handle->description->functions->data_process(
+			(struct audio_module_handle_private *)handle, audio_data_rx, NULL);
+		goto out;
+	}
+
+	ret = k_mem_slab_alloc(handle->thread.data_slab, (void **)&data, K_NO_WAIT);
+	if (ret) {
+		LOG_ERR("No free data buffer for module %s, ret %d", handle->name, ret);
+		goto out;
+	}
+
+	audio_data.data = data;
+	audio_data.data_size = handle->thread.data_size;
+
+	ret = handle->description->functions->data_process(
+		(struct audio_module_handle_private *)handle, audio_data_rx, &audio_data);
+	if (ret) {
+		k_mem_slab_free(handle->thread.data_slab, data);
+		goto out;
+	}
+
+	ret = chain_send(handle, &audio_data);
+
+out:
+	process_unlock(handle);
+
+	return ret;
+}
+#endif /* CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER */
+
+/**
+ * @brief Release an audio data item taken from a module's FIFO.
+ *
+ * @param msg  [in/out]  The message holding the audio data.
+ */
+static void message_release(struct audio_module_message *msg)
+{
+#if defined(CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER)
+	if (msg->buf_ref != NULL) {
+		buf_ref_put(msg->buf_ref);
+		return;
+	}
+#endif /* CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER */
+
+	if (msg->response_cb != NULL) {
+		msg->response_cb((struct audio_module_handle_private *)msg->tx_handle,
+				 &msg->audio_data);
+	}
+}
+
 /**
  * @brief Send the audio data item to all connected modules.
  *
@@ -284,6 +535,11 @@ static int send_to_connected_modules(struct audio_module_handle *handle,
 		return 0;
 	}
 
+#if defined(CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER)
+	/* Run the connected modules in this thread rather than queuing the audio data to them. */
+	return chain_send(handle, audio_data);
+#endif /* CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER */
+
 	/* We need to ensure that all receiving modules have got the audio data.
 	 * This is so the first receiver cannot free the audio data before all receivers
 	 * have all gotten the audio data.
@@ -324,7 +580,7 @@ static int send_to_connected_modules(struct audio_module_handle *handle,
 	 * process with audio_module_rx().
 	 */
 	if (handle->use_tx_queue && handle->thread.msg_tx) {
-		ret = tx_fifo_put(handle, audio_data);
+		ret = tx_fifo_put(handle, audio_data, NULL);
 		if (ret) {
 			LOG_ERR("Failed to send audio data on module %s TX message queue",
 				handle->name);
@@ -379,10 +635,14 @@ static void module_thread_input(struct audio_module_handle *handle, void *p2, vo
 		audio_data.data = data;
 		audio_data.data_size = handle->thread.data_size;
 
+		process_lock(handle);
+
 		/* Process the input audio data */
 		ret = handle->description->functions->data_process(
 			(struct audio_module_handle_private *)handle, NULL, &audio_data);
 		if (ret) {
+			process_unlock(handle);
+
 			k_mem_slab_free(handle->thread.data_slab, (void *)(data));
 
 			LOG_ERR("Data process error in module %s, ret %d", handle->name, ret);
@@ -393,6 +653,8 @@ static void module_thread_input(struct audio_module_handle *handle, void *p2, vo
 
 		/* Send input audio data to next module(s). */
 		send_to_connected_modules(handle, &audio_data);
+
+		process_unlock(handle);
 	}
 
 	CODE_UNREACHABLE;
@@ -437,8 +699,10 @@ static void module_thread_output(struct audio_module_handle *handle, void *p2, v
 		LOG_DBG("Module %s new audio data received", handle->name);
 
 		/* Process the input audio data and output from the audio system. */
+		process_lock(handle);
 		ret = handle->description->functions->data_process(
 			(struct audio_module_handle_private *)handle, &msg_rx->audio_data, NULL);
+		process_unlock(handle);
 		if (ret) {
 			if (msg_rx->response_cb != NULL) {
 				msg_rx->response_cb(
@@ -504,11 +768,15 @@ static void module_thread_in_out(struct audio_module_handle *handle, void *p2, v
 		audio_data.data = data;
 		audio_data.data_size = handle->thread.data_size;
 
+		process_lock(handle);
+
 		/* Process the input audio data into the output audio data. */
 		ret = handle->description->functions->data_process(
 			(struct audio_module_handle_private *)handle, &msg_rx->audio_data,
 			&audio_data);
 		if (ret) {
+			process_unlock(handle);
+
 			if (msg_rx->response_cb != NULL) {
 				msg_rx->response_cb(
 					(struct audio_module_handle_private *)(msg_rx->tx_handle),
@@ -526,6 +794,8 @@ static void module_thread_in_out(struct audio_module_handle *handle, void *p2, v
 		/* Send processed audio data to next module(s). */
 		send_to_connected_modules(handle, &audio_data);
 
+		process_unlock(handle);
+
 		if (msg_rx->response_cb != NULL) {
 			msg_rx->response_cb((struct audio_module_handle_private *)msg_rx->tx_handle,
 					    &msg_rx->audio_data);
@@ -537,13 +807,63 @@ static void module_thread_in_out(struct audio_module_handle *handle, void *p2, v
 	CODE_UNREACHABLE;
 }
 
+/**
+ * @brief Create and start the thread of a module.
+ *
+ * @param handle  [in/out]  The handle for this modules instance.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+static int module_thread_start(struct audio_module_handle *handle)
+{
+	int ret;
+	k_thread_entry_t thread_entry;
+
+	switch (handle->description->type) {
+	case AUDIO_MODULE_TYPE_INPUT:
+		thread_entry = (k_thread_entry_t)module_thread_input;
+		break;
+
+	case AUDIO_MODULE_TYPE_OUTPUT:
+		thread_entry = (k_thread_entry_t)module_thread_output;
+		break;
+
+	case AUDIO_MODULE_TYPE_IN_OUT:
+		thread_entry = (k_thread_entry_t)module_thread_in_out;
+		break;
+
+	default:
+		LOG_ERR("Invalid module type %d for module %s", handle->description->type,
+			handle->name);
+		return -EINVAL;
+	}
+
+	handle->thread_id = k_thread_create(
+		&handle->thread_data, handle->thread.stack, handle->thread.stack_size, thread_entry,
+		(void *)handle, NULL, NULL, K_PRIO_PREEMPT(handle->thread.priority), 0, K_FOREVER);
+
+	ret = k_thread_name_set(handle->thread_id, &handle->name[0]);
+	if (ret) {
+		LOG_ERR("Failed to start thread for module %s thread, ret %d", handle->name, ret);
+
+		k_thread_abort(handle->thread_id);
+		handle->thread_id = NULL;
+		return ret;
+	}
+
+	k_thread_start(handle->thread_id);
+
+	LOG_DBG("Thread started");
+
+	return 0;
+}
+
 int audio_module_open(struct audio_module_parameters const *const parameters,
 		      struct audio_module_configuration const *const configuration,
 		      char const *const name, struct audio_module_context *context,
 		      struct audio_module_handle *handle)
 {
 	int ret;
-	k_thread_entry_t thread_entry;
 
 	if (parameters == NULL || configuration == NULL || name == NULL || handle == NULL ||
 	    context == NULL) {
@@ -593,25 +913,6 @@ int audio_module_open(struct audio_module_parameters const *const parameters,
 		return ret;
 	}
 
-	switch (handle->description->type) {
-	case AUDIO_MODULE_TYPE_INPUT:
-		thread_entry = (k_thread_entry_t)module_thread_input;
-		break;
-
-	case AUDIO_MODULE_TYPE_OUTPUT:
-		thread_entry = (k_thread_entry_t)module_thread_output;
-		break;
-
-	case AUDIO_MODULE_TYPE_IN_OUT:
-		thread_entry = (k_thread_entry_t)module_thread_in_out;
-		break;
-
-	default:
-		LOG_ERR("Invalid module type %d for module %s", handle->description->type,
-			handle->name);
-		return -EINVAL;
-	}
-
 	if (handle->thread.msg_rx != NULL && !data_fifo_state(handle->thread.msg_rx)) {
 		ret = data_fifo_init(handle->thread.msg_rx);
 		if (ret) {
@@ -638,25 +939,21 @@ int audio_module_open(struct audio_module_parameters const *const parameters,
 
 	sys_slist_init(&handle->handle_dest_list);
 	k_mutex_init(&handle->dest_mutex);
-
-	handle->thread_id = k_thread_create(
-		&handle->thread_data, handle->thread.stack, handle->thread.stack_size, thread_entry,
-		(void *)handle, NULL, NULL, K_PRIO_PREEMPT(handle->thread.priority), 0, K_FOREVER);
-
-	ret = k_thread_name_set(handle->thread_id, &handle->name[0]);
-	if (ret) {
-		LOG_ERR("Failed to start thread for module %s thread, ret %d", handle->name, ret);
-
-		/* Clean up the handle. */
-		memset(handle, 0, sizeof(struct audio_module_handle));
-		return ret;
-	}
+	k_mutex_init(&handle->process_mutex);
 
 	handle->state = AUDIO_MODULE_STATE_CONFIGURED;
 
-	k_thread_start(handle->thread_id);
-
-	LOG_DBG("Thread started");
+	/* With the chain scheduler, the thread is only started by audio_module_start() for a
+	 * module that is not run by the thread of a source module.
+	 */
+	if (!IS_ENABLED(CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER)) {
+		ret = module_thread_start(handle);
+		if (ret) {
+			/* Clean up the handle. */
+			memset(handle, 0, sizeof(struct audio_module_handle));
+			return ret;
+		}
+	}
 
 	return 0;
 }
@@ -676,10 +973,15 @@ int audio_module_close(struct audio_module_handle *handle)
 		return -ECANCELED;
 	}
 
+	/* The thread is not aborted while it processes audio data. */
+	process_lock(handle);
+
 	if (handle->description->functions->close != NULL) {
 		ret = handle->description->functions->close(
 			(struct audio_module_handle_private *)handle);
 		if (ret) {
+			process_unlock(handle);
+
 			LOG_ERR("Failed close call to module %s, returned %d", handle->name, ret);
 			return ret;
 		}
@@ -698,7 +1000,11 @@ int audio_module_close(struct audio_module_handle *handle)
 	 *       Test the semaphore and wait for it to be zero.
 	 */
 
-	k_thread_abort(handle->thread_id);
+	if (handle->thread_id != NULL) {
+		k_thread_abort(handle->thread_id);
+	}
+
+	process_unlock(handle);
 
 	/* Ensure module handle data is fully cleared. */
 	memset(handle, 0, sizeof(struct audio_module_handle));
@@ -819,6 +1125,16 @@ int audio_module_connect(struct audio_module_handle *handle_from,
 			LOG_WRN("A module is in an invalid state for connecting");
 			return -ECANCELED;
 		}
+
+		/* A chained module is run by the thread of its source module, so it can neither
+		 * have a second source nor a thread of its own.
+		 */
+		if (IS_ENABLED(CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER) &&
+		    (handle_to->src_count != 0 || handle_to->thread_id != NULL)) {
+			LOG_ERR("Module %s already has a source or runs in its own thread",
+				handle_to->name);
+			return -ECANCELED;
+		}
 	}
 
 	ret = k_mutex_lock(&handle_from->dest_mutex, LOCK_TIMEOUT_US);
@@ -827,6 +1143,15 @@ int audio_module_connect(struct audio_module_handle *handle_from,
 		return ret;
 	}
 
+#if defined(CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER)
+	if (!connect_external &&
+	    sys_slist_len(&handle_from->handle_dest_list) >= CONFIG_AUDIO_MODULE_CHAIN_DEST_NUM) {
+		LOG_ERR("Module %s has too many destinations", handle_from->name);
+		k_mutex_unlock(&handle_from->dest_mutex);
+		return -ENOMEM;
+	}
+#endif /* CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER */
+
 	/* If the connect_external is true the handle_from module will queue it's output
 	 * data to it's own TX FIFO. Thus allowing an external system to receive the data
 	 * with a call to audio_module_data_rx() with the same handle.
@@ -845,6 +1170,7 @@ int audio_module_connect(struct audio_module_handle *handle_from,
 		}
 
 		sys_slist_append(&handle_from->handle_dest_list, &handle_to->node);
+		handle_to->src_count++;
 
 		LOG_DBG("Connected the output of %s to the input of %s", handle_from->name,
 			handle_to->name);
@@ -912,8 +1238,13 @@ int audio_module_disconnect(struct audio_module_handle *handle,
 		}
 	}
 
+	/* The destinations are not changed while the module passes audio data on to them. */
+	process_lock(handle);
+
 	ret = k_mutex_lock(&handle->dest_mutex, LOCK_TIMEOUT_US);
 	if (ret) {
+		process_unlock(handle);
+
 		LOG_ERR("Failed to take MUTEX lock in time");
 		return ret;
 	}
@@ -929,11 +1260,16 @@ int audio_module_disconnect(struct audio_module_handle *handle,
 	} else {
 		if (!sys_slist_find_and_remove(&handle->handle_dest_list,
 					       &handle_disconnect->node)) {
+			k_mutex_unlock(&handle->dest_mutex);
+			process_unlock(handle);
+
 			LOG_ERR("Connection to module %s has not been found for module %s",
 				handle_disconnect->name, handle->name);
 			return -EALREADY;
 		}
 
+		handle_disconnect->src_count--;
+
 		LOG_DBG("Disconnect module %s from module %s", handle_disconnect->name,
 			handle->name);
 	}
@@ -941,6 +1277,9 @@ int audio_module_disconnect(struct audio_module_handle *handle,
 	handle->dest_count--;
 
 	ret = k_mutex_unlock(&handle->dest_mutex);
+
+	process_unlock(handle);
+
 	if (ret) {
 		LOG_ERR("Failed to release MUTEX lock");
 		return ret;
@@ -969,6 +1308,15 @@ int audio_module_start(struct audio_module_handle *handle)
 		return -EALREADY;
 	}
 
+	/* With the chain scheduler, only a module without a source needs a thread of its own. */
+	if (IS_ENABLED(CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER) && handle->thread_id == NULL &&
+	    handle->src_count == 0) {
+		ret = module_thread_start(handle);
+		if (ret) {
+			return ret;
+		}
+	}
+
 	if (handle->description->functions->start != NULL) {
 		ret = handle->description->functions->start(
 			(struct audio_module_handle_private *)handle);
@@ -1003,10 +1351,15 @@ int audio_module_stop(struct audio_module_handle *handle)
 		return -EALREADY;
 	}
 
+	/* Return only once the module, and the modules chained after it, are idle. */
+	process_lock(handle);
+
 	if (handle->description->functions->stop != NULL) {
 		ret = handle->description->functions->stop(
 			(struct audio_module_handle_private *)handle);
 		if (ret) {
+			process_unlock(handle);
+
 			LOG_ERR("Failed user pause for module %s, ret %d", handle->name, ret);
 			return ret;
 		}
@@ -1014,6 +1367,8 @@ int audio_module_stop(struct audio_module_handle *handle)
 
 	handle->state = AUDIO_MODULE_STATE_STOPPED;
 
+	process_unlock(handle);
+
 	return 0;
 }
 
@@ -1108,10 +1463,7 @@ int audio_module_data_rx(struct audio_module_handle *handle, struct audio_data *
 		LOG_WRN("Data buffer size is 0");
 	}
 
-	if (msg_rx->response_cb != NULL) {
-		msg_rx->response_cb((struct audio_module_handle_private *)msg_rx->tx_handle,
-				    &msg_rx->audio_data);
-	}
+	message_release(msg_rx);
 
 	data_fifo_block_free(handle->thread.msg_tx, (void *)msg_rx);
 
@@ -1189,10 +1541,7 @@ int audio_module_data_tx_rx(struct audio_module_handle *handle_tx,
 		LOG_WRN("Data buffer size is 0");
 	}
 
-	if (msg_rx->response_cb != NULL) {
-		msg_rx->response_cb((struct audio_module_handle_private *)msg_rx->tx_handle,
-				    &msg_rx->audio_data);
-	}
+	message_release(msg_rx);
 
 	data_fifo_block_free(handle_rx->thread.msg_tx, (void *)msg_rx);
 
@@ -0,0 +1,701 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/cs.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net_buf.h>
+#include <bluetooth/services/ras.h>
+#include <bluetooth/cs_de.h>
+#include <bluetooth/cs_de_pipeline.h>
+
+LOG_MODULE_REGISTER(cs_de_pipeline, CONFIG_BT_CS_DE_LOG_LEVEL);
+
+#define PEER_CNT	CONFIG_BT_CS_DE_PIPELINE_MAX_PEERS
+#define SLOT_CNT	CONFIG_BT_CS_DE_PIPELINE_PROCEDURE_CNT
+/* Every procedure slot can own a peer ranging data buffer. One more buffer is needed to
+ * receive real-time ranging data while all slots are occupied.
+ */
+#define PEER_BUF_CNT	(SLOT_CNT + 1)
+
+#define LOCAL_PROCEDURE_MEM                                                                        \
+	((BT_RAS_MAX_STEPS_PER_PROCEDURE * sizeof(struct bt_le_cs_subevent_step)) +                \
+	 (BT_RAS_MAX_STEPS_PER_PROCEDURE * BT_RAS_MAX_STEP_DATA_LEN))
+
+BUILD_ASSERT(PEER_BUF_CNT <= 32);
+
+enum slot_state {
+	/* Slot is not used. */
+	SLOT_STATE_FREE,
+	/* Local step data of the procedure is being received. */
+	SLOT_STATE_LOCAL,
+	/* Local step data is complete, waiting for the peer ranging data. */
+	SLOT_STATE_WAIT_PEER,
+	/* Procedure is waiting for the distance estimation. */
+	SLOT_STATE_READY,
+	/* Distance estimation is in progress. */
+	SLOT_STATE_PROCESSING,
+};
+
+struct procedure_slot {
+	enum slot_state state;
+	uint16_t ranging_counter;
+
+	/* Peer notified that the ranging data is available. */
+	bool rd_ready;
+
+	/* Buffer with the peer ranging data, owned by the slot. */
+	struct net_buf_simple *peer_rd;
+
+	/* Time when the procedure data became complete (hardware cycles). */
+	uint32_t ready_ts;
+
+	struct net_buf_simple local_steps;
+	uint8_t local_steps_mem[LOCAL_PROCEDURE_MEM];
+};
+
+struct pipeline_peer {
+	struct bt_conn *conn;
+	enum bt_conn_le_cs_role role;
+	bool realtime;
+	cs_de_pipeline_result_cb_t result_cb;
+
+	struct procedure_slot slot[SLOT_CNT];
+	struct procedure_slot *local_slot;
+	uint8_t alloc_idx;
+	int32_t dropped_counter;
+
+	struct net_buf_simple peer_buf[PEER_BUF_CNT];
+	uint8_t peer_buf_mem[PEER_BUF_CNT][BT_RAS_PROCEDURE_MEM];
+	uint32_t peer_buf_free;
+
+	/* Buffer that receives the peer ranging data. */
+	struct net_buf_simple *rx_buf;
+	struct k_work rd_get_work;
+
+	struct cs_de_pipeline_stats stats;
+	uint64_t latency_sum_us;
+	int64_t stats_start;
+};
+
+static struct pipeline_peer peers[PEER_CNT];
+
+/* Protects the peer and slot states shared with the Bluetooth RX thread. */
+static struct k_spinlock lock;
+/* Serializes the distance estimation with removing the peers. */
+static K_MUTEX_DEFINE(process_mutex);
+static K_SEM_DEFINE(process_sem, 0, 1);
+
+static struct pipeline_peer *peer_find(struct bt_conn *conn)
+{
+	if (!conn) {
+		return NULL;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(peers); i++) {
+		if (peers[i].conn == conn) {
+			return &peers[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct net_buf_simple *peer_buf_alloc(struct pipeline_peer *peer)
+{
+	if (!peer->peer_buf_free) {
+		return NULL;
+	}
+
+	size_t idx = u32_count_trailing_zeros(peer->peer_buf_free);
+
+	WRITE_BIT(peer->peer_buf_free, idx, 0);
+	net_buf_simple_reset(&peer->peer_buf[idx]);
+
+	return &peer->peer_buf[idx];
+}
+
+static void peer_buf_free(struct pipeline_peer *peer, struct net_buf_simple *buf)
+{
+	size_t idx = buf - peer->peer_buf;
+
+	__ASSERT_NO_MSG(idx < ARRAY_SIZE(peer->peer_buf));
+	WRITE_BIT(peer->peer_buf_free, idx, 1);
+}
+
+static struct procedure_slot *slot_find(struct pipeline_peer *peer, uint16_t ranging_counter)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(peer->slot); i++) {
+		struct procedure_slot *slot = &peer->slot[i];
+
+		if (((slot->state == SLOT_STATE_LOCAL) || (slot->state == SLOT_STATE_WAIT_PEER)) &&
+		    (slot->ranging_counter == ranging_counter)) {
+			return slot;
+		}
+	}
+
+	return NULL;
+}
+
+static struct procedure_slot *slot_alloc(struct pipeline_peer *peer, uint16_t ranging_counter)
+{
+	/* Slots are used in the ring order, skipping the ones still in use. */
+	for (size_t i = 0; i < ARRAY_SIZE(peer->slot); i++) {
+		struct procedure_slot *slot = &peer->slot[peer->alloc_idx];
+
+		peer->alloc_idx = (peer->alloc_idx + 1) % ARRAY_SIZE(peer->slot);
+
+		if (slot->state == SLOT_STATE_FREE) {
+			slot->state = SLOT_STATE_LOCAL;
+			slot->ranging_counter = ranging_counter;
+			slot->rd_ready = false;
+			slot->peer_rd = NULL;
+			net_buf_simple_reset(&slot->local_steps);
+
+			return slot;
+		}
+	}
+
+	return NULL;
+}
+
+static void slot_release(struct pipeline_peer *peer, struct procedure_slot *slot)
+{
+	if (slot->peer_rd) {
+		peer_buf_free(peer, slot->peer_rd);
+		slot->peer_rd = NULL;
+	}
+
+	if (peer->local_slot == slot) {
+		peer->local_slot = NULL;
+	}
+
+	slot->state = SLOT_STATE_FREE;
+}
+
+static void slot_drop(struct pipeline_peer *peer, struct procedure_slot *slot)
+{
+	LOG_DBG("Procedure %u dropped", slot->ranging_counter);
+
+	peer->stats.dropped++;
+	slot_release(peer, slot);
+}
+
+static void slot_ready_check(struct pipeline_peer *peer, struct procedure_slot *slot)
+{
+	if ((slot->state != SLOT_STATE_WAIT_PEER) || !slot->peer_rd) {
+		return;
+	}
+
+	slot->state = SLOT_STATE_READY;
+	slot->ready_ts = k_cycle_get_32();
+	peer->stats.rx_bytes += slot->local_steps.len + slot->peer_rd->len;
+
+	k_sem_give(&process_sem);
+}
+
+static void peer_rd_attach(struct pipeline_peer *peer, struct net_buf_simple *buf,
+			   uint16_t ranging_counter, int err)
+{
+	struct procedure_slot *slot = slot_find(peer, ranging_counter);
+
+	if (err || !slot) {
+		LOG_DBG("Ranging data %u not used (err %d)", ranging_counter, err);
+		peer_buf_free(peer, buf);
+
+		if (slot) {
+			slot_drop(peer, slot);
+		}
+
+		return;
+	}
+
+	slot->peer_rd = buf;
+	slot_ready_check(peer, slot);
+}
+
+static void on_demand_rd_cb(struct bt_conn *conn, uint16_t ranging_counter, int err)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct pipeline_peer *peer = peer_find(conn);
+
+	if (peer && peer->rx_buf) {
+		struct net_buf_simple *buf = peer->rx_buf;
+
+		peer->rx_buf = NULL;
+		peer_rd_attach(peer, buf, ranging_counter, err);
+
+		/* Ranging Requestor does not accept a new request from within the callback. */
+		(void)k_work_submit(&peer->rd_get_work);
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+static void rd_get_work_handler(struct k_work *work)
+{
+	struct pipeline_peer *peer = CONTAINER_OF(work, struct pipeline_peer, rd_get_work);
+	struct procedure_slot *slot = NULL;
+	struct net_buf_simple *buf;
+	struct bt_conn *conn;
+	int err;
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (!peer->conn || peer->rx_buf) {
+		k_spin_unlock(&lock, key);
+		return;
+	}
+
+	/* Request the oldest ranging data announced by the peer. */
+	for (size_t i = 0; i < ARRAY_SIZE(peer->slot); i++) {
+		struct procedure_slot *s = &peer->slot[(peer->alloc_idx + i) % SLOT_CNT];
+
+		if (((s->state == SLOT_STATE_LOCAL) || (s->state == SLOT_STATE_WAIT_PEER)) &&
+		    s->rd_ready && !s->peer_rd) {
+			slot = s;
+			break;
+		}
+	}
+
+	buf = slot ? peer_buf_alloc(peer) : NULL;
+	if (!buf) {
+		k_spin_unlock(&lock, key);
+		return;
+	}
+
+	uint16_t ranging_counter = slot->ranging_counter;
+
+	slot->rd_ready = false;
+	peer->rx_buf = buf;
+	conn = bt_conn_ref(peer->conn);
+
+	k_spin_unlock(&lock, key);
+
+	err = bt_ras_rreq_cp_get_ranging_data(conn, buf, ranging_counter, on_demand_rd_cb);
+	bt_conn_unref(conn);
+	if (err) {
+		LOG_WRN("Get ranging data %u failed (err %d)", ranging_counter, err);
+
+		key = k_spin_lock(&lock);
+
+		if (peer->rx_buf == buf) {
+			peer->rx_buf = NULL;
+			peer_rd_attach(peer, buf, ranging_counter, err);
+		}
+
+		k_spin_unlock(&lock, key);
+	}
+}
+
+static void rd_ready_cb(struct bt_conn *conn, uint16_t ranging_counter)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct pipeline_peer *peer = peer_find(conn);
+	struct procedure_slot *slot = peer ? slot_find(peer, ranging_counter) : NULL;
+
+	if (slot) {
+		slot->rd_ready = true;
+		(void)k_work_submit(&peer->rd_get_work);
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+static void realtime_rd_cb(struct bt_conn *conn, uint16_t ranging_counter, int err)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct pipeline_peer *peer = peer_find(conn);
+
+	if (!peer || !peer->rx_buf) {
+		k_spin_unlock(&lock, key);
+		return;
+	}
+
+	struct net_buf_simple *next_buf = peer_buf_alloc(peer);
+
+	if (next_buf && bt_ras_rreq_realtime_rd_buf_set(conn, next_buf)) {
+		peer_buf_free(peer, next_buf);
+		next_buf = NULL;
+	}
+
+	if (!next_buf) {
+		/* Received buffer stays with the Ranging Requestor and is reused. */
+		struct procedure_slot *slot = slot_find(peer, ranging_counter);
+
+		if (slot) {
+			slot_drop(peer, slot);
+		}
+	} else {
+		struct net_buf_simple *buf = peer->rx_buf;
+
+		peer->rx_buf = next_buf;
+		peer_rd_attach(peer, buf, ranging_counter, err);
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+void cs_de_pipeline_subevent_result(struct bt_conn *conn,
+				    struct bt_conn_le_cs_subevent_result *result)
+{
+	uint16_t ranging_counter =
+		bt_ras_rreq_get_ranging_counter(result->header.procedure_counter);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct pipeline_peer *peer = peer_find(conn);
+	struct procedure_slot *slot;
+	uint8_t *steps_dst = NULL;
+	uint16_t len = 0;
+
+	if (!peer) {
+		goto out;
+	}
+
+	slot = peer->local_slot;
+
+	if (slot && (slot->ranging_counter != ranging_counter)) {
+		LOG_WRN("Procedure %u not completed", slot->ranging_counter);
+		slot_drop(peer, slot);
+		slot = NULL;
+	}
+
+	if (!slot) {
+		if (peer->dropped_counter == ranging_counter) {
+			goto out;
+		}
+
+		slot = slot_alloc(peer, ranging_counter);
+		if (!slot) {
+			LOG_DBG("No free slot for procedure %u", ranging_counter);
+			peer->stats.dropped++;
+			peer->dropped_counter = ranging_counter;
+			goto out;
+		}
+
+		peer->local_slot = slot;
+		peer->dropped_counter = -1;
+	}
+
+	if ((result->header.subevent_done_status != BT_CONN_LE_CS_SUBEVENT_ABORTED) &&
+	    result->step_data_buf) {
+		len = result->step_data_buf->len;
+
+		if (len > net_buf_simple_tailroom(&slot->local_steps)) {
+			LOG_WRN("Not enough memory to store step data");
+			peer->dropped_counter = ranging_counter;
+			slot_drop(peer, slot);
+			goto out;
+		}
+
+		/* Only reserve the space here, step data is copied without holding the lock. */
+		steps_dst = net_buf_simple_add(&slot->local_steps, len);
+	}
+
+	if (steps_dst) {
+		k_spin_unlock(&lock, key);
+
+		/* Slot is not completed before the copy is done, so it is not processed in the
+		 * meantime. Slot memory is statically allocated and stays valid even if the slot is
+		 * dropped in the meantime.
+		 */
+		memcpy(steps_dst, net_buf_simple_pull_mem(result->step_data_buf, len), len);
+
+		key = k_spin_lock(&lock);
+
+		/* Slot could be dropped or the peer could be removed during the copy. */
+		peer = peer_find(conn);
+		if (!peer || (peer->local_slot != slot) ||
+		    (slot->ranging_counter != ranging_counter)) {
+			goto out;
+		}
+	}
+
+	if (result->header.procedure_done_status == BT_CONN_LE_CS_PROCEDURE_COMPLETE) {
+		peer->local_slot = NULL;
+		slot->state = SLOT_STATE_WAIT_PEER;
+		slot_ready_check(peer, slot);
+	} else if (result->header.procedure_done_status == BT_CONN_LE_CS_PROCEDURE_ABORTED) {
+		LOG_DBG("Procedure %u aborted", ranging_counter);
+		slot_drop(peer, slot);
+	}
+
+out:
+	k_spin_unlock(&lock, key);
+}
+
+static struct procedure_slot *ready_slot_take(struct pipeline_peer *peer)
+{
+	struct procedure_slot *oldest = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(peer->slot); i++) {
+		struct procedure_slot *slot = &peer->slot[i];
+
+		if ((slot->state == SLOT_STATE_READY) &&
+		    (!oldest || ((int32_t)(slot->ready_ts - oldest->ready_ts) < 0))) {
+			oldest = slot;
+		}
+	}
+
+	if (oldest) {
+		oldest->state = SLOT_STATE_PROCESSING;
+	}
+
+	return oldest;
+}
+
+static void slot_process(struct pipeline_peer *peer, struct procedure_slot *slot)
+{
+	/* The report is very large, it is kept out of the thread stack. */
+	static cs_de_report_t report;
+	cs_de_quality_t quality;
+	uint32_t latency_us;
+
+	cs_de_populate_report(&slot->local_steps, slot->peer_rd, peer->role, &report);
+	quality = cs_de_calc(&report);
+
+	if (peer->result_cb) {
+		peer->result_cb(peer->conn, slot->ranging_counter, &report, quality);
+	}
+
+	latency_us = k_cyc_to_us_floor32(k_cycle_get_32() - slot->ready_ts);
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	peer->stats.procedures++;
+	peer->latency_sum_us += latency_us;
+	peer->stats.latency_max_us = MAX(peer->stats.latency_max_us, latency_us);
+	slot_release(peer, slot);
+
+	k_spin_unlock(&lock, key);
+}
+
+static void pipeline_thread_fn(void)
+{
+	while (true) {
+		bool processed;
+
+		k_sem_take(&process_sem, K_FOREVER);
+
+		/* Serve peers in turns, so that a single busy peer cannot starve the others. */
+		do {
+			processed = false;
+
+			for (size_t i = 0; i < ARRAY_SIZE(peers); i++) {
+				struct pipeline_peer *peer = &peers[i];
+				struct procedure_slot *slot;
+
+				k_mutex_lock(&process_mutex, K_FOREVER);
+
+				k_spinlock_key_t key = k_spin_lock(&lock);
+
+				slot = peer->conn ? ready_slot_take(peer) : NULL;
+
+				k_spin_unlock(&lock, key);
+
+				if (slot) {
+					slot_process(peer, slot);
+					processed = true;
+				}
+
+				k_mutex_unlock(&process_mutex);
+			}
+		} while (processed);
+	}
+}
+
+K_THREAD_DEFINE(cs_de_pipeline_thread, CONFIG_BT_CS_DE_PIPELINE_STACK_SIZE,
+		pipeline_thread_fn, NULL, NULL, NULL,
+		CONFIG_BT_CS_DE_PIPELINE_THREAD_PRIO, 0, 0);
+
+static void peer_reset(struct pipeline_peer *peer)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(peer->slot); i++) {
+		peer->slot[i].state = SLOT_STATE_FREE;
+		peer->slot[i].peer_rd = NULL;
+		net_buf_simple_init_with_data(&peer->slot[i].local_steps,
+					      peer->slot[i].local_steps_mem,
+					      sizeof(peer->slot[i].local_steps_mem));
+		net_buf_simple_reset(&peer->slot[i].local_steps);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(peer->peer_buf); i++) {
+		net_buf_simple_init_with_data(&peer->peer_buf[i], peer->peer_buf_mem[i],
+					      sizeof(peer->peer_buf_mem[i]));
+		net_buf_simple_reset(&peer->peer_buf[i]);
+	}
+
+	peer->peer_buf_free = BIT_MASK(PEER_BUF_CNT);
+	peer->local_slot = NULL;
+	peer->alloc_idx = 0;
+	peer->dropped_counter = -1;
+	peer->rx_buf = NULL;
+
+	memset(&peer->stats, 0, sizeof(peer->stats));
+	peer->latency_sum_us = 0;
+	peer->stats_start = k_uptime_get();
+}
+
+int cs_de_pipeline_peer_add(struct bt_conn *conn, enum bt_conn_le_cs_role role, bool realtime,
+			    cs_de_pipeline_result_cb_t result_cb)
+{
+	struct pipeline_peer *peer = NULL;
+	k_spinlock_key_t key;
+	int err;
+
+	if (!conn || !result_cb) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (peer_find(conn)) {
+		k_spin_unlock(&lock, key);
+		return -EALREADY;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(peers); i++) {
+		if (!peers[i].conn) {
+			peer = &peers[i];
+			break;
+		}
+	}
+
+	if (!peer) {
+		k_spin_unlock(&lock, key);
+		return -ENOMEM;
+	}
+
+	peer_reset(peer);
+	peer->role = role;
+	peer->realtime = realtime;
+	peer->result_cb = result_cb;
+	k_work_init(&peer->rd_get_work, rd_get_work_handler);
+	peer->conn = bt_conn_ref(conn);
+
+	if (realtime) {
+		peer->rx_buf = peer_buf_alloc(peer);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (realtime) {
+		err = bt_ras_rreq_realtime_rd_subscribe(conn, peer->rx_buf, realtime_rd_cb);
+	} else {
+		err = bt_ras_rreq_rd_ready_subscribe(conn, rd_ready_cb);
+		if (!err) {
+			err = bt_ras_rreq_on_demand_rd_subscribe(conn);
+		}
+	}
+
+	if (err) {
+		LOG_ERR("Ranging data subscribe failed (err %d)", err);
+		(void)cs_de_pipeline_peer_remove(conn);
+		return err;
+	}
+
+	LOG_DBG("Peer %p added", (void *)conn);
+
+	return 0;
+}
+
+static int peer_remove(struct bt_conn *conn, bool unsubscribe)
+{
+	struct pipeline_peer *peer;
+	struct bt_conn *peer_conn;
+	k_spinlock_key_t key;
+
+	k_mutex_lock(&process_mutex, K_FOREVER);
+	key = k_spin_lock(&lock);
+
+	peer = peer_find(conn);
+	if (!peer) {
+		k_spin_unlock(&lock, key);
+		k_mutex_unlock(&process_mutex);
+		return -ENOENT;
+	}
+
+	peer_conn = peer->conn;
+	peer->conn = NULL;
+
+	k_spin_unlock(&lock, key);
+	k_mutex_unlock(&process_mutex);
+
+	(void)k_work_cancel(&peer->rd_get_work);
+
+	if (unsubscribe) {
+		if (peer->realtime) {
+			(void)bt_ras_rreq_realtime_rd_unsubscribe(peer_conn);
+		} else {
+			(void)bt_ras_rreq_rd_ready_unsubscribe(peer_conn);
+			(void)bt_ras_rreq_on_demand_rd_unsubscribe(peer_conn);
+		}
+	}
+
+	bt_conn_unref(peer_conn);
+
+	LOG_DBG("Peer %p removed", (void *)conn);
+
+	return 0;
+}
+
+int cs_de_pipeline_peer_remove(struct bt_conn *conn)
+{
+	return peer_remove(conn, true);
+}
+
+int cs_de_pipeline_stats_get(struct bt_conn *conn, struct cs_de_pipeline_stats *stats,
+			     bool reset)
+{
+	struct pipeline_peer *peer;
+	k_spinlock_key_t key;
+	int64_t elapsed_ms;
+
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	peer = peer_find(conn);
+	if (!peer) {
+		k_spin_unlock(&lock, key);
+		return -ENOENT;
+	}
+
+	*stats = peer->stats;
+	elapsed_ms = k_uptime_get() - peer->stats_start;
+
+	if (stats->procedures > 0) {
+		stats->latency_avg_us = peer->latency_sum_us / stats->procedures;
+	}
+
+	if (elapsed_ms > 0) {
+		stats->rx_rate = ((uint64_t)stats->rx_bytes * MSEC_PER_SEC) / elapsed_ms;
+	}
+
+	if (reset) {
+		memset(&peer->stats, 0, sizeof(peer->stats));
+		peer->latency_sum_us = 0;
+		peer->stats_start = k_uptime_get();
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	ARG_UNUSED(reason);
+
+	(void)peer_remove(conn, false);
+}
+
+BT_CONN_CB_DEFINE(cs_de_pipeline_conn_callbacks) = {
+	.disconnected = disconnected,
+};
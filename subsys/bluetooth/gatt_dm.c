@@ -5,8 +5,12 @@
  */
 
 #include <inttypes.h>
+#include <stdlib.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/settings/settings.h>
 
 #include <bluetooth/gatt_dm.h>
 
@@ -44,9 +48,32 @@ SYS_INIT(gatt_dm_wq_init, POST_KERNEL, CONFIG_BT_GATT_DM_WORKQ_INIT_PRIO);
 enum {
 	STATE_ATTRS_LOCKED,
 	STATE_ATTRS_RELEASE_PENDING,
+	STATE_TIME_MEASURED,
 	STATE_NUM
 };
 
+/* State of the discovery cache for the ongoing discovery */
+enum cache_state {
+	/* The peer Database Hash is unknown, the cache is not used */
+	CACHE_DISABLED,
+	/* The peer Database Hash is known, no discovery is ongoing */
+	CACHE_IDLE,
+	/* The discovery result is not cached and is stored when completed */
+	CACHE_MISS,
+	/* The discovery result was loaded from the cache */
+	CACHE_HIT,
+};
+
+#define DB_HASH_LEN 16
+
+/* Any of the UUID types */
+union uuid_any {
+	struct bt_uuid uuid;
+	struct bt_uuid_16 u16;
+	struct bt_uuid_32 u32;
+	struct bt_uuid_128 u128;
+};
+
 /* One item in linked list containing dynamically allocated user data chunks */
 struct data_chunk_item {
 	/* Required by the sys_slist */
@@ -68,16 +95,17 @@ struct bt_gatt_dm {
 	struct bt_gatt_dm_attr attrs[CONFIG_BT_GATT_DM_MAX_ATTRS];
 	/* Currently accessed attribute */
 	size_t cur_attr_id;
+	/* Number of characteristic declarations, stored right after the service */
+	size_t chrc_cnt;
+	/* Index of the next handle gap to check for descriptors */
+	size_t gap_id;
+	/* End handle of the last found service */
+	uint16_t svc_end_handle;
 	/* Flags with the status of the attributes */
 	ATOMIC_DEFINE(state_flags, STATE_NUM);
 
 	/* The UUID of the service to discover. */
-	union {
-		struct bt_uuid uuid;
-		struct bt_uuid_16 u16;
-		struct bt_uuid_32 u32;
-		struct bt_uuid_128 u128;
-	} svc_uuid;
+	union uuid_any svc_uuid;
 
 	/* Single-linked list of allocated chunks for user data */
 	sys_slist_t chunk_list;
@@ -92,11 +120,108 @@ struct bt_gatt_dm {
 
 	/* Work item used for discovery callbacks. */
 	struct k_work discover_work;
+
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	/* Parameters used to read the peer Database Hash */
+	struct bt_gatt_read_params read_params;
+	/* The peer Database Hash */
+	uint8_t db_hash[DB_HASH_LEN];
+	/* Start handle of the service search */
+	uint16_t search_start_handle;
+	/* Cache state of the ongoing discovery */
+	enum cache_state cache_state;
+	/* Work item used for the cache lookup */
+	struct k_work cache_work;
+#endif
+
+#if defined(CONFIG_BT_GATT_DM_STATS)
+	/* Uptime in ticks when the discovery was started */
+	int64_t start_time;
+#endif
 };
 
 /* Currently only one instance is supported */
 static struct bt_gatt_dm bt_gatt_dm_inst;
 
+#if defined(CONFIG_BT_GATT_DM_STATS)
+static struct {
+	uint32_t discovery_cnt;
+	uint32_t cache_hit_cnt;
+	uint32_t procedure_cnt;
+	uint64_t discovery_time_us;
+	uint32_t discovery_time_max_us;
+	uint64_t cache_time_us;
+} dm_stats;
+
+static struct k_spinlock dm_stats_lock;
+
+static void stats_procedure_add(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&dm_stats_lock);
+
+	dm_stats.procedure_cnt++;
+	k_spin_unlock(&dm_stats_lock, key);
+}
+
+static void stats_time_start(struct bt_gatt_dm *dm)
+{
+	dm->start_time = k_uptime_ticks();
+	atomic_set_bit(dm->state_flags, STATE_TIME_MEASURED);
+}
+
+static void stats_time_stop(struct bt_gatt_dm *dm, bool cached)
+{
+	if (!atomic_test_and_clear_bit(dm->state_flags, STATE_TIME_MEASURED)) {
+		return;
+	}
+
+	uint32_t time_us = k_ticks_to_us_floor32(k_uptime_ticks() - dm->start_time);
+	k_spinlock_key_t key = k_spin_lock(&dm_stats_lock);
+
+	if (cached) {
+		dm_stats.cache_hit_cnt++;
+		dm_stats.cache_time_us += time_us;
+	} else {
+		dm_stats.discovery_cnt++;
+		dm_stats.discovery_time_us += time_us;
+		dm_stats.discovery_time_max_us = MAX(dm_stats.discovery_time_max_us, time_us);
+	}
+
+	k_spin_unlock(&dm_stats_lock, key);
+}
+#else
+static void stats_procedure_add(void)
+{
+}
+
+static void stats_time_start(struct bt_gatt_dm *dm)
+{
+	ARG_UNUSED(dm);
+}
+
+static void stats_time_stop(struct bt_gatt_dm *dm, bool cached)
+{
+	ARG_UNUSED(dm);
+	ARG_UNUSED(cached);
+}
+#endif /* CONFIG_BT_GATT_DM_STATS */
+
+static void dm_work_submit(struct k_work *work)
+{
+#if defined(CONFIG_BT_GATT_DM_WORKQ_OWN)
+	k_work_submit_to_queue(&bt_gatt_dm_wq, work);
+#else
+	k_work_submit(work);
+#endif
+}
+
+static int discover(struct bt_gatt_dm *dm)
+{
+	stats_procedure_add();
+
+	return bt_gatt_discover(dm->conn, &dm->discover_params);
+}
+
 /* Returns pointer to newly allocated space in a dm->data_chunk */
 static void *user_data_alloc(struct bt_gatt_dm *dm,
 			     size_t len)
@@ -268,9 +393,463 @@ static struct bt_gatt_dm_attr *attr_find_by_handle(
 	return NULL;
 }
 
+/* Descriptors are discovered after the characteristic declarations, so the
+ * attributes must be put in the handle order before they are reported.
+ */
+static void attrs_sort(struct bt_gatt_dm *dm)
+{
+	for (size_t i = 1; i < dm->cur_attr_id; i++) {
+		struct bt_gatt_dm_attr attr = dm->attrs[i];
+		size_t j = i;
+
+		while ((j > 0) && (dm->attrs[j - 1].handle > attr.handle)) {
+			dm->attrs[j] = dm->attrs[j - 1];
+			j--;
+		}
+
+		dm->attrs[j] = attr;
+	}
+}
+
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+/* The longest attribute record: a characteristic declaration with
+ * two 128-bit UUIDs.
+ */
+#define CACHE_ATTR_MAX_LEN (2 * (sizeof(uint16_t) + 2 * sizeof(uint8_t) + BT_UUID_SIZE_128))
+
+#define CACHE_SETTINGS_KEY "bt/dm"
+
+/* Discovery result of one service search */
+struct cache_entry {
+	/* Peer identity address */
+	bt_addr_le_t addr;
+	/* Peer Database Hash */
+	uint8_t db_hash[DB_HASH_LEN];
+	/* The UUID of the searched service, if searched by UUID */
+	union uuid_any svc_uuid;
+	/* Indicates that the service was searched by the UUID */
+	bool by_uuid;
+	/* Indicates that the entry is in use */
+	bool valid;
+	/* Start handle of the service search */
+	uint16_t start_handle;
+	/* End handle of the found service */
+	uint16_t end_handle;
+	/* Number of attributes of the found service, 0 if not found */
+	uint16_t attr_cnt;
+	/* Length of the encoded attributes */
+	uint16_t data_len;
+	/* Last use of the entry, for the replacement policy */
+	uint32_t last_used;
+	/* Encoded attributes */
+	uint8_t data[CONFIG_BT_GATT_DM_CACHE_ENTRY_SIZE];
+};
+
+static struct cache_entry cache[CONFIG_BT_GATT_DM_CACHE_ENTRIES];
+static uint32_t cache_use_cnt;
+static K_MUTEX_DEFINE(cache_mutex);
+
+#if defined(CONFIG_BT_GATT_DM_CACHE_STORE)
+static ATOMIC_DEFINE(cache_dirty, CONFIG_BT_GATT_DM_CACHE_ENTRIES);
+
+static void cache_store_work_handler(struct k_work *work)
+{
+	static struct cache_entry entry;
+	char key[sizeof(CACHE_SETTINGS_KEY "/") + 3];
+	size_t len;
+	int err;
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (!atomic_test_and_clear_bit(cache_dirty, i)) {
+			continue;
+		}
+
+		k_mutex_lock(&cache_mutex, K_FOREVER);
+		memcpy(&entry, &cache[i], sizeof(entry));
+		k_mutex_unlock(&cache_mutex);
+
+		snprintk(key, sizeof(key), CACHE_SETTINGS_KEY "/%zu", i);
+
+		if (entry.valid) {
+			len = offsetof(struct cache_entry, data) + entry.data_len;
+			err = settings_save_one(key, &entry, len);
+		} else {
+			err = settings_delete(key);
+		}
+
+		if (err) {
+			LOG_WRN("Failed to store cache entry %zu, error: %d.", i, err);
+		}
+	}
+}
+
+static K_WORK_DEFINE(cache_store_work, cache_store_work_handler);
+
+static int cache_settings_set(const char *key, size_t len, settings_read_cb read_cb,
+			      void *cb_arg)
+{
+	struct cache_entry *entry;
+	unsigned long index = strtoul(key, NULL, 10);
+	ssize_t size;
+
+	if (index >= ARRAY_SIZE(cache)) {
+		return -ENOMEM;
+	}
+
+	if ((len < offsetof(struct cache_entry, data)) || (len > sizeof(*entry))) {
+		return -EINVAL;
+	}
+
+	entry = &cache[index];
+
+	size = read_cb(cb_arg, entry, len);
+	if ((size != (ssize_t)len) ||
+	    (entry->data_len != len - offsetof(struct cache_entry, data))) {
+		entry->valid = false;
+		return -EINVAL;
+	}
+
+	entry->last_used = 0;
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bt_gatt_dm, CACHE_SETTINGS_KEY, NULL, cache_settings_set,
+			       NULL, NULL);
+
+static void cache_entry_changed(const struct cache_entry *entry)
+{
+	atomic_set_bit(cache_dirty, entry - cache);
+	k_work_submit(&cache_store_work);
+}
+#else
+static void cache_entry_changed(const struct cache_entry *entry)
+{
+	ARG_UNUSED(entry);
+}
+#endif /* CONFIG_BT_GATT_DM_CACHE_STORE */
+
+static void cache_uuid_put(struct net_buf_simple *buf, const struct bt_uuid *uuid)
+{
+	net_buf_simple_add_u8(buf, uuid->type);
+
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		net_buf_simple_add_le16(buf, BT_UUID_16(uuid)->val);
+		break;
+	case BT_UUID_TYPE_32:
+		net_buf_simple_add_le32(buf, BT_UUID_32(uuid)->val);
+		break;
+	default:
+		net_buf_simple_add_mem(buf, BT_UUID_128(uuid)->val, BT_UUID_SIZE_128);
+		break;
+	}
+}
+
+static int cache_uuid_pull(struct net_buf_simple *buf, union uuid_any *uuid)
+{
+	if (buf->len < sizeof(uint8_t)) {
+		return -EINVAL;
+	}
+
+	uuid->uuid.type = net_buf_simple_pull_u8(buf);
+
+	switch (uuid->uuid.type) {
+	case BT_UUID_TYPE_16:
+		if (buf->len < sizeof(uint16_t)) {
+			return -EINVAL;
+		}
+		uuid->u16.val = net_buf_simple_pull_le16(buf);
+		break;
+	case BT_UUID_TYPE_32:
+		if (buf->len < sizeof(uint32_t)) {
+			return -EINVAL;
+		}
+		uuid->u32.val = net_buf_simple_pull_le32(buf);
+		break;
+	case BT_UUID_TYPE_128:
+		if (buf->len < BT_UUID_SIZE_128) {
+			return -EINVAL;
+		}
+		memcpy(uuid->u128.val, net_buf_simple_pull_mem(buf, BT_UUID_SIZE_128),
+		       BT_UUID_SIZE_128);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static bool cache_attr_put(struct net_buf_simple *buf, const struct bt_gatt_dm_attr *attr)
+{
+	const struct bt_gatt_service_val *service_val = bt_gatt_dm_attr_service_val(attr);
+	const struct bt_gatt_chrc *chrc = bt_gatt_dm_attr_chrc_val(attr);
+
+	if (net_buf_simple_tailroom(buf) < CACHE_ATTR_MAX_LEN) {
+		return false;
+	}
+
+	net_buf_simple_add_le16(buf, attr->handle);
+	net_buf_simple_add_u8(buf, attr->perm);
+	cache_uuid_put(buf, attr->uuid);
+
+	if (service_val) {
+		net_buf_simple_add_le16(buf, service_val->end_handle);
+		cache_uuid_put(buf, service_val->uuid);
+	} else if (chrc) {
+		net_buf_simple_add_le16(buf, chrc->value_handle);
+		net_buf_simple_add_u8(buf, chrc->properties);
+		cache_uuid_put(buf, chrc->uuid);
+	}
+
+	return true;
+}
+
+static int cache_attr_pull(struct bt_gatt_dm *dm, struct net_buf_simple *buf)
+{
+	union uuid_any uuid;
+	struct bt_gatt_attr attr = {
+		.uuid = &uuid.uuid,
+	};
+	struct bt_gatt_dm_attr *cur_attr;
+	int err;
+
+	if (buf->len < sizeof(uint16_t) + sizeof(uint8_t)) {
+		return -EINVAL;
+	}
+
+	attr.handle = net_buf_simple_pull_le16(buf);
+	attr.perm = net_buf_simple_pull_u8(buf);
+
+	err = cache_uuid_pull(buf, &uuid);
+	if (err) {
+		return err;
+	}
+
+	if (!bt_uuid_cmp(attr.uuid, BT_UUID_GATT_PRIMARY) ||
+	    !bt_uuid_cmp(attr.uuid, BT_UUID_GATT_SECONDARY)) {
+		struct bt_gatt_service_val *service_val;
+
+		cur_attr = attr_store(dm, &attr, sizeof(*service_val));
+		if (!cur_attr) {
+			return -ENOMEM;
+		}
+
+		if (buf->len < sizeof(uint16_t)) {
+			return -EINVAL;
+		}
+
+		service_val = bt_gatt_dm_attr_service_val(cur_attr);
+		service_val->end_handle = net_buf_simple_pull_le16(buf);
+
+		err = cache_uuid_pull(buf, &uuid);
+		if (err) {
+			return err;
+		}
+
+		service_val->uuid = uuid_store(dm, &uuid.uuid);
+		if (!service_val->uuid) {
+			return -ENOMEM;
+		}
+	} else if (!bt_uuid_cmp(attr.uuid, BT_UUID_GATT_CHRC)) {
+		struct bt_gatt_chrc *chrc;
+
+		cur_attr = attr_store(dm, &attr, sizeof(*chrc));
+		if (!cur_attr) {
+			return -ENOMEM;
+		}
+
+		if (buf->len < sizeof(uint16_t) + sizeof(uint8_t)) {
+			return -EINVAL;
+		}
+
+		chrc = bt_gatt_dm_attr_chrc_val(cur_attr);
+		chrc->value_handle = net_buf_simple_pull_le16(buf);
+		chrc->properties = net_buf_simple_pull_u8(buf);
+
+		err = cache_uuid_pull(buf, &uuid);
+		if (err) {
+			return err;
+		}
+
+		chrc->uuid = uuid_store(dm, &uuid.uuid);
+		if (!chrc->uuid) {
+			return -ENOMEM;
+		}
+	} else {
+		cur_attr = attr_store(dm, &attr, 0);
+		if (!cur_attr) {
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+}
+
+static bool cache_entry_match(const struct cache_entry *entry, const struct bt_gatt_dm *dm,
+			      const bt_addr_le_t *addr)
+{
+	if (!entry->valid || bt_addr_le_cmp(&entry->addr, addr) ||
+	    memcmp(entry->db_hash, dm->db_hash, sizeof(entry->db_hash))) {
+		return false;
+	}
+
+	if ((entry->start_handle != dm->search_start_handle) ||
+	    (entry->by_uuid != dm->search_svc_by_uuid)) {
+		return false;
+	}
+
+	return !entry->by_uuid || !bt_uuid_cmp(&entry->svc_uuid.uuid, &dm->svc_uuid.uuid);
+}
+
+/* Loads the result of the ongoing service search from the cache.
+ * Entries of the peer with a different Database Hash are dropped on the way.
+ */
+static int cache_load(struct bt_gatt_dm *dm)
+{
+	const bt_addr_le_t *addr = bt_conn_get_dst(dm->conn);
+	struct cache_entry *found = NULL;
+	struct net_buf_simple buf;
+	int err = 0;
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache); i++) {
+		struct cache_entry *entry = &cache[i];
+
+		if (!entry->valid || bt_addr_le_cmp(&entry->addr, addr)) {
+			continue;
+		}
+
+		if (memcmp(entry->db_hash, dm->db_hash, sizeof(entry->db_hash))) {
+			LOG_DBG("Database Hash changed, dropping cache entry %zu", i);
+			entry->valid = false;
+			cache_entry_changed(entry);
+			continue;
+		}
+
+		if (!found && cache_entry_match(entry, dm, addr)) {
+			found = entry;
+		}
+	}
+
+	if (!found) {
+		k_mutex_unlock(&cache_mutex);
+		return -ENOENT;
+	}
+
+	found->last_used = ++cache_use_cnt;
+	net_buf_simple_init_with_data(&buf, found->data, found->data_len);
+
+	for (size_t i = 0; (i < found->attr_cnt) && !err; i++) {
+		err = cache_attr_pull(dm, &buf);
+	}
+
+	if (err) {
+		LOG_WRN("Invalid cache entry, error: %d.", err);
+		found->valid = false;
+		cache_entry_changed(found);
+		svc_attr_memory_release(dm);
+	} else {
+		dm->svc_end_handle = found->end_handle;
+	}
+
+	k_mutex_unlock(&cache_mutex);
+
+	return err;
+}
+
+static struct cache_entry *cache_entry_alloc(void)
+{
+	struct cache_entry *oldest = &cache[0];
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (!cache[i].valid) {
+			return &cache[i];
+		}
+
+		if (cache[i].last_used < oldest->last_used) {
+			oldest = &cache[i];
+		}
+	}
+
+	return oldest;
+}
+
+static void cache_store(struct bt_gatt_dm *dm, bool found)
+{
+	struct cache_entry *entry;
+	struct net_buf_simple buf;
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	entry = cache_entry_alloc();
+	net_buf_simple_init_with_data(&buf, entry->data, sizeof(entry->data));
+	net_buf_simple_reset(&buf);
+
+	entry->valid = true;
+	entry->attr_cnt = found ? dm->cur_attr_id : 0;
+
+	for (size_t i = 0; i < entry->attr_cnt; i++) {
+		if (!cache_attr_put(&buf, &dm->attrs[i])) {
+			LOG_DBG("Service does not fit in the cache entry");
+			entry->valid = false;
+			break;
+		}
+	}
+
+	if (entry->valid) {
+		bt_addr_le_copy(&entry->addr, bt_conn_get_dst(dm->conn));
+		memcpy(entry->db_hash, dm->db_hash, sizeof(entry->db_hash));
+		memcpy(&entry->svc_uuid, &dm->svc_uuid, sizeof(entry->svc_uuid));
+		entry->by_uuid = dm->search_svc_by_uuid;
+		entry->start_handle = dm->search_start_handle;
+		entry->end_handle = found ? dm->svc_end_handle : 0;
+		entry->data_len = buf.len;
+		entry->last_used = ++cache_use_cnt;
+	}
+
+	cache_entry_changed(entry);
+
+	k_mutex_unlock(&cache_mutex);
+}
+
+static void cache_complete(struct bt_gatt_dm *dm, bool found)
+{
+	if (dm->cache_state == CACHE_MISS) {
+		cache_store(dm, found);
+	}
+
+	if (dm->cache_state != CACHE_DISABLED) {
+		dm->cache_state = CACHE_IDLE;
+	}
+}
+
+static bool cache_hit(const struct bt_gatt_dm *dm)
+{
+	return dm->cache_state == CACHE_HIT;
+}
+#else
+static void cache_complete(struct bt_gatt_dm *dm, bool found)
+{
+	ARG_UNUSED(dm);
+	ARG_UNUSED(found);
+}
+
+static bool cache_hit(const struct bt_gatt_dm *dm)
+{
+	ARG_UNUSED(dm);
+
+	return false;
+}
+#endif /* CONFIG_BT_GATT_DM_CACHE */
+
 static void discovery_complete(struct bt_gatt_dm *dm)
 {
 	LOG_DBG("Discovery complete.");
+	stats_time_stop(dm, cache_hit(dm));
+	cache_complete(dm, true);
 	atomic_set_bit(dm->state_flags, STATE_ATTRS_RELEASE_PENDING);
 	if (dm->callback->completed) {
 		dm->callback->completed(dm, dm->context);
@@ -281,6 +860,9 @@ static void discovery_complete_not_found(struct bt_gatt_dm *dm)
 {
 	LOG_DBG("Discover complete. No service found.");
 
+	stats_time_stop(dm, cache_hit(dm));
+	cache_complete(dm, false);
+	dm->svc_end_handle = 0xffff;
 	svc_attr_memory_release(dm);
 	atomic_clear_bit(dm->state_flags, STATE_ATTRS_LOCKED);
 
@@ -291,6 +873,12 @@ static void discovery_complete_not_found(struct bt_gatt_dm *dm)
 
 static void discovery_complete_error(struct bt_gatt_dm *dm, int err)
 {
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	if (dm->cache_state != CACHE_DISABLED) {
+		dm->cache_state = CACHE_IDLE;
+	}
+#endif
+	atomic_clear_bit(dm->state_flags, STATE_TIME_MEASURED);
 	svc_attr_memory_release(dm);
 	atomic_clear_bit(dm->state_flags, STATE_ATTRS_LOCKED);
 	if (dm->callback->error_found) {
@@ -307,7 +895,7 @@ static void gatt_discover_work(struct k_work *work)
 		return;
 	}
 
-	int err = bt_gatt_discover(dm->conn, &(dm->discover_params));
+	int err = discover(dm);
 
 	if (err) {
 		LOG_ERR("GATT discover failed, error: %d.", err);
@@ -315,6 +903,174 @@ static void gatt_discover_work(struct k_work *work)
 	}
 }
 
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+static void cache_lookup_work(struct k_work *work)
+{
+	struct bt_gatt_dm *dm = CONTAINER_OF(work, struct bt_gatt_dm, cache_work);
+	int err;
+
+	if (!atomic_test_bit(dm->state_flags, STATE_ATTRS_LOCKED)) {
+		LOG_WRN("Attributes not locked");
+		return;
+	}
+
+	if ((dm->cache_state == CACHE_MISS) && !cache_load(dm)) {
+		LOG_DBG("Discovery result loaded from the cache");
+		dm->cache_state = CACHE_HIT;
+		dm->discover_params.uuid = NULL;
+
+		if (dm->cur_attr_id) {
+			discovery_complete(dm);
+		} else {
+			discovery_complete_not_found(dm);
+		}
+
+		return;
+	}
+
+	err = discover(dm);
+	if (err) {
+		LOG_ERR("GATT discover failed, error: %d.", err);
+		discovery_complete_error(dm, err);
+	}
+}
+
+static uint8_t db_hash_read_cb(struct bt_conn *conn, uint8_t err,
+			       struct bt_gatt_read_params *params,
+			       const void *data, uint16_t length)
+{
+	struct bt_gatt_dm *dm = CONTAINER_OF(params, struct bt_gatt_dm, read_params);
+
+	if (!err && data && (length == sizeof(dm->db_hash))) {
+		memcpy(dm->db_hash, data, sizeof(dm->db_hash));
+		dm->cache_state = CACHE_MISS;
+	} else {
+		LOG_DBG("Database Hash not available, error: %u.", err);
+		dm->cache_state = CACHE_DISABLED;
+	}
+
+	dm_work_submit(&dm->cache_work);
+
+	return BT_GATT_ITER_STOP;
+}
+
+static int db_hash_read(struct bt_gatt_dm *dm)
+{
+	dm->read_params.func = db_hash_read_cb;
+	dm->read_params.handle_count = 0;
+	dm->read_params.by_uuid.uuid = BT_UUID_GATT_DB_HASH;
+	dm->read_params.by_uuid.start_handle = 0x0001;
+	dm->read_params.by_uuid.end_handle = 0xffff;
+
+	stats_procedure_add();
+
+	return bt_gatt_read(dm->conn, &dm->read_params);
+}
+#endif /* CONFIG_BT_GATT_DM_CACHE */
+
+/* Handle gap with the given index lies between the declaration stored at the
+ * same index in dm->attrs and the next characteristic declaration or the end
+ * of the service.
+ */
+static void gap_range_get(const struct bt_gatt_dm *dm, size_t gap_id,
+			  uint32_t *start, uint32_t *end)
+{
+	*start = (uint32_t)dm->attrs[gap_id].handle + 1;
+	*end = (gap_id < dm->chrc_cnt) ?
+	       ((uint32_t)dm->attrs[gap_id + 1].handle - 1) : dm->svc_end_handle;
+}
+
+/* The gap that holds only the characteristic value is fully described by
+ * the characteristic declaration.
+ */
+static bool gap_is_value_only(const struct bt_gatt_dm *dm, size_t gap_id,
+			      uint32_t start, uint32_t end)
+{
+	const struct bt_gatt_chrc *chrc;
+
+	if ((gap_id == 0) || (start != end)) {
+		return false;
+	}
+
+	chrc = bt_gatt_dm_attr_chrc_val(&dm->attrs[gap_id]);
+
+	return chrc->value_handle == start;
+}
+
+static bool gap_needs_discovery(const struct bt_gatt_dm *dm, size_t gap_id)
+{
+	uint32_t start;
+	uint32_t end;
+
+	gap_range_get(dm, gap_id, &start, &end);
+
+	return (start <= end) && !gap_is_value_only(dm, gap_id, start, end);
+}
+
+static struct bt_gatt_dm_attr *value_attr_store(struct bt_gatt_dm *dm,
+						const struct bt_gatt_dm_attr *chrc_attr)
+{
+	const struct bt_gatt_chrc *chrc = bt_gatt_dm_attr_chrc_val(chrc_attr);
+	const struct bt_gatt_attr attr = {
+		.uuid = chrc->uuid,
+		.handle = chrc->value_handle,
+	};
+
+	return attr_store(dm, &attr, 0);
+}
+
+/* Finds the remaining attributes of the service. The characteristic values
+ * are taken from the declarations, and descriptors are discovered only in
+ * the gaps that contain more than the value. Adjacent gaps are covered by
+ * a single procedure.
+ */
+static void descriptor_discovery_next(struct bt_gatt_dm *dm)
+{
+	uint32_t start;
+	uint32_t end;
+
+	for (; dm->gap_id <= dm->chrc_cnt; dm->gap_id++) {
+		gap_range_get(dm, dm->gap_id, &start, &end);
+
+		if (start > end) {
+			continue;
+		}
+
+		if (!gap_is_value_only(dm, dm->gap_id, start, end)) {
+			/* The range starts at the characteristic declaration,
+			 * which is skipped when processed.
+			 */
+			dm->discover_params.start_handle =
+				(dm->gap_id == 0) ? start : dm->attrs[dm->gap_id].handle;
+
+			while ((dm->gap_id < dm->chrc_cnt) &&
+			       gap_needs_discovery(dm, dm->gap_id + 1)) {
+				dm->gap_id++;
+			}
+
+			gap_range_get(dm, dm->gap_id, &start, &end);
+			dm->gap_id++;
+
+			dm->discover_params.end_handle = end;
+			dm->discover_params.type = BT_GATT_DISCOVER_ATTRIBUTE;
+			LOG_DBG("Starting descriptors discovery, handles range: <%u, %u>",
+				dm->discover_params.start_handle, end);
+
+			dm_work_submit(&dm->discover_work);
+			return;
+		}
+
+		if (!value_attr_store(dm, &dm->attrs[dm->gap_id])) {
+			LOG_ERR("Not enough memory for characteristic value attribute.");
+			discovery_complete_error(dm, -ENOMEM);
+			return;
+		}
+	}
+
+	attrs_sort(dm);
+	discovery_complete(dm);
+}
+
 static uint8_t discovery_process_service(struct bt_gatt_dm *dm,
 				      const struct bt_gatt_attr *attr,
 				      struct bt_gatt_discover_params *params)
@@ -360,6 +1116,7 @@ static uint8_t discovery_process_service(struct bt_gatt_dm *dm,
 		return BT_GATT_ITER_STOP;
 	}
 
+	dm->svc_end_handle = cur_service_val->end_handle;
 	dm->discover_params.end_handle = cur_service_val->end_handle;
 
 	if (cur_attr->handle == cur_service_val->end_handle) {
@@ -368,16 +1125,16 @@ static uint8_t discovery_process_service(struct bt_gatt_dm *dm,
 		return BT_GATT_ITER_STOP;
 	}
 
+	/* Characteristic declarations are read in batches with the
+	 * Read By Type procedure, so they are discovered first.
+	 */
+	dm->chrc_cnt = 0;
 	dm->discover_params.uuid         = NULL;
-	dm->discover_params.type         = BT_GATT_DISCOVER_ATTRIBUTE;
+	dm->discover_params.type         = BT_GATT_DISCOVER_CHARACTERISTIC;
 	dm->discover_params.start_handle = cur_attr->handle + 1;
-	LOG_DBG("Starting descriptors discovery");
+	LOG_DBG("Starting characteristic discovery");
 
-#if defined(CONFIG_BT_GATT_DM_WORKQ_OWN)
-	k_work_submit_to_queue(&bt_gatt_dm_wq, &dm->discover_work);
-#else
-	k_work_submit(&dm->discover_work);
-#endif
+	dm_work_submit(&dm->discover_work);
 
 	return BT_GATT_ITER_STOP;
 }
@@ -389,33 +1146,16 @@ static uint8_t discovery_process_attribute(struct bt_gatt_dm *dm,
 	struct bt_gatt_dm_attr *cur_attr;
 
 	if (!attr) {
-		if (dm->cur_attr_id > 1) {
-			LOG_DBG("Starting characteristic discovery");
-			dm->discover_params.start_handle =
-				dm->attrs[0].handle + 1;
-			dm->discover_params.type =
-				BT_GATT_DISCOVER_CHARACTERISTIC;
-
-#if defined(CONFIG_BT_GATT_DM_WORKQ_OWN)
-			k_work_submit_to_queue(&bt_gatt_dm_wq, &dm->discover_work);
-#else
-			k_work_submit(&dm->discover_work);
-#endif
-		} else {
-			discovery_complete(dm);
-		}
+		descriptor_discovery_next(dm);
 		return BT_GATT_ITER_STOP;
 	}
 
 	if (bt_uuid_cmp(attr->uuid, BT_UUID_GATT_CHRC) == 0) {
-		cur_attr = attr_store(dm, attr, sizeof(struct bt_gatt_chrc));
-		struct bt_gatt_chrc *cur_gatt_chrc = bt_gatt_dm_attr_chrc_val(cur_attr);
-
-		cur_gatt_chrc->uuid = cur_attr->uuid;
-	} else {
-		cur_attr = attr_store(dm, attr, 0);
+		/* Already stored by the characteristic discovery. */
+		return BT_GATT_ITER_CONTINUE;
 	}
 
+	cur_attr = attr_store(dm, attr, 0);
 	if (!cur_attr) {
 		LOG_ERR("Not enough memory for next attribute descriptor"
 			" at handle %u.",
@@ -437,20 +1177,22 @@ static uint8_t discovery_process_characteristic(
 	struct bt_gatt_chrc *cur_gatt_chrc;
 
 	if (!attr) {
-		discovery_complete(dm);
+		dm->gap_id = 0;
+		descriptor_discovery_next(dm);
 		return BT_GATT_ITER_STOP;
 	}
 
 	__ASSERT_NO_MSG(bt_uuid_cmp(attr->uuid, BT_UUID_GATT_CHRC) == 0);
 
-	cur_attr = attr_find_by_handle(dm, attr->handle);
+	gatt_chrc = attr->user_data;
+	cur_attr = attr_store(dm, attr, sizeof(*cur_gatt_chrc));
 	if (!cur_attr) {
-		/* We should never be here is the server is working properly */
-		discovery_complete_error(dm, -ESRCH);
+		LOG_ERR("Not enough memory for characteristic at handle %u.",
+			attr->handle);
+		discovery_complete_error(dm, -ENOMEM);
 		return BT_GATT_ITER_STOP;
 	}
 
-	gatt_chrc = attr->user_data;
 	cur_gatt_chrc = bt_gatt_dm_attr_chrc_val(cur_attr);
 
 	__ASSERT_NO_MSG(cur_gatt_chrc != NULL);
@@ -462,6 +1204,8 @@ static uint8_t discovery_process_characteristic(
 		return BT_GATT_ITER_STOP;
 	}
 
+	dm->chrc_cnt++;
+
 	return BT_GATT_ITER_CONTINUE;
 }
 
@@ -663,6 +1407,7 @@ int bt_gatt_dm_start(struct bt_conn *conn,
 	dm->cur_attr_id = 0;
 	sys_slist_init(&dm->chunk_list);
 	dm->cur_chunk_len = 0;
+	dm->svc_end_handle = 0xffff;
 	dm->search_svc_by_uuid = (svc_uuid != NULL);
 
 	if (svc_uuid) {
@@ -679,7 +1424,23 @@ int bt_gatt_dm_start(struct bt_conn *conn,
 	dm->discover_params.type = BT_GATT_DISCOVER_PRIMARY;
 	k_work_init(&dm->discover_work, gatt_discover_work);
 
-	err = bt_gatt_discover(conn, &dm->discover_params);
+	stats_time_start(dm);
+
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	k_work_init(&dm->cache_work, cache_lookup_work);
+	dm->search_start_handle = dm->discover_params.start_handle;
+	dm->cache_state = CACHE_DISABLED;
+
+	/* The discovery starts when the Database Hash is known. */
+	err = db_hash_read(dm);
+	if (!err) {
+		return 0;
+	}
+
+	LOG_WRN("Database Hash read failed, error: %d.", err);
+#endif
+
+	err = discover(dm);
 	if (err) {
 		LOG_ERR("Discover failed, error: %d.", err);
 		atomic_clear_bit(dm->state_flags, STATE_ATTRS_LOCKED);
@@ -710,19 +1471,31 @@ int bt_gatt_dm_continue(struct bt_gatt_dm *dm, void *context)
 		return -EALREADY;
 	}
 
-	if (dm->discover_params.end_handle == 0xffff) {
+	if (dm->svc_end_handle == 0xffff) {
 		/* No more handles to discover. */
 		discovery_complete_not_found(dm);
 		return 0;
 	}
 
 	dm->context = context;
-	dm->discover_params.start_handle = dm->discover_params.end_handle + 1;
+	dm->discover_params.start_handle = dm->svc_end_handle + 1;
 	dm->discover_params.end_handle = 0xffff;
 	dm->discover_params.type = BT_GATT_DISCOVER_PRIMARY;
 	dm->discover_params.uuid = dm->search_svc_by_uuid ? &dm->svc_uuid.uuid : NULL;
 
-	err = bt_gatt_discover(dm->conn, &dm->discover_params);
+	stats_time_start(dm);
+
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	dm->search_start_handle = dm->discover_params.start_handle;
+
+	if (dm->cache_state != CACHE_DISABLED) {
+		dm->cache_state = CACHE_MISS;
+		dm_work_submit(&dm->cache_work);
+		return 0;
+	}
+#endif
+
+	err = discover(dm);
 	if (err) {
 		LOG_ERR("Discover failed, error: %d.", err);
 		atomic_clear_bit(dm->state_flags, STATE_ATTRS_LOCKED);
@@ -740,12 +1513,74 @@ int bt_gatt_dm_data_release(struct bt_gatt_dm *dm)
 	}
 
 	k_work_cancel(&dm->discover_work);
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	k_work_cancel(&dm->cache_work);
+#endif
 	svc_attr_memory_release(dm);
 	atomic_clear_bit(dm->state_flags, STATE_ATTRS_LOCKED);
 
 	return 0;
 }
 
+int bt_gatt_dm_cache_clear(const bt_addr_le_t *addr)
+{
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (!cache[i].valid || (addr && bt_addr_le_cmp(&cache[i].addr, addr))) {
+			continue;
+		}
+
+		cache[i].valid = false;
+		cache_entry_changed(&cache[i]);
+	}
+
+	k_mutex_unlock(&cache_mutex);
+
+	return 0;
+#else
+	ARG_UNUSED(addr);
+
+	return -ENOTSUP;
+#endif
+}
+
+int bt_gatt_dm_stats_get(struct bt_gatt_dm_stats *stats, bool reset)
+{
+#if defined(CONFIG_BT_GATT_DM_STATS)
+	k_spinlock_key_t key;
+
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&dm_stats_lock);
+
+	stats->discovery_cnt = dm_stats.discovery_cnt;
+	stats->cache_hit_cnt = dm_stats.cache_hit_cnt;
+	stats->procedure_cnt = dm_stats.procedure_cnt;
+	stats->discovery_time_avg_us = dm_stats.discovery_cnt ?
+		(dm_stats.discovery_time_us / dm_stats.discovery_cnt) : 0;
+	stats->discovery_time_max_us = dm_stats.discovery_time_max_us;
+	stats->cache_time_avg_us = dm_stats.cache_hit_cnt ?
+		(dm_stats.cache_time_us / dm_stats.cache_hit_cnt) : 0;
+
+	if (reset) {
+		memset(&dm_stats, 0, sizeof(dm_stats));
+	}
+
+	k_spin_unlock(&dm_stats_lock, key);
+
+	return 0;
+#else
+	ARG_UNUSED(stats);
+	ARG_UNUSED(reset);
+
+	return -ENOTSUP;
+#endif
+}
+
 #if CONFIG_BT_GATT_DM_DATA_PRINT
 
 #define UUID_STR_LEN 37
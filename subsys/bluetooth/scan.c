@@ -14,6 +14,14 @@ LOG_MODULE_REGISTER(nrf_bt_scan, CONFIG_BT_SCAN_LOG_LEVEL);
 
 #define BT_SCAN_UUID_128_SIZE 16
 
+#define FNV1A_INIT	0x811c9dc5
+#define FNV1A_PRIME	0x01000193
+
+#define ADDR_HASH_SIZE	(2 * CONFIG_BT_SCAN_ADDRESS_CNT)
+#define UUID_HASH_SIZE	(2 * CONFIG_BT_SCAN_UUID_CNT)
+
+#define DEDUP_CACHE_SIZE CONFIG_BT_SCAN_DEDUP_CACHE_SIZE
+
 #define MODE_CHECK (BT_SCAN_NAME_FILTER | BT_SCAN_ADDR_FILTER | \
 	BT_SCAN_SHORT_NAME_FILTER | BT_SCAN_APPEARANCE_FILTER | \
 	BT_SCAN_UUID_FILTER | BT_SCAN_MANUFACTURER_DATA_FILTER)
@@ -89,8 +97,15 @@ struct bt_scan_addr_filter {
 	/* Addresses advertised by the peripherals. */
 	bt_addr_le_t target_addr[CONFIG_BT_SCAN_ADDRESS_CNT];
 
+#if CONFIG_BT_SCAN_ADDRESS_HASH
+	/* Hash index of the addresses. Zero marks an empty slot, other values
+	 * store the address index incremented by one.
+	 */
+	uint16_t hash_index[ADDR_HASH_SIZE];
+#endif /* CONFIG_BT_SCAN_ADDRESS_HASH */
+
 	/* Address filter counter. */
-	uint8_t cnt;
+	uint16_t cnt;
 
 	/* Flag to inform about enabling or disabling this filter. */
 	bool enabled;
@@ -120,6 +135,13 @@ struct bt_scan_uuid_filter {
 	 */
 	struct bt_scan_uuid uuid[CONFIG_BT_SCAN_UUID_CNT];
 
+#if CONFIG_BT_SCAN_UUID_HASH
+	/* Hash index of the UUIDs. Zero marks an empty slot, other values
+	 * store the UUID index incremented by one.
+	 */
+	uint16_t hash_index[UUID_HASH_SIZE];
+#endif /* CONFIG_BT_SCAN_UUID_HASH */
+
 	/* UUID filter counter. */
 	uint8_t cnt;
 
@@ -219,6 +241,51 @@ struct conn_attempts_filter {
 };
 #endif /* CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER */
 
+#if DEDUP_CACHE_SIZE > 0
+/* Filtering result of a recently received advertising report. */
+struct dedup_entry {
+	/* Advertiser address. */
+	bt_addr_le_t addr;
+
+	/* Advertising properties. */
+	uint16_t adv_props;
+
+	/* Length of the advertising data. */
+	uint16_t data_len;
+
+	/* Hash of the advertising data and advertising properties. */
+	uint32_t data_hash;
+
+	/* Advertising data, compared on a hash match to rule out hash collisions. */
+	uint8_t data[CONFIG_BT_SCAN_DEDUP_DATA_SIZE];
+
+	/* Filters generation for which the result is valid. */
+	uint32_t generation;
+
+	/* Number of matched filters. */
+	uint8_t filter_match_cnt;
+
+	/* Indicates whether at least one filter has been fitted. */
+	bool filter_match;
+
+	/* Scan filter status. */
+	struct bt_scan_filter_match filter_status;
+};
+
+/* Direct-mapped cache of the recent filtering results. */
+struct dedup_cache {
+	struct dedup_entry entry[DEDUP_CACHE_SIZE];
+
+	/* Incremented on every filter change to invalidate cached results.
+	 * Protected by the scan mutex.
+	 */
+	uint32_t generation;
+
+	/* Cache statistics. */
+	struct bt_scan_dedup_stats stats;
+};
+#endif /* DEDUP_CACHE_SIZE > 0 */
+
 #if CONFIG_BT_SCAN_BLOCKLIST
 /* Connection blocklist */
 struct conn_blocklist {
@@ -266,10 +333,45 @@ static struct bt_scan {
 	struct conn_blocklist blocklist;
 #endif /* CONFIG_BT_SCAN_BLOCKLIST */
 
+#if DEDUP_CACHE_SIZE > 0
+	/* Advertising report deduplication cache. */
+	struct dedup_cache dedup;
+#endif /* DEDUP_CACHE_SIZE > 0 */
+
 } bt_scan;
 
 static sys_slist_t callback_list;
 
+#if CONFIG_BT_SCAN_ADDRESS_HASH || CONFIG_BT_SCAN_UUID_HASH || (DEDUP_CACHE_SIZE > 0)
+static uint32_t fnv1a_hash(uint32_t hash, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		hash ^= data[i];
+		hash *= FNV1A_PRIME;
+	}
+
+	return hash;
+}
+#endif /* CONFIG_BT_SCAN_ADDRESS_HASH || CONFIG_BT_SCAN_UUID_HASH || (DEDUP_CACHE_SIZE > 0) */
+
+#if CONFIG_BT_SCAN_ADDRESS_HASH || (DEDUP_CACHE_SIZE > 0)
+static uint32_t addr_hash(const bt_addr_le_t *addr)
+{
+	uint32_t hash = fnv1a_hash(FNV1A_INIT, &addr->type, sizeof(addr->type));
+
+	return fnv1a_hash(hash, addr->a.val, sizeof(addr->a.val));
+}
+#endif /* CONFIG_BT_SCAN_ADDRESS_HASH || (DEDUP_CACHE_SIZE > 0) */
+
+/* Must be called with the scan mutex held, after the filters are modified. */
+static void filters_changed(void)
+{
+#if DEDUP_CACHE_SIZE > 0
+	/* Cached filtering results are no longer valid. */
+	bt_scan.dedup.generation++;
+#endif /* DEDUP_CACHE_SIZE > 0 */
+}
+
 void bt_scan_cb_register(struct bt_scan_cb *cb)
 {
 	if (!cb) {
@@ -506,22 +608,70 @@ static void scan_connect_with_target(struct bt_scan_control *control,
 }
 #endif /* CONFIG_BT_CENTRAL */
 
-static bool adv_addr_compare(const bt_addr_le_t *target_addr,
-			     struct bt_scan_control *control)
+#if CONFIG_BT_SCAN_ADDRESS_HASH
+static int addr_hash_find(const bt_addr_le_t *target_addr)
 {
+	const struct bt_scan_addr_filter *addr_filter = &bt_scan.scan_filters.addr;
+	size_t slot = addr_hash(target_addr) % ADDR_HASH_SIZE;
+
+	/* Index is at most half full, the loop always finds an empty slot. */
+	while (addr_filter->hash_index[slot] != 0) {
+		uint16_t idx = addr_filter->hash_index[slot] - 1;
+
+		if (bt_addr_le_cmp(target_addr, &addr_filter->target_addr[idx]) == 0) {
+			return idx;
+		}
+
+		slot = (slot + 1) % ADDR_HASH_SIZE;
+	}
+
+	return -ENOENT;
+}
+
+static void addr_hash_insert(uint16_t idx)
+{
+	struct bt_scan_addr_filter *addr_filter = &bt_scan.scan_filters.addr;
+	size_t slot = addr_hash(&addr_filter->target_addr[idx]) % ADDR_HASH_SIZE;
+
+	while (addr_filter->hash_index[slot] != 0) {
+		slot = (slot + 1) % ADDR_HASH_SIZE;
+	}
+
+	addr_filter->hash_index[slot] = idx + 1;
+}
+#endif /* CONFIG_BT_SCAN_ADDRESS_HASH */
+
+static int addr_filter_find(const bt_addr_le_t *target_addr)
+{
+#if CONFIG_BT_SCAN_ADDRESS_HASH
+	return addr_hash_find(target_addr);
+#else
 	const bt_addr_le_t *addr =
 			bt_scan.scan_filters.addr.target_addr;
-	uint8_t counter = bt_scan.scan_filters.addr.cnt;
+	uint16_t counter = bt_scan.scan_filters.addr.cnt;
 
 	for (size_t i = 0; i < counter; i++) {
 		if (bt_addr_le_cmp(target_addr, &addr[i]) == 0) {
-			control->filter_status.addr.addr = &addr[i];
-
-			return true;
+			return i;
 		}
 	}
 
-	return false;
+	return -ENOENT;
+#endif /* CONFIG_BT_SCAN_ADDRESS_HASH */
+}
+
+static bool adv_addr_compare(const bt_addr_le_t *target_addr,
+			     struct bt_scan_control *control)
+{
+	int idx = addr_filter_find(target_addr);
+
+	if (idx < 0) {
+		return false;
+	}
+
+	control->filter_status.addr.addr = &bt_scan.scan_filters.addr.target_addr[idx];
+
+	return true;
 }
 
 static bool is_addr_filter_enabled(void)
@@ -548,23 +698,25 @@ static int scan_addr_filter_add(const bt_addr_le_t *target_addr)
 	char addr[BT_ADDR_LE_STR_LEN];
 	bt_addr_le_t *addr_filter =
 			bt_scan.scan_filters.addr.target_addr;
-	uint8_t counter = bt_scan.scan_filters.addr.cnt;
+	uint16_t counter = bt_scan.scan_filters.addr.cnt;
+
+	/* Check for duplicated filter. */
+	if (addr_filter_find(target_addr) >= 0) {
+		return 0;
+	}
 
 	/* If no memory for filter. */
 	if (counter >= CONFIG_BT_SCAN_ADDRESS_CNT) {
 		return -ENOMEM;
 	}
 
-	/* Check for duplicated filter. */
-	for (size_t i = 0; i < counter; i++) {
-		if (bt_addr_le_cmp(target_addr, &addr_filter[i]) == 0) {
-			return 0;
-		}
-	}
-
 	/* Add target address to filter. */
 	bt_addr_le_copy(&addr_filter[counter], target_addr);
 
+#if CONFIG_BT_SCAN_ADDRESS_HASH
+	addr_hash_insert(counter);
+#endif /* CONFIG_BT_SCAN_ADDRESS_HASH */
+
 	LOG_DBG("Filter set on address type %i",
 		addr_filter[counter].type);
 
@@ -788,7 +940,7 @@ static bool find_uuid(const uint8_t *data,
 		return false;
 	}
 
-	for (size_t i = 0; i < data_len; i += uuid_len) {
+	for (size_t i = 0; i + uuid_len <= data_len; i += uuid_len) {
 		struct bt_uuid_128 uuid;
 
 		if (!bt_uuid_create(&uuid.uuid, &data[i], uuid_len)) {
@@ -803,6 +955,130 @@ static bool find_uuid(const uint8_t *data,
 	return false;
 }
 
+#if CONFIG_BT_SCAN_UUID_HASH
+/* Converts the UUID to the 128-bit little-endian form, so that the same UUID
+ * in different forms results in the same hash.
+ */
+static void uuid_to_uuid128_val(const struct bt_uuid *uuid,
+				uint8_t val[BT_SCAN_UUID_128_SIZE])
+{
+	static const uint8_t base_uuid[BT_SCAN_UUID_128_SIZE] = {
+		0xfb, 0x34, 0x9b, 0x5f, 0x80, 0x00, 0x00, 0x80,
+		0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+	};
+
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		memcpy(val, base_uuid, sizeof(base_uuid));
+		sys_put_le16(BT_UUID_16(uuid)->val, &val[12]);
+		break;
+
+	case BT_UUID_TYPE_32:
+		memcpy(val, base_uuid, sizeof(base_uuid));
+		sys_put_le32(BT_UUID_32(uuid)->val, &val[12]);
+		break;
+
+	case BT_UUID_TYPE_128:
+		memcpy(val, BT_UUID_128(uuid)->val, BT_SCAN_UUID_128_SIZE);
+		break;
+
+	default:
+		__ASSERT_NO_MSG(false);
+		memset(val, 0, BT_SCAN_UUID_128_SIZE);
+		break;
+	}
+}
+
+static int uuid_hash_find(const struct bt_uuid *uuid)
+{
+	const struct bt_scan_uuid_filter *uuid_filter = &bt_scan.scan_filters.uuid;
+	uint8_t val[BT_SCAN_UUID_128_SIZE];
+	size_t slot;
+
+	uuid_to_uuid128_val(uuid, val);
+	slot = fnv1a_hash(FNV1A_INIT, val, sizeof(val)) % UUID_HASH_SIZE;
+
+	/* Index is at most half full, the loop always finds an empty slot. */
+	while (uuid_filter->hash_index[slot] != 0) {
+		uint16_t idx = uuid_filter->hash_index[slot] - 1;
+
+		if (bt_uuid_cmp(uuid, uuid_filter->uuid[idx].uuid) == 0) {
+			return idx;
+		}
+
+		slot = (slot + 1) % UUID_HASH_SIZE;
+	}
+
+	return -ENOENT;
+}
+
+static void uuid_hash_insert(uint8_t idx)
+{
+	struct bt_scan_uuid_filter *uuid_filter = &bt_scan.scan_filters.uuid;
+	uint8_t val[BT_SCAN_UUID_128_SIZE];
+	size_t slot;
+
+	uuid_to_uuid128_val(uuid_filter->uuid[idx].uuid, val);
+	slot = fnv1a_hash(FNV1A_INIT, val, sizeof(val)) % UUID_HASH_SIZE;
+
+	while (uuid_filter->hash_index[slot] != 0) {
+		slot = (slot + 1) % UUID_HASH_SIZE;
+	}
+
+	uuid_filter->hash_index[slot] = idx + 1;
+}
+
+/* In the normal filter mode a single hash lookup per advertised UUID replaces
+ * comparing every advertised UUID against every filter.
+ */
+static bool adv_uuid_hash_compare(const struct bt_data *data, uint8_t uuid_type,
+				  struct bt_scan_control *control)
+{
+	const struct bt_scan_uuid_filter *uuid_filter =
+			&bt_scan.scan_filters.uuid;
+	uint8_t uuid_len;
+
+	switch (uuid_type) {
+	case BT_UUID_TYPE_16:
+		uuid_len = sizeof(uint16_t);
+		break;
+
+	case BT_UUID_TYPE_32:
+		uuid_len = sizeof(uint32_t);
+		break;
+
+	case BT_UUID_TYPE_128:
+		uuid_len = BT_SCAN_UUID_128_SIZE * sizeof(uint8_t);
+		break;
+
+	default:
+		return false;
+	}
+
+	/* Trailing bytes that do not form a complete UUID are ignored. */
+	for (size_t i = 0; i + uuid_len <= data->data_len; i += uuid_len) {
+		struct bt_uuid_128 uuid;
+		int idx;
+
+		if (!bt_uuid_create(&uuid.uuid, &data->data[i], uuid_len)) {
+			break;
+		}
+
+		idx = uuid_hash_find(&uuid.uuid);
+		if (idx >= 0) {
+			control->filter_status.uuid.uuid[0] = uuid_filter->uuid[idx].uuid;
+			control->filter_status.uuid.count = 1;
+
+			return true;
+		}
+	}
+
+	control->filter_status.uuid.count = 0;
+
+	return false;
+}
+#endif /* CONFIG_BT_SCAN_UUID_HASH */
+
 static bool adv_uuid_compare(const struct bt_data *data, uint8_t uuid_type,
 			     struct bt_scan_control *control)
 {
@@ -813,6 +1089,12 @@ static bool adv_uuid_compare(const struct bt_data *data, uint8_t uuid_type,
 	uint8_t data_len = data->data_len;
 	uint8_t uuid_match_cnt = 0;
 
+#if CONFIG_BT_SCAN_UUID_HASH
+	if (!all_filters_mode) {
+		return adv_uuid_hash_compare(data, uuid_type, control);
+	}
+#endif /* CONFIG_BT_SCAN_UUID_HASH */
+
 	for (size_t i = 0; i < counter; i++) {
 
 		if (find_uuid(data->data, data_len, uuid_type,
@@ -881,11 +1163,17 @@ static int scan_uuid_filter_add(struct bt_uuid *uuid)
 	}
 
 	/* Check for duplicated filter. */
+#if CONFIG_BT_SCAN_UUID_HASH
+	if (uuid_hash_find(uuid) >= 0) {
+		return 0;
+	}
+#else
 	for (size_t i = 0; i < counter; i++) {
 		if (bt_uuid_cmp(uuid_filter[i].uuid, uuid) == 0) {
 			return 0;
 		}
 	}
+#endif /* CONFIG_BT_SCAN_UUID_HASH */
 
 	/* Add UUID to the filter. */
 	switch (uuid->type) {
@@ -917,6 +1205,10 @@ static int scan_uuid_filter_add(struct bt_uuid *uuid)
 		return -EINVAL;
 	}
 
+#if CONFIG_BT_SCAN_UUID_HASH
+	uuid_hash_insert(counter);
+#endif /* CONFIG_BT_SCAN_UUID_HASH */
+
 	bt_scan.scan_filters.uuid.cnt++;
 	LOG_DBG("Added filter on UUID type %x", uuid->type);
 
@@ -1209,6 +1501,10 @@ int bt_scan_filter_add(enum bt_scan_filter_type type,
 		break;
 	}
 
+	if (!err) {
+		filters_changed();
+	}
+
 	k_mutex_unlock(&scan_mutex);
 
 	return err;
@@ -1229,10 +1525,16 @@ void bt_scan_filter_remove_all(void)
 	struct bt_scan_addr_filter *addr_filter =
 			&bt_scan.scan_filters.addr;
 	addr_filter->cnt = 0;
+#if CONFIG_BT_SCAN_ADDRESS_HASH
+	memset(addr_filter->hash_index, 0, sizeof(addr_filter->hash_index));
+#endif /* CONFIG_BT_SCAN_ADDRESS_HASH */
 
 	struct bt_scan_uuid_filter *uuid_filter =
 			&bt_scan.scan_filters.uuid;
 	uuid_filter->cnt = 0;
+#if CONFIG_BT_SCAN_UUID_HASH
+	memset(uuid_filter->hash_index, 0, sizeof(uuid_filter->hash_index));
+#endif /* CONFIG_BT_SCAN_UUID_HASH */
 
 	struct bt_scan_appearance_filter *appearance_filter =
 			&bt_scan.scan_filters.appearance;
@@ -1242,10 +1544,12 @@ void bt_scan_filter_remove_all(void)
 		&bt_scan.scan_filters.manufacturer_data;
 	manufacturer_data_filter->cnt = 0;
 
+	filters_changed();
+
 	k_mutex_unlock(&scan_mutex);
 }
 
-void bt_scan_filter_disable(void)
+static void filters_disable(void)
 {
 	/* Disable all filters. */
 	bt_scan.scan_filters.name.enabled = false;
@@ -1256,6 +1560,16 @@ void bt_scan_filter_disable(void)
 	bt_scan.scan_filters.manufacturer_data.enabled = false;
 }
 
+void bt_scan_filter_disable(void)
+{
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+
+	filters_disable();
+	filters_changed();
+
+	k_mutex_unlock(&scan_mutex);
+}
+
 int bt_scan_filter_enable(uint8_t mode, bool match_all)
 {
 	/* Check if the mode is correct. */
@@ -1263,8 +1577,10 @@ int bt_scan_filter_enable(uint8_t mode, bool match_all)
 		return -EINVAL;
 	}
 
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+
 	/* Disable filters. */
-	bt_scan_filter_disable();
+	filters_disable();
 
 	struct bt_scan_filters *filters = &bt_scan.scan_filters;
 
@@ -1296,6 +1612,10 @@ int bt_scan_filter_enable(uint8_t mode, bool match_all)
 	/* Select the filter mode. */
 	filters->all_mode = match_all;
 
+	filters_changed();
+
+	k_mutex_unlock(&scan_mutex);
+
 	return 0;
 }
 
@@ -1325,6 +1645,29 @@ int bt_scan_filter_status_get(struct bt_filter_status *status)
 	return 0;
 }
 
+int bt_scan_dedup_stats_get(struct bt_scan_dedup_stats *stats, bool reset)
+{
+	if (!stats) {
+		return -EINVAL;
+	}
+
+#if DEDUP_CACHE_SIZE > 0
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+
+	*stats = bt_scan.dedup.stats;
+
+	if (reset) {
+		memset(&bt_scan.dedup.stats, 0, sizeof(bt_scan.dedup.stats));
+	}
+
+	k_mutex_unlock(&scan_mutex);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif /* DEDUP_CACHE_SIZE > 0 */
+}
+
 int bt_scan_stop(void)
 {
 	return bt_le_scan_stop();
@@ -1335,8 +1678,13 @@ void bt_scan_init(const struct bt_scan_init_param *init)
 {
 	bt_le_scan_cb_register(&scan_cb);
 
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+
 	/* Disable all scanning filters. */
 	memset(&bt_scan.scan_filters, 0, sizeof(bt_scan.scan_filters));
+	filters_changed();
+
+	k_mutex_unlock(&scan_mutex);
 
 	/* If the pointer to the initialization structure exist,
 	 * use it to scan the configuration.
@@ -1491,11 +1839,107 @@ static void filter_state_check(struct bt_scan_control *control,
 	}
 }
 
+static void filters_check(struct bt_scan_control *control,
+			  const bt_addr_le_t *addr,
+			  struct net_buf_simple *ad)
+{
+	struct net_buf_simple_state state;
+
+	/* Check the address filter. */
+	check_addr(control, addr);
+
+	/* Save advertising buffer state to transfer it
+	 * data to application if futher processing is needed.
+	 */
+	net_buf_simple_save(ad, &state);
+	bt_data_parse(ad, adv_data_found, (void *)control);
+	net_buf_simple_restore(ad, &state);
+}
+
+#if DEDUP_CACHE_SIZE > 0
+static uint32_t adv_data_hash(const struct bt_le_scan_recv_info *info,
+			      const struct net_buf_simple *ad)
+{
+	uint32_t hash = fnv1a_hash(FNV1A_INIT, (const uint8_t *)&info->adv_props,
+				   sizeof(info->adv_props));
+
+	return fnv1a_hash(hash, ad->data, ad->len);
+}
+
+static bool dedup_entry_match(const struct dedup_entry *entry,
+			      const struct bt_le_scan_recv_info *info,
+			      const struct net_buf_simple *ad,
+			      uint32_t data_hash, uint32_t generation)
+{
+	return (entry->generation == generation) &&
+	       (entry->data_hash == data_hash) &&
+	       (entry->data_len == ad->len) &&
+	       (entry->adv_props == info->adv_props) &&
+	       (bt_addr_le_cmp(&entry->addr, info->addr) == 0) &&
+	       (memcmp(entry->data, ad->data, ad->len) == 0);
+}
+
+static void dedup_filters_check(struct bt_scan_control *control,
+				const struct bt_le_scan_recv_info *info,
+				struct net_buf_simple *ad)
+{
+	const bt_addr_le_t *addr = info->addr;
+	struct dedup_cache *cache = &bt_scan.dedup;
+	struct dedup_entry *entry = &cache->entry[addr_hash(addr) % DEDUP_CACHE_SIZE];
+	/* Reports with advertising data that does not fit in the entry are not cached. */
+	bool cacheable = (ad->len <= sizeof(entry->data));
+	uint32_t data_hash = cacheable ? adv_data_hash(info, ad) : 0;
+	uint32_t generation;
+	bool hit;
+
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+
+	generation = cache->generation;
+	hit = cacheable && dedup_entry_match(entry, info, ad, data_hash, generation);
+	if (hit) {
+		control->filter_match = entry->filter_match;
+		control->filter_match_cnt = entry->filter_match_cnt;
+		control->filter_status = entry->filter_status;
+		cache->stats.hit++;
+	} else {
+		cache->stats.miss++;
+	}
+
+	k_mutex_unlock(&scan_mutex);
+
+	if (hit) {
+		return;
+	}
+
+	filters_check(control, addr, ad);
+
+	if (!cacheable) {
+		return;
+	}
+
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+
+	/* Filters changed in the meantime, the result must not be cached. */
+	if (generation == cache->generation) {
+		bt_addr_le_copy(&entry->addr, addr);
+		entry->adv_props = info->adv_props;
+		entry->data_len = ad->len;
+		entry->data_hash = data_hash;
+		memcpy(entry->data, ad->data, ad->len);
+		entry->generation = generation;
+		entry->filter_match = control->filter_match;
+		entry->filter_match_cnt = control->filter_match_cnt;
+		entry->filter_status = control->filter_status;
+	}
+
+	k_mutex_unlock(&scan_mutex);
+}
+#endif /* DEDUP_CACHE_SIZE > 0 */
+
 static void scan_recv(const struct bt_le_scan_recv_info *info,
 		      struct net_buf_simple *ad)
 {
 	struct bt_scan_control scan_control;
-	struct net_buf_simple_state state;
 
 	memset(&scan_control, 0, sizeof(scan_control));
 
@@ -1507,15 +1951,14 @@ static void scan_recv(const struct bt_le_scan_recv_info *info,
 	scan_control.connectable =
 		(info->adv_props & BT_GAP_ADV_PROP_CONNECTABLE) != 0;
 
-	/* Check the address filter. */
-	check_addr(&scan_control, info->addr);
-
-	/* Save advertising buffer state to transfer it
-	 * data to application if futher processing is needed.
+#if DEDUP_CACHE_SIZE > 0
+	/* Advertisers repeat the same payload many times per second.
+	 * Reuse the filtering result of the previous identical report.
 	 */
-	net_buf_simple_save(ad, &state);
-	bt_data_parse(ad, adv_data_found, (void *)&scan_control);
-	net_buf_simple_restore(ad, &state);
+	dedup_filters_check(&scan_control, info, ad);
+#else
+	filters_check(&scan_control, info->addr, ad);
+#endif /* DEDUP_CACHE_SIZE > 0 */
 
 	scan_control.device_info.recv_info = info;
 	scan_control.device_info.conn_param = &bt_scan.conn_param;
@@ -4,9 +4,11 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <zephyr/kernel.h>
 #include <zephyr/bluetooth/conn.h>
 #include <zephyr/bluetooth/uuid.h>
 #include <zephyr/bluetooth/gatt.h>
+#include <zephyr/sys/ring_buffer.h>
 
 #include <bluetooth/services/nus.h>
 #include <zephyr/logging/log.h>
@@ -15,6 +17,35 @@ LOG_MODULE_REGISTER(bt_nus, CONFIG_BT_NUS_LOG_LEVEL);
 
 static struct bt_nus_cb nus_cb;
 
+#ifdef CONFIG_BT_NUS_TX_COALESCE
+/* Largest notification payload that fits in the ATT MTU. */
+#define NUS_NOTIF_MAX_LEN (CONFIG_BT_L2CAP_TX_MTU - 3)
+
+struct nus_tx_ctx {
+	struct bt_conn *conn;
+	struct ring_buf rb;
+	uint8_t rb_data[CONFIG_BT_NUS_TX_COALESCE_BUF_SIZE];
+	struct k_work_delayable flush_work;
+	struct k_spinlock lock;
+	atomic_t in_flight;
+	bool force_flush;
+
+	/* Time when the oldest pending data was queued (milliseconds). */
+	uint32_t pending_since;
+
+	/* Statistics. */
+	uint32_t tx_bytes;
+	uint32_t tx_notifications;
+	uint32_t tx_capacity;
+	int64_t stats_start;
+};
+
+static struct nus_tx_ctx nus_tx_ctx[CONFIG_BT_MAX_CONN];
+static uint8_t nus_tx_buf[NUS_NOTIF_MAX_LEN];
+
+static void nus_tx_flush_work_handler(struct k_work *work);
+#endif /* CONFIG_BT_NUS_TX_COALESCE */
+
 static void nus_ccc_cfg_changed(const struct bt_gatt_attr *attr,
 				  uint16_t value)
 {
@@ -44,7 +75,20 @@ static ssize_t on_receive(struct bt_conn *conn,
 
 static void on_sent(struct bt_conn *conn, void *user_data)
 {
+#ifdef CONFIG_BT_NUS_TX_COALESCE
+	struct nus_tx_ctx *ctx = user_data;
+
+	if (ctx && (ctx->conn == conn)) {
+		atomic_dec(&ctx->in_flight);
+
+		/* Notification slot is free again, continue with the pending data. */
+		if (!ring_buf_is_empty(&ctx->rb)) {
+			k_work_reschedule(&ctx->flush_work, K_NO_WAIT);
+		}
+	}
+#else
 	ARG_UNUSED(user_data);
+#endif /* CONFIG_BT_NUS_TX_COALESCE */
 
 	LOG_DBG("Data send, conn %p", (void *)conn);
 
@@ -83,6 +127,14 @@ BT_GATT_PRIMARY_SERVICE(BT_UUID_NUS_SERVICE),
 
 int bt_nus_init(struct bt_nus_cb *callbacks)
 {
+#ifdef CONFIG_BT_NUS_TX_COALESCE
+	for (size_t i = 0; i < ARRAY_SIZE(nus_tx_ctx); i++) {
+		ring_buf_init(&nus_tx_ctx[i].rb, sizeof(nus_tx_ctx[i].rb_data),
+			      nus_tx_ctx[i].rb_data);
+		k_work_init_delayable(&nus_tx_ctx[i].flush_work, nus_tx_flush_work_handler);
+	}
+#endif /* CONFIG_BT_NUS_TX_COALESCE */
+
 	if (callbacks) {
 		nus_cb.received = callbacks->received;
 		nus_cb.sent = callbacks->sent;
@@ -92,8 +144,309 @@ int bt_nus_init(struct bt_nus_cb *callbacks)
 	return 0;
 }
 
+#ifdef CONFIG_BT_NUS_TX_COALESCE
+static struct nus_tx_ctx *nus_tx_ctx_get(struct bt_conn *conn)
+{
+	return &nus_tx_ctx[bt_conn_index(conn)];
+}
+
+static bool nus_tx_timeout_expired(struct nus_tx_ctx *ctx)
+{
+	return (k_uptime_get_32() - ctx->pending_since) >= CONFIG_BT_NUS_TX_COALESCE_TIMEOUT_MS;
+}
+
+static void nus_tx_flush(struct nus_tx_ctx *ctx, struct bt_conn *conn)
+{
+	struct bt_gatt_notify_params params = {0};
+	uint16_t mtu = MIN(bt_nus_get_mtu(conn), sizeof(nus_tx_buf));
+	k_spinlock_key_t key;
+	int err;
+
+	params.attr = &nus_svc.attrs[2];
+	params.data = nus_tx_buf;
+	params.func = on_sent;
+	params.user_data = ctx;
+
+	while (atomic_get(&ctx->in_flight) < CONFIG_BT_NUS_TX_COALESCE_MAX_IN_FLIGHT) {
+		key = k_spin_lock(&ctx->lock);
+
+		uint32_t pending = ring_buf_size_get(&ctx->rb);
+
+		/* Partially filled notification is sent only if the link is idle, the timeout
+		 * expired or flush was requested. Otherwise, wait for more data.
+		 */
+		if ((pending == 0) ||
+		    ((pending < mtu) && !ctx->force_flush &&
+		     (atomic_get(&ctx->in_flight) > 0) && !nus_tx_timeout_expired(ctx))) {
+			k_spin_unlock(&ctx->lock, key);
+			break;
+		}
+
+		params.len = ring_buf_peek(&ctx->rb, nus_tx_buf, mtu);
+
+		k_spin_unlock(&ctx->lock, key);
+
+		atomic_inc(&ctx->in_flight);
+
+		err = bt_gatt_notify_cb(conn, &params);
+		if (err) {
+			atomic_dec(&ctx->in_flight);
+			LOG_DBG("Notification not sent (err %d)", err);
+
+			if (err == -EINVAL) {
+				/* Peer disabled notifications, pending data is not needed. */
+				key = k_spin_lock(&ctx->lock);
+				ring_buf_reset(&ctx->rb);
+				ctx->force_flush = false;
+				k_spin_unlock(&ctx->lock, key);
+			}
+
+			break;
+		}
+
+		key = k_spin_lock(&ctx->lock);
+
+		ring_buf_get(&ctx->rb, NULL, params.len);
+		ctx->tx_bytes += params.len;
+		ctx->tx_notifications++;
+		ctx->tx_capacity += mtu;
+
+		if (ring_buf_is_empty(&ctx->rb)) {
+			ctx->force_flush = false;
+		}
+
+		k_spin_unlock(&ctx->lock, key);
+	}
+
+	if (ring_buf_is_empty(&ctx->rb)) {
+		return;
+	}
+
+	if (atomic_get(&ctx->in_flight) == 0) {
+		/* Sending failed and no sent callback will resume the transmission. */
+		k_work_reschedule(&ctx->flush_work,
+				  K_MSEC(CONFIG_BT_NUS_TX_COALESCE_TIMEOUT_MS));
+	} else if (atomic_get(&ctx->in_flight) < CONFIG_BT_NUS_TX_COALESCE_MAX_IN_FLIGHT) {
+		uint32_t age = k_uptime_get_32() - ctx->pending_since;
+
+		k_work_reschedule(&ctx->flush_work,
+				  K_MSEC(CONFIG_BT_NUS_TX_COALESCE_TIMEOUT_MS -
+					 MIN(age, CONFIG_BT_NUS_TX_COALESCE_TIMEOUT_MS)));
+	}
+}
+
+static void nus_tx_flush_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct nus_tx_ctx *ctx = CONTAINER_OF(dwork, struct nus_tx_ctx, flush_work);
+	struct bt_conn *conn = NULL;
+	k_spinlock_key_t key;
+
+	/* Local reference keeps the connection valid even if it is disconnected meanwhile. */
+	key = k_spin_lock(&ctx->lock);
+	if (ctx->conn) {
+		conn = bt_conn_ref(ctx->conn);
+	}
+	k_spin_unlock(&ctx->lock, key);
+
+	if (!conn) {
+		return;
+	}
+
+	nus_tx_flush(ctx, conn);
+	bt_conn_unref(conn);
+}
+
+static int nus_tx_enqueue(struct bt_conn *conn, const uint8_t *data, uint16_t len)
+{
+	struct nus_tx_ctx *ctx = nus_tx_ctx_get(conn);
+	k_spinlock_key_t key;
+	uint32_t pending;
+
+	if (!bt_gatt_is_subscribed(conn, &nus_svc.attrs[2], BT_GATT_CCC_NOTIFY)) {
+		return -EINVAL;
+	}
+
+	if (len > sizeof(ctx->rb_data)) {
+		return -EMSGSIZE;
+	}
+
+	key = k_spin_lock(&ctx->lock);
+
+	if (ring_buf_space_get(&ctx->rb) < len) {
+		k_spin_unlock(&ctx->lock, key);
+		return -ENOMEM;
+	}
+
+	if (!ctx->conn) {
+		ctx->conn = bt_conn_ref(conn);
+		ctx->stats_start = k_uptime_get();
+	}
+
+	if (ring_buf_is_empty(&ctx->rb)) {
+		ctx->pending_since = k_uptime_get_32();
+	}
+
+	ring_buf_put(&ctx->rb, data, len);
+	pending = ring_buf_size_get(&ctx->rb);
+
+	k_spin_unlock(&ctx->lock, key);
+
+	if ((atomic_get(&ctx->in_flight) == 0) || (pending >= bt_nus_get_mtu(conn))) {
+		/* Idle link or full notification, send without waiting. */
+		k_work_reschedule(&ctx->flush_work, K_NO_WAIT);
+	} else {
+		/* Does not postpone the already scheduled flush. */
+		k_work_schedule(&ctx->flush_work, K_MSEC(CONFIG_BT_NUS_TX_COALESCE_TIMEOUT_MS));
+	}
+
+	return 0;
+}
+
+struct nus_tx_enqueue_all_data {
+	const uint8_t *data;
+	uint16_t len;
+	int err;
+	bool queued;
+};
+
+static void nus_tx_enqueue_all(struct bt_conn *conn, void *user_data)
+{
+	struct nus_tx_enqueue_all_data *all_data = user_data;
+	struct bt_conn_info info;
+	int err;
+
+	if (bt_conn_get_info(conn, &info) || (info.state != BT_CONN_STATE_CONNECTED)) {
+		return;
+	}
+
+	err = nus_tx_enqueue(conn, all_data->data, all_data->len);
+	if (!err) {
+		all_data->queued = true;
+	} else if (err != -EINVAL) {
+		all_data->err = err;
+	}
+}
+
+static void nus_tx_disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	struct nus_tx_ctx *ctx = nus_tx_ctx_get(conn);
+	struct k_work_sync sync;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(reason);
+
+	if (ctx->conn != conn) {
+		return;
+	}
+
+	/* Wait for the ongoing flush, so that the context is not used after it is reset. */
+	(void)k_work_cancel_delayable_sync(&ctx->flush_work, &sync);
+
+	key = k_spin_lock(&ctx->lock);
+	ring_buf_reset(&ctx->rb);
+	ctx->conn = NULL;
+	ctx->force_flush = false;
+	atomic_set(&ctx->in_flight, 0);
+	ctx->tx_bytes = 0;
+	ctx->tx_notifications = 0;
+	ctx->tx_capacity = 0;
+	k_spin_unlock(&ctx->lock, key);
+
+	bt_conn_unref(conn);
+}
+
+BT_CONN_CB_DEFINE(nus_conn_callbacks) = {
+	.disconnected = nus_tx_disconnected,
+};
+
+int bt_nus_flush(struct bt_conn *conn)
+{
+	struct nus_tx_ctx *ctx;
+
+	if (!conn) {
+		for (size_t i = 0; i < ARRAY_SIZE(nus_tx_ctx); i++) {
+			if (nus_tx_ctx[i].conn) {
+				nus_tx_ctx[i].force_flush = true;
+				k_work_reschedule(&nus_tx_ctx[i].flush_work, K_NO_WAIT);
+			}
+		}
+
+		return 0;
+	}
+
+	ctx = nus_tx_ctx_get(conn);
+	if (ctx->conn != conn) {
+		return -ENOTCONN;
+	}
+
+	ctx->force_flush = true;
+	k_work_reschedule(&ctx->flush_work, K_NO_WAIT);
+
+	return 0;
+}
+
+int bt_nus_tx_stats_get(struct bt_conn *conn, struct bt_nus_tx_stats *stats, bool reset)
+{
+	struct nus_tx_ctx *ctx;
+	k_spinlock_key_t key;
+	int64_t elapsed_ms;
+
+	if (!conn || !stats) {
+		return -EINVAL;
+	}
+
+	ctx = nus_tx_ctx_get(conn);
+	if (ctx->conn != conn) {
+		return -ENOTCONN;
+	}
+
+	key = k_spin_lock(&ctx->lock);
+
+	elapsed_ms = k_uptime_get() - ctx->stats_start;
+
+	stats->bytes = ctx->tx_bytes;
+	stats->notifications = ctx->tx_notifications;
+	stats->fill_ratio = ctx->tx_capacity ?
+			    ((uint64_t)ctx->tx_bytes * 100) / ctx->tx_capacity : 0;
+	stats->throughput = (elapsed_ms > 0) ?
+			    ((uint64_t)ctx->tx_bytes * MSEC_PER_SEC) / elapsed_ms : 0;
+
+	if (reset) {
+		ctx->tx_bytes = 0;
+		ctx->tx_notifications = 0;
+		ctx->tx_capacity = 0;
+		ctx->stats_start = k_uptime_get();
+	}
+
+	k_spin_unlock(&ctx->lock, key);
+
+	return 0;
+}
+#endif /* CONFIG_BT_NUS_TX_COALESCE */
+
 int bt_nus_send(struct bt_conn *conn, const uint8_t *data, uint16_t len)
 {
+#ifdef CONFIG_BT_NUS_TX_COALESCE
+	if (!conn) {
+		struct nus_tx_enqueue_all_data all_data = {
+			.data = data,
+			.len = len,
+		};
+
+		LOG_DBG("Data queued for all connected peers");
+		bt_conn_foreach(BT_CONN_TYPE_LE, nus_tx_enqueue_all, &all_data);
+
+		if (all_data.err) {
+			return all_data.err;
+		}
+
+		/* No connected peer has notifications enabled. */
+		return all_data.queued ? 0 : -ENOTCONN;
+	}
+
+	return nus_tx_enqueue(conn, data, len);
+#else
 	struct bt_gatt_notify_params params = {0};
 	const struct bt_gatt_attr *attr = &nus_svc.attrs[2];
 
@@ -105,9 +458,12 @@ int bt_nus_send(struct bt_conn *conn, const uint8_t *data, uint16_t len)
 	if (!conn) {
 		LOG_DBG("Notification send to all connected peers");
 		return bt_gatt_notify_cb(NULL, &params);
-	} else if (bt_gatt_is_subscribed(conn, attr, BT_GATT_CCC_NOTIFY)) {
-		return bt_gatt_notify_cb(conn, &params);
-	} else {
+	} else if (!bt_gatt_is_subscribed(conn, attr, BT_GATT_CCC_NOTIFY)) {
 		return -EINVAL;
+	} else if (len > bt_nus_get_mtu(conn)) {
+		return -EMSGSIZE;
+	} else {
+		return bt_gatt_notify_cb(conn, &params);
 	}
+#endif /* CONFIG_BT_NUS_TX_COALESCE */
 }
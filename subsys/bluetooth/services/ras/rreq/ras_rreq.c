@@ -183,19 +183,30 @@ static void data_receive_finished(struct bt_ras_rreq *rreq)
 		rreq->data_error_status = -ENODATA;
 	}
 
+	int data_error_status = rreq->data_error_status;
+
+	/* Reset the reception state before calling the application, so that the real-time
+	 * ranging data callback can already provide the buffer for the next ranging data.
+	 */
+	rreq->last_segment_received = false;
+	rreq->next_expected_segment_counter = 0;
+	rreq->data_error_status = 0;
+
 	if (rreq->realtime) {
+		struct net_buf_simple *ranging_data_out = rreq->real_time_rd.ranging_data_out;
+
 		rreq->real_time_rd.data_cb(rreq->conn, rreq->counter_in_progress,
-					   rreq->data_error_status);
-		net_buf_simple_reset(rreq->real_time_rd.ranging_data_out);
+					   data_error_status);
+
+		/* Buffer is not reset if the callback has provided a new one. */
+		if (ranging_data_out == rreq->real_time_rd.ranging_data_out) {
+			net_buf_simple_reset(ranging_data_out);
+		}
 	} else {
 		rreq->on_demand_rd.data_cb(rreq->conn, rreq->counter_in_progress,
-					   rreq->data_error_status);
+					   data_error_status);
 		rreq->on_demand_rd.data_get_in_progress = false;
 	}
-
-	rreq->last_segment_received = false;
-	rreq->next_expected_segment_counter = 0;
-	rreq->data_error_status = 0;
 }
 
 static uint8_t ranging_data_overwritten_notify_func(struct bt_conn *conn,
@@ -988,6 +999,29 @@ int bt_ras_rreq_realtime_rd_subscribe(struct bt_conn *conn, struct net_buf_simpl
 	return 0;
 }
 
+int bt_ras_rreq_realtime_rd_buf_set(struct bt_conn *conn, struct net_buf_simple *ranging_data_out)
+{
+	struct bt_ras_rreq *rreq = ras_rreq_find(conn);
+
+	if (!rreq || !ranging_data_out) {
+		return -EINVAL;
+	}
+
+	if (!rreq->real_time_rd.data_cb) {
+		return -EACCES;
+	}
+
+	/* Buffer must not be changed in the middle of ranging data reception. */
+	if (rreq->next_expected_segment_counter != 0) {
+		return -EBUSY;
+	}
+
+	net_buf_simple_reset(ranging_data_out);
+	rreq->real_time_rd.ranging_data_out = ranging_data_out;
+
+	return 0;
+}
+
 int bt_ras_rreq_realtime_rd_unsubscribe(struct bt_conn *conn)
 {
 	int err;
@@ -601,3 +601,102 @@ int read_variable_data(enum variable_data_type data_type, uint8_t *buf, uint32_t
 }
 
 #endif /* CONFIG_BUILD_WITH_TFM */
+
+#if defined(CONFIG_SB_VALIDATION_MARKER)
+
+#define MARKER ((const volatile struct bl_validation_marker *)(PM_B0_MARKER_ADDRESS))
+#define MARKER_WORDS (sizeof(struct bl_validation_marker) / sizeof(uint32_t))
+#define MARKER_TALLY ((const volatile uint32_t *)(PM_B0_MARKER_ADDRESS + \
+						  sizeof(struct bl_validation_marker)))
+#define MARKER_TALLY_LEN CONFIG_SB_VALIDATION_MARKER_REVALIDATE_INTERVAL
+#define MARKER_USED_SIZE (sizeof(struct bl_validation_marker) + \
+			  MARKER_TALLY_LEN * sizeof(uint32_t))
+#define TALLY_FREE 0xFFFFFFFF
+#define TALLY_USED 0
+
+BUILD_ASSERT(sizeof(struct bl_validation_marker) % sizeof(uint32_t) == 0);
+BUILD_ASSERT(MARKER_USED_SIZE <= PM_B0_MARKER_SIZE,
+	     "The b0_marker partition is too small for the boot tally.");
+
+const struct bl_validation_marker *bl_validation_marker_get(void)
+{
+	if (MARKER->magic != BL_VALIDATION_MARKER_MAGIC) {
+		return NULL;
+	}
+
+	return (const struct bl_validation_marker *)MARKER;
+}
+
+void bl_validation_marker_erase(void)
+{
+#if defined(CONFIG_NRFX_NVMC)
+	const uint32_t page_size = nrfx_nvmc_flash_page_size_get();
+
+	for (uint32_t address = PM_B0_MARKER_ADDRESS;
+	     address < (PM_B0_MARKER_ADDRESS + MARKER_USED_SIZE);
+	     address += page_size) {
+		(void)nrfx_nvmc_page_erase(address);
+	}
+#elif defined(CONFIG_NRFX_RRAMC)
+	/* RRAM does not need to be erased before writing, so only the words
+	 * in use are reset.
+	 */
+	for (uint32_t address = PM_B0_MARKER_ADDRESS;
+	     address < (PM_B0_MARKER_ADDRESS + MARKER_USED_SIZE);
+	     address += sizeof(uint32_t)) {
+		nrfx_rramc_word_write(address, TALLY_FREE);
+	}
+#endif
+}
+
+int bl_validation_marker_write(const struct bl_validation_marker *marker)
+{
+	const uint32_t *src = (const uint32_t *)marker;
+	const volatile uint32_t *dst = (const volatile uint32_t *)MARKER;
+
+	if (marker == NULL) {
+		return -EINVAL;
+	}
+
+	bl_validation_marker_erase();
+
+	/* The magic is the first word and is written after the rest of the
+	 * marker has been written and verified.
+	 */
+	for (size_t i = 1; i < MARKER_WORDS; i++) {
+		bl_storage_word_write((uint32_t)&dst[i], src[i]);
+		if (dst[i] != src[i]) {
+			return -EIO;
+		}
+	}
+
+	bl_storage_word_write((uint32_t)&dst[0], BL_VALIDATION_MARKER_MAGIC);
+
+	return (dst[0] == BL_VALIDATION_MARKER_MAGIC) ? 0 : -EIO;
+}
+
+uint32_t bl_validation_marker_boots_get(void)
+{
+	uint32_t boots = 0;
+
+	while ((boots < MARKER_TALLY_LEN) && (MARKER_TALLY[boots] != TALLY_FREE)) {
+		boots++;
+	}
+
+	return boots;
+}
+
+int bl_validation_marker_boot_add(void)
+{
+	const uint32_t boots = bl_validation_marker_boots_get();
+
+	if (boots >= MARKER_TALLY_LEN) {
+		return -ENOMEM;
+	}
+
+	bl_storage_word_write((uint32_t)&MARKER_TALLY[boots], TALLY_USED);
+
+	return 0;
+}
+
+#endif /* CONFIG_SB_VALIDATION_MARKER */
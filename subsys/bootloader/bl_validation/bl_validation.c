@@ -119,6 +119,9 @@ bool bl_validate_firmware(uint32_t fw_dst_address, uint32_t fw_src_address)
 #include <zephyr/toolchain.h>
 #include <bl_crypto.h>
 #include "bl_validation_internal.h"
+#if defined(CONFIG_SB_VALIDATION_TIMING)
+#include <nrf.h>
+#endif
 
 #if USE_PARTITION_MANAGER
 #include <pm_config.h>
@@ -215,7 +218,7 @@ validation_info_find(uint32_t start_address, uint32_t search_distance)
 #if defined(CONFIG_SB_VALIDATE_FW_SIGNATURE)
 static bool validate_signature(const uint32_t fw_src_address, const uint32_t fw_size,
 			       const struct fw_validation_info *fw_val_info,
-			       bool external)
+			       bool external, uint32_t *key_idx)
 {
 	int init_retval = bl_crypto_init();
 
@@ -288,6 +291,9 @@ static bool validate_signature(const uint32_t fw_src_address, const uint32_t fw_
 			if (!external) {
 				LOG_INF("Firmware signature verified.");
 			}
+			if (key_idx != NULL) {
+				*key_idx = key_data_idx;
+			}
 			return true;
 		} else if (retval == -EHASHINV) {
 			if (!external) {
@@ -322,6 +328,112 @@ static bool validate_signature(const uint32_t fw_src_address, const uint32_t fw_
 }
 
 
+#if defined(CONFIG_SB_VALIDATION_MARKER)
+static const char *const marker_result_str[] = {
+	[MARKER_USABLE] = "marker usable",
+	[MARKER_MISSING] = "no validation marker",
+	[MARKER_MISMATCH] = "marker belongs to another image",
+	[MARKER_COUNTER_CHANGED] = "monotonic counter changed",
+	[MARKER_KEY_INVALIDATED] = "public key invalidated",
+	[MARKER_REVALIDATE] = "periodic full validation",
+};
+
+static bool image_digest(uint32_t fw_address, uint32_t fw_size, uint8_t *digest)
+{
+	bl_sha256_ctx_t ctx;
+
+	return (bl_sha256_init(&ctx) == 0) &&
+	       (bl_sha256_update(&ctx, (const uint8_t *)fw_address, fw_size) == 0) &&
+	       (bl_sha256_finalize(&ctx, digest) == 0);
+}
+
+static bool marker_key_valid(uint32_t key_idx)
+{
+	/* Some key data storage backends require word sized reads. */
+	__aligned(4) uint8_t key_data[SB_PUBLIC_KEY_HASH_LEN];
+
+	return (public_key_data_read(key_idx, key_data) == SB_PUBLIC_KEY_HASH_LEN);
+}
+
+/* Validate the image against the validation marker if the marker was written
+ * for this image, and do the full signature validation otherwise. The
+ * structural checks of validate_firmware() are done in both cases, only the
+ * signature verification is replaced by comparing the image digest with the
+ * digest of the image that passed it.
+ *
+ * @p counter is the current monotonic counter value, and @p counter_after is
+ * the value it will have after the image is booted.
+ */
+static bool validate_with_marker(uint32_t fw_address, const struct fw_info *fwinfo,
+				 const struct fw_validation_info *fw_val_info,
+				 uint32_t counter, uint32_t counter_after)
+{
+	const struct bl_validation_marker *stored = bl_validation_marker_get();
+	const struct marker_binding image = {
+		.fw_address = fw_address,
+		.fw_size = fwinfo->size,
+		.fw_version = fwinfo->version,
+		.counter = counter,
+	};
+	struct marker_binding binding;
+	struct bl_validation_marker marker;
+	enum marker_result result;
+	int err;
+
+	if (stored != NULL) {
+		binding.fw_address = stored->fw_address;
+		binding.fw_size = stored->fw_size;
+		binding.fw_version = stored->fw_version;
+		binding.counter = stored->counter;
+	}
+
+	result = marker_check((stored != NULL) ? &binding : NULL, &image,
+			      (stored != NULL) && marker_key_valid(stored->key_idx),
+			      bl_validation_marker_boots_get(),
+			      CONFIG_SB_VALIDATION_MARKER_REVALIDATE_INTERVAL);
+
+	err = bl_crypto_init();
+	if (err) {
+		LOG_ERR("bl_crypto_init() returned %d.", err);
+		return false;
+	}
+
+	if (!image_digest(fw_address, fwinfo->size, marker.digest)) {
+		LOG_ERR("Failed to calculate the firmware digest.");
+		return false;
+	}
+
+	if (result == MARKER_USABLE) {
+		if (memcmp(marker.digest, stored->digest, sizeof(marker.digest)) == 0) {
+			(void)bl_validation_marker_boot_add();
+			LOG_INF("Firmware digest matches the validation marker.");
+			return true;
+		}
+
+		LOG_INF("Full validation: firmware digest changed.");
+	} else {
+		LOG_INF("Full validation: %s.", marker_result_str[result]);
+	}
+
+	if (!validate_signature(fw_address, fwinfo->size, fw_val_info, false,
+				&marker.key_idx)) {
+		return false;
+	}
+
+	marker.fw_address = fw_address;
+	marker.fw_size = fwinfo->size;
+	marker.fw_version = fwinfo->version;
+	marker.counter = counter_after;
+
+	err = bl_validation_marker_write(&marker);
+	if (err) {
+		LOG_WRN("Failed to write the validation marker: %d.", err);
+	}
+
+	return true;
+}
+#endif /* CONFIG_SB_VALIDATION_MARKER */
+
 #elif defined(CONFIG_SB_VALIDATE_FW_HASH)
 static bool validate_hash(const uint32_t fw_src_address, const uint32_t fw_size,
 			  const struct fw_validation_info *fw_val_info,
@@ -501,9 +613,20 @@ static bool validate_firmware(uint32_t fw_dst_address, uint32_t fw_src_address,
 		return false;
 	}
 
+#if defined(CONFIG_SB_VALIDATION_MARKER)
+	if (!external) {
+		/* The counter is updated to the image version after the image
+		 * is validated, unless the counter is disabled.
+		 */
+		return validate_with_marker(fw_src_address, fwinfo, fw_val_info,
+					    stored_version,
+					    err ? 0 : MAX(stored_version, fwinfo->version));
+	}
+#endif
+
 #if defined(CONFIG_SB_VALIDATE_FW_SIGNATURE)
 	return validate_signature(fw_src_address, fwinfo->size, fw_val_info,
-				external);
+				external, NULL);
 #elif defined(CONFIG_SB_VALIDATE_FW_HASH)
 	return validate_hash(fw_src_address, fwinfo->size, fw_val_info,
 				external);
@@ -520,9 +643,28 @@ bool bl_validate_firmware(uint32_t fw_dst_address, uint32_t fw_src_address)
 }
 
 
+#if defined(CONFIG_SB_VALIDATION_TIMING)
+static void cycle_counter_start(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+#endif
+
 bool bl_validate_firmware_local(uint32_t fw_address, const struct fw_info *fwinfo)
 {
+#if defined(CONFIG_SB_VALIDATION_TIMING)
+	bool valid;
+
+	cycle_counter_start();
+	valid = validate_firmware(fw_address, fw_address, fwinfo, false);
+	LOG_INF("Validation took %u us.", DWT->CYCCNT / (SystemCoreClock / 1000000));
+
+	return valid;
+#else
 	return validate_firmware(fw_address, fw_address, fwinfo, false);
+#endif
 }
 #endif
 
@@ -11,6 +11,7 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
 #include <zephyr/types.h>
 
 
@@ -43,6 +44,55 @@ static bool region_within(uint32_t inner_start, uint32_t inner_end,
 	return true;
 }
 
+/* Image properties that a validation marker is bound to. */
+struct marker_binding {
+	uint32_t fw_address;
+	uint32_t fw_size;
+	uint32_t fw_version;
+	uint32_t counter;
+};
+
+enum marker_result {
+	/* The image digest can be checked against the marker. */
+	MARKER_USABLE,
+	MARKER_MISSING,
+	/* The marker belongs to another image. */
+	MARKER_MISMATCH,
+	MARKER_COUNTER_CHANGED,
+	MARKER_KEY_INVALIDATED,
+	/* The marker has been used for the configured number of boots. */
+	MARKER_REVALIDATE,
+};
+
+/* Decide whether the validation marker can replace the signature
+ * verification. @p marker is NULL if no marker is written. An
+ * @p interval of 0 disables the periodic full validation.
+ */
+static inline enum marker_result marker_check(const struct marker_binding *marker,
+					      const struct marker_binding *image,
+					      bool key_valid, uint32_t boots,
+					      uint32_t interval)
+{
+	if (marker == NULL) {
+		return MARKER_MISSING;
+	}
+	if ((marker->fw_address != image->fw_address) ||
+	    (marker->fw_size != image->fw_size) ||
+	    (marker->fw_version != image->fw_version)) {
+		return MARKER_MISMATCH;
+	}
+	if (marker->counter != image->counter) {
+		return MARKER_COUNTER_CHANGED;
+	}
+	if (!key_valid) {
+		return MARKER_KEY_INVALIDATED;
+	}
+	if ((interval != 0) && (boots >= interval)) {
+		return MARKER_REVALIDATE;
+	}
+	return MARKER_USABLE;
+}
+
 #ifdef __cplusplus
 }
 #endif
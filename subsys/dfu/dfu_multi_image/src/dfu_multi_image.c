@@ -5,10 +5,16 @@
  */
 
 #include <dfu/dfu_multi_image.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/sys/byteorder.h>
 #include <zephyr/sys/util.h>
 #include <zcbor_decode.h>
 
+#if defined(CONFIG_DFU_MULTI_IMAGE_SHA256)
+#include <mbedtls/sha256.h>
+#endif
+
 #include <errno.h>
 #include <string.h>
 
@@ -27,6 +33,41 @@ struct header {
 	size_t image_count;
 };
 
+enum stats_time {
+	STATS_TIME_TOTAL,
+	STATS_TIME_WRITE,
+	STATS_TIME_HASH,
+	STATS_TIME_STALL,
+	STATS_TIME_COUNT,
+};
+
+#if defined(CONFIG_DFU_MULTI_IMAGE_STATS)
+struct image_stats {
+	size_t bytes_written;
+	int64_t open_time;
+	/* Accumulated times, in system ticks */
+	int64_t times[STATS_TIME_COUNT];
+	bool opened;
+	bool closed;
+};
+#endif
+
+/* Writer state of a single image. With the pipeline enabled, it is only
+ * accessed by the pipeline thread.
+ */
+struct image_state {
+	bool opened;
+	bool closed;
+#if defined(CONFIG_DFU_MULTI_IMAGE_SHA256)
+	bool digest_valid;
+	mbedtls_sha256_context sha256_ctx;
+	uint8_t digest[DFU_MULTI_IMAGE_SHA256_LEN];
+#endif
+#if defined(CONFIG_DFU_MULTI_IMAGE_STATS)
+	struct image_stats stats;
+#endif
+};
+
 struct dfu_multi_image_ctx {
 	/* User configuration */
 	uint8_t *buffer;
@@ -36,6 +77,7 @@ struct dfu_multi_image_ctx {
 
 	/* Parsed header */
 	struct header header;
+	struct image_state images[CONFIG_DFU_MULTI_IMAGE_MAX_IMAGE_COUNT];
 
 	/* Current parser state */
 	int cur_image_no;
@@ -46,6 +88,67 @@ struct dfu_multi_image_ctx {
 
 static struct dfu_multi_image_ctx ctx;
 
+#if defined(CONFIG_DFU_MULTI_IMAGE_STATS)
+static struct k_spinlock stats_lock;
+
+static void stats_open(int image_no)
+{
+	struct image_stats *stats = &ctx.images[image_no].stats;
+
+	K_SPINLOCK(&stats_lock) {
+		stats->open_time = k_uptime_ticks();
+		stats->opened = true;
+	}
+}
+
+static void stats_close(int image_no)
+{
+	struct image_stats *stats = &ctx.images[image_no].stats;
+
+	K_SPINLOCK(&stats_lock) {
+		if (stats->opened && !stats->closed) {
+			stats->times[STATS_TIME_TOTAL] = k_uptime_ticks() - stats->open_time;
+			stats->closed = true;
+		}
+	}
+}
+
+static void stats_time_add(int image_no, enum stats_time type, int64_t start)
+{
+	struct image_stats *stats = &ctx.images[image_no].stats;
+	int64_t duration = k_uptime_ticks() - start;
+
+	K_SPINLOCK(&stats_lock) {
+		stats->times[type] += duration;
+	}
+}
+
+static void stats_bytes_add(int image_no, size_t bytes)
+{
+	struct image_stats *stats = &ctx.images[image_no].stats;
+
+	K_SPINLOCK(&stats_lock) {
+		stats->bytes_written += bytes;
+	}
+}
+#else
+static inline void stats_open(int image_no)
+{
+}
+
+static inline void stats_close(int image_no)
+{
+}
+
+static inline void stats_time_add(int image_no, enum stats_time type, int64_t start)
+{
+}
+
+static inline void stats_bytes_add(int image_no, size_t bytes)
+{
+}
+#endif /* CONFIG_DFU_MULTI_IMAGE_STATS */
+
 static int parse_fixed_header(void)
 {
 	ctx.cur_item_size += sys_get_le16(ctx.buffer);
@@ -94,10 +197,10 @@ static int parse_cbor_header(void)
 	return 0;
 }
 
-static const struct dfu_image_writer *current_image_writer(void)
+static const struct dfu_image_writer *image_writer(int image_no)
 {
-	if (ctx.cur_image_no >= 0 && (size_t)ctx.cur_image_no < ctx.header.image_count) {
-		const int image_id = ctx.header.images[ctx.cur_image_no].id;
+	if (image_no >= 0 && (size_t)image_no < ctx.header.image_count) {
+		const int image_id = ctx.header.images[image_no].id;
 
 		for (size_t i = 0; i < ctx.writer_count; i++) {
 			if (ctx.writers[i].image_id == image_id) {
@@ -109,6 +212,277 @@ static const struct dfu_image_writer *current_image_writer(void)
 	return NULL;
 }
 
+static const struct dfu_image_writer *current_image_writer(void)
+{
+	return image_writer(ctx.cur_image_no);
+}
+
+static int image_open(int image_no)
+{
+	const struct dfu_image_writer *writer = image_writer(image_no);
+	struct image_state *state = &ctx.images[image_no];
+	int err;
+
+	stats_open(image_no);
+
+	err = writer->open(writer->image_id, ctx.header.images[image_no].size);
+
+	if (err) {
+		return err;
+	}
+
+	state->opened = true;
+
+#if defined(CONFIG_DFU_MULTI_IMAGE_SHA256)
+	mbedtls_sha256_init(&state->sha256_ctx);
+
+	if (mbedtls_sha256_starts(&state->sha256_ctx, false) != 0) {
+		return -EIO;
+	}
+#endif
+
+	return 0;
+}
+
+static int image_write(int image_no, const uint8_t *chunk, size_t chunk_size)
+{
+	const struct dfu_image_writer *writer = image_writer(image_no);
+	int64_t start;
+	int err;
+
+#if defined(CONFIG_DFU_MULTI_IMAGE_SHA256)
+	struct image_state *state = &ctx.images[image_no];
+
+	start = k_uptime_ticks();
+
+	if (mbedtls_sha256_update(&state->sha256_ctx, chunk, chunk_size) != 0) {
+		return -EIO;
+	}
+
+	stats_time_add(image_no, STATS_TIME_HASH, start);
+#endif
+
+	start = k_uptime_ticks();
+	err = writer->write(chunk, chunk_size);
+	stats_time_add(image_no, STATS_TIME_WRITE, start);
+
+	if (!err) {
+		stats_bytes_add(image_no, chunk_size);
+	}
+
+	return err;
+}
+
+/* Finalize the digest of a fully written image and compare it with the expected one. */
+static int image_verify(int image_no)
+{
+#if defined(CONFIG_DFU_MULTI_IMAGE_SHA256)
+	const struct dfu_image_writer *writer = image_writer(image_no);
+	struct image_state *state = &ctx.images[image_no];
+
+	if (mbedtls_sha256_finish(&state->sha256_ctx, state->digest) != 0) {
+		return -EIO;
+	}
+
+	state->digest_valid = true;
+
+	if (writer->sha256 != NULL &&
+	    memcmp(writer->sha256, state->digest, DFU_MULTI_IMAGE_SHA256_LEN) != 0) {
+		return -EBADMSG;
+	}
+#endif
+
+	return 0;
+}
+
+/* Close an opened image. Every image is closed only once, either after its last byte
+ * is written or when the whole update is done.
+ */
+static int image_close(int image_no, bool success)
+{
+	const struct dfu_image_writer *writer = image_writer(image_no);
+	struct image_state *state = &ctx.images[image_no];
+
+	if (!state->opened || state->closed) {
+		return 0;
+	}
+
+#if defined(CONFIG_DFU_MULTI_IMAGE_SHA256)
+	mbedtls_sha256_free(&state->sha256_ctx);
+#endif
+	state->closed = true;
+
+	stats_close(image_no);
+
+	return writer->close(success);
+}
+
+/* Pass a chunk of image data to the image writer, opening the image before
+ * its first byte and verifying and closing it after its last byte.
+ */
+static int write_image_data(int image_no, const uint8_t *chunk, size_t chunk_size, bool first,
+			    bool last)
+{
+	int err = 0;
+	int close_err;
+
+	if (first) {
+		err = image_open(image_no);
+	}
+
+	if (!err) {
+		err = image_write(image_no, chunk, chunk_size);
+	}
+
+	if (!err && last) {
+		err = image_verify(image_no);
+		close_err = image_close(image_no, err == 0);
+		err = err ? err : close_err;
+	}
+
+	return err;
+}
+
+#if defined(CONFIG_DFU_MULTI_IMAGE_PIPELINE)
+#define PIPELINE_BUF_SIZE CONFIG_DFU_MULTI_IMAGE_PIPELINE_BUF_SIZE
+#define PIPELINE_BUF_COUNT CONFIG_DFU_MULTI_IMAGE_PIPELINE_BUF_COUNT
+
+struct pipeline_item {
+	uint8_t *buf;
+	size_t len;
+	int image_no;
+	bool first;
+	bool last;
+};
+
+K_MEM_SLAB_DEFINE_STATIC(pipeline_slab, PIPELINE_BUF_SIZE, PIPELINE_BUF_COUNT, 4);
+/* Every queued item holds a buffer, so putting an item never blocks. */
+K_MSGQ_DEFINE(pipeline_msgq, sizeof(struct pipeline_item), PIPELINE_BUF_COUNT, 4);
+static K_SEM_DEFINE(pipeline_done_sem, 0, K_SEM_MAX_LIMIT);
+
+static struct {
+	/* Buffer being filled with the image data */
+	struct pipeline_item item;
+	/* Number of queued items */
+	atomic_t pending;
+	/* First error returned by the image writers */
+	atomic_t err;
+} pipeline;
+
+static void pipeline_submit(void)
+{
+	atomic_inc(&pipeline.pending);
+	(void)k_msgq_put(&pipeline_msgq, &pipeline.item, K_FOREVER);
+	pipeline.item.buf = NULL;
+}
+
+/* Copy image data of the current item to the pipeline buffer and queue the buffer when it
+ * is full or contains the last byte of the image.
+ *
+ * Returns the number of bytes consumed or a negative error code.
+ */
+static int pipeline_put(const uint8_t *chunk, size_t chunk_size)
+{
+	struct pipeline_item *item = &pipeline.item;
+	int err = (int)atomic_get(&pipeline.err);
+	int64_t start;
+
+	if (err) {
+		return err;
+	}
+
+	if (item->buf == NULL) {
+		start = k_uptime_ticks();
+		err = k_mem_slab_alloc(&pipeline_slab, (void **)&item->buf, K_FOREVER);
+		stats_time_add(ctx.cur_image_no, STATS_TIME_STALL, start);
+
+		if (err) {
+			return err;
+		}
+
+		item->len = 0;
+		item->image_no = ctx.cur_image_no;
+		item->first = (ctx.cur_item_offset == 0);
+	}
+
+	chunk_size = MIN(chunk_size, PIPELINE_BUF_SIZE - item->len);
+	memcpy(item->buf + item->len, chunk, chunk_size);
+	item->len += chunk_size;
+	item->last = (ctx.cur_item_offset + chunk_size == ctx.cur_item_size);
+
+	if (item->last || item->len == PIPELINE_BUF_SIZE) {
+		pipeline_submit();
+	}
+
+	return chunk_size;
+}
+
+static void pipeline_wait(void)
+{
+	while (atomic_get(&pipeline.pending) != 0) {
+		k_sem_take(&pipeline_done_sem, K_FOREVER);
+	}
+}
+
+/* Queue the partially filled buffer and wait until all queued data is written. */
+static int pipeline_flush(void)
+{
+	if (pipeline.item.buf != NULL) {
+		pipeline_submit();
+	}
+
+	pipeline_wait();
+
+	return (int)atomic_get(&pipeline.err);
+}
+
+/* Drop the image data of a previous package that has not been written yet. */
+static void pipeline_reset(void)
+{
+	if (pipeline.item.buf != NULL) {
+		k_mem_slab_free(&pipeline_slab, pipeline.item.buf);
+		pipeline.item.buf = NULL;
+	}
+
+	atomic_set(&pipeline.err, -ECANCELED);
+	pipeline_wait();
+	atomic_set(&pipeline.err, 0);
+	k_sem_reset(&pipeline_done_sem);
+}
+
+static void pipeline_thread(void *p1, void *p2, void *p3)
+{
+	struct pipeline_item item;
+	int err;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_msgq_get(&pipeline_msgq, &item, K_FOREVER);
+
+		/* After a failure, only release the buffers */
+		if (atomic_get(&pipeline.err) == 0) {
+			err = write_image_data(item.image_no, item.buf, item.len, item.first,
+					       item.last);
+
+			if (err) {
+				atomic_cas(&pipeline.err, 0, err);
+			}
+		}
+
+		k_mem_slab_free(&pipeline_slab, item.buf);
+		atomic_dec(&pipeline.pending);
+		k_sem_give(&pipeline_done_sem);
+	}
+}
+
+K_THREAD_DEFINE(dfu_multi_image_pipeline, CONFIG_DFU_MULTI_IMAGE_PIPELINE_STACK_SIZE,
+		pipeline_thread, NULL, NULL, NULL, CONFIG_DFU_MULTI_IMAGE_PIPELINE_THREAD_PRIO, 0,
+		0);
+#endif /* CONFIG_DFU_MULTI_IMAGE_PIPELINE */
+
 static void select_next_image(void)
 {
 	ctx.cur_item_offset = 0;
@@ -148,18 +522,22 @@ static int process_current_item(const uint8_t *chunk, size_t chunk_size)
 			err = -ESPIPE;
 		}
 
-		if (!err && ctx.cur_item_offset == 0) {
-			err = writer->open(writer->image_id,
-					   ctx.header.images[ctx.cur_image_no].size);
-		}
-
+#if defined(CONFIG_DFU_MULTI_IMAGE_PIPELINE)
 		if (!err) {
-			err = writer->write(chunk, chunk_size);
+			err = pipeline_put(chunk, chunk_size);
 		}
 
-		if (!err && ctx.cur_item_offset + chunk_size == ctx.cur_item_size) {
-			err = writer->close(true);
+		if (err > 0) {
+			chunk_size = (size_t)err;
+			err = 0;
 		}
+#else
+		if (!err) {
+			err = write_image_data(ctx.cur_image_no, chunk, chunk_size,
+					       ctx.cur_item_offset == 0,
+					       ctx.cur_item_offset + chunk_size == ctx.cur_item_size);
+		}
+#endif
 	}
 
 	if (err) {
@@ -182,6 +560,10 @@ int dfu_multi_image_init(uint8_t *buffer, size_t buffer_size)
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_DFU_MULTI_IMAGE_PIPELINE)
+	pipeline_reset();
+#endif
+
 	memset(&ctx, 0, sizeof(ctx));
 	ctx.buffer = buffer;
 	ctx.buffer_size = buffer_size;
@@ -239,12 +621,24 @@ size_t dfu_multi_image_offset(void)
 
 int dfu_multi_image_done(bool success)
 {
-	const struct dfu_image_writer *writer = current_image_writer();
 	int err = 0;
+	int close_err;
 
-	/* Close any active writer if such exists */
-	if (writer != NULL) {
-		err = writer->close(success);
+#if defined(CONFIG_DFU_MULTI_IMAGE_PIPELINE)
+	/* Wait for the queued image data to be written */
+	err = pipeline_flush();
+
+	if (err) {
+		success = false;
+	}
+#endif
+
+	/* Close the images that are still open. With the pipeline enabled, this may be
+	 * an image that failed to be written after the parser moved on to the next one.
+	 */
+	for (size_t i = 0; i < ctx.header.image_count; i++) {
+		close_err = image_close(i, success);
+		err = err ? err : close_err;
 	}
 
 	/* On success, verify that all images have been fully written */
@@ -254,3 +648,83 @@ int dfu_multi_image_done(bool success)
 
 	return err;
 }
+
+static int find_image_no(int image_id)
+{
+	for (size_t i = 0; i < ctx.header.image_count; i++) {
+		if (ctx.header.images[i].id == image_id) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+int dfu_multi_image_digest_get(int image_id, uint8_t *digest)
+{
+#if defined(CONFIG_DFU_MULTI_IMAGE_SHA256)
+	int image_no;
+
+	if (digest == NULL) {
+		return -EINVAL;
+	}
+
+	image_no = find_image_no(image_id);
+
+	if (image_no < 0 || !ctx.images[image_no].digest_valid) {
+		return -ENOENT;
+	}
+
+	memcpy(digest, ctx.images[image_no].digest, DFU_MULTI_IMAGE_SHA256_LEN);
+
+	return 0;
+#else
+	ARG_UNUSED(image_id);
+	ARG_UNUSED(digest);
+
+	return -ENOTSUP;
+#endif
+}
+
+int dfu_multi_image_stats_get(int image_id, struct dfu_multi_image_stats *stats)
+{
+#if defined(CONFIG_DFU_MULTI_IMAGE_STATS)
+	struct image_stats image_stats;
+	int image_no;
+
+	if (stats == NULL) {
+		return -EINVAL;
+	}
+
+	image_no = find_image_no(image_id);
+
+	if (image_no < 0) {
+		return -ENOENT;
+	}
+
+	K_SPINLOCK(&stats_lock) {
+		image_stats = ctx.images[image_no].stats;
+	}
+
+	if (!image_stats.opened) {
+		return -ENOENT;
+	}
+
+	if (!image_stats.closed) {
+		image_stats.times[STATS_TIME_TOTAL] = k_uptime_ticks() - image_stats.open_time;
+	}
+
+	stats->bytes_written = image_stats.bytes_written;
+	stats->total_time_us = k_ticks_to_us_floor32(image_stats.times[STATS_TIME_TOTAL]);
+	stats->write_time_us = k_ticks_to_us_floor32(image_stats.times[STATS_TIME_WRITE]);
+	stats->hash_time_us = k_ticks_to_us_floor32(image_stats.times[STATS_TIME_HASH]);
+	stats->stall_time_us = k_ticks_to_us_floor32(image_stats.times[STATS_TIME_STALL]);
+
+	return 0;
+#else
+	ARG_UNUSED(image_id);
+	ARG_UNUSED(stats);
+
+	return -ENOTSUP;
+#endif
+}
@@ -9,6 +9,8 @@
 #include "emds_flash.h"
 
 #include <zephyr/drivers/flash.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/sys/crc.h>
 
 #include <zephyr/logging/log.h>
@@ -81,6 +83,23 @@ enum emds_state {
 static enum emds_state emds_state = EMDS_STATE_NOT_INITIALIZED;
 static struct emds_snapshot_candidate freshest_snapshot;
 static struct emds_snapshot_candidate allocated_snapshot;
+static bool delta_allocated;
+
+/* The full snapshot the freshest snapshot is built on and the number of deltas on top of it */
+static uint32_t chain_base_cnt;
+static uint32_t chain_len;
+
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+static ATOMIC_DEFINE(dirty_entries, CONFIG_EMDS_DELTA_ENTRIES_MAX);
+/* Size of the entries marked in dirty_entries */
+static atomic_t dirty_bytes;
+static bool compacting;
+static bool compact_pending;
+static int compact_rc;
+
+static void emds_compact_work_handler(struct k_work *work);
+static K_WORK_DEFINE(compact_work, emds_compact_work_handler);
+#endif
 
 static sys_slist_t emds_dynamic_entries;
 static struct emds_partition partition[PARTITIONS_NUM_MAX];
@@ -155,6 +174,12 @@ int emds_init(emds_store_cb_t cb)
 		return -EINVAL;
 	}
 
+	if (IS_ENABLED(CONFIG_EMDS_DELTA_SNAPSHOTS) &&
+	    CHUNK_SIZE % partition[0].fp->write_block_size) {
+		LOG_ERR("Write block size is not supported for compaction");
+		return -EINVAL;
+	}
+
 	emds_print_init_info();
 
 	sys_slist_init(&emds_dynamic_entries);
@@ -211,6 +236,114 @@ static int emds_entries_size(size_t *size)
 	return entries;
 }
 
+/* The dirty flag index of an entry is its index among the entries with dirty tracking */
+static struct emds_entry *emds_entry_get(uint16_t id, int *idx)
+{
+	*idx = 0;
+
+	STRUCT_SECTION_FOREACH(emds_entry, ch) {
+		if (ch->id == id) {
+			return ch;
+		}
+		*idx += ch->dirty_tracking;
+	}
+
+	struct emds_dynamic_entry *ch;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
+		if (ch->entry.id == id) {
+			return &ch->entry;
+		}
+		*idx += ch->entry.dirty_tracking;
+	}
+
+	return NULL;
+}
+
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+static bool emds_entry_is_tracked(const struct emds_entry *entry, int idx)
+{
+	return entry->dirty_tracking && idx < CONFIG_EMDS_DELTA_ENTRIES_MAX;
+}
+#endif
+
+static bool emds_entry_is_stored(const struct emds_entry *entry, int idx)
+{
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+	/* Entries without a dirty flag are stored in every delta snapshot */
+	return !delta_allocated || !emds_entry_is_tracked(entry, idx) ||
+	       atomic_test_bit(dirty_entries, idx);
+#else
+	return true;
+#endif
+}
+
+static void emds_entries_clean(void)
+{
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+	/* The size goes first, so that an entry marked in between is not left out of it */
+	atomic_clear(&dirty_bytes);
+
+	for (int i = 0; i < ATOMIC_BITMAP_SIZE(CONFIG_EMDS_DELTA_ENTRIES_MAX); i++) {
+		atomic_clear(&dirty_entries[i]);
+	}
+#endif
+}
+
+static size_t emds_stored_entries_size(void)
+{
+	size_t size = 0;
+	int idx = 0;
+
+	STRUCT_SECTION_FOREACH(emds_entry, ch) {
+		if (emds_entry_is_stored(ch, idx)) {
+			size += ch->len + sizeof(struct emds_data_entry);
+		}
+		idx += ch->dirty_tracking;
+	}
+
+	struct emds_dynamic_entry *ch;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
+		if (emds_entry_is_stored(&ch->entry, idx)) {
+			size += ch->entry.len + sizeof(struct emds_data_entry);
+		}
+		idx += ch->entry.dirty_tracking;
+	}
+
+	return size;
+}
+
+int emds_entry_dirty_set(uint16_t id)
+{
+	struct emds_entry *entry;
+	int idx;
+
+	if (emds_state == EMDS_STATE_NOT_INITIALIZED) {
+		return -ECANCELED;
+	}
+
+	entry = emds_entry_get(id, &idx);
+	if (!entry) {
+		return -ENOENT;
+	}
+
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+	size_t size = entry->len + sizeof(struct emds_data_entry);
+
+	if (!emds_entry_is_tracked(entry, idx) || atomic_test_and_set_bit(dirty_entries, idx)) {
+		return 0;
+	}
+
+	if (atomic_add(&dirty_bytes, size) + size > CONFIG_EMDS_DELTA_DIRTY_BYTES_MAX) {
+		LOG_DBG("Dirty entries exceed %u bytes", CONFIG_EMDS_DELTA_DIRTY_BYTES_MAX);
+		(void)k_work_submit(&compact_work);
+	}
+#endif
+
+	return 0;
+}
+
 int emds_store_size_get(size_t *store_size)
 {
 	if (emds_state == EMDS_STATE_NOT_INITIALIZED) {
@@ -227,6 +360,45 @@ bool emds_is_ready(void)
 	return emds_state == EMDS_STATE_READY;
 }
 
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+static size_t emds_delta_store_size_max(void)
+{
+	size_t untracked_size = 0;
+	size_t tracked_size = 0;
+	size_t tracked_max = 0;
+	size_t size;
+	int idx = 0;
+
+	STRUCT_SECTION_FOREACH(emds_entry, ch) {
+		size = ch->len + sizeof(struct emds_data_entry);
+		if (emds_entry_is_tracked(ch, idx)) {
+			tracked_size += size;
+			tracked_max = MAX(tracked_max, size);
+		} else {
+			untracked_size += size;
+		}
+		idx += ch->dirty_tracking;
+	}
+
+	struct emds_dynamic_entry *ch;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
+		size = ch->entry.len + sizeof(struct emds_data_entry);
+		if (emds_entry_is_tracked(&ch->entry, idx)) {
+			tracked_size += size;
+			tracked_max = MAX(tracked_max, size);
+		} else {
+			untracked_size += size;
+		}
+		idx += ch->entry.dirty_tracking;
+	}
+
+	/* The entry that exceeds the budget is stored until the compaction has started */
+	return untracked_size +
+	       MIN(tracked_size, CONFIG_EMDS_DELTA_DIRTY_BYTES_MAX + tracked_max);
+}
+#endif
+
 int emds_store_time_get(uint32_t *store_time)
 {
 	size_t store_size = 0;
@@ -239,6 +411,10 @@ int emds_store_time_get(uint32_t *store_time)
 		return rc;
 	}
 
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+	store_size = emds_delta_store_size_max();
+#endif
+
 	words = DIV_ROUND_UP(store_size, 4);
 	words += DIV_ROUND_UP(sizeof(struct emds_snapshot_metadata), 4);
 	chunk_handling = DIV_ROUND_UP(store_size, CHUNK_SIZE);
@@ -308,9 +484,61 @@ static int emds_read_data(const struct flash_area *fa, struct emds_snapshot_meta
 	return 0;
 }
 
+static int emds_chain_load(void)
+{
+	const struct emds_partition *part = &partition[freshest_snapshot.partition_index];
+	struct emds_snapshot_candidate snapshot;
+	uint32_t fresh_cnt = freshest_snapshot.metadata.fresh_cnt;
+	int rc;
+
+	chain_base_cnt = fresh_cnt;
+	chain_len = 0;
+
+	if (emds_flash_snapshot_is_delta(&freshest_snapshot.metadata)) {
+		chain_base_cnt = freshest_snapshot.metadata.base_cnt;
+		chain_len = fresh_cnt - chain_base_cnt;
+	}
+
+	if (chain_base_cnt == 0 || chain_base_cnt > fresh_cnt ||
+	    chain_len >= part->fa->fa_size / sizeof(struct emds_snapshot_metadata)) {
+		LOG_ERR("Invalid base snapshot %u for fresh_cnt %u", chain_base_cnt, fresh_cnt);
+		chain_len = UINT32_MAX;
+		return -EIO;
+	}
+
+	/* The full snapshot and its deltas occupy consecutive metadata slots. Apply them starting
+	 * from the full snapshot so that the later deltas overwrite the older data.
+	 */
+	for (uint32_t i = 0; i <= chain_len; i++) {
+		rc = emds_flash_snapshot_read(part,
+					      freshest_snapshot.metadata_off +
+						      (chain_len - i) *
+							      sizeof(struct emds_snapshot_metadata),
+					      &snapshot);
+		if (rc || snapshot.metadata.fresh_cnt != chain_base_cnt + i ||
+		    emds_flash_snapshot_is_delta(&snapshot.metadata) != (i > 0) ||
+		    (i > 0 && snapshot.metadata.base_cnt != chain_base_cnt)) {
+			LOG_ERR("Snapshot chain is broken at fresh_cnt %u", chain_base_cnt + i);
+			/* Force compaction on the next prepare */
+			chain_len = UINT32_MAX;
+
+			/* Keep the data of the base snapshot and the valid deltas on top of it */
+			return i > 0 ? 0 : -EIO;
+		}
+
+		rc = emds_read_data(part->fa, &snapshot.metadata);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
 int emds_load(void)
 {
 	struct emds_snapshot_candidate candidate = {0};
+	int rc;
 
 	if (emds_state == EMDS_STATE_NOT_INITIALIZED) {
 		return -ECANCELED;
@@ -338,25 +566,23 @@ int emds_load(void)
 	LOG_DBG("Found freshest snapshot in partition %d with fresh_cnt %u",
 		freshest_snapshot.partition_index, freshest_snapshot.metadata.fresh_cnt);
 
-	return emds_read_data(partition[freshest_snapshot.partition_index].fa,
-			      &freshest_snapshot.metadata);
+	rc = emds_chain_load();
+	if (rc == 0) {
+		/* The entries match the stored data now */
+		emds_entries_clean();
+	}
+
+	return rc;
 }
 
-int emds_prepare(void)
+static int emds_snapshot_allocate(size_t data_size)
 {
-	size_t data_size;
 	bool erase_enabled = false;
 	int idx = 0;
 	int freshest_partition_idx = -1;
 	int rc = 0;
 
-	if (emds_state != EMDS_STATE_SYNCHRONIZED) {
-		return -ECANCELED;
-	}
-
-	/* Returned status is not checked since initialization state is checked above */
-	(void)emds_store_size_get(&data_size);
-
+	delta_allocated = false;
 	allocated_snapshot.metadata.fresh_cnt = freshest_snapshot.metadata.fresh_cnt + 1;
 
 	/* First try to allocate snapshot in the same partition where freshest snapshot exists */
@@ -367,7 +593,6 @@ int emds_prepare(void)
 						  data_size);
 		if (rc == 0) {
 			allocated_snapshot.partition_index = freshest_partition_idx;
-			emds_state = EMDS_STATE_READY;
 			return 0;
 		}
 		rc = 0;
@@ -388,7 +613,6 @@ int emds_prepare(void)
 							  &allocated_snapshot, data_size);
 			if (rc == 0) {
 				allocated_snapshot.partition_index = idx;
-				emds_state = EMDS_STATE_READY;
 				return 0;
 			}
 		}
@@ -413,6 +637,32 @@ static void data_stream_pack(uint8_t *in, uint8_t *out, size_t *wp, size_t *rp,
 	*wp += size;
 }
 
+static void chunk_write(const struct emds_partition *partition, off_t data_off, uint8_t *chunk,
+			size_t len)
+{
+	allocated_snapshot.metadata.snapshot_crc =
+		crc32_k_4_2_update(allocated_snapshot.metadata.snapshot_crc, chunk, len);
+
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+	if (compacting) {
+		/* Compaction is not time-critical and goes through the flash driver, which
+		 * only accepts whole write blocks.
+		 */
+		size_t aligned_len = ROUND_UP(len, partition->fp->write_block_size);
+		int rc;
+
+		memset(&chunk[len], partition->fp->erase_value, aligned_len - len);
+		rc = flash_area_write(partition->fa, data_off, chunk, aligned_len);
+		if (rc && compact_rc == 0) {
+			compact_rc = rc;
+		}
+		return;
+	}
+#endif
+
+	emds_flash_write_data(partition, data_off, chunk, len);
+}
+
 static void data_to_stream(const struct emds_partition *partition, off_t *data_off, uint8_t *in,
 			   uint8_t *out, size_t *wp, size_t len)
 {
@@ -421,9 +671,7 @@ static void data_to_stream(const struct emds_partition *partition, off_t *data_o
 	while (rp != len) {
 		data_stream_pack(in, out, wp, &rp, len);
 		if (*wp == CHUNK_SIZE) {
-			allocated_snapshot.metadata.snapshot_crc = crc32_k_4_2_update(
-				allocated_snapshot.metadata.snapshot_crc, out, *wp);
-			emds_flash_write_data(partition, *data_off, out, *wp);
+			chunk_write(partition, *data_off, out, *wp);
 			*data_off += *wp;
 			*wp = 0;
 		}
@@ -443,18 +691,187 @@ static void entry_to_stream(const struct emds_partition *partition, off_t *data_
 	data_to_stream(partition, data_off, entry->data, out, wp, entry->len);
 }
 
+static void entries_to_stream(const struct emds_partition *partition, off_t *data_off,
+			      uint8_t *out, size_t *wp)
+{
+	int idx = 0;
+
+	STRUCT_SECTION_FOREACH(emds_entry, ch) {
+		if (emds_entry_is_stored(ch, idx)) {
+			entry_to_stream(partition, data_off, out, wp, ch);
+		}
+		idx += ch->dirty_tracking;
+	}
+
+	struct emds_dynamic_entry *ch;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
+		if (emds_entry_is_stored(&ch->entry, idx)) {
+			entry_to_stream(partition, data_off, out, wp, &ch->entry);
+		}
+		idx += ch->entry.dirty_tracking;
+	}
+}
+
 static void stream_fflush(const struct emds_partition *partition, off_t *data_off, uint8_t *out,
 			  size_t *wp)
 {
 	if (*wp > 0) {
-		allocated_snapshot.metadata.snapshot_crc =
-			crc32_k_4_2_update(allocated_snapshot.metadata.snapshot_crc, out, *wp);
-		emds_flash_write_data(partition, *data_off, out, *wp);
+		chunk_write(partition, *data_off, out, *wp);
 		*data_off += *wp;
 		*wp = 0;
 	}
 }
 
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+static int emds_delta_allocate(size_t data_size)
+{
+	int idx = freshest_snapshot.partition_index;
+	int rc;
+
+	if (freshest_snapshot.metadata.fresh_cnt == 0 ||
+	    chain_len >= CONFIG_EMDS_DELTA_CHAIN_MAX || compact_pending ||
+	    atomic_get(&dirty_bytes) > CONFIG_EMDS_DELTA_DIRTY_BYTES_MAX) {
+		return -ENOENT;
+	}
+
+	/* The delta is placed right behind the freshest snapshot to keep the chain in consecutive
+	 * metadata slots. Space is reserved for all entries since any of them may change before
+	 * the store.
+	 */
+	allocated_snapshot.metadata.fresh_cnt = freshest_snapshot.metadata.fresh_cnt + 1;
+	rc = emds_flash_allocate_snapshot(&partition[idx], &freshest_snapshot, &allocated_snapshot,
+					  data_size);
+	if (rc) {
+		return rc;
+	}
+
+	allocated_snapshot.partition_index = idx;
+	delta_allocated = true;
+
+	return 0;
+}
+
+static int emds_compact(void)
+{
+	const struct emds_partition *part = &partition[allocated_snapshot.partition_index];
+	uint8_t data_chunk[CHUNK_SIZE];
+	off_t data_off = allocated_snapshot.metadata.data_instance_off;
+	size_t wp = 0;
+	int rc;
+
+	LOG_DBG("Compacting %u delta snapshots into fresh_cnt %u", chain_len,
+		allocated_snapshot.metadata.fresh_cnt);
+
+	/* Entries marked while the data is copied are stored in the next delta. Until the
+	 * compaction succeeds, no delta can be chained on top of the old snapshot.
+	 */
+	compact_pending = true;
+	emds_entries_clean();
+
+	compacting = true;
+	compact_rc = 0;
+	entries_to_stream(part, &data_off, data_chunk, &wp);
+	stream_fflush(part, &data_off, data_chunk, &wp);
+	compacting = false;
+
+	if (compact_rc) {
+		LOG_ERR("Failed to write compacted snapshot: %d", compact_rc);
+		return compact_rc;
+	}
+
+	allocated_snapshot.metadata.base_cnt = 0;
+	allocated_snapshot.metadata.reserved = 0;
+
+	/* The metadata is written last, the snapshot is not valid until then */
+	rc = flash_area_write(part->fa, allocated_snapshot.metadata_off,
+			      &allocated_snapshot.metadata, sizeof(allocated_snapshot.metadata));
+	if (rc) {
+		LOG_ERR("Failed to write compacted snapshot metadata: %d", rc);
+		return rc;
+	}
+
+	freshest_snapshot = allocated_snapshot;
+	chain_base_cnt = freshest_snapshot.metadata.fresh_cnt;
+	chain_len = 0;
+	compact_pending = false;
+
+	return 0;
+}
+
+static void emds_compact_work_handler(struct k_work *work)
+{
+	unsigned int key;
+	int rc;
+
+	ARG_UNUSED(work);
+
+	key = irq_lock();
+	if (emds_state != EMDS_STATE_READY || !delta_allocated ||
+	    atomic_get(&dirty_bytes) <= CONFIG_EMDS_DELTA_DIRTY_BYTES_MAX) {
+		irq_unlock(key);
+		return;
+	}
+
+	/* The store is not available until the prepared delta is replaced */
+	emds_state = EMDS_STATE_SYNCHRONIZED;
+	delta_allocated = false;
+	irq_unlock(key);
+
+	rc = emds_prepare();
+	if (rc) {
+		LOG_ERR("Failed to compact delta snapshots: %d", rc);
+	}
+}
+#endif
+
+int emds_prepare(void)
+{
+	size_t data_size;
+	int rc;
+
+	if (emds_state != EMDS_STATE_SYNCHRONIZED) {
+		return -ECANCELED;
+	}
+
+	/* Returned status is not checked since initialization state is checked above */
+	(void)emds_store_size_get(&data_size);
+
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+	if (emds_delta_allocate(data_size) == 0) {
+		emds_state = EMDS_STATE_READY;
+		return 0;
+	}
+
+	/* Compact the chain into a new full snapshot while there is time for it, so the
+	 * emergency store only has to write the changed entries on top of it.
+	 */
+	rc = emds_snapshot_allocate(data_size);
+	if (rc) {
+		return rc;
+	}
+
+	rc = emds_compact();
+	if (rc) {
+		return rc;
+	}
+
+	if (emds_delta_allocate(data_size) == 0) {
+		emds_state = EMDS_STATE_READY;
+		return 0;
+	}
+#endif
+
+	rc = emds_snapshot_allocate(data_size);
+	if (rc) {
+		return rc;
+	}
+
+	emds_state = EMDS_STATE_READY;
+
+	return 0;
+}
+
 int emds_store(void)
 {
 	uint32_t store_key;
@@ -476,6 +893,11 @@ int emds_store(void)
 		goto unlock_and_exit;
 	}
 
+	if (delta_allocated) {
+		emds_flash_snapshot_delta_set(&allocated_snapshot.metadata, chain_base_cnt,
+					      emds_stored_entries_size());
+	}
+
 	if (flash_params_get_erase_cap(partition[idx].fp) & FLASH_ERASE_C_EXPLICIT) {
 		LOG_DBG("Writing metadata on offset: 0x%4lx, address : 0x%4lx",
 			 allocated_snapshot.metadata_off,
@@ -483,17 +905,16 @@ int emds_store(void)
 		emds_flash_write_data(&partition[idx], allocated_snapshot.metadata_off,
 				      &allocated_snapshot.metadata,
 				      offsetof(struct emds_snapshot_metadata, snapshot_crc));
-	}
 
-	STRUCT_SECTION_FOREACH(emds_entry, ch) {
-		entry_to_stream(&partition[idx], &data_off, data_chunk, &wp, ch);
+		if (delta_allocated) {
+			emds_flash_write_data(&partition[idx],
+					      allocated_snapshot.metadata_off +
+						      offsetof(struct emds_snapshot_metadata, base_cnt),
+					      &allocated_snapshot.metadata.base_cnt, sizeof(uint32_t));
+		}
 	}
 
-	struct emds_dynamic_entry *ch;
-
-	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
-		entry_to_stream(&partition[idx], &data_off, data_chunk, &wp, &ch->entry);
-	}
+	entries_to_stream(&partition[idx], &data_off, data_chunk, &wp);
 
 	stream_fflush(&partition[idx], &data_off, data_chunk, &wp);
 
@@ -513,11 +934,16 @@ int emds_store(void)
 			 allocated_snapshot.metadata.snapshot_crc);
 		emds_flash_write_data(&partition[idx], allocated_snapshot.metadata_off,
 				      &allocated_snapshot.metadata,
-				      offsetof(struct emds_snapshot_metadata, reserved));
+				      delta_allocated
+					      ? offsetof(struct emds_snapshot_metadata, reserved)
+					      : offsetof(struct emds_snapshot_metadata, base_cnt));
 	}
 
+	emds_entries_clean();
+
 unlock_and_exit:
 	emds_state = EMDS_STATE_INITIALIZED;
+	delta_allocated = false;
 	RESUME_POFWARN();
 	/* Unlock all interrupts */
 	irq_unlock(store_key);
@@ -541,6 +967,13 @@ int emds_clear(void)
 	emds_state = EMDS_STATE_INITIALIZED;
 	memset(&freshest_snapshot, 0, sizeof(freshest_snapshot));
 	memset(&allocated_snapshot, 0, sizeof(allocated_snapshot));
+	delta_allocated = false;
+	chain_base_cnt = 0;
+	chain_len = 0;
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+	(void)k_work_cancel(&compact_work);
+	compact_pending = false;
+#endif
 	for (int i = 0; i < PARTITIONS_NUM_MAX; i++) {
 		rc = emds_flash_erase_partition(&partition[i]);
 		if (rc) {
@@ -15,13 +15,31 @@ LOG_MODULE_REGISTER(emds_flash, CONFIG_EMDS_LOG_LEVEL);
 #if defined CONFIG_SOC_FLASH_NRF_RRAM
 #include <hal/nrf_rramc.h>
 #include <zephyr/sys/barrier.h>
-#else
+#define SOC_FLASH_DIRECT_WRITE 1
+#elif defined CONFIG_SOC_FLASH_NRF
 #include <nrfx_nvmc.h>
+#define SOC_FLASH_DIRECT_WRITE 1
 #endif
 
 #define SOC_NV_FLASH_NODE             DT_INST(0, soc_nv_flash)
 /* "EMDS" in ASCII */
 #define EMDS_SNAPSHOT_METADATA_MARKER 0x4D444553
+/* "EMDD" in ASCII */
+#define EMDS_SNAPSHOT_DELTA_MARKER    0x4D444544
+
+static uint32_t metadata_crc_get(const struct emds_snapshot_metadata *metadata)
+{
+	uint32_t crc = crc32_k_4_2_update(0, (const unsigned char *)metadata,
+					  offsetof(struct emds_snapshot_metadata, metadata_crc));
+
+	if (metadata->marker == EMDS_SNAPSHOT_DELTA_MARKER) {
+		/* The link to the base snapshot is a part of the delta snapshot metadata */
+		crc = crc32_k_4_2_update(crc, (const unsigned char *)&metadata->base_cnt,
+					 sizeof(metadata->base_cnt));
+	}
+
+	return crc;
+}
 
 static void cand_list_init(sys_slist_t *cand_list, struct emds_snapshot_candidate *cand_buf)
 {
@@ -95,6 +113,25 @@ static bool cand_snapshot_crc_check(const struct emds_partition *partition,
 	return crc == metadata->snapshot_crc;
 }
 
+#define SIM_FLASH_DEV_MATCH(node_id) || dev == DEVICE_DT_GET(node_id)
+
+static bool flash_driver_write_get(const struct device *dev)
+{
+#if !defined SOC_FLASH_DIRECT_WRITE
+	ARG_UNUSED(dev);
+
+	/* There is no SoC flash controller to write to directly */
+	return true;
+#elif defined CONFIG_FLASH_SIMULATOR
+	/* The simulated flash is only accessible through its driver */
+	return false DT_FOREACH_STATUS_OKAY(zephyr_sim_flash, SIM_FLASH_DEV_MATCH);
+#else
+	ARG_UNUSED(dev);
+
+	return false;
+#endif
+}
+
 static bool metadata_iterator(off_t *read_off, int cur_failures)
 {
 	*read_off -= sizeof(struct emds_snapshot_metadata);
@@ -120,6 +157,8 @@ int emds_flash_init(struct emds_partition *partition)
 		return -EINVAL;
 	}
 
+	partition->driver_write = flash_driver_write_get(fa->fa_dev);
+
 	if (flash_params_get_erase_cap(partition->fp) & FLASH_ERASE_C_EXPLICIT) {
 		struct flash_pages_info info;
 		int rc;
@@ -155,7 +194,6 @@ int emds_flash_scan_partition(const struct emds_partition *partition,
 	const struct flash_area *fa = partition->fa;
 	off_t read_off = fa->fa_size - sizeof(cache);
 	int failures = 0;
-	uint32_t crc;
 	int rc;
 
 	cand_list_init(&cand_list, cand_buf);
@@ -167,16 +205,15 @@ int emds_flash_scan_partition(const struct emds_partition *partition,
 			return rc;
 		}
 
-		if (cache.marker != EMDS_SNAPSHOT_METADATA_MARKER) {
+		if (cache.marker != EMDS_SNAPSHOT_METADATA_MARKER &&
+		    cache.marker != EMDS_SNAPSHOT_DELTA_MARKER) {
 			failures++;
 			LOG_DBG("Snapshot metadata marker mismatch at address 0x%04lx",
 				fa->fa_off + read_off);
 			continue;
 		}
 
-		crc = crc32_k_4_2_update(0, (const unsigned char *)&cache,
-					 offsetof(struct emds_snapshot_metadata, metadata_crc));
-		if (crc != cache.metadata_crc) {
+		if (metadata_crc_get(&cache) != cache.metadata_crc) {
 			failures++;
 			LOG_DBG("Snapshot metadata CRC mismatch at address 0x%04lx",
 				fa->fa_off + read_off);
@@ -213,6 +250,55 @@ int emds_flash_scan_partition(const struct emds_partition *partition,
 	return 0;
 }
 
+int emds_flash_snapshot_read(const struct emds_partition *partition, off_t metadata_off,
+			     struct emds_snapshot_candidate *snapshot)
+{
+	const struct flash_area *fa = partition->fa;
+	struct emds_snapshot_metadata *metadata = &snapshot->metadata;
+	int rc;
+
+	if (metadata_off <= 0 || metadata_off > fa->fa_size - sizeof(*metadata)) {
+		return -EINVAL;
+	}
+
+	rc = flash_area_read(fa, metadata_off, metadata, sizeof(*metadata));
+	if (rc) {
+		LOG_ERR("Failed to read snapshot metadata: %d", rc);
+		return -EIO;
+	}
+
+	if ((metadata->marker != EMDS_SNAPSHOT_METADATA_MARKER &&
+	     metadata->marker != EMDS_SNAPSHOT_DELTA_MARKER) ||
+	    metadata_crc_get(metadata) != metadata->metadata_crc) {
+		LOG_DBG("No valid snapshot metadata at address 0x%04lx", fa->fa_off + metadata_off);
+		return -ENOENT;
+	}
+
+	if (!cand_snapshot_crc_check(partition, metadata)) {
+		LOG_DBG("Snapshot CRC mismatch at address 0x%04lx",
+			fa->fa_off + metadata->data_instance_off);
+		return -ENOENT;
+	}
+
+	snapshot->metadata_off = metadata_off;
+
+	return 0;
+}
+
+bool emds_flash_snapshot_is_delta(const struct emds_snapshot_metadata *metadata)
+{
+	return metadata->marker == EMDS_SNAPSHOT_DELTA_MARKER;
+}
+
+void emds_flash_snapshot_delta_set(struct emds_snapshot_metadata *metadata, uint32_t base_cnt,
+				   size_t data_size)
+{
+	metadata->marker = EMDS_SNAPSHOT_DELTA_MARKER;
+	metadata->base_cnt = base_cnt;
+	metadata->data_instance_len = data_size;
+	metadata->metadata_crc = metadata_crc_get(metadata);
+}
+
 int emds_flash_allocate_snapshot(const struct emds_partition *partition,
 				 const struct emds_snapshot_candidate *freshest_snapshot,
 				 struct emds_snapshot_candidate *allocated_snapshot,
@@ -284,9 +370,7 @@ int emds_flash_allocate_snapshot(const struct emds_partition *partition,
 	allocated_snapshot->metadata.marker = EMDS_SNAPSHOT_METADATA_MARKER;
 	allocated_snapshot->metadata.data_instance_off = data_off;
 	allocated_snapshot->metadata.data_instance_len = data_size;
-	allocated_snapshot->metadata.metadata_crc =
-		crc32_k_4_2_update(0, (const unsigned char *)&allocated_snapshot->metadata,
-				   offsetof(struct emds_snapshot_metadata, metadata_crc));
+	allocated_snapshot->metadata.metadata_crc = metadata_crc_get(&allocated_snapshot->metadata);
 	allocated_snapshot->metadata.snapshot_crc = 0;
 
 	LOG_DBG("Allocating snapshot at address 0x%04lx with length %u and fresh_cnt %u",
@@ -297,6 +381,7 @@ int emds_flash_allocate_snapshot(const struct emds_partition *partition,
 	return 0;
 }
 
+#if defined SOC_FLASH_DIRECT_WRITE
 static void nvmc_wait_ready(void)
 {
 #if defined CONFIG_SOC_FLASH_NRF_RRAM
@@ -307,6 +392,7 @@ static void nvmc_wait_ready(void)
 	}
 #endif
 }
+#endif
 
 #if defined CONFIG_SOC_FLASH_NRF_RRAM
 static void commit_changes(const struct emds_partition *partition, size_t len)
@@ -330,6 +416,14 @@ static void commit_changes(const struct emds_partition *partition, size_t len)
 void emds_flash_write_data(const struct emds_partition *partition, off_t data_off, void *data_chunk,
 			   size_t data_size)
 {
+	if (partition->driver_write) {
+		data_size = ROUND_UP(data_size, partition->fp->write_block_size);
+
+		(void)flash_area_write(partition->fa, data_off, data_chunk, data_size);
+		return;
+	}
+
+#if defined SOC_FLASH_DIRECT_WRITE
 	uint32_t flash_addr = data_off + partition->fa->fa_off;
 
 	flash_addr += DT_REG_ADDR(SOC_NV_FLASH_NODE);
@@ -362,6 +456,7 @@ void emds_flash_write_data(const struct emds_partition *partition, off_t data_of
 	}
 #endif
 	nvmc_wait_ready();
+#endif
 }
 
 int emds_flash_erase_partition(const struct emds_partition *partition)
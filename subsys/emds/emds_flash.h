@@ -36,10 +36,13 @@ extern "C" {
  *
  * @param fa Flash area for the partition.
  * @param fp Flash parameters for the partition.
+ * @param driver_write The partition is not on the SoC flash and is written through the flash
+ *                     driver also by the emergency store.
  */
 struct emds_partition {
 	const struct flash_area *fa;
 	const struct flash_parameters *fp;
+	bool driver_write;
 };
 
 /**
@@ -66,12 +69,18 @@ struct emds_data_entry {
  * in the lifetime of devices. This will never happen in the lifetime of the device
  * as flash endurance will run out much before this count is reached.
  *
+ * A delta snapshot holds only the entries changed since the previous snapshot. It is chained
+ * to a full snapshot in the same partition. The full snapshot and its deltas occupy consecutive
+ * metadata slots with consecutive fresh_cnt values.
+ *
  * @param marker Constant value to follow the end of the table.
  * @param fresh_cnt Increment counter for every data instance.
  * @param data_instance_off The start offset of the data instance area.
  * @param data_instance_len The data instance area length.
- * @param metadata_crc The metadata structure CRC.
+ * @param metadata_crc The metadata structure CRC. For delta snapshots it covers base_cnt too.
  * @param snapshot_crc The snapshot area CRC.
+ * @param base_cnt The fresh_cnt of the full snapshot a delta snapshot is chained to.
+ *                 Not used by full snapshots.
  */
 struct emds_snapshot_metadata {
 	uint32_t marker;
@@ -80,7 +89,8 @@ struct emds_snapshot_metadata {
 	uint32_t data_instance_len;
 	uint32_t metadata_crc;
 	uint32_t snapshot_crc;
-	uint32_t reserved[2];
+	uint32_t base_cnt;
+	uint32_t reserved;
 } __packed;
 
 /**
@@ -129,6 +139,44 @@ int emds_flash_init(struct emds_partition *partition);
 int emds_flash_scan_partition(const struct emds_partition *partition,
 			      struct emds_snapshot_candidate *candidate);
 
+/**
+ * @brief Read and validate the snapshot with metadata at the given offset.
+ *
+ * @param partition Pointer to the emergency data storage partition structure.
+ * @param metadata_off Offset of the metadata within the partition.
+ * @param snapshot Pointer to the emergency data storage snapshot candidate structure
+ * that will be filled with the snapshot metadata.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the offset is outside of the metadata area.
+ * @retval -ENOENT if there is no valid snapshot at the offset.
+ * @retval -EIO if an error occurs during reading.
+ */
+int emds_flash_snapshot_read(const struct emds_partition *partition, off_t metadata_off,
+			     struct emds_snapshot_candidate *snapshot);
+
+/**
+ * @brief Check if the snapshot metadata describes a delta snapshot.
+ *
+ * @param metadata Pointer to the snapshot metadata.
+ *
+ * @return true if the snapshot is a delta snapshot, false otherwise.
+ */
+bool emds_flash_snapshot_is_delta(const struct emds_snapshot_metadata *metadata);
+
+/**
+ * @brief Turn allocated snapshot metadata into delta snapshot metadata.
+ *
+ * Sets the marker, the base snapshot and the actual data length of the delta snapshot
+ * and updates the metadata crc.
+ *
+ * @param metadata Pointer to the allocated snapshot metadata.
+ * @param base_cnt The fresh_cnt of the full snapshot the delta snapshot is chained to.
+ * @param data_size The size of the changed entries stored in the delta snapshot.
+ */
+void emds_flash_snapshot_delta_set(struct emds_snapshot_metadata *metadata, uint32_t base_cnt,
+				   size_t data_size);
+
 /** * @brief Allocate a new snapshot in the emergency data storage partition.
  *
  * This function allocates a new snapshot in the specified partition based on the
@@ -15,6 +15,10 @@ LOG_MODULE_REGISTER(event_manager_proxy, CONFIG_APP_EVENT_MANAGER_LOG_LEVEL);
 
 
 #define EMP_BIND_TIMEOUT K_MSEC(CONFIG_EVENT_MANAGER_PROXY_BIND_TIMEOUT_MS)
+#define EMP_TX_BUF_WAIT K_MSEC(CONFIG_EVENT_MANAGER_PROXY_TX_BUF_WAIT_MS)
+
+/** @brief The remote packs multiple events into a single IPC message. */
+#define EMP_START_FLAG_BATCH BIT(0)
 
 /* Helpers - allow linker to get information about these structure sizes. */
 static struct event_type _emp_event_type_size_check
@@ -26,6 +30,10 @@ static struct event_type *_emp_event_type_pointer_size_check
 extern struct event_type *event_manager_proxy_array[];
 extern struct event_type *_event_manager_proxy_array_list_end[];
 
+/* Open addressing hash map of event type names, used to find events subscribed by remotes. */
+extern struct event_type *event_manager_proxy_name_map[];
+extern struct event_type *_event_manager_proxy_name_map_end[];
+
 
 /** @brief Command codes used by the proxy. */
 enum emp_cmd_code {
@@ -42,6 +50,16 @@ struct emp_cmd {
 	enum emp_cmd_code code;
 };
 
+/**
+ * @brief The command structure used to start events transfer.
+ *
+ * Older remotes send only the command code, in which case no flags are set.
+ */
+struct emp_cmd_start {
+	enum emp_cmd_code code;
+	uint32_t flags;
+};
+
 /**
  * @brief The command structure used to subscribe.
  */
@@ -51,14 +69,55 @@ struct emp_cmd_subscribe {
 	char name[];
 };
 
+/**
+ * @brief The header of a single event in the batched IPC message.
+ *
+ * The event data follows the header and is padded to a multiple of 4 bytes.
+ */
+struct emp_batch_record {
+	uint16_t len;
+	uint16_t reserved;
+	uint8_t data[];
+};
+
+#ifdef CONFIG_EVENT_MANAGER_PROXY_BATCH
+/**
+ * @brief Events waiting to be sent to the remote in a single IPC message.
+ *
+ * Accessed only from the system workqueue, which processes the events and the flush work.
+ */
+struct emp_tx_batch {
+	/* IPC TX buffer, or local_buf if the backend does not support no-copy send. */
+	uint8_t *buf;
+	uint32_t size;
+	uint32_t len;
+	uint32_t cnt;
+	/* Timestamp of the first event and the sum of the following event offsets from it. */
+	uint32_t first_cycles;
+	uint64_t cycles_offset_sum;
+	struct k_work_delayable flush_work;
+	uint32_t local_buf[DIV_ROUND_UP(CONFIG_EVENT_MANAGER_PROXY_BATCH_SIZE, sizeof(uint32_t))];
+};
+#endif
+
 /** @brief Inter-core communication data. */
 struct emp_ipc_data {
 	struct ipc_ept ept;
 	struct ipc_ept_cfg ept_cfg;
 	bool used;
 	bool started;
+	/* Events are packed into batches in both directions. */
+	bool batch;
+	/* The IPC backend supports no-copy send. */
+	bool nocopy;
 	struct k_event bound;
 	const struct event_type **event_type_map;
+#ifdef CONFIG_EVENT_MANAGER_PROXY_BATCH
+	struct emp_tx_batch tx_batch;
+#endif
+	struct k_spinlock stats_lock;
+	struct event_manager_proxy_stats stats;
+	uint64_t latency_sum_us;
 };
 
 
@@ -92,6 +151,59 @@ static struct emp_ipc_data *find_ipc_by_instance(const struct device *instance)
 	return NULL;
 }
 
+/**
+ * @brief Calculate the hash of the event name.
+ *
+ * @param name The name of the event.
+ *
+ * @return FNV-1a hash of the name.
+ */
+static uint32_t name_hash(const char *name)
+{
+	uint32_t hash = 2166136261U;
+
+	while (*name) {
+		hash ^= (uint8_t)*name++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+static size_t name_map_size(void)
+{
+	return _event_manager_proxy_name_map_end - event_manager_proxy_name_map;
+}
+
+/**
+ * @brief Fill in the event type name map.
+ *
+ * The map has twice as many entries as there are event types, so the probe sequences are short.
+ */
+static void name_map_build(void)
+{
+	static bool built;
+	size_t map_size = name_map_size();
+
+	if (built) {
+		return;
+	}
+
+	memset(event_manager_proxy_name_map, 0, map_size * sizeof(event_manager_proxy_name_map[0]));
+
+	STRUCT_SECTION_FOREACH(event_type, et) {
+		size_t idx = name_hash(et->name) % map_size;
+
+		while (event_manager_proxy_name_map[idx]) {
+			idx = (idx + 1) % map_size;
+		}
+
+		event_manager_proxy_name_map[idx] = et;
+	}
+
+	built = true;
+}
+
 /**
  * @brief Find event type by name.
  *
@@ -102,7 +214,16 @@ static struct emp_ipc_data *find_ipc_by_instance(const struct device *instance)
  */
 static struct event_type *find_event_by_name(const char *name)
 {
-	STRUCT_SECTION_FOREACH(event_type, et) {
+	size_t map_size = name_map_size();
+
+	if (map_size == 0) {
+		return NULL;
+	}
+
+	for (size_t idx = name_hash(name) % map_size; event_manager_proxy_name_map[idx];
+	     idx = (idx + 1) % map_size) {
+		struct event_type *et = event_manager_proxy_name_map[idx];
+
 		if (!strcmp(et->name, name)) {
 			return et;
 		}
@@ -159,6 +280,26 @@ static void handle_remote_event(struct emp_ipc_data *ipc, const void *data, size
 	_event_submit(event);
 }
 
+static void handle_remote_batch(struct emp_ipc_data *ipc, const uint8_t *data, size_t len)
+{
+	while (len >= sizeof(struct emp_batch_record)) {
+		const struct emp_batch_record *rec = (const struct emp_batch_record *)data;
+		size_t rec_size = ROUND_UP(sizeof(*rec) + rec->len, sizeof(uint32_t));
+
+		if ((rec->len == 0) || (sizeof(*rec) + rec->len > len)) {
+			LOG_ERR("Malformed event batch");
+			__ASSERT_NO_MSG(false);
+			return;
+		}
+
+		handle_remote_event(ipc, rec->data, rec->len);
+
+		rec_size = MIN(rec_size, len);
+		data += rec_size;
+		len -= rec_size;
+	}
+}
+
 static void handle_remote_command_subscribe(struct emp_ipc_data *ipc, const void *data, size_t len)
 {
 	if (ipc->started) {
@@ -197,9 +338,15 @@ static void handle_remote_command_start(struct emp_ipc_data *ipc, const void *da
 		return;
 	}
 
+	const struct emp_cmd_start *cmd = data;
+	uint32_t flags = (len >= sizeof(*cmd)) ? cmd->flags : 0;
+
+	ipc->batch = IS_ENABLED(CONFIG_EVENT_MANAGER_PROXY_BATCH) &&
+		     (flags & EMP_START_FLAG_BATCH);
 	ipc->started = true;
 
-	LOG_DBG("Event transmission on ipc %d started", ipc2idx(ipc));
+	LOG_DBG("Event transmission on ipc %d started%s", ipc2idx(ipc),
+		ipc->batch ? ", batched" : "");
 
 	/* Check if all remote cores started. */
 	for (size_t i = 0; i < ARRAY_SIZE(emp_ipc_data); ++i) {
@@ -256,7 +403,11 @@ static void handle_ipc_data_receive(const void *data, size_t len, void *priv)
 	__ASSERT_NO_MSG(!k_is_in_isr());
 
 	if (ipc->started && emp_started) {
-		handle_remote_event(ipc, data, len);
+		if (ipc->batch) {
+			handle_remote_batch(ipc, data, len);
+		} else {
+			handle_remote_event(ipc, data, len);
+		}
 	} else {
 		handle_remote_command(ipc, data, len);
 	}
@@ -274,33 +425,245 @@ static void handle_ipc_endpoint_error(const char *message, void *priv)
 	__ASSERT_NO_MSG(false);
 }
 
-static int send_event_to_remote(struct emp_ipc_data *ipc, const struct app_event_header *eh)
+static void stats_update(struct emp_ipc_data *ipc, uint32_t forwarded, uint32_t dropped,
+			 uint64_t latency_sum_cycles, uint32_t latency_max_cycles)
 {
-	const struct event_type *remote_ev = ipc->event_type_map[et2idx(eh->type_id)];
-	int ret;
+	k_spinlock_key_t key = k_spin_lock(&ipc->stats_lock);
 
-	if (remote_ev == NULL) {
-		return 0;
+	ipc->stats.forwarded += forwarded;
+	ipc->stats.dropped += dropped;
+
+	if (forwarded > 0) {
+		ipc->stats.messages++;
+		ipc->latency_sum_us += k_cyc_to_us_floor64(latency_sum_cycles);
+		ipc->stats.latency_max_us = MAX(ipc->stats.latency_max_us,
+						k_cyc_to_us_floor32(latency_max_cycles));
 	}
 
-	size_t size = app_event_manager_event_size(eh);
-	uint32_t buffer[DIV_ROUND_UP(size, sizeof(uint32_t))];
-	struct app_event_header *remote_eh = (struct app_event_header *)buffer;
+	k_spin_unlock(&ipc->stats_lock, key);
+}
 
-	memcpy(buffer, eh, sizeof(buffer));
+static void event_copy(void *dst, const struct app_event_header *eh, size_t size,
+		       const struct event_type *remote_ev)
+{
+	struct app_event_header *remote_eh = dst;
+
+	memcpy(dst, eh, size);
 	remote_eh->type_id = remote_ev;
+}
+
+/**
+ * @brief Get the IPC TX buffer for the no-copy send.
+ *
+ * @param ipc  The related element of the @ref emp_ipc_data array.
+ * @param buf  The pointer to the obtained buffer.
+ * @param size Requested buffer size on input, obtained buffer size on output.
+ *
+ * @retval 0        On success.
+ * @retval -ENOTSUP The IPC backend does not support no-copy send.
+ * @retval other    Error code from the IPC service.
+ */
+static int tx_buf_get(struct emp_ipc_data *ipc, void **buf, uint32_t *size)
+{
+	int ret;
+
+	if (!ipc->nocopy) {
+		return -ENOTSUP;
+	}
+
+	ret = ipc_service_get_tx_buffer(&ipc->ept, buf, size, EMP_TX_BUF_WAIT);
+	if ((ret == -EIO) || (ret == -ENOTSUP)) {
+		LOG_DBG("No-copy send not supported on ipc %zu", ipc2idx(ipc));
+		ipc->nocopy = false;
+		return -ENOTSUP;
+	}
+
+	return ret;
+}
+
+static int tx_buf_send(struct emp_ipc_data *ipc, void *buf, size_t len)
+{
+	int ret = ipc_service_send_nocopy(&ipc->ept, buf, len);
+
+	if (ret < 0) {
+		(void)ipc_service_drop_tx_buffer(&ipc->ept, buf);
+	}
+
+	return ret;
+}
+
+static int send_with_retries(struct emp_ipc_data *ipc, const void *data, size_t len)
+{
+	int ret;
 
 	for (size_t cnt = CONFIG_EVENT_MANAGER_PROXY_SEND_RETRIES + 1; cnt > 0; --cnt) {
-		ret = ipc_service_send(&ipc->ept, buffer, sizeof(buffer));
+		ret = ipc_service_send(&ipc->ept, data, len);
 		if (ret >= 0) {
 			break;
 		}
 		k_usleep(1);
 	}
 
+	return ret;
+}
+
+#ifdef CONFIG_EVENT_MANAGER_PROXY_BATCH
+static int batch_flush(struct emp_ipc_data *ipc)
+{
+	struct emp_tx_batch *batch = &ipc->tx_batch;
+	uint32_t now;
+	int ret;
+
+	if (!batch->buf) {
+		return 0;
+	}
+
+	(void)k_work_cancel_delayable(&batch->flush_work);
+
+	if (batch->buf == (uint8_t *)batch->local_buf) {
+		ret = send_with_retries(ipc, batch->buf, batch->len);
+	} else {
+		ret = tx_buf_send(ipc, batch->buf, batch->len);
+	}
+
+	now = k_cycle_get_32();
+
+	if (ret < 0) {
+		LOG_ERR("Cannot send %u events to remote %p, err: %d", batch->cnt, ipc, ret);
+		stats_update(ipc, 0, batch->cnt, 0, 0);
+	} else {
+		uint32_t first_latency = now - batch->first_cycles;
+
+		stats_update(ipc, batch->cnt, 0,
+			     (uint64_t)first_latency * batch->cnt - batch->cycles_offset_sum,
+			     first_latency);
+	}
+
+	batch->buf = NULL;
+	batch->len = 0;
+	batch->cnt = 0;
+
+	return ret;
+}
+
+static void batch_flush_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct emp_tx_batch *batch = CONTAINER_OF(dwork, struct emp_tx_batch, flush_work);
+
+	(void)batch_flush(CONTAINER_OF(batch, struct emp_ipc_data, tx_batch));
+}
+
+static int batch_alloc(struct emp_ipc_data *ipc, uint32_t size)
+{
+	struct emp_tx_batch *batch = &ipc->tx_batch;
+	void *buf;
+	int ret;
+
+	ret = tx_buf_get(ipc, &buf, &size);
+	if (ret == -ENOTSUP) {
+		if (size > sizeof(batch->local_buf)) {
+			return -EMSGSIZE;
+		}
+
+		buf = batch->local_buf;
+		size = sizeof(batch->local_buf);
+	} else if (ret < 0) {
+		return ret;
+	}
+
+	batch->buf = buf;
+	batch->size = size;
+
+	return 0;
+}
+
+static int batch_add(struct emp_ipc_data *ipc, const struct app_event_header *eh,
+		     const struct event_type *remote_ev, size_t size, uint32_t timestamp)
+{
+	struct emp_tx_batch *batch = &ipc->tx_batch;
+	size_t rec_size = ROUND_UP(sizeof(struct emp_batch_record) + size, sizeof(uint32_t));
+	struct emp_batch_record *rec;
+	int ret;
+
+	if (batch->buf && (batch->len + rec_size > batch->size)) {
+		(void)batch_flush(ipc);
+	}
+
+	if (!batch->buf) {
+		ret = batch_alloc(ipc, MAX(rec_size, CONFIG_EVENT_MANAGER_PROXY_BATCH_SIZE));
+		if (ret < 0) {
+			return ret;
+		}
+
+		batch->first_cycles = timestamp;
+		batch->cycles_offset_sum = 0;
+
+		/* The deadline is counted from the first event in the batch. */
+		k_work_schedule(&batch->flush_work,
+				K_USEC(CONFIG_EVENT_MANAGER_PROXY_BATCH_TIMEOUT_US));
+	}
+
+	rec = (struct emp_batch_record *)&batch->buf[batch->len];
+	rec->len = size;
+	rec->reserved = 0;
+	event_copy(rec->data, eh, size, remote_ev);
+
+	batch->len += rec_size;
+	batch->cnt++;
+	batch->cycles_offset_sum += timestamp - batch->first_cycles;
+
+	return 0;
+}
+#endif /* CONFIG_EVENT_MANAGER_PROXY_BATCH */
+
+static int send_event_to_remote(struct emp_ipc_data *ipc, const struct app_event_header *eh,
+				uint32_t timestamp)
+{
+	const struct event_type *remote_ev = ipc->event_type_map[et2idx(eh->type_id)];
+	uint32_t latency;
+	void *buf;
+	int ret;
+
+	if (remote_ev == NULL) {
+		return 0;
+	}
+
+	size_t size = app_event_manager_event_size(eh);
+
+#ifdef CONFIG_EVENT_MANAGER_PROXY_BATCH
+	if (ipc->batch) {
+		ret = batch_add(ipc, eh, remote_ev, size, timestamp);
+		if (ret < 0) {
+			LOG_ERR("Cannot queue event to remote %p, err: %d", ipc, ret);
+			stats_update(ipc, 0, 1, 0, 0);
+		}
+
+		return ret;
+	}
+#endif
+
+	uint32_t buf_size = size;
+
+	ret = tx_buf_get(ipc, &buf, &buf_size);
+	if (ret == 0) {
+		/* Copy the event directly to the shared memory. */
+		event_copy(buf, eh, size, remote_ev);
+		ret = tx_buf_send(ipc, buf, size);
+	} else if (ret == -ENOTSUP) {
+		uint32_t buffer[DIV_ROUND_UP(size, sizeof(uint32_t))];
+
+		event_copy(buffer, eh, size, remote_ev);
+		ret = send_with_retries(ipc, buffer, size);
+	}
+
 	if (ret < 0) {
 		LOG_ERR("Cannot send event to remote %p, err: %d", ipc, ret);
+		stats_update(ipc, 0, 1, 0, 0);
 		__ASSERT_NO_MSG(false);
+	} else {
+		latency = k_cycle_get_32() - timestamp;
+		stats_update(ipc, 1, 0, latency, latency);
 	}
 
 	return ret;
@@ -308,6 +671,7 @@ static int send_event_to_remote(struct emp_ipc_data *ipc, const struct app_event
 
 static void event_manager_proxy_on_event_process(const struct app_event_header *eh)
 {
+	uint32_t timestamp = k_cycle_get_32();
 	int ret = 0;
 
 	if (!emp_started) {
@@ -321,7 +685,7 @@ static void event_manager_proxy_on_event_process(const struct app_event_header *
 			continue;
 		}
 
-		ret = send_event_to_remote(ipc, eh);
+		ret = send_event_to_remote(ipc, eh, timestamp);
 	}
 }
 APP_EVENT_HOOK_POSTPROCESS_REGISTER(event_manager_proxy_on_event_process);
@@ -336,6 +700,8 @@ static int add_ipc_instace(struct emp_ipc_data *ipc, const struct device *instan
 	}
 
 	ipc->started = false;
+	ipc->batch = false;
+	ipc->nocopy = true;
 	ipc->ept_cfg = (struct ipc_ept_cfg) {
 		.name = "event_manager_proxy",
 		.cb = {
@@ -356,6 +722,13 @@ static int add_ipc_instace(struct emp_ipc_data *ipc, const struct device *instan
 
 	k_event_init(&ipc->bound);
 
+#ifdef CONFIG_EVENT_MANAGER_PROXY_BATCH
+	k_work_init_delayable(&ipc->tx_batch.flush_work, batch_flush_work_handler);
+#endif
+
+	/* Remote can subscribe as soon as the endpoint is registered. */
+	name_map_build();
+
 	ret = ipc_service_register_endpoint(instance, &ipc->ept, &ipc->ept_cfg);
 	if (ret) {
 		LOG_ERR("Error registering endpoint in ipc service (%d)", ret);
@@ -428,7 +801,10 @@ int event_manager_proxy_subscribe(const struct device *instance,
 
 static int send_start_command_to_remote(struct emp_ipc_data *ipc)
 {
-	const struct emp_cmd cmd = {.code = EMP_CMD_START};
+	const struct emp_cmd_start cmd = {
+		.code = EMP_CMD_START,
+		.flags = IS_ENABLED(CONFIG_EVENT_MANAGER_PROXY_BATCH) ? EMP_START_FLAG_BATCH : 0,
+	};
 
 	__ASSERT_NO_MSG(ipc);
 
@@ -479,3 +855,33 @@ int event_manager_proxy_wait_for_remotes(k_timeout_t timeout)
 
 	return 0;
 }
+
+int event_manager_proxy_stats_get(const struct device *instance,
+				  struct event_manager_proxy_stats *stats, bool reset)
+{
+	struct emp_ipc_data *ipc = find_ipc_by_instance(instance);
+	k_spinlock_key_t key;
+
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	if (!ipc) {
+		return -ENOENT;
+	}
+
+	key = k_spin_lock(&ipc->stats_lock);
+
+	*stats = ipc->stats;
+	stats->latency_avg_us = (stats->forwarded > 0) ?
+				(ipc->latency_sum_us / stats->forwarded) : 0;
+
+	if (reset) {
+		memset(&ipc->stats, 0, sizeof(ipc->stats));
+		ipc->latency_sum_us = 0;
+	}
+
+	k_spin_unlock(&ipc->stats_lock, key);
+
+	return 0;
+}
@@ -26,6 +26,7 @@
 #include <zephyr/logging/log_backend_std.h>
 #include <zephyr/logging/log_ctrl.h>
 #include <zephyr/logging/log_output.h>
+#include <zephyr/sys/byteorder.h>
 
 #include <string.h>
 
@@ -46,11 +47,41 @@ static const char *const filtered_out_sources[] = {
 	"NRF_RPC",
 };
 
+/*
+ * Bitmap of local source IDs matching filtered_out_sources, computed at init.
+ * Sources with higher IDs are matched by name.
+ */
+static uint32_t filtered_out_bitmap[DIV_ROUND_UP(CONFIG_LOG_BACKEND_RPC_FILTER_MAX_SOURCES, 32)];
+
 static const uint32_t common_output_flags =
 	LOG_OUTPUT_FLAG_TIMESTAMP | LOG_OUTPUT_FLAG_FORMAT_TIMESTAMP;
 
+/*
+ * Each message in the buffer is stored as a record with the following layout:
+ * level (1 byte) | length (2 bytes, little-endian) | formatted message.
+ */
+#define MSG_RECORD_HDR_SIZE 3
+
+/* Upper bound of the CBOR overhead per message: level + byte string header. */
+#define MSG_CBOR_OVERHEAD 6
+
+/* Formatted messages waiting to be sent, accessed only from the logging thread. */
+static struct {
+	uint8_t data[CONFIG_LOG_BACKEND_RPC_BUFFER_SIZE];
+	size_t len;
+	uint32_t cnt;
+	uint32_t format;
+} msg_buf;
+
+static struct k_spinlock stats_lock;
+static struct log_rpc_stats stats;
+
 static bool panic_mode;
+#ifdef CONFIG_LOG_BACKEND_RPC_OUTPUT_DICTIONARY
+static uint32_t log_format = LOG_OUTPUT_DICT;
+#else
 static uint32_t log_format = LOG_OUTPUT_TEXT;
+#endif
 static enum log_rpc_level stream_level = LOG_RPC_LEVEL_NONE;
 static log_timestamp_t log_timestamp_delta;
 
@@ -173,8 +204,8 @@ NRF_RPC_CBOR_CMD_DECODER(log_rpc_group, log_rpc_invalidate_crash_dump_handler,
 			 NULL);
 #endif /* CONFIG_LOG_BACKEND_RPC_CRASH_LOG */
 
-static void format_message(struct log_msg *msg, uint32_t flags, log_output_func_t output_func,
-			   void *output_ctx)
+static void format_message(struct log_msg *msg, uint32_t format, uint32_t flags,
+			   log_output_func_t output_func, void *output_ctx)
 {
 	uint8_t output_buffer[CONFIG_LOG_BACKEND_RPC_OUTPUT_BUFFER_SIZE];
 	struct log_output_control_block control_block = {.ctx = output_ctx};
@@ -186,7 +217,7 @@ static void format_message(struct log_msg *msg, uint32_t flags, log_output_func_
 	};
 	log_format_func_t log_formatter;
 
-	log_formatter = log_format_func_t_get(log_format);
+	log_formatter = log_format_func_t_get(format);
 	log_formatter(&output, msg, flags);
 }
 
@@ -213,8 +244,8 @@ static int output_to_buf(uint8_t *data, size_t length, void *ctx)
 	return (int)length;
 }
 
-static size_t format_message_to_buf(struct log_msg *msg, uint32_t flags, uint8_t *out,
-				    size_t out_len)
+static size_t format_message_to_buf(struct log_msg *msg, uint32_t format, uint32_t flags,
+				    uint8_t *out, size_t out_len)
 {
 	struct output_to_buf_ctx output_ctx = {
 		.out = out,
@@ -222,55 +253,166 @@ static size_t format_message_to_buf(struct log_msg *msg, uint32_t flags, uint8_t
 		.total_len = 0,
 	};
 
-	format_message(msg, flags, output_to_buf, &output_ctx);
+	format_message(msg, format, flags, output_to_buf, &output_ctx);
 
 	return output_ctx.total_len;
 }
 
-static void stream_message(struct log_msg *msg)
+static void send_event(enum log_rpc_evt_forwarder evt, struct nrf_rpc_cbor_ctx *ctx,
+		       uint32_t msg_cnt, size_t msg_bytes)
 {
-	const uint32_t flags = common_output_flags | LOG_OUTPUT_FLAG_CRLF_NONE;
+	uint32_t start = k_cycle_get_32();
+	int rc = nrf_rpc_cbor_evt(&log_rpc_group, evt, ctx);
+	uint32_t send_time_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	if (rc) {
+		stats.failed_msgs += msg_cnt;
+	} else {
+		stats.sent_msgs += msg_cnt;
+		stats.sent_events++;
+		stats.sent_bytes += msg_bytes;
+	}
 
+	stats.send_time_max_us = MAX(stats.send_time_max_us, send_time_us);
+
+	k_spin_unlock(&stats_lock, key);
+}
+
+static void flush_messages(void)
+{
+	const bool dict = (msg_buf.format == LOG_OUTPUT_DICT);
+	enum log_rpc_evt_forwarder evt;
 	struct nrf_rpc_cbor_ctx ctx;
+	size_t pos = 0;
 	size_t length;
+
+	if (msg_buf.cnt == 0) {
+		return;
+	}
+
+	if (dict) {
+		evt = LOG_RPC_EVT_DICT_MSG;
+	} else {
+		/* Keep using the single message event, so that batching is only used when needed. */
+		evt = (msg_buf.cnt > 1) ? LOG_RPC_EVT_MSG_BATCH : LOG_RPC_EVT_MSG;
+	}
+
+	NRF_RPC_CBOR_ALLOC(&log_rpc_group, ctx,
+			   MSG_CBOR_OVERHEAD + msg_buf.len + msg_buf.cnt * MSG_CBOR_OVERHEAD);
+
+	if (evt != LOG_RPC_EVT_MSG) {
+		nrf_rpc_encode_uint(&ctx, msg_buf.cnt);
+	}
+
+	while (pos < msg_buf.len) {
+		length = sys_get_le16(&msg_buf.data[pos + 1]);
+
+		if (!dict) {
+			nrf_rpc_encode_uint(&ctx, msg_buf.data[pos]);
+		}
+
+		nrf_rpc_encode_buffer(&ctx, &msg_buf.data[pos + MSG_RECORD_HDR_SIZE], length);
+		pos += MSG_RECORD_HDR_SIZE + length;
+	}
+
+	send_event(evt, &ctx, msg_buf.cnt, msg_buf.len - msg_buf.cnt * MSG_RECORD_HDR_SIZE);
+
+	msg_buf.len = 0;
+	msg_buf.cnt = 0;
+}
+
+static void stream_long_message(struct log_msg *msg, uint32_t format, uint32_t flags,
+				size_t length)
+{
+	const bool dict = (format == LOG_OUTPUT_DICT);
+	struct nrf_rpc_cbor_ctx ctx;
 	size_t max_length;
 
-	/* 1. Calculate the formatted message length to allocate a sufficient CBOR encode buffer */
-	length = format_message_to_buf(msg, flags, NULL, 0);
+	NRF_RPC_CBOR_ALLOC(&log_rpc_group, ctx, MSG_CBOR_OVERHEAD + length);
 
-	NRF_RPC_CBOR_ALLOC(&log_rpc_group, ctx, 6 + length);
-	nrf_rpc_encode_uint(&ctx, log_msg_get_level(msg));
+	/* The dictionary-based message event carries the number of messages instead of level. */
+	nrf_rpc_encode_uint(&ctx, dict ? 1 : log_msg_get_level(msg));
 
-	/* 2. Format the message directly into the CBOR encode buffer. */
+	/* Format the message directly into the CBOR encode buffer. */
 	if (zcbor_bstr_start_encode(ctx.zs)) {
 		max_length = ctx.zs[0].payload_end - ctx.zs[0].payload_mut;
-		length = format_message_to_buf(msg, flags, ctx.zs[0].payload_mut, max_length);
-		ctx.zs[0].payload_mut += MIN(length, max_length);
+		length = format_message_to_buf(msg, format, flags, ctx.zs[0].payload_mut,
+					       max_length);
+		length = MIN(length, max_length);
+		ctx.zs[0].payload_mut += length;
 		zcbor_bstr_end_encode(ctx.zs, NULL);
 	}
 
-	nrf_rpc_cbor_evt_no_err(&log_rpc_group, LOG_RPC_EVT_MSG, &ctx);
+	send_event(dict ? LOG_RPC_EVT_DICT_MSG : LOG_RPC_EVT_MSG, &ctx, 1, length);
+}
+
+static void stream_message(struct log_msg *msg)
+{
+	const uint32_t flags = common_output_flags | LOG_OUTPUT_FLAG_CRLF_NONE;
+	const uint32_t format = log_format;
+
+	uint8_t *record;
+	size_t max_length;
+	size_t length = 0;
+
+	if (msg_buf.cnt > 0 && msg_buf.format != format) {
+		flush_messages();
+	}
+
+	/*
+	 * Format the message directly into the message buffer. If the message does not fit,
+	 * flush the pending messages and retry with the empty buffer.
+	 */
+	for (int attempt = 0; attempt < 2; attempt++) {
+		record = &msg_buf.data[msg_buf.len];
+		max_length = sizeof(msg_buf.data) - msg_buf.len;
+		max_length = MIN(max_length - MIN(max_length, MSG_RECORD_HDR_SIZE), UINT16_MAX);
+
+		length = format_message_to_buf(msg, format, flags, record + MSG_RECORD_HDR_SIZE,
+					       max_length);
+
+		if (length <= max_length) {
+			record[0] = log_msg_get_level(msg);
+			sys_put_le16(length, &record[1]);
+			msg_buf.len += MSG_RECORD_HDR_SIZE + length;
+			msg_buf.cnt++;
+			msg_buf.format = format;
+
+			if (!IS_ENABLED(CONFIG_LOG_BACKEND_RPC_BATCH)) {
+				flush_messages();
+			}
+
+			return;
+		}
+
+		if (msg_buf.cnt == 0) {
+			break;
+		}
+
+		flush_messages();
+	}
+
+	/* The message is longer than the message buffer. */
+	stream_long_message(msg, format, flags, length);
 }
 
-static const char *log_msg_source_name_get(struct log_msg *msg)
+static uint32_t log_msg_source_id_get(struct log_msg *msg)
 {
 	void *source;
-	uint32_t source_id;
 
 	if (log_msg_get_domain(msg) != Z_LOG_LOCAL_DOMAIN_ID) {
-		return NULL;
+		return UINT32_MAX;
 	}
 
 	source = (void *)log_msg_get_source(msg);
 
 	if (source == NULL) {
-		return NULL;
+		return UINT32_MAX;
 	}
 
-	source_id = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? log_dynamic_source_id(source)
-							     : log_const_source_id(source);
-
-	return TYPE_SECTION_START(log_const)[source_id].name;
+	return IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? log_dynamic_source_id(source)
+						       : log_const_source_id(source);
 }
 
 static bool starts_with(const char *str, const char *prefix)
@@ -278,19 +420,56 @@ static bool starts_with(const char *str, const char *prefix)
 	return strncmp(str, prefix, strlen(prefix)) == 0;
 }
 
+static bool source_name_filtered_out(const char *source_name)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(filtered_out_sources); i++) {
+		if (starts_with(source_name, filtered_out_sources[i])) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool source_filtered_out(struct log_msg *msg)
+{
+	uint32_t source_id = log_msg_source_id_get(msg);
+
+	if (source_id == UINT32_MAX) {
+		return false;
+	}
+
+	if (source_id < CONFIG_LOG_BACKEND_RPC_FILTER_MAX_SOURCES) {
+		return filtered_out_bitmap[source_id / 32] & BIT(source_id % 32);
+	}
+
+	return source_name_filtered_out(TYPE_SECTION_START(log_const)[source_id].name);
+}
+
+static void filtered_out_bitmap_init(void)
+{
+	uint32_t source_cnt = MIN(log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID),
+				  CONFIG_LOG_BACKEND_RPC_FILTER_MAX_SOURCES);
+
+	for (uint32_t source_id = 0; source_id < source_cnt; source_id++) {
+		if (source_name_filtered_out(TYPE_SECTION_START(log_const)[source_id].name)) {
+			filtered_out_bitmap[source_id / 32] |= BIT(source_id % 32);
+		}
+	}
+}
+
 static void process(const struct log_backend *const backend, union log_msg_generic *msg_generic)
 {
 	struct log_msg *msg = &msg_generic->log;
-	const char *source_name = log_msg_source_name_get(msg);
 	enum log_rpc_level level = (enum log_rpc_level)log_msg_get_level(msg);
 	enum log_rpc_level max_level;
 
-	if (source_name != NULL) {
-		for (size_t i = 0; i < ARRAY_SIZE(filtered_out_sources); i++) {
-			if (starts_with(source_name, filtered_out_sources[i])) {
-				return;
-			}
-		}
+	if (source_filtered_out(msg)) {
+		k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+		stats.filtered_msgs++;
+		k_spin_unlock(&stats_lock, key);
+		return;
 	}
 
 	if (panic_mode) {
@@ -330,6 +509,12 @@ static void panic(struct log_backend const *const backend)
 {
 	ARG_UNUSED(backend);
 
+	/*
+	 * The logging thread will not notify the backend anymore, so send the batched messages
+	 * now. They are likely to describe the cause of the panic.
+	 */
+	flush_messages();
+
 	panic_mode = true;
 }
 
@@ -337,6 +522,8 @@ static void init(struct log_backend const *const backend)
 {
 	ARG_UNUSED(backend);
 
+	filtered_out_bitmap_init();
+
 #ifdef CONFIG_LOG_BACKEND_RPC_HISTORY
 	log_rpc_history_init();
 	k_work_queue_init(&history_transfer_workq);
@@ -349,7 +536,11 @@ static void init(struct log_backend const *const backend)
 static void dropped(const struct log_backend *const backend, uint32_t cnt)
 {
 	ARG_UNUSED(backend);
-	ARG_UNUSED(cnt);
+
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	stats.dropped_msgs += cnt;
+	k_spin_unlock(&stats_lock, key);
 
 	/*
 	 * Due to an issue in Zephyr logging subsystem (see upstream PR 78145), this function
@@ -358,9 +549,22 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 	 * waste the RCP transport's bandwidth.
 	 *
 	 * For this reason, do not report the dropped log messages until this issue is fixed.
+	 * The number of dropped messages can be read using the statistics command instead.
 	 */
 }
 
+static void notify(const struct log_backend *const backend, enum log_backend_evt event,
+		   union log_backend_evt_arg *arg)
+{
+	ARG_UNUSED(backend);
+	ARG_UNUSED(arg);
+
+	/* Send the batched messages once the logging thread has processed all pending messages. */
+	if (event == LOG_BACKEND_EVT_PROCESS_THREAD_DONE && !panic_mode) {
+		flush_messages();
+	}
+}
+
 static int format_set(const struct log_backend *const backend, uint32_t log_type)
 {
 	ARG_UNUSED(backend);
@@ -376,6 +580,7 @@ static const struct log_backend_api log_backend_rpc_api = {
 	.init = init,
 	.dropped = dropped,
 	.format_set = format_set,
+	.notify = notify,
 };
 
 LOG_BACKEND_DEFINE(log_backend_rpc, log_backend_rpc_api, true);
@@ -401,6 +606,45 @@ static void log_rpc_set_stream_level_handler(const struct nrf_rpc_group *group,
 NRF_RPC_CBOR_CMD_DECODER(log_rpc_group, log_rpc_set_stream_level_handler,
 			 LOG_RPC_CMD_SET_STREAM_LEVEL, log_rpc_set_stream_level_handler, NULL);
 
+static void log_rpc_get_stats_handler(const struct nrf_rpc_group *group,
+				      struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
+{
+	struct nrf_rpc_cbor_ctx rsp_ctx;
+	struct log_rpc_stats current;
+	k_spinlock_key_t key;
+	bool reset;
+
+	reset = nrf_rpc_decode_bool(ctx);
+
+	if (!nrf_rpc_decoding_done_and_check(group, ctx)) {
+		nrf_rpc_err(-EBADMSG, NRF_RPC_ERR_SRC_RECV, group, LOG_RPC_CMD_GET_STATS,
+			    NRF_RPC_PACKET_TYPE_CMD);
+		return;
+	}
+
+	key = k_spin_lock(&stats_lock);
+	current = stats;
+
+	if (reset) {
+		memset(&stats, 0, sizeof(stats));
+	}
+
+	k_spin_unlock(&stats_lock, key);
+
+	NRF_RPC_CBOR_ALLOC(group, rsp_ctx, 7 * (1 + sizeof(uint32_t)));
+	nrf_rpc_encode_uint(&rsp_ctx, current.sent_msgs);
+	nrf_rpc_encode_uint(&rsp_ctx, current.sent_events);
+	nrf_rpc_encode_uint(&rsp_ctx, current.sent_bytes);
+	nrf_rpc_encode_uint(&rsp_ctx, current.filtered_msgs);
+	nrf_rpc_encode_uint(&rsp_ctx, current.dropped_msgs);
+	nrf_rpc_encode_uint(&rsp_ctx, current.failed_msgs);
+	nrf_rpc_encode_uint(&rsp_ctx, current.send_time_max_us);
+	nrf_rpc_cbor_rsp_no_err(group, &rsp_ctx);
+}
+
+NRF_RPC_CBOR_CMD_DECODER(log_rpc_group, log_rpc_get_stats_handler, LOG_RPC_CMD_GET_STATS,
+			 log_rpc_get_stats_handler, NULL);
+
 #ifdef CONFIG_LOG_BACKEND_RPC_HISTORY
 
 static void log_rpc_set_history_level_handler(const struct nrf_rpc_group *group,
@@ -427,6 +671,8 @@ NRF_RPC_CBOR_CMD_DECODER(log_rpc_group, log_rpc_set_history_level_handler,
 static void history_transfer_task(struct k_work *work)
 {
 	const uint32_t flags = common_output_flags | LOG_OUTPUT_FLAG_CRLF_NONE;
+	/* The history handler on the client receives text, even if the dictionary mode is used. */
+	const uint32_t format = (log_format == LOG_OUTPUT_DICT) ? LOG_OUTPUT_TEXT : log_format;
 
 	struct nrf_rpc_cbor_ctx ctx;
 	bool any_msg_consumed = false;
@@ -456,7 +702,7 @@ static void history_transfer_task(struct k_work *work)
 		}
 
 		msg = &history_cur_msg->log;
-		length = 6 + format_message_to_buf(msg, flags, NULL, 0);
+		length = 6 + format_message_to_buf(msg, format, flags, NULL, 0);
 		max_length = ctx.zs[0].payload_end - ctx.zs[0].payload_mut;
 
 		/* Check if there is enough buffer space to fit in the current message. */
@@ -468,8 +714,8 @@ static void history_transfer_task(struct k_work *work)
 
 		if (zcbor_bstr_start_encode(ctx.zs)) {
 			max_length = ctx.zs[0].payload_end - ctx.zs[0].payload_mut;
-			length = format_message_to_buf(msg, flags, ctx.zs[0].payload_mut,
-						       max_length);
+			length = format_message_to_buf(msg, format, flags,
+						       ctx.zs[0].payload_mut, max_length);
 			ctx.zs[0].payload_mut += MIN(length, max_length);
 			zcbor_bstr_end_encode(ctx.zs, NULL);
 		}
@@ -28,6 +28,28 @@ static uint32_t history_transfer_id;
 static log_rpc_history_handler_t history_handler;
 static log_rpc_history_threshold_reached_handler_t history_threshold_reached_handler;
 
+static log_rpc_dict_handler_t dict_handler;
+
+static void forward_message(enum log_rpc_level level, const char *message, size_t message_size)
+{
+	switch (level) {
+	case LOG_RPC_LEVEL_ERR:
+		LOG_ERR("%.*s", message_size, message);
+		break;
+	case LOG_RPC_LEVEL_WRN:
+		LOG_WRN("%.*s", message_size, message);
+		break;
+	case LOG_RPC_LEVEL_INF:
+		LOG_INF("%.*s", message_size, message);
+		break;
+	case LOG_RPC_LEVEL_DBG:
+		LOG_DBG("%.*s", message_size, message);
+		break;
+	default:
+		break;
+	}
+}
+
 static void log_rpc_msg_handler(const struct nrf_rpc_group *group, struct nrf_rpc_cbor_ctx *ctx,
 				void *handler_data)
 {
@@ -39,22 +61,7 @@ static void log_rpc_msg_handler(const struct nrf_rpc_group *group, struct nrf_rp
 	message = nrf_rpc_decode_buffer_ptr_and_size(ctx, &message_size);
 
 	if (message) {
-		switch (level) {
-		case LOG_RPC_LEVEL_ERR:
-			LOG_ERR("%.*s", message_size, message);
-			break;
-		case LOG_RPC_LEVEL_WRN:
-			LOG_WRN("%.*s", message_size, message);
-			break;
-		case LOG_RPC_LEVEL_INF:
-			LOG_INF("%.*s", message_size, message);
-			break;
-		case LOG_RPC_LEVEL_DBG:
-			LOG_DBG("%.*s", message_size, message);
-			break;
-		default:
-			break;
-		}
+		forward_message(level, message, message_size);
 	}
 
 	if (!nrf_rpc_decoding_done_and_check(&log_rpc_group, ctx)) {
@@ -66,6 +73,91 @@ static void log_rpc_msg_handler(const struct nrf_rpc_group *group, struct nrf_rp
 NRF_RPC_CBOR_EVT_DECODER(log_rpc_group, log_rpc_msg_handler, LOG_RPC_EVT_MSG, log_rpc_msg_handler,
 			 NULL);
 
+static void log_rpc_msg_batch_handler(const struct nrf_rpc_group *group,
+				      struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
+{
+	enum log_rpc_level level;
+	const char *message;
+	size_t message_size;
+	uint32_t cnt;
+
+	cnt = nrf_rpc_decode_uint(ctx);
+
+	for (; cnt > 0 && nrf_rpc_decode_valid(ctx); cnt--) {
+		level = nrf_rpc_decode_uint(ctx);
+		message = nrf_rpc_decode_buffer_ptr_and_size(ctx, &message_size);
+
+		if (message) {
+			forward_message(level, message, message_size);
+		}
+	}
+
+	if (!nrf_rpc_decoding_done_and_check(&log_rpc_group, ctx)) {
+		nrf_rpc_err(-EBADMSG, NRF_RPC_ERR_SRC_RECV, &log_rpc_group, LOG_RPC_EVT_MSG_BATCH,
+			    NRF_RPC_PACKET_TYPE_EVT);
+	}
+}
+
+NRF_RPC_CBOR_EVT_DECODER(log_rpc_group, log_rpc_msg_batch_handler, LOG_RPC_EVT_MSG_BATCH,
+			 log_rpc_msg_batch_handler, NULL);
+
+static void log_rpc_dict_msg_handler(const struct nrf_rpc_group *group,
+				     struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
+{
+	log_rpc_dict_handler_t handler = dict_handler;
+	const uint8_t *message;
+	size_t message_size;
+	uint32_t cnt;
+
+	cnt = nrf_rpc_decode_uint(ctx);
+
+	for (; cnt > 0 && nrf_rpc_decode_valid(ctx); cnt--) {
+		message = nrf_rpc_decode_buffer_ptr_and_size(ctx, &message_size);
+
+		if (handler != NULL && message != NULL) {
+			handler(message, message_size);
+		}
+	}
+
+	if (!nrf_rpc_decoding_done_and_check(&log_rpc_group, ctx)) {
+		nrf_rpc_err(-EBADMSG, NRF_RPC_ERR_SRC_RECV, &log_rpc_group, LOG_RPC_EVT_DICT_MSG,
+			    NRF_RPC_PACKET_TYPE_EVT);
+	}
+}
+
+NRF_RPC_CBOR_EVT_DECODER(log_rpc_group, log_rpc_dict_msg_handler, LOG_RPC_EVT_DICT_MSG,
+			 log_rpc_dict_msg_handler, NULL);
+
+void log_rpc_set_dict_handler(log_rpc_dict_handler_t handler)
+{
+	dict_handler = handler;
+}
+
+int log_rpc_get_stats(struct log_rpc_stats *stats, bool reset)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+
+	NRF_RPC_CBOR_ALLOC(&log_rpc_group, ctx, 1);
+	nrf_rpc_encode_bool(&ctx, reset);
+	nrf_rpc_cbor_cmd_rsp_no_err(&log_rpc_group, LOG_RPC_CMD_GET_STATS, &ctx);
+
+	stats->sent_msgs = nrf_rpc_decode_uint(&ctx);
+	stats->sent_events = nrf_rpc_decode_uint(&ctx);
+	stats->sent_bytes = nrf_rpc_decode_uint(&ctx);
+	stats->filtered_msgs = nrf_rpc_decode_uint(&ctx);
+	stats->dropped_msgs = nrf_rpc_decode_uint(&ctx);
+	stats->failed_msgs = nrf_rpc_decode_uint(&ctx);
+	stats->send_time_max_us = nrf_rpc_decode_uint(&ctx);
+
+	if (!nrf_rpc_decoding_done_and_check(&log_rpc_group, &ctx)) {
+		nrf_rpc_err(-EBADMSG, NRF_RPC_ERR_SRC_RECV, &log_rpc_group, LOG_RPC_CMD_GET_STATS,
+			    NRF_RPC_PACKET_TYPE_RSP);
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+
 void log_rpc_set_stream_level(enum log_rpc_level level)
 {
 	struct nrf_rpc_cbor_ctx ctx;
@@ -14,6 +14,8 @@
 #include <nrf_rpc/nrf_rpc_ipc.h>
 #elif defined(CONFIG_NRF_RPC_UART_TRANSPORT)
 #include <nrf_rpc/nrf_rpc_uart.h>
+#elif defined(CONFIG_MOCK_NRF_RPC_TRANSPORT)
+#include <mock_nrf_rpc_transport.h>
 #endif
 
 #ifdef __cplusplus
@@ -24,12 +26,16 @@ extern "C" {
 NRF_RPC_IPC_TRANSPORT(log_rpc_tr, DEVICE_DT_GET(DT_NODELABEL(ipc0)), "log_rpc_ept");
 #elif defined(CONFIG_NRF_RPC_UART_TRANSPORT)
 #define log_rpc_tr NRF_RPC_UART_TRANSPORT(DT_CHOSEN(nordic_rpc_uart))
+#elif defined(CONFIG_MOCK_NRF_RPC_TRANSPORT)
+#define log_rpc_tr mock_nrf_rpc_tr
 #endif
 NRF_RPC_GROUP_DEFINE(log_rpc_group, "log", &log_rpc_tr, NULL, NULL, NULL);
 
 enum log_rpc_evt_forwarder {
 	LOG_RPC_EVT_MSG = 0,
 	LOG_RPC_EVT_HISTORY_THRESHOLD_REACHED = 1,
+	LOG_RPC_EVT_MSG_BATCH = 2,
+	LOG_RPC_EVT_DICT_MSG = 3,
 };
 
 enum log_rpc_cmd_forwarder {
@@ -49,6 +55,7 @@ enum log_rpc_cmd_backend {
 	LOG_RPC_CMD_INVALIDATE_CRASH_DUMP,
 	LOG_RPC_CMD_ECHO,
 	LOG_RPC_CMD_SET_TIME,
+	LOG_RPC_CMD_GET_STATS,
 };
 
 #ifdef __cplusplus
@@ -11,6 +11,10 @@
 #include <zephyr/net/mqtt.h>
 #include <zephyr/logging/log.h>
 
+#if defined(CONFIG_MQTT_HELPER_OUTBOX_SETTINGS)
+#include <zephyr/settings/settings.h>
+#endif
+
 #if defined(CONFIG_MQTT_HELPER_PROVISION_CERTIFICATES)
 #include "mqtt-certs.h"
 #endif
@@ -36,6 +40,30 @@ MQTT_HELPER_STATIC char payload_buf[CONFIG_MQTT_HELPER_PAYLOAD_BUFFER_LEN];
 MQTT_HELPER_STATIC K_SEM_DEFINE(connection_poll_sem, 0, 1);
 static struct mqtt_helper_cfg current_cfg;
 MQTT_HELPER_STATIC enum mqtt_state mqtt_state = MQTT_STATE_UNINIT;
+static uint16_t msg_id;
+
+#if defined(CONFIG_MQTT_HELPER_OUTBOX)
+#define OUTBOX_SETTINGS_KEY "mqtt_helper/outbox"
+
+/* Unacknowledged QoS 1 message. The topic is followed by the payload in the data field. */
+struct outbox_entry {
+	/* Order of publishing, used when the messages are sent again. */
+	uint32_t seq;
+	/* Zero if the entry is free. */
+	uint16_t message_id;
+	uint16_t topic_len;
+	uint16_t payload_len;
+	uint8_t retain;
+	uint8_t data[CONFIG_MQTT_HELPER_OUTBOX_MSG_SIZE];
+};
+
+MQTT_HELPER_STATIC struct outbox_entry outbox[CONFIG_MQTT_HELPER_OUTBOX_MSG_COUNT];
+static uint32_t outbox_seq;
+static K_MUTEX_DEFINE(outbox_lock);
+#if defined(CONFIG_MQTT_HELPER_OUTBOX_SETTINGS)
+static bool outbox_loaded;
+#endif
+#endif /* CONFIG_MQTT_HELPER_OUTBOX */
 
 static const char *state_name_get(enum mqtt_state state)
 {
@@ -241,6 +269,234 @@ static int certificates_provision(void)
 }
 #endif /* CONFIG_MQTT_HELPER_PROVISION_CERTIFICATES */
 
+#if defined(CONFIG_MQTT_HELPER_OUTBOX)
+static size_t outbox_entry_size(const struct outbox_entry *entry)
+{
+	return offsetof(struct outbox_entry, data) + entry->topic_len + entry->payload_len;
+}
+
+static void outbox_entry_store(size_t index)
+{
+#if defined(CONFIG_MQTT_HELPER_OUTBOX_SETTINGS)
+	char key[sizeof(OUTBOX_SETTINGS_KEY "/255")];
+	int err;
+
+	snprintk(key, sizeof(key), OUTBOX_SETTINGS_KEY "/%u", (unsigned int)index);
+
+	if (outbox[index].message_id == 0) {
+		err = settings_delete(key);
+	} else {
+		err = settings_save_one(key, &outbox[index], outbox_entry_size(&outbox[index]));
+	}
+
+	if (err) {
+		LOG_WRN("Failed to store outbox entry %u, error: %d", (unsigned int)index, err);
+	}
+#else
+	ARG_UNUSED(index);
+#endif /* CONFIG_MQTT_HELPER_OUTBOX_SETTINGS */
+}
+
+static struct outbox_entry *outbox_find(uint16_t message_id)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(outbox); i++) {
+		if (outbox[i].message_id == message_id) {
+			return &outbox[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int outbox_add(const struct mqtt_publish_param *param)
+{
+	const struct mqtt_binstr *payload = &param->message.payload;
+	const struct mqtt_utf8 *topic = &param->message.topic.topic;
+	struct outbox_entry *entry;
+
+	if (topic->size + payload->len > CONFIG_MQTT_HELPER_OUTBOX_MSG_SIZE) {
+		LOG_ERR("Message too large for the outbox");
+		return -EMSGSIZE;
+	}
+
+	k_mutex_lock(&outbox_lock, K_FOREVER);
+
+	/* Reuse the entry of a message with the same ID */
+	entry = outbox_find(param->message_id);
+
+	if (entry == NULL) {
+		entry = outbox_find(0);
+	}
+
+	if (entry == NULL) {
+		k_mutex_unlock(&outbox_lock);
+		LOG_ERR("Outbox is full");
+		return -ENOMEM;
+	}
+
+	entry->seq = outbox_seq++;
+	entry->message_id = param->message_id;
+	entry->topic_len = topic->size;
+	entry->payload_len = payload->len;
+	entry->retain = param->retain_flag;
+	memcpy(entry->data, topic->utf8, topic->size);
+	memcpy(entry->data + topic->size, payload->data, payload->len);
+
+	outbox_entry_store(entry - outbox);
+
+	k_mutex_unlock(&outbox_lock);
+
+	return 0;
+}
+
+static void outbox_remove(uint16_t message_id)
+{
+	struct outbox_entry *entry;
+
+	k_mutex_lock(&outbox_lock, K_FOREVER);
+
+	entry = outbox_find(message_id);
+
+	if (entry != NULL) {
+		entry->message_id = 0;
+		outbox_entry_store(entry - outbox);
+	}
+
+	k_mutex_unlock(&outbox_lock);
+}
+
+/* Drop the messages kept in RAM. The stored messages are kept, and they are loaded again
+ * by the next initialization.
+ */
+MQTT_HELPER_STATIC void outbox_clear(void)
+{
+	k_mutex_lock(&outbox_lock, K_FOREVER);
+
+	memset(outbox, 0, sizeof(outbox));
+	outbox_seq = 0;
+
+#if defined(CONFIG_MQTT_HELPER_OUTBOX_SETTINGS)
+	outbox_loaded = false;
+#endif
+
+	k_mutex_unlock(&outbox_lock);
+}
+
+/* Send the unacknowledged messages again, oldest first. */
+static void outbox_resend(void)
+{
+	struct mqtt_publish_param param = {
+		.message.topic.qos = MQTT_QOS_1_AT_LEAST_ONCE,
+		.dup_flag = 1,
+	};
+	uint32_t last_seq = 0;
+	bool first = true;
+	int err;
+
+	k_mutex_lock(&outbox_lock, K_FOREVER);
+
+	while (true) {
+		struct outbox_entry *next = NULL;
+
+		for (size_t i = 0; i < ARRAY_SIZE(outbox); i++) {
+			struct outbox_entry *entry = &outbox[i];
+
+			if (entry->message_id == 0 || (!first && entry->seq <= last_seq)) {
+				continue;
+			}
+
+			if (next == NULL || entry->seq < next->seq) {
+				next = entry;
+			}
+		}
+
+		if (next == NULL) {
+			break;
+		}
+
+		first = false;
+		last_seq = next->seq;
+
+		param.message_id = next->message_id;
+		param.retain_flag = next->retain;
+		param.message.topic.topic.utf8 = next->data;
+		param.message.topic.topic.size = next->topic_len;
+		param.message.payload.data = next->data + next->topic_len;
+		param.message.payload.len = next->payload_len;
+
+		LOG_DBG("Sending unacknowledged message ID %d again", next->message_id);
+
+		err = mqtt_publish(&mqtt_client, &param);
+		if (err) {
+			LOG_WRN("Failed to send outbox message, error: %d", err);
+			break;
+		}
+	}
+
+	k_mutex_unlock(&outbox_lock);
+}
+
+#if defined(CONFIG_MQTT_HELPER_OUTBOX_SETTINGS)
+static int outbox_settings_set(const char *key, size_t len, settings_read_cb read_cb,
+			       void *cb_arg, void *param)
+{
+	struct outbox_entry entry = { 0 };
+	unsigned long index;
+	char *end;
+	ssize_t read;
+
+	ARG_UNUSED(param);
+
+	if (key == NULL) {
+		return 0;
+	}
+
+	index = strtoul(key, &end, 10);
+
+	if (*end != '\0' || index >= ARRAY_SIZE(outbox) || len > sizeof(entry) ||
+	    len < offsetof(struct outbox_entry, data)) {
+		LOG_WRN("Invalid outbox entry: %s", key);
+		return 0;
+	}
+
+	read = read_cb(cb_arg, &entry, len);
+
+	if (read != (ssize_t)len || outbox_entry_size(&entry) != len) {
+		LOG_WRN("Failed to load outbox entry: %s", key);
+		return 0;
+	}
+
+	outbox[index] = entry;
+	outbox_seq = MAX(outbox_seq, entry.seq + 1);
+
+	/* Do not hand out the message IDs that are still waiting for an acknowledgment. */
+	msg_id = MAX(msg_id, entry.message_id);
+
+	return 0;
+}
+
+static void outbox_load(void)
+{
+	int err;
+
+	if (outbox_loaded) {
+		return;
+	}
+
+	k_mutex_lock(&outbox_lock, K_FOREVER);
+
+	err = settings_load_subtree_direct(OUTBOX_SETTINGS_KEY, outbox_settings_set, NULL);
+	if (err) {
+		LOG_WRN("Failed to load the outbox, error: %d", err);
+	} else {
+		outbox_loaded = true;
+	}
+
+	k_mutex_unlock(&outbox_lock);
+}
+#endif /* CONFIG_MQTT_HELPER_OUTBOX_SETTINGS */
+#endif /* CONFIG_MQTT_HELPER_OUTBOX */
+
 static int publish_get_payload(struct mqtt_client *const mqtt_client, size_t length)
 {
 	if (length > sizeof(payload_buf)) {
@@ -267,6 +523,32 @@ static void send_ack(struct mqtt_client *const mqtt_client, uint16_t message_id)
 	LOG_DBG("PUBACK sent for message ID %d", message_id);
 }
 
+/* Pass the payload to the on_publish_chunk callback in chunks of up to the payload buffer size. */
+static int publish_get_payload_chunks(struct mqtt_client *const mqtt_client,
+				      struct mqtt_helper_buf topic, size_t length)
+{
+	struct mqtt_helper_buf chunk = {
+		.ptr = payload_buf,
+	};
+	size_t offset = 0;
+	int err;
+
+	do {
+		chunk.size = MIN(sizeof(payload_buf), length - offset);
+
+		err = mqtt_readall_publish_payload(mqtt_client, payload_buf, chunk.size);
+		if (err) {
+			return err;
+		}
+
+		current_cfg.cb.on_publish_chunk(topic, chunk, offset, length);
+
+		offset += chunk.size;
+	} while (offset < length);
+
+	return 0;
+}
+
 MQTT_HELPER_STATIC void on_publish(const struct mqtt_evt *mqtt_evt)
 {
 	int err;
@@ -279,6 +561,20 @@ MQTT_HELPER_STATIC void on_publish(const struct mqtt_evt *mqtt_evt)
 		.ptr = payload_buf,
 	};
 
+	if (current_cfg.cb.on_publish_chunk) {
+		err = publish_get_payload_chunks(&mqtt_client, topic, p->message.payload.len);
+		if (err) {
+			LOG_ERR("publish_get_payload_chunks, error: %d", err);
+			return;
+		}
+
+		if (p->message.topic.qos == MQTT_QOS_1_AT_LEAST_ONCE) {
+			send_ack(&mqtt_client, p->message_id);
+		}
+
+		return;
+	}
+
 	err = publish_get_payload(&mqtt_client, p->message.payload.len);
 	if (err) {
 		LOG_ERR("publish_get_payload, error: %d", err);
@@ -318,6 +614,10 @@ MQTT_HELPER_STATIC void mqtt_evt_handler(struct mqtt_client *const mqtt_client,
 
 		if (mqtt_evt->param.connack.return_code == MQTT_CONNECTION_ACCEPTED) {
 			mqtt_state_set(MQTT_STATE_CONNECTED);
+
+#if defined(CONFIG_MQTT_HELPER_OUTBOX)
+			outbox_resend();
+#endif
 		} else {
 			mqtt_state_set(MQTT_STATE_DISCONNECTED);
 		}
@@ -347,6 +647,10 @@ MQTT_HELPER_STATIC void mqtt_evt_handler(struct mqtt_client *const mqtt_client,
 			mqtt_evt->param.puback.message_id,
 			mqtt_evt->result);
 
+#if defined(CONFIG_MQTT_HELPER_OUTBOX)
+		outbox_remove(mqtt_evt->param.puback.message_id);
+#endif
+
 		if (current_cfg.cb.on_puback) {
 			current_cfg.cb.on_puback(mqtt_evt->param.puback.message_id,
 						 mqtt_evt->result);
@@ -585,6 +889,10 @@ int mqtt_helper_init(struct mqtt_helper_cfg *cfg)
 
 	mqtt_client_init(&mqtt_client);
 
+#if defined(CONFIG_MQTT_HELPER_OUTBOX_SETTINGS)
+	outbox_load();
+#endif
+
 	mqtt_state_set(MQTT_STATE_DISCONNECTED);
 
 	return 0;
@@ -678,6 +986,8 @@ int mqtt_helper_subscribe(struct mqtt_subscription_list *sub_list)
 
 int mqtt_helper_publish(const struct mqtt_publish_param *param)
 {
+	int err;
+
 	LOG_DBG("Publishing to topic: %.*s",
 		param->message.topic.topic.size,
 		(char *)param->message.topic.topic.utf8);
@@ -695,20 +1005,36 @@ int mqtt_helper_publish(const struct mqtt_publish_param *param)
 		return -EOPNOTSUPP;
 	}
 
-	return mqtt_publish(&mqtt_client, param);
+#if defined(CONFIG_MQTT_HELPER_OUTBOX)
+	if (param->message.topic.qos == MQTT_QOS_1_AT_LEAST_ONCE) {
+		err = outbox_add(param);
+		if (err) {
+			return err;
+		}
+	}
+#endif
+
+	err = mqtt_publish(&mqtt_client, param);
+
+#if defined(CONFIG_MQTT_HELPER_OUTBOX)
+	if (err && param->message.topic.qos == MQTT_QOS_1_AT_LEAST_ONCE) {
+		/* The message was not sent, leave retrying to the caller. */
+		outbox_remove(param->message_id);
+	}
+#endif
+
+	return err;
 }
 
 uint16_t mqtt_helper_msg_id_get(void)
 {
-	static uint16_t id;
-
-	id++;
+	msg_id++;
 
-	if (id == 0) {
-		id++;
+	if (msg_id == 0) {
+		msg_id++;
 	}
 
-	return id;
+	return msg_id;
 }
 
 int mqtt_helper_deinit(void)
@@ -724,6 +1050,10 @@ int mqtt_helper_deinit(void)
 	memset(&current_cfg, 0, sizeof(current_cfg));
 	memset(&mqtt_client, 0, sizeof(mqtt_client));
 
+#if defined(CONFIG_MQTT_HELPER_OUTBOX)
+	outbox_clear();
+#endif
+
 	mqtt_state_set(MQTT_STATE_UNINIT);
 
 	return 0;
@@ -798,6 +798,64 @@ int nrf_cloud_coap_shadow_service_info_update(const struct nrf_cloud_svc_info *
 	return nrf_cloud_coap_shadow_device_status_update(&dev_status);
 }
 
+static void shadow_control_reply(int err, struct nrf_cloud_data *const out_data)
+{
+	if ((err == -ENODATA) || (err == -ENOMSG)) {
+		/* No control data in the delta or no reply is needed */
+	} else if ((err == -EINVAL) || (err == 0)) {
+		const char *action = err ? "reject" : "acknowledge";
+
+		LOG_DBG("delta: len:%zd, %s", out_data->len, (const char *)out_data->ptr);
+
+		/* Acknowledge it or reject it so we do not receive it again. */
+		if (!err) {
+			err = nrf_cloud_coap_shadow_state_update(out_data->ptr);
+		} else {
+			err = nrf_cloud_coap_shadow_desired_update(out_data->ptr);
+		}
+		if (err) {
+			LOG_ERR("Failed to %s control delta: %d", action, err);
+		} else {
+			LOG_DBG("Control delta: %s", action);
+		}
+
+		nrf_cloud_free((void *)out_data->ptr);
+		out_data->ptr = NULL;
+		out_data->len = 0;
+	} else {
+		LOG_ERR("Failed to process device control shadow update, error: %d", err);
+	}
+}
+
+#if defined(CONFIG_NRF_CLOUD_SHADOW_SCAN)
+/* Process a delta that only contains the control section without building a cJSON tree.
+ * Returns false if the delta must be decoded, because it contains data for the
+ * application or default nRF Cloud shadow content.
+ */
+static bool shadow_delta_scan_process(const struct nrf_cloud_data *const in_data)
+{
+	struct nrf_cloud_shadow_scan_result scan;
+	struct nrf_cloud_data out_data = {0};
+	int err;
+
+	/* Same requirement as for decoding the delta */
+	if (!in_data->ptr || !in_data->len || !memchr(in_data->ptr, '\0', in_data->len + 1)) {
+		return false;
+	}
+
+	err = nrf_cloud_shadow_scan(in_data->ptr, strlen(in_data->ptr),
+				    NRF_CLOUD_SHADOW_SCAN_DOC_DELTA_STATE, &scan);
+	if (err || !scan.state_found || (scan.state_items > 0)) {
+		return false;
+	}
+
+	err = nrf_cloud_shadow_control_scan_process(&scan, true, &out_data);
+	shadow_control_reply(err, &out_data);
+
+	return true;
+}
+#endif /* CONFIG_NRF_CLOUD_SHADOW_SCAN */
+
 int nrf_cloud_coap_shadow_delta_process(const struct nrf_cloud_data *in_data,
 					struct nrf_cloud_obj *const delta_out)
 {
@@ -810,6 +868,12 @@ int nrf_cloud_coap_shadow_delta_process(const struct nrf_cloud_data *in_data,
 	struct nrf_cloud_obj_shadow_delta shadow_delta = {0};
 	struct nrf_cloud_obj_shadow_data shadow_data;
 
+#if defined(CONFIG_NRF_CLOUD_SHADOW_SCAN)
+	if (shadow_delta_scan_process(in_data)) {
+		return 0;
+	}
+#endif
+
 	/* CoAP delta data does not have a "state" object, so decode directly to
 	 * the object in the nrf_cloud_obj_shadow_delta struct.
 	 */
@@ -842,31 +906,7 @@ int nrf_cloud_coap_shadow_delta_process(const struct nrf_cloud_data *in_data,
 
 	/* Process the potential control section of the delta */
 	err = nrf_cloud_shadow_control_process(&shadow_data, &out_data);
-	if ((err == -ENODATA) || (err == -ENOMSG)) {
-		/* No control data in the delta or no reply is needed */
-	} else if ((err == -EINVAL) || (err == 0)) {
-		const char *action = err ? "reject" : "acknowledge";
-
-		LOG_DBG("delta: len:%zd, %s", out_data.len, (const char *)out_data.ptr);
-
-		/* Acknowledge it or reject it so we do not receive it again. */
-		if (!err) {
-			err = nrf_cloud_coap_shadow_state_update(out_data.ptr);
-		} else {
-			err = nrf_cloud_coap_shadow_desired_update(out_data.ptr);
-		}
-		if (err) {
-			LOG_ERR("Failed to %s control delta: %d", action, err);
-		} else {
-			LOG_DBG("Control delta: %s", action);
-		}
-
-		nrf_cloud_free((void *)out_data.ptr);
-		out_data.ptr = NULL;
-		out_data.len = 0;
-	} else {
-		LOG_ERR("Failed to process device control shadow update, error: %d", err);
-	}
+	shadow_control_reply(err, &out_data);
 
 	/* Check if there is delta data to give to the caller */
 	if ((delta_out != NULL) &&
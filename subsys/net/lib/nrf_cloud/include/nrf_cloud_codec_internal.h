@@ -32,6 +32,7 @@
 #include "nrf_cloud_log_internal.h"
 #include "nrf_cloud_fota.h"
 #include "nrf_cloud_transport.h"
+#include "nrf_cloud_shadow_scan.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -93,6 +94,15 @@ int nrf_cloud_alert_encode(const struct nrf_cloud_alert_info *alert,
 int nrf_cloud_sensor_data_encode(const struct nrf_cloud_sensor_data *input,
 				 struct nrf_cloud_data *output);
 
+/** @brief Encode a cellular and/or Wi-Fi location request device message using the JSON
+ *  writer. Same output and error codes as nrf_cloud_obj_location_request_create().
+ *  Caller must free the output pointer when done.
+ */
+int nrf_cloud_location_request_msg_encode(const struct lte_lc_cells_info *const cells_inf,
+					  const struct wifi_scan_info *const wifi_inf,
+					  const struct nrf_cloud_location_config *const config,
+					  struct nrf_cloud_data *output);
+
 /** @brief Encode general message of either a given numeric value or, if not NULL,
  *  a string value.  If topic is present, that topic will be used.
  */
@@ -171,6 +181,14 @@ int nrf_cloud_shadow_control_response_encode(struct nrf_cloud_ctrl_data const *c
 int nrf_cloud_shadow_control_process(struct nrf_cloud_obj_shadow_data *const input,
 				     struct nrf_cloud_data *const response_out);
 
+/** @brief Act on the control section found by @ref nrf_cloud_shadow_scan, in the same way
+ * as @ref nrf_cloud_shadow_control_process. Set delta to true if the scanned document is a
+ * shadow delta.
+ */
+int nrf_cloud_shadow_control_scan_process(const struct nrf_cloud_shadow_scan_result *const scan,
+					  const bool delta,
+					  struct nrf_cloud_data *const response_out);
+
 /** @brief Parse shadow data for default nRF Cloud shadow content. This data is not
  * needed by CoAP devices, but it needs to be acknowledged to remove the shadow delta.
  */
@@ -296,6 +314,9 @@ int nrf_cloud_obj_location_request_payload_add(struct nrf_cloud_obj *const obj,
 int nrf_cloud_wifi_req_json_encode(struct wifi_scan_info const *const wifi,
 				   cJSON *const req_obj_out);
 
+/** @brief Check if the MAC address is a local address, which is not used for Wi-Fi location. */
+bool nrf_cloud_wifi_mac_is_local(const uint8_t *const mac);
+
 /** @brief Get the required information from the modem for a single-cell location request. */
 int nrf_cloud_get_single_cell_modem_info(struct lte_lc_cell *const cell_inf);
 
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRF_CLOUD_JSON_WRITER_H__
+#define NRF_CLOUD_JSON_WRITER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <modem/lte_lc.h>
+#include <net/wifi_location_common.h>
+#include <net/nrf_cloud.h>
+#include <net/nrf_cloud_alert.h>
+#include <net/nrf_cloud_location.h>
+#include "nrf_cloud_log_internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum nesting depth of objects and arrays */
+#define NRF_CLOUD_JSON_WRITER_DEPTH_MAX 8
+
+/** @brief State of a JSON document written directly into a buffer.
+ *
+ * The output is identical to the unformatted output of cJSON for the same
+ * items added in the same order, but no tree is built and nothing is allocated.
+ * If the buffer is NULL, nothing is written and only the length is computed.
+ * Errors are sticky and reported by @ref nrf_cloud_json_writer_done.
+ */
+struct nrf_cloud_json_writer {
+	/** Output buffer, or NULL to only compute the length */
+	char *buf;
+	/** Size of the output buffer */
+	size_t size;
+	/** Length of the output, which may exceed the buffer size */
+	size_t len;
+	/** First error that occurred */
+	int err;
+	/** Current nesting depth */
+	uint8_t depth;
+	/** Bit n is set if the container at depth n already has an item */
+	uint8_t has_items;
+};
+
+/** @brief Initialize the writer to write into the provided buffer.
+ *  If buf is NULL, only the length of the output is computed.
+ */
+void nrf_cloud_json_writer_init(struct nrf_cloud_json_writer *const w, char *const buf,
+				const size_t size);
+
+/** @brief Allocate a buffer for the output length computed by a previous pass
+ *  and reset the writer to write into it. The buffer must be freed with cJSON_free().
+ *
+ * @retval 0 Success.
+ * @retval -ENOMEM Out of memory.
+ */
+int nrf_cloud_json_writer_alloc(struct nrf_cloud_json_writer *const w);
+
+/** @brief Start an object. The key must be NULL for the root object and array elements. */
+void nrf_cloud_json_obj_start(struct nrf_cloud_json_writer *const w, const char *const key);
+
+/** @brief End the current object. */
+void nrf_cloud_json_obj_end(struct nrf_cloud_json_writer *const w);
+
+/** @brief Start an array. The key must be NULL for array elements. */
+void nrf_cloud_json_arr_start(struct nrf_cloud_json_writer *const w, const char *const key);
+
+/** @brief End the current array. */
+void nrf_cloud_json_arr_end(struct nrf_cloud_json_writer *const w);
+
+/** @brief Add a string. A NULL string sets the -EINVAL error. */
+void nrf_cloud_json_str_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const char *const val);
+
+/** @brief Add a number, formatted as cJSON formats it. */
+void nrf_cloud_json_num_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const double val);
+
+/** @brief Add a boolean. */
+void nrf_cloud_json_bool_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			     const bool val);
+
+/** @brief Finish the document and NULL-terminate the output.
+ *
+ * @retval 0 Success.
+ * @retval -ENOMEM The buffer is too small; the len field holds the required length.
+ * @retval -E2BIG Objects and arrays are nested too deep.
+ * @retval -EINVAL Invalid item or unbalanced objects and arrays.
+ */
+int nrf_cloud_json_writer_done(struct nrf_cloud_json_writer *const w);
+
+/** @brief Write a sensor data device message.
+ *  Same output as nrf_cloud_sensor_data_encode().
+ */
+int nrf_cloud_sensor_data_json_write(struct nrf_cloud_json_writer *const w,
+				     const struct nrf_cloud_sensor_data *const sensor);
+
+/** @brief Write a GNSS device message.
+ *  Same output as nrf_cloud_gnss_msg_json_encode() on an empty object.
+ */
+int nrf_cloud_gnss_msg_json_write(struct nrf_cloud_json_writer *const w,
+				  const struct nrf_cloud_gnss_data *const gnss);
+
+/** @brief Write an alert device message.
+ *  Same output as nrf_cloud_alert_encode().
+ */
+int nrf_cloud_alert_json_write(struct nrf_cloud_json_writer *const w,
+			       const struct nrf_cloud_alert_info *const alert);
+
+/** @brief Write a log device message.
+ *  Same output as nrf_cloud_log_json_encode().
+ */
+int nrf_cloud_log_json_write(struct nrf_cloud_json_writer *const w,
+			     const struct nrf_cloud_log_context *const ctx,
+			     const char *const msg);
+
+/** @brief Write a cellular and/or Wi-Fi location request device message.
+ *  Same output as nrf_cloud_obj_location_request_create(), and the same error codes.
+ */
+int nrf_cloud_location_req_json_write(struct nrf_cloud_json_writer *const w,
+				      const struct lte_lc_cells_info *const cells_inf,
+				      const struct wifi_scan_info *const wifi_inf,
+				      const struct nrf_cloud_location_config *const config);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_CLOUD_JSON_WRITER_H__ */
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRF_CLOUD_SHADOW_SCAN_H__
+#define NRF_CLOUD_SHADOW_SCAN_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum nesting depth of objects and arrays in a scanned shadow document */
+#define NRF_CLOUD_SHADOW_SCAN_DEPTH_MAX 32
+
+/** @brief Layout of the scanned shadow document. */
+enum nrf_cloud_shadow_scan_doc {
+	/** MQTT delta: "version", "timestamp" and the changes in the "state" object. */
+	NRF_CLOUD_SHADOW_SCAN_DOC_DELTA,
+	/** CoAP delta: the changes are in the root object. */
+	NRF_CLOUD_SHADOW_SCAN_DOC_DELTA_STATE,
+	/** Accepted (trimmed) shadow: "desired", "reported" and "config" objects. */
+	NRF_CLOUD_SHADOW_SCAN_DOC_ACCEPTED,
+};
+
+/** @brief Result of a shadow document scan. */
+struct nrf_cloud_shadow_scan_result {
+	/** Shadow version, valid if ver_found is true */
+	int ver;
+	/** Shadow timestamp, valid if ts_found is true */
+	int64_t ts;
+	/** The "version" number is present */
+	bool ver_found;
+	/** The "timestamp" number is present */
+	bool ts_found;
+	/** The state (or desired) object is present */
+	bool state_found;
+	/** Number of state (or desired) items other than the control section */
+	uint16_t state_items;
+	/** A control object is present, in the desired or else the reported section */
+	bool ctrl_found;
+	/** The control object contains an invalid value */
+	bool ctrl_invalid;
+	/** The control object contains the alerts setting */
+	bool alerts_found;
+	/** Alerts setting */
+	bool alerts_enabled;
+	/** The control object contains the log level */
+	bool log_found;
+	/** Log level */
+	int log_level;
+	/** Deepest nesting level in the document */
+	uint8_t depth_max;
+};
+
+/** @brief Scan a shadow document without building a cJSON tree.
+ *
+ * The document is scanned once and nothing is allocated. Keys are matched
+ * the same way cJSON_GetObjectItem() does: case-insensitive, and only the first
+ * occurrence of a key in an object is used.
+ *
+ * @param[in] buf Shadow document, does not need to be NULL-terminated.
+ * @param[in] len Length of the shadow document.
+ * @param[in] doc Layout of the shadow document.
+ * @param[out] result Scan result.
+ *
+ * @retval 0 Success.
+ * @retval -EBADMSG The document is not valid JSON.
+ * @retval -E2BIG Objects and arrays are nested too deep.
+ * @retval -ENOTSUP A key of a shadow section contains an escape sequence.
+ */
+int nrf_cloud_shadow_scan(const char *const buf, const size_t len,
+			  const enum nrf_cloud_shadow_scan_doc doc,
+			  struct nrf_cloud_shadow_scan_result *const result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_CLOUD_SHADOW_SCAN_H__ */
@@ -9,6 +9,7 @@
 #include "nrf_cloud_fsm.h"
 #include <net/nrf_cloud_codec.h>
 #include "nrf_cloud_log_internal.h"
+#include "nrf_cloud_json_writer.h"
 #include <net/nrf_cloud_location.h>
 #include <net/nrf_cloud_alert.h>
 #include <net/nrf_cloud_log.h>
@@ -410,6 +411,24 @@ static bool compare(const char *s1, const char *s2)
 	return !strncmp(s1, s2, strlen(s2));
 }
 
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+/* Pass the buffer allocated for the second pass of a writer to the output */
+static int json_writer_output_get(struct nrf_cloud_json_writer *const w, const int err,
+				  struct nrf_cloud_data *const output)
+{
+	if (err) {
+		if (w->buf) {
+			cJSON_free(w->buf);
+		}
+		return err;
+	}
+
+	output->ptr = w->buf;
+	output->len = w->len;
+	return 0;
+}
+#endif /* CONFIG_NRF_CLOUD_JSON_WRITER */
+
 int nrf_cloud_sensor_data_encode(const struct nrf_cloud_sensor_data *sensor,
 				 struct nrf_cloud_data *output)
 {
@@ -421,6 +440,17 @@ int nrf_cloud_sensor_data_encode(const struct nrf_cloud_sensor_data *sensor,
 	__ASSERT_NO_MSG(output != NULL);
 	__ASSERT_NO_MSG(sensor->type < SENSOR_TYPE_ARRAY_SIZE);
 
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+	struct nrf_cloud_json_writer w;
+
+	/* The first pass computes the length, the second one fills the allocated buffer */
+	nrf_cloud_json_writer_init(&w, NULL, 0);
+	ret = nrf_cloud_sensor_data_json_write(&w, sensor);
+	ret = ret ? ret : nrf_cloud_json_writer_alloc(&w);
+	ret = ret ? ret : nrf_cloud_sensor_data_json_write(&w, sensor);
+
+	return json_writer_output_get(&w, ret, output);
+#else
 	cJSON *root_obj = cJSON_CreateObject();
 
 	if (root_obj == NULL) {
@@ -453,8 +483,29 @@ int nrf_cloud_sensor_data_encode(const struct nrf_cloud_sensor_data *sensor,
 	output->len = strlen(buffer);
 
 	return 0;
+#endif /* CONFIG_NRF_CLOUD_JSON_WRITER */
 }
 
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+int nrf_cloud_location_request_msg_encode(const struct lte_lc_cells_info *const cells_inf,
+					  const struct wifi_scan_info *const wifi_inf,
+					  const struct nrf_cloud_location_config *const config,
+					  struct nrf_cloud_data *output)
+{
+	struct nrf_cloud_json_writer w;
+	int ret;
+
+	__ASSERT_NO_MSG(output != NULL);
+
+	nrf_cloud_json_writer_init(&w, NULL, 0);
+	ret = nrf_cloud_location_req_json_write(&w, cells_inf, wifi_inf, config);
+	ret = ret ? ret : nrf_cloud_json_writer_alloc(&w);
+	ret = ret ? ret : nrf_cloud_location_req_json_write(&w, cells_inf, wifi_inf, config);
+
+	return json_writer_output_get(&w, ret, output);
+}
+#endif /* CONFIG_NRF_CLOUD_JSON_WRITER */
+
 int nrf_cloud_state_encode(uint32_t reported_state, const bool update_desired_topic,
 			   const bool add_info_sections, struct nrf_cloud_data *output)
 {
@@ -2602,7 +2653,7 @@ int nrf_cloud_obj_location_request_payload_add(struct nrf_cloud_obj *const obj,
  *  or
  * - An address in the reserved IANA Unicast range: 00:00:5E:00:00:00 - 00:00:5E:FF:FF:FF.
  */
-static bool is_local_mac(const uint8_t *const mac)
+bool nrf_cloud_wifi_mac_is_local(const uint8_t *const mac)
 {
 	return ((mac[0] & 0x02) ||
 		((mac[0] == 0x00) && (mac[1] == 0x00) && (mac[2] == 0x5E)));
@@ -2637,7 +2688,7 @@ int nrf_cloud_wifi_req_json_encode(struct wifi_scan_info const *const wifi,
 		cJSON *ap_obj;
 		int ret;
 
-		if (is_local_mac(ap->mac)) {
+		if (nrf_cloud_wifi_mac_is_local(ap->mac)) {
 			LOG_DBG("Skipping local MAC %02x:%02x:%02x:...",
 				ap->mac[0], ap->mac[1], ap->mac[2]);
 			continue;
@@ -3150,6 +3201,16 @@ int nrf_cloud_alert_encode(const struct nrf_cloud_alert_info *alert, struct nrf_
 	__ASSERT_NO_MSG(alert != NULL);
 	__ASSERT_NO_MSG(output != NULL);
 
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+	struct nrf_cloud_json_writer w;
+
+	nrf_cloud_json_writer_init(&w, NULL, 0);
+	ret = nrf_cloud_alert_json_write(&w, alert);
+	ret = ret ? ret : nrf_cloud_json_writer_alloc(&w);
+	ret = ret ? ret : nrf_cloud_alert_json_write(&w, alert);
+
+	return json_writer_output_get(&w, ret, output);
+#else
 	cJSON *root_obj = cJSON_CreateObject();
 
 	if (root_obj == NULL) {
@@ -3189,6 +3250,7 @@ int nrf_cloud_alert_encode(const struct nrf_cloud_alert_info *alert, struct nrf_
 
 	output->ptr = buffer;
 	output->len = strlen(buffer);
+#endif /* CONFIG_NRF_CLOUD_JSON_WRITER */
 #else
 	ARG_UNUSED(alert);
 	output->ptr = NULL;
@@ -3735,6 +3797,19 @@ static int encode_json_log(struct nrf_cloud_log_context *ctx, uint8_t *buf, size
 			   struct nrf_cloud_data *output)
 {
 	int ret;
+
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+	struct nrf_cloud_json_writer w;
+
+	ARG_UNUSED(size);
+
+	nrf_cloud_json_writer_init(&w, NULL, 0);
+	ret = nrf_cloud_log_json_write(&w, ctx, (const char *)buf);
+	ret = ret ? ret : nrf_cloud_json_writer_alloc(&w);
+	ret = ret ? ret : nrf_cloud_log_json_write(&w, ctx, (const char *)buf);
+
+	return json_writer_output_get(&w, ret, output);
+#else
 	cJSON *root_obj = cJSON_CreateObject();
 
 	if (root_obj == NULL) {
@@ -3775,6 +3850,7 @@ static int encode_json_log(struct nrf_cloud_log_context *ctx, uint8_t *buf, size
 	output->ptr = buffer;
 	output->len = strlen(buffer);
 	return 0;
+#endif /* CONFIG_NRF_CLOUD_JSON_WRITER */
 }
 
 int nrf_cloud_log_json_encode(struct nrf_cloud_log_context *ctx, uint8_t *buf, size_t size,
@@ -4033,6 +4109,53 @@ int nrf_cloud_coap_shadow_default_process(struct nrf_cloud_obj_shadow_data *cons
 	return err;
 }
 
+static int shadow_control_update(enum nrf_cloud_ctrl_status ctrl_status,
+				 struct nrf_cloud_ctrl_data const *const device_ctrl,
+				 struct nrf_cloud_ctrl_data const *const cloud_ctrl,
+				 struct nrf_cloud_data *const response_out)
+{
+	int err;
+
+	/* Diff cloud/device control settings */
+	if (ctrl_status != NRF_CLOUD_CTRL_REJECT) {
+
+		if (device_ctrl->alerts_enabled != cloud_ctrl->alerts_enabled) {
+			ctrl_status = NRF_CLOUD_CTRL_REPLY;
+#if defined(CONFIG_NRF_CLOUD_ALERT)
+			nrf_cloud_alert_control_set(cloud_ctrl->alerts_enabled);
+#endif /* CONFIG_NRF_CLOUD_ALERT */
+		}
+
+		if (device_ctrl->log_level != cloud_ctrl->log_level) {
+			ctrl_status = NRF_CLOUD_CTRL_REPLY;
+			nrf_cloud_log_control_set(cloud_ctrl->log_level);
+		}
+	}
+
+	if (ctrl_status == NRF_CLOUD_CTRL_NO_REPLY) {
+		LOG_DBG("No need to reply to control settings");
+		return -ENOMSG;
+	}
+
+	if (response_out) {
+		/* Encode reply; reject with device data or confirm with cloud data */
+		err = nrf_cloud_shadow_control_response_encode(
+			((ctrl_status == NRF_CLOUD_CTRL_REJECT) ? device_ctrl : cloud_ctrl),
+			(ctrl_status == NRF_CLOUD_CTRL_REPLY),
+			response_out);
+
+		if (err) {
+			LOG_ERR("nrf_cloud_shadow_control_response_encode failed %d", err);
+			return -EIO;
+		}
+		if (ctrl_status == NRF_CLOUD_CTRL_REJECT) {
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
 int nrf_cloud_shadow_control_process(struct nrf_cloud_obj_shadow_data *const input,
 				     struct nrf_cloud_data *const response_out)
 {
@@ -4070,42 +4193,45 @@ int nrf_cloud_shadow_control_process(struct nrf_cloud_obj_shadow_data *const inp
 	/* Done with the control object */
 	nrf_cloud_obj_free(&ctrl_obj);
 
-	/* Diff cloud/device control settings */
-	if (ctrl_status != NRF_CLOUD_CTRL_REJECT) {
+	return shadow_control_update(ctrl_status, &device_ctrl, &cloud_ctrl, response_out);
+}
 
-		if (device_ctrl.alerts_enabled != cloud_ctrl.alerts_enabled) {
-			ctrl_status = NRF_CLOUD_CTRL_REPLY;
-#if defined(CONFIG_NRF_CLOUD_ALERT)
-			nrf_cloud_alert_control_set(cloud_ctrl.alerts_enabled);
-#endif /* CONFIG_NRF_CLOUD_ALERT */
-		}
+#if defined(CONFIG_NRF_CLOUD_SHADOW_SCAN)
+int nrf_cloud_shadow_control_scan_process(const struct nrf_cloud_shadow_scan_result *const scan,
+					  const bool delta,
+					  struct nrf_cloud_data *const response_out)
+{
+	__ASSERT_NO_MSG(scan != NULL);
 
-		if (device_ctrl.log_level != cloud_ctrl.log_level) {
-			ctrl_status = NRF_CLOUD_CTRL_REPLY;
-			nrf_cloud_log_control_set(cloud_ctrl.log_level);
-		}
-	}
+	enum nrf_cloud_ctrl_status ctrl_status;
+	struct nrf_cloud_ctrl_data cloud_ctrl;
+	struct nrf_cloud_ctrl_data device_ctrl = {0};
 
-	if (ctrl_status == NRF_CLOUD_CTRL_NO_REPLY) {
-		LOG_DBG("No need to reply to control settings");
-		return -ENOMSG;
+	if (!scan->ctrl_found) {
+		/* No control to process */
+		return -ENODATA;
 	}
 
-	if (response_out) {
-		/* Encode reply; reject with device data or confirm with cloud data */
-		err = nrf_cloud_shadow_control_response_encode(
-			((ctrl_status == NRF_CLOUD_CTRL_REJECT) ? &device_ctrl : &cloud_ctrl),
-			(ctrl_status == NRF_CLOUD_CTRL_REPLY),
-			response_out);
+	/* A delta needs a reply */
+	ctrl_status = delta ? NRF_CLOUD_CTRL_REPLY : NRF_CLOUD_CTRL_NO_REPLY;
 
-		if (err) {
-			LOG_ERR("nrf_cloud_shadow_control_response_encode failed %d", err);
-			return -EIO;
+	/* Get current device control status */
+	nrf_cloud_device_control_get(&device_ctrl);
+	/* Set cloud equal to device, then diff later */
+	cloud_ctrl = device_ctrl;
+
+	if (scan->ctrl_invalid) {
+		/* There was an invalid value, correct (reject) it */
+		ctrl_status = NRF_CLOUD_CTRL_REJECT;
+	} else {
+		if (scan->alerts_found) {
+			cloud_ctrl.alerts_enabled = scan->alerts_enabled;
 		}
-		if (ctrl_status == NRF_CLOUD_CTRL_REJECT) {
-			return -EINVAL;
+		if (scan->log_found) {
+			cloud_ctrl.log_level = scan->log_level;
 		}
 	}
 
-	return 0;
+	return shadow_control_update(ctrl_status, &device_ctrl, &cloud_ctrl, response_out);
 }
+#endif /* CONFIG_NRF_CLOUD_SHADOW_SCAN */
@@ -8,6 +8,7 @@
 #include "nrf_cloud_codec_internal.h"
 #include "nrf_cloud_mem.h"
 #include "nrf_cloud_transport.h"
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <net/nrf_cloud_alert.h>
 #include <net/nrf_cloud_codec.h>
@@ -385,6 +386,26 @@ static int set_endpoint_data(const struct nrf_cloud_obj_shadow_data *const input
 	return 0;
 }
 
+static void shadow_control_reply(int err, struct nct_cc_data *const msg)
+{
+	if (err == -ENODATA) {
+		return;
+	} else if (err == -ENOMSG) {
+		LOG_DBG("No reply needed for device control shadow update");
+		return;
+	} else if (err) {
+		LOG_ERR("Failed to process device control shadow update, error: err");
+		return;
+	}
+
+	LOG_DBG("Confirming device control in shadow: %s", (const char *)msg->data.ptr);
+	err = nct_cc_send(msg);
+	nrf_cloud_free((void *)msg->data.ptr);
+	if (err) {
+		LOG_ERR("nct_cc_send failed %d", err);
+	}
+}
+
 static void shadow_control_process(struct nrf_cloud_obj_shadow_data *const input)
 {
 	if (input->type == NRF_CLOUD_OBJ_SHADOW_TYPE_TF) {
@@ -397,23 +418,43 @@ static void shadow_control_process(struct nrf_cloud_obj_shadow_data *const input
 	};
 	int err = nrf_cloud_shadow_control_process(input, &msg.data);
 
-	if (err == -ENODATA) {
-		return;
-	} else if (err == -ENOMSG) {
-		LOG_DBG("No reply needed for device control shadow update");
-		return;
-	} else if (err) {
-		LOG_ERR("Failed to process device control shadow update, error: err");
-		return;
+	shadow_control_reply(err, &msg);
+}
+
+#if defined(CONFIG_NRF_CLOUD_SHADOW_SCAN)
+/* Process a delta that only contains the control section without building a cJSON tree.
+ * Returns false if the delta must be decoded, because it contains data for the
+ * application or for the device/cloud association.
+ */
+static bool shadow_delta_scan_process(const struct nrf_cloud_data *const data)
+{
+	struct nrf_cloud_shadow_scan_result scan;
+	struct nct_cc_data msg = {
+		.opcode = NCT_CC_OPCODE_UPDATE_ACCEPTED,
+		.message_id = NCT_MSG_ID_STATE_REPORT
+	};
+	int err;
+
+	/* Same requirement as for decoding the delta */
+	if (!data->ptr || !data->len || !memchr(data->ptr, '\0', data->len + 1)) {
+		return false;
 	}
 
-	LOG_DBG("Confirming device control in shadow: %s", (const char *)msg.data.ptr);
-	err = nct_cc_send(&msg);
-	nrf_cloud_free((void *)msg.data.ptr);
-	if (err) {
-		LOG_ERR("nct_cc_send failed %d", err);
+	err = nrf_cloud_shadow_scan(data->ptr, strlen(data->ptr), NRF_CLOUD_SHADOW_SCAN_DOC_DELTA,
+				    &scan);
+	if (err || !scan.ver_found || !scan.ts_found || !scan.state_found ||
+	    (scan.state_items > 0)) {
+		return false;
 	}
+
+	LOG_DBG("Delta shadow scanned");
+
+	err = nrf_cloud_shadow_control_scan_process(&scan, true, &msg.data);
+	shadow_control_reply(err, &msg);
+
+	return true;
 }
+#endif /* CONFIG_NRF_CLOUD_SHADOW_SCAN */
 
 static void accept_associated_or_wait_state(enum nfsm_state cur_state, enum nfsm_state new_state,
 					    bool *const accept_state, bool *const do_discon)
@@ -488,6 +529,13 @@ static int cc_rx_data_handler(const struct nct_evt *nct_evt)
 		return 0;
 	}
 
+#if defined(CONFIG_NRF_CLOUD_SHADOW_SCAN)
+	if ((nct_evt->param.cc->opcode == NCT_CC_OPCODE_UPDATE_DELTA) &&
+	    shadow_delta_scan_process(&nct_evt->param.cc->data)) {
+		return 0;
+	}
+#endif
+
 	/* Decode input data */
 	err = nrf_cloud_obj_input_decode(&shadow_obj, &nct_evt->param.cc->data);
 	if (err) {
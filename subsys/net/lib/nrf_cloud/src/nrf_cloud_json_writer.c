@@ -0,0 +1,685 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+#include <math.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <modem/modem_info.h>
+#include <net/nrf_cloud_defs.h>
+#include <net/nrf_cloud_codec.h>
+#if defined(CONFIG_NRF_MODEM)
+#include <nrf_modem_gnss.h>
+#endif
+#include "cJSON.h"
+#include "nrf_cloud_codec_internal.h"
+#include "nrf_cloud_json_writer.h"
+
+/* Size of the buffer used by cJSON to print numbers */
+#define NUM_BUF_SIZE 26
+
+void nrf_cloud_json_writer_init(struct nrf_cloud_json_writer *const w, char *const buf,
+				const size_t size)
+{
+	__ASSERT_NO_MSG(w != NULL);
+
+	w->buf = buf;
+	w->size = buf ? size : 0;
+	w->len = 0;
+	w->err = 0;
+	w->depth = 0;
+	w->has_items = 0;
+}
+
+int nrf_cloud_json_writer_alloc(struct nrf_cloud_json_writer *const w)
+{
+	char *buf;
+
+	if (w->err) {
+		return w->err;
+	}
+
+	buf = cJSON_malloc(w->len + 1);
+	if (!buf) {
+		return -ENOMEM;
+	}
+
+	nrf_cloud_json_writer_init(w, buf, w->len + 1);
+	return 0;
+}
+
+static void put(struct nrf_cloud_json_writer *const w, const char *const data, size_t len)
+{
+	if (w->buf && (w->len < w->size)) {
+		memcpy(&w->buf[w->len], data, MIN(len, w->size - w->len));
+	}
+	w->len += len;
+}
+
+static void put_char(struct nrf_cloud_json_writer *const w, const char c)
+{
+	put(w, &c, 1);
+}
+
+/* Escape the string the same way cJSON does */
+static void put_string(struct nrf_cloud_json_writer *const w, const char *str)
+{
+	const char *start = str;
+
+	put_char(w, '\"');
+
+	for (; *str; str++) {
+		const unsigned char c = (unsigned char)*str;
+		char esc[7];
+
+		if ((c >= 32) && (c != '\"') && (c != '\\')) {
+			continue;
+		}
+
+		/* Flush the characters that do not need escaping */
+		put(w, start, str - start);
+		start = str + 1;
+
+		switch (c) {
+		case '\"':
+		case '\\':
+			esc[0] = '\\';
+			esc[1] = c;
+			put(w, esc, 2);
+			break;
+		case '\b':
+			put(w, "\\b", 2);
+			break;
+		case '\f':
+			put(w, "\\f", 2);
+			break;
+		case '\n':
+			put(w, "\\n", 2);
+			break;
+		case '\r':
+			put(w, "\\r", 2);
+			break;
+		case '\t':
+			put(w, "\\t", 2);
+			break;
+		default:
+			put(w, esc, snprintf(esc, sizeof(esc), "\\u%04x", c));
+			break;
+		}
+	}
+
+	put(w, start, str - start);
+	put_char(w, '\"');
+}
+
+/* Separate the item from the previous one and add its key, if any */
+static void item_start(struct nrf_cloud_json_writer *const w, const char *const key)
+{
+	const uint8_t bit = BIT(w->depth);
+
+	if (w->has_items & bit) {
+		put_char(w, ',');
+	}
+	w->has_items |= bit;
+
+	if (key) {
+		put_string(w, key);
+		put_char(w, ':');
+	}
+}
+
+static void container_start(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const char open)
+{
+	item_start(w, key);
+	put_char(w, open);
+
+	if (w->depth >= (NRF_CLOUD_JSON_WRITER_DEPTH_MAX - 1)) {
+		if (!w->err) {
+			w->err = -E2BIG;
+		}
+		return;
+	}
+
+	w->depth++;
+	w->has_items &= ~BIT(w->depth);
+}
+
+static void container_end(struct nrf_cloud_json_writer *const w, const char close)
+{
+	if (w->depth == 0) {
+		if (!w->err) {
+			w->err = -EINVAL;
+		}
+		return;
+	}
+
+	w->depth--;
+	put_char(w, close);
+}
+
+void nrf_cloud_json_obj_start(struct nrf_cloud_json_writer *const w, const char *const key)
+{
+	container_start(w, key, '{');
+}
+
+void nrf_cloud_json_obj_end(struct nrf_cloud_json_writer *const w)
+{
+	container_end(w, '}');
+}
+
+void nrf_cloud_json_arr_start(struct nrf_cloud_json_writer *const w, const char *const key)
+{
+	container_start(w, key, '[');
+}
+
+void nrf_cloud_json_arr_end(struct nrf_cloud_json_writer *const w)
+{
+	container_end(w, ']');
+}
+
+void nrf_cloud_json_str_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const char *const val)
+{
+	if (!val) {
+		if (!w->err) {
+			w->err = -EINVAL;
+		}
+		return;
+	}
+
+	item_start(w, key);
+	put_string(w, val);
+}
+
+/* Format the number the same way cJSON does: integers that fit in an int are printed
+ * as such, other numbers with the shortest of 15 or 17 significant digits that
+ * gives back the same value.
+ */
+void nrf_cloud_json_num_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const double val)
+{
+	char num[NUM_BUF_SIZE];
+	int len;
+
+	item_start(w, key);
+
+	if (isnan(val) || isinf(val)) {
+		put(w, "null", 4);
+		return;
+	}
+
+	if ((val < (double)INT_MAX) && (val > (double)INT_MIN) && (val == (double)(int)val)) {
+		len = snprintf(num, sizeof(num), "%d", (int)val);
+	} else {
+		double test;
+
+		len = snprintf(num, sizeof(num), "%1.15g", val);
+		test = strtod(num, NULL);
+
+		if (fabs(test - val) > (MAX(fabs(test), fabs(val)) * DBL_EPSILON)) {
+			len = snprintf(num, sizeof(num), "%1.17g", val);
+		}
+	}
+
+	put(w, num, MIN(len, (int)sizeof(num) - 1));
+}
+
+void nrf_cloud_json_bool_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			     const bool val)
+{
+	item_start(w, key);
+
+	if (val) {
+		put(w, "true", 4);
+	} else {
+		put(w, "false", 5);
+	}
+}
+
+int nrf_cloud_json_writer_done(struct nrf_cloud_json_writer *const w)
+{
+	if (!w->err && (w->depth != 0)) {
+		w->err = -EINVAL;
+	}
+
+	if (w->buf) {
+		if (w->len < w->size) {
+			w->buf[w->len] = '\0';
+		} else {
+			if (w->size) {
+				w->buf[w->size - 1] = '\0';
+			}
+			if (!w->err) {
+				w->err = -ENOMEM;
+			}
+		}
+	}
+
+	return w->err;
+}
+
+int nrf_cloud_sensor_data_json_write(struct nrf_cloud_json_writer *const w,
+				     const struct nrf_cloud_sensor_data *const sensor)
+{
+	const char *app_id;
+
+	if (!w || !sensor || !sensor->data.ptr) {
+		return -EINVAL;
+	}
+
+	app_id = nrf_cloud_sensor_app_id_lookup(sensor->type);
+	if (!app_id) {
+		return -EINVAL;
+	}
+
+	nrf_cloud_json_obj_start(w, NULL);
+	nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_APPID_KEY, app_id);
+	nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_DATA_KEY, sensor->data.ptr);
+	nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_MSG_TYPE_KEY, NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA);
+	if (sensor->ts_ms != NRF_CLOUD_NO_TIMESTAMP) {
+		nrf_cloud_json_num_add(w, NRF_CLOUD_MSG_TIMESTAMP_KEY, sensor->ts_ms);
+	}
+	nrf_cloud_json_obj_end(w);
+
+	return nrf_cloud_json_writer_done(w);
+}
+
+static void pvt_write(struct nrf_cloud_json_writer *const w,
+		      const struct nrf_cloud_gnss_pvt *const pvt)
+{
+	nrf_cloud_json_obj_start(w, NRF_CLOUD_JSON_DATA_KEY);
+	nrf_cloud_json_num_add(w, NRF_CLOUD_JSON_GNSS_PVT_KEY_LON, pvt->lon);
+	nrf_cloud_json_num_add(w, NRF_CLOUD_JSON_GNSS_PVT_KEY_LAT, pvt->lat);
+	nrf_cloud_json_num_add(w, NRF_CLOUD_JSON_GNSS_PVT_KEY_ACCURACY, pvt->accuracy);
+	if (pvt->has_alt) {
+		nrf_cloud_json_num_add(w, NRF_CLOUD_JSON_GNSS_PVT_KEY_ALTITUDE, pvt->alt);
+	}
+	if (pvt->has_speed) {
+		nrf_cloud_json_num_add(w, NRF_CLOUD_JSON_GNSS_PVT_KEY_SPEED, pvt->speed);
+	}
+	if (pvt->has_heading) {
+		nrf_cloud_json_num_add(w, NRF_CLOUD_JSON_GNSS_PVT_KEY_HEADING, pvt->heading);
+	}
+	nrf_cloud_json_obj_end(w);
+}
+
+int nrf_cloud_gnss_msg_json_write(struct nrf_cloud_json_writer *const w,
+				  const struct nrf_cloud_gnss_data *const gnss)
+{
+	const char *nmea = NULL;
+
+	if (!w || !gnss) {
+		return -EINVAL;
+	}
+
+	/* Check the data before anything is written */
+	switch (gnss->type) {
+	case NRF_CLOUD_GNSS_TYPE_PVT:
+		break;
+	case NRF_CLOUD_GNSS_TYPE_MODEM_PVT:
+#if defined(CONFIG_NRF_MODEM)
+		if (!gnss->mdm_pvt) {
+			return -EINVAL;
+		}
+		break;
+#else
+		return -ENOSYS;
+#endif
+	case NRF_CLOUD_GNSS_TYPE_MODEM_NMEA:
+	case NRF_CLOUD_GNSS_TYPE_NMEA:
+		if (gnss->type == NRF_CLOUD_GNSS_TYPE_MODEM_NMEA) {
+#if defined(CONFIG_NRF_MODEM)
+			if (gnss->mdm_nmea) {
+				nmea = gnss->mdm_nmea->nmea_str;
+			}
+#endif
+		} else {
+			nmea = gnss->nmea.sentence;
+		}
+
+		if (nmea == NULL) {
+			return -EINVAL;
+		}
+
+		if (memchr(nmea, '\0', NRF_MODEM_GNSS_NMEA_MAX_LEN) == NULL) {
+			return -EFBIG;
+		}
+		break;
+	default:
+		return -EPROTO;
+	}
+
+	nrf_cloud_json_obj_start(w, NULL);
+	nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_APPID_KEY, NRF_CLOUD_JSON_APPID_VAL_GNSS);
+	nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_MSG_TYPE_KEY, NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA);
+	if (gnss->ts_ms != NRF_CLOUD_NO_TIMESTAMP) {
+		nrf_cloud_json_num_add(w, NRF_CLOUD_MSG_TIMESTAMP_KEY, gnss->ts_ms);
+	}
+
+	if (gnss->type == NRF_CLOUD_GNSS_TYPE_PVT) {
+		pvt_write(w, &gnss->pvt);
+#if defined(CONFIG_NRF_MODEM)
+	} else if (gnss->type == NRF_CLOUD_GNSS_TYPE_MODEM_PVT) {
+		/* Same conversion as nrf_cloud_modem_pvt_data_encode() */
+		struct nrf_cloud_gnss_pvt pvt = {
+			.lon =		gnss->mdm_pvt->longitude,
+			.lat =		gnss->mdm_pvt->latitude,
+			.accuracy =	gnss->mdm_pvt->accuracy,
+			.alt =		gnss->mdm_pvt->altitude,
+			.has_alt =	1,
+			.speed =	gnss->mdm_pvt->speed,
+			.has_speed =	1,
+			.heading =	gnss->mdm_pvt->heading,
+			.has_heading =	1
+		};
+
+		pvt_write(w, &pvt);
+#endif
+	} else {
+		nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_DATA_KEY, nmea);
+	}
+
+	nrf_cloud_json_obj_end(w);
+
+	return nrf_cloud_json_writer_done(w);
+}
+
+int nrf_cloud_alert_json_write(struct nrf_cloud_json_writer *const w,
+			       const struct nrf_cloud_alert_info *const alert)
+{
+	if (!w || !alert) {
+		return -EINVAL;
+	}
+
+	nrf_cloud_json_obj_start(w, NULL);
+	nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_APPID_KEY, NRF_CLOUD_JSON_APPID_VAL_ALERT);
+	nrf_cloud_json_num_add(w, NRF_CLOUD_JSON_ALERT_TYPE, alert->type);
+	if (alert->value != NRF_CLOUD_ALERT_UNUSED_VALUE) {
+		nrf_cloud_json_num_add(w, NRF_CLOUD_JSON_ALERT_VALUE, alert->value);
+	}
+	if (alert->ts_ms > NRF_CLOUD_NO_TIMESTAMP) {
+		nrf_cloud_json_num_add(w, NRF_CLOUD_MSG_TIMESTAMP_KEY, alert->ts_ms);
+	}
+	if ((alert->ts_ms <= NRF_CLOUD_NO_TIMESTAMP) ||
+	    IS_ENABLED(CONFIG_NRF_CLOUD_ALERT_SEQ_ALWAYS)) {
+		nrf_cloud_json_num_add(w, NRF_CLOUD_JSON_ALERT_SEQUENCE, alert->sequence);
+	}
+	if (alert->description != NULL) {
+		nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_ALERT_DESCRIPTION, alert->description);
+	}
+	nrf_cloud_json_obj_end(w);
+
+	return nrf_cloud_json_writer_done(w);
+}
+
+int nrf_cloud_log_json_write(struct nrf_cloud_json_writer *const w,
+			     const struct nrf_cloud_log_context *const ctx,
+			     const char *const msg)
+{
+	if (!w || !msg) {
+		return -EINVAL;
+	}
+
+	nrf_cloud_json_obj_start(w, NULL);
+	nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_APPID_KEY, NRF_CLOUD_JSON_APPID_VAL_LOG);
+	if (ctx != NULL) {
+		nrf_cloud_json_num_add(w, NRF_CLOUD_JSON_LOG_KEY_DOMAIN, ctx->dom_id);
+		nrf_cloud_json_num_add(w, NRF_CLOUD_JSON_LOG_KEY_LEVEL, ctx->level);
+		if (ctx->src_name != NULL) {
+			nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_LOG_KEY_SOURCE, ctx->src_name);
+		}
+		if (ctx->ts > 0) {
+			nrf_cloud_json_num_add(w, NRF_CLOUD_MSG_TIMESTAMP_KEY, ctx->ts);
+		}
+		if (!ctx->ts || IS_ENABLED(CONFIG_NRF_CLOUD_LOG_SEQ_ALWAYS)) {
+			nrf_cloud_json_num_add(w, NRF_CLOUD_JSON_LOG_KEY_SEQUENCE, ctx->sequence);
+		}
+	}
+	nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_LOG_KEY_MESSAGE, msg);
+	nrf_cloud_json_obj_end(w);
+
+	return nrf_cloud_json_writer_done(w);
+}
+
+static void lte_cell_write(struct nrf_cloud_json_writer *const w,
+			   const struct lte_lc_cell *const inf)
+{
+	/* Required parameters for the API call */
+	nrf_cloud_json_num_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_ECI, inf->id);
+	nrf_cloud_json_num_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_MCC, inf->mcc);
+	nrf_cloud_json_num_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_MNC, inf->mnc);
+	nrf_cloud_json_num_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_TAC, inf->tac);
+
+	/* Optional parameters for the API call */
+	if (inf->earfcn != NRF_CLOUD_LOCATION_CELL_OMIT_EARFCN) {
+		nrf_cloud_json_num_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_EARFCN, inf->earfcn);
+	}
+	if (inf->rsrp != NRF_CLOUD_LOCATION_CELL_OMIT_RSRP) {
+		nrf_cloud_json_num_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_RSRP,
+				       RSRP_IDX_TO_DBM(inf->rsrp));
+	}
+	if (inf->rsrq != NRF_CLOUD_LOCATION_CELL_OMIT_RSRQ) {
+		nrf_cloud_json_num_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_RSRQ,
+				       RSRQ_IDX_TO_DB(inf->rsrq));
+	}
+	if (inf->timing_advance != NRF_CLOUD_LOCATION_CELL_OMIT_TIME_ADV) {
+		uint16_t t_adv = inf->timing_advance;
+
+		if (t_adv > NRF_CLOUD_LOCATION_CELL_TIME_ADV_MAX) {
+			t_adv = NRF_CLOUD_LOCATION_CELL_TIME_ADV_MAX;
+		}
+
+		nrf_cloud_json_num_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_T_ADV, t_adv);
+	}
+}
+
+static void ncells_write(struct nrf_cloud_json_writer *const w, const uint8_t ncells_count,
+			 const struct lte_lc_ncell *const neighbor_cells)
+{
+	nrf_cloud_json_arr_start(w, NRF_CLOUD_CELL_POS_JSON_KEY_NBORS);
+
+	for (uint8_t i = 0; i < ncells_count; ++i) {
+		const struct lte_lc_ncell *ncell = neighbor_cells + i;
+
+		nrf_cloud_json_obj_start(w, NULL);
+
+		/* Required parameters for the API call */
+		nrf_cloud_json_num_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_EARFCN, ncell->earfcn);
+		nrf_cloud_json_num_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_PCI, ncell->phys_cell_id);
+
+		/* Optional parameters for the API call */
+		if (ncell->rsrp != NRF_CLOUD_LOCATION_CELL_OMIT_RSRP) {
+			nrf_cloud_json_num_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_RSRP,
+					       RSRP_IDX_TO_DBM(ncell->rsrp));
+		}
+		if (ncell->rsrq != NRF_CLOUD_LOCATION_CELL_OMIT_RSRQ) {
+			nrf_cloud_json_num_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_RSRQ,
+					       RSRQ_IDX_TO_DB(ncell->rsrq));
+		}
+		if (ncell->time_diff != LTE_LC_CELL_TIME_DIFF_INVALID) {
+			nrf_cloud_json_num_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_TDIFF,
+					       ncell->time_diff);
+		}
+
+		nrf_cloud_json_obj_end(w);
+	}
+
+	nrf_cloud_json_arr_end(w);
+}
+
+static void cells_write(struct nrf_cloud_json_writer *const w,
+			const struct lte_lc_cells_info *const inf)
+{
+	nrf_cloud_json_arr_start(w, NRF_CLOUD_CELL_POS_JSON_KEY_LTE);
+
+	/* If using a GCI search type, sometimes there is no current cell */
+	if (inf->current_cell.id != LTE_LC_CELL_EUTRAN_ID_INVALID) {
+		nrf_cloud_json_obj_start(w, NULL);
+		lte_cell_write(w, &inf->current_cell);
+		if (inf->ncells_count && inf->neighbor_cells) {
+			ncells_write(w, inf->ncells_count, inf->neighbor_cells);
+		}
+		nrf_cloud_json_obj_end(w);
+	}
+
+	if (inf->gci_cells_count && inf->gci_cells) {
+		for (uint8_t i = 0; i < inf->gci_cells_count; ++i) {
+			nrf_cloud_json_obj_start(w, NULL);
+			lte_cell_write(w, inf->gci_cells + i);
+			nrf_cloud_json_obj_end(w);
+		}
+	}
+
+	nrf_cloud_json_arr_end(w);
+}
+
+static int wifi_ap_count(const struct wifi_scan_info *const wifi)
+{
+	int cnt = 0;
+
+	for (uint16_t i = 0; i < wifi->cnt; ++i) {
+		if (!nrf_cloud_wifi_mac_is_local(wifi->ap_info[i].mac)) {
+			++cnt;
+		}
+	}
+
+	return cnt;
+}
+
+static void wifi_write(struct nrf_cloud_json_writer *const w,
+		       const struct wifi_scan_info *const wifi)
+{
+	const bool add_all = IS_ENABLED(CONFIG_NRF_CLOUD_WIFI_LOCATION_ENCODE_OPT_ALL);
+	const bool add_rssi = (add_all ||
+			       IS_ENABLED(CONFIG_NRF_CLOUD_WIFI_LOCATION_ENCODE_OPT_MAC_RSSI));
+
+	nrf_cloud_json_obj_start(w, NRF_CLOUD_LOCATION_JSON_KEY_WIFI);
+	nrf_cloud_json_arr_start(w, NRF_CLOUD_LOCATION_JSON_KEY_APS);
+
+	for (uint16_t i = 0; i < wifi->cnt; ++i) {
+		char str_buf[MAX(WIFI_MAC_ADDR_STR_LEN, WIFI_SSID_MAX_LEN) + 1];
+		const struct wifi_scan_result *const ap = wifi->ap_info + i;
+
+		if (nrf_cloud_wifi_mac_is_local(ap->mac)) {
+			continue;
+		}
+
+		nrf_cloud_json_obj_start(w, NULL);
+
+		/* MAC address is the only required parameter for the API call */
+		snprintk(str_buf, sizeof(str_buf), WIFI_MAC_ADDR_TEMPLATE,
+			 ap->mac[0], ap->mac[1], ap->mac[2],
+			 ap->mac[3], ap->mac[4], ap->mac[5]);
+		nrf_cloud_json_str_add(w, NRF_CLOUD_LOCATION_JSON_KEY_WIFI_MAC, str_buf);
+
+		/* Optional parameters for the API call */
+		if (add_rssi && (ap->rssi != NRF_CLOUD_LOCATION_WIFI_OMIT_RSSI)) {
+			nrf_cloud_json_num_add(w, NRF_CLOUD_LOCATION_JSON_KEY_WIFI_RSSI, ap->rssi);
+		}
+
+		if (add_all) {
+			memset(str_buf, 0, sizeof(str_buf));
+			if ((ap->ssid_length > 0) && (ap->ssid_length <= WIFI_SSID_MAX_LEN)) {
+				memcpy(str_buf, ap->ssid, ap->ssid_length);
+			}
+
+			if (str_buf[0] != '\0') {
+				nrf_cloud_json_str_add(w, NRF_CLOUD_LOCATION_JSON_KEY_WIFI_SSID,
+						       str_buf);
+			}
+
+			if (ap->channel != NRF_CLOUD_LOCATION_WIFI_OMIT_CHAN) {
+				nrf_cloud_json_num_add(w, NRF_CLOUD_LOCATION_JSON_KEY_WIFI_CH,
+						       ap->channel);
+			}
+		}
+
+		nrf_cloud_json_obj_end(w);
+	}
+
+	nrf_cloud_json_arr_end(w);
+	nrf_cloud_json_obj_end(w);
+}
+
+int nrf_cloud_location_req_json_write(struct nrf_cloud_json_writer *const w,
+				      const struct lte_lc_cells_info *const cells_inf,
+				      const struct wifi_scan_info *const wifi_inf,
+				      const struct nrf_cloud_location_config *const config)
+{
+	bool add_cells = false;
+	bool add_wifi = false;
+
+	if (!w || (!cells_inf && !wifi_inf)) {
+		return -EINVAL;
+	}
+	if (!cells_inf && (wifi_inf->cnt < NRF_CLOUD_LOCATION_WIFI_AP_CNT_MIN)) {
+		return -EDOM;
+	}
+
+	/* Decide what to include up front, as nothing can be removed once written.
+	 * The rules are those of nrf_cloud_obj_location_request_payload_add().
+	 */
+	if (cells_inf) {
+		add_cells = (cells_inf->current_cell.id != LTE_LC_CELL_EUTRAN_ID_INVALID) ||
+			    (cells_inf->gci_cells_count && cells_inf->gci_cells);
+		if (!add_cells && !wifi_inf) {
+			return -ENODATA;
+		}
+	}
+
+	if (wifi_inf) {
+		if (!wifi_inf->ap_info || !wifi_inf->cnt) {
+			return -EINVAL;
+		}
+
+		add_wifi = (wifi_ap_count(wifi_inf) >= NRF_CLOUD_LOCATION_WIFI_AP_CNT_MIN);
+		if (!add_wifi && !add_cells) {
+			return -ENODATA;
+		}
+	}
+
+	nrf_cloud_json_obj_start(w, NULL);
+	nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_APPID_KEY, NRF_CLOUD_JSON_APPID_VAL_LOCATION);
+	nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_MSG_TYPE_KEY, NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA);
+
+	if (config &&
+	    ((config->do_reply != NRF_CLOUD_LOCATION_DOREPLY_DEFAULT) ||
+	     (config->hi_conf != NRF_CLOUD_LOCATION_HICONF_DEFAULT) ||
+	     (config->fallback != NRF_CLOUD_LOCATION_FALLBACK_DEFAULT))) {
+		nrf_cloud_json_obj_start(w, NRF_CLOUD_LOCATION_JSON_KEY_CONFIG);
+		if (config->do_reply != NRF_CLOUD_LOCATION_DOREPLY_DEFAULT) {
+			nrf_cloud_json_bool_add(w, NRF_CLOUD_LOCATION_JSON_KEY_DOREPLY,
+						config->do_reply);
+		}
+		if (config->hi_conf != NRF_CLOUD_LOCATION_HICONF_DEFAULT) {
+			nrf_cloud_json_bool_add(w, NRF_CLOUD_LOCATION_JSON_KEY_HICONF,
+						config->hi_conf);
+		}
+		if (config->fallback != NRF_CLOUD_LOCATION_FALLBACK_DEFAULT) {
+			nrf_cloud_json_bool_add(w, NRF_CLOUD_LOCATION_JSON_KEY_FALLBACK,
+						config->fallback);
+		}
+		nrf_cloud_json_obj_end(w);
+	}
+
+	nrf_cloud_json_obj_start(w, NRF_CLOUD_JSON_DATA_KEY);
+	if (add_cells) {
+		cells_write(w, cells_inf);
+	}
+	if (add_wifi) {
+		wifi_write(w, wifi_inf);
+	}
+	nrf_cloud_json_obj_end(w);
+
+	nrf_cloud_json_obj_end(w);
+
+	return nrf_cloud_json_writer_done(w);
+}
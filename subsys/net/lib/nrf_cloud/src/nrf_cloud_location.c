@@ -14,6 +14,7 @@
 #include "nrf_cloud_fsm.h"
 #include "nrf_cloud_codec_internal.h"
 #include "nrf_cloud_transport.h"
+#include "nrf_cloud_mem.h"
 
 LOG_MODULE_REGISTER(nrf_cloud_location, CONFIG_NRF_CLOUD_LOG_LEVEL);
 
@@ -32,6 +33,24 @@ int nrf_cloud_location_request(const struct lte_lc_cells_info *const cells_inf,
 	}
 
 	int err = 0;
+
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+	struct nct_dc_data msg = { 0 };
+
+	err = nrf_cloud_location_request_msg_encode(cells_inf, wifi_inf, config, &msg.data);
+	if (!err) {
+		if (!config || (config->do_reply)) {
+			nfsm_set_location_response_cb(cb);
+		}
+
+		err = nct_dc_send(&msg);
+		if (err) {
+			LOG_ERR("Failed to send request, error: %d", err);
+		}
+	}
+
+	nrf_cloud_free((void *)msg.data.ptr);
+#else
 	NRF_CLOUD_OBJ_JSON_DEFINE(location_req_obj);
 
 	err = nrf_cloud_obj_location_request_create(&location_req_obj, cells_inf, wifi_inf,
@@ -45,6 +64,7 @@ int nrf_cloud_location_request(const struct lte_lc_cells_info *const cells_inf,
 	}
 
 	(void)nrf_cloud_obj_free(&location_req_obj);
+#endif /* CONFIG_NRF_CLOUD_JSON_WRITER */
 	return err;
 }
 
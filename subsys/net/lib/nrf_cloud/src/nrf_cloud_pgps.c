@@ -9,6 +9,7 @@
 #include <zephyr/device.h>
 #include <zephyr/storage/stream_flash.h>
 #include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/crc.h>
 
 #include <cJSON.h>
 #include <modem/modem_info.h>
@@ -64,6 +65,26 @@ enum pgps_state {
 };
 static enum pgps_state state;
 
+/* Entry of the RAM directory of stored predictions. The directory is built from flash once
+ * during initialization and then kept up to date as predictions are stored and discarded,
+ * so selecting and validating a prediction does not require reading flash.
+ */
+struct pgps_dir_entry {
+	/* Memory offset to the prediction, or NULL if not stored.
+	 * If flash device is external, this must be passed
+	 * to get_cached_prediction() to read a copy to a local buffer.
+	 * If flash device is internal, it can be converted directly to
+	 * a pointer.
+	 */
+	struct nrf_cloud_pgps_prediction *prediction;
+	/* GPS time, in seconds, when the validity period of the prediction starts. */
+	uint32_t sentinel;
+	/* CRC32 of the stored prediction, to detect changes to flash after validation. */
+	uint32_t crc;
+	/* Prediction has been validated for its place in the prediction set. */
+	bool valid;
+};
+
 struct pgps_index {
 	struct nrf_cloud_pgps_header header;
 	int64_t start_sec;
@@ -81,13 +102,8 @@ struct pgps_index {
 	int32_t storage_extent;
 	int store_block;
 
-	/* Array of memory offsets to predictions, in sorted time order.
-	 * If flash device is external, this must be passed
-	 * to read_prediction() to read a copy to a local buffer.
-	 * If flash device is internal, it can be converted directly to
-	 * a pointer.
-	 */
-	struct nrf_cloud_pgps_prediction *predictions[NUM_PREDICTIONS];
+	/* Directory of stored predictions, in sorted time order. */
+	struct pgps_dir_entry dir[NUM_PREDICTIONS];
 };
 
 static struct pgps_index index;
@@ -109,6 +125,8 @@ static uint8_t prediction_cache[PGPS_PREDICTION_STORAGE_SIZE];
 #endif
 
 static uint8_t prediction_buf[PGPS_PREDICTION_STORAGE_SIZE];
+/* Number of predictions read from flash since the start of the latest prediction search. */
+static uint32_t flash_reads;
 static volatile bool accept_packets;
 static volatile bool loading_in_progress;
 static volatile bool notified;
@@ -140,7 +158,12 @@ static void discard_prediction_buffer(void)
 
 static int get_prediction_block(int pnum)
 {
-	return npgps_pointer_to_block((uint8_t *)index.predictions[pnum]);
+	return npgps_pointer_to_block((uint8_t *)index.dir[pnum].prediction);
+}
+
+static uint32_t get_prediction_crc(const struct nrf_cloud_pgps_prediction *p)
+{
+	return crc32_ieee((const uint8_t *)p, sizeof(*p));
 }
 
 /**
@@ -172,6 +195,7 @@ static struct nrf_cloud_pgps_prediction *get_cached_prediction(off_t off)
 				err, off);
 			return NULL;
 		}
+		flash_reads++;
 		prediction_cache_flash_offset = off;
 		LOG_DBG("Caching offset 0x%X", (uint32_t)(off - prediction_flash_area->fa_off));
 	}
@@ -185,7 +209,7 @@ static struct nrf_cloud_pgps_prediction *get_cached_prediction(off_t off)
 
 static struct nrf_cloud_pgps_prediction *get_prediction(int pnum)
 {
-	off_t off = (off_t)index.predictions[pnum];
+	off_t off = (off_t)index.dir[pnum].prediction;
 
 	return get_cached_prediction(off);
 }
@@ -332,19 +356,20 @@ static int validate_stored_predictions(uint16_t *first_bad_day,
 	uint16_t gps_day = index.header.gps_day;
 	uint32_t gps_time_of_day = index.header.gps_time_of_day;
 	struct nrf_cloud_pgps_prediction *pred;
+	struct pgps_dir_entry *entry;
 	int64_t start_gps_sec = index.start_sec;
 	off_t off;
 	int64_t gps_sec;
 
-	/* reset catalog of predictions */
+	/* reset directory of predictions */
 	discard_prediction_buffer();
-	for (pnum = 0; pnum < count; pnum++) {
-		index.predictions[pnum] = NULL;
-	}
+	memset(index.dir, 0, sizeof(index.dir));
 
 	npgps_reset_block_pool();
 
-	/* build catalog of predictions by block */
+	/* build directory of predictions by block; each prediction is read from
+	 * flash and validated only once
+	 */
 	for (i = 0; i < count; i++) {
 		pred = (struct nrf_cloud_pgps_prediction *)get_prediction_slot(i, &off);
 		if (pred == NULL) {
@@ -357,46 +382,52 @@ static int validate_stored_predictions(uint16_t *first_bad_day,
 			LOG_ERR("prediction idx:%u, ofs:%p, out of expected time range;"
 				" day:%u, time:%u", i, (void *)pred, pred->time.date_day,
 				pred->time.time_full_s);
-		} else if (index.predictions[pnum] == NULL) {
-			index.predictions[pnum] = (struct nrf_cloud_pgps_prediction *)off;
-			LOG_DBG("Prediction num:%u stored at idx:%d, off:0x%lX",
-				pnum, i, (unsigned long) off);
-		} else {
+			continue;
+		}
+
+		entry = &index.dir[pnum];
+		if (entry->prediction != NULL) {
 			LOG_WRN("Prediction num:%u stored more than once!", pnum);
+			continue;
 		}
-	}
 
-	/* validate predictions in time order, independent of storage order */
-	i = -1;
-	for (pnum = 0; pnum < count; pnum++) {
 		/* calculate expected time signature */
 		gps_sec = start_gps_sec + pnum * period_min * SEC_PER_MIN;
 		npgps_gps_sec_to_day_time(gps_sec, &gps_day, &gps_time_of_day);
 
-		pred = get_prediction(pnum);
-		if (pred == NULL) {
-			LOG_WRN("Prediction num:%u missing", pnum);
-			/* request partial data; download interrupted? */
-			*first_bad_day = gps_day;
-			*first_bad_time = gps_time_of_day;
-			break;
-		}
-
+		entry->prediction = (struct nrf_cloud_pgps_prediction *)off;
+		entry->sentinel = (uint32_t)gps_sec;
 		err = validate_prediction(pred, gps_day, gps_time_of_day,
 					  period_min, true, false);
 		if (err) {
 			LOG_ERR("Prediction num:%u, gps_day:%u, "
 				"gps_time_of_day:%u is bad:%d; loc:%p",
-				pnum, gps_day, gps_time_of_day, err, pred);
+				pnum, gps_day, gps_time_of_day, err, (void *)off);
+		} else {
+			entry->crc = get_prediction_crc(pred);
+			entry->valid = true;
+		}
+		LOG_DBG("Prediction num:%u stored at idx:%d, off:0x%lX",
+			pnum, i, (unsigned long) off);
+	}
+
+	/* check predictions in time order, independent of storage order */
+	i = -1;
+	for (pnum = 0; pnum < count; pnum++) {
+		entry = &index.dir[pnum];
+		if (!entry->valid) {
+			if (entry->prediction == NULL) {
+				LOG_WRN("Prediction num:%u missing", pnum);
+			}
 			/* request partial data; download interrupted? */
-			*first_bad_day = gps_day;
-			*first_bad_time = gps_time_of_day;
+			gps_sec = start_gps_sec + pnum * period_min * SEC_PER_MIN;
+			npgps_gps_sec_to_day_time(gps_sec, first_bad_day, first_bad_time);
 			break;
 		}
 
 		i = get_prediction_block(pnum);
-		LOG_DBG("Prediction num:%u, loc:%p, blk:%d", pnum, pred, i);
-		__ASSERT(i != NO_BLOCK, "unexpected pointer value %p", pred);
+		LOG_DBG("Prediction num:%u, loc:%p, blk:%d", pnum, entry->prediction, i);
+		__ASSERT(i != NO_BLOCK, "unexpected pointer value %p", entry->prediction);
 		npgps_mark_block_used(i, true);
 	}
 
@@ -450,22 +481,22 @@ static void discard_oldest_predictions(int num)
 	for (pnum = 0; pnum < last; pnum++) {
 		block = get_prediction_block(pnum);
 		__ASSERT((block != -1), "unexpected ptr:%p for Prediction num:%d",
-			 index.predictions[pnum], pnum);
+			 index.dir[pnum].prediction, pnum);
 		npgps_free_block(block);
 	}
 
-	/* move predictions we are keeping to the start */
+	/* move directory entries of predictions we are keeping to the start;
+	 * they remain valid as they are not read from flash again
+	 */
 	for (i = last; i < index.header.prediction_count; i++) {
 		pnum = i - last;
-		index.predictions[pnum] = index.predictions[i];
+		index.dir[pnum] = index.dir[i];
 	}
 
-	/* set prediction pointers for 'last' in the newly empty
-	 * entries to NULL
-	 */
+	/* clear directory entries for 'last' in the newly empty entries */
 	for (pnum = index.header.prediction_count - last; pnum <
 	      index.header.prediction_count; pnum++) {
-		index.predictions[pnum] = NULL;
+		memset(&index.dir[pnum], 0, sizeof(index.dir[pnum]));
 	}
 	npgps_print_blocks();
 
@@ -614,6 +645,32 @@ static void print_time_details(const char *info,
 		tow, tow / 16);
 }
 
+/* Check from the RAM directory that a stored prediction can be used at the given time. */
+static int check_prediction(int pnum, int64_t cur_gps_sec, bool margin)
+{
+	const struct pgps_dir_entry *entry = &index.dir[pnum];
+	int64_t pred_sec = entry->sentinel;
+	int64_t end_sec = pred_sec + index.period_sec;
+
+	if (!entry->valid) {
+		LOG_ERR("Prediction num:%d is not valid", pnum);
+		return -EINVAL;
+	}
+
+	if (margin) {
+		end_sec += PGPS_MARGIN_SEC;
+	}
+
+	if ((cur_gps_sec < pred_sec) || (cur_gps_sec > end_sec)) {
+		LOG_ERR("prediction does not contain desired time; "
+			"start:%d, cur:%d, end:%d",
+			(int32_t)pred_sec, (int32_t)cur_gps_sec, (int32_t)end_sec);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
 int nrf_cloud_pgps_find_prediction(struct nrf_cloud_pgps_prediction **prediction)
 {
 	int64_t cur_gps_sec;
@@ -702,16 +759,30 @@ int nrf_cloud_pgps_find_prediction(struct nrf_cloud_pgps_prediction **prediction
 
 	LOG_DBG("Selected prediction num:%d", pnum);
 	index.cur_pnum = pnum;
-	*prediction = get_prediction(pnum);
-	if (*prediction) {
-		err = validate_prediction(*prediction,
-					  cur_gps_day, cur_gps_time_of_day,
-					  period_min, false, margin);
-		if (!err) {
-			start_expiration_timer(pnum, cur_gps_sec);
-			return pnum;
+	if (index.dir[pnum].prediction) {
+		err = check_prediction(pnum, cur_gps_sec, margin);
+		if (err) {
+			return err;
 		}
-		return err;
+
+		flash_reads = 0;
+		*prediction = get_prediction(pnum);
+		if (*prediction == NULL) {
+			return -EIO;
+		}
+		LOG_DBG("Prediction num:%d found; flash reads:%u", pnum, flash_reads);
+
+		/* Flash content may have been changed after the prediction was validated,
+		 * for example, if the storage is shared with a firmware update.
+		 */
+		if (get_prediction_crc(*prediction) != index.dir[pnum].crc) {
+			LOG_ERR("Prediction num:%d has changed in flash", pnum);
+			*prediction = NULL;
+			return -EINVAL;
+		}
+
+		start_expiration_timer(pnum, cur_gps_sec);
+		return pnum;
 	}
 	if (nrf_cloud_pgps_loading()) {
 		LOG_WRN("Prediction num:%u not loaded yet", pnum);
@@ -1240,7 +1311,8 @@ static int open_storage(uint32_t offset, bool preserve)
 	return 0;
 }
 
-static int store_prediction(uint8_t *p, size_t len, uint32_t sentinel, bool last)
+static int store_prediction(uint8_t *p, size_t len, uint32_t sentinel, bool last,
+			    uint32_t *crc)
 {
 	static bool first = true;
 	static uint8_t pad[PGPS_PREDICTION_PAD];
@@ -1253,6 +1325,12 @@ static int store_prediction(uint8_t *p, size_t len, uint32_t sentinel, bool last
 		first = false;
 	}
 
+	/* CRC is calculated over the prediction as stored, without the padding */
+	*crc = crc32_ieee_update(0, p, schema_offset);
+	*crc = crc32_ieee_update(*crc, &schema, sizeof(schema));
+	*crc = crc32_ieee_update(*crc, p + schema_offset, len - schema_offset);
+	*crc = crc32_ieee_update(*crc, (uint8_t *)&sentinel, sizeof(sentinel));
+
 	err = stream_flash_buffered_write(&stream, p, schema_offset, false);
 	if (err) {
 		LOG_ERR("Error writing pgps prediction:%d", err);
@@ -1465,6 +1543,9 @@ static int consume_pgps_data(uint8_t pnum, const char *buf, size_t buf_len)
 	struct agnss_header *elem = (struct agnss_header *)element_ptr;
 	size_t parsed_len = 0;
 	int64_t gps_sec;
+	int64_t expected_sec;
+	struct pgps_dir_entry *entry = &index.dir[pnum];
+	uint32_t crc;
 	bool finished = false;
 	int err = 0;
 
@@ -1512,7 +1593,7 @@ static int consume_pgps_data(uint8_t pnum, const char *buf, size_t buf_len)
 	if (parsed_len == buf_len) {
 		LOG_DBG("Parsing finished");
 
-		if (index.predictions[pnum]) {
+		if (entry->prediction) {
 			LOG_WRN("Received duplicate packet; ignoring");
 		} else if (gps_sec == 0) {
 			LOG_ERR("Prediction did not include GPS day and time of day; ignoring");
@@ -1524,12 +1605,24 @@ static int consume_pgps_data(uint8_t pnum, const char *buf, size_t buf_len)
 			index.loading_count++;
 			finished = (index.loading_count == index.expected_count);
 			err = store_prediction(prediction_ptr, buf_len, (uint32_t)gps_sec,
-					       finished || (index.storage_extent == 1));
+					       finished || (index.storage_extent == 1), &crc);
 			if (err) {
 				LOG_ERR("Error storing prediction:%d", err);
 				goto fail;
 			}
-			index.predictions[pnum] = npgps_block_to_pointer(index.store_block);
+
+			/* Update the directory directly from the received data, so the
+			 * prediction does not need to be read back from flash to validate it.
+			 */
+			get_prediction_day_time(pnum, &expected_sec, NULL, NULL);
+			entry->prediction = npgps_block_to_pointer(index.store_block);
+			entry->sentinel = (uint32_t)gps_sec;
+			entry->crc = crc;
+			entry->valid = (gps_sec == expected_sec);
+			if (!entry->valid) {
+				LOG_ERR("Prediction num:%u has unexpected gps sec:%d, expected:%d",
+					pnum, (int32_t)gps_sec, (int32_t)expected_sec);
+			}
 
 			if (!finished) {
 				if (loading_in_progress && !notified && (index.loading_count > 1)) {
@@ -1633,11 +1726,11 @@ int nrf_cloud_pgps_begin_update(void)
 		index.header.prediction_count = NUM_PREDICTIONS;
 		index.header.prediction_period_min = PREDICTION_PERIOD;
 		index.period_sec = index.header.prediction_period_min * SEC_PER_MIN;
-		memset(index.predictions, 0, sizeof(index.predictions));
+		memset(index.dir, 0, sizeof(index.dir));
 	} else {
 		for (uint8_t pnum = index.pnum_offset;
 		     pnum < index.expected_count + index.pnum_offset; pnum++) {
-			index.predictions[pnum] = NULL;
+			memset(&index.dir[pnum], 0, sizeof(index.dir[pnum]));
 		}
 	}
 
@@ -25,6 +25,7 @@
 
 #include "nrf_cloud_mem.h"
 #include "nrf_cloud_codec_internal.h"
+#include "nrf_cloud_json_writer.h"
 
 LOG_MODULE_REGISTER(nrf_cloud_rest, CONFIG_NRF_CLOUD_REST_LOG_LEVEL);
 
@@ -1084,6 +1085,18 @@ int nrf_cloud_rest_send_location(struct nrf_cloud_rest_context *const rest_ctx,
 
 	(void)nrf_cloud_codec_init(NULL);
 
+#if defined(CONFIG_NRF_CLOUD_JSON_WRITER)
+	struct nrf_cloud_json_writer w;
+
+	nrf_cloud_json_writer_init(&w, NULL, 0);
+	err = nrf_cloud_gnss_msg_json_write(&w, gnss);
+	err = err ? err : nrf_cloud_json_writer_alloc(&w);
+	err = err ? err : nrf_cloud_gnss_msg_json_write(&w, gnss);
+	json_msg = w.buf;
+	if (err) {
+		goto clean_up;
+	}
+#else
 	msg_obj = cJSON_CreateObject();
 	err = nrf_cloud_gnss_msg_json_encode(gnss, msg_obj);
 	if (err) {
@@ -1097,6 +1110,7 @@ int nrf_cloud_rest_send_location(struct nrf_cloud_rest_context *const rest_ctx,
 	}
 	cJSON_Delete(msg_obj);
 	msg_obj = NULL;
+#endif /* CONFIG_NRF_CLOUD_JSON_WRITER */
 
 	err = nrf_cloud_rest_send_device_message(rest_ctx, device_id, json_msg, false, NULL);
 
@@ -0,0 +1,591 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+#include <net/nrf_cloud_defs.h>
+#include "nrf_cloud_shadow_scan.h"
+
+LOG_MODULE_REGISTER(nrf_cloud_shadow_scan, CONFIG_NRF_CLOUD_LOG_LEVEL);
+
+/* Longest number that is parsed, cJSON uses the same character set */
+#define NUM_LEN_MAX 32
+#define NUM_CHARS "0123456789+-.eE"
+
+/* What an object or array represents in the shadow document */
+enum scan_role {
+	/* Not part of a section of interest, only validated */
+	ROLE_SKIP,
+	/* Root object of an MQTT delta or an accepted shadow */
+	ROLE_ROOT,
+	/* Delta state or desired section */
+	ROLE_STATE,
+	/* Reported section of an accepted shadow */
+	ROLE_REPORTED,
+	/* Control section of the desired state */
+	ROLE_CTRL_DES,
+	/* Control section of the reported state */
+	ROLE_CTRL_REP,
+};
+
+/* JSON type of a value */
+enum scan_type {
+	TYPE_NULL,
+	TYPE_BOOL,
+	TYPE_NUMBER,
+	TYPE_STRING,
+	TYPE_OBJECT,
+	TYPE_ARRAY,
+};
+
+/* Scalar value, objects and arrays are only validated */
+struct scan_value {
+	enum scan_type type;
+	double num;
+	bool boolean;
+};
+
+/* Keys already seen in an object, only the first occurrence of a key is used */
+#define SEEN_STATE	BIT(0)
+#define SEEN_VERSION	BIT(1)
+#define SEEN_TIMESTAMP	BIT(2)
+#define SEEN_DESIRED	BIT(3)
+#define SEEN_REPORTED	BIT(4)
+#define SEEN_CONTROL	BIT(5)
+#define SEEN_ALERTS	BIT(0)
+#define SEEN_LOG	BIT(1)
+
+struct scan_level {
+	uint8_t role : 4;
+	uint8_t array : 1;
+	uint8_t seen;
+};
+
+struct scan_ctrl {
+	bool found;
+	bool invalid;
+	bool alerts_found;
+	bool alerts_enabled;
+	bool log_found;
+	int log_level;
+};
+
+/* Where the scan is in the current object or array */
+enum scan_expect {
+	EXPECT_FIRST,
+	EXPECT_NEXT,
+	EXPECT_SEPARATOR,
+};
+
+struct scan {
+	const char *p;
+	const char *end;
+	enum nrf_cloud_shadow_scan_doc doc;
+	enum scan_expect expect;
+	struct nrf_cloud_shadow_scan_result *result;
+	struct scan_ctrl ctrl_des;
+	struct scan_ctrl ctrl_rep;
+	uint8_t depth;
+	struct scan_level levels[NRF_CLOUD_SHADOW_SCAN_DEPTH_MAX];
+};
+
+/* Keys of the values being scanned */
+struct scan_key {
+	const char *ptr;
+	size_t len;
+	bool escaped;
+};
+
+static void ws_skip(struct scan *const s)
+{
+	while ((s->p < s->end) && ((unsigned char)*s->p <= ' ')) {
+		s->p++;
+	}
+}
+
+static int peek(const struct scan *const s)
+{
+	return (s->p < s->end) ? (unsigned char)*s->p : -1;
+}
+
+static bool key_equal(const struct scan_key *const key, const char *const name)
+{
+	size_t i;
+
+	/* cJSON_GetObjectItem() matches keys case-insensitively */
+	for (i = 0; i < key->len; i++) {
+		if ((name[i] == '\0') ||
+		    (tolower((unsigned char)key->ptr[i]) != tolower((unsigned char)name[i]))) {
+			return false;
+		}
+	}
+
+	return name[i] == '\0';
+}
+
+static bool key_first(struct scan_level *const lvl, const struct scan_key *const key,
+		      const char *const name, const uint8_t bit)
+{
+	if ((lvl->seen & bit) || !key_equal(key, name)) {
+		return false;
+	}
+
+	lvl->seen |= bit;
+	return true;
+}
+
+static int hex4_parse(const char *const p, uint32_t *const val)
+{
+	*val = 0;
+
+	for (int i = 0; i < 4; i++) {
+		int c = (unsigned char)p[i];
+
+		*val <<= 4;
+		if ((c >= '0') && (c <= '9')) {
+			*val |= c - '0';
+		} else if ((c >= 'a') && (c <= 'f')) {
+			*val |= c - 'a' + 10;
+		} else if ((c >= 'A') && (c <= 'F')) {
+			*val |= c - 'A' + 10;
+		} else {
+			return -EBADMSG;
+		}
+	}
+
+	return 0;
+}
+
+/* Validate a string the same way cJSON parses it, without decoding it */
+static int string_parse(struct scan *const s, const char **const start, size_t *const len,
+			bool *const escaped)
+{
+	uint32_t code;
+
+	if (peek(s) != '"') {
+		return -EBADMSG;
+	}
+
+	s->p++;
+	*start = s->p;
+	*escaped = false;
+
+	while ((s->p < s->end) && (*s->p != '"')) {
+		if (*s->p != '\\') {
+			s->p++;
+			continue;
+		}
+
+		*escaped = true;
+		if ((s->end - s->p) < 2) {
+			return -EBADMSG;
+		}
+
+		switch (s->p[1]) {
+		case 'b':
+		case 'f':
+		case 'n':
+		case 'r':
+		case 't':
+		case '"':
+		case '\\':
+		case '/':
+			s->p += 2;
+			break;
+		case 'u':
+			if (((s->end - s->p) < 6) || hex4_parse(s->p + 2, &code)) {
+				return -EBADMSG;
+			}
+			s->p += 6;
+
+			if ((code >= 0xDC00) && (code <= 0xDFFF)) {
+				/* Low surrogate without a high surrogate */
+				return -EBADMSG;
+			}
+
+			if ((code >= 0xD800) && (code <= 0xDBFF)) {
+				/* A high surrogate must be followed by a low surrogate */
+				if (((s->end - s->p) < 6) || (s->p[0] != '\\') || (s->p[1] != 'u') ||
+				    hex4_parse(s->p + 2, &code) ||
+				    (code < 0xDC00) || (code > 0xDFFF)) {
+					return -EBADMSG;
+				}
+				s->p += 6;
+			}
+			break;
+		default:
+			return -EBADMSG;
+		}
+	}
+
+	if (s->p >= s->end) {
+		return -EBADMSG;
+	}
+
+	*len = s->p - *start;
+	s->p++;
+
+	return 0;
+}
+
+static int number_parse(struct scan *const s, double *const num)
+{
+	char buf[NUM_LEN_MAX + 1];
+	char *num_end;
+	size_t len = 0;
+
+	while ((s->p + len < s->end) && (s->p[len] != '\0') && strchr(NUM_CHARS, s->p[len])) {
+		if (len == NUM_LEN_MAX) {
+			return -EBADMSG;
+		}
+		buf[len] = s->p[len];
+		len++;
+	}
+
+	buf[len] = '\0';
+	*num = strtod(buf, &num_end);
+	if (num_end == buf) {
+		return -EBADMSG;
+	}
+
+	s->p += num_end - buf;
+
+	return 0;
+}
+
+static int literal_parse(struct scan *const s, const char *const literal)
+{
+	size_t len = strlen(literal);
+
+	if (((size_t)(s->end - s->p) < len) || strncmp(s->p, literal, len)) {
+		return -EBADMSG;
+	}
+
+	s->p += len;
+
+	return 0;
+}
+
+static void ctrl_update(struct scan_ctrl *const ctrl, struct scan_level *const lvl,
+			const struct scan_key *const key, const struct scan_value *const val)
+{
+	if (key_first(lvl, key, NRF_CLOUD_JSON_KEY_ALERT, SEEN_ALERTS)) {
+		if (val->type == TYPE_BOOL) {
+			ctrl->alerts_found = true;
+			ctrl->alerts_enabled = val->boolean;
+		} else {
+			ctrl->invalid = true;
+		}
+	} else if (key_first(lvl, key, NRF_CLOUD_JSON_KEY_LOG, SEEN_LOG)) {
+		if ((val->type != TYPE_NUMBER) ||
+		    (val->num < (double)INT_MIN) || (val->num > (double)INT_MAX) ||
+		    ((int)val->num < (int)LOG_LEVEL_NONE) ||
+		    ((int)val->num > LOG_LEVEL_DBG)) {
+			ctrl->invalid = true;
+		} else {
+			ctrl->log_found = true;
+			ctrl->log_level = (int)val->num;
+		}
+	}
+}
+
+/* Handle a value of a section, the type and the scalar value are already set.
+ * Also provides the role of the value if it is an object or array.
+ */
+static int value_handle(struct scan *const s, const struct scan_key *const key,
+			const struct scan_value *const val, enum scan_role *const role)
+{
+	struct nrf_cloud_shadow_scan_result *const res = s->result;
+	bool is_obj = (val->type == TYPE_OBJECT);
+	struct scan_level *lvl;
+
+	*role = ROLE_SKIP;
+
+	if (s->depth == 0) {
+		/* Root value */
+		if (!is_obj) {
+			return 0;
+		}
+
+		if (s->doc == NRF_CLOUD_SHADOW_SCAN_DOC_DELTA_STATE) {
+			res->state_found = true;
+			*role = ROLE_STATE;
+		} else {
+			*role = ROLE_ROOT;
+		}
+		return 0;
+	}
+
+	lvl = &s->levels[s->depth - 1];
+	if (lvl->array) {
+		return 0;
+	}
+
+	/* The keys of the sections must match the names used by cJSON lookups */
+	if (key->escaped) {
+		return -ENOTSUP;
+	}
+
+	switch (lvl->role) {
+	case ROLE_ROOT:
+		if (s->doc == NRF_CLOUD_SHADOW_SCAN_DOC_DELTA) {
+			if (key_first(lvl, key, NRF_CLOUD_JSON_KEY_STATE, SEEN_STATE)) {
+				if (is_obj) {
+					res->state_found = true;
+					*role = ROLE_STATE;
+				}
+			} else if (key_first(lvl, key, NRF_CLOUD_JSON_KEY_SHADOW_VERSION,
+					     SEEN_VERSION)) {
+				if (val->type == TYPE_NUMBER) {
+					res->ver_found = true;
+					res->ver = (int)val->num;
+				}
+			} else if (key_first(lvl, key, NRF_CLOUD_JSON_KEY_SHADOW_TIMESTAMP,
+					     SEEN_TIMESTAMP)) {
+				if (val->type == TYPE_NUMBER) {
+					res->ts_found = true;
+					res->ts = (int64_t)val->num;
+				}
+			}
+		} else {
+			if (key_first(lvl, key, NRF_CLOUD_JSON_KEY_DES, SEEN_DESIRED)) {
+				if (is_obj) {
+					res->state_found = true;
+					*role = ROLE_STATE;
+				}
+			} else if (key_first(lvl, key, NRF_CLOUD_JSON_KEY_REP, SEEN_REPORTED)) {
+				*role = is_obj ? ROLE_REPORTED : ROLE_SKIP;
+			}
+		}
+		return 0;
+	case ROLE_STATE:
+		if (key_first(lvl, key, NRF_CLOUD_JSON_KEY_CTRL, SEEN_CONTROL) && is_obj) {
+			/* The control section is detached from the state */
+			s->ctrl_des.found = true;
+			*role = ROLE_CTRL_DES;
+			return 0;
+		}
+
+		/* Other items, including the config section, are passed to the application */
+		res->state_items++;
+		return 0;
+	case ROLE_REPORTED:
+		if (key_first(lvl, key, NRF_CLOUD_JSON_KEY_CTRL, SEEN_CONTROL) && is_obj) {
+			s->ctrl_rep.found = true;
+			*role = ROLE_CTRL_REP;
+		}
+		return 0;
+	case ROLE_CTRL_DES:
+		ctrl_update(&s->ctrl_des, lvl, key, val);
+		return 0;
+	case ROLE_CTRL_REP:
+		ctrl_update(&s->ctrl_rep, lvl, key, val);
+		return 0;
+	default:
+		return 0;
+	}
+}
+
+static int value_parse(struct scan *const s, const struct scan_key *const key)
+{
+	struct scan_value value = {0};
+	struct scan_value *const val = &value;
+	enum scan_role role = ROLE_SKIP;
+	const char *start;
+	size_t len;
+	bool escaped;
+	int err = 0;
+
+	switch (peek(s)) {
+	case '{':
+		val->type = TYPE_OBJECT;
+		s->p++;
+		break;
+	case '[':
+		val->type = TYPE_ARRAY;
+		s->p++;
+		break;
+	case '"':
+		val->type = TYPE_STRING;
+		err = string_parse(s, &start, &len, &escaped);
+		break;
+	case 't':
+		val->type = TYPE_BOOL;
+		val->boolean = true;
+		err = literal_parse(s, "true");
+		break;
+	case 'f':
+		val->type = TYPE_BOOL;
+		err = literal_parse(s, "false");
+		break;
+	case 'n':
+		val->type = TYPE_NULL;
+		err = literal_parse(s, "null");
+		break;
+	case '-':
+	case '0':
+	case '1':
+	case '2':
+	case '3':
+	case '4':
+	case '5':
+	case '6':
+	case '7':
+	case '8':
+	case '9':
+		val->type = TYPE_NUMBER;
+		err = number_parse(s, &val->num);
+		break;
+	default:
+		return -EBADMSG;
+	}
+
+	if (err) {
+		return err;
+	}
+
+	/* Values in skipped objects and arrays are only validated */
+	if ((s->depth == 0) || (s->levels[s->depth - 1].role != ROLE_SKIP)) {
+		err = value_handle(s, key, val, &role);
+		if (err) {
+			return err;
+		}
+	}
+
+	if ((val->type != TYPE_OBJECT) && (val->type != TYPE_ARRAY)) {
+		s->expect = EXPECT_SEPARATOR;
+		return 0;
+	}
+
+	if (s->depth == NRF_CLOUD_SHADOW_SCAN_DEPTH_MAX) {
+		return -E2BIG;
+	}
+
+	s->levels[s->depth].role = role;
+	s->levels[s->depth].array = (val->type == TYPE_ARRAY);
+	s->levels[s->depth].seen = 0;
+	s->depth++;
+	s->result->depth_max = MAX(s->result->depth_max, s->depth);
+	s->expect = EXPECT_FIRST;
+
+	return 0;
+}
+
+static void container_end(struct scan *const s)
+{
+	s->p++;
+	s->depth--;
+	s->expect = EXPECT_SEPARATOR;
+}
+
+static void ctrl_result_set(const struct scan_ctrl *const ctrl,
+			    struct nrf_cloud_shadow_scan_result *const res)
+{
+	res->ctrl_found = true;
+	res->ctrl_invalid = ctrl->invalid;
+	res->alerts_found = ctrl->alerts_found;
+	res->alerts_enabled = ctrl->alerts_enabled;
+	res->log_found = ctrl->log_found;
+	res->log_level = ctrl->log_level;
+}
+
+static int scan_run(struct scan *const s)
+{
+	struct scan_key key = {0};
+	struct scan_level *lvl;
+	int c;
+	int err;
+
+	/* cJSON skips a UTF-8 byte order mark */
+	if (((s->end - s->p) >= 3) && !strncmp(s->p, "\xEF\xBB\xBF", 3)) {
+		s->p += 3;
+	}
+
+	ws_skip(s);
+	err = value_parse(s, &key);
+
+	while (!err && (s->depth > 0)) {
+		lvl = &s->levels[s->depth - 1];
+		ws_skip(s);
+		c = peek(s);
+
+		if (s->expect == EXPECT_SEPARATOR) {
+			if (c == ',') {
+				s->p++;
+				s->expect = EXPECT_NEXT;
+			} else if (c == (lvl->array ? ']' : '}')) {
+				container_end(s);
+			} else {
+				err = -EBADMSG;
+			}
+			continue;
+		}
+
+		if ((s->expect == EXPECT_FIRST) && (c == (lvl->array ? ']' : '}'))) {
+			container_end(s);
+			continue;
+		}
+
+		if (!lvl->array) {
+			err = string_parse(s, &key.ptr, &key.len, &key.escaped);
+			if (err) {
+				break;
+			}
+
+			ws_skip(s);
+			if (peek(s) != ':') {
+				err = -EBADMSG;
+				break;
+			}
+
+			s->p++;
+			ws_skip(s);
+		}
+
+		err = value_parse(s, &key);
+	}
+
+	return err;
+}
+
+int nrf_cloud_shadow_scan(const char *const buf, const size_t len,
+			  const enum nrf_cloud_shadow_scan_doc doc,
+			  struct nrf_cloud_shadow_scan_result *const result)
+{
+	if (!buf || !result) {
+		return -EINVAL;
+	}
+
+	struct scan s = {
+		.p = buf,
+		.end = buf + len,
+		.doc = doc,
+		.result = result,
+	};
+	int err;
+
+	memset(result, 0, sizeof(*result));
+
+	err = scan_run(&s);
+	if (err) {
+		LOG_DBG("Shadow scan stopped at offset %d, error: %d", (int)(s.p - buf), err);
+		return err;
+	}
+
+	/* The desired control section takes precedence over the reported one */
+	if (s.ctrl_des.found) {
+		ctrl_result_set(&s.ctrl_des, result);
+	} else if (s.ctrl_rep.found) {
+		ctrl_result_set(&s.ctrl_rep, result);
+	}
+
+	return 0;
+}
@@ -0,0 +1,760 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <nrf_compress/implementation.h>
+#include <nrf_compress/lz4.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_REGISTER(nrf_compress_lz4, CONFIG_NRF_COMPRESS_LOG_LEVEL);
+
+/* Hash positions are stored as 16-bit offsets from the start of the block, which also keeps the
+ * match distance within the 64 KiB limit of the LZ4 format.
+ */
+BUILD_ASSERT(CONFIG_NRF_COMPRESS_LZ4_BLOCK_SIZE <= 65536,
+	     "CONFIG_NRF_COMPRESS_LZ4_BLOCK_SIZE must not exceed 64 KiB");
+
+#define LZ4_MAGIC			0x184D2204
+#define LZ4_FLG_VERSION_MASK		0xC0
+#define LZ4_FLG_VERSION			0x40
+#define LZ4_FLG_BLOCK_INDEPENDENCE	BIT(5)
+#define LZ4_FLG_BLOCK_CHECKSUM		BIT(4)
+#define LZ4_FLG_CONTENT_SIZE		BIT(3)
+#define LZ4_FLG_CONTENT_CHECKSUM	BIT(2)
+#define LZ4_FLG_RESERVED		BIT(1)
+#define LZ4_FLG_DICT_ID			BIT(0)
+#define LZ4_BD_RESERVED_MASK		0x8F
+#define LZ4_BD_BLOCK_MAX_SIZE_64KB	0x40
+#define LZ4_CONTENT_SIZE_SIZE		8
+#define LZ4_BLOCK_UNCOMPRESSED		BIT(31)
+
+/* Magic number, frame descriptor flags and block descriptor */
+#define LZ4_FRAME_DESCRIPTOR_SIZE	6
+
+/* Sequence limits from the LZ4 block format specification */
+#define LZ4_MIN_MATCH			4
+#define LZ4_LAST_LITERALS		5
+#define LZ4_MF_LIMIT			12
+#define LZ4_RUN_MASK			0x0F
+
+/* Number of failed match attempts after which the compressor starts skipping input faster */
+#define LZ4_SKIP_TRIGGER		6
+
+#define LZ4_HASH_SIZE			BIT(CONFIG_NRF_COMPRESS_LZ4_HASH_BITS)
+#define LZ4_HASH(sequence)							\
+	(((sequence) * 2654435761U) >> (32 - CONFIG_NRF_COMPRESS_LZ4_HASH_BITS))
+
+#define XXH_PRIME32_1			0x9E3779B1U
+#define XXH_PRIME32_2			0x85EBCA77U
+#define XXH_PRIME32_3			0xC2B2AE3DU
+#define XXH_PRIME32_4			0x27D4EB2FU
+#define XXH_PRIME32_5			0x165667B1U
+
+#if defined(CONFIG_NRF_COMPRESS_COMPRESSION)
+struct lz4_encoder {
+	uint16_t hash_table[LZ4_HASH_SIZE];
+	uint8_t input[CONFIG_NRF_COMPRESS_LZ4_BLOCK_SIZE];
+	uint8_t output[NRF_COMPRESS_LZ4_FRAME_HEADER_SIZE + NRF_COMPRESS_LZ4_BLOCK_HEADER_SIZE +
+		       CONFIG_NRF_COMPRESS_LZ4_BLOCK_SIZE + NRF_COMPRESS_LZ4_END_MARK_SIZE];
+	size_t input_size;
+	bool header_written;
+	bool finished;
+};
+#endif
+
+#if defined(CONFIG_NRF_COMPRESS_DECOMPRESSION)
+enum lz4_decoder_state {
+	LZ4_STATE_DESCRIPTOR,
+	LZ4_STATE_HEADER_CHECKSUM,
+	LZ4_STATE_BLOCK_SIZE,
+	LZ4_STATE_BLOCK,
+	LZ4_STATE_FINISHED,
+};
+
+struct lz4_decoder {
+	/* Output first to keep it aligned */
+	uint8_t output[CONFIG_NRF_COMPRESS_LZ4_BLOCK_SIZE];
+	uint8_t input[CONFIG_NRF_COMPRESS_LZ4_BLOCK_SIZE];
+	enum lz4_decoder_state state;
+	size_t needed;
+	size_t fill;
+	uint8_t descriptor[2];
+	bool uncompressed_block;
+};
+#endif
+
+#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC)
+/* Both buffers are allocated on initialization */
+#define LZ4_MALLOC_SIZE									\
+	(COND_CODE_1(CONFIG_NRF_COMPRESS_COMPRESSION, (sizeof(struct lz4_encoder)), (0)) +	\
+	 COND_CODE_1(CONFIG_NRF_COMPRESS_DECOMPRESSION,						\
+		     (ROUND_UP(sizeof(struct lz4_decoder), CONFIG_NRF_COMPRESS_MEMORY_ALIGNMENT)),	\
+		     (0)))
+
+BUILD_ASSERT(LZ4_MALLOC_SIZE <= CONFIG_NRF_COMPRESS_MIN_MEMORY_REQUIRED,
+	     "CONFIG_NRF_COMPRESS_MIN_MEMORY_REQUIRED does not cover the LZ4 buffers");
+#endif
+
+#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_STATIC)
+#if defined(CONFIG_NRF_COMPRESS_COMPRESSION)
+static struct lz4_encoder lz4_encoder_buffer;
+static struct lz4_encoder *encoder = &lz4_encoder_buffer;
+#endif
+#if defined(CONFIG_NRF_COMPRESS_DECOMPRESSION)
+#if CONFIG_NRF_COMPRESS_MEMORY_ALIGNMENT > 1
+static struct lz4_decoder __aligned(CONFIG_NRF_COMPRESS_MEMORY_ALIGNMENT) lz4_decoder_buffer;
+#else
+static struct lz4_decoder lz4_decoder_buffer;
+#endif
+static struct lz4_decoder *decoder = &lz4_decoder_buffer;
+#endif
+#else
+#if defined(CONFIG_NRF_COMPRESS_COMPRESSION)
+static struct lz4_encoder *encoder;
+#endif
+#if defined(CONFIG_NRF_COMPRESS_DECOMPRESSION)
+static struct lz4_decoder *decoder;
+#endif
+#endif
+
+static size_t lz4_output_limit = SIZE_MAX;
+
+/* xxHash32 with a seed of 0, only for the short frame descriptor */
+static uint8_t lz4_header_checksum(const uint8_t *data, size_t len)
+{
+	uint32_t hash = XXH_PRIME32_5 + len;
+
+	for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t), data += sizeof(uint32_t)) {
+		hash += sys_get_le32(data) * XXH_PRIME32_3;
+		hash = ((hash << 17) | (hash >> 15)) * XXH_PRIME32_4;
+	}
+
+	for (; len > 0; len--, data++) {
+		hash += *data * XXH_PRIME32_5;
+		hash = ((hash << 11) | (hash >> 21)) * XXH_PRIME32_1;
+	}
+
+	hash ^= hash >> 15;
+	hash *= XXH_PRIME32_2;
+	hash ^= hash >> 13;
+	hash *= XXH_PRIME32_3;
+	hash ^= hash >> 16;
+
+	return (uint8_t)(hash >> 8);
+}
+
+#if defined(CONFIG_NRF_COMPRESS_COMPRESSION)
+static uint8_t *lz4_length_write(uint8_t *op, size_t length)
+{
+	for (; length >= UINT8_MAX; length -= UINT8_MAX) {
+		*op++ = UINT8_MAX;
+	}
+
+	*op++ = (uint8_t)length;
+
+	return op;
+}
+
+/* Write a sequence, a match length of 0 writes the final literals. Returns NULL if the sequence
+ * does not fit in the output.
+ */
+static uint8_t *lz4_sequence_write(uint8_t *op, const uint8_t *oend, const uint8_t *literals,
+				   size_t literal_len, uint16_t match_offset, size_t match_len)
+{
+	/* Token, literal length, literals, offset and match length */
+	const size_t max_size = 1 + literal_len / UINT8_MAX + 1 + literal_len + sizeof(uint16_t) +
+				match_len / UINT8_MAX + 1;
+	uint8_t *token = op++;
+
+	if ((size_t)(oend - token) < max_size) {
+		return NULL;
+	}
+
+	if (literal_len >= LZ4_RUN_MASK) {
+		*token = LZ4_RUN_MASK << 4;
+		op = lz4_length_write(op, literal_len - LZ4_RUN_MASK);
+	} else {
+		*token = (uint8_t)(literal_len << 4);
+	}
+
+	memcpy(op, literals, literal_len);
+	op += literal_len;
+
+	if (match_len == 0) {
+		return op;
+	}
+
+	sys_put_le16(match_offset, op);
+	op += sizeof(uint16_t);
+	match_len -= LZ4_MIN_MATCH;
+
+	if (match_len >= LZ4_RUN_MASK) {
+		*token |= LZ4_RUN_MASK;
+		op = lz4_length_write(op, match_len - LZ4_RUN_MASK);
+	} else {
+		*token |= (uint8_t)match_len;
+	}
+
+	return op;
+}
+
+/* Greedy single pass compressor, returns 0 if the block does not fit in the output */
+static size_t lz4_block_compress(const uint8_t *src, size_t src_size, uint8_t *dst,
+				 size_t dst_capacity, uint16_t *hash_table)
+{
+	const uint8_t *ip = src;
+	const uint8_t *anchor = src;
+	const uint8_t *const iend = src + src_size;
+	uint8_t *op = dst;
+	const uint8_t *const oend = dst + dst_capacity;
+
+	memset(hash_table, 0, sizeof(uint16_t) * LZ4_HASH_SIZE);
+
+	if (src_size > LZ4_MF_LIMIT) {
+		const uint8_t *const mflimit = iend - LZ4_MF_LIMIT;
+		const uint8_t *const matchlimit = iend - LZ4_LAST_LITERALS;
+		uint32_t misses = 0;
+
+		while (ip < mflimit) {
+			const uint32_t sequence = UNALIGNED_GET((const uint32_t *)ip);
+			const uint32_t hash = LZ4_HASH(sequence);
+			const uint8_t *ref = src + hash_table[hash];
+			size_t match_len = LZ4_MIN_MATCH;
+
+			hash_table[hash] = (uint16_t)(ip - src);
+
+			if (ref >= ip || UNALIGNED_GET((const uint32_t *)ref) != sequence) {
+				/* Skip faster through data that does not compress */
+				ip += 1 + (misses++ >> LZ4_SKIP_TRIGGER);
+				continue;
+			}
+
+			misses = 0;
+
+			while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+				ip--;
+				ref--;
+			}
+
+			while (ip + match_len < matchlimit && ip[match_len] == ref[match_len]) {
+				match_len++;
+			}
+
+			op = lz4_sequence_write(op, oend, anchor, ip - anchor, (uint16_t)(ip - ref),
+						match_len);
+
+			if (op == NULL) {
+				return 0;
+			}
+
+			ip += match_len;
+			anchor = ip;
+
+			if (ip < mflimit) {
+				hash_table[LZ4_HASH(UNALIGNED_GET((const uint32_t *)(ip - 2)))] =
+					(uint16_t)(ip - 2 - src);
+			}
+		}
+	}
+
+	op = lz4_sequence_write(op, oend, anchor, iend - anchor, 0, 0);
+
+	return op != NULL ? op - dst : 0;
+}
+
+static size_t lz4_block_write(uint8_t *dst, const uint8_t *src, size_t src_size)
+{
+	uint8_t *payload = dst + NRF_COMPRESS_LZ4_BLOCK_HEADER_SIZE;
+	size_t size;
+
+	/* Only keep the compressed block if it is smaller than the data itself */
+	size = lz4_block_compress(src, src_size, payload, src_size - 1, encoder->hash_table);
+
+	if (size == 0) {
+		memcpy(payload, src, src_size);
+		size = src_size;
+		sys_put_le32(size | LZ4_BLOCK_UNCOMPRESSED, dst);
+	} else {
+		sys_put_le32(size, dst);
+	}
+
+	return NRF_COMPRESS_LZ4_BLOCK_HEADER_SIZE + size;
+}
+
+static size_t lz4_frame_header_write(uint8_t *dst)
+{
+	sys_put_le32(LZ4_MAGIC, dst);
+	dst[4] = LZ4_FLG_VERSION | LZ4_FLG_BLOCK_INDEPENDENCE;
+	dst[5] = LZ4_BD_BLOCK_MAX_SIZE_64KB;
+	dst[6] = lz4_header_checksum(&dst[4], 2);
+
+	return NRF_COMPRESS_LZ4_FRAME_HEADER_SIZE;
+}
+
+static void lz4_encoder_reset(void)
+{
+	encoder->input_size = 0;
+	encoder->header_written = false;
+	encoder->finished = false;
+}
+
+static int lz4_compress(void *inst, const uint8_t *input, size_t input_size, bool last_part,
+			uint32_t *offset, uint8_t **output, size_t *output_size)
+{
+	size_t copy_size;
+	bool last_block;
+	uint8_t *op;
+
+	ARG_UNUSED(inst);
+
+#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC)
+	if (encoder == NULL) {
+		return -ESRCH;
+	}
+#endif
+
+	if ((input == NULL && input_size > 0) || (input_size == 0 && !last_part) ||
+	    offset == NULL || output == NULL || output_size == NULL || encoder->finished) {
+		return -EINVAL;
+	}
+
+	*output = NULL;
+	*output_size = 0;
+
+	copy_size = MIN(input_size, sizeof(encoder->input) - encoder->input_size);
+
+	if (copy_size > lz4_output_limit) {
+		return -EINVAL;
+	}
+
+	if (copy_size > 0) {
+		memcpy(&encoder->input[encoder->input_size], input, copy_size);
+		encoder->input_size += copy_size;
+		lz4_output_limit -= copy_size;
+	}
+
+	*offset = copy_size;
+	last_block = last_part && copy_size == input_size;
+
+	if (encoder->input_size < sizeof(encoder->input) && !last_block) {
+		return 0;
+	}
+
+	op = encoder->output;
+
+	if (!encoder->header_written) {
+		op += lz4_frame_header_write(op);
+		encoder->header_written = true;
+	}
+
+	if (encoder->input_size > 0) {
+		op += lz4_block_write(op, encoder->input, encoder->input_size);
+		encoder->input_size = 0;
+	}
+
+	if (last_block) {
+		sys_put_le32(0, op);
+		op += NRF_COMPRESS_LZ4_END_MARK_SIZE;
+		encoder->finished = true;
+	}
+
+	*output = encoder->output;
+	*output_size = op - encoder->output;
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_NRF_COMPRESS_DECOMPRESSION)
+static int lz4_length_read(const uint8_t **ip, const uint8_t *iend, size_t *length)
+{
+	uint8_t byte;
+
+	do {
+		if (*ip >= iend) {
+			return -EINVAL;
+		}
+
+		byte = *(*ip)++;
+		*length += byte;
+	} while (byte == UINT8_MAX);
+
+	return 0;
+}
+
+static int lz4_block_decompress(const uint8_t *src, size_t src_size, uint8_t *dst,
+				size_t dst_capacity, size_t *dst_size)
+{
+	const uint8_t *ip = src;
+	const uint8_t *const iend = src + src_size;
+	uint8_t *op = dst;
+	const uint8_t *const oend = dst + dst_capacity;
+
+	while (true) {
+		const uint8_t *match;
+		size_t length;
+		uint16_t match_offset;
+		uint8_t token;
+
+		if (ip >= iend) {
+			return -EINVAL;
+		}
+
+		token = *ip++;
+		length = token >> 4;
+
+		if (length == LZ4_RUN_MASK && lz4_length_read(&ip, iend, &length) != 0) {
+			return -EINVAL;
+		}
+
+		if (length > (size_t)(iend - ip) || length > (size_t)(oend - op)) {
+			return -EINVAL;
+		}
+
+		memcpy(op, ip, length);
+		op += length;
+		ip += length;
+
+		if (ip == iend) {
+			/* The last sequence only has literals */
+			break;
+		}
+
+		if ((size_t)(iend - ip) < sizeof(uint16_t)) {
+			return -EINVAL;
+		}
+
+		match_offset = sys_get_le16(ip);
+		ip += sizeof(uint16_t);
+
+		if (match_offset == 0 || match_offset > (size_t)(op - dst)) {
+			return -EINVAL;
+		}
+
+		length = token & LZ4_RUN_MASK;
+
+		if (length == LZ4_RUN_MASK && lz4_length_read(&ip, iend, &length) != 0) {
+			return -EINVAL;
+		}
+
+		length += LZ4_MIN_MATCH;
+
+		if (length > (size_t)(oend - op)) {
+			return -EINVAL;
+		}
+
+		/* Overlapping matches repeat the last match_offset bytes, copy them in chunks
+		 * which double in size instead of byte by byte.
+		 */
+		match = op - match_offset;
+
+		while (length > 0) {
+			const size_t copy_size = MIN(length, (size_t)(op - match));
+
+			memcpy(op, match, copy_size);
+			op += copy_size;
+			length -= copy_size;
+		}
+	}
+
+	*dst_size = op - dst;
+
+	return 0;
+}
+
+static void lz4_decoder_reset(void)
+{
+	decoder->state = LZ4_STATE_DESCRIPTOR;
+	decoder->needed = LZ4_FRAME_DESCRIPTOR_SIZE;
+	decoder->fill = 0;
+}
+
+static int lz4_element_process(const uint8_t *element, uint8_t **output, size_t *output_size)
+{
+	uint8_t descriptor[2 + LZ4_CONTENT_SIZE_SIZE];
+	size_t size;
+	int rc;
+
+	switch (decoder->state) {
+	case LZ4_STATE_DESCRIPTOR:
+		if (sys_get_le32(element) != LZ4_MAGIC) {
+			return -EINVAL;
+		}
+
+		memcpy(decoder->descriptor, &element[4], sizeof(decoder->descriptor));
+
+		if ((decoder->descriptor[0] & LZ4_FLG_VERSION_MASK) != LZ4_FLG_VERSION ||
+		    (decoder->descriptor[0] & LZ4_FLG_RESERVED) ||
+		    (decoder->descriptor[1] & LZ4_BD_RESERVED_MASK)) {
+			return -EINVAL;
+		}
+
+		if (!(decoder->descriptor[0] & LZ4_FLG_BLOCK_INDEPENDENCE) ||
+		    (decoder->descriptor[0] &
+		     (LZ4_FLG_BLOCK_CHECKSUM | LZ4_FLG_CONTENT_CHECKSUM | LZ4_FLG_DICT_ID))) {
+			LOG_ERR("Unsupported LZ4 frame options (0x%02x)", decoder->descriptor[0]);
+			return -ENOTSUP;
+		}
+
+		decoder->state = LZ4_STATE_HEADER_CHECKSUM;
+		decoder->needed = 1;
+
+		if (decoder->descriptor[0] & LZ4_FLG_CONTENT_SIZE) {
+			decoder->needed += LZ4_CONTENT_SIZE_SIZE;
+		}
+
+		break;
+
+	case LZ4_STATE_HEADER_CHECKSUM:
+		size = decoder->needed - 1;
+		memcpy(descriptor, decoder->descriptor, sizeof(decoder->descriptor));
+		memcpy(&descriptor[sizeof(decoder->descriptor)], element, size);
+
+		if (lz4_header_checksum(descriptor, sizeof(decoder->descriptor) + size) !=
+		    element[size]) {
+			return -EINVAL;
+		}
+
+		decoder->state = LZ4_STATE_BLOCK_SIZE;
+		decoder->needed = NRF_COMPRESS_LZ4_BLOCK_HEADER_SIZE;
+		break;
+
+	case LZ4_STATE_BLOCK_SIZE:
+		size = sys_get_le32(element);
+
+		if (size == 0) {
+			decoder->state = LZ4_STATE_FINISHED;
+			decoder->needed = 0;
+			break;
+		}
+
+		decoder->uncompressed_block = (size & LZ4_BLOCK_UNCOMPRESSED) != 0;
+		size &= ~LZ4_BLOCK_UNCOMPRESSED;
+
+		if (size == 0 || size > sizeof(decoder->input)) {
+			LOG_ERR("LZ4 block size %zu exceeds the supported size", size);
+			return -EINVAL;
+		}
+
+		decoder->state = LZ4_STATE_BLOCK;
+		decoder->needed = size;
+		break;
+
+	case LZ4_STATE_BLOCK:
+		if (decoder->uncompressed_block) {
+			memcpy(decoder->output, element, decoder->needed);
+			size = decoder->needed;
+		} else {
+			rc = lz4_block_decompress(element, decoder->needed, decoder->output,
+						  sizeof(decoder->output), &size);
+
+			if (rc) {
+				return rc;
+			}
+		}
+
+		if (size > lz4_output_limit) {
+			return -EINVAL;
+		}
+
+		lz4_output_limit -= size;
+		*output = decoder->output;
+		*output_size = size;
+
+		decoder->state = LZ4_STATE_BLOCK_SIZE;
+		decoder->needed = NRF_COMPRESS_LZ4_BLOCK_HEADER_SIZE;
+		break;
+
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static size_t lz4_bytes_needed(void *inst)
+{
+	ARG_UNUSED(inst);
+
+#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC)
+	if (decoder == NULL) {
+		return 0;
+	}
+#endif
+
+	return decoder->needed - decoder->fill;
+}
+
+static int lz4_decompress(void *inst, const uint8_t *input, size_t input_size, bool last_part,
+			  uint32_t *offset, uint8_t **output, size_t *output_size)
+{
+	size_t consumed = 0;
+	int rc;
+
+	ARG_UNUSED(inst);
+
+#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC)
+	if (decoder == NULL) {
+		return -ESRCH;
+	}
+#endif
+
+	if (input == NULL || input_size == 0 || offset == NULL || output == NULL ||
+	    output_size == NULL) {
+		return -EINVAL;
+	}
+
+	*output = NULL;
+	*output_size = 0;
+
+	/* Process frame elements until a block is decompressed or the input is used up */
+	while (consumed < input_size && *output_size == 0 &&
+	       decoder->state != LZ4_STATE_FINISHED) {
+		const uint8_t *element = &input[consumed];
+		const size_t available = input_size - consumed;
+
+		if (decoder->fill == 0 && available >= decoder->needed) {
+			/* Complete element in the input, process it in place */
+			consumed += decoder->needed;
+		} else {
+			const size_t copy_size = MIN(available, decoder->needed - decoder->fill);
+
+			memcpy(&decoder->input[decoder->fill], element, copy_size);
+			decoder->fill += copy_size;
+			consumed += copy_size;
+
+			if (decoder->fill < decoder->needed) {
+				break;
+			}
+
+			element = decoder->input;
+		}
+
+		decoder->fill = 0;
+		rc = lz4_element_process(element, output, output_size);
+
+		if (rc) {
+			return rc;
+		}
+	}
+
+	*offset = consumed;
+
+	if (last_part && consumed == input_size && decoder->state != LZ4_STATE_FINISHED) {
+		/* The frame end mark is missing */
+		return -EINVAL;
+	}
+
+	return 0;
+}
+#endif
+
+static int lz4_reset(void *inst, size_t decompressed_size)
+{
+	ARG_UNUSED(inst);
+
+#if defined(CONFIG_NRF_COMPRESS_COMPRESSION)
+	if (encoder != NULL) {
+		lz4_encoder_reset();
+	}
+#endif
+
+#if defined(CONFIG_NRF_COMPRESS_DECOMPRESSION)
+	if (decoder != NULL) {
+		lz4_decoder_reset();
+	}
+#endif
+
+	lz4_output_limit = decompressed_size != 0 ? decompressed_size : SIZE_MAX;
+
+	return 0;
+}
+
+static int lz4_init(void *inst, size_t decompressed_size)
+{
+#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC)
+#if defined(CONFIG_NRF_COMPRESS_COMPRESSION)
+	if (encoder == NULL) {
+		encoder = malloc(sizeof(*encoder));
+
+		if (encoder == NULL) {
+			LOG_ERR("Failed to allocate LZ4 compression buffer (%zu)",
+				sizeof(*encoder));
+			return -ENOMEM;
+		}
+	}
+#endif
+
+#if defined(CONFIG_NRF_COMPRESS_DECOMPRESSION)
+	if (decoder == NULL) {
+#if CONFIG_NRF_COMPRESS_MEMORY_ALIGNMENT > 1
+		decoder = aligned_alloc(CONFIG_NRF_COMPRESS_MEMORY_ALIGNMENT,
+					ROUND_UP(sizeof(*decoder),
+						 CONFIG_NRF_COMPRESS_MEMORY_ALIGNMENT));
+#else
+		decoder = malloc(sizeof(*decoder));
+#endif
+
+		if (decoder == NULL) {
+			LOG_ERR("Failed to allocate LZ4 decompression buffer (%zu)",
+				sizeof(*decoder));
+#if defined(CONFIG_NRF_COMPRESS_COMPRESSION)
+			free(encoder);
+			encoder = NULL;
+#endif
+			return -ENOMEM;
+		}
+	}
+#endif
+#endif
+
+	return lz4_reset(inst, decompressed_size);
+}
+
+static int lz4_deinit(void *inst)
+{
+	ARG_UNUSED(inst);
+
+#if defined(CONFIG_NRF_COMPRESS_COMPRESSION)
+	if (encoder != NULL) {
+#ifdef CONFIG_NRF_COMPRESS_CLEANUP
+		memset(encoder, 0x00, sizeof(*encoder));
+#endif
+		lz4_encoder_reset();
+
+#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC)
+		free(encoder);
+		encoder = NULL;
+#endif
+	}
+#endif
+
+#if defined(CONFIG_NRF_COMPRESS_DECOMPRESSION)
+	if (decoder != NULL) {
+#ifdef CONFIG_NRF_COMPRESS_CLEANUP
+		memset(decoder, 0x00, sizeof(*decoder));
+#endif
+		lz4_decoder_reset();
+
+#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC)
+		free(decoder);
+		decoder = NULL;
+#endif
+	}
+#endif
+
+	lz4_output_limit = SIZE_MAX;
+
+	return 0;
+}
+
+NRF_COMPRESS_IMPLEMENTATION_DEFINE(lz4, NRF_COMPRESS_TYPE_LZ4, lz4_init, lz4_deinit, lz4_reset,
+				   lz4_compress, lz4_bytes_needed, lz4_decompress);
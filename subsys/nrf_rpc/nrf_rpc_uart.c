@@ -15,24 +15,48 @@
 #include <zephyr/sys/byteorder.h>
 #include <zephyr/sys/crc.h>
 
+#include <string.h>
+
 LOG_MODULE_REGISTER(nrf_rpc_uart, CONFIG_NRF_RPC_TR_LOG_LEVEL);
 
 #define CRC_SIZE sizeof(uint16_t)
 
-enum {
-	HDLC_CHAR_ESCAPE = 0x7d,
-	HDLC_CHAR_DELIMITER = 0x7e,
-};
+/* Reliable data frame carries the sequence number between the packet and the checksum. */
+#define SEQ_SIZE COND_CODE_1(CONFIG_NRF_RPC_UART_RELIABLE, (1), (0))
+
+/* Ack frame carries the acknowledged sequence number and its inverted copy. */
+#define ACK_SIZE 2
+
+/*
+ * Control frame carries the frame type with the protocol version, a sequence number and a CRC8
+ * checksum. It is shorter than any data frame, because nRF RPC packets are never empty.
+ */
+#define CTRL_SIZE 3
+
+/* Version of the reliable protocol, exchanged in the low nibble of the control frame type. */
+#define PROTOCOL_VERSION 1
 
-enum flip_state {
-	FLIP_ZERO,
-	FLIP_ONE
+/* Worst case size of the HDLC-encoded frame, with every byte escaped. */
+#define TX_FRAME_MAX_SIZE (2 + 2 * (CONFIG_NRF_RPC_UART_MAX_PACKET_SIZE + SEQ_SIZE + CRC_SIZE))
+
+#if CONFIG_NRF_RPC_UART_RELIABLE
+#define WINDOW_SIZE CONFIG_NRF_RPC_UART_WINDOW_SIZE
+
+/* Window slots are indexed by the sequence number modulo the window size. */
+BUILD_ASSERT(IS_POWER_OF_TWO(WINDOW_SIZE), "Window size must be a power of two");
+BUILD_ASSERT(CTRL_SIZE == SEQ_SIZE + CRC_SIZE, "Control frame must have no packet");
+
+enum ctrl_type {
+	/* Sent by a transport that has just started, with its next sequence number. */
+	CTRL_RESET = 1,
+	/* Response to the reset frame, with the next sequence number of the responder. */
+	CTRL_RESET_ACK = 2,
 };
+#endif
 
-struct trx_flips {
-	uint8_t tx_flip : 1;
-	uint8_t rx_flip_any : 1;
-	uint16_t last_rx_crc;
+enum {
+	HDLC_CHAR_ESCAPE = 0x7d,
+	HDLC_CHAR_DELIMITER = 0x7e,
 };
 
 enum hdlc_state {
@@ -54,6 +78,27 @@ struct hdlc_decode_ctx {
 	uint16_t capacity;
 };
 
+#if CONFIG_NRF_RPC_UART_RELIABLE
+struct tx_slot {
+	/* Sent packet waiting for acknowledgment, or NULL if the slot is free. */
+	const uint8_t *data;
+	size_t len;
+	/* Time when the last transmission of the packet was completed. */
+	int64_t sent_time;
+	uint8_t attempts;
+	/* The packet is being transmitted, so it must not be freed on acknowledgment. */
+	bool tx_busy;
+	/* The packet was acknowledged while being transmitted. */
+	bool acked;
+};
+
+struct rx_slot {
+	/* Length of the packet received out of order, or 0 if the slot is free. */
+	uint16_t len;
+	uint8_t data[CONFIG_NRF_RPC_UART_MAX_PACKET_SIZE];
+};
+#endif
+
 struct nrf_rpc_uart {
 	const struct device *uart;
 	nrf_rpc_tr_receive_handler_t receive_callback;
@@ -72,22 +117,58 @@ struct nrf_rpc_uart {
 
 	/* HDLC ack decoding state */
 	struct hdlc_decode_ctx rx_ack_ctx;
-	uint8_t rx_ack[CRC_SIZE];
+	uint8_t rx_ack[ACK_SIZE];
 
 	/* HDLC packet decoding state */
 	struct hdlc_decode_ctx rx_pkt_ctx;
-	uint8_t rx_pkt[CONFIG_NRF_RPC_UART_MAX_PACKET_SIZE];
+	uint8_t rx_pkt[CONFIG_NRF_RPC_UART_MAX_PACKET_SIZE + SEQ_SIZE + CRC_SIZE];
+
+#if CONFIG_NRF_RPC_UART_ASYNC_API
+	/* RX DMA buffers used alternately by the UART driver */
+	uint8_t rx_async_buf[2][CONFIG_NRF_RPC_UART_ASYNC_RX_BUF_SIZE];
+	uint8_t rx_async_buf_idx;
 
-	/* Ack waiting semaphore */
-	struct k_sem ack_sem;
-	uint16_t ack_payload;
-	struct k_mutex ack_tx_lock;
-	struct trx_flips flips;
+	/* HDLC-encoded frame sent in a single DMA transfer */
+	uint8_t tx_frame[TX_FRAME_MAX_SIZE];
+	struct k_sem tx_done_sem;
+#endif
 
-	/* TX lock */
+#if CONFIG_NRF_RPC_UART_RELIABLE
+	/* Sent packets waiting for acknowledgment, from tx_base up to tx_next */
+	struct tx_slot tx_window[WINDOW_SIZE];
+	uint8_t tx_base;
+	uint8_t tx_next;
+	struct k_spinlock tx_window_lock;
+	struct k_sem tx_slots_sem;
+	struct k_work_delayable retx_work;
+
+	/*
+	 * The reset handshake with the peer has completed, so both sides agree on the sequence
+	 * numbers. Protected by the window lock.
+	 */
+	bool synced;
+
+	/* Sequence number of the next packet to pass to nRF RPC */
+	uint8_t rx_seq;
+#if WINDOW_SIZE > 1
+	struct rx_slot rx_window[WINDOW_SIZE];
+#endif
+#endif
+
+	struct nrf_rpc_uart_stats stats;
+	struct k_spinlock stats_lock;
+
+	/* TX lock, serializes frames sent by the application and the RX thread */
 	struct k_mutex tx_lock;
 };
 
+#define STATS_ADD(_uart_tr, _field, _val)                                                          \
+	do {                                                                                       \
+		k_spinlock_key_t _key = k_spin_lock(&(_uart_tr)->stats_lock);                      \
+		(_uart_tr)->stats._field += (_val);                                                \
+		k_spin_unlock(&(_uart_tr)->stats_lock, _key);                                      \
+	} while (0)
+
 static void log_hexdump_dbg(const uint8_t *data, size_t length, const char *fmt, ...)
 {
 	if (IS_ENABLED(CONFIG_NRF_RPC_TR_LOG_LEVEL_DBG)) {
@@ -102,93 +183,537 @@ static void log_hexdump_dbg(const uint8_t *data, size_t length, const char *fmt,
 	}
 }
 
-static void send_byte(const struct device *dev, uint8_t byte);
+#if !CONFIG_NRF_RPC_UART_ASYNC_API
+static void send_byte(const struct device *dev, uint8_t byte)
+{
+	if (byte == HDLC_CHAR_DELIMITER || byte == HDLC_CHAR_ESCAPE) {
+		uart_poll_out(dev, HDLC_CHAR_ESCAPE);
+		byte ^= 0x20;
+	}
 
-static void ack_rx(struct nrf_rpc_uart *uart_tr)
+	uart_poll_out(dev, byte);
+}
+#else
+static size_t hdlc_encode(uint8_t *out, const uint8_t *in, size_t len)
 {
-	if (!IS_ENABLED(CONFIG_NRF_RPC_UART_RELIABLE) || uart_tr->rx_ack_ctx.len != CRC_SIZE) {
-		log_hexdump_dbg(uart_tr->rx_ack, uart_tr->rx_ack_ctx.len, ">>> RX invalid frame");
+	size_t out_len = 0;
+
+	for (size_t i = 0; i < len; i++) {
+		if (in[i] == HDLC_CHAR_DELIMITER || in[i] == HDLC_CHAR_ESCAPE) {
+			out[out_len++] = HDLC_CHAR_ESCAPE;
+			out[out_len++] = in[i] ^ 0x20;
+		} else {
+			out[out_len++] = in[i];
+		}
+	}
+
+	return out_len;
+}
+#endif /* !CONFIG_NRF_RPC_UART_ASYNC_API */
+
+/*
+ * Sends a single frame composed of the packet and the trailer, which contains the sequence number
+ * and the checksum. Must be called with the TX lock held.
+ */
+static void tx_frame(struct nrf_rpc_uart *uart_tr, const uint8_t *data, size_t len,
+		     const uint8_t *trailer, size_t trailer_len)
+{
+#if CONFIG_NRF_RPC_UART_ASYNC_API
+	uint8_t *out = uart_tr->tx_frame;
+	size_t out_len = 0;
+	int err;
+
+	out[out_len++] = HDLC_CHAR_DELIMITER;
+	out_len += hdlc_encode(&out[out_len], data, len);
+	out_len += hdlc_encode(&out[out_len], trailer, trailer_len);
+	out[out_len++] = HDLC_CHAR_DELIMITER;
+
+	err = uart_tx(uart_tr->uart, out, out_len, SYS_FOREVER_US);
+	if (err) {
+		LOG_ERR("Failed to start UART TX: %d", err);
 		return;
 	}
 
-	uint16_t rx_ack = sys_get_le16(uart_tr->rx_ack);
+	k_sem_take(&uart_tr->tx_done_sem, K_FOREVER);
+#else
+	uart_poll_out(uart_tr->uart, HDLC_CHAR_DELIMITER);
+
+	for (size_t i = 0; i < len; i++) {
+		send_byte(uart_tr->uart, data[i]);
+	}
+
+	for (size_t i = 0; i < trailer_len; i++) {
+		send_byte(uart_tr->uart, trailer[i]);
+	}
+
+	uart_poll_out(uart_tr->uart, HDLC_CHAR_DELIMITER);
+#endif /* CONFIG_NRF_RPC_UART_ASYNC_API */
+}
+
+#if CONFIG_NRF_RPC_UART_RELIABLE
+static struct tx_slot *tx_slot_get(struct nrf_rpc_uart *uart_tr, uint8_t seq)
+{
+	return &uart_tr->tx_window[seq % WINDOW_SIZE];
+}
+
+/*
+ * Sends the control frame with the sequence number of the first packet in the window, which the
+ * peer expects next after the handshake. Must be called with the TX lock held.
+ */
+static void ctrl_tx(struct nrf_rpc_uart *uart_tr, enum ctrl_type type)
+{
+	uint8_t ctrl[CTRL_SIZE];
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&uart_tr->tx_window_lock);
+	ctrl[1] = uart_tr->tx_base;
+	k_spin_unlock(&uart_tr->tx_window_lock, key);
+
+	ctrl[0] = (type << 4) | PROTOCOL_VERSION;
+	ctrl[2] = crc8_ccitt(0xff, ctrl, CTRL_SIZE - 1);
 
-	LOG_DBG(">>> RX ack %04x", rx_ack);
+	LOG_DBG("<<< TX %s %02x", type == CTRL_RESET ? "reset" : "reset ack", ctrl[1]);
+	tx_frame(uart_tr, NULL, 0, ctrl, sizeof(ctrl));
+}
+
+/* Releases acknowledged packets from the beginning of the window. Must be called with the window
+ * lock held.
+ */
+static void tx_window_slide(struct nrf_rpc_uart *uart_tr)
+{
+	while (uart_tr->tx_base != uart_tr->tx_next &&
+	       tx_slot_get(uart_tr, uart_tr->tx_base)->data == NULL) {
+		uart_tr->tx_base++;
+		k_sem_give(&uart_tr->tx_slots_sem);
+	}
+}
 
-	if (uart_tr->ack_payload != rx_ack) {
-		LOG_WRN("Received ack %04x but expected %04x", rx_ack, uart_tr->ack_payload);
+static void tx_window_ack(struct nrf_rpc_uart *uart_tr, uint8_t seq)
+{
+	k_spinlock_key_t key = k_spin_lock(&uart_tr->tx_window_lock);
+	uint8_t in_flight = uart_tr->tx_next - uart_tr->tx_base;
+	struct tx_slot *slot = tx_slot_get(uart_tr, seq);
+	const uint8_t *free_data = NULL;
+
+	/* Acks received before the handshake refer to the packets sent before the restart. */
+	if (!uart_tr->synced || (uint8_t)(seq - uart_tr->tx_base) >= in_flight ||
+	    slot->data == NULL) {
+		k_spin_unlock(&uart_tr->tx_window_lock, key);
+		LOG_DBG("Ignored ack %02x", seq);
 		return;
 	}
 
-	k_sem_give(&uart_tr->ack_sem);
+	if (slot->tx_busy) {
+		slot->acked = true;
+	} else {
+		free_data = slot->data;
+		slot->data = NULL;
+		tx_window_slide(uart_tr);
+	}
+
+	k_spin_unlock(&uart_tr->tx_window_lock, key);
+
+	k_free((void *)free_data);
 }
 
-static void ack_tx(struct nrf_rpc_uart *uart_tr, uint16_t ack_pld)
+/*
+ * Sends the packet from the window slot. Until the handshake has completed, the peer would drop
+ * the packet, so the reset frame is sent instead. Must be called with the TX lock held.
+ */
+static void tx_slot_send(struct nrf_rpc_uart *uart_tr, uint8_t seq)
 {
-	uint8_t ack[2];
+	struct tx_slot *slot = tx_slot_get(uart_tr, seq);
+	const uint8_t *free_data = NULL;
+	k_spinlock_key_t key;
+	uint8_t trailer[SEQ_SIZE + CRC_SIZE];
+	uint16_t crc_val;
+	bool synced;
+
+	key = k_spin_lock(&uart_tr->tx_window_lock);
+	synced = uart_tr->synced;
+	k_spin_unlock(&uart_tr->tx_window_lock, key);
+
+	if (synced) {
+		crc_val = crc16_ccitt(0xffff, slot->data, slot->len);
+		crc_val = crc16_ccitt(crc_val, &seq, sizeof(seq));
+
+		trailer[0] = seq;
+		sys_put_le16(crc_val, &trailer[SEQ_SIZE]);
+
+		log_hexdump_dbg(slot->data, slot->len, "<<< TX packet %02x", seq);
+		tx_frame(uart_tr, slot->data, slot->len, trailer, sizeof(trailer));
+	} else {
+		ctrl_tx(uart_tr, CTRL_RESET);
+	}
+
+	key = k_spin_lock(&uart_tr->tx_window_lock);
+
+	slot->tx_busy = false;
+	slot->sent_time = k_uptime_get();
+
+	if (slot->acked) {
+		slot->acked = false;
+		free_data = slot->data;
+		slot->data = NULL;
+		tx_window_slide(uart_tr);
+	}
+
+	k_spin_unlock(&uart_tr->tx_window_lock, key);
+
+	k_free((void *)free_data);
+}
+
+/*
+ * Retransmits the packets whose acknowledgment timed out and drops the packets that reached
+ * the attempt limit. Returns the time until the next acknowledgment timeout, or K_FOREVER if no
+ * packets are waiting for acknowledgment.
+ */
+static k_timeout_t tx_retransmit(struct nrf_rpc_uart *uart_tr)
+{
+	int64_t next_timeout = INT64_MAX;
+	k_spinlock_key_t key;
+	uint8_t failures = 0;
+	uint8_t seq;
+
+	k_mutex_lock(&uart_tr->tx_lock, K_FOREVER);
 
-	if (!IS_ENABLED(CONFIG_NRF_RPC_UART_RELIABLE)) {
+	key = k_spin_lock(&uart_tr->tx_window_lock);
+	seq = uart_tr->tx_base;
+
+	while (seq != uart_tr->tx_next) {
+		struct tx_slot *slot = tx_slot_get(uart_tr, seq);
+		int64_t timeout = slot->sent_time + CONFIG_NRF_RPC_UART_ACK_WAITING_TIME;
+		const uint8_t *free_data;
+
+		if (slot->data == NULL) {
+			seq++;
+			continue;
+		}
+
+		if (timeout > k_uptime_get()) {
+			next_timeout = MIN(next_timeout, timeout);
+			seq++;
+			continue;
+		}
+
+		if (slot->attempts >= CONFIG_NRF_RPC_UART_TX_ATTEMPTS) {
+			LOG_ERR("Packet %02x not acknowledged after %u attempts", seq,
+				slot->attempts);
+
+			free_data = slot->data;
+			slot->data = NULL;
+			tx_window_slide(uart_tr);
+			k_spin_unlock(&uart_tr->tx_window_lock, key);
+
+			k_free((void *)free_data);
+			STATS_ADD(uart_tr, tx_failures, 1);
+			failures++;
+		} else {
+			LOG_WRN("Ack timeout, retransmitting packet %02x", seq);
+
+			slot->attempts++;
+			slot->tx_busy = true;
+			k_spin_unlock(&uart_tr->tx_window_lock, key);
+
+			tx_slot_send(uart_tr, seq);
+			STATS_ADD(uart_tr, retransmits, 1);
+		}
+
+		key = k_spin_lock(&uart_tr->tx_window_lock);
+
+		/* The window might have slid when the lock was released. */
+		if ((uint8_t)(seq - uart_tr->tx_base) >= (uint8_t)(uart_tr->tx_next - uart_tr->tx_base)) {
+			seq = uart_tr->tx_base;
+		}
+	}
+
+	k_spin_unlock(&uart_tr->tx_window_lock, key);
+	k_mutex_unlock(&uart_tr->tx_lock);
+
+	/*
+	 * The packets were already accepted by send(), so the loss is reported through the nRF RPC
+	 * error handler. The transport does not decode the packets, so the group, the command and
+	 * the packet type are not known.
+	 */
+	for (uint8_t i = 0; i < failures; i++) {
+		nrf_rpc_err(-EPROTO, NRF_RPC_ERR_SRC_SEND, NULL, NRF_RPC_ID_UNKNOWN,
+			    NRF_RPC_PACKET_TYPE_CMD);
+	}
+
+	if (next_timeout == INT64_MAX) {
+		return K_FOREVER;
+	}
+
+	return K_MSEC(MAX(next_timeout - k_uptime_get(), 0));
+}
+
+/*
+ * Assigns consecutive sequence numbers, starting from the beginning of the window, to the packets
+ * that have not been acknowledged yet, and makes them due for transmission with all the attempts
+ * available. The packets acknowledged out of order by the peer before its restart are not
+ * retransmitted, so their sequence numbers are reused. Must be called with the TX lock and the
+ * window lock held.
+ */
+static void tx_window_restart(struct nrf_rpc_uart *uart_tr)
+{
+	uint8_t next = uart_tr->tx_base;
+
+	for (uint8_t seq = uart_tr->tx_base; seq != uart_tr->tx_next; seq++) {
+		struct tx_slot *slot = tx_slot_get(uart_tr, seq);
+
+		if (slot->data == NULL) {
+			continue;
+		}
+
+		slot->attempts = 0;
+		slot->sent_time = 0;
+
+		if (seq != next) {
+			*tx_slot_get(uart_tr, next) = *slot;
+			slot->data = NULL;
+		}
+
+		next++;
+	}
+
+	while (uart_tr->tx_next != next) {
+		uart_tr->tx_next--;
+		k_sem_give(&uart_tr->tx_slots_sem);
+	}
+}
+
+static void retx_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct nrf_rpc_uart *uart_tr = CONTAINER_OF(dwork, struct nrf_rpc_uart, retx_work);
+	k_timeout_t next_timeout = tx_retransmit(uart_tr);
+
+	if (!K_TIMEOUT_EQ(next_timeout, K_FOREVER)) {
+		k_work_reschedule_for_queue(&uart_tr->rx_workq, &uart_tr->retx_work, next_timeout);
+	}
+}
+#endif /* CONFIG_NRF_RPC_UART_RELIABLE */
+
+static void ack_rx(struct nrf_rpc_uart *uart_tr)
+{
+	if (!IS_ENABLED(CONFIG_NRF_RPC_UART_RELIABLE) || uart_tr->rx_ack_ctx.len != ACK_SIZE) {
+		log_hexdump_dbg(uart_tr->rx_ack, uart_tr->rx_ack_ctx.len, ">>> RX invalid frame");
 		return;
 	}
 
-	sys_put_le16(ack_pld, ack);
-	k_mutex_lock(&uart_tr->ack_tx_lock, K_FOREVER);
-	LOG_DBG("<<< TX ack %04x", ack_pld);
+#if CONFIG_NRF_RPC_UART_RELIABLE
+	uint8_t rx_ack = uart_tr->rx_ack[0];
 
-	uart_poll_out(uart_tr->uart, HDLC_CHAR_DELIMITER);
+	if ((uint8_t)~uart_tr->rx_ack[1] != rx_ack) {
+		LOG_WRN("Received corrupted ack");
+		return;
+	}
 
-	send_byte(uart_tr->uart, ack[0]);
-	send_byte(uart_tr->uart, ack[1]);
+	LOG_DBG(">>> RX ack %02x", rx_ack);
 
-	uart_poll_out(uart_tr->uart, HDLC_CHAR_DELIMITER);
+	tx_window_ack(uart_tr, rx_ack);
+#endif /* CONFIG_NRF_RPC_UART_RELIABLE */
+}
+
+#if CONFIG_NRF_RPC_UART_RELIABLE
+static void ack_tx(struct nrf_rpc_uart *uart_tr, uint8_t seq)
+{
+	uint8_t ack[ACK_SIZE] = {seq, ~seq};
 
-	k_mutex_unlock(&uart_tr->ack_tx_lock);
+	k_mutex_lock(&uart_tr->tx_lock, K_FOREVER);
+	LOG_DBG("<<< TX ack %02x", seq);
+
+	tx_frame(uart_tr, NULL, 0, ack, sizeof(ack));
+
+	k_mutex_unlock(&uart_tr->tx_lock);
+}
+#endif /* CONFIG_NRF_RPC_UART_RELIABLE */
+
+static void packet_deliver(struct nrf_rpc_uart *uart_tr, const uint8_t *data, size_t len)
+{
+	STATS_ADD(uart_tr, rx_frames, 1);
+	STATS_ADD(uart_tr, rx_bytes, len);
+
+	uart_tr->receive_callback(uart_tr->transport, data, len, uart_tr->receive_ctx);
+}
+
+#if CONFIG_NRF_RPC_UART_RELIABLE
+/* Passes the next packet to nRF RPC if it has been already received out of order. */
+static bool rx_window_deliver_next(struct nrf_rpc_uart *uart_tr)
+{
+#if WINDOW_SIZE > 1
+	struct rx_slot *slot = &uart_tr->rx_window[uart_tr->rx_seq % WINDOW_SIZE];
+
+	if (slot->len > 0) {
+		packet_deliver(uart_tr, slot->data, slot->len);
+		slot->len = 0;
+		return true;
+	}
+#endif
+	return false;
 }
 
-static uint16_t tx_flip(struct nrf_rpc_uart *uart_tr, uint16_t crc_val)
+static void rx_window_receive(struct nrf_rpc_uart *uart_tr, uint8_t seq, const uint8_t *data,
+			      size_t len)
 {
-	if (!IS_ENABLED(CONFIG_NRF_RPC_UART_RELIABLE)) {
-		return crc_val;
+	k_spinlock_key_t key;
+	uint8_t offset;
+	bool synced;
+
+	key = k_spin_lock(&uart_tr->tx_window_lock);
+	synced = uart_tr->synced;
+	k_spin_unlock(&uart_tr->tx_window_lock, key);
+
+	if (!synced) {
+		/*
+		 * The peer does not know about the restart, because the reset frame was lost.
+		 * Drop the packet without the ack, so that it is retransmitted after the handshake.
+		 */
+		LOG_WRN("Packet %02x received before handshake", seq);
+		k_mutex_lock(&uart_tr->tx_lock, K_FOREVER);
+		ctrl_tx(uart_tr, CTRL_RESET);
+		k_mutex_unlock(&uart_tr->tx_lock);
+		return;
 	}
 
-	if (uart_tr->flips.tx_flip == FLIP_ZERO) {
-		crc_val &= 0x7fffu;
-		uart_tr->flips.tx_flip = FLIP_ONE;
-	} else {
-		crc_val |= 0x8000u;
-		uart_tr->flips.tx_flip = FLIP_ZERO;
+	offset = seq - uart_tr->rx_seq;
+
+	if (offset >= (uint8_t)(UINT8_MAX + 1 - WINDOW_SIZE)) {
+		/* The packet was already received, but the peer has not received the ack. */
+		LOG_WRN("Duplicate packet %02x", seq);
+		STATS_ADD(uart_tr, duplicates, 1);
+		ack_tx(uart_tr, seq);
+		return;
+	}
+
+	if (offset >= WINDOW_SIZE) {
+		/* The peer can only send beyond the window if it gave up on the missing packets. */
+		LOG_WRN("Packets %02x-%02x lost", uart_tr->rx_seq,
+			(uint8_t)(seq - WINDOW_SIZE));
+
+		while (offset >= WINDOW_SIZE) {
+			rx_window_deliver_next(uart_tr);
+			uart_tr->rx_seq++;
+			offset--;
+		}
+	}
+
+	ack_tx(uart_tr, seq);
+
+	if (offset == 0) {
+		packet_deliver(uart_tr, data, len);
+		uart_tr->rx_seq++;
+
+		while (rx_window_deliver_next(uart_tr)) {
+			uart_tr->rx_seq++;
+		}
+
+		return;
+	}
+
+#if WINDOW_SIZE > 1
+	struct rx_slot *slot = &uart_tr->rx_window[seq % WINDOW_SIZE];
+
+	if (slot->len > 0) {
+		LOG_WRN("Duplicate packet %02x", seq);
+		STATS_ADD(uart_tr, duplicates, 1);
+		return;
+	}
+
+	memcpy(slot->data, data, len);
+	slot->len = len;
+#endif
+}
+
+/*
+ * Passes the packets received out of order to nRF RPC, because the restarted peer will not
+ * retransmit the packets missing before them, and expects the next packet with the given
+ * sequence number.
+ */
+static void rx_window_reset(struct nrf_rpc_uart *uart_tr, uint8_t seq)
+{
+	for (uint8_t i = 0; i < WINDOW_SIZE; i++) {
+		rx_window_deliver_next(uart_tr);
+		uart_tr->rx_seq++;
 	}
 
-	return crc_val;
+	uart_tr->rx_seq = seq;
 }
 
-static bool rx_flip_check(struct nrf_rpc_uart *uart_tr, uint16_t crc_val)
+/*
+ * Completes the handshake and retransmits the packets waiting for acknowledgment. On reception of
+ * the reset frame, the handshake is repeated every time the peer restarts, and the reset ack
+ * frame lets the peer know the next sequence number.
+ */
+static void session_start(struct nrf_rpc_uart *uart_tr, enum ctrl_type type, uint8_t seq)
 {
-	uint16_t last_rx_crc;
+	k_spinlock_key_t key;
+	bool synced;
 
-	if (!IS_ENABLED(CONFIG_NRF_RPC_UART_RELIABLE)) {
-		return false;
+	/* The flag is only set in the RX thread, so it cannot change after it is read. */
+	key = k_spin_lock(&uart_tr->tx_window_lock);
+	synced = uart_tr->synced;
+	k_spin_unlock(&uart_tr->tx_window_lock, key);
+
+	/* Repeated reset ack must not rewind the sequence number of already received packets. */
+	if (type == CTRL_RESET_ACK && synced) {
+		LOG_DBG("Ignored reset ack %02x", seq);
+		return;
 	}
 
-	last_rx_crc = uart_tr->flips.last_rx_crc;
-	uart_tr->flips.last_rx_crc = crc_val;
+	rx_window_reset(uart_tr, seq);
 
-	if (uart_tr->flips.rx_flip_any == 1 || last_rx_crc != crc_val) {
-		uart_tr->flips.rx_flip_any = 0;
-		return false;
+	k_mutex_lock(&uart_tr->tx_lock, K_FOREVER);
+
+	key = k_spin_lock(&uart_tr->tx_window_lock);
+	tx_window_restart(uart_tr);
+	uart_tr->synced = true;
+	k_spin_unlock(&uart_tr->tx_window_lock, key);
+
+	if (type == CTRL_RESET) {
+		ctrl_tx(uart_tr, CTRL_RESET_ACK);
 	}
 
-	return true;
+	k_mutex_unlock(&uart_tr->tx_lock);
+
+	k_work_reschedule_for_queue(&uart_tr->rx_workq, &uart_tr->retx_work, K_NO_WAIT);
 }
 
-static bool crc_compare(uint16_t rx_crc, uint16_t calc_crc)
+static void ctrl_rx(struct nrf_rpc_uart *uart_tr)
 {
-	if (IS_ENABLED(CONFIG_NRF_RPC_UART_RELIABLE)) {
-		return (rx_crc & 0x7fffu) == (calc_crc & 0x7fffu);
+	const uint8_t *ctrl = uart_tr->rx_pkt;
+	uint8_t type = ctrl[0] >> 4;
+	uint8_t version = ctrl[0] & 0x0f;
+
+	if (crc8_ccitt(0xff, ctrl, CTRL_SIZE - 1) != ctrl[CTRL_SIZE - 1]) {
+		LOG_WRN("Received corrupted control frame");
+		STATS_ADD(uart_tr, crc_errors, 1);
+		return;
+	}
+
+	if (version != PROTOCOL_VERSION) {
+		LOG_ERR("Peer uses protocol version %u, but only version %u is supported", version,
+			PROTOCOL_VERSION);
+		nrf_rpc_err(-EPROTONOSUPPORT, NRF_RPC_ERR_SRC_RECV, NULL, NRF_RPC_ID_UNKNOWN,
+			    NRF_RPC_PACKET_TYPE_CMD);
+		return;
 	}
 
-	return rx_crc == calc_crc;
+	switch (type) {
+	case CTRL_RESET:
+		LOG_INF("Peer restarted, next sequence number %02x", ctrl[1]);
+		session_start(uart_tr, CTRL_RESET, ctrl[1]);
+		break;
+	case CTRL_RESET_ACK:
+		LOG_DBG(">>> RX reset ack %02x", ctrl[1]);
+		session_start(uart_tr, CTRL_RESET_ACK, ctrl[1]);
+		break;
+	default:
+		LOG_WRN("Unknown control frame %02x", ctrl[0]);
+		break;
+	}
 }
+#endif /* CONFIG_NRF_RPC_UART_RELIABLE */
 
 static void hdlc_decode_byte(struct hdlc_decode_ctx *ctx, uint8_t *out, uint8_t in)
 {
@@ -229,14 +754,36 @@ static void hdlc_decode_byte(struct hdlc_decode_ctx *ctx, uint8_t *out, uint8_t
 	out[ctx->len++] = in;
 }
 
+static void frame_rx(struct nrf_rpc_uart *uart_tr)
+{
+	size_t len = uart_tr->rx_pkt_ctx.len - CRC_SIZE;
+	uint16_t crc_received = sys_get_le16(uart_tr->rx_pkt + len);
+	uint16_t crc_calculated = crc16_ccitt(0xffff, uart_tr->rx_pkt, len);
+
+	if (crc_received != crc_calculated) {
+		LOG_ERR("Invalid packet CRC: calculated %04x but received %04x", crc_calculated,
+			crc_received);
+		STATS_ADD(uart_tr, crc_errors, 1);
+		return;
+	}
+
+#if CONFIG_NRF_RPC_UART_RELIABLE
+	uint8_t seq = uart_tr->rx_pkt[--len];
+
+	log_hexdump_dbg(uart_tr->rx_pkt, len, ">>> RX packet %02x", seq);
+	rx_window_receive(uart_tr, seq, uart_tr->rx_pkt, len);
+#else
+	log_hexdump_dbg(uart_tr->rx_pkt, len, ">>> RX packet %04x", crc_received);
+	packet_deliver(uart_tr, uart_tr->rx_pkt, len);
+#endif
+}
+
 static void work_handler(struct k_work *work)
 {
 	struct nrf_rpc_uart *uart_tr = CONTAINER_OF(work, struct nrf_rpc_uart, rx_work);
 	uint8_t *data;
 	size_t len;
 	int ret;
-	uint16_t crc_received = 0;
-	uint16_t crc_calculated = 0;
 
 	while (!ring_buf_is_empty(&uart_tr->rx_ringbuf)) {
 		len = ring_buf_get_claim(&uart_tr->rx_ringbuf, &data,
@@ -248,34 +795,19 @@ static void work_handler(struct k_work *work)
 				continue;
 			}
 
-			/* ACKs are already handled in ISR, so process only normal packets here */
-			if (uart_tr->rx_pkt_ctx.len <= CRC_SIZE) {
+#if CONFIG_NRF_RPC_UART_RELIABLE
+			if (uart_tr->rx_pkt_ctx.len == CTRL_SIZE) {
+				ctrl_rx(uart_tr);
 				continue;
 			}
+#endif
 
-			uart_tr->rx_pkt_ctx.len -= CRC_SIZE;
-			crc_received = sys_get_le16(uart_tr->rx_pkt + uart_tr->rx_pkt_ctx.len);
-			crc_calculated =
-				crc16_ccitt(0xffff, uart_tr->rx_pkt, uart_tr->rx_pkt_ctx.len);
-
-			log_hexdump_dbg(uart_tr->rx_pkt, uart_tr->rx_pkt_ctx.len,
-					">>> RX packet %04x", crc_received);
-
-			if (!crc_compare(crc_received, crc_calculated)) {
-				LOG_ERR("Invalid packet CRC: calculated %04x but received %04x",
-					crc_calculated, crc_received);
+			/* ACKs are already handled in ISR, so process only normal packets here */
+			if (uart_tr->rx_pkt_ctx.len <= SEQ_SIZE + CRC_SIZE) {
 				continue;
 			}
 
-			ack_tx(uart_tr, crc_received);
-
-			if (rx_flip_check(uart_tr, crc_received)) {
-				LOG_WRN("Duplicate packet %04x", crc_received);
-			} else {
-				uart_tr->receive_callback(uart_tr->transport, uart_tr->rx_pkt,
-							  uart_tr->rx_pkt_ctx.len,
-							  uart_tr->receive_ctx);
-			}
+			frame_rx(uart_tr);
 		}
 
 		ret = ring_buf_get_finish(&uart_tr->rx_ringbuf, len);
@@ -296,6 +828,67 @@ static void decode_ack(struct nrf_rpc_uart *inst, const uint8_t *in, size_t len)
 	}
 }
 
+#if CONFIG_NRF_RPC_UART_ASYNC_API
+static uint8_t *rx_async_buf_next(struct nrf_rpc_uart *uart_tr)
+{
+	uart_tr->rx_async_buf_idx ^= 1;
+
+	return uart_tr->rx_async_buf[uart_tr->rx_async_buf_idx];
+}
+
+static int rx_async_enable(struct nrf_rpc_uart *uart_tr)
+{
+	return uart_rx_enable(uart_tr->uart, rx_async_buf_next(uart_tr),
+			      CONFIG_NRF_RPC_UART_ASYNC_RX_BUF_SIZE,
+			      CONFIG_NRF_RPC_UART_ASYNC_RX_TIMEOUT_US);
+}
+
+static void async_cb(const struct device *uart, struct uart_event *evt, void *user_data)
+{
+	struct nrf_rpc_uart *uart_tr = user_data;
+	const uint8_t *rx_data;
+	uint32_t written;
+	int err;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		k_sem_give(&uart_tr->tx_done_sem);
+		break;
+	case UART_RX_RDY:
+		rx_data = evt->data.rx.buf + evt->data.rx.offset;
+
+		decode_ack(uart_tr, rx_data, evt->data.rx.len);
+
+		written = ring_buf_put(&uart_tr->rx_ringbuf, rx_data, evt->data.rx.len);
+		if (written < evt->data.rx.len) {
+			LOG_WRN("RX ring buffer full");
+			STATS_ADD(uart_tr, rx_overruns, evt->data.rx.len - written);
+		}
+
+		k_work_submit_to_queue(&uart_tr->rx_workq, &uart_tr->rx_work);
+		break;
+	case UART_RX_BUF_REQUEST:
+		err = uart_rx_buf_rsp(uart, rx_async_buf_next(uart_tr),
+				      CONFIG_NRF_RPC_UART_ASYNC_RX_BUF_SIZE);
+		if (err) {
+			LOG_ERR("Failed to provide RX buffer: %d", err);
+		}
+		break;
+	case UART_RX_STOPPED:
+		LOG_WRN("RX stopped, reason: %d", evt->data.rx_stop.reason);
+		break;
+	case UART_RX_DISABLED:
+		err = rx_async_enable(uart_tr);
+		if (err) {
+			LOG_ERR("Failed to re-enable RX: %d", err);
+		}
+		break;
+	default:
+		break;
+	}
+}
+#else
 static void serial_cb(const struct device *uart, void *user_data)
 {
 	struct nrf_rpc_uart *uart_tr = user_data;
@@ -324,6 +917,7 @@ static void serial_cb(const struct device *uart, void *user_data)
 			LOG_WRN("RX ring buffer full");
 
 			rx_len = uart_fifo_read(uart, &dummy, 1);
+			STATS_ADD(uart_tr, rx_overruns, rx_len);
 		}
 	}
 
@@ -331,6 +925,7 @@ static void serial_cb(const struct device *uart, void *user_data)
 		k_work_submit_to_queue(&uart_tr->rx_workq, &uart_tr->rx_work);
 	}
 }
+#endif /* CONFIG_NRF_RPC_UART_ASYNC_API */
 
 static int init(const struct nrf_rpc_tr *transport, nrf_rpc_tr_receive_handler_t receive_cb,
 		void *context)
@@ -357,6 +952,17 @@ static int init(const struct nrf_rpc_tr *transport, nrf_rpc_tr_receive_handler_t
 		return -NRF_ENOENT;
 	}
 
+#if CONFIG_NRF_RPC_UART_ASYNC_API
+	/* configure asynchronous API callback to send and receive data */
+	int ret = uart_callback_set(uart_tr->uart, async_cb, uart_tr);
+
+	if (ret < 0) {
+		LOG_ERR("Error setting UART callback: %d", ret);
+		return -NRF_EIO;
+	}
+
+	k_sem_init(&uart_tr->tx_done_sem, 0, 1);
+#else
 	/* configure interrupt and callback to receive data */
 	int ret = uart_irq_callback_user_data_set(uart_tr->uart, serial_cb, uart_tr);
 
@@ -370,15 +976,14 @@ static int init(const struct nrf_rpc_tr *transport, nrf_rpc_tr_receive_handler_t
 		}
 		return 0;
 	}
+#endif /* CONFIG_NRF_RPC_UART_ASYNC_API */
 
 	k_mutex_init(&uart_tr->tx_lock);
 
-	if (IS_ENABLED(CONFIG_NRF_RPC_UART_RELIABLE)) {
-		k_mutex_init(&uart_tr->ack_tx_lock);
-		k_sem_init(&uart_tr->ack_sem, 0, 1);
-		uart_tr->flips.tx_flip = FLIP_ZERO;
-		uart_tr->flips.rx_flip_any = 1;
-	}
+#if CONFIG_NRF_RPC_UART_RELIABLE
+	k_sem_init(&uart_tr->tx_slots_sem, WINDOW_SIZE, WINDOW_SIZE);
+	k_work_init_delayable(&uart_tr->retx_work, retx_work_handler);
+#endif
 
 	k_work_queue_init(&uart_tr->rx_workq);
 	k_work_queue_start(&uart_tr->rx_workq, uart_tr->rx_workq_stack,
@@ -392,76 +997,86 @@ static int init(const struct nrf_rpc_tr *transport, nrf_rpc_tr_receive_handler_t
 	uart_tr->rx_pkt_ctx.capacity = sizeof(uart_tr->rx_pkt);
 	uart_tr->rx_ack_ctx.state = HDLC_STATE_UNSYNC;
 	uart_tr->rx_ack_ctx.capacity = sizeof(uart_tr->rx_ack);
+
+#if CONFIG_NRF_RPC_UART_ASYNC_API
+	ret = rx_async_enable(uart_tr);
+	if (ret < 0) {
+		LOG_ERR("Failed to enable RX: %d", ret);
+		return -NRF_EIO;
+	}
+#else
 	uart_irq_rx_enable(uart_tr->uart);
-	nrf_rpc_uart_initialized_hook(uart_tr->uart);
+#endif
 
-	return 0;
-}
+#if CONFIG_NRF_RPC_UART_RELIABLE
+	/* Let the peer know about the restart, so that it resets the sequence numbers. */
+	k_mutex_lock(&uart_tr->tx_lock, K_FOREVER);
+	ctrl_tx(uart_tr, CTRL_RESET);
+	k_mutex_unlock(&uart_tr->tx_lock);
+#endif
 
-static void send_byte(const struct device *dev, uint8_t byte)
-{
-	if (byte == HDLC_CHAR_DELIMITER || byte == HDLC_CHAR_ESCAPE) {
-		uart_poll_out(dev, HDLC_CHAR_ESCAPE);
-		byte ^= 0x20;
-	}
+	nrf_rpc_uart_initialized_hook(uart_tr->uart);
 
-	uart_poll_out(dev, byte);
+	return 0;
 }
 
 static int send(const struct nrf_rpc_tr *transport, const uint8_t *data, size_t length)
 {
-	uint8_t crc[2];
-	uint16_t crc_val;
-	bool acked = true;
 	struct nrf_rpc_uart *uart_tr = transport->ctx;
 
-	k_mutex_lock(&uart_tr->tx_lock, K_FOREVER);
+#if CONFIG_NRF_RPC_UART_RELIABLE
+	struct tx_slot *slot;
+	k_spinlock_key_t key;
+	uint8_t seq;
+
+	/*
+	 * Wait for a free slot in the window. If the function is called from the RX thread,
+	 * the retransmission work cannot run, so retransmit lost packets while waiting.
+	 */
+	while (k_sem_take(&uart_tr->tx_slots_sem, K_MSEC(CONFIG_NRF_RPC_UART_ACK_WAITING_TIME))) {
+		(void)tx_retransmit(uart_tr);
+	}
 
-	crc_val = crc16_ccitt(0xffff, data, length);
-	crc_val = tx_flip(uart_tr, crc_val);
-	log_hexdump_dbg(data, length, "<<< TX packet %04x", crc_val);
+	k_mutex_lock(&uart_tr->tx_lock, K_FOREVER);
 
-#if CONFIG_NRF_RPC_UART_RELIABLE
-	int attempts = 0;
+	key = k_spin_lock(&uart_tr->tx_window_lock);
+	seq = uart_tr->tx_next++;
+	slot = tx_slot_get(uart_tr, seq);
+	slot->data = data;
+	slot->len = length;
+	slot->attempts = 1;
+	slot->tx_busy = true;
+	slot->acked = false;
+	k_spin_unlock(&uart_tr->tx_window_lock, key);
 
-	uart_tr->ack_payload = crc_val;
-	acked = false;
+	tx_slot_send(uart_tr, seq);
 
-	do {
-		attempts++;
-		k_mutex_lock(&uart_tr->ack_tx_lock, K_FOREVER);
-		k_sem_reset(&uart_tr->ack_sem);
-#endif /* CONFIG_NRF_RPC_UART_RELIABLE */
+	k_mutex_unlock(&uart_tr->tx_lock);
 
-		uart_poll_out(uart_tr->uart, HDLC_CHAR_DELIMITER);
+	/* Does not postpone the already scheduled retransmission check. */
+	k_work_schedule_for_queue(&uart_tr->rx_workq, &uart_tr->retx_work,
+				  K_MSEC(CONFIG_NRF_RPC_UART_ACK_WAITING_TIME));
+#else
+	uint8_t crc[CRC_SIZE];
+	uint16_t crc_val;
 
-		for (size_t i = 0; i < length; i++) {
-			send_byte(uart_tr->uart, data[i]);
-		}
+	k_mutex_lock(&uart_tr->tx_lock, K_FOREVER);
 
-		sys_put_le16(crc_val, crc);
-		send_byte(uart_tr->uart, crc[0]);
-		send_byte(uart_tr->uart, crc[1]);
+	crc_val = crc16_ccitt(0xffff, data, length);
+	sys_put_le16(crc_val, crc);
+	log_hexdump_dbg(data, length, "<<< TX packet %04x", crc_val);
 
-		uart_poll_out(uart_tr->uart, HDLC_CHAR_DELIMITER);
+	tx_frame(uart_tr, data, length, crc, sizeof(crc));
 
-#if CONFIG_NRF_RPC_UART_RELIABLE
-		k_mutex_unlock(&uart_tr->ack_tx_lock);
-		if (k_sem_take(&uart_tr->ack_sem, K_MSEC(CONFIG_NRF_RPC_UART_ACK_WAITING_TIME)) ==
-		    0) {
-			acked = true;
-			LOG_DBG("Acked successfully");
-		} else {
-			LOG_WRN("Ack timeout");
-		}
-	} while (!acked && attempts < CONFIG_NRF_RPC_UART_TX_ATTEMPTS);
-#endif /* CONFIG_NRF_RPC_UART_RELIABLE */
+	k_mutex_unlock(&uart_tr->tx_lock);
 
 	k_free((void *)data);
+#endif /* CONFIG_NRF_RPC_UART_RELIABLE */
 
-	k_mutex_unlock(&uart_tr->tx_lock);
+	STATS_ADD(uart_tr, tx_frames, 1);
+	STATS_ADD(uart_tr, tx_bytes, length);
 
-	return acked ? 0 : -EPROTO;
+	return 0;
 }
 
 static void *tx_buf_alloc(const struct nrf_rpc_tr *transport, size_t *size)
@@ -490,6 +1105,30 @@ static void tx_buf_free(const struct nrf_rpc_tr *transport, void *buf)
 	k_free(buf);
 }
 
+int nrf_rpc_uart_stats_get(const struct nrf_rpc_tr *transport, struct nrf_rpc_uart_stats *stats,
+			   bool reset)
+{
+	struct nrf_rpc_uart *uart_tr;
+	k_spinlock_key_t key;
+
+	if (transport == NULL || stats == NULL) {
+		return -EINVAL;
+	}
+
+	uart_tr = transport->ctx;
+	key = k_spin_lock(&uart_tr->stats_lock);
+
+	*stats = uart_tr->stats;
+
+	if (reset) {
+		memset(&uart_tr->stats, 0, sizeof(uart_tr->stats));
+	}
+
+	k_spin_unlock(&uart_tr->stats_lock, key);
+
+	return 0;
+}
+
 __weak void nrf_rpc_uart_initialized_hook(const struct device *uart_dev)
 {
 }
@@ -515,3 +1154,4 @@ const struct nrf_rpc_tr_api nrf_rpc_uart_service_api = {
 	};
 
 DT_FOREACH_STATUS_OKAY(nordic_nrf_uarte, NRF_RPC_UART_TRANSPORT_DEFINE);
+DT_FOREACH_STATUS_OKAY(zephyr_uart_emul, NRF_RPC_UART_TRANSPORT_DEFINE);
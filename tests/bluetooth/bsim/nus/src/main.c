@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <bluetooth/services/nus.h>
+
+#include <babblekit/testcase.h>
+#include <bstests.h>
+#include <bs_tracing.h>
+#include <bs_types.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(nus_test, LOG_LEVEL_INF);
+
+extern enum bst_result_t bst_result;
+
+/* Size of a single bt_nus_send() call, typical for UART bridges. */
+#define CHUNK_SIZE		20
+#define TX_DURATION_MS		5000
+#define MIN_FILL_RATIO		80
+#define DEVICE_NAME		CONFIG_BT_DEVICE_NAME
+#define DEVICE_NAME_LEN		(sizeof(DEVICE_NAME) - 1)
+
+static struct bt_conn *default_conn;
+
+static K_SEM_DEFINE(sem_connected, 0, 1);
+static K_SEM_DEFINE(sem_mtu, 0, 1);
+static K_SEM_DEFINE(sem_subscribed, 0, 1);
+static K_SEM_DEFINE(sem_discovered, 0, 1);
+static K_SEM_DEFINE(sem_rx_done, 0, 1);
+
+static const struct bt_data ad[] = {
+	BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
+	BT_DATA(BT_DATA_NAME_COMPLETE, DEVICE_NAME, DEVICE_NAME_LEN),
+};
+
+static const struct bt_data sd[] = {
+	BT_DATA_BYTES(BT_DATA_UUID128_ALL, BT_UUID_NUS_VAL),
+};
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	if (err) {
+		TEST_FAIL("Connection failed (err %u)", err);
+		return;
+	}
+
+	if (!default_conn) {
+		default_conn = bt_conn_ref(conn);
+	}
+
+	k_sem_give(&sem_connected);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	if (conn != default_conn) {
+		return;
+	}
+
+	bt_conn_unref(default_conn);
+	default_conn = NULL;
+
+	if (bst_result != Passed) {
+		TEST_FAIL("Disconnected (reason 0x%02x)", reason);
+	}
+}
+
+BT_CONN_CB_DEFINE(conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+static void mtu_updated(struct bt_conn *conn, uint16_t tx, uint16_t rx)
+{
+	LOG_INF("MTU updated: TX %u RX %u", tx, rx);
+}
+
+static struct bt_gatt_cb gatt_callbacks = {
+	.att_mtu_updated = mtu_updated,
+};
+
+static void send_enabled(enum bt_nus_send_status status)
+{
+	if (status == BT_NUS_SEND_STATUS_ENABLED) {
+		k_sem_give(&sem_subscribed);
+	}
+}
+
+static struct bt_nus_cb nus_cb = {
+	.send_enabled = send_enabled,
+};
+
+static void peripheral_main(void)
+{
+	struct bt_nus_tx_stats stats;
+	uint8_t chunk[CHUNK_SIZE];
+	uint8_t counter = 0;
+	int64_t end;
+	int err;
+
+	bt_gatt_cb_register(&gatt_callbacks);
+
+	err = bt_nus_init(&nus_cb);
+	if (err) {
+		TEST_FAIL("Failed to initialize NUS (err %d)", err);
+		return;
+	}
+
+	err = bt_enable(NULL);
+	if (err) {
+		TEST_FAIL("Bluetooth init failed (err %d)", err);
+		return;
+	}
+
+	err = bt_le_adv_start(BT_LE_ADV_CONN_FAST_1, ad, ARRAY_SIZE(ad), sd, ARRAY_SIZE(sd));
+	if (err) {
+		TEST_FAIL("Advertising failed to start (err %d)", err);
+		return;
+	}
+
+	k_sem_take(&sem_connected, K_FOREVER);
+	k_sem_take(&sem_subscribed, K_FOREVER);
+
+	LOG_INF("Sending data for %d ms", TX_DURATION_MS);
+
+	(void)bt_nus_tx_stats_get(default_conn, &stats, true);
+	end = k_uptime_get() + TX_DURATION_MS;
+
+	while (k_uptime_get() < end) {
+		for (size_t i = 0; i < sizeof(chunk); i++) {
+			chunk[i] = counter++;
+		}
+
+		do {
+			err = bt_nus_send(default_conn, chunk, sizeof(chunk));
+			if (err == -ENOMEM) {
+				/* TX queue is full, wait for the link to drain it. */
+				k_sleep(K_MSEC(1));
+			}
+		} while (err == -ENOMEM);
+
+		if (err) {
+			TEST_FAIL("Failed to send data (err %d)", err);
+			return;
+		}
+	}
+
+	err = bt_nus_flush(default_conn);
+	if (err) {
+		TEST_FAIL("Failed to flush data (err %d)", err);
+		return;
+	}
+
+	/* Give the link time to send the remaining data. */
+	k_sleep(K_MSEC(500));
+
+	err = bt_nus_tx_stats_get(default_conn, &stats, false);
+	if (err) {
+		TEST_FAIL("Failed to get TX statistics (err %d)", err);
+		return;
+	}
+
+	LOG_INF("Sent %u bytes in %u notifications, fill ratio %u%%, throughput %u B/s",
+		stats.bytes, stats.notifications, stats.fill_ratio, stats.throughput);
+
+	if (stats.fill_ratio < MIN_FILL_RATIO) {
+		TEST_FAIL("Notification fill ratio too low (%u%%)", stats.fill_ratio);
+		return;
+	}
+
+	TEST_PASS("Peripheral done");
+}
+
+static struct bt_gatt_discover_params discover_params;
+static struct bt_gatt_subscribe_params subscribe_params;
+static uint8_t rx_expected;
+static uint32_t rx_bytes;
+static uint32_t rx_notifications;
+static int64_t rx_start;
+static int64_t rx_last;
+
+static uint8_t notify_cb(struct bt_conn *conn, struct bt_gatt_subscribe_params *params,
+			 const void *data, uint16_t length)
+{
+	const uint8_t *buf = data;
+
+	if (!data) {
+		return BT_GATT_ITER_STOP;
+	}
+
+	if (rx_bytes == 0) {
+		rx_start = k_uptime_get();
+	}
+
+	for (uint16_t i = 0; i < length; i++) {
+		if (buf[i] != rx_expected) {
+			TEST_FAIL("Data mismatch at byte %u: 0x%02x != 0x%02x",
+				  rx_bytes + i, buf[i], rx_expected);
+			return BT_GATT_ITER_STOP;
+		}
+
+		rx_expected++;
+	}
+
+	rx_bytes += length;
+	rx_notifications++;
+	rx_last = k_uptime_get();
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static uint8_t discover_cb(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+			   struct bt_gatt_discover_params *params)
+{
+	const struct bt_gatt_chrc *chrc;
+
+	if (!attr) {
+		TEST_FAIL("NUS TX characteristic not found");
+		return BT_GATT_ITER_STOP;
+	}
+
+	chrc = attr->user_data;
+
+	subscribe_params.notify = notify_cb;
+	subscribe_params.value = BT_GATT_CCC_NOTIFY;
+	subscribe_params.value_handle = chrc->value_handle;
+	subscribe_params.ccc_handle = BT_GATT_AUTO_DISCOVER_CCC_HANDLE;
+	subscribe_params.end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE;
+	subscribe_params.disc_params = &discover_params;
+
+	k_sem_give(&sem_discovered);
+
+	return BT_GATT_ITER_STOP;
+}
+
+static void exchange_cb(struct bt_conn *conn, uint8_t err,
+			struct bt_gatt_exchange_params *params)
+{
+	if (err) {
+		TEST_FAIL("MTU exchange failed (err %u)", err);
+		return;
+	}
+
+	k_sem_give(&sem_mtu);
+}
+
+static bool ad_name_check(struct bt_data *data, void *user_data)
+{
+	bool *found = user_data;
+
+	if ((data->type == BT_DATA_NAME_COMPLETE) && (data->data_len == DEVICE_NAME_LEN) &&
+	    !memcmp(data->data, DEVICE_NAME, DEVICE_NAME_LEN)) {
+		*found = true;
+		return false;
+	}
+
+	return true;
+}
+
+static void device_found(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
+			 struct net_buf_simple *ad_buf)
+{
+	bool found = false;
+	int err;
+
+	if (default_conn || (type != BT_GAP_ADV_TYPE_ADV_IND)) {
+		return;
+	}
+
+	bt_data_parse(ad_buf, ad_name_check, &found);
+	if (!found) {
+		return;
+	}
+
+	err = bt_le_scan_stop();
+	if (err) {
+		TEST_FAIL("Failed to stop scanning (err %d)", err);
+		return;
+	}
+
+	err = bt_conn_le_create(addr, BT_CONN_LE_CREATE_CONN, BT_LE_CONN_PARAM_DEFAULT,
+				&default_conn);
+	if (err) {
+		TEST_FAIL("Failed to create connection (err %d)", err);
+	}
+}
+
+static void central_main(void)
+{
+	static struct bt_gatt_exchange_params exchange_params = {
+		.func = exchange_cb,
+	};
+	uint32_t duration;
+	int err;
+
+	bt_gatt_cb_register(&gatt_callbacks);
+
+	err = bt_enable(NULL);
+	if (err) {
+		TEST_FAIL("Bluetooth init failed (err %d)", err);
+		return;
+	}
+
+	err = bt_le_scan_start(BT_LE_SCAN_PASSIVE, device_found);
+	if (err) {
+		TEST_FAIL("Scanning failed to start (err %d)", err);
+		return;
+	}
+
+	k_sem_take(&sem_connected, K_FOREVER);
+
+	err = bt_gatt_exchange_mtu(default_conn, &exchange_params);
+	if (err) {
+		TEST_FAIL("Failed to exchange MTU (err %d)", err);
+		return;
+	}
+
+	k_sem_take(&sem_mtu, K_FOREVER);
+
+	discover_params.uuid = BT_UUID_NUS_TX;
+	discover_params.func = discover_cb;
+	discover_params.start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE;
+	discover_params.end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE;
+	discover_params.type = BT_GATT_DISCOVER_CHARACTERISTIC;
+
+	err = bt_gatt_discover(default_conn, &discover_params);
+	if (err) {
+		TEST_FAIL("Discovery failed (err %d)", err);
+		return;
+	}
+
+	k_sem_take(&sem_discovered, K_FOREVER);
+
+	err = bt_gatt_subscribe(default_conn, &subscribe_params);
+	if (err) {
+		TEST_FAIL("Failed to subscribe (err %d)", err);
+		return;
+	}
+
+	/* The peripheral sends data for a fixed time, wait until it stops. */
+	k_sleep(K_MSEC(TX_DURATION_MS + 2000));
+
+	if (rx_bytes == 0) {
+		TEST_FAIL("No data received");
+		return;
+	}
+
+	duration = MAX(rx_last - rx_start, 1);
+
+	LOG_INF("Received %u bytes in %u notifications, throughput %u B/s",
+		rx_bytes, rx_notifications, (uint32_t)((uint64_t)rx_bytes * 1000 / duration));
+
+	if ((rx_bytes / rx_notifications) <= CHUNK_SIZE) {
+		TEST_FAIL("Notifications not coalesced (%u bytes per notification)",
+			  rx_bytes / rx_notifications);
+		return;
+	}
+
+	TEST_PASS("Central done");
+}
+
+static void test_delete(void)
+{
+	if (bst_result != Passed) {
+		TEST_FAIL("Test did not finish");
+	}
+}
+
+static const struct bst_test_instance test_vector[] = {
+	{
+		.test_id = "nus_peripheral",
+		.test_descr = "Send small chunks of data with the coalesced NUS TX",
+		.test_main_f = peripheral_main,
+		.test_delete_f = test_delete,
+	},
+	{
+		.test_id = "nus_central",
+		.test_descr = "Receive NUS notifications and verify the data",
+		.test_main_f = central_main,
+		.test_delete_f = test_delete,
+	},
+	BSTEST_END_MARKER,
+};
+
+struct bst_test_list *test_nus_install(struct bst_test_list *tests)
+{
+	return bst_add_tests(tests, test_vector);
+}
+
+bst_test_install_t test_installers[] = {test_nus_install, NULL};
+
+int main(void)
+{
+	bst_main();
+	return 0;
+}
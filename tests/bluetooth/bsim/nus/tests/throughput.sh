@@ -0,0 +1,25 @@
+#!/usr/bin/env bash
+# Copyright 2026 Nordic Semiconductor ASA
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+# Small writes passed to bt_nus_send() are coalesced into MTU-sized
+# notifications. The central verifies the received data and reports the
+# throughput, the peripheral checks the notification fill ratio.
+
+source ${ZEPHYR_BASE}/tests/bsim/sh_common.source
+
+SIMULATION_ID="nus_throughput"
+VERBOSITY_LEVEL=2
+EXECUTE_TIMEOUT=60
+
+cd ${BSIM_OUT_PATH}/bin
+
+Execute ./bs_nrf52_bsim____nrf_tests_bluetooth_bsim_nus_prj_conf \
+  -v=${VERBOSITY_LEVEL} -s=${SIMULATION_ID} -d=0 -testid=nus_peripheral
+
+Execute ./bs_nrf52_bsim____nrf_tests_bluetooth_bsim_nus_prj_conf \
+  -v=${VERBOSITY_LEVEL} -s=${SIMULATION_ID} -d=1 -testid=nus_central
+
+Execute ./bs_2G4_phy_v1 -v=${VERBOSITY_LEVEL} -s=${SIMULATION_ID} -D=2 -sim_length=30e6
+
+wait_for_background_jobs
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <mock_nrf_rpc_transport.h>
+#include <drivers/flash/flash_rpc.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/sys/util.h>
+
+#define FLASH_DEV DEVICE_DT_GET(DT_NODELABEL(rpc_flash_controller))
+
+/* Macros for constructing nRF RPC packets for the flash_rpc_api group. */
+
+#define RPC_PKT(bytes...)                                                                          \
+	(mock_nrf_rpc_pkt_t)                                                                       \
+	{                                                                                          \
+		.data = (uint8_t[]){bytes}, .len = sizeof((uint8_t[]){bytes}),                     \
+	}
+
+#define RPC_INIT_REQ                                                                               \
+	RPC_PKT(0x04, 0x00, 0xff, 0x00, 0xff, 0x00, 'f', 'l', 'a', 's', 'h', '_', 'r', 'p', 'c',   \
+		'_', 'a', 'p', 'i')
+#define RPC_INIT_RSP                                                                               \
+	RPC_PKT(0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 'f', 'l', 'a', 's', 'h', '_', 'r', 'p', 'c',   \
+		'_', 'a', 'p', 'i')
+#define RPC_CMD(cmd, ...) RPC_PKT(0x80, cmd, 0xff, 0x00, 0x00 __VA_OPT__(,) __VA_ARGS__, 0xf6)
+#define RPC_RSP(...)	  RPC_PKT(0x01, 0xff, 0x00, 0x00, 0x00 __VA_OPT__(,) __VA_ARGS__, 0xf6)
+#define RPC_EVT(evt, ...) RPC_PKT(0x00, evt, 0xff, 0x00, 0x00 __VA_OPT__(,) __VA_ARGS__, 0xf6)
+#define RPC_ACK(evt)	  RPC_PKT(0x02, evt, 0xff, 0x00, 0x00)
+#define NO_RSP		  RPC_PKT()
+
+#define CBOR_UINT16(value) 0x19, (((value) >> 8) & 0xff), ((value) & 0xff)
+#define CBOR_BSTR8(len)	   0x40 | (len)
+#define CBOR_BSTR(len)	   0x58, (len)
+#define CBOR_EIO	   0x24
+
+#define DATA_BYTE(n, base) ((base) + (n))
+#define DATA(len, base)	   LISTIFY(len, DATA_BYTE, (,), base)
+
+static const struct device *const flash_dev = FLASH_DEV;
+static const uint8_t data[] = {DATA(40, 0)};
+
+static void write_done_send(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	/* Results of both writes in flight, the second one failed. */
+	mock_nrf_rpc_tr_receive(RPC_EVT(RPC_EVENT_FLASH_WRITE_DONE, 0x00, 0x00));
+	mock_nrf_rpc_tr_receive(RPC_EVT(RPC_EVENT_FLASH_WRITE_DONE, 0x01, CBOR_EIO));
+}
+
+static K_WORK_DELAYABLE_DEFINE(write_done_work, write_done_send);
+
+static void *suite_setup(void)
+{
+	mock_nrf_rpc_tr_expect_add(RPC_INIT_REQ, RPC_INIT_RSP);
+	mock_nrf_rpc_tr_expect_add(RPC_CMD(RPC_COMMAND_FLASH_INIT), RPC_RSP(0x00));
+	zassert_ok(device_init(flash_dev));
+	mock_nrf_rpc_tr_expect_done();
+
+	return NULL;
+}
+
+ZTEST(flash_rpc_pipeline, test_unaligned_write)
+{
+	/* Rejected before anything is buffered or sent. */
+	zassert_equal(flash_write(flash_dev, 0x101, data, 4), -EINVAL);
+	zassert_equal(flash_write(flash_dev, 0x100, data, 3), -EINVAL);
+	zassert_equal(flash_write(flash_dev, DT_SIZE_K(256) - 4, data, 8), -EINVAL);
+	mock_nrf_rpc_tr_expect_done();
+}
+
+ZTEST(flash_rpc_pipeline, test_write_pipeline)
+{
+	struct k_work_sync sync;
+	struct flash_rpc_stats stats;
+
+	zassert_ok(flash_rpc_stats_get(&stats, true));
+
+	/* Contiguous writes are merged without sending anything. */
+	zassert_ok(flash_write(flash_dev, 0x100, data, 16));
+	zassert_ok(flash_write(flash_dev, 0x110, &data[16], 16));
+	mock_nrf_rpc_tr_expect_done();
+
+	/* A write that does not follow the buffered data sends it. */
+	mock_nrf_rpc_tr_expect_add(RPC_EVT(RPC_EVENT_FLASH_WRITE, 0x00, CBOR_UINT16(0x100),
+					   CBOR_BSTR(32), DATA(32, 0)),
+				   RPC_ACK(RPC_EVENT_FLASH_WRITE));
+	zassert_ok(flash_write(flash_dev, 0x200, &data[32], 8));
+	mock_nrf_rpc_tr_expect_done();
+
+	/* Flush sends the rest without waiting for the first result, then waits
+	 * for the results of both writes and reports the error.
+	 */
+	mock_nrf_rpc_tr_expect_add(RPC_EVT(RPC_EVENT_FLASH_WRITE, 0x01, CBOR_UINT16(0x200),
+					   CBOR_BSTR8(8), DATA(8, 32)),
+				   RPC_ACK(RPC_EVENT_FLASH_WRITE));
+	mock_nrf_rpc_tr_expect_add(RPC_ACK(RPC_EVENT_FLASH_WRITE_DONE), NO_RSP);
+	mock_nrf_rpc_tr_expect_add(RPC_ACK(RPC_EVENT_FLASH_WRITE_DONE), NO_RSP);
+	k_work_schedule(&write_done_work, K_MSEC(10));
+	zassert_equal(flash_rpc_flush(flash_dev), -EIO);
+	k_work_flush_delayable(&write_done_work, &sync);
+	mock_nrf_rpc_tr_expect_done();
+
+	/* The error is reported once. */
+	zassert_ok(flash_rpc_flush(flash_dev));
+
+	zassert_ok(flash_rpc_stats_get(&stats, false));
+	zassert_equal(stats.write_cnt, 3);
+	zassert_equal(stats.msg_cnt, 2);
+	zassert_equal(stats.byte_cnt, 40);
+	zassert_equal(stats.flush_cnt, 2);
+	zassert_equal(stats.max_in_flight, 2);
+	zassert_true(stats.busy_time_us > 0);
+}
+
+ZTEST_SUITE(flash_rpc_pipeline, NULL, suite_setup, NULL, NULL, NULL);
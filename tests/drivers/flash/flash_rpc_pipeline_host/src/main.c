@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <mock_nrf_rpc_transport.h>
+#include <drivers/flash/flash_rpc.h>
+#include <nrf_rpc.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/sys/util.h>
+
+#define FLASH_DEV DEVICE_DT_GET(DT_CHOSEN(zephyr_flash_controller))
+
+/* Macros for constructing nRF RPC packets for the flash_rpc_api group. */
+
+#define RPC_PKT(bytes...)                                                                          \
+	(mock_nrf_rpc_pkt_t)                                                                       \
+	{                                                                                          \
+		.data = (uint8_t[]){bytes}, .len = sizeof((uint8_t[]){bytes}),                     \
+	}
+
+#define RPC_INIT_REQ                                                                               \
+	RPC_PKT(0x04, 0x00, 0xff, 0x00, 0xff, 0x00, 'f', 'l', 'a', 's', 'h', '_', 'r', 'p', 'c',   \
+		'_', 'a', 'p', 'i')
+#define RPC_INIT_RSP                                                                               \
+	RPC_PKT(0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 'f', 'l', 'a', 's', 'h', '_', 'r', 'p', 'c',   \
+		'_', 'a', 'p', 'i')
+#define RPC_EVT(evt, ...) RPC_PKT(0x00, evt, 0xff, 0x00, 0x00 __VA_OPT__(,) __VA_ARGS__, 0xf6)
+#define RPC_ACK(evt)	  RPC_PKT(0x02, evt, 0xff, 0x00, 0x00)
+#define NO_RSP		  RPC_PKT()
+
+#define CBOR_UINT16(value) 0x19, (((value) >> 8) & 0xff), ((value) & 0xff)
+#define CBOR_BSTR8(len)	   0x40 | (len)
+#define CBOR_NEG8(value)   0x38, ((value) - 1)
+
+#define DATA_BYTE(n, base) ((base) + (n))
+#define DATA(len, base)	   LISTIFY(len, DATA_BYTE, (,), base)
+
+/* LISTIFY() needs literal lengths. */
+#define WRITE_LEN	   16
+#define OVERSIZED_LEN	   20
+#define WRITE_OFFSET	   0x100
+#define ERROR_OFFSET	   0x200
+#define WRITE_TIMEOUT	   K_MSEC(10)
+
+BUILD_ASSERT(WRITE_LEN == CONFIG_FLASH_RPC_PIPELINE_BUF_SIZE);
+
+static const struct device *const flash_dev = FLASH_DEV;
+static const uint8_t data[] = {DATA(WRITE_LEN, 0)};
+
+/* Sequence number of the next write sent by the controller. */
+static uint8_t seq;
+
+static void nrf_rpc_err_handler(const struct nrf_rpc_err_report *report)
+{
+	zassert_ok(report->code);
+}
+
+static void *suite_setup(void)
+{
+	mock_nrf_rpc_tr_expect_add(RPC_INIT_REQ, RPC_INIT_RSP);
+	zassert_ok(nrf_rpc_init(nrf_rpc_err_handler));
+	mock_nrf_rpc_tr_expect_reset();
+
+	zassert_ok(flash_erase(flash_dev, 0, 4096));
+
+	return NULL;
+}
+
+static void data_check(off_t offset)
+{
+	uint8_t buf[sizeof(data)];
+
+	zassert_ok(flash_read(flash_dev, offset, buf, sizeof(buf)));
+	zassert_mem_equal(buf, data, sizeof(buf));
+}
+
+ZTEST(flash_rpc_pipeline_host, test_write)
+{
+	mock_nrf_rpc_tr_expect_add(RPC_ACK(RPC_EVENT_FLASH_WRITE), NO_RSP);
+	mock_nrf_rpc_tr_expect_add(RPC_EVT(RPC_EVENT_FLASH_WRITE_DONE, seq, 0x00),
+				   RPC_ACK(RPC_EVENT_FLASH_WRITE_DONE));
+	mock_nrf_rpc_tr_receive(RPC_EVT(RPC_EVENT_FLASH_WRITE, seq, CBOR_UINT16(WRITE_OFFSET),
+					CBOR_BSTR8(WRITE_LEN), DATA(WRITE_LEN, 0)));
+	seq++;
+
+	k_sleep(WRITE_TIMEOUT);
+	mock_nrf_rpc_tr_expect_done();
+
+	data_check(WRITE_OFFSET);
+}
+
+ZTEST(flash_rpc_pipeline_host, test_write_errors)
+{
+	/* A write that does not fit in the buffer is completed with an error. */
+	mock_nrf_rpc_tr_expect_add(RPC_ACK(RPC_EVENT_FLASH_WRITE), NO_RSP);
+	mock_nrf_rpc_tr_expect_add(RPC_EVT(RPC_EVENT_FLASH_WRITE_DONE, seq, CBOR_NEG8(EMSGSIZE)),
+				   RPC_ACK(RPC_EVENT_FLASH_WRITE_DONE));
+	mock_nrf_rpc_tr_receive(RPC_EVT(RPC_EVENT_FLASH_WRITE, seq, CBOR_UINT16(ERROR_OFFSET),
+					CBOR_BSTR8(OVERSIZED_LEN), DATA(OVERSIZED_LEN, 0)));
+	seq++;
+
+	/* So is a write without the data. */
+	mock_nrf_rpc_tr_expect_add(RPC_ACK(RPC_EVENT_FLASH_WRITE), NO_RSP);
+	mock_nrf_rpc_tr_expect_add(RPC_EVT(RPC_EVENT_FLASH_WRITE_DONE, seq, CBOR_NEG8(EBADMSG)),
+				   RPC_ACK(RPC_EVENT_FLASH_WRITE_DONE));
+	mock_nrf_rpc_tr_receive(RPC_EVT(RPC_EVENT_FLASH_WRITE, seq, CBOR_UINT16(ERROR_OFFSET)));
+	seq++;
+
+	k_sleep(WRITE_TIMEOUT);
+	mock_nrf_rpc_tr_expect_done();
+
+	/* The failed writes release their slots, so the following write is not blocked. */
+	mock_nrf_rpc_tr_expect_add(RPC_ACK(RPC_EVENT_FLASH_WRITE), NO_RSP);
+	mock_nrf_rpc_tr_expect_add(RPC_EVT(RPC_EVENT_FLASH_WRITE_DONE, seq, 0x00),
+				   RPC_ACK(RPC_EVENT_FLASH_WRITE_DONE));
+	mock_nrf_rpc_tr_receive(RPC_EVT(RPC_EVENT_FLASH_WRITE, seq, CBOR_UINT16(ERROR_OFFSET),
+					CBOR_BSTR8(WRITE_LEN), DATA(WRITE_LEN, 0)));
+	seq++;
+
+	k_sleep(WRITE_TIMEOUT);
+	mock_nrf_rpc_tr_expect_done();
+
+	data_check(ERROR_OFFSET);
+}
+
+ZTEST_SUITE(flash_rpc_pipeline_host, NULL, suite_setup, NULL, NULL, NULL);
@@ -208,6 +208,9 @@ void setUp(void)
 	net_mgmt_NET_REQUEST_WIFI_SCAN_retval = -1;
 	net_mgmt_NET_REQUEST_WIFI_SCAN_expected = false;
 	net_mgmt_NET_REQUEST_WIFI_SCAN_occurred = false;
+#endif
+#if defined(CONFIG_LOCATION_RESULT_CACHE)
+	location_cache_clear();
 #endif
 	mock_nrf_modem_at_Init();
 }
@@ -2192,6 +2195,254 @@ void test_location_cellular_periodic(void)
 #endif
 }
 
+/********* PARALLEL MODE AND RESULT CACHE TESTS ***********************/
+
+/* Test that cellular location is returned in LOCATION_REQ_MODE_PARALLEL while GNSS is still
+ * waiting for LTE to enter PSM, and that GNSS is cancelled.
+ */
+void test_location_parallel_cellular_first(void)
+{
+#if defined(CONFIG_LOCATION_REQUEST_MODE_PARALLEL) && !defined(CONFIG_LOCATION_TEST_AGNSS)
+	int err;
+	int64_t start_time;
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_GNSS, LOCATION_METHOD_CELLULAR};
+
+	location_config_defaults_set(&config, 2, methods);
+	config.mode = LOCATION_REQ_MODE_PARALLEL;
+	config.methods[1].cellular.cell_count = 1;
+
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_CLOUD_LOCATION_EXT_REQUEST;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+	location_cb_expected++;
+
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_LOCATION;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+	test_location_event_data[location_cb_expected].location.latitude = 61.50375;
+	test_location_event_data[location_cb_expected].location.longitude = 23.896979;
+	test_location_event_data[location_cb_expected].location.accuracy = 750.0;
+	test_location_event_data[location_cb_expected].location.datetime.valid = false;
+	location_cb_expected++;
+
+	/* LTE is active and RRC is idle, so GNSS waits for PSM */
+	at_monitor_dispatch("%XMODEMSLEEP: 1,0");
+	at_monitor_dispatch("+CSCON: 0");
+	k_sleep(K_MSEC(1));
+
+	__cmock_nrf_modem_gnss_event_handler_set_ExpectAndReturn(&method_gnss_event_handler, 0);
+	__cmock_nrf_modem_gnss_fix_interval_set_ExpectAndReturn(1, 0);
+	__cmock_nrf_modem_gnss_use_case_set_ExpectAndReturn(
+		NRF_MODEM_GNSS_USE_CASE_MULTIPLE_HOT_START, 0);
+
+	__mock_nrf_modem_at_scanf_ExpectAndReturn(
+		"AT%XSYSTEMMODE?", "%%XSYSTEMMODE: %d,%d,%d,%d", 4);
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* LTE-M support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* NB-IoT support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* GNSS support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(0); /* LTE preference */
+
+	__cmock_nrf_modem_at_cmd_ExpectAndReturn(NULL, 0, "AT%%XMONITOR", 0);
+	__cmock_nrf_modem_at_cmd_IgnoreArg_buf();
+	__cmock_nrf_modem_at_cmd_IgnoreArg_len();
+	__cmock_nrf_modem_at_cmd_ReturnArrayThruPtr_buf(
+		(char *)xmonitor_resp_psm_on, sizeof(xmonitor_resp_psm_on));
+
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEAS=1", 0);
+
+	start_time = k_uptime_get();
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(0, err);
+	k_sleep(K_MSEC(1));
+
+	/* Cellular measurement runs although GNSS is blocked waiting for PSM */
+	at_monitor_dispatch(ncellmeas_resp_pci1);
+
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+
+	struct location_data location_data = {
+		.latitude = 61.50375,
+		.longitude = 23.896979,
+		.accuracy = 750.0,
+		.datetime.valid = false
+	};
+
+	/* GNSS is cancelled once cellular location is available */
+	__cmock_nrf_modem_gnss_stop_ExpectAndReturn(0);
+
+	location_cloud_location_ext_result_set(LOCATION_EXT_RESULT_SUCCESS, &location_data);
+
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+
+	/* Location is available long before GNSS would have even started */
+	TEST_ASSERT_LESS_THAN_UINT32(1000, (uint32_t)(k_uptime_get() - start_time));
+	k_sleep(K_MSEC(1));
+#else
+	TEST_IGNORE();
+#endif
+}
+
+/* Test that GNSS location is returned in LOCATION_REQ_MODE_PARALLEL when it's acquired before
+ * cellular location, and that cellular is cancelled.
+ */
+void test_location_parallel_gnss_first(void)
+{
+#if defined(CONFIG_LOCATION_REQUEST_MODE_PARALLEL) && !defined(CONFIG_LOCATION_TEST_AGNSS)
+	int err;
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_GNSS, LOCATION_METHOD_CELLULAR};
+
+	location_config_defaults_set(&config, 2, methods);
+	config.mode = LOCATION_REQ_MODE_PARALLEL;
+	config.accuracy_threshold = 50.0;
+	config.methods[1].cellular.cell_count = 1;
+
+	test_pvt_data.flags = NRF_MODEM_GNSS_PVT_FLAG_FIX_VALID;
+	test_pvt_data.latitude = 61.005;
+	test_pvt_data.longitude = -45.997;
+	test_pvt_data.accuracy = 15.83;
+	test_pvt_data.datetime.year = 2021;
+	test_pvt_data.datetime.month = 8;
+	test_pvt_data.datetime.day = 13;
+	test_pvt_data.datetime.hour = 12;
+	test_pvt_data.datetime.minute = 34;
+	test_pvt_data.datetime.seconds = 56;
+	test_pvt_data.datetime.ms = 789;
+
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_LOCATION;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_GNSS;
+	test_location_event_data[location_cb_expected].location.latitude = 61.005;
+	test_location_event_data[location_cb_expected].location.longitude = -45.997;
+	test_location_event_data[location_cb_expected].location.accuracy = 15.83;
+	test_location_event_data[location_cb_expected].location.datetime.valid = true;
+	test_location_event_data[location_cb_expected].location.datetime.year = 2021;
+	test_location_event_data[location_cb_expected].location.datetime.month = 8;
+	test_location_event_data[location_cb_expected].location.datetime.day = 13;
+	test_location_event_data[location_cb_expected].location.datetime.hour = 12;
+	test_location_event_data[location_cb_expected].location.datetime.minute = 34;
+	test_location_event_data[location_cb_expected].location.datetime.second = 56;
+	test_location_event_data[location_cb_expected].location.datetime.ms = 789;
+	location_cb_expected++;
+
+	at_monitor_dispatch("+CSCON: 0");
+	k_sleep(K_MSEC(1));
+
+	__cmock_nrf_modem_gnss_event_handler_set_ExpectAndReturn(&method_gnss_event_handler, 0);
+	__cmock_nrf_modem_gnss_fix_interval_set_ExpectAndReturn(1, 0);
+	__cmock_nrf_modem_gnss_use_case_set_ExpectAndReturn(
+		NRF_MODEM_GNSS_USE_CASE_MULTIPLE_HOT_START, 0);
+
+	__mock_nrf_modem_at_scanf_ExpectAndReturn(
+		"AT%XSYSTEMMODE?", "%%XSYSTEMMODE: %d,%d,%d,%d", 4);
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* LTE-M support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* NB-IoT support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* GNSS support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(0); /* LTE preference */
+
+	/* PSM is not configured so GNSS is started right away */
+	__cmock_nrf_modem_at_cmd_ExpectAndReturn(NULL, 0, "AT%%XMONITOR", 0);
+	__cmock_nrf_modem_at_cmd_IgnoreArg_buf();
+	__cmock_nrf_modem_at_cmd_IgnoreArg_len();
+	__cmock_nrf_modem_at_cmd_ReturnArrayThruPtr_buf(
+		(char *)xmonitor_resp, sizeof(xmonitor_resp));
+	__cmock_nrf_modem_gnss_start_ExpectAndReturn(0);
+
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEAS=1", 0);
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(0, err);
+	k_sleep(K_MSEC(1));
+
+	__cmock_nrf_modem_gnss_read_ExpectAndReturn(
+		NULL, sizeof(test_pvt_data), NRF_MODEM_GNSS_DATA_PVT, 0);
+	__cmock_nrf_modem_gnss_read_IgnoreArg_buf();
+	__cmock_nrf_modem_gnss_read_ReturnMemThruPtr_buf(&test_pvt_data, sizeof(test_pvt_data));
+	__cmock_nrf_modem_gnss_stop_ExpectAndReturn(0);
+
+	/* Ongoing neighbor cell measurement is stopped once GNSS location is available */
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEASSTOP", 0);
+
+	method_gnss_event_handler(NRF_MODEM_GNSS_EVT_PVT);
+
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+
+	/* Need to wait a bit because no %NCELLMEAS notification is sent after AT%NCELLMEASSTOP. */
+	k_sleep(K_MSEC(2100));
+#else
+	TEST_IGNORE();
+#endif
+}
+
+/* Test that a location request is answered from the cache when a location acquired with
+ * the same method in the same cell is available.
+ */
+void test_location_cache(void)
+{
+#if defined(CONFIG_LOCATION_RESULT_CACHE) && !defined(CONFIG_LOCATION_DATA_DETAILS)
+	int err;
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_CELLULAR};
+
+	location_config_defaults_set(&config, 1, methods);
+	config.methods[0].cellular.cell_count = 1;
+
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_CLOUD_LOCATION_EXT_REQUEST;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+	location_cb_expected++;
+
+	for (int i = 0; i < 2; i++) {
+		test_location_event_data[location_cb_expected].id = LOCATION_EVT_LOCATION;
+		test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+		test_location_event_data[location_cb_expected].location.latitude = 61.50375;
+		test_location_event_data[location_cb_expected].location.longitude = 23.896979;
+		test_location_event_data[location_cb_expected].location.accuracy = 750.0;
+		test_location_event_data[location_cb_expected].location.datetime.valid = false;
+		location_cb_expected++;
+	}
+
+	/* Serving cell is needed for the location to be cached */
+	at_monitor_dispatch("+CEREG: 2,\"0140\",\"001F8414\",7\r\n");
+	k_sleep(K_MSEC(1));
+
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEAS=1", 0);
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(0, err);
+	k_sleep(K_MSEC(1));
+
+	at_monitor_dispatch(ncellmeas_resp_pci1);
+
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+
+	struct location_data location_data = {
+		.latitude = 61.50375,
+		.longitude = 23.896979,
+		.accuracy = 750.0,
+		.datetime.valid = false
+	};
+
+	location_cloud_location_ext_result_set(LOCATION_EXT_RESULT_SUCCESS, &location_data);
+
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+	k_sleep(K_MSEC(1));
+
+	/* No neighbor cell measurement nor cloud request is made for the second request */
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(0, err);
+
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(1));
+	TEST_ASSERT_EQUAL(0, err);
+	k_sleep(K_MSEC(1));
+#else
+	TEST_IGNORE();
+#endif
+}
+
 /* This is needed because AT Monitor library is initialized in SYS_INIT. */
 static int location_test_sys_init(void)
 {
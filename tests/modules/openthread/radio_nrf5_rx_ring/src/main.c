@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "radio_nrf5_rx_ring.h"
+
+#define RING_SIZE 5
+#define BURST_SIZE 4
+#define BURST_COUNT 250
+
+static struct nrf5_rx_ring ring;
+
+/* Sequence numbers of the synthetic frames stored in the slots. */
+static uint32_t slots[RING_SIZE];
+
+static void produce(uint32_t seq)
+{
+	int slot = nrf5_rx_ring_acquire(&ring);
+
+	if (slot < 0) {
+		return;
+	}
+
+	slots[slot] = seq;
+	nrf5_rx_ring_commit(&ring);
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	nrf5_rx_ring_init(&ring, RING_SIZE);
+}
+
+ZTEST(radio_nrf5_rx_ring, test_empty)
+{
+	zassert_true(nrf5_rx_ring_is_empty(&ring));
+	zassert_equal(nrf5_rx_ring_peek(&ring), -ENOENT);
+	zassert_equal(nrf5_rx_ring_count(&ring), 0);
+}
+
+ZTEST(radio_nrf5_rx_ring, test_overflow)
+{
+	/* Fill the ring that does not have a power of two size */
+	for (uint32_t i = 0; i < RING_SIZE; i++) {
+		zassert_equal(nrf5_rx_ring_acquire(&ring), i);
+		nrf5_rx_ring_commit(&ring);
+	}
+
+	zassert_equal(nrf5_rx_ring_acquire(&ring), -ENOMEM);
+	zassert_equal(ring.overflows, 1);
+	zassert_equal(ring.received, RING_SIZE);
+	zassert_equal(ring.high_watermark, RING_SIZE);
+
+	/* Releasing a slot makes it available to the producer again */
+	zassert_equal(nrf5_rx_ring_peek(&ring), 0);
+	nrf5_rx_ring_release(&ring);
+	zassert_equal(nrf5_rx_ring_acquire(&ring), 0);
+	zassert_equal(nrf5_rx_ring_count(&ring), RING_SIZE - 1);
+}
+
+ZTEST(radio_nrf5_rx_ring, test_wrap_around)
+{
+	uint32_t seq = 0;
+
+	/* Keep the ring partially filled while the positions wrap around several times */
+	for (uint32_t i = 0; i < 3; i++) {
+		produce(seq++);
+	}
+
+	for (uint32_t expected = 0; expected < 10 * RING_SIZE; expected++) {
+		int slot = nrf5_rx_ring_peek(&ring);
+
+		zassert_true(slot >= 0);
+		zassert_equal(slots[slot], expected);
+		nrf5_rx_ring_release(&ring);
+		produce(seq++);
+	}
+
+	zassert_equal(ring.overflows, 0);
+	zassert_equal(ring.high_watermark, 3);
+}
+
+/*
+ * Synthetic frame bursts delivered from the timer interrupt, as the radio driver does,
+ * and drained by a thread, as the OpenThread thread does.
+ */
+
+static K_SEM_DEFINE(rx_sem, 0, 1);
+static uint32_t produced;
+
+static void burst_handler(struct k_timer *timer)
+{
+	for (uint32_t i = 0; i < BURST_SIZE; i++) {
+		produce(produced++);
+	}
+
+	k_sem_give(&rx_sem);
+
+	if (produced == BURST_SIZE * BURST_COUNT) {
+		k_timer_stop(timer);
+	}
+}
+
+static K_TIMER_DEFINE(burst_timer, burst_handler, NULL);
+
+ZTEST(radio_nrf5_rx_ring, test_frame_burst)
+{
+	uint32_t consumed = 0;
+	uint32_t last_seq = 0;
+	int slot;
+
+	produced = 0;
+	k_timer_start(&burst_timer, K_MSEC(1), K_MSEC(1));
+
+	while (k_sem_take(&rx_sem, K_MSEC(100)) == 0) {
+		/* Drain all pending frames at once */
+		while ((slot = nrf5_rx_ring_peek(&ring)) >= 0) {
+			zassert_true(consumed == 0 || slots[slot] > last_seq,
+				     "Frames delivered out of order");
+			last_seq = slots[slot];
+			consumed++;
+			nrf5_rx_ring_release(&ring);
+		}
+	}
+
+	zassert_equal(produced, BURST_SIZE * BURST_COUNT);
+	zassert_equal(ring.received + ring.overflows, produced);
+	zassert_equal(consumed, ring.received);
+	zassert_true(ring.high_watermark >= BURST_SIZE);
+	zassert_true(ring.high_watermark <= RING_SIZE);
+}
+
+ZTEST_SUITE(radio_nrf5_rx_ring, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _BENCH_KEYMAP_H_
+#define _BENCH_KEYMAP_H_
+
+#include <caf/key_id.h>
+
+/* Full size keyboard with eight rows in every column. */
+#define BENCH_KEY_CNT		104
+#define BENCH_ROW_CNT		8
+
+#define BENCH_KEY_ID(i)		KEY_ID((i) / BENCH_ROW_CNT, (i) % BENCH_ROW_CNT)
+#define BENCH_USAGE_ID(i)	(0x04 + (i))
+
+#endif /* _BENCH_KEYMAP_H_ */
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "hid_keymap.h"
+#include "bench_keymap.h"
+
+/* This structure enforces the header file is included only once in the build.
+ * Violating this requirement triggers a multiple definition error at link time.
+ */
+const struct {} hid_keymap_def_include_once;
+
+#define BENCH_KEYMAP_ENTRY(i, _) \
+	{ BENCH_KEY_ID(i), BENCH_USAGE_ID(i), REPORT_ID_KEYBOARD_KEYS }
+
+/* Key IDs grow together with the index, so the keymap is sorted by key ID. */
+static const struct hid_keymap hid_keymap[] = {
+	LISTIFY(BENCH_KEY_CNT, BENCH_KEYMAP_ENTRY, (,))
+};
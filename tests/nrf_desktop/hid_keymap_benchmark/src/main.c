@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "hid_keymap.h"
+#include "keys_state.h"
+#include "bench_keymap.h"
+
+#define BENCH_LOOKUP_NUM	(10000)
+#define BENCH_STORM_NUM		(10000)
+#define BENCH_KEYS_PRESSED	(CONFIG_DESKTOP_KEYS_STATE_KEY_CNT_MAX)
+
+#if CONFIG_DESKTOP_HID_KEYMAP_HASH_INDEX
+#define BENCH_MODE_NAME		"hash_index"
+#else
+#define BENCH_MODE_NAME		"bsearch"
+#endif
+
+static struct keys_state keys_state;
+static uint32_t rand_state;
+
+/* Deterministic pseudo-random sequence keeps the results comparable between runs. */
+static size_t bench_key_idx_get(void)
+{
+	rand_state = rand_state * 1664525U + 1013904223U;
+
+	return (rand_state >> 16) % BENCH_KEY_CNT;
+}
+
+static void bench_print(const char *name, uint32_t cycles, uint32_t num)
+{
+	TC_PRINT("%s %s: %u events, %u cycles total, %u ns per event\n", BENCH_MODE_NAME, name,
+		 num, cycles, (uint32_t)(k_cyc_to_ns_floor64(cycles) / num));
+}
+
+static void key_update(size_t key_idx, bool pressed)
+{
+	const struct hid_keymap *map = hid_keymap_get(BENCH_KEY_ID(key_idx));
+	bool ks_changed;
+
+	zassert_not_null(map, "No mapping for key %zu", key_idx);
+	zassert_equal(map->usage_id, BENCH_USAGE_ID(key_idx), "Invalid mapping");
+	zassert_ok(keys_state_key_update(&keys_state, map->key_id, pressed, &ks_changed),
+		   "Cannot update keys state");
+}
+
+ZTEST(hid_keymap_benchmark, test_lookup)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (size_t i = 0; i < BENCH_LOOKUP_NUM; i++) {
+		size_t key_idx = bench_key_idx_get();
+		const struct hid_keymap *map = hid_keymap_get(BENCH_KEY_ID(key_idx));
+
+		zassert_not_null(map, "No mapping for key %zu", key_idx);
+		zassert_equal(map->key_id, BENCH_KEY_ID(key_idx), "Invalid mapping");
+	}
+
+	bench_print("lookup", k_cycle_get_32() - start, BENCH_LOOKUP_NUM);
+
+	/* Key IDs that are not part of the keymap. */
+	zassert_is_null(hid_keymap_get(KEY_ID(0, BENCH_ROW_CNT)), "Unexpected mapping");
+	zassert_is_null(hid_keymap_get(KEY_ID(127, 127)), "Unexpected mapping");
+}
+
+ZTEST(hid_keymap_benchmark, test_key_storm)
+{
+	size_t pressed[BENCH_KEYS_PRESSED];
+	uint16_t active[BENCH_KEYS_PRESSED];
+	size_t oldest = 0;
+
+	/* Keep the maximum number of keys pressed. Every step releases the oldest key and presses
+	 * a random one, so both key state insertions and removals shift the active keys.
+	 */
+	for (size_t i = 0; i < ARRAY_SIZE(pressed); i++) {
+		pressed[i] = bench_key_idx_get();
+		key_update(pressed[i], true);
+	}
+
+	uint32_t start = k_cycle_get_32();
+
+	for (size_t i = 0; i < BENCH_STORM_NUM; i++) {
+		key_update(pressed[oldest], false);
+
+		pressed[oldest] = bench_key_idx_get();
+		key_update(pressed[oldest], true);
+
+		oldest = (oldest + 1) % ARRAY_SIZE(pressed);
+	}
+
+	bench_print("key storm", k_cycle_get_32() - start, 2 * BENCH_STORM_NUM);
+
+	zassert_true(keys_state_keys_get(&keys_state, active, ARRAY_SIZE(active)) > 0,
+		     "No active keys");
+
+	for (size_t i = 0; i < ARRAY_SIZE(pressed); i++) {
+		key_update(pressed[i], false);
+	}
+
+	zassert_equal(keys_state_keys_get(&keys_state, active, ARRAY_SIZE(active)), 0,
+		      "Keys left active");
+}
+
+static void *hid_keymap_benchmark_setup(void)
+{
+	hid_keymap_init();
+	keys_state_init(&keys_state, BENCH_KEYS_PRESSED);
+
+	return NULL;
+}
+
+static void hid_keymap_benchmark_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	rand_state = 0x12345678;
+	keys_state_clear(&keys_state);
+}
+
+ZTEST_SUITE(hid_keymap_benchmark, NULL, hid_keymap_benchmark_setup, hid_keymap_benchmark_before,
+	    NULL, NULL);
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <app_event_manager.h>
+
+#include "motion_event.h"
+#include "hid_event.h"
+#include "config_event.h"
+
+#define MODULE main
+#include <caf/events/module_state_event.h>
+
+/* The module under test is the only config channel module in the test. */
+#define LATENCY_MODULE_ID	0
+
+/* Option indexes, as defined by the hid_latency_meas module. */
+enum latency_opt {
+	LATENCY_OPT_INPUT,
+	LATENCY_OPT_QUEUE,
+	LATENCY_OPT_SEND,
+	LATENCY_OPT_TOTAL,
+	LATENCY_OPT_RESET,
+};
+
+struct latency_stats {
+	uint32_t count;
+	uint32_t p50_us;
+	uint32_t p99_us;
+	uint32_t max_us;
+};
+
+#define INPUT_DELAY_US	1000
+#define SEND_DELAY_US	4000
+#define EVENT_TIMEOUT	K_SECONDS(1)
+
+static const void *const subscriber_a = (const void *)0x1000;
+static const void *const subscriber_b = (const void *)0x2000;
+
+static K_SEM_DEFINE(module_ready_sem, 0, 1);
+static K_SEM_DEFINE(config_rsp_sem, 0, 1);
+static uint8_t config_rsp_data[CONFIG_CHANNEL_FETCHED_DATA_MAX_SIZE];
+static size_t config_rsp_size;
+
+static void config_request_submit(enum latency_opt opt, uint8_t status)
+{
+	struct config_event *event = new_config_event(0);
+
+	event->transport_id = 0;
+	event->is_request = true;
+	event->recipient = CFG_CHAN_RECIPIENT_LOCAL;
+	event->status = status;
+	/* Option field 0 is reserved for the module description. */
+	event->event_id = MOD_FIELD_SET(LATENCY_MODULE_ID) | OPT_FIELD_SET(opt + 1);
+
+	APP_EVENT_SUBMIT(event);
+
+	zassert_ok(k_sem_take(&config_rsp_sem, EVENT_TIMEOUT), "No config channel response");
+}
+
+static struct latency_stats stats_fetch(enum latency_opt opt)
+{
+	struct latency_stats stats;
+
+	config_request_submit(opt, CONFIG_STATUS_FETCH);
+	zassert_equal(config_rsp_size, sizeof(stats), "Unexpected response size");
+
+	stats.count = sys_get_le32(&config_rsp_data[0]);
+	stats.p50_us = sys_get_le32(&config_rsp_data[4]);
+	stats.p99_us = sys_get_le32(&config_rsp_data[8]);
+	stats.max_us = sys_get_le32(&config_rsp_data[12]);
+
+	zassert_true(stats.p50_us <= stats.p99_us, "p50 above p99");
+	zassert_true(stats.p99_us <= stats.max_us, "p99 above maximum");
+
+	return stats;
+}
+
+static void motion_submit(uint32_t input_age_us)
+{
+	struct motion_event *event = new_motion_event();
+
+	event->dx = 1;
+	event->dy = 1;
+	event->timestamp = k_cycle_get_32() - k_us_to_cyc_ceil32(input_age_us);
+
+	APP_EVENT_SUBMIT(event);
+}
+
+static void hid_report_submit(const void *subscriber, uint8_t report_id)
+{
+	struct hid_report_event *event = new_hid_report_event(REPORT_SIZE_MOUSE + 1);
+
+	memset(event->dyndata.data, 0, event->dyndata.size);
+	event->dyndata.data[0] = report_id;
+	event->source = NULL;
+	event->subscriber = subscriber;
+
+	APP_EVENT_SUBMIT(event);
+}
+
+static void hid_report_sent_submit(const void *subscriber, uint8_t report_id, bool error)
+{
+	struct hid_report_sent_event *event = new_hid_report_sent_event();
+
+	event->subscriber = subscriber;
+	event->report_id = report_id;
+	event->error = error;
+
+	APP_EVENT_SUBMIT(event);
+}
+
+static void hid_report_subscriber_submit(const void *subscriber, bool connected)
+{
+	struct hid_report_subscriber_event *event = new_hid_report_subscriber_event();
+
+	event->subscriber = subscriber;
+	event->params.priority = 1;
+	event->params.pipeline_size = 1;
+	event->params.report_max = 1;
+	event->connected = connected;
+
+	APP_EVENT_SUBMIT(event);
+}
+
+static void mouse_report_round(const void *subscriber)
+{
+	motion_submit(INPUT_DELAY_US);
+	hid_report_submit(subscriber, REPORT_ID_MOUSE);
+	k_sleep(K_USEC(SEND_DELAY_US));
+	hid_report_sent_submit(subscriber, REPORT_ID_MOUSE, false);
+}
+
+ZTEST(hid_latency_meas, test_report_with_input)
+{
+	struct latency_stats stats;
+
+	mouse_report_round(subscriber_a);
+
+	stats = stats_fetch(LATENCY_OPT_INPUT);
+	zassert_equal(stats.count, 1, "Unexpected input sample count");
+	zassert_true(stats.max_us >= INPUT_DELAY_US, "Input latency too small");
+
+	stats = stats_fetch(LATENCY_OPT_QUEUE);
+	zassert_equal(stats.count, 1, "Unexpected queue sample count");
+
+	stats = stats_fetch(LATENCY_OPT_SEND);
+	zassert_equal(stats.count, 1, "Unexpected send sample count");
+	zassert_true(stats.max_us >= SEND_DELAY_US, "Send latency too small");
+
+	stats = stats_fetch(LATENCY_OPT_TOTAL);
+	zassert_equal(stats.count, 1, "Unexpected total sample count");
+	zassert_true(stats.max_us >= INPUT_DELAY_US + SEND_DELAY_US, "Total latency too small");
+	/* The only sample is reported as every percentile. */
+	zassert_equal(stats.p50_us, stats.max_us, "Unexpected p50");
+	zassert_equal(stats.p99_us, stats.max_us, "Unexpected p99");
+}
+
+ZTEST(hid_latency_meas, test_report_without_input)
+{
+	/* Reports that are not caused by a new input only contribute to the send stage. */
+	hid_report_submit(subscriber_a, REPORT_ID_MOUSE);
+	hid_report_sent_submit(subscriber_a, REPORT_ID_MOUSE, false);
+
+	zassert_equal(stats_fetch(LATENCY_OPT_SEND).count, 1, "Unexpected send sample count");
+	zassert_equal(stats_fetch(LATENCY_OPT_TOTAL).count, 0, "Unexpected total sample count");
+}
+
+ZTEST(hid_latency_meas, test_ignored_reports)
+{
+	/* Non-mouse reports are not tracked. */
+	motion_submit(INPUT_DELAY_US);
+	hid_report_submit(subscriber_a, REPORT_ID_KEYBOARD_KEYS);
+	hid_report_sent_submit(subscriber_a, REPORT_ID_KEYBOARD_KEYS, false);
+
+	/* Reports that failed to be sent are not a part of the statistics. */
+	hid_report_submit(subscriber_a, REPORT_ID_MOUSE);
+	hid_report_sent_submit(subscriber_a, REPORT_ID_MOUSE, true);
+
+	/* Confirmation of a report that was never submitted is ignored. */
+	hid_report_sent_submit(subscriber_b, REPORT_ID_MOUSE, false);
+
+	zassert_equal(stats_fetch(LATENCY_OPT_SEND).count, 0, "Unexpected send sample count");
+	zassert_equal(stats_fetch(LATENCY_OPT_TOTAL).count, 0, "Unexpected total sample count");
+}
+
+ZTEST(hid_latency_meas, test_subscribers)
+{
+	mouse_report_round(subscriber_a);
+	mouse_report_round(subscriber_b);
+
+	/* Reports in flight are dropped on disconnection. */
+	hid_report_submit(subscriber_b, REPORT_ID_MOUSE);
+	hid_report_subscriber_submit(subscriber_b, false);
+	hid_report_sent_submit(subscriber_b, REPORT_ID_MOUSE, false);
+
+	zassert_equal(stats_fetch(LATENCY_OPT_SEND).count, 2, "Unexpected send sample count");
+	zassert_equal(stats_fetch(LATENCY_OPT_TOTAL).count, 2, "Unexpected total sample count");
+}
+
+static void *hid_latency_meas_setup(void)
+{
+	zassert_ok(app_event_manager_init(), "Error when initializing");
+	module_set_state(MODULE_STATE_READY);
+
+	zassert_ok(k_sem_take(&module_ready_sem, EVENT_TIMEOUT), "Module is not ready");
+
+	return NULL;
+}
+
+static void hid_latency_meas_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	config_request_submit(LATENCY_OPT_RESET, CONFIG_STATUS_SET);
+	zassert_equal(stats_fetch(LATENCY_OPT_SEND).count, 0, "Statistics not reset");
+}
+
+ZTEST_SUITE(hid_latency_meas, NULL, hid_latency_meas_setup, hid_latency_meas_before, NULL, NULL);
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_config_event(aeh)) {
+		const struct config_event *event = cast_config_event(aeh);
+
+		if (!event->is_request) {
+			zassert_equal(event->status, CONFIG_STATUS_SUCCESS, "Request failed");
+			zassert_true(event->dyndata.size <= sizeof(config_rsp_data),
+				     "Response too long");
+
+			memcpy(config_rsp_data, event->dyndata.data, event->dyndata.size);
+			config_rsp_size = event->dyndata.size;
+			k_sem_give(&config_rsp_sem);
+		}
+
+		return false;
+	}
+
+	if (is_module_state_event(aeh)) {
+		const struct module_state_event *event = cast_module_state_event(aeh);
+
+		if (check_state(event, MODULE_ID(hid_latency_meas), MODULE_STATE_READY)) {
+			k_sem_give(&module_ready_sem);
+		}
+
+		return false;
+	}
+
+	/* Event not handled but subscribed. */
+	__ASSERT_NO_MSG(false);
+
+	return false;
+}
+
+APP_EVENT_LISTENER(test_main, app_event_handler);
+APP_EVENT_SUBSCRIBE(test_main, config_event);
+APP_EVENT_SUBSCRIBE(test_main, module_state_event);
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <caf/key_id.h>
+
+#include "hid_keymap.h"
+
+/* This structure enforces the header file is included only once in the build.
+ * Violating this requirement triggers a multiple definition error at link time.
+ */
+const struct {} hid_keymap_def_include_once;
+
+static const struct hid_keymap hid_keymap[] = {
+	{ KEY_ID(0x00, 0x00), 0x04, REPORT_ID_KEYBOARD_KEYS }, /* A */
+	{ KEY_ID(0x00, 0x01), 0x05, REPORT_ID_KEYBOARD_KEYS }, /* B */
+	{ KEY_ID(0x00, 0x02), 0x06, REPORT_ID_KEYBOARD_KEYS }, /* C */
+	{ KEY_ID(0x00, 0x03), 0xE1, REPORT_ID_KEYBOARD_KEYS }, /* Left Shift */
+};
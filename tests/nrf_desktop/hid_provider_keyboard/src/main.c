@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <app_event_manager.h>
+#include <caf/key_id.h>
+#include <caf/events/button_event.h>
+
+#include "hid_event.h"
+#include "hid_report_provider_event.h"
+
+#define MODULE main
+#include <caf/events/module_state_event.h>
+
+#define KEY_A		KEY_ID(0x00, 0x00)
+#define KEY_B		KEY_ID(0x00, 0x01)
+#define KEY_C		KEY_ID(0x00, 0x02)
+#define KEY_SHIFT	KEY_ID(0x00, 0x03)
+/* Key without mapping in the HID keymap, ignored by the provider. */
+#define KEY_UNMAPPED	KEY_ID(0x01, 0x00)
+
+#define USAGE_A		0x04
+#define USAGE_B		0x05
+#define USAGE_C		0x06
+#define MODIFIER_SHIFT	BIT(0xE1 - KEYBOARD_REPORT_FIRST_MODIFIER)
+
+#define REPORT_CNT_MAX	8
+#define EVENT_TIMEOUT	K_SECONDS(1)
+
+struct keyboard_report {
+	uint8_t modifier_bm;
+	uint8_t keys[KEYBOARD_REPORT_KEY_COUNT_MAX];
+};
+
+struct keypress {
+	uint16_t key_id;
+	bool pressed;
+};
+
+static const void *const subscriber = (const void *)0x1000;
+
+static const struct hid_report_provider_api *provider_api;
+static atomic_t trigger_cnt;
+
+static K_SEM_DEFINE(provider_sem, 0, 1);
+static K_SEM_DEFINE(button_sem, 0, 1);
+static K_SEM_DEFINE(report_sem, 0, REPORT_CNT_MAX);
+static struct keyboard_report reports[REPORT_CNT_MAX];
+static size_t report_cnt;
+
+static int trigger_report_send(uint8_t report_id)
+{
+	zassert_equal(report_id, REPORT_ID_KEYBOARD_KEYS, "Unexpected report ID");
+	atomic_inc(&trigger_cnt);
+
+	return 0;
+}
+
+static void button_submit(uint16_t key_id, bool pressed)
+{
+	struct button_event *event = new_button_event();
+
+	event->key_id = key_id;
+	event->pressed = pressed;
+
+	APP_EVENT_SUBMIT(event);
+
+	/* The test module is the final subscriber, so the provider already handled the event. */
+	zassert_ok(k_sem_take(&button_sem, EVENT_TIMEOUT), "Button event not processed");
+}
+
+static void keypresses_submit(const struct keypress *keypresses, size_t cnt)
+{
+	for (size_t i = 0; i < cnt; i++) {
+		button_submit(keypresses[i].key_id, keypresses[i].pressed);
+	}
+}
+
+static void subscriber_connect(bool connected)
+{
+	const struct subscriber_conn_state cs = {
+		.subscriber = connected ? subscriber : NULL,
+		.pipeline_cnt = 0,
+		.pipeline_size = 1,
+	};
+
+	provider_api->connection_state_changed(REPORT_ID_KEYBOARD_KEYS, &cs);
+}
+
+/* Send reports until the provider has no more key state changes, as HID state would. */
+static size_t reports_send_all(void)
+{
+	size_t sent = 0;
+
+	report_cnt = 0;
+
+	while (provider_api->send_report(REPORT_ID_KEYBOARD_KEYS, false)) {
+		zassert_ok(k_sem_take(&report_sem, EVENT_TIMEOUT), "Report not submitted");
+		provider_api->report_sent(REPORT_ID_KEYBOARD_KEYS, false);
+		sent++;
+		zassert_true(sent <= REPORT_CNT_MAX, "Too many reports");
+	}
+
+	zassert_equal(sent, report_cnt, "Unexpected number of reports");
+
+	return sent;
+}
+
+static void reports_verify(const struct keyboard_report *expected, size_t cnt)
+{
+	zassert_equal(reports_send_all(), cnt, "Unexpected number of reports");
+
+	for (size_t i = 0; i < cnt; i++) {
+		zassert_equal(reports[i].modifier_bm, expected[i].modifier_bm,
+			      "Invalid modifiers in report %zu", i);
+		zassert_mem_equal(reports[i].keys, expected[i].keys, sizeof(expected[i].keys),
+				  "Invalid keys in report %zu", i);
+	}
+}
+
+ZTEST(hid_provider_keyboard, test_direct_keypress)
+{
+	static const struct keyboard_report expected[] = {
+		{ .keys = { USAGE_A } },
+		{ .keys = { 0 } },
+	};
+
+	subscriber_connect(true);
+
+	/* Without queued keypresses, the key state is updated instantly. */
+	button_submit(KEY_A, true);
+	zassert_equal(atomic_get(&trigger_cnt), 1, "Report send not triggered");
+	reports_verify(&expected[0], 1);
+
+	button_submit(KEY_A, false);
+	zassert_equal(atomic_get(&trigger_cnt), 2, "Report send not triggered");
+	reports_verify(&expected[1], 1);
+
+	/* Keys without mapping do not affect the report. */
+	button_submit(KEY_UNMAPPED, true);
+	zassert_equal(atomic_get(&trigger_cnt), 2, "Unexpected report send trigger");
+	zassert_equal(reports_send_all(), 0, "Unexpected report");
+}
+
+ZTEST(hid_provider_keyboard, test_queued_keypresses)
+{
+	static const struct keypress keypresses[] = {
+		{ KEY_A, true },
+		{ KEY_B, true },
+		{ KEY_SHIFT, true },
+		{ KEY_A, false },
+		{ KEY_C, true },
+	};
+
+	/* Keys are reported in descending usage ID order. */
+	static const struct keyboard_report expected[] = {
+#if CONFIG_DESKTOP_HID_REPORT_PROVIDER_KEYBOARD_COALESCE
+		/* The release of key A must be sent in a separate report. */
+		{ .modifier_bm = MODIFIER_SHIFT, .keys = { USAGE_B, USAGE_A } },
+		{ .modifier_bm = MODIFIER_SHIFT, .keys = { USAGE_C, USAGE_B } },
+#else
+		{ .keys = { USAGE_A } },
+		{ .keys = { USAGE_B, USAGE_A } },
+		{ .modifier_bm = MODIFIER_SHIFT, .keys = { USAGE_B, USAGE_A } },
+		{ .modifier_bm = MODIFIER_SHIFT, .keys = { USAGE_B } },
+		{ .modifier_bm = MODIFIER_SHIFT, .keys = { USAGE_C, USAGE_B } },
+#endif
+	};
+
+	/* Keypresses are queued until the subscriber connects. */
+	keypresses_submit(keypresses, ARRAY_SIZE(keypresses));
+	subscriber_connect(true);
+
+	reports_verify(expected, ARRAY_SIZE(expected));
+	zassert_equal(atomic_get(&trigger_cnt), 0, "Unexpected report send trigger");
+}
+
+ZTEST(hid_provider_keyboard, test_queued_key_toggles)
+{
+	static const struct keypress keypresses[] = {
+		{ KEY_A, true },
+		{ KEY_A, false },
+		{ KEY_A, true },
+		{ KEY_B, true },
+		{ KEY_A, false },
+	};
+
+	/* Every state change of a key is sent in a separate report, also if coalescing. */
+	static const struct keyboard_report expected[] = {
+		{ .keys = { USAGE_A } },
+		{ .keys = { 0 } },
+#if !CONFIG_DESKTOP_HID_REPORT_PROVIDER_KEYBOARD_COALESCE
+		{ .keys = { USAGE_A } },
+#endif
+		{ .keys = { USAGE_B, USAGE_A } },
+		{ .keys = { USAGE_B } },
+	};
+
+	keypresses_submit(keypresses, ARRAY_SIZE(keypresses));
+	subscriber_connect(true);
+
+	reports_verify(expected, ARRAY_SIZE(expected));
+}
+
+ZTEST(hid_provider_keyboard, test_keypresses_queued_while_connected)
+{
+	static const struct keypress keypresses[] = {
+		{ KEY_B, true },
+		{ KEY_A, false },
+	};
+
+	static const struct keyboard_report expected[] = {
+#if !CONFIG_DESKTOP_HID_REPORT_PROVIDER_KEYBOARD_COALESCE
+		{ .keys = { USAGE_A } },
+#endif
+		{ .keys = { USAGE_B, USAGE_A } },
+		{ .keys = { USAGE_B } },
+	};
+
+	button_submit(KEY_A, true);
+	subscriber_connect(true);
+
+	/* Keypresses go through the queue while it is not empty to preserve the order. */
+	keypresses_submit(keypresses, ARRAY_SIZE(keypresses));
+	zassert_equal(atomic_get(&trigger_cnt), 0, "Unexpected report send trigger");
+
+	reports_verify(expected, ARRAY_SIZE(expected));
+}
+
+static void *hid_provider_keyboard_setup(void)
+{
+	zassert_ok(app_event_manager_init(), "Error when initializing");
+	module_set_state(MODULE_STATE_READY);
+
+	zassert_ok(k_sem_take(&provider_sem, EVENT_TIMEOUT), "Provider not registered");
+	/* Make sure the provider also handled the registration event. */
+	button_submit(KEY_UNMAPPED, true);
+
+	return NULL;
+}
+
+static void hid_provider_keyboard_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	report_cnt = 0;
+	atomic_clear(&trigger_cnt);
+	k_sem_reset(&report_sem);
+}
+
+static void hid_provider_keyboard_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Disconnection clears the keys state and the queued keypresses. */
+	subscriber_connect(false);
+}
+
+ZTEST_SUITE(hid_provider_keyboard, NULL, hid_provider_keyboard_setup,
+	    hid_provider_keyboard_before, hid_provider_keyboard_after, NULL);
+
+static bool handle_hid_report_provider_event(struct hid_report_provider_event *event)
+{
+	static const struct hid_state_api hid_state_api = {
+		.trigger_report_send = trigger_report_send,
+	};
+
+	/* Test module replaces HID state. */
+	zassert_equal(event->report_id, REPORT_ID_KEYBOARD_KEYS, "Unexpected report ID");
+	zassert_is_null(event->hid_state_api, "HID state API already set");
+
+	provider_api = event->provider_api;
+	event->hid_state_api = &hid_state_api;
+	k_sem_give(&provider_sem);
+
+	return false;
+}
+
+static bool handle_hid_report_event(const struct hid_report_event *event)
+{
+	zassert_equal(event->subscriber, subscriber, "Unexpected subscriber");
+	zassert_equal(event->dyndata.size, REPORT_SIZE_KEYBOARD_KEYS + 1, "Invalid report size");
+	zassert_equal(event->dyndata.data[0], REPORT_ID_KEYBOARD_KEYS, "Invalid report ID");
+	zassert_true(report_cnt < ARRAY_SIZE(reports), "Too many reports");
+
+	struct keyboard_report *report = &reports[report_cnt];
+
+	report->modifier_bm = event->dyndata.data[1];
+	memcpy(report->keys, &event->dyndata.data[3], sizeof(report->keys));
+	report_cnt++;
+
+	k_sem_give(&report_sem);
+
+	return false;
+}
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_hid_report_provider_event(aeh)) {
+		return handle_hid_report_provider_event(cast_hid_report_provider_event(aeh));
+	}
+
+	if (is_hid_report_event(aeh)) {
+		return handle_hid_report_event(cast_hid_report_event(aeh));
+	}
+
+	if (is_button_event(aeh)) {
+		k_sem_give(&button_sem);
+		return false;
+	}
+
+	/* Event not handled but subscribed. */
+	__ASSERT_NO_MSG(false);
+
+	return false;
+}
+
+APP_EVENT_LISTENER(test_main, app_event_handler);
+APP_EVENT_SUBSCRIBE_EARLY(test_main, hid_report_provider_event);
+APP_EVENT_SUBSCRIBE(test_main, hid_report_event);
+APP_EVENT_SUBSCRIBE_FINAL(test_main, button_event);
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+
+#include "bridge/ble_discovery_cache.h"
+
+using Nrf::BLEDiscoveryCacheRecord;
+
+static const bt_addr_le_t kAddr = { .type = BT_ADDR_LE_RANDOM, .a = { { 0x01, 0x02, 0x03, 0x04, 0x05, 0xc6 } } };
+static const uint16_t kHandles[] = { 0x0010, 0x0012, 0x0013 };
+
+static BLEDiscoveryCacheRecord MakeRecord()
+{
+	BLEDiscoveryCacheRecord record;
+
+	record.mAddr = kAddr;
+
+	for (size_t i = 0; i < sizeof(record.mDbHash); i++) {
+		record.mDbHash[i] = i;
+	}
+
+	memcpy(record.mData, kHandles, sizeof(kHandles));
+	record.mDataSize = sizeof(kHandles);
+
+	return record;
+}
+
+ZTEST(ble_discovery_cache, test_encode_decode)
+{
+	const BLEDiscoveryCacheRecord record = MakeRecord();
+	BLEDiscoveryCacheRecord decoded;
+	uint8_t buffer[BLEDiscoveryCacheRecord::kMaxSize];
+
+	const size_t size = record.Encode(buffer, sizeof(buffer));
+
+	zassert_equal(size, BLEDiscoveryCacheRecord::kHeaderSize + sizeof(kHandles), "Unexpected record size");
+	zassert_true(decoded.Decode(buffer, size), "Expected decode to be successful");
+	zassert_true(bt_addr_le_eq(&decoded.mAddr, &kAddr), "Expected address to match");
+	zassert_mem_equal(decoded.mDbHash, record.mDbHash, sizeof(record.mDbHash), "Expected hash to match");
+	zassert_equal(decoded.mDataSize, sizeof(kHandles), "Expected data size to match");
+	zassert_mem_equal(decoded.mData, kHandles, sizeof(kHandles), "Expected data to match");
+}
+
+ZTEST(ble_discovery_cache, test_encode_too_small_buffer)
+{
+	BLEDiscoveryCacheRecord record = MakeRecord();
+	uint8_t buffer[BLEDiscoveryCacheRecord::kMaxSize];
+
+	zassert_equal(record.Encode(buffer, BLEDiscoveryCacheRecord::kHeaderSize + sizeof(kHandles) - 1), 0,
+		      "Expected encode to a too small buffer to fail");
+
+	record.mDataSize = BLEDiscoveryCacheRecord::kMaxDataSize + 1;
+	zassert_equal(record.Encode(buffer, sizeof(buffer)), 0, "Expected encode of too much data to fail");
+}
+
+ZTEST(ble_discovery_cache, test_decode_invalid)
+{
+	const BLEDiscoveryCacheRecord record = MakeRecord();
+	BLEDiscoveryCacheRecord decoded;
+	uint8_t buffer[BLEDiscoveryCacheRecord::kMaxSize + 1];
+	const size_t size = record.Encode(buffer, sizeof(buffer));
+
+	zassert_false(decoded.Decode(buffer, BLEDiscoveryCacheRecord::kHeaderSize - 1), "Expected truncated header");
+	zassert_false(decoded.Decode(buffer, size - 1), "Expected truncated data");
+	zassert_false(decoded.Decode(buffer, size + 1), "Expected trailing data");
+
+	buffer[BLEDiscoveryCacheRecord::kHeaderSize - 1] = BLEDiscoveryCacheRecord::kMaxDataSize + 1;
+	zassert_false(decoded.Decode(buffer, sizeof(buffer)), "Expected too much data");
+	zassert_equal(decoded.mDataSize, 0, "Expected record not to be modified");
+}
+
+ZTEST(ble_discovery_cache, test_matches)
+{
+	const BLEDiscoveryCacheRecord record = MakeRecord();
+	uint8_t hash[BLEDiscoveryCacheRecord::kDbHashSize];
+	bt_addr_le_t addr = kAddr;
+
+	memcpy(hash, record.mDbHash, sizeof(hash));
+	zassert_true(record.Matches(addr, hash, sizeof(hash)), "Expected record to match");
+
+	/* The GATT database hash has not been read. */
+	zassert_false(record.Matches(addr, hash, 0), "Expected missing hash not to match");
+
+	/* The GATT database of the device has changed. */
+	hash[sizeof(hash) - 1] ^= 0xff;
+	zassert_false(record.Matches(addr, hash, sizeof(hash)), "Expected changed hash not to match");
+	hash[sizeof(hash) - 1] ^= 0xff;
+
+	addr.type = BT_ADDR_LE_PUBLIC;
+	zassert_false(record.Matches(addr, hash, sizeof(hash)), "Expected other address type not to match");
+
+	addr = kAddr;
+	addr.a.val[0] ^= 0xff;
+	zassert_false(record.Matches(addr, hash, sizeof(hash)), "Expected other address not to match");
+}
+
+ZTEST(ble_discovery_cache, test_key)
+{
+	char key[BLEDiscoveryCacheRecord::kKeyLength + 1] = { 0 };
+	bt_addr_le_t addr = kAddr;
+
+	BLEDiscoveryCacheRecord::MakeKey(addr, key);
+	zassert_str_equal(key, "c60504030201", "Unexpected key");
+
+	/* The address type is verified when loading the record. */
+	addr.type = BT_ADDR_LE_PUBLIC;
+	BLEDiscoveryCacheRecord::MakeKey(addr, key);
+	zassert_str_equal(key, "c60504030201", "Unexpected key");
+}
+
+ZTEST_SUITE(ble_discovery_cache, NULL, NULL, NULL, NULL, NULL);
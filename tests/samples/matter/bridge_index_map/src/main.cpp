@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+
+#include "util/index_map.h"
+
+#define MAX_DEVICES	  16
+/* Number of slots in the map, keys differing by a multiple of it collide. */
+#define SLOTS_CNT	  (2 * MAX_DEVICES)
+#define FIRST_ENDPOINT	  3
+#define RANDOM_OPS_CNT	  10000
+#define RANDOM_ENDPOINTS  (4 * SLOTS_CNT)
+
+using EndpointIndexMap = Nrf::IndexMap<uint16_t, MAX_DEVICES>;
+
+ZTEST(bridge_index_map, test_consecutive_endpoints)
+{
+	EndpointIndexMap map;
+
+	for (uint16_t i = 0; i < MAX_DEVICES; i++) {
+		zassert_true(map.Insert(FIRST_ENDPOINT + i, i), "Expected insert to be successful");
+	}
+
+	zassert_equal(map.Size(), MAX_DEVICES, "Expected the map to be full");
+	zassert_false(map.Insert(FIRST_ENDPOINT + MAX_DEVICES, 0), "Expected insert to the full map to fail");
+
+	for (uint16_t i = 0; i < MAX_DEVICES; i++) {
+		zassert_equal(map.Find(FIRST_ENDPOINT + i), i, "Expected index to match");
+	}
+
+	zassert_equal(map.Find(FIRST_ENDPOINT - 1), EndpointIndexMap::kInvalidIndex, "Expected no index");
+	zassert_equal(map.Find(FIRST_ENDPOINT + MAX_DEVICES), EndpointIndexMap::kInvalidIndex,
+		      "Expected no index");
+}
+
+ZTEST(bridge_index_map, test_invalid_and_duplicated_keys)
+{
+	EndpointIndexMap map;
+
+	zassert_false(map.Insert(EndpointIndexMap::kInvalidKey, 0), "Expected invalid key insert to fail");
+	zassert_equal(map.Find(EndpointIndexMap::kInvalidKey), EndpointIndexMap::kInvalidIndex,
+		      "Expected no index");
+	zassert_false(map.Erase(EndpointIndexMap::kInvalidKey), "Expected invalid key erase to fail");
+
+	zassert_true(map.Insert(FIRST_ENDPOINT, 1), "Expected insert to be successful");
+	zassert_false(map.Insert(FIRST_ENDPOINT, 2), "Expected duplicated key insert to fail");
+	zassert_equal(map.Find(FIRST_ENDPOINT), 1, "Expected index to match");
+	zassert_equal(map.Size(), 1, "Expected one key");
+
+	zassert_true(map.Erase(FIRST_ENDPOINT), "Expected erase to be successful");
+	zassert_false(map.Erase(FIRST_ENDPOINT), "Expected second erase to fail");
+	zassert_equal(map.Size(), 0, "Expected no keys");
+}
+
+ZTEST(bridge_index_map, test_erase_colliding_keys)
+{
+	EndpointIndexMap map;
+
+	/* The keys are mapped to the same slot and the last one is stored in the slot of the next key. */
+	zassert_true(map.Insert(FIRST_ENDPOINT, 0), "Expected insert to be successful");
+	zassert_true(map.Insert(FIRST_ENDPOINT + SLOTS_CNT, 1), "Expected insert to be successful");
+	zassert_true(map.Insert(FIRST_ENDPOINT + 2 * SLOTS_CNT, 2), "Expected insert to be successful");
+	zassert_true(map.Insert(FIRST_ENDPOINT + 1, 3), "Expected insert to be successful");
+
+	/* The following keys of the probe sequence must still be found after erasing the first one. */
+	zassert_true(map.Erase(FIRST_ENDPOINT), "Expected erase to be successful");
+	zassert_equal(map.Find(FIRST_ENDPOINT), EndpointIndexMap::kInvalidIndex, "Expected no index");
+	zassert_equal(map.Find(FIRST_ENDPOINT + SLOTS_CNT), 1, "Expected index to match");
+	zassert_equal(map.Find(FIRST_ENDPOINT + 2 * SLOTS_CNT), 2, "Expected index to match");
+	zassert_equal(map.Find(FIRST_ENDPOINT + 1), 3, "Expected index to match");
+
+	zassert_true(map.Erase(FIRST_ENDPOINT + 2 * SLOTS_CNT), "Expected erase to be successful");
+	zassert_equal(map.Find(FIRST_ENDPOINT + SLOTS_CNT), 1, "Expected index to match");
+	zassert_equal(map.Find(FIRST_ENDPOINT + 1), 3, "Expected index to match");
+	zassert_equal(map.Size(), 2, "Expected two keys");
+}
+
+ZTEST(bridge_index_map, test_random_operations)
+{
+	EndpointIndexMap map;
+	/* Reference mapping, searched linearly like the bridge manager did before using the map. */
+	uint16_t indexes[RANDOM_ENDPOINTS];
+	uint16_t count = 0;
+	uint32_t state = 0x12345678;
+
+	for (auto &index : indexes) {
+		index = EndpointIndexMap::kInvalidIndex;
+	}
+
+	for (uint32_t op = 0; op < RANDOM_OPS_CNT; op++) {
+		/* Xorshift sequence */
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+
+		const uint16_t endpoint = state % RANDOM_ENDPOINTS;
+		const bool present = indexes[endpoint] != EndpointIndexMap::kInvalidIndex;
+
+		if (present) {
+			zassert_true(map.Erase(endpoint), "Expected erase to be successful");
+			indexes[endpoint] = EndpointIndexMap::kInvalidIndex;
+			count--;
+		} else if (count < MAX_DEVICES) {
+			zassert_true(map.Insert(endpoint, op % MAX_DEVICES), "Expected insert to be successful");
+			indexes[endpoint] = op % MAX_DEVICES;
+			count++;
+		} else {
+			zassert_false(map.Insert(endpoint, 0), "Expected insert to the full map to fail");
+		}
+
+		zassert_equal(map.Size(), count, "Expected size to match");
+
+		for (uint16_t i = 0; i < RANDOM_ENDPOINTS; i++) {
+			zassert_equal(map.Find(i), indexes[i], "Expected index of endpoint %u to match", i);
+		}
+	}
+}
+
+ZTEST_SUITE(bridge_index_map, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <data_fifo.h>
+#include "audio_module/audio_module.h"
+
+#define BENCH_FRAMES_NUM      (1000)
+#define BENCH_FRAME_SIZE      (480)
+#define BENCH_STACK_SIZE      (4096)
+#define BENCH_PRIORITY	      (4)
+#define BENCH_FIFO_NUM	      (4)
+#define BENCH_DATA_BUFFER_NUM (4)
+#define BENCH_MSG_SIZE	      (WB_UP(sizeof(struct audio_module_message)))
+
+/* The resampler and the monitor are both fed from the decoder, the resampler output is returned
+ * to the test on its TX FIFO:
+ *
+ * test -> decoder -+-> resampler -> test
+ *                  +-> monitor
+ */
+#define BENCH_MODULES_NUM (3)
+
+#if defined(CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER)
+#define BENCH_MODE_NAME		 "chain"
+#define BENCH_THREAD_HOPS_EXPECT (1)
+#else
+#define BENCH_MODE_NAME		 "threaded"
+#define BENCH_THREAD_HOPS_EXPECT (BENCH_MODULES_NUM)
+#endif
+
+struct bench_config {
+	uint8_t offset;
+};
+
+struct bench_context {
+	struct bench_config config;
+	uint32_t frames;
+
+	/* Hold the processing of each frame, so the module can be stopped mid-stream. */
+	bool stall;
+
+	/* Set while the module is processing a frame. */
+	atomic_t busy;
+};
+
+K_THREAD_STACK_DEFINE(decoder_stack, BENCH_STACK_SIZE);
+K_THREAD_STACK_DEFINE(resampler_stack, BENCH_STACK_SIZE);
+K_THREAD_STACK_DEFINE(monitor_stack, BENCH_STACK_SIZE);
+
+DATA_FIFO_DEFINE(decoder_fifo_rx, BENCH_FIFO_NUM, BENCH_MSG_SIZE);
+DATA_FIFO_DEFINE(resampler_fifo_rx, BENCH_FIFO_NUM, BENCH_MSG_SIZE);
+DATA_FIFO_DEFINE(resampler_fifo_tx, BENCH_FIFO_NUM, BENCH_MSG_SIZE);
+DATA_FIFO_DEFINE(monitor_fifo_rx, BENCH_FIFO_NUM, BENCH_MSG_SIZE);
+
+K_MEM_SLAB_DEFINE(decoder_slab, BENCH_FRAME_SIZE, BENCH_DATA_BUFFER_NUM, 4);
+K_MEM_SLAB_DEFINE(resampler_slab, BENCH_FRAME_SIZE, BENCH_DATA_BUFFER_NUM, 4);
+
+static struct audio_module_handle decoder, resampler, monitor;
+static struct bench_context decoder_ctx, resampler_ctx, monitor_ctx;
+
+static uint8_t frame_in[BENCH_FRAME_SIZE];
+static uint8_t frame_out[BENCH_FRAME_SIZE];
+
+/* Number of times a frame moved to another thread on its way through the modules. */
+static atomic_t thread_hops;
+static k_tid_t last_thread;
+
+/* Given when a stalled module starts processing a frame. */
+static K_SEM_DEFINE(stall_sem, 0, 1);
+
+static int bench_config_set(struct audio_module_handle_private *handle,
+			    struct audio_module_configuration const *const configuration)
+{
+	struct audio_module_handle *hdl = (struct audio_module_handle *)handle;
+	struct bench_context *ctx = (struct bench_context *)hdl->context;
+
+	memcpy(&ctx->config, configuration, sizeof(struct bench_config));
+
+	return 0;
+}
+
+static int bench_config_get(struct audio_module_handle_private const *const handle,
+			    struct audio_module_configuration *configuration)
+{
+	struct audio_module_handle *hdl = (struct audio_module_handle *)handle;
+	struct bench_context *ctx = (struct bench_context *)hdl->context;
+
+	memcpy(configuration, &ctx->config, sizeof(struct bench_config));
+
+	return 0;
+}
+
+static int bench_data_process(struct audio_module_handle_private *handle,
+			      struct audio_data const *const audio_data_rx,
+			      struct audio_data *audio_data_tx)
+{
+	struct audio_module_handle *hdl = (struct audio_module_handle *)handle;
+	struct bench_context *ctx = (struct bench_context *)hdl->context;
+	k_tid_t current = k_current_get();
+	const uint8_t *in = audio_data_rx->data;
+	uint8_t *out;
+
+	if (current != last_thread) {
+		atomic_inc(&thread_hops);
+		last_thread = current;
+	}
+
+	ctx->frames++;
+
+	if (ctx->stall) {
+		atomic_set(&ctx->busy, 1);
+		k_sem_give(&stall_sem);
+		k_sleep(K_MSEC(10));
+		atomic_set(&ctx->busy, 0);
+	}
+
+	if (audio_data_tx == NULL) {
+		return 0;
+	}
+
+	out = audio_data_tx->data;
+
+	for (size_t i = 0; i < audio_data_rx->data_size; i++) {
+		out[i] = in[i] + ctx->config.offset;
+	}
+
+	audio_data_tx->data_size = audio_data_rx->data_size;
+	audio_data_tx->meta = audio_data_rx->meta;
+
+	return 0;
+}
+
+static const struct audio_module_functions bench_functions = {
+	.configuration_set = bench_config_set,
+	.configuration_get = bench_config_get,
+	.data_process = bench_data_process};
+
+static struct audio_module_description in_out_description = {
+	.name = "Bench in/out", .type = AUDIO_MODULE_TYPE_IN_OUT, .functions = &bench_functions};
+static struct audio_module_description output_description = {
+	.name = "Bench output", .type = AUDIO_MODULE_TYPE_OUTPUT, .functions = &bench_functions};
+
+static void bench_module_open(struct audio_module_handle *handle, const char *name,
+			      struct audio_module_description *description,
+			      k_thread_stack_t *stack, struct data_fifo *fifo_rx,
+			      struct data_fifo *fifo_tx, struct k_mem_slab *slab,
+			      struct bench_context *ctx, uint8_t offset)
+{
+	int ret;
+	struct audio_module_parameters parameters = {0};
+	struct bench_config config = {.offset = offset};
+
+	AUDIO_MODULE_PARAMETERS(parameters, description, stack, BENCH_STACK_SIZE, BENCH_PRIORITY,
+				fifo_rx, fifo_tx, slab, BENCH_FRAME_SIZE);
+
+	ret = audio_module_open(&parameters, (struct audio_module_configuration *)&config, name,
+				(struct audio_module_context *)ctx, handle);
+	zassert_equal(ret, 0, "Open module %s failed, ret %d", name, ret);
+}
+
+static uint64_t threads_cycles_get(void)
+{
+	k_tid_t threads[] = {decoder.thread_id, resampler.thread_id, monitor.thread_id,
+			     k_current_get()};
+	k_thread_runtime_stats_t stats;
+	uint64_t cycles = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(threads); i++) {
+		/* Chained modules run in the thread of their source and have no thread. */
+		if (threads[i] == NULL) {
+			continue;
+		}
+
+		zassert_equal(k_thread_runtime_stats_get(threads[i], &stats), 0,
+			      "Failed to get thread runtime stats");
+		cycles += stats.execution_cycles;
+	}
+
+	return cycles;
+}
+
+ZTEST(suite_audio_module_benchmark, test_frame_latency_and_cpu)
+{
+	int ret;
+	uint64_t start;
+	uint64_t latency_cycles = 0;
+	uint64_t cpu_cycles;
+	struct audio_data audio_in = {.data = frame_in, .data_size = sizeof(frame_in)};
+	struct audio_data audio_out;
+
+	for (size_t i = 0; i < sizeof(frame_in); i++) {
+		frame_in[i] = i;
+	}
+
+	bench_module_open(&decoder, "Decoder", &in_out_description, decoder_stack,
+			  &decoder_fifo_rx, NULL, &decoder_slab, &decoder_ctx, 1);
+	bench_module_open(&resampler, "Resampler", &in_out_description, resampler_stack,
+			  &resampler_fifo_rx, &resampler_fifo_tx, &resampler_slab, &resampler_ctx,
+			  2);
+	bench_module_open(&monitor, "Monitor", &output_description, monitor_stack,
+			  &monitor_fifo_rx, NULL, NULL, &monitor_ctx, 0);
+
+	zassert_equal(audio_module_connect(&decoder, &resampler, false), 0, NULL);
+	zassert_equal(audio_module_connect(&decoder, &monitor, false), 0, NULL);
+	zassert_equal(audio_module_connect(&resampler, NULL, true), 0, NULL);
+
+	zassert_equal(audio_module_start(&monitor), 0, NULL);
+	zassert_equal(audio_module_start(&resampler), 0, NULL);
+	zassert_equal(audio_module_start(&decoder), 0, NULL);
+
+#if defined(CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER)
+	/* Only the head of the chain has a thread, and a chained module takes a single source. */
+	zassert_not_null(decoder.thread_id, NULL);
+	zassert_is_null(resampler.thread_id, NULL);
+	zassert_is_null(monitor.thread_id, NULL);
+	zassert_equal(audio_module_connect(&resampler, &monitor, false), -ECANCELED, NULL);
+#endif /* CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER */
+
+	cpu_cycles = threads_cycles_get();
+
+	for (int frame = 0; frame < BENCH_FRAMES_NUM; frame++) {
+		audio_out.data = frame_out;
+		audio_out.data_size = sizeof(frame_out);
+		last_thread = NULL;
+
+		start = k_cycle_get_64();
+
+		ret = audio_module_data_tx(&decoder, &audio_in, NULL);
+		zassert_equal(ret, 0, "Frame %d not sent, ret %d", frame, ret);
+
+		ret = audio_module_data_rx(&resampler, &audio_out, K_FOREVER);
+		zassert_equal(ret, 0, "Frame %d not received, ret %d", frame, ret);
+
+		latency_cycles += k_cycle_get_64() - start;
+
+		/* Let the monitor finish with the frame before the next one is sent. */
+		k_sleep(K_MSEC(1));
+
+		zassert_equal(audio_out.data_size, sizeof(frame_out), NULL);
+		zassert_equal(frame_out[0], (uint8_t)(frame_in[0] + 3), "Frame %d data is wrong", frame);
+		zassert_equal(frame_out[BENCH_FRAME_SIZE - 1],
+			      (uint8_t)(frame_in[BENCH_FRAME_SIZE - 1] + 3),
+			      "Frame %d data is wrong", frame);
+	}
+
+	cpu_cycles = threads_cycles_get() - cpu_cycles;
+
+	TC_PRINT("%s: latency %llu ns/frame, cpu %llu ns/frame, thread hops %ld/frame\n",
+		 BENCH_MODE_NAME, k_cyc_to_ns_floor64(latency_cycles) / BENCH_FRAMES_NUM,
+		 k_cyc_to_ns_floor64(cpu_cycles) / BENCH_FRAMES_NUM,
+		 atomic_get(&thread_hops) / BENCH_FRAMES_NUM);
+
+	zassert_equal(decoder_ctx.frames, BENCH_FRAMES_NUM, NULL);
+	zassert_equal(resampler_ctx.frames, BENCH_FRAMES_NUM, NULL);
+	zassert_equal(monitor_ctx.frames, BENCH_FRAMES_NUM, NULL);
+	zassert_equal(atomic_get(&thread_hops), BENCH_THREAD_HOPS_EXPECT * BENCH_FRAMES_NUM,
+		      "Unexpected number of thread hops");
+
+	/* All the audio data must have been released by the receiving modules. */
+	zassert_equal(k_mem_slab_num_used_get(&decoder_slab), 0, "Decoder buffers leaked");
+	zassert_equal(k_mem_slab_num_used_get(&resampler_slab), 0, "Resampler buffers leaked");
+
+	zassert_equal(audio_module_stop(&decoder), 0, NULL);
+	zassert_equal(audio_module_stop(&resampler), 0, NULL);
+	zassert_equal(audio_module_stop(&monitor), 0, NULL);
+	zassert_equal(audio_module_close(&decoder), 0, NULL);
+	zassert_equal(audio_module_close(&resampler), 0, NULL);
+	zassert_equal(audio_module_close(&monitor), 0, NULL);
+}
+
+#if defined(CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER)
+ZTEST(suite_audio_module_benchmark, test_stop_chained_module_mid_stream)
+{
+	int ret;
+	struct audio_data audio_in = {.data = frame_in, .data_size = sizeof(frame_in)};
+	struct audio_data audio_out = {.data = frame_out, .data_size = sizeof(frame_out)};
+
+	memset(&decoder_ctx, 0, sizeof(decoder_ctx));
+	memset(&resampler_ctx, 0, sizeof(resampler_ctx));
+	memset(&monitor_ctx, 0, sizeof(monitor_ctx));
+	k_sem_reset(&stall_sem);
+
+	bench_module_open(&decoder, "Decoder", &in_out_description, decoder_stack,
+			  &decoder_fifo_rx, NULL, &decoder_slab, &decoder_ctx, 1);
+	bench_module_open(&resampler, "Resampler", &in_out_description, resampler_stack,
+			  &resampler_fifo_rx, &resampler_fifo_tx, &resampler_slab, &resampler_ctx,
+			  2);
+	bench_module_open(&monitor, "Monitor", &output_description, monitor_stack,
+			  &monitor_fifo_rx, NULL, NULL, &monitor_ctx, 0);
+
+	zassert_equal(audio_module_connect(&decoder, &resampler, false), 0, NULL);
+	zassert_equal(audio_module_connect(&decoder, &monitor, false), 0, NULL);
+	zassert_equal(audio_module_connect(&resampler, NULL, true), 0, NULL);
+
+	zassert_equal(audio_module_start(&monitor), 0, NULL);
+	zassert_equal(audio_module_start(&resampler), 0, NULL);
+	zassert_equal(audio_module_start(&decoder), 0, NULL);
+
+	resampler_ctx.stall = true;
+
+	ret = audio_module_data_tx(&decoder, &audio_in, NULL);
+	zassert_equal(ret, 0, "Frame not sent, ret %d", ret);
+
+	/* Stop the resampler while the decoder thread runs it. */
+	zassert_equal(k_sem_take(&stall_sem, K_SECONDS(1)), 0, "Resampler not run");
+	zassert_true(atomic_get(&resampler_ctx.busy), NULL);
+	zassert_equal(audio_module_stop(&resampler), 0, NULL);
+	zassert_false(atomic_get(&resampler_ctx.busy), "Stop returned while processing a frame");
+
+	/* The next frame is only taken by the monitor. */
+	ret = audio_module_data_tx(&decoder, &audio_in, NULL);
+	zassert_equal(ret, 0, "Frame not sent, ret %d", ret);
+	k_sleep(K_MSEC(1));
+
+	zassert_equal(decoder_ctx.frames, 2, NULL);
+	zassert_equal(resampler_ctx.frames, 1, NULL);
+	zassert_equal(monitor_ctx.frames, 2, NULL);
+
+	/* The frame processed before the stop is still on the resampler's TX FIFO. */
+	zassert_equal(audio_module_start(&resampler), 0, NULL);
+	zassert_equal(audio_module_data_rx(&resampler, &audio_out, K_NO_WAIT), 0, NULL);
+	zassert_equal(frame_out[0], (uint8_t)(frame_in[0] + 3), "Frame data is wrong");
+	zassert_not_equal(audio_module_data_rx(&resampler, &audio_out, K_NO_WAIT), 0,
+			  "Unexpected frame from the stopped resampler");
+
+	zassert_equal(audio_module_stop(&decoder), 0, NULL);
+	zassert_equal(audio_module_stop(&resampler), 0, NULL);
+	zassert_equal(audio_module_stop(&monitor), 0, NULL);
+
+	zassert_equal(k_mem_slab_num_used_get(&decoder_slab), 0, "Decoder buffers leaked");
+	zassert_equal(k_mem_slab_num_used_get(&resampler_slab), 0, "Resampler buffers leaked");
+
+	zassert_equal(audio_module_close(&decoder), 0, NULL);
+	zassert_equal(audio_module_close(&resampler), 0, NULL);
+	zassert_equal(audio_module_close(&monitor), 0, NULL);
+}
+#endif /* CONFIG_AUDIO_MODULE_CHAIN_SCHEDULER */
+
+ZTEST_SUITE(suite_audio_module_benchmark, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,409 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/conn.h>
+#include <bluetooth/services/ras.h>
+#include <bluetooth/cs_de.h>
+#include <bluetooth/cs_de_pipeline.h>
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(int, bt_ras_rreq_cp_get_ranging_data, struct bt_conn *, struct net_buf_simple *,
+		uint16_t, bt_ras_rreq_ranging_data_received_t);
+FAKE_VALUE_FUNC(int, bt_ras_rreq_on_demand_rd_subscribe, struct bt_conn *);
+FAKE_VALUE_FUNC(int, bt_ras_rreq_on_demand_rd_unsubscribe, struct bt_conn *);
+FAKE_VALUE_FUNC(int, bt_ras_rreq_rd_ready_subscribe, struct bt_conn *,
+		bt_ras_rreq_rd_ready_cb_t);
+FAKE_VALUE_FUNC(int, bt_ras_rreq_rd_ready_unsubscribe, struct bt_conn *);
+FAKE_VALUE_FUNC(int, bt_ras_rreq_realtime_rd_subscribe, struct bt_conn *,
+		struct net_buf_simple *, bt_ras_rreq_ranging_data_received_t);
+FAKE_VALUE_FUNC(int, bt_ras_rreq_realtime_rd_unsubscribe, struct bt_conn *);
+FAKE_VALUE_FUNC(int, bt_ras_rreq_realtime_rd_buf_set, struct bt_conn *, struct net_buf_simple *);
+FAKE_VOID_FUNC(cs_de_populate_report, struct net_buf_simple *, struct net_buf_simple *,
+	       enum bt_conn_le_cs_role, cs_de_report_t *);
+FAKE_VALUE_FUNC(cs_de_quality_t, cs_de_calc, cs_de_report_t *);
+
+#define PEER_CNT	CONFIG_BT_CS_DE_PIPELINE_MAX_PEERS
+#define RESULT_TIMEOUT	K_MSEC(100)
+
+/* Connection objects are only used as peer identifiers by the pipeline. */
+static uint8_t conn_mem[PEER_CNT];
+#define CONN_A		((struct bt_conn *)&conn_mem[0])
+#define CONN_B		((struct bt_conn *)&conn_mem[1])
+
+/* Ranging Requestor state of a peer. */
+struct fake_peer {
+	struct bt_conn *conn;
+	bt_ras_rreq_rd_ready_cb_t rd_ready_cb;
+	bt_ras_rreq_ranging_data_received_t rd_cb;
+	struct net_buf_simple *rx_buf;
+};
+
+struct result {
+	struct bt_conn *conn;
+	uint16_t ranging_counter;
+	float distance;
+	cs_de_quality_t quality;
+};
+
+static struct fake_peer fake_peers[PEER_CNT];
+static enum bt_conn_le_cs_role last_role;
+
+K_MSGQ_DEFINE(result_msgq, sizeof(struct result), 8, 4);
+
+struct bt_conn *__wrap_bt_conn_ref(struct bt_conn *conn)
+{
+	return conn;
+}
+
+void __wrap_bt_conn_unref(struct bt_conn *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+static struct fake_peer *fake_peer_get(struct bt_conn *conn)
+{
+	struct fake_peer *fp = &fake_peers[(uint8_t *)conn - conn_mem];
+
+	fp->conn = conn;
+
+	return fp;
+}
+
+static int rd_ready_subscribe_fake(struct bt_conn *conn, bt_ras_rreq_rd_ready_cb_t cb)
+{
+	fake_peer_get(conn)->rd_ready_cb = cb;
+
+	return 0;
+}
+
+static int cp_get_ranging_data_fake(struct bt_conn *conn, struct net_buf_simple *buf,
+				    uint16_t ranging_counter,
+				    bt_ras_rreq_ranging_data_received_t cb)
+{
+	struct fake_peer *fp = fake_peer_get(conn);
+
+	fp->rx_buf = buf;
+	fp->rd_cb = cb;
+
+	return 0;
+}
+
+static int realtime_rd_subscribe_fake(struct bt_conn *conn, struct net_buf_simple *buf,
+				      bt_ras_rreq_ranging_data_received_t cb)
+{
+	struct fake_peer *fp = fake_peer_get(conn);
+
+	fp->rx_buf = buf;
+	fp->rd_cb = cb;
+
+	return 0;
+}
+
+static int realtime_rd_buf_set_fake(struct bt_conn *conn, struct net_buf_simple *buf)
+{
+	fake_peer_get(conn)->rx_buf = buf;
+
+	return 0;
+}
+
+/* Fake distance estimation, where every byte of the step data adds its value in centimeters.
+ * It verifies that the estimation gets all of the step data of the procedure.
+ */
+static void populate_report_fake(struct net_buf_simple *local_steps,
+				 struct net_buf_simple *peer_steps,
+				 enum bt_conn_le_cs_role role, cs_de_report_t *report)
+{
+	uint32_t sum = 0;
+
+	for (size_t i = 0; i < local_steps->len; i++) {
+		sum += local_steps->data[i];
+	}
+
+	for (size_t i = 0; i < peer_steps->len; i++) {
+		sum += peer_steps->data[i];
+	}
+
+	memset(report, 0, sizeof(*report));
+	report->role = role;
+	report->n_ap = 1;
+	report->distance_estimates[0].best = sum / 100.0f;
+	last_role = role;
+}
+
+static cs_de_quality_t calc_fake(cs_de_report_t *report)
+{
+	return (report->distance_estimates[0].best > 0.0f) ? CS_DE_QUALITY_OK :
+							      CS_DE_QUALITY_DO_NOT_USE;
+}
+
+static void result_cb(struct bt_conn *conn, uint16_t ranging_counter, cs_de_report_t *report,
+		      cs_de_quality_t quality)
+{
+	struct result result = {
+		.conn = conn,
+		.ranging_counter = ranging_counter,
+		.distance = report->distance_estimates[0].best,
+		.quality = quality,
+	};
+
+	zassert_ok(k_msgq_put(&result_msgq, &result, K_NO_WAIT), "Too many results");
+}
+
+static void local_steps_send(struct bt_conn *conn, uint16_t procedure_counter,
+			     const uint8_t *steps, size_t len,
+			     enum bt_conn_le_cs_procedure_done_status status)
+{
+	struct bt_conn_le_cs_subevent_result result = {0};
+	struct net_buf_simple buf;
+
+	net_buf_simple_init_with_data(&buf, (void *)steps, len);
+
+	result.header.procedure_counter = procedure_counter;
+	result.header.subevent_done_status = BT_CONN_LE_CS_SUBEVENT_COMPLETE;
+	result.header.procedure_done_status = status;
+	result.step_data_buf = &buf;
+
+	cs_de_pipeline_subevent_result(conn, &result);
+}
+
+static void peer_rd_send(struct bt_conn *conn, uint16_t ranging_counter, const uint8_t *rd,
+			 size_t len)
+{
+	struct fake_peer *fp = fake_peer_get(conn);
+
+	zassert_not_null(fp->rx_buf, "No ranging data buffer");
+	zassert_not_null(fp->rd_cb, "No ranging data callback");
+
+	net_buf_simple_add_mem(fp->rx_buf, rd, len);
+	fp->rd_cb(conn, ranging_counter, 0);
+}
+
+static void result_verify(struct bt_conn *conn, uint16_t ranging_counter, float distance)
+{
+	struct result result;
+
+	zassert_ok(k_msgq_get(&result_msgq, &result, RESULT_TIMEOUT), "No result");
+	zassert_equal_ptr(result.conn, conn, "Invalid peer");
+	zassert_equal(result.ranging_counter, ranging_counter, "Invalid ranging counter");
+	zassert_within(result.distance, distance, 0.001f, "Invalid distance estimate");
+	zassert_equal(result.quality, CS_DE_QUALITY_OK, "Invalid quality");
+}
+
+static void no_result_verify(void)
+{
+	struct result result;
+
+	zassert_equal(k_msgq_get(&result_msgq, &result, RESULT_TIMEOUT), -EAGAIN,
+		      "Unexpected result");
+}
+
+static struct cs_de_pipeline_stats stats_get(struct bt_conn *conn)
+{
+	struct cs_de_pipeline_stats stats;
+
+	/* Let the pipeline thread finish the processing of the last procedure. */
+	k_sleep(K_MSEC(10));
+
+	zassert_ok(cs_de_pipeline_stats_get(conn, &stats, false), "Cannot get statistics");
+
+	return stats;
+}
+
+ZTEST(cs_de_pipeline, test_on_demand_procedure)
+{
+	static const uint8_t steps_1[] = {10, 20};
+	static const uint8_t steps_2[] = {30};
+	static const uint8_t rd[] = {40};
+	struct cs_de_pipeline_stats stats;
+
+	zassert_ok(cs_de_pipeline_peer_add(CONN_A, BT_CONN_LE_CS_ROLE_INITIATOR, false,
+					   result_cb), "Cannot add peer");
+	zassert_equal(bt_ras_rreq_rd_ready_subscribe_fake.call_count, 1, "Not subscribed");
+	zassert_equal(bt_ras_rreq_on_demand_rd_subscribe_fake.call_count, 1, "Not subscribed");
+	zassert_equal(cs_de_pipeline_peer_add(CONN_A, BT_CONN_LE_CS_ROLE_INITIATOR, false,
+					      result_cb), -EALREADY, "Peer added twice");
+
+	/* Local step data of a procedure is received in multiple subevents. The procedure
+	 * counter is reduced to the ranging counter.
+	 */
+	local_steps_send(CONN_A, 0x1001, steps_1, sizeof(steps_1),
+			 BT_CONN_LE_CS_PROCEDURE_INCOMPLETE);
+	local_steps_send(CONN_A, 0x1001, steps_2, sizeof(steps_2),
+			 BT_CONN_LE_CS_PROCEDURE_COMPLETE);
+
+	/* The pipeline requests the ranging data on its own when it is ready. */
+	fake_peer_get(CONN_A)->rd_ready_cb(CONN_A, 1);
+	k_sleep(K_MSEC(10));
+	zassert_equal(bt_ras_rreq_cp_get_ranging_data_fake.call_count, 1,
+		      "Ranging data not requested");
+	zassert_equal(bt_ras_rreq_cp_get_ranging_data_fake.arg2_val, 1,
+		      "Invalid ranging counter requested");
+
+	peer_rd_send(CONN_A, 1, rd, sizeof(rd));
+	result_verify(CONN_A, 1, 1.0f);
+	zassert_equal(last_role, BT_CONN_LE_CS_ROLE_INITIATOR, "Invalid role");
+
+	stats = stats_get(CONN_A);
+	zassert_equal(stats.procedures, 1, "Invalid number of procedures");
+	zassert_equal(stats.dropped, 0, "Invalid number of dropped procedures");
+	zassert_equal(stats.rx_bytes, sizeof(steps_1) + sizeof(steps_2) + sizeof(rd),
+		      "Invalid number of received bytes");
+}
+
+ZTEST(cs_de_pipeline, test_realtime_peers)
+{
+	static const uint8_t steps_a[] = {50};
+	static const uint8_t steps_b[] = {70};
+	static const uint8_t rd_a[] = {100, 50};
+	static const uint8_t rd_b[] = {30};
+
+	zassert_ok(cs_de_pipeline_peer_add(CONN_A, BT_CONN_LE_CS_ROLE_INITIATOR, true, result_cb),
+		   "Cannot add peer");
+	zassert_ok(cs_de_pipeline_peer_add(CONN_B, BT_CONN_LE_CS_ROLE_REFLECTOR, true, result_cb),
+		   "Cannot add peer");
+	zassert_equal(bt_ras_rreq_realtime_rd_subscribe_fake.call_count, 2, "Not subscribed");
+
+	local_steps_send(CONN_A, 5, steps_a, sizeof(steps_a), BT_CONN_LE_CS_PROCEDURE_COMPLETE);
+	local_steps_send(CONN_B, 7, steps_b, sizeof(steps_b), BT_CONN_LE_CS_PROCEDURE_COMPLETE);
+
+	/* Procedures of every peer use their own step data. */
+	peer_rd_send(CONN_B, 7, rd_b, sizeof(rd_b));
+	result_verify(CONN_B, 7, 1.0f);
+	zassert_equal(last_role, BT_CONN_LE_CS_ROLE_REFLECTOR, "Invalid role");
+
+	peer_rd_send(CONN_A, 5, rd_a, sizeof(rd_a));
+	result_verify(CONN_A, 5, 2.0f);
+	zassert_equal(last_role, BT_CONN_LE_CS_ROLE_INITIATOR, "Invalid role");
+
+	/* The next ranging data is received to a new buffer. */
+	zassert_equal(bt_ras_rreq_realtime_rd_buf_set_fake.call_count, 2, "Buffer not set");
+}
+
+ZTEST(cs_de_pipeline, test_slot_overflow)
+{
+	static const uint8_t steps[] = {1, 2, 3, 4};
+	static const uint8_t rd[] = {99, 98, 97, 96};
+	struct cs_de_pipeline_stats stats;
+
+	BUILD_ASSERT(CONFIG_BT_CS_DE_PIPELINE_PROCEDURE_CNT == 2);
+
+	zassert_ok(cs_de_pipeline_peer_add(CONN_A, BT_CONN_LE_CS_ROLE_INITIATOR, true, result_cb),
+		   "Cannot add peer");
+
+	/* Both slots wait for the peer ranging data, so the third procedure is dropped. */
+	for (uint16_t i = 0; i < 3; i++) {
+		local_steps_send(CONN_A, i + 1, &steps[i], 1, BT_CONN_LE_CS_PROCEDURE_COMPLETE);
+	}
+
+	zassert_equal(stats_get(CONN_A).dropped, 1, "Procedure not dropped");
+
+	/* Remaining step data of the dropped procedure is ignored. */
+	local_steps_send(CONN_A, 3, &steps[2], 1, BT_CONN_LE_CS_PROCEDURE_COMPLETE);
+	zassert_equal(stats_get(CONN_A).dropped, 1, "Procedure dropped twice");
+
+	peer_rd_send(CONN_A, 1, &rd[0], 1);
+	result_verify(CONN_A, 1, 1.0f);
+	peer_rd_send(CONN_A, 2, &rd[1], 1);
+	result_verify(CONN_A, 2, 1.0f);
+
+	/* Ranging data of the dropped procedure is not used. */
+	peer_rd_send(CONN_A, 3, &rd[2], 1);
+	no_result_verify();
+
+	/* Slots are reused after the processing. */
+	local_steps_send(CONN_A, 4, &steps[3], 1, BT_CONN_LE_CS_PROCEDURE_COMPLETE);
+	peer_rd_send(CONN_A, 4, &rd[3], 1);
+	result_verify(CONN_A, 4, 1.0f);
+
+	stats = stats_get(CONN_A);
+	zassert_equal(stats.procedures, 3, "Invalid number of procedures");
+	zassert_equal(stats.dropped, 1, "Invalid number of dropped procedures");
+}
+
+ZTEST(cs_de_pipeline, test_incomplete_procedures)
+{
+	static const uint8_t steps[] = {1, 2, 3};
+	static const uint8_t rd[] = {97};
+
+	zassert_ok(cs_de_pipeline_peer_add(CONN_A, BT_CONN_LE_CS_ROLE_INITIATOR, true, result_cb),
+		   "Cannot add peer");
+
+	/* Aborted procedure is dropped. */
+	local_steps_send(CONN_A, 1, &steps[0], 1, BT_CONN_LE_CS_PROCEDURE_ABORTED);
+	zassert_equal(stats_get(CONN_A).dropped, 1, "Aborted procedure not dropped");
+
+	peer_rd_send(CONN_A, 1, rd, sizeof(rd));
+	no_result_verify();
+
+	/* Procedure is dropped if the step data of the next procedure starts before it is
+	 * completed.
+	 */
+	local_steps_send(CONN_A, 2, &steps[1], 1, BT_CONN_LE_CS_PROCEDURE_INCOMPLETE);
+	local_steps_send(CONN_A, 3, &steps[2], 1, BT_CONN_LE_CS_PROCEDURE_COMPLETE);
+	zassert_equal(stats_get(CONN_A).dropped, 2, "Incomplete procedure not dropped");
+
+	peer_rd_send(CONN_A, 3, rd, sizeof(rd));
+	result_verify(CONN_A, 3, 1.0f);
+	zassert_equal(stats_get(CONN_A).procedures, 1, "Invalid number of procedures");
+}
+
+ZTEST(cs_de_pipeline, test_peer_remove)
+{
+	static const uint8_t steps[] = {1};
+	static const uint8_t rd[] = {99};
+
+	zassert_ok(cs_de_pipeline_peer_add(CONN_A, BT_CONN_LE_CS_ROLE_INITIATOR, true, result_cb),
+		   "Cannot add peer");
+	local_steps_send(CONN_A, 1, steps, sizeof(steps), BT_CONN_LE_CS_PROCEDURE_COMPLETE);
+
+	zassert_ok(cs_de_pipeline_peer_remove(CONN_A), "Cannot remove peer");
+	zassert_equal(bt_ras_rreq_realtime_rd_unsubscribe_fake.call_count, 1, "Not unsubscribed");
+	zassert_equal(cs_de_pipeline_peer_remove(CONN_A), -ENOENT, "Peer removed twice");
+
+	/* Data received after the removal is ignored. */
+	peer_rd_send(CONN_A, 1, rd, sizeof(rd));
+	no_result_verify();
+}
+
+static void cs_de_pipeline_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	RESET_FAKE(bt_ras_rreq_cp_get_ranging_data);
+	RESET_FAKE(bt_ras_rreq_on_demand_rd_subscribe);
+	RESET_FAKE(bt_ras_rreq_on_demand_rd_unsubscribe);
+	RESET_FAKE(bt_ras_rreq_rd_ready_subscribe);
+	RESET_FAKE(bt_ras_rreq_rd_ready_unsubscribe);
+	RESET_FAKE(bt_ras_rreq_realtime_rd_subscribe);
+	RESET_FAKE(bt_ras_rreq_realtime_rd_unsubscribe);
+	RESET_FAKE(bt_ras_rreq_realtime_rd_buf_set);
+	RESET_FAKE(cs_de_populate_report);
+	RESET_FAKE(cs_de_calc);
+
+	bt_ras_rreq_cp_get_ranging_data_fake.custom_fake = cp_get_ranging_data_fake;
+	bt_ras_rreq_rd_ready_subscribe_fake.custom_fake = rd_ready_subscribe_fake;
+	bt_ras_rreq_realtime_rd_subscribe_fake.custom_fake = realtime_rd_subscribe_fake;
+	bt_ras_rreq_realtime_rd_buf_set_fake.custom_fake = realtime_rd_buf_set_fake;
+	cs_de_populate_report_fake.custom_fake = populate_report_fake;
+	cs_de_calc_fake.custom_fake = calc_fake;
+
+	memset(fake_peers, 0, sizeof(fake_peers));
+	k_msgq_purge(&result_msgq);
+}
+
+static void cs_de_pipeline_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)cs_de_pipeline_peer_remove(CONN_A);
+	(void)cs_de_pipeline_peer_remove(CONN_B);
+}
+
+ZTEST_SUITE(cs_de_pipeline, NULL, NULL, cs_de_pipeline_before, cs_de_pipeline_after, NULL);
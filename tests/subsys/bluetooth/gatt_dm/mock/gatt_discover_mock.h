@@ -61,7 +61,8 @@
 		.uuid = BT_UUID_GATT_CHRC,                         \
 		.handle = _handle,                                 \
 		.user_data = (void *)(&(const struct bt_gatt_chrc) \
-			{ .uuid = _uuid, .properties = _props })   \
+			{ .uuid = _uuid, .value_handle = (_handle) + 1, \
+			  .properties = _props })                  \
 	}
 
 /**
@@ -90,5 +91,22 @@
  */
 void bt_gatt_discover_mock_setup(const struct bt_gatt_attr *attr, size_t len);
 
+/**
+ * @brief Get the number of bt_gatt_discover calls
+ *
+ * @return Number of calls since the last @ref bt_gatt_discover_mock_setup.
+ */
+size_t bt_gatt_discover_mock_call_cnt(void);
+
+/**
+ * @brief GATT read mock setup
+ *
+ * This function sets the Database Hash returned by the mock for the
+ * @ref bt_gatt_read function.
+ *
+ * @param db_hash The 16-byte Database Hash or NULL if not available.
+ */
+void bt_gatt_read_mock_setup(const uint8_t *db_hash);
+
 /** @} */
 #endif /* #define BT_GATT_DISCOVERY_MOCK_H_ */
@@ -20,6 +20,29 @@
 static char dummy_conn;
 K_SEM_DEFINE(discovery_finished, 0, 1);
 
+static const uint8_t db_hash[16] = {
+	0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+	0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+};
+
+static const uint8_t db_hash_changed[16] = {
+	0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88,
+	0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00,
+};
+
+const bt_addr_le_t *__wrap_bt_conn_get_dst(const struct bt_conn *conn)
+{
+	static const bt_addr_le_t addr = {
+		.type = BT_ADDR_LE_RANDOM,
+		.a.val = { 0x01, 0x02, 0x03, 0x04, 0x05, 0xc0 },
+	};
+
+	zassert_equal_ptr((const void *)&dummy_conn, (const void *)conn,
+			  "Unexpected connection object");
+
+	return &addr;
+}
+
 
 const struct bt_gatt_attr discover_sim[] = {
 	/* HIDS */
@@ -93,6 +116,9 @@ void test_before(void *fixture)
 
 	k_sem_reset(&discovery_finished);
 	bt_gatt_discover_mock_setup(discover_sim, ARRAY_SIZE(discover_sim));
+	bt_gatt_read_mock_setup(db_hash);
+	(void)bt_gatt_dm_cache_clear(NULL);
+	(void)bt_gatt_dm_stats_get(&(struct bt_gatt_dm_stats){0}, true);
 }
 
 struct bt_gatt_dm *run_dm(const struct bt_uuid *svc_uuid)
@@ -476,3 +502,105 @@ ZTEST(gatt_tests, test_gatt_many_serv_by_uuid)
 	zassert_equal(0, bt_gatt_dm_attr_cnt(dm), "Parameter count after clearing: %d",
 		      bt_gatt_dm_attr_cnt(dm));
 }
+
+/* Characteristic values without descriptors are taken from the declarations,
+ * so the Find Information procedure is not used for the service.
+ */
+ZTEST(gatt_tests, test_gatt_DIS_procedures)
+{
+	struct bt_gatt_dm *dm = run_dm(BT_UUID_DIS);
+
+	zassert_not_null(dm, "Device Manager pointer not set");
+	zassert_equal(5,
+		      bt_gatt_dm_attr_cnt(dm),
+		      "Unexpected number of attributes detected: %d",
+		      bt_gatt_dm_attr_cnt(dm));
+	zassert_equal(2, bt_gatt_discover_mock_call_cnt(),
+		      "Unexpected number of discover procedures: %d",
+		      bt_gatt_discover_mock_call_cnt());
+
+	bt_gatt_dm_data_release(dm);
+}
+
+ZTEST(gatt_tests, test_gatt_cache)
+{
+	struct bt_gatt_dm_stats stats;
+	const struct bt_gatt_dm_attr *attr_chrc;
+	const struct bt_gatt_dm_attr *attr_desc;
+	struct bt_gatt_dm *dm;
+	size_t call_cnt;
+
+	if (!IS_ENABLED(CONFIG_BT_GATT_DM_CACHE)) {
+		ztest_test_skip();
+	}
+
+	dm = run_dm(BT_UUID_HIDS);
+	zassert_not_null(dm, "Device Manager pointer not set");
+	bt_gatt_dm_data_release(dm);
+
+	call_cnt = bt_gatt_discover_mock_call_cnt();
+	zassert_true(call_cnt > 0, "Service not discovered");
+
+	/* The same Database Hash, the result is taken from the cache. */
+	dm = run_dm(BT_UUID_HIDS);
+	zassert_not_null(dm, "Device Manager pointer not set");
+	zassert_equal(call_cnt, bt_gatt_discover_mock_call_cnt(), "Cached service discovered");
+	zassert_equal(11,
+		      bt_gatt_dm_attr_cnt(dm),
+		      "Unexpected number of attributes detected: %d",
+		      bt_gatt_dm_attr_cnt(dm));
+
+	for (int i = 1; i <= 11; ++i) {
+		zassert_not_null(bt_gatt_dm_attr_by_handle(dm, i), "Attr handle: %d", i);
+	}
+
+	attr_chrc = bt_gatt_dm_char_by_uuid(dm, BT_UUID_HIDS_REPORT);
+	zassert_not_null(attr_chrc, "Unexpected NULL");
+	zassert_equal(6, attr_chrc->handle, "Unexpected handle: %d", attr_chrc->handle);
+	zassert_equal(BT_GATT_CHRC_READ | BT_GATT_CHRC_NOTIFY,
+		      bt_gatt_dm_attr_chrc_val(attr_chrc)->properties,
+		      "Unexpected HIDS_REPORT properties");
+	attr_desc = bt_gatt_dm_desc_by_uuid(dm, attr_chrc, BT_UUID_GATT_CCC);
+	zassert_not_null(attr_desc, "Unexpected NULL");
+	zassert_equal(8, attr_desc->handle, "Unexpected handle: %d", attr_desc->handle);
+	bt_gatt_dm_data_release(dm);
+
+	/* Missing services are cached too. */
+	dm = run_dm(BT_UUID_BAS);
+	zassert_is_null(dm, "Detected service that should be inviable");
+	call_cnt = bt_gatt_discover_mock_call_cnt();
+	dm = run_dm(BT_UUID_BAS);
+	zassert_is_null(dm, "Detected service that should be inviable");
+	zassert_equal(call_cnt, bt_gatt_discover_mock_call_cnt(), "Cached service discovered");
+
+	/* Changed Database Hash invalidates the cached results. */
+	bt_gatt_read_mock_setup(db_hash_changed);
+	dm = run_dm(BT_UUID_HIDS);
+	zassert_not_null(dm, "Device Manager pointer not set");
+	zassert_true(bt_gatt_discover_mock_call_cnt() > call_cnt, "Service not discovered");
+	bt_gatt_dm_data_release(dm);
+
+	/* Without the Database Hash, the cache is not used. */
+	bt_gatt_read_mock_setup(NULL);
+	dm = run_dm(BT_UUID_DIS);
+	zassert_not_null(dm, "Device Manager pointer not set");
+	bt_gatt_dm_data_release(dm);
+	call_cnt = bt_gatt_discover_mock_call_cnt();
+	dm = run_dm(BT_UUID_DIS);
+	zassert_not_null(dm, "Device Manager pointer not set");
+	zassert_true(bt_gatt_discover_mock_call_cnt() > call_cnt, "Service not discovered");
+	bt_gatt_dm_data_release(dm);
+
+	if (!IS_ENABLED(CONFIG_BT_GATT_DM_STATS)) {
+		return;
+	}
+
+	zassert_ok(bt_gatt_dm_stats_get(&stats, true), "Failed to get statistics");
+	zassert_equal(2, stats.cache_hit_cnt, "Unexpected cache hit count: %u",
+		      stats.cache_hit_cnt);
+	zassert_equal(5, stats.discovery_cnt, "Unexpected discovery count: %u",
+		      stats.discovery_cnt);
+
+	printk("Discovery time: %u us, cached: %u us\n",
+	       stats.discovery_time_avg_us, stats.cache_time_avg_us);
+}
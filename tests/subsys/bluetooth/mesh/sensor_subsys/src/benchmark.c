@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <bluetooth/mesh/sensor_types.h>
+#include <sensor.h> /* private header from the source folder */
+
+#define BENCHMARK_ROUNDS 200
+
+/* Property IDs which are not mapped to any sensor type. */
+static const uint16_t unknown_ids[] = { 0x0000, 0x00FF, 0x7FFF, 0xFFFF };
+
+static void report(const char *name, uint32_t ops, uint64_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles);
+
+	if (ns == 0) {
+		TC_PRINT("%s: %u operations in less than 1 ns\n", name, ops);
+		return;
+	}
+
+	TC_PRINT("%s: %u operations in %llu ns, %llu per second\n", name, ops,
+		 ns, (uint64_t)ops * NSEC_PER_SEC / ns);
+}
+
+ZTEST(sensor_types_benchmark, test_type_get)
+{
+	uint32_t ops = 0;
+	uint64_t start;
+
+	start = k_cycle_get_64();
+
+	for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+		STRUCT_SECTION_FOREACH(bt_mesh_sensor_type, type) {
+			zassert_equal_ptr(bt_mesh_sensor_type_get(type->id), type);
+			ops++;
+		}
+
+		for (int i = 0; i < ARRAY_SIZE(unknown_ids); i++) {
+			zassert_is_null(bt_mesh_sensor_type_get(unknown_ids[i]));
+			ops++;
+		}
+	}
+
+	report("Sensor type lookup", ops, k_cycle_get_64() - start);
+}
+
+ZTEST(sensor_types_benchmark, test_value_encode_decode)
+{
+	const int64_t micro_values[] = { -1500000, 0, 1000000, 42500000 };
+	struct bt_mesh_sensor_value value = { 0 };
+	uint32_t ops = 0;
+	uint64_t start;
+	int64_t micro;
+	int err;
+
+	start = k_cycle_get_64();
+
+	for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+		STRUCT_SECTION_FOREACH(bt_mesh_sensor_type, type) {
+			for (int ch = 0; ch < type->channel_count; ch++) {
+				const struct bt_mesh_sensor_format *format =
+					type->channels[ch].format;
+
+				for (int i = 0; i < ARRAY_SIZE(micro_values); i++) {
+					err = bt_mesh_sensor_value_from_micro(
+						format, micro_values[i], &value);
+					zassert_true(err == 0 || err == -ERANGE,
+						     "Encoding failed (err %d)", err);
+
+					(void)bt_mesh_sensor_value_to_micro(&value,
+									    &micro);
+					ops++;
+				}
+			}
+		}
+	}
+
+	report("Sensor value encode and decode", ops, k_cycle_get_64() - start);
+}
+
+ZTEST_SUITE(sensor_types_benchmark, NULL, NULL, NULL, NULL, NULL);
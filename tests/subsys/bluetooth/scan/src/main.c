@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <bluetooth/scan.h>
+
+#define ADDR_FILTER_CNT		CONFIG_BT_SCAN_ADDRESS_CNT
+#define UUID_FILTER_CNT		CONFIG_BT_SCAN_UUID_CNT
+#define BENCHMARK_REPORT_CNT	10000
+#define BENCHMARK_DEVICE_CNT	8
+
+static struct bt_le_scan_cb *scan_cb;
+
+static uint32_t match_cnt;
+static uint32_t no_match_cnt;
+static struct bt_scan_filter_match last_match;
+
+void __wrap_bt_le_scan_cb_register(struct bt_le_scan_cb *cb)
+{
+	scan_cb = cb;
+}
+
+static void scan_filter_match(struct bt_scan_device_info *device_info,
+			      struct bt_scan_filter_match *filter_match,
+			      bool connectable)
+{
+	match_cnt++;
+	last_match = *filter_match;
+}
+
+static void scan_filter_no_match(struct bt_scan_device_info *device_info,
+				 bool connectable)
+{
+	no_match_cnt++;
+}
+
+BT_SCAN_CB_INIT(scan_cb_data, scan_filter_match, scan_filter_no_match, NULL, NULL);
+
+static void test_addr_get(bt_addr_le_t *addr, uint16_t idx)
+{
+	addr->type = BT_ADDR_LE_RANDOM;
+	addr->a.val[0] = idx & 0xff;
+	addr->a.val[1] = idx >> 8;
+	addr->a.val[2] = 0x5a;
+	addr->a.val[3] = 0xa5;
+	addr->a.val[4] = 0x11;
+	addr->a.val[5] = 0xc0;
+}
+
+static uint16_t test_uuid_get(uint16_t idx)
+{
+	return 0x1800 + idx;
+}
+
+static void recv_info_init(struct bt_le_scan_recv_info *info, const bt_addr_le_t *addr)
+{
+	memset(info, 0, sizeof(*info));
+	info->addr = addr;
+	info->adv_type = BT_GAP_ADV_TYPE_ADV_IND;
+	info->adv_props = BT_GAP_ADV_PROP_CONNECTABLE | BT_GAP_ADV_PROP_SCANNABLE;
+}
+
+static void report_send(const bt_addr_le_t *addr, uint16_t uuid, uint8_t counter)
+{
+	uint8_t data[] = {
+		0x02, BT_DATA_FLAGS, BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR,
+		0x03, BT_DATA_UUID16_ALL, uuid & 0xff, uuid >> 8,
+		0x04, BT_DATA_MANUFACTURER_DATA, 0x59, 0x00, counter,
+	};
+	struct bt_le_scan_recv_info info;
+	struct net_buf_simple ad;
+
+	recv_info_init(&info, addr);
+	net_buf_simple_init_with_data(&ad, data, sizeof(data));
+
+	zassert_not_null(scan_cb, "Scan callback not registered");
+	scan_cb->recv(&info, &ad);
+}
+
+static void addr_filters_add(void)
+{
+	bt_addr_le_t addr;
+	int err;
+
+	for (uint16_t i = 0; i < ADDR_FILTER_CNT; i++) {
+		test_addr_get(&addr, i);
+		err = bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &addr);
+		zassert_ok(err, "Failed to add address filter %u (err %d)", i, err);
+	}
+}
+
+static void uuid_filters_add(void)
+{
+	int err;
+
+	for (uint16_t i = 0; i < UUID_FILTER_CNT; i++) {
+		/* Mix 16-bit and 128-bit forms of the same SIG UUIDs. */
+		if (i % 2) {
+			struct bt_uuid_16 uuid = BT_UUID_INIT_16(test_uuid_get(i));
+
+			err = bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &uuid);
+		} else {
+			uint32_t val = test_uuid_get(i);
+			struct bt_uuid_128 uuid = BT_UUID_INIT_128(
+				BT_UUID_128_ENCODE(val, 0x0000, 0x1000, 0x8000, 0x00805f9b34fb));
+
+			err = bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &uuid);
+		}
+
+		zassert_ok(err, "Failed to add UUID filter %u (err %d)", i, err);
+	}
+}
+
+static void *scan_setup(void)
+{
+	bt_scan_init(NULL);
+	bt_scan_cb_register(&scan_cb_data);
+
+	return NULL;
+}
+
+static void scan_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	bt_scan_filter_remove_all();
+	bt_scan_filter_disable();
+	(void)bt_scan_dedup_stats_get(&(struct bt_scan_dedup_stats){0}, true);
+
+	match_cnt = 0;
+	no_match_cnt = 0;
+	memset(&last_match, 0, sizeof(last_match));
+}
+
+ZTEST(bt_scan, test_addr_filter)
+{
+	bt_addr_le_t addr;
+	struct bt_filter_status status;
+	int err;
+
+	addr_filters_add();
+
+	err = bt_scan_filter_status_get(&status);
+	zassert_ok(err, "Failed to get filter status (err %d)", err);
+	zassert_equal(status.addr.cnt, ADDR_FILTER_CNT, "Invalid address filter count");
+
+	/* Duplicated filter is accepted and not added again. */
+	test_addr_get(&addr, 0);
+	err = bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &addr);
+	zassert_ok(err, "Duplicated filter rejected (err %d)", err);
+
+	test_addr_get(&addr, ADDR_FILTER_CNT);
+	err = bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &addr);
+	zassert_equal(err, -ENOMEM, "Filter added above the limit (err %d)", err);
+
+	err = bt_scan_filter_enable(BT_SCAN_ADDR_FILTER, false);
+	zassert_ok(err, "Failed to enable filters (err %d)", err);
+
+	for (uint16_t i = 0; i < ADDR_FILTER_CNT; i++) {
+		test_addr_get(&addr, i);
+		report_send(&addr, 0, 0);
+
+		zassert_equal(match_cnt, i + 1, "Address %u not matched", i);
+		zassert_true(last_match.addr.match, "Address filter not reported");
+		zassert_ok(bt_addr_le_cmp(last_match.addr.addr, &addr), "Invalid matched address");
+	}
+
+	test_addr_get(&addr, ADDR_FILTER_CNT + 1);
+	report_send(&addr, 0, 0);
+	zassert_equal(no_match_cnt, 1, "Unknown address matched");
+}
+
+ZTEST(bt_scan, test_uuid_filter)
+{
+	bt_addr_le_t addr;
+	int err;
+
+	uuid_filters_add();
+
+	err = bt_scan_filter_enable(BT_SCAN_UUID_FILTER, false);
+	zassert_ok(err, "Failed to enable filters (err %d)", err);
+
+	test_addr_get(&addr, 0);
+
+	for (uint16_t i = 0; i < UUID_FILTER_CNT; i++) {
+		report_send(&addr, test_uuid_get(i), 0);
+
+		zassert_equal(match_cnt, i + 1, "UUID %u not matched", i);
+		zassert_equal(last_match.uuid.count, 1, "Invalid matched UUID count");
+		zassert_ok(bt_uuid_cmp(last_match.uuid.uuid[0],
+				       BT_UUID_DECLARE_16(test_uuid_get(i))),
+			   "Invalid matched UUID");
+	}
+
+	report_send(&addr, test_uuid_get(UUID_FILTER_CNT), 0);
+	zassert_equal(no_match_cnt, 1, "Unknown UUID matched");
+}
+
+ZTEST(bt_scan, test_uuid_filter_partial_uuid)
+{
+	const uint16_t uuid = test_uuid_get(1);
+	/* The last byte of the UUID list does not form a complete UUID. The byte that follows
+	 * the advertising data would complete it to the UUID of a filter.
+	 */
+	uint8_t data[] = {
+		0x04, BT_DATA_UUID16_ALL, 0xff, 0xff, uuid & 0xff, uuid >> 8,
+	};
+	struct bt_le_scan_recv_info info;
+	struct net_buf_simple ad;
+	bt_addr_le_t addr;
+	int err;
+
+	uuid_filters_add();
+
+	err = bt_scan_filter_enable(BT_SCAN_UUID_FILTER, false);
+	zassert_ok(err, "Failed to enable filters (err %d)", err);
+
+	test_addr_get(&addr, 0);
+	recv_info_init(&info, &addr);
+	net_buf_simple_init_with_data(&ad, data, sizeof(data) - 1);
+	scan_cb->recv(&info, &ad);
+
+	zassert_equal(match_cnt, 0, "Partial UUID matched");
+	zassert_equal(no_match_cnt, 1, "Invalid no match count");
+}
+
+ZTEST(bt_scan, test_dedup_cache)
+{
+	struct bt_scan_dedup_stats stats;
+	bt_addr_le_t addr;
+	int err;
+
+	err = bt_scan_dedup_stats_get(&stats, true);
+	if (err == -ENOTSUP) {
+		ztest_test_skip();
+	}
+	zassert_ok(err, "Failed to get cache statistics (err %d)", err);
+
+	addr_filters_add();
+
+	err = bt_scan_filter_enable(BT_SCAN_ADDR_FILTER, false);
+	zassert_ok(err, "Failed to enable filters (err %d)", err);
+
+	test_addr_get(&addr, 1);
+	report_send(&addr, 0, 0);
+	report_send(&addr, 0, 0);
+
+	/* Changed payload must not reuse the cached result. */
+	report_send(&addr, 0, 1);
+
+	zassert_equal(match_cnt, 3, "Invalid match count");
+	zassert_ok(bt_addr_le_cmp(last_match.addr.addr, &addr), "Invalid matched address");
+
+	err = bt_scan_dedup_stats_get(&stats, false);
+	zassert_ok(err, "Failed to get cache statistics (err %d)", err);
+	zassert_equal(stats.hit, 1, "Invalid cache hit count");
+	zassert_equal(stats.miss, 2, "Invalid cache miss count");
+
+	/* Filter change invalidates the cache. */
+	bt_scan_filter_remove_all();
+	report_send(&addr, 0, 1);
+
+	zassert_equal(match_cnt, 3, "Removed filter matched");
+	zassert_equal(no_match_cnt, 1, "Invalid no match count");
+
+	err = bt_scan_dedup_stats_get(&stats, true);
+	zassert_ok(err, "Failed to get cache statistics (err %d)", err);
+	zassert_equal(stats.hit, 1, "Invalid cache hit count");
+	zassert_equal(stats.miss, 3, "Invalid cache miss count");
+}
+
+#if CONFIG_BT_SCAN_DEDUP_CACHE_SIZE > 0
+ZTEST(bt_scan, test_dedup_cache_long_data)
+{
+	uint8_t data[CONFIG_BT_SCAN_DEDUP_DATA_SIZE + 2] = {
+		sizeof(data) - 1, BT_DATA_MANUFACTURER_DATA, 0x59, 0x00,
+	};
+	struct bt_scan_dedup_stats stats;
+	struct bt_le_scan_recv_info info;
+	struct net_buf_simple ad;
+	bt_addr_le_t addr;
+	int err;
+
+	addr_filters_add();
+
+	err = bt_scan_filter_enable(BT_SCAN_ADDR_FILTER, false);
+	zassert_ok(err, "Failed to enable filters (err %d)", err);
+
+	test_addr_get(&addr, 1);
+	recv_info_init(&info, &addr);
+
+	/* Advertising data that does not fit in the cache entry is always filtered. */
+	for (size_t i = 0; i < 2; i++) {
+		net_buf_simple_init_with_data(&ad, data, sizeof(data));
+		scan_cb->recv(&info, &ad);
+	}
+
+	zassert_equal(match_cnt, 2, "Invalid match count");
+
+	err = bt_scan_dedup_stats_get(&stats, true);
+	zassert_ok(err, "Failed to get cache statistics (err %d)", err);
+	zassert_equal(stats.hit, 0, "Invalid cache hit count");
+	zassert_equal(stats.miss, 2, "Invalid cache miss count");
+}
+#endif /* CONFIG_BT_SCAN_DEDUP_CACHE_SIZE > 0 */
+
+ZTEST(bt_scan, test_benchmark)
+{
+	bt_addr_le_t addr[BENCHMARK_DEVICE_CNT];
+	uint32_t start;
+	uint32_t cycles;
+	int err;
+
+	addr_filters_add();
+	uuid_filters_add();
+
+	err = bt_scan_filter_enable(BT_SCAN_ADDR_FILTER | BT_SCAN_UUID_FILTER, false);
+	zassert_ok(err, "Failed to enable filters (err %d)", err);
+
+	/* Devices outside of the allowlist force the worst case lookup. */
+	for (size_t i = 0; i < ARRAY_SIZE(addr); i++) {
+		test_addr_get(&addr[i], ADDR_FILTER_CNT + i);
+	}
+
+	start = k_cycle_get_32();
+
+	for (uint32_t i = 0; i < BENCHMARK_REPORT_CNT; i++) {
+		report_send(&addr[i % ARRAY_SIZE(addr)], test_uuid_get(UUID_FILTER_CNT), 0);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(no_match_cnt, BENCHMARK_REPORT_CNT, "Invalid no match count");
+
+	printk("Processed %u advertising reports in %u us (%u filters)\n",
+	       BENCHMARK_REPORT_CNT, k_cyc_to_us_floor32(cycles),
+	       ADDR_FILTER_CNT + UUID_FILTER_CNT);
+}
+
+ZTEST_SUITE(bt_scan, NULL, scan_setup, scan_before, NULL, NULL);
@@ -30,4 +30,60 @@ ZTEST(bl_validation_unittest, test_region_within)
 	zassert_false(region_within(0xFFFF, 0x20000, 0x10000, 0x100000), NULL);
 }
 
+ZTEST(bl_validation_unittest, test_marker_check)
+{
+	const struct marker_binding image = {
+		.fw_address = 0x10000,
+		.fw_size = 0x8000,
+		.fw_version = 3,
+		.counter = 3,
+	};
+	struct marker_binding marker = image;
+
+	zassert_equal(marker_check(NULL, &image, true, 0, 32), MARKER_MISSING, NULL);
+	zassert_equal(marker_check(&marker, &image, true, 0, 32), MARKER_USABLE, NULL);
+	zassert_equal(marker_check(&marker, &image, true, 31, 32), MARKER_USABLE, NULL);
+
+	marker.fw_address = 0x20000;
+	zassert_equal(marker_check(&marker, &image, true, 0, 32), MARKER_MISMATCH, NULL);
+	marker = image;
+	marker.fw_size = 0x8004;
+	zassert_equal(marker_check(&marker, &image, true, 0, 32), MARKER_MISMATCH, NULL);
+	marker = image;
+	marker.fw_version = 2;
+	zassert_equal(marker_check(&marker, &image, true, 0, 32), MARKER_MISMATCH, NULL);
+
+	marker = image;
+	marker.counter = 2;
+	zassert_equal(marker_check(&marker, &image, true, 0, 32),
+		      MARKER_COUNTER_CHANGED, NULL);
+
+	marker = image;
+	zassert_equal(marker_check(&marker, &image, false, 0, 32),
+		      MARKER_KEY_INVALIDATED, NULL);
+}
+
+ZTEST(bl_validation_unittest, test_marker_check_revalidate)
+{
+	const struct marker_binding image = {
+		.fw_address = 0x10000,
+		.fw_size = 0x8000,
+		.fw_version = 3,
+		.counter = 0,
+	};
+
+	zassert_equal(marker_check(&image, &image, true, 32, 32), MARKER_REVALIDATE, NULL);
+	zassert_equal(marker_check(&image, &image, true, 33, 32), MARKER_REVALIDATE, NULL);
+	zassert_equal(marker_check(&image, &image, true, 1, 1), MARKER_REVALIDATE, NULL);
+	zassert_equal(marker_check(&image, &image, true, 0, 1), MARKER_USABLE, NULL);
+
+	/* Interval 0 disables the periodic full validation. */
+	zassert_equal(marker_check(&image, &image, true, 0, 0), MARKER_USABLE, NULL);
+	zassert_equal(marker_check(&image, &image, true, 1024, 0), MARKER_USABLE, NULL);
+
+	/* Other reasons take precedence over the periodic full validation. */
+	zassert_equal(marker_check(&image, &image, false, 32, 32),
+		      MARKER_KEY_INVALIDATED, NULL);
+}
+
 ZTEST_SUITE(bl_validation_unittest, NULL, NULL, NULL, NULL, NULL);
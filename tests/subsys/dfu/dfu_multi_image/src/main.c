@@ -20,6 +20,8 @@ struct expected_image {
 	int image_id;
 	const char *content;
 	size_t content_size;
+	/* Digest passed to the image writer, or NULL */
+	const uint8_t *sha256;
 };
 
 #define EXPECTED_IMAGE(id, contentstr)                                                             \
@@ -33,6 +35,10 @@ struct expected_image {
 struct expected {
 	struct expected_image images[CONFIG_DFU_MULTI_IMAGE_MAX_IMAGE_COUNT];
 	size_t image_count;
+	/* Images may be closed with a failure */
+	bool close_failure;
+	/* Error returned by the image writer, or 0 */
+	int write_err;
 };
 
 /*
@@ -64,6 +70,10 @@ static int image_comparator_write(const uint8_t *chunk, size_t chunk_size)
 {
 	const struct expected_image *image = &ctx.expected.images[ctx.current_image_no];
 
+	if (ctx.expected.write_err) {
+		return ctx.expected.write_err;
+	}
+
 	zassert_true(ctx.current_image_offset + chunk_size <= image->content_size,
 		     "Too large image written");
 	zassert_ok(memcmp(image->content + ctx.current_image_offset, chunk, chunk_size),
@@ -76,7 +86,7 @@ static int image_comparator_write(const uint8_t *chunk, size_t chunk_size)
 
 static int image_comparator_close(bool success)
 {
-	zassert_true(success, "Closing image with failure");
+	zassert_true(success || ctx.expected.close_failure, "Closing image with failure");
 
 	ctx.current_image_no++;
 	ctx.current_image_offset = 0;
@@ -111,7 +121,8 @@ static int comparison_test(const uint8_t *package, size_t package_size,
 		struct dfu_image_writer writer = { .image_id = expected->images[i].image_id,
 						   .open = image_comparator_open,
 						   .write = image_comparator_write,
-						   .close = image_comparator_close };
+						   .close = image_comparator_close,
+						   .sha256 = expected->images[i].sha256 };
 
 		err = dfu_multi_image_register_writer(&writer);
 
@@ -267,4 +278,102 @@ ZTEST(dfu_multi_image_test, test_generated_dfu_package)
 		   "DFU failed");
 }
 
+static const uint8_t image_0_sha256[] = {
+	0x02, 0xed, 0xb5, 0xea, 0xfb, 0x84, 0xf9, 0x60, 0x9d, 0xcf, 0xf8, 0xbb, 0x1e, 0x5c, 0xc0, 0x31,
+	0xa7, 0x62, 0xad, 0x96, 0xb1, 0xd8, 0x31, 0xa8, 0x2c, 0x31, 0x83, 0xf0, 0x2f, 0xec, 0x23, 0x5d
+};
+
+static const uint8_t image_256_sha256[] = {
+	0xb7, 0x76, 0xe3, 0x90, 0xdd, 0xf7, 0xc5, 0x98, 0x1f, 0x98, 0xdc, 0xe1, 0xb9, 0x1b, 0xb8, 0xd9,
+	0xa6, 0xef, 0x0d, 0x5c, 0xb5, 0xc1, 0x74, 0xa3, 0x02, 0x00, 0x1e, 0x4d, 0x30, 0x8e, 0xcd, 0xbd
+};
+
+ZTEST(dfu_multi_image_test, test_digest)
+{
+	uint8_t buffer[128];
+	uint8_t digest[DFU_MULTI_IMAGE_SHA256_LEN];
+	struct expected expected = two_image_package_expected;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_DFU_MULTI_IMAGE_SHA256);
+
+	/*
+	 * Test that the digests of the written images are computed and verified against
+	 * the digests provided by the image writers.
+	 */
+	expected.images[0].sha256 = image_0_sha256;
+	expected.images[1].sha256 = image_256_sha256;
+	zassert_ok(comparison_test(two_image_package, sizeof(two_image_package), &expected, buffer,
+				   sizeof(buffer), 6),
+		   "DFU failed");
+
+	zassert_ok(dfu_multi_image_digest_get(0, digest));
+	zassert_mem_equal(digest, image_0_sha256, sizeof(digest));
+	zassert_ok(dfu_multi_image_digest_get(256, digest));
+	zassert_mem_equal(digest, image_256_sha256, sizeof(digest));
+	zassert_equal(dfu_multi_image_digest_get(1, digest), -ENOENT);
+}
+
+ZTEST(dfu_multi_image_test, test_digest_mismatch)
+{
+	int err;
+	uint8_t buffer[128];
+	struct expected expected = two_image_package_expected;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_DFU_MULTI_IMAGE_SHA256);
+
+	/*
+	 * Test that the DFU fails when the digest of a written image differs from the
+	 * digest provided by the image writer.
+	 */
+	expected.images[1].sha256 = image_0_sha256;
+	expected.close_failure = true;
+	err = comparison_test(two_image_package, sizeof(two_image_package), &expected, buffer,
+			      sizeof(buffer), 100);
+	zassert_equal(err, -EBADMSG, "DFU passed despite of digest mismatch");
+
+	/* The image closed after the digest mismatch is not closed again */
+	(void)dfu_multi_image_done(false);
+	zassert_equal(ctx.current_image_no, 2, "Images not closed exactly once");
+}
+
+ZTEST(dfu_multi_image_test, test_write_failure)
+{
+	int err;
+	uint8_t buffer[128];
+	struct expected expected = two_image_package_expected;
+
+	/*
+	 * Test that an image that failed to be written is closed once, even if the failure
+	 * is reported after the package parser moved on to the next image.
+	 */
+	expected.write_err = -EIO;
+	expected.close_failure = true;
+	err = comparison_test(two_image_package, sizeof(two_image_package), &expected, buffer,
+			      sizeof(buffer), 100);
+	zassert_equal(err, -EIO, "DFU passed despite of write failure");
+
+	(void)dfu_multi_image_done(false);
+	zassert_equal(ctx.current_image_no, 1, "Image not closed exactly once");
+}
+
+ZTEST(dfu_multi_image_test, test_stats)
+{
+	uint8_t buffer[128];
+	struct dfu_multi_image_stats stats;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_DFU_MULTI_IMAGE_STATS);
+
+	zassert_ok(comparison_test(two_image_package, sizeof(two_image_package),
+				   &two_image_package_expected, buffer, sizeof(buffer), 3),
+		   "DFU failed");
+
+	zassert_ok(dfu_multi_image_stats_get(0, &stats));
+	zassert_equal(stats.bytes_written, strlen("image 0 content"));
+	zassert_true(stats.write_time_us <= stats.total_time_us);
+	zassert_ok(dfu_multi_image_stats_get(256, &stats));
+	zassert_equal(stats.bytes_written, strlen("image 256 content"));
+	zassert_equal(dfu_multi_image_stats_get(1, &stats), -ENOENT);
+	zassert_equal(dfu_multi_image_stats_get(0, NULL), -EINVAL);
+}
+
 ZTEST_SUITE(dfu_multi_image_test, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/flash/flash_simulator.h>
+#include <zephyr/sys/util.h>
+#include <emds/emds.h>
+#include <emds_flash.h>
+
+#define PARTITIONS_NUM_MAX 2
+#define ENTRY_SIZE         64
+#define DYNAMIC_ENTRY_SIZE 100
+#define DYNAMIC_ENTRY_ID   0x1001
+
+#define ENTRY_STORE_SIZE   (ENTRY_SIZE + sizeof(struct emds_data_entry))
+
+BUILD_ASSERT(CONFIG_EMDS_DELTA_CHAIN_MAX == 3, "The compaction test expects a chain of 3 deltas");
+BUILD_ASSERT(CONFIG_EMDS_DELTA_DIRTY_BYTES_MAX >=
+			     DYNAMIC_ENTRY_SIZE + sizeof(struct emds_data_entry) &&
+		     CONFIG_EMDS_DELTA_DIRTY_BYTES_MAX < 2 * ENTRY_STORE_SIZE,
+	     "The budget tests expect that only two static entries exceed the budget");
+
+static uint8_t s_data[3][ENTRY_SIZE];
+static uint8_t d_data[DYNAMIC_ENTRY_SIZE];
+
+/* The first entry has no dirty tracking and is stored in every snapshot */
+EMDS_STATIC_ENTRY_DEFINE(s_entry_0, 0x1, s_data[0], ENTRY_SIZE);
+EMDS_STATIC_TRACKED_ENTRY_DEFINE(s_entry_1, 0x2, s_data[1], ENTRY_SIZE);
+EMDS_STATIC_TRACKED_ENTRY_DEFINE(s_entry_2, 0x3, s_data[2], ENTRY_SIZE);
+
+static struct emds_dynamic_entry d_entry = {
+	.entry = {DYNAMIC_ENTRY_ID, d_data, DYNAMIC_ENTRY_SIZE, true},
+};
+
+static struct emds_partition partition[PARTITIONS_NUM_MAX];
+
+static uint32_t store_time_expected(size_t store_size)
+{
+	return (DIV_ROUND_UP(store_size, 4) +
+		DIV_ROUND_UP(sizeof(struct emds_snapshot_metadata), 4)) *
+		       CONFIG_EMDS_FLASH_TIME_WRITE_ONE_WORD_US +
+	       DIV_ROUND_UP(store_size, 16) * CONFIG_EMDS_CHUNK_PREPARATION_TIME_US;
+}
+
+static void data_fill(uint8_t value)
+{
+	for (int i = 0; i < ARRAY_SIZE(s_data); i++) {
+		memset(s_data[i], value + i, ENTRY_SIZE);
+	}
+
+	memset(d_data, value + ARRAY_SIZE(s_data), DYNAMIC_ENTRY_SIZE);
+}
+
+static void data_check(const uint8_t *data, size_t len, uint8_t value)
+{
+	for (size_t i = 0; i < len; i++) {
+		zassert_equal(data[i], value, "Unexpected data at %zu: %u != %u", i, data[i],
+			      value);
+	}
+}
+
+static void data_reload(void)
+{
+	memset(s_data, 0, sizeof(s_data));
+	memset(d_data, 0, sizeof(d_data));
+
+	zassert_ok(emds_load(), "Failed to load data");
+}
+
+static struct emds_snapshot_candidate freshest_snapshot_get(void)
+{
+	struct emds_snapshot_candidate freshest = {0};
+	struct emds_snapshot_candidate candidate;
+
+	for (int i = 0; i < PARTITIONS_NUM_MAX; i++) {
+		memset(&candidate, 0, sizeof(candidate));
+		zassert_ok(emds_flash_scan_partition(&partition[i], &candidate),
+			   "Failed to scan partition %d", i);
+
+		if (candidate.metadata.fresh_cnt > freshest.metadata.fresh_cnt) {
+			freshest = candidate;
+			freshest.partition_index = i;
+		}
+	}
+
+	zassert_not_equal(freshest.metadata.fresh_cnt, 0, "No snapshot found");
+
+	return freshest;
+}
+
+static void *emds_delta_setup(void)
+{
+	const uint8_t id[] = {FIXED_PARTITION_ID(emds_partition_0),
+			      FIXED_PARTITION_ID(emds_partition_1)};
+
+	zassert_ok(emds_init(NULL), "Failed to initialize EMDS");
+	zassert_ok(emds_entry_add(&d_entry), "Failed to add dynamic entry");
+
+	for (int i = 0; i < ARRAY_SIZE(id); i++) {
+		zassert_ok(flash_area_open(id[i], &partition[i].fa), "Failed to open flash area %d",
+			   id[i]);
+		zassert_ok(emds_flash_init(&partition[i]), "Failed to initialize flash area %d",
+			   id[i]);
+	}
+
+	return NULL;
+}
+
+static void emds_delta_before(void *fixture)
+{
+	(void)fixture;
+
+	zassert_ok(emds_clear(), "Failed to clear EMDS");
+	data_fill(0x10);
+
+	/* The first prepare writes the current data as the full snapshot */
+	zassert_equal(emds_load(), -ENOENT, "Expected empty partitions");
+	zassert_ok(emds_prepare(), "Failed to prepare EMDS");
+	zassert_true(emds_is_ready(), "EMDS is not ready");
+}
+
+ZTEST(emds_delta, test_delta_store_load)
+{
+	struct emds_snapshot_candidate snapshot;
+	size_t full_size;
+	size_t delta_size;
+	uint32_t store_time;
+
+	zassert_ok(emds_store_size_get(&full_size), "Failed to get store size");
+	zassert_equal(full_size,
+		      3 * ENTRY_STORE_SIZE + DYNAMIC_ENTRY_SIZE + sizeof(struct emds_data_entry),
+		      "Unexpected store size");
+
+	/* The store time estimate covers the entry without dirty tracking, the dirty budget
+	 * and the largest entry with dirty tracking, whether the entries are changed or not.
+	 */
+	delta_size = ENTRY_STORE_SIZE + CONFIG_EMDS_DELTA_DIRTY_BYTES_MAX + DYNAMIC_ENTRY_SIZE +
+		     sizeof(struct emds_data_entry);
+	zassert_true(delta_size < full_size, "Expected a shorter store time than for all entries");
+
+	zassert_ok(emds_store_time_get(&store_time), "Failed to get store time");
+	zassert_equal(store_time, store_time_expected(delta_size), "Unexpected store time");
+
+	memset(s_data[1], 0xa5, ENTRY_SIZE);
+	zassert_ok(emds_entry_dirty_set(0x2), "Failed to mark entry");
+	zassert_equal(emds_entry_dirty_set(0x1234), -ENOENT, "Expected unknown entry");
+
+	zassert_ok(emds_store_time_get(&store_time), "Failed to get store time");
+	zassert_equal(store_time, store_time_expected(delta_size), "Unexpected store time");
+
+	zassert_ok(emds_store(), "Failed to store");
+	zassert_false(emds_is_ready(), "EMDS is still ready");
+
+	snapshot = freshest_snapshot_get();
+	zassert_true(emds_flash_snapshot_is_delta(&snapshot.metadata), "Expected delta snapshot");
+	zassert_equal(snapshot.metadata.base_cnt, snapshot.metadata.fresh_cnt - 1,
+		      "Delta is not chained to the full snapshot");
+	zassert_equal(snapshot.metadata.data_instance_len, 2 * ENTRY_STORE_SIZE,
+		      "Unexpected delta size");
+
+	data_reload();
+
+	data_check(s_data[0], ENTRY_SIZE, 0x10);
+	data_check(s_data[1], ENTRY_SIZE, 0xa5);
+	data_check(s_data[2], ENTRY_SIZE, 0x12);
+	data_check(d_data, DYNAMIC_ENTRY_SIZE, 0x13);
+}
+
+ZTEST(emds_delta, test_delta_untracked_entries_stored)
+{
+	/* Entries without dirty tracking are stored without being marked as dirty, while
+	 * changes of tracked entries not marked as dirty are not a part of the delta.
+	 */
+	memset(s_data[0], 0x5a, ENTRY_SIZE);
+	memset(s_data[2], 0x5b, ENTRY_SIZE);
+	memset(d_data, 0x77, DYNAMIC_ENTRY_SIZE);
+	zassert_ok(emds_entry_dirty_set(0x1), "Failed to mark entry");
+	zassert_ok(emds_entry_dirty_set(DYNAMIC_ENTRY_ID), "Failed to mark entry");
+
+	zassert_ok(emds_store(), "Failed to store");
+
+	data_reload();
+
+	data_check(s_data[0], ENTRY_SIZE, 0x5a);
+	data_check(s_data[2], ENTRY_SIZE, 0x12);
+	data_check(d_data, DYNAMIC_ENTRY_SIZE, 0x77);
+}
+
+ZTEST(emds_delta, test_delta_dirty_budget_compaction)
+{
+	struct emds_snapshot_candidate snapshot;
+	uint32_t base_cnt = freshest_snapshot_get().metadata.fresh_cnt;
+
+	memset(s_data[1], 0x61, ENTRY_SIZE);
+	zassert_ok(emds_entry_dirty_set(0x2), "Failed to mark entry");
+	memset(s_data[2], 0x62, ENTRY_SIZE);
+	zassert_ok(emds_entry_dirty_set(0x3), "Failed to mark entry");
+
+	/* The second entry exceeds the budget and the compaction runs in the system workqueue */
+	k_sleep(K_MSEC(100));
+	zassert_true(emds_is_ready(), "EMDS is not ready after the compaction");
+
+	snapshot = freshest_snapshot_get();
+	zassert_false(emds_flash_snapshot_is_delta(&snapshot.metadata), "Expected full snapshot");
+	zassert_equal(snapshot.metadata.fresh_cnt, base_cnt + 1, "Unexpected fresh_cnt");
+
+	/* The compacted snapshot holds the changes, so only the untracked entry is stored */
+	zassert_ok(emds_store(), "Failed to store");
+
+	snapshot = freshest_snapshot_get();
+	zassert_true(emds_flash_snapshot_is_delta(&snapshot.metadata), "Expected delta snapshot");
+	zassert_equal(snapshot.metadata.base_cnt, base_cnt + 1,
+		      "Delta is not chained to the compacted snapshot");
+	zassert_equal(snapshot.metadata.data_instance_len, ENTRY_STORE_SIZE,
+		      "Unexpected delta size");
+
+	data_reload();
+
+	data_check(s_data[1], ENTRY_SIZE, 0x61);
+	data_check(s_data[2], ENTRY_SIZE, 0x62);
+}
+
+ZTEST(emds_delta, test_delta_broken_chain_load)
+{
+	struct emds_snapshot_candidate snapshot;
+	struct emds_snapshot_candidate broken;
+	uint8_t *flash;
+	size_t flash_size;
+
+	memset(s_data[1], 0x51, ENTRY_SIZE);
+	zassert_ok(emds_entry_dirty_set(0x2), "Failed to mark entry");
+	zassert_ok(emds_store(), "Failed to store");
+	broken = freshest_snapshot_get();
+
+	data_reload();
+	zassert_ok(emds_prepare(), "Failed to prepare EMDS");
+
+	memset(s_data[2], 0x52, ENTRY_SIZE);
+	zassert_ok(emds_entry_dirty_set(0x3), "Failed to mark entry");
+	zassert_ok(emds_store(), "Failed to store");
+	snapshot = freshest_snapshot_get();
+
+	/* Corrupt the data of the first delta */
+	flash = flash_simulator_get_memory(partition[broken.partition_index].fa->fa_dev,
+					   &flash_size);
+	flash[partition[broken.partition_index].fa->fa_off +
+	      broken.metadata.data_instance_off] ^= 0xff;
+
+	/* Only the full snapshot is loaded, since the second delta is chained behind the
+	 * broken one.
+	 */
+	data_reload();
+
+	data_check(s_data[0], ENTRY_SIZE, 0x10);
+	data_check(s_data[1], ENTRY_SIZE, 0x11);
+	data_check(s_data[2], ENTRY_SIZE, 0x12);
+
+	/* The next prepare compacts the loaded data into a new full snapshot */
+	zassert_ok(emds_prepare(), "Failed to prepare EMDS");
+	zassert_equal(freshest_snapshot_get().metadata.fresh_cnt, snapshot.metadata.fresh_cnt + 1,
+		      "Unexpected fresh_cnt");
+	zassert_false(emds_flash_snapshot_is_delta(&freshest_snapshot_get().metadata),
+		      "Expected full snapshot");
+}
+
+ZTEST(emds_delta, test_delta_chain_compaction)
+{
+	struct emds_snapshot_candidate snapshot;
+	uint32_t base_cnt = freshest_snapshot_get().metadata.fresh_cnt;
+
+	for (int i = 1; i <= CONFIG_EMDS_DELTA_CHAIN_MAX; i++) {
+		memset(s_data[i % ARRAY_SIZE(s_data)], 0x40 + i, ENTRY_SIZE);
+		zassert_ok(emds_entry_dirty_set(0x1 + i % ARRAY_SIZE(s_data)),
+			   "Failed to mark entry");
+		zassert_ok(emds_store(), "Failed to store");
+
+		snapshot = freshest_snapshot_get();
+		zassert_true(emds_flash_snapshot_is_delta(&snapshot.metadata),
+			     "Expected delta snapshot");
+		zassert_equal(snapshot.metadata.base_cnt, base_cnt,
+			      "Delta is not chained to the full snapshot");
+		zassert_equal(snapshot.metadata.fresh_cnt, base_cnt + i, "Unexpected fresh_cnt");
+
+		/* Every load applies the whole chain */
+		data_reload();
+		zassert_ok(emds_prepare(), "Failed to prepare EMDS");
+	}
+
+	/* The last prepare has compacted the full chain into a new full snapshot */
+	snapshot = freshest_snapshot_get();
+	zassert_false(emds_flash_snapshot_is_delta(&snapshot.metadata),
+		      "Expected full snapshot");
+	zassert_equal(snapshot.metadata.fresh_cnt, base_cnt + CONFIG_EMDS_DELTA_CHAIN_MAX + 1,
+		      "Unexpected fresh_cnt");
+
+	zassert_ok(emds_store(), "Failed to store");
+
+	snapshot = freshest_snapshot_get();
+	zassert_true(emds_flash_snapshot_is_delta(&snapshot.metadata), "Expected delta snapshot");
+	zassert_equal(snapshot.metadata.base_cnt, base_cnt + CONFIG_EMDS_DELTA_CHAIN_MAX + 1,
+		      "Delta is not chained to the compacted snapshot");
+	zassert_equal(snapshot.metadata.data_instance_len, ENTRY_STORE_SIZE,
+		      "Expected only the untracked entry");
+
+	data_reload();
+
+	data_check(s_data[0], ENTRY_SIZE, 0x43);
+	data_check(s_data[1], ENTRY_SIZE, 0x41);
+	data_check(s_data[2], ENTRY_SIZE, 0x42);
+	data_check(d_data, DYNAMIC_ENTRY_SIZE, 0x13);
+}
+
+ZTEST_SUITE(emds_delta, NULL, emds_delta_setup, emds_delta_before, NULL, NULL);
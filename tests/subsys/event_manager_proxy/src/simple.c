@@ -34,7 +34,12 @@ ZTEST(simple_tests, test_simple_ping_pong)
 
 ZTEST(simple_tests, test_simple_burst)
 {
+	struct event_manager_proxy_stats stats;
 	uint32_t us_spent;
+	int err;
+
+	err = event_manager_proxy_stats_get(REMOTE_IPC_DEV, &stats, true);
+	zassert_ok(err, "Cannot get proxy statistics");
 
 	test_start(TEST_SIMPLE_BURST);
 	test_start_ack_wait();
@@ -52,6 +57,14 @@ ZTEST(simple_tests, test_simple_burst)
 		us_spent;
 	printk(" Time: %u us\n", us_spent);
 	printk(" Test sending simple burst speed %lu msg/sec\n", speed);
+
+	err = event_manager_proxy_stats_get(REMOTE_IPC_DEV, &stats, false);
+	zassert_ok(err, "Cannot get proxy statistics");
+	zassert_true(stats.forwarded >= TEST_CONFIG_SIMPLE_BURST_SIZE, "Events not forwarded");
+	zassert_equal(stats.dropped, 0, "Events dropped");
+
+	printk(" Forwarded %u events in %u messages, latency avg %u us, max %u us\n",
+	       stats.forwarded, stats.messages, stats.latency_avg_us, stats.latency_max_us);
 }
 
 ZTEST(simple_tests, test_simple_burst_from_remote)
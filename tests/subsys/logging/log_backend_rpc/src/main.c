@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <mock_nrf_rpc_transport.h>
+#include <logging/log_rpc.h>
+#include <nrf_rpc_cbor.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_msg.h>
+
+LOG_MODULE_REGISTER(log_backend_rpc_test, LOG_LEVEL_DBG);
+
+/* Command and event IDs of the log_rpc group. */
+#define LOG_RPC_CMD_SET_STREAM_LEVEL 0
+#define LOG_RPC_EVT_MSG		     0
+#define LOG_RPC_EVT_MSG_BATCH	     2
+
+/* Macros for constructing nRF RPC packets for the log_rpc group. */
+
+#define RPC_PKT(bytes...)                                                                          \
+	(mock_nrf_rpc_pkt_t)                                                                       \
+	{                                                                                          \
+		.data = (uint8_t[]){bytes}, .len = sizeof((uint8_t[]){bytes}),                     \
+	}
+
+#define RPC_INIT_REQ RPC_PKT(0x04, 0x00, 0xff, 0x00, 0xff, 0x00, 'l', 'o', 'g')
+#define RPC_INIT_RSP RPC_PKT(0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 'l', 'o', 'g')
+#define RPC_CMD(cmd, ...) RPC_PKT(0x80, cmd, 0xff, 0x00, 0x00 __VA_OPT__(,) __VA_ARGS__, 0xf6)
+#define RPC_RSP(...)	  RPC_PKT(0x01, 0xff, 0x00, 0x00, 0x00 __VA_OPT__(,) __VA_ARGS__, 0xf6)
+#define NO_RSP		  RPC_PKT()
+
+#define EVT_TIMEOUT	K_SECONDS(1)
+#define NO_EVT_TIMEOUT	K_MSEC(100)
+
+static K_SEM_DEFINE(evt_sem, 0, 1);
+static uint8_t evt_id;
+static uint32_t evt_msg_cnt;
+static atomic_t panic_on_error;
+
+/* Captures the log events instead of sending them to the mock transport. */
+int __wrap_nrf_rpc_cbor_evt(const struct nrf_rpc_group *group, uint8_t evt,
+			    struct nrf_rpc_cbor_ctx *ctx)
+{
+	evt_id = evt;
+
+	/* The batch starts with the number of messages, which CBOR encodes in one byte. */
+	evt_msg_cnt = (evt == LOG_RPC_EVT_MSG_BATCH) ? ctx->out_packet[0] : 1;
+
+	NRF_RPC_CBOR_DISCARD(group, *ctx);
+	k_sem_give(&evt_sem);
+
+	return 0;
+}
+
+static void nrf_rpc_err_handler(const struct nrf_rpc_err_report *report)
+{
+	zassert_ok(report->code);
+}
+
+static void *suite_setup(void)
+{
+	mock_nrf_rpc_tr_expect_add(RPC_INIT_REQ, RPC_INIT_RSP);
+	zassert_ok(nrf_rpc_init(nrf_rpc_err_handler));
+	mock_nrf_rpc_tr_expect_done();
+
+	mock_nrf_rpc_tr_expect_add(RPC_RSP(), NO_RSP);
+	mock_nrf_rpc_tr_receive(RPC_CMD(LOG_RPC_CMD_SET_STREAM_LEVEL, LOG_RPC_LEVEL_DBG));
+	mock_nrf_rpc_tr_expect_done();
+
+	return NULL;
+}
+
+static void test_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Discard the messages logged before the test. */
+	log_thread_trigger();
+	k_sleep(NO_EVT_TIMEOUT);
+	k_sem_reset(&evt_sem);
+}
+
+ZTEST(log_backend_rpc, test_batch)
+{
+	LOG_INF("First message");
+	LOG_WRN("Second message");
+	LOG_DBG("Third message");
+	log_thread_trigger();
+
+	zassert_ok(k_sem_take(&evt_sem, EVT_TIMEOUT), "Messages not sent");
+	zassert_equal(evt_id, LOG_RPC_EVT_MSG_BATCH, "Messages not batched");
+	zassert_equal(evt_msg_cnt, 3, "Invalid number of messages in the batch");
+	zassert_equal(k_sem_take(&evt_sem, NO_EVT_TIMEOUT), -EAGAIN, "Unexpected event");
+}
+
+/* Must run last, because the backend stays in the panic mode. */
+ZTEST(log_backend_rpc, test_panic_flush)
+{
+	atomic_set(&panic_on_error, 1);
+
+	LOG_INF("Message before the error");
+	LOG_ERR("Error causing the panic");
+	log_thread_trigger();
+
+	zassert_ok(k_sem_take(&evt_sem, EVT_TIMEOUT), "Batched messages not sent on panic");
+	zassert_equal(evt_id, LOG_RPC_EVT_MSG_BATCH, "Messages not batched");
+	zassert_equal(evt_msg_cnt, 2, "Invalid number of messages in the batch");
+
+	/* The messages logged after the panic are not sent. */
+	LOG_INF("Message after the panic");
+	log_thread_trigger();
+
+	zassert_equal(k_sem_take(&evt_sem, NO_EVT_TIMEOUT), -EAGAIN,
+		      "Message sent in the panic mode");
+}
+
+ZTEST_SUITE(log_backend_rpc, NULL, suite_setup, test_before, NULL, NULL);
+
+/*
+ * Backend that puts the RPC backend in the panic mode, as if a fault occurred while the logging
+ * thread was processing the messages. The backend name sorts after log_backend_rpc, so it
+ * receives each message after the RPC backend.
+ */
+static void panic_trigger_process(const struct log_backend *const backend,
+				  union log_msg_generic *msg)
+{
+	ARG_UNUSED(backend);
+
+	if (log_msg_get_level(&msg->log) == LOG_LEVEL_ERR && atomic_cas(&panic_on_error, 1, 0)) {
+		log_backend_panic(log_backend_get_by_name("log_backend_rpc"));
+	}
+}
+
+static void panic_trigger_panic(const struct log_backend *const backend)
+{
+	ARG_UNUSED(backend);
+}
+
+static const struct log_backend_api panic_trigger_api = {
+	.process = panic_trigger_process,
+	.panic = panic_trigger_panic,
+};
+
+LOG_BACKEND_DEFINE(panic_trigger_backend, panic_trigger_api, true);
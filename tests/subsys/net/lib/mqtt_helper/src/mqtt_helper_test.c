@@ -49,6 +49,7 @@ extern void mqtt_evt_handler(struct mqtt_client *const mqtt_client,
 			     const struct mqtt_evt *mqtt_evt);
 extern void mqtt_helper_poll_loop(void);
 extern void on_publish(const struct mqtt_evt *mqtt_evt);
+extern void outbox_clear(void);
 extern char payload_buf[];
 
 /* Semaphores used by tests to wait for a certain callbacks */
@@ -60,6 +61,14 @@ static K_SEM_DEFINE(suback_sem, 0, 1);
 static K_SEM_DEFINE(publish_sem, 0, 1);
 static K_SEM_DEFINE(error_msg_size_sem, 0, 1);
 
+/* Chunks received by the on_publish_chunk callback. */
+static size_t chunk_count;
+static size_t chunk_bytes;
+
+/* Message ID expected to be sent again from the outbox. */
+static uint16_t resend_message_id;
+static size_t resend_count;
+
 void setUp(void)
 {
 	__cmock_mqtt_keepalive_time_left_IgnoreAndReturn(0);
@@ -74,6 +83,8 @@ void setUp(void)
 	while (UINT16_MAX != mqtt_helper_msg_id_get()) {
 		/* Do nothing */
 	};
+
+	outbox_clear();
 }
 
 /* Stubs */
@@ -85,6 +96,32 @@ static int mqtt_readall_publish_payload_stub(struct mqtt_client *client, uint8_t
 	return 0;
 }
 
+static int mqtt_readall_publish_payload_chunk_stub(struct mqtt_client *client, uint8_t *buffer,
+						   size_t length, int num_calls)
+{
+	/* Every chunk is filled with its sequence number. */
+	memset(buffer, num_calls, length);
+
+	return 0;
+}
+
+static int mqtt_publish_resend_stub(struct mqtt_client *client,
+				    const struct mqtt_publish_param *param, int num_calls)
+{
+	TEST_ASSERT_EQUAL(resend_message_id, param->message_id);
+	TEST_ASSERT_EQUAL(1, param->dup_flag);
+	TEST_ASSERT_EQUAL(MQTT_QOS_1_AT_LEAST_ONCE, param->message.topic.qos);
+	TEST_ASSERT_EQUAL(TEST_TOPIC_2_LEN, param->message.topic.topic.size);
+	TEST_ASSERT_EQUAL_MEMORY(TEST_TOPIC_2, param->message.topic.topic.utf8,
+				 TEST_TOPIC_2_LEN);
+	TEST_ASSERT_EQUAL(TEST_PAYLOAD_LEN, param->message.payload.len);
+	TEST_ASSERT_EQUAL_MEMORY(TEST_PAYLOAD, param->message.payload.data, TEST_PAYLOAD_LEN);
+
+	resend_count++;
+
+	return 0;
+}
+
 static int poll_stub_pollin(struct pollfd *fds, int nfds, int timeout, int num_calls)
 {
 	fds[0].revents = fds[0].events & POLLIN;
@@ -185,6 +222,27 @@ static void cb_on_publish(struct mqtt_helper_buf topic, struct mqtt_helper_buf p
 	k_sem_give(&publish_sem);
 }
 
+static void cb_on_publish_chunk(struct mqtt_helper_buf topic, struct mqtt_helper_buf chunk,
+				size_t offset, size_t total_len)
+{
+	TEST_ASSERT_EQUAL(TEST_TOPIC_1_LEN, topic.size);
+	TEST_ASSERT_EQUAL_MEMORY(TEST_TOPIC_1, topic.ptr, TEST_TOPIC_1_LEN);
+	TEST_ASSERT_EQUAL(chunk_bytes, offset);
+	TEST_ASSERT_TRUE(chunk.size <= CONFIG_MQTT_HELPER_PAYLOAD_BUFFER_LEN);
+	TEST_ASSERT_TRUE(offset + chunk.size <= total_len);
+
+	for (size_t i = 0; i < chunk.size; i++) {
+		TEST_ASSERT_EQUAL((char)chunk_count, chunk.ptr[i]);
+	}
+
+	chunk_count++;
+	chunk_bytes += chunk.size;
+
+	if (chunk_bytes == total_len) {
+		k_sem_give(&publish_sem);
+	}
+}
+
 static void cb_on_connack(enum mqtt_conn_return_code return_code, bool session_present)
 {
 	switch (return_code) {
@@ -628,6 +686,195 @@ void test_mqtt_helper_poll_loop_pollerr(void)
 	mqtt_helper_poll_loop();
 }
 
+static void init_with_cfg(struct mqtt_helper_cfg *cfg)
+{
+	__cmock_mqtt_client_init_Expect(&mqtt_client);
+
+	TEST_ASSERT_EQUAL(0, mqtt_helper_init(cfg));
+}
+
+static void publish_qos1(uint16_t message_id, const char *topic, int expected_err)
+{
+	struct mqtt_publish_param pub_param = {
+		.message = {
+			.payload = {
+				.data = TEST_PAYLOAD,
+				.len = TEST_PAYLOAD_LEN,
+			},
+			.topic = {
+				.topic = {
+					.utf8 = (const uint8_t *)topic,
+					.size = strlen(topic),
+				},
+				.qos = MQTT_QOS_1_AT_LEAST_ONCE,
+			},
+		},
+		.message_id = message_id,
+	};
+
+	TEST_ASSERT_EQUAL(expected_err, mqtt_helper_publish(&pub_param));
+}
+
+static void reconnect(void)
+{
+	mqtt_state = MQTT_STATE_CONNECTING;
+
+	send_mqtt_event(MQTT_EVT_CONNACK, MQTT_CONNECTION_ACCEPTED);
+
+	TEST_ASSERT_EQUAL(0, k_sem_take(&connack_success_sem, K_SECONDS(1)));
+}
+
+void test_on_publish_chunked(void)
+{
+	const size_t payload_len = 2 * CONFIG_MQTT_HELPER_PAYLOAD_BUFFER_LEN + 10;
+	struct mqtt_helper_cfg cfg = {
+		.cb = {
+			.on_publish_chunk = cb_on_publish_chunk,
+		},
+	};
+	struct mqtt_evt evt = {
+		.type = MQTT_EVT_PUBLISH,
+		.param.publish = {
+			.message = {
+				.topic = {
+					.topic = {
+						.utf8 = TEST_TOPIC_1,
+						.size = TEST_TOPIC_1_LEN,
+					},
+					.qos = MQTT_QOS_1_AT_LEAST_ONCE,
+				},
+				.payload.len = payload_len,
+			},
+			.message_id = TEST_MESSAGE_ID,
+		},
+	};
+
+	mqtt_state = MQTT_STATE_DISCONNECTED;
+	init_with_cfg(&cfg);
+
+	chunk_count = 0;
+	chunk_bytes = 0;
+
+	__cmock_mqtt_readall_publish_payload_Stub(mqtt_readall_publish_payload_chunk_stub);
+	__cmock_mqtt_publish_qos1_ack_ExpectAnyArgsAndReturn(0);
+
+	mqtt_evt_handler(&mqtt_client, &evt);
+
+	TEST_ASSERT_EQUAL(0, k_sem_take(&publish_sem, K_SECONDS(1)));
+	TEST_ASSERT_EQUAL(3, chunk_count);
+	TEST_ASSERT_EQUAL(payload_len, chunk_bytes);
+}
+
+void test_outbox_resend_after_reconnect(void)
+{
+	struct mqtt_helper_cfg cfg = {
+		.cb = {
+			.on_connack = cb_on_connack,
+		},
+	};
+
+	mqtt_state = MQTT_STATE_DISCONNECTED;
+	init_with_cfg(&cfg);
+	mqtt_state = MQTT_STATE_CONNECTED;
+
+	__cmock_mqtt_publish_ExpectAnyArgsAndReturn(0);
+	__cmock_mqtt_publish_ExpectAnyArgsAndReturn(0);
+
+	publish_qos1(TEST_MESSAGE_ID, TEST_TOPIC_1, 0);
+	publish_qos1(TEST_MESSAGE_ID + 1, TEST_TOPIC_2, 0);
+
+	/* Only the message that has not been acknowledged is sent again. */
+	send_mqtt_event(MQTT_EVT_PUBACK, TEST_MESSAGE_ID);
+
+	resend_message_id = TEST_MESSAGE_ID + 1;
+	resend_count = 0;
+	__cmock_mqtt_publish_Stub(mqtt_publish_resend_stub);
+
+	reconnect();
+	TEST_ASSERT_EQUAL(1, resend_count);
+
+	/* The message is kept in the outbox until it is acknowledged. */
+	reconnect();
+	TEST_ASSERT_EQUAL(2, resend_count);
+
+	send_mqtt_event(MQTT_EVT_PUBACK, TEST_MESSAGE_ID + 1);
+
+	/* Nothing is sent when the outbox is empty. */
+	reconnect();
+	TEST_ASSERT_EQUAL(2, resend_count);
+}
+
+void test_outbox_full(void)
+{
+	mqtt_state = MQTT_STATE_CONNECTED;
+
+	__cmock_mqtt_publish_ExpectAnyArgsAndReturn(0);
+	__cmock_mqtt_publish_ExpectAnyArgsAndReturn(0);
+
+	publish_qos1(TEST_MESSAGE_ID, TEST_TOPIC_1, 0);
+	publish_qos1(TEST_MESSAGE_ID + 1, TEST_TOPIC_1, 0);
+	publish_qos1(TEST_MESSAGE_ID + 2, TEST_TOPIC_1, -ENOMEM);
+
+	/* An acknowledgment frees an entry. */
+	send_mqtt_event(MQTT_EVT_PUBACK, TEST_MESSAGE_ID);
+
+	__cmock_mqtt_publish_ExpectAnyArgsAndReturn(0);
+
+	publish_qos1(TEST_MESSAGE_ID + 2, TEST_TOPIC_1, 0);
+}
+
+void test_outbox_message_too_large(void)
+{
+	uint8_t payload[CONFIG_MQTT_HELPER_OUTBOX_MSG_SIZE] = { 0 };
+	struct mqtt_publish_param pub_param = {
+		.message = {
+			.payload = {
+				.data = payload,
+				.len = sizeof(payload),
+			},
+			.topic = {
+				.topic = {
+					.utf8 = TEST_TOPIC_1,
+					.size = TEST_TOPIC_1_LEN,
+				},
+				.qos = MQTT_QOS_1_AT_LEAST_ONCE,
+			},
+		},
+		.message_id = TEST_MESSAGE_ID,
+	};
+
+	mqtt_state = MQTT_STATE_CONNECTED;
+
+	TEST_ASSERT_EQUAL(-EMSGSIZE, mqtt_helper_publish(&pub_param));
+
+	/* QoS 0 messages are not stored in the outbox. */
+	pub_param.message.topic.qos = MQTT_QOS_0_AT_MOST_ONCE;
+
+	__cmock_mqtt_publish_ExpectAndReturn(&mqtt_client, &pub_param, 0);
+
+	TEST_ASSERT_EQUAL(0, mqtt_helper_publish(&pub_param));
+}
+
+void test_outbox_publish_error(void)
+{
+	struct mqtt_helper_cfg cfg = {
+		.cb = {
+			.on_connack = cb_on_connack,
+		},
+	};
+
+	mqtt_state = MQTT_STATE_DISCONNECTED;
+	init_with_cfg(&cfg);
+	mqtt_state = MQTT_STATE_CONNECTED;
+
+	__cmock_mqtt_publish_ExpectAnyArgsAndReturn(-EIO);
+
+	publish_qos1(TEST_MESSAGE_ID, TEST_TOPIC_1, -EIO);
+
+	/* A message that failed to be sent is not sent again. */
+	reconnect();
+}
+
 void test_mqtt_helper_msg_id_get_returns_valid_ids(void)
 {
 	for (int i = 1; i == UINT16_MAX; i++) {
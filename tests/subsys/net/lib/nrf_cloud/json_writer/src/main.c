@@ -0,0 +1,503 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <net/nrf_cloud.h>
+#include <net/nrf_cloud_codec.h>
+#include <net/nrf_cloud_alert.h>
+#include <net/nrf_cloud_location.h>
+#include <net/nrf_cloud_os.h>
+#include <cJSON.h>
+
+#include "nrf_cloud_codec_internal.h"
+#include "nrf_cloud_json_writer.h"
+
+#define BENCH_ITERATIONS 100
+
+static char buf[1024];
+static size_t alloc_count;
+
+static void *counting_malloc(size_t size)
+{
+	alloc_count++;
+	return k_malloc(size);
+}
+
+static void *counting_calloc(size_t count, size_t size)
+{
+	alloc_count++;
+	return k_calloc(count, size);
+}
+
+static struct nrf_cloud_os_mem_hooks hooks = {
+	.malloc_fn = counting_malloc,
+	.calloc_fn = counting_calloc,
+	.free_fn = k_free,
+};
+
+static const struct nrf_cloud_gnss_pvt test_pvt = {
+	.lat = 61.49372,
+	.lon = 23.77254,
+	.accuracy = 12.3f,
+	.alt = 121.7f,
+	.has_alt = 1,
+	.speed = 0.1f,
+	.has_speed = 1,
+	.heading = 275.55f,
+	.has_heading = 1,
+};
+
+static struct lte_lc_ncell test_ncells[] = {
+	{ .earfcn = 6400, .phys_cell_id = 10, .rsrp = 50, .rsrq = -3, .time_diff = 24 },
+	{ .earfcn = 6400, .phys_cell_id = 11, .rsrp = LTE_LC_CELL_RSRP_INVALID,
+	  .rsrq = LTE_LC_CELL_RSRQ_INVALID, .time_diff = LTE_LC_CELL_TIME_DIFF_INVALID },
+};
+
+static struct lte_lc_cell test_gci_cells[] = {
+	{ .mcc = 244, .mnc = 91, .id = 0x1234567, .tac = 0x1f, .earfcn = 1300,
+	  .timing_advance = 65535, .rsrp = 30, .rsrq = 20 },
+};
+
+static struct wifi_scan_result test_aps[] = {
+	{ .mac = { 0x40, 0x9b, 0xcd, 0x01, 0x02, 0x03 }, .rssi = -40, .channel = 6,
+	  .ssid = "office", .ssid_length = 6 },
+	/* Local MAC, not included */
+	{ .mac = { 0x42, 0x9b, 0xcd, 0x01, 0x02, 0x04 }, .rssi = -50, .channel = 1 },
+	{ .mac = { 0x10, 0x20, 0x30, 0x40, 0x50, 0x60 }, .rssi = INT8_MAX, .channel = 0,
+	  .ssid = "quote\"d\\", .ssid_length = 8 },
+};
+
+static void *setup(void)
+{
+	/* Count the allocations made by cJSON and the library */
+	nrf_cloud_os_mem_hooks_init(&hooks);
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	alloc_count = 0;
+}
+
+ZTEST_SUITE(nrf_cloud_json_writer, NULL, setup, before, NULL, NULL);
+
+/* Write into the static buffer and return the output, or NULL on error */
+#define WRITE(_fn, ...)									\
+	({										\
+		struct nrf_cloud_json_writer _w;					\
+											\
+		nrf_cloud_json_writer_init(&_w, buf, sizeof(buf));			\
+		(_fn(&_w, __VA_ARGS__) == 0) ? buf : NULL;				\
+	})
+
+static void assert_same(char *expected, const char *actual)
+{
+	zassert_not_null(expected);
+	zassert_not_null(actual);
+	zassert_str_equal(expected, actual, "expected: %s, actual: %s", expected, actual);
+	cJSON_free(expected);
+}
+
+static char *cjson_print(cJSON *obj)
+{
+	char *str = cJSON_PrintUnformatted(obj);
+
+	cJSON_Delete(obj);
+	return str;
+}
+
+ZTEST(nrf_cloud_json_writer, test_numbers)
+{
+	const double values[] = {
+		0.0, -0.0, 1.0, -1.0, 42.0, 0.5, 0.1, 1.0 / 3.0, -273.15, 1e-7, 2.5e-308,
+		(double)INT_MAX, (double)INT_MIN, (double)INT_MAX + 1.0, (double)INT_MIN - 1.0,
+		1700000000123.0, 9007199254740993.0, 1e21, -1.7976931348623157e308,
+		(double)12.3f, (double)275.55f, NAN, INFINITY, -INFINITY,
+	};
+
+	for (size_t i = 0; i < ARRAY_SIZE(values); i++) {
+		struct nrf_cloud_json_writer w;
+		cJSON *obj = cJSON_CreateObject();
+
+		cJSON_AddNumberToObject(obj, "n", values[i]);
+
+		nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+		nrf_cloud_json_obj_start(&w, NULL);
+		nrf_cloud_json_num_add(&w, "n", values[i]);
+		nrf_cloud_json_obj_end(&w);
+		zassert_ok(nrf_cloud_json_writer_done(&w));
+
+		assert_same(cjson_print(obj), buf);
+	}
+}
+
+ZTEST(nrf_cloud_json_writer, test_strings)
+{
+	char str[128];
+	struct nrf_cloud_json_writer w;
+	cJSON *arr = cJSON_CreateArray();
+
+	/* All ASCII characters, including those that must be escaped */
+	for (int i = 0; i < (sizeof(str) - 1); i++) {
+		str[i] = (char)(i + 1);
+	}
+	str[sizeof(str) - 1] = '\0';
+
+	cJSON_AddItemToArray(arr, cJSON_CreateString(str));
+	cJSON_AddItemToArray(arr, cJSON_CreateString(""));
+	cJSON_AddItemToArray(arr, cJSON_CreateString("\xc3\xa4\xe2\x82\xac/"));
+	cJSON_AddItemToArray(arr, cJSON_CreateTrue());
+	cJSON_AddItemToArray(arr, cJSON_CreateObject());
+	cJSON_AddItemToArray(arr, cJSON_CreateArray());
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_arr_start(&w, NULL);
+	nrf_cloud_json_str_add(&w, NULL, str);
+	nrf_cloud_json_str_add(&w, NULL, "");
+	nrf_cloud_json_str_add(&w, NULL, "\xc3\xa4\xe2\x82\xac/");
+	nrf_cloud_json_bool_add(&w, NULL, true);
+	nrf_cloud_json_obj_start(&w, NULL);
+	nrf_cloud_json_obj_end(&w);
+	nrf_cloud_json_arr_start(&w, NULL);
+	nrf_cloud_json_arr_end(&w);
+	nrf_cloud_json_arr_end(&w);
+	zassert_ok(nrf_cloud_json_writer_done(&w));
+
+	assert_same(cjson_print(arr), buf);
+}
+
+ZTEST(nrf_cloud_json_writer, test_buffer_too_small)
+{
+	struct nrf_cloud_data expected;
+	struct nrf_cloud_json_writer w;
+	char small[16];
+	const struct nrf_cloud_sensor_data sensor = {
+		.type = NRF_CLOUD_SENSOR_TEMP,
+		.data = { .ptr = "23.5" },
+		.ts_ms = NRF_CLOUD_NO_TIMESTAMP,
+	};
+
+	zassert_ok(nrf_cloud_sensor_data_encode(&sensor, &expected));
+
+	/* Only the length is computed without a buffer */
+	nrf_cloud_json_writer_init(&w, NULL, 0);
+	zassert_ok(nrf_cloud_sensor_data_json_write(&w, &sensor));
+	zassert_equal(w.len, expected.len);
+
+	/* The required length is known after a failed attempt */
+	nrf_cloud_json_writer_init(&w, small, sizeof(small));
+	zassert_equal(nrf_cloud_sensor_data_json_write(&w, &sensor), -ENOMEM);
+	zassert_equal(w.len, expected.len);
+	zassert_equal(strlen(small), sizeof(small) - 1);
+
+	/* Exact size allocation for the second pass */
+	nrf_cloud_json_writer_init(&w, NULL, 0);
+	zassert_ok(nrf_cloud_sensor_data_json_write(&w, &sensor));
+	zassert_ok(nrf_cloud_json_writer_alloc(&w));
+	zassert_ok(nrf_cloud_sensor_data_json_write(&w, &sensor));
+	zassert_str_equal(w.buf, expected.ptr);
+	cJSON_free(w.buf);
+
+	assert_same((char *)expected.ptr, WRITE(nrf_cloud_sensor_data_json_write, &sensor));
+}
+
+ZTEST(nrf_cloud_json_writer, test_nesting)
+{
+	struct nrf_cloud_json_writer w;
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	for (int i = 0; i < NRF_CLOUD_JSON_WRITER_DEPTH_MAX; i++) {
+		nrf_cloud_json_arr_start(&w, NULL);
+	}
+	zassert_equal(nrf_cloud_json_writer_done(&w), -E2BIG);
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_obj_start(&w, NULL);
+	zassert_equal(nrf_cloud_json_writer_done(&w), -EINVAL);
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_obj_end(&w);
+	zassert_equal(nrf_cloud_json_writer_done(&w), -EINVAL);
+}
+
+ZTEST(nrf_cloud_json_writer, test_sensor_data)
+{
+	struct nrf_cloud_sensor_data sensor = {
+		.data = { .ptr = "line 1\nline \"2\"\t\\" },
+	};
+	const int64_t timestamps[] = { NRF_CLOUD_NO_TIMESTAMP, 1, 1700000000123LL, -5 };
+
+	for (int type = NRF_CLOUD_SENSOR_GNSS; type <= NRF_CLOUD_SENSOR_LIGHT; type++) {
+		for (size_t i = 0; i < ARRAY_SIZE(timestamps); i++) {
+			struct nrf_cloud_data expected;
+
+			sensor.type = type;
+			sensor.ts_ms = timestamps[i];
+
+			zassert_ok(nrf_cloud_sensor_data_encode(&sensor, &expected));
+			assert_same((char *)expected.ptr,
+				    WRITE(nrf_cloud_sensor_data_json_write, &sensor));
+		}
+	}
+}
+
+ZTEST(nrf_cloud_json_writer, test_alert)
+{
+	const float values[] = { NRF_CLOUD_ALERT_UNUSED_VALUE, 0.0f, 3.14159f, -40.25f, 1e9f };
+	const char *descriptions[] = { NULL, "", "Temperature \"high\"" };
+	struct nrf_cloud_alert_info alert = {
+		.type = ALERT_TYPE_TEMPERATURE,
+		.sequence = 7,
+	};
+
+	for (size_t i = 0; i < ARRAY_SIZE(values); i++) {
+		for (size_t j = 0; j < ARRAY_SIZE(descriptions); j++) {
+			struct nrf_cloud_data expected;
+
+			alert.value = values[i];
+			alert.description = descriptions[j];
+			alert.ts_ms = (j == 1) ? NRF_CLOUD_NO_TIMESTAMP : 1700000000123LL;
+
+			zassert_ok(nrf_cloud_alert_encode(&alert, &expected));
+			assert_same((char *)expected.ptr,
+				    WRITE(nrf_cloud_alert_json_write, &alert));
+		}
+	}
+}
+
+ZTEST(nrf_cloud_json_writer, test_log)
+{
+	char msg[] = "Sensor 0x2a: value\r\n";
+	struct nrf_cloud_log_context contexts[] = {
+		{ .dom_id = 0, .level = 3, .src_name = "main", .ts = 1700000000123LL,
+		  .sequence = 1 },
+		{ .dom_id = 1, .level = 1, .src_name = NULL, .ts = 0, .sequence = 4000000000U },
+	};
+
+	for (size_t i = 0; i < ARRAY_SIZE(contexts); i++) {
+		struct nrf_cloud_data expected;
+
+		zassert_ok(nrf_cloud_log_json_encode(&contexts[i], (uint8_t *)msg, strlen(msg),
+						     &expected));
+		assert_same((char *)expected.ptr,
+			    WRITE(nrf_cloud_log_json_write, &contexts[i], msg));
+	}
+}
+
+static void assert_gnss_same(const struct nrf_cloud_gnss_data *const gnss)
+{
+	cJSON *obj = cJSON_CreateObject();
+	struct nrf_cloud_json_writer w;
+	int expected_err;
+	int err;
+
+	expected_err = nrf_cloud_gnss_msg_json_encode(gnss, obj);
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	err = nrf_cloud_gnss_msg_json_write(&w, gnss);
+
+	zassert_equal(err, expected_err);
+	if (expected_err) {
+		cJSON_Delete(obj);
+		return;
+	}
+
+	assert_same(cjson_print(obj), buf);
+}
+
+ZTEST(nrf_cloud_json_writer, test_gnss)
+{
+	struct nrf_cloud_gnss_data gnss = {
+		.type = NRF_CLOUD_GNSS_TYPE_PVT,
+		.ts_ms = 1700000000123LL,
+		.pvt = test_pvt,
+	};
+	char long_nmea[NRF_MODEM_GNSS_NMEA_MAX_LEN + 1];
+
+	assert_gnss_same(&gnss);
+
+	gnss.ts_ms = NRF_CLOUD_NO_TIMESTAMP;
+	gnss.pvt.has_alt = 0;
+	gnss.pvt.has_heading = 0;
+	assert_gnss_same(&gnss);
+
+	gnss.type = NRF_CLOUD_GNSS_TYPE_NMEA;
+	gnss.nmea.sentence = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47";
+	assert_gnss_same(&gnss);
+
+	/* Errors are the same */
+	memset(long_nmea, 'A', sizeof(long_nmea));
+	gnss.nmea.sentence = long_nmea;
+	assert_gnss_same(&gnss);
+
+	gnss.nmea.sentence = NULL;
+	assert_gnss_same(&gnss);
+
+	gnss.type = NRF_CLOUD_GNSS_TYPE_INVALID;
+	assert_gnss_same(&gnss);
+}
+
+static void assert_location_same(const struct lte_lc_cells_info *const cells,
+				 const struct wifi_scan_info *const wifi,
+				 const struct nrf_cloud_location_config *const config)
+{
+	NRF_CLOUD_OBJ_JSON_DEFINE(obj);
+	struct nrf_cloud_json_writer w;
+	int expected_err;
+	int err;
+
+	expected_err = nrf_cloud_obj_location_request_create(&obj, cells, wifi, config);
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	err = nrf_cloud_location_req_json_write(&w, cells, wifi, config);
+
+	zassert_equal(err, expected_err);
+	if (expected_err) {
+		return;
+	}
+
+	assert_same(cjson_print(obj.json), buf);
+}
+
+ZTEST(nrf_cloud_json_writer, test_location_request)
+{
+	struct lte_lc_cells_info cells = {
+		.current_cell = {
+			.mcc = 244, .mnc = 1, .id = 0x1234, .tac = 0x9876, .earfcn = 6400,
+			.timing_advance = 80, .rsrp = 45, .rsrq = 12,
+		},
+		.ncells_count = ARRAY_SIZE(test_ncells),
+		.neighbor_cells = test_ncells,
+	};
+	struct wifi_scan_info wifi = {
+		.ap_info = test_aps,
+		.cnt = ARRAY_SIZE(test_aps),
+	};
+	const struct nrf_cloud_location_config config = {
+		.do_reply = false,
+		.hi_conf = true,
+		.fallback = true,
+	};
+
+	assert_location_same(&cells, NULL, NULL);
+	assert_location_same(&cells, &wifi, NULL);
+	assert_location_same(NULL, &wifi, &config);
+
+	/* GCI cells only */
+	cells.current_cell.id = LTE_LC_CELL_EUTRAN_ID_INVALID;
+	cells.gci_cells_count = ARRAY_SIZE(test_gci_cells);
+	cells.gci_cells = test_gci_cells;
+	assert_location_same(&cells, NULL, &config);
+
+	/* No cells, the request is Wi-Fi only */
+	cells.gci_cells_count = 0;
+	assert_location_same(&cells, &wifi, NULL);
+	assert_location_same(&cells, NULL, NULL);
+
+	/* Too few APs with a non-local MAC, the request is cellular only */
+	wifi.cnt = 2;
+	cells.current_cell.id = 0x1234;
+	assert_location_same(&cells, &wifi, NULL);
+
+	/* Too few APs and no cells */
+	cells.current_cell.id = LTE_LC_CELL_EUTRAN_ID_INVALID;
+	assert_location_same(&cells, &wifi, NULL);
+	wifi.cnt = 1;
+	assert_location_same(NULL, &wifi, NULL);
+	assert_location_same(NULL, NULL, NULL);
+}
+
+/* Allocations and cycles per message for both encoders */
+
+struct bench_result {
+	uint32_t allocs;
+	uint32_t cycles;
+};
+
+static void bench_print(const char *name, struct bench_result *cjson,
+			struct bench_result *writer)
+{
+	TC_PRINT("%-8s cJSON: %3u allocs, %6u cycles; writer: %3u allocs, %6u cycles\n",
+		 name, cjson->allocs, cjson->cycles, writer->allocs, writer->cycles);
+}
+
+#define BENCH(_result, _body)								\
+	do {										\
+		uint32_t _start;							\
+											\
+		alloc_count = 0;							\
+		_start = k_cycle_get_32();						\
+		for (int _i = 0; _i < BENCH_ITERATIONS; _i++) {				\
+			_body;								\
+		}									\
+		(_result)->cycles = (k_cycle_get_32() - _start) / BENCH_ITERATIONS;	\
+		(_result)->allocs = alloc_count / BENCH_ITERATIONS;			\
+	} while (0)
+
+ZTEST(nrf_cloud_json_writer, test_benchmark)
+{
+	struct bench_result cjson;
+	struct bench_result writer;
+	struct nrf_cloud_data out;
+	const struct nrf_cloud_sensor_data sensor = {
+		.type = NRF_CLOUD_SENSOR_TEMP,
+		.data = { .ptr = "23.5" },
+		.ts_ms = 1700000000123LL,
+	};
+	const struct nrf_cloud_alert_info alert = {
+		.type = ALERT_TYPE_TEMPERATURE,
+		.value = 31.5f,
+		.description = "Temperature above threshold",
+		.sequence = 3,
+		.ts_ms = 1700000000123LL,
+	};
+	const struct nrf_cloud_gnss_data gnss = {
+		.type = NRF_CLOUD_GNSS_TYPE_PVT,
+		.ts_ms = 1700000000123LL,
+		.pvt = test_pvt,
+	};
+
+	BENCH(&cjson, {
+		zassert_ok(nrf_cloud_sensor_data_encode(&sensor, &out));
+		cJSON_free((void *)out.ptr);
+	});
+	BENCH(&writer, {
+		zassert_not_null(WRITE(nrf_cloud_sensor_data_json_write, &sensor));
+	});
+	bench_print("sensor", &cjson, &writer);
+	zassert_equal(writer.allocs, 0);
+	zassert_true(cjson.allocs > 1);
+
+	BENCH(&cjson, {
+		zassert_ok(nrf_cloud_alert_encode(&alert, &out));
+		cJSON_free((void *)out.ptr);
+	});
+	BENCH(&writer, {
+		zassert_not_null(WRITE(nrf_cloud_alert_json_write, &alert));
+	});
+	bench_print("alert", &cjson, &writer);
+	zassert_equal(writer.allocs, 0);
+
+	BENCH(&cjson, {
+		cJSON *obj = cJSON_CreateObject();
+
+		zassert_ok(nrf_cloud_gnss_msg_json_encode(&gnss, obj));
+		cJSON_free(cjson_print(obj));
+	});
+	BENCH(&writer, {
+		zassert_not_null(WRITE(nrf_cloud_gnss_msg_json_write, &gnss));
+	});
+	bench_print("gnss", &cjson, &writer);
+	zassert_equal(writer.allocs, 0);
+}
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Maps the partition manager flash area macros to the devicetree partitions
+ * listed in the test's pm_config.h.
+ */
+#ifndef FLASH_MAP_PM_H_
+#define FLASH_MAP_PM_H_
+
+#include <pm_config.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/storage/flash_map.h>
+
+#define PM_LABEL(label) UTIL_CAT(PM_, UTIL_CAT(label, _LABEL))
+
+#define FLASH_AREA_ID(label) FIXED_PARTITION_ID(PM_LABEL(label))
+#define FLASH_AREA_DEVICE(label) FIXED_PARTITION_DEVICE(PM_LABEL(label))
+
+#endif /* FLASH_MAP_PM_H_*/
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRFX_NVMC_H__
+#define NRFX_NVMC_H__
+
+#include <stdint.h>
+
+/* There is no NVMC on native_sim; the P-GPS library then uses its default page size. */
+static inline uint32_t nrfx_nvmc_flash_page_size_get(void)
+{
+	return 0;
+}
+
+#endif /* NRFX_NVMC_H__ */
@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Partition manager is not used on native_sim. The P-GPS storage is placed in the
+ * devicetree partition of the MCUboot secondary slot.
+ */
+#ifndef PM_CONFIG_H__
+#define PM_CONFIG_H__
+#define PM_MCUBOOT_SECONDARY_LABEL slot1_partition
+#define PM_MCUBOOT_SECONDARY_ADDRESS FIXED_PARTITION_OFFSET(slot1_partition)
+#define PM_MCUBOOT_SECONDARY_SIZE FIXED_PARTITION_SIZE(slot1_partition)
+#endif /* PM_CONFIG_H__ */
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <date_time.h>
+#include <net/downloader.h>
+#include <net/nrf_cloud_agnss.h>
+#include <nrf_cloud_download.h>
+#include <zephyr/fff.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Fake functions declaration */
+FAKE_VALUE_FUNC(int, date_time_now, int64_t *);
+FAKE_VALUE_FUNC(int, nrf_cloud_agnss_process, const char *, size_t);
+FAKE_VOID_FUNC(nrf_cloud_agnss_processed, struct nrf_modem_gnss_agnss_data_frame *);
+FAKE_VALUE_FUNC(int, downloader_init, struct downloader *, struct downloader_cfg *);
+FAKE_VALUE_FUNC(int, downloader_cancel, struct downloader *);
+FAKE_VALUE_FUNC(int, nrf_cloud_download_start, struct nrf_cloud_download_data *);
+FAKE_VOID_FUNC(nrf_cloud_download_end);
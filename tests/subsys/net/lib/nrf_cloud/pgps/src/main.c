@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stddef.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+#include <net/nrf_cloud_pgps.h>
+
+#include "nrf_cloud_pgps_schema_v1.h"
+#include "nrf_cloud_pgps_utils.h"
+#include "fakes.h"
+
+#define PERIOD_MIN		240
+#define PERIOD_SEC		(PERIOD_MIN * SEC_PER_MIN)
+#define START_GPS_DAY		16000
+#define START_GPS_SEC		((int64_t)START_GPS_DAY * SEC_PER_DAY)
+/* The library looks up the prediction for the current time shifted by this amount. */
+#define MIDPOINT_SHIFT_SEC	(120 * SEC_PER_MIN)
+#define DL_FRAGMENT_SIZE	512
+#define DL_SIZE			(sizeof(struct nrf_cloud_pgps_header) + \
+				 NUM_PREDICTIONS * PGPS_PREDICTION_DL_SIZE)
+
+static const struct flash_area *fa;
+static uint8_t dl_buf[DL_SIZE];
+static uint8_t page_buf[4096];
+static int64_t lookup_gps_sec;
+static struct nrf_cloud_pgps_prediction *available_prediction;
+static bool ready;
+
+static int date_time_now_custom_fake_lookup(int64_t *unix_time_ms)
+{
+	*unix_time_ms = (lookup_gps_sec - MIDPOINT_SHIFT_SEC - (int64_t)GPS_TO_UTC_LEAP_SECONDS +
+			 (int64_t)GPS_TO_UNIX_UTC_OFFSET_SECONDS) * MSEC_PER_SEC;
+
+	return 0;
+}
+
+static void pgps_event_handler(struct nrf_cloud_pgps_event *event)
+{
+	switch (event->type) {
+	case PGPS_EVT_AVAILABLE:
+		available_prediction = event->prediction;
+		break;
+	case PGPS_EVT_READY:
+		ready = true;
+		break;
+	default:
+		break;
+	}
+}
+
+static void pgps_init(void)
+{
+	struct nrf_cloud_pgps_init_param param = {
+		.event_handler = pgps_event_handler,
+	};
+
+	available_prediction = NULL;
+	zassert_ok(nrf_cloud_pgps_init(&param), "Failed to initialize P-GPS");
+}
+
+static void time_set(int pnum)
+{
+	lookup_gps_sec = START_GPS_SEC + (int64_t)pnum * PERIOD_SEC + SEC_PER_MIN;
+}
+
+static void prediction_fill(struct nrf_cloud_pgps_prediction *p, int pnum)
+{
+	int64_t gps_sec = START_GPS_SEC + (int64_t)pnum * PERIOD_SEC;
+
+	memset(p, 0, sizeof(*p));
+
+	p->time_type = NRF_CLOUD_AGNSS_GPS_SYSTEM_CLOCK;
+	p->time_count = 1;
+	p->time.date_day = gps_sec / SEC_PER_DAY;
+	p->time.time_full_s = gps_sec % SEC_PER_DAY;
+	p->schema_version = NRF_CLOUD_AGNSS_BIN_SCHEMA_VERSION;
+	p->ephemeris_type = NRF_CLOUD_AGNSS_GPS_EPHEMERIDES;
+	p->ephemeris_count = NRF_CLOUD_PGPS_NUM_SV;
+
+	for (int i = 0; i < NRF_CLOUD_PGPS_NUM_SV; i++) {
+		p->ephemerii[i].sv_id = i + 1;
+		p->ephemerii[i].iodc = pnum + 1;
+	}
+
+	p->sentinel = (uint32_t)gps_sec;
+}
+
+/* Build the downloaded P-GPS data: the header followed by the predictions without the
+ * schema version and sentinel, which are only added to the stored predictions.
+ */
+static void dl_buf_fill(void)
+{
+	struct nrf_cloud_pgps_header header = {
+		.schema_version = NRF_CLOUD_PGPS_BIN_SCHEMA_VERSION,
+		.array_type = NRF_CLOUD_PGPS_PREDICTION_HEADER,
+		.num_items = 1,
+		.prediction_count = NUM_PREDICTIONS,
+		.prediction_size = PGPS_PREDICTION_DL_SIZE,
+		.prediction_period_min = PERIOD_MIN,
+		.gps_day = START_GPS_DAY,
+		.gps_time_of_day = 0,
+	};
+	struct nrf_cloud_pgps_prediction p;
+	uint8_t *pos = dl_buf;
+
+	memcpy(pos, &header, sizeof(header));
+	pos += sizeof(header);
+
+	for (int pnum = 0; pnum < NUM_PREDICTIONS; pnum++) {
+		prediction_fill(&p, pnum);
+
+		memcpy(pos, &p, offsetof(struct nrf_cloud_pgps_prediction, schema_version));
+		pos += offsetof(struct nrf_cloud_pgps_prediction, schema_version);
+		memcpy(pos, &p.ephemeris_type,
+		       offsetof(struct nrf_cloud_pgps_prediction, sentinel) -
+		       offsetof(struct nrf_cloud_pgps_prediction, ephemeris_type));
+		pos += offsetof(struct nrf_cloud_pgps_prediction, sentinel) -
+		       offsetof(struct nrf_cloud_pgps_prediction, ephemeris_type);
+	}
+
+	zassert_equal((size_t)(pos - dl_buf), sizeof(dl_buf), "Unexpected download size");
+}
+
+static void predictions_download(void)
+{
+	size_t len;
+
+	dl_buf_fill();
+	ready = false;
+
+	zassert_ok(nrf_cloud_pgps_begin_update(), "Failed to begin update");
+
+	for (size_t off = 0; off < sizeof(dl_buf); off += len) {
+		len = MIN(DL_FRAGMENT_SIZE, sizeof(dl_buf) - off);
+		zassert_ok(nrf_cloud_pgps_process_update(&dl_buf[off], len),
+			   "Failed to process data at offset %zu", off);
+	}
+
+	zassert_ok(nrf_cloud_pgps_finish_update(), "Failed to finish update");
+	zassert_true(ready, "Predictions are not ready");
+}
+
+static void prediction_check(const struct nrf_cloud_pgps_prediction *p, int pnum)
+{
+	struct nrf_cloud_pgps_prediction expected;
+
+	prediction_fill(&expected, pnum);
+	zassert_mem_equal(p, &expected, sizeof(expected), "Prediction num:%d differs", pnum);
+}
+
+static void prediction_find_check(int pnum)
+{
+	struct nrf_cloud_pgps_prediction *p;
+
+	time_set(pnum);
+	zassert_equal(nrf_cloud_pgps_find_prediction(&p), pnum, "Prediction num:%d not found",
+		      pnum);
+	prediction_check(p, pnum);
+}
+
+/* Flip all bits of a stored byte. The flash page is rewritten, as flash cannot be
+ * overwritten without erasing it first.
+ */
+static void flash_byte_flip(int pnum, size_t pred_off)
+{
+	/* Predictions are stored in the blocks allocated in order from the first one. */
+	off_t off = pnum * PGPS_PREDICTION_STORAGE_SIZE + pred_off;
+	struct flash_pages_info info;
+	off_t page_off;
+
+	zassert_ok(flash_get_page_info_by_offs(flash_area_get_device(fa), fa->fa_off + off,
+					       &info), "Failed to get page info");
+	zassert_true(info.size <= sizeof(page_buf), "Unexpected page size");
+	page_off = info.start_offset - fa->fa_off;
+
+	zassert_ok(flash_area_read(fa, page_off, page_buf, info.size), "Failed to read");
+	page_buf[off - page_off] ^= 0xff;
+	zassert_ok(flash_area_erase(fa, page_off, info.size), "Failed to erase");
+	zassert_ok(flash_area_write(fa, page_off, page_buf, info.size), "Failed to write");
+}
+
+ZTEST(nrf_cloud_pgps, test_update)
+{
+	struct nrf_cloud_pgps_prediction *p;
+
+	/* Downloaded predictions are found using the RAM directory and read back once */
+	for (int pnum = 0; pnum < NUM_PREDICTIONS; pnum++) {
+		prediction_find_check(pnum);
+	}
+
+	time_set(NUM_PREDICTIONS + 1);
+	zassert_equal(nrf_cloud_pgps_find_prediction(&p), -ETIMEDOUT, "Expected expired data");
+	zassert_is_null(p, "Unexpected prediction");
+}
+
+ZTEST(nrf_cloud_pgps, test_directory_rebuilt_on_init)
+{
+	/* The directory is rebuilt from flash, as after a reboot */
+	time_set(0);
+	pgps_init();
+
+	zassert_not_null(available_prediction, "No prediction available after init");
+	prediction_check(available_prediction, 0);
+
+	for (int pnum = 0; pnum < NUM_PREDICTIONS; pnum++) {
+		prediction_find_check(pnum);
+	}
+}
+
+ZTEST(nrf_cloud_pgps, test_changed_prediction_detected)
+{
+	struct nrf_cloud_pgps_prediction *p;
+
+	/* Change the prediction after it has been validated, so only its CRC differs */
+	flash_byte_flip(1, offsetof(struct nrf_cloud_pgps_prediction, ephemerii) +
+			   offsetof(struct nrf_cloud_agnss_ephemeris, iodc));
+
+	prediction_find_check(0);
+
+	time_set(1);
+	zassert_equal(nrf_cloud_pgps_find_prediction(&p), -EINVAL, "Expected changed prediction");
+	zassert_is_null(p, "Unexpected prediction");
+
+	prediction_find_check(2);
+}
+
+ZTEST(nrf_cloud_pgps, test_invalid_prediction_on_init)
+{
+	struct nrf_cloud_pgps_prediction *p;
+
+	flash_byte_flip(2, offsetof(struct nrf_cloud_pgps_prediction, sentinel));
+
+	/* The set is incomplete, so the found prediction is not reported as available */
+	time_set(0);
+	pgps_init();
+	zassert_is_null(available_prediction, "Unexpected available prediction");
+
+	prediction_find_check(0);
+	prediction_find_check(1);
+
+	time_set(2);
+	zassert_equal(nrf_cloud_pgps_find_prediction(&p), -EINVAL, "Expected invalid prediction");
+	zassert_is_null(p, "Unexpected prediction");
+
+	prediction_find_check(3);
+}
+
+static void *nrf_cloud_pgps_setup(void)
+{
+	date_time_now_fake.custom_fake = date_time_now_custom_fake_lookup;
+
+	zassert_ok(flash_area_open(FIXED_PARTITION_ID(storage_partition), &fa),
+		   "Failed to open settings storage");
+	zassert_ok(flash_area_erase(fa, 0, fa->fa_size), "Failed to erase settings storage");
+	flash_area_close(fa);
+
+	zassert_ok(flash_area_open(FIXED_PARTITION_ID(slot1_partition), &fa),
+		   "Failed to open P-GPS storage");
+
+	return NULL;
+}
+
+static void nrf_cloud_pgps_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Start each test from an empty storage and a complete download */
+	zassert_ok(flash_area_erase(fa, 0, NUM_PREDICTIONS * PGPS_PREDICTION_STORAGE_SIZE),
+		   "Failed to erase P-GPS storage");
+
+	time_set(0);
+	pgps_init();
+	predictions_download();
+}
+
+ZTEST_SUITE(nrf_cloud_pgps, NULL, nrf_cloud_pgps_setup, nrf_cloud_pgps_before, NULL, NULL);
@@ -0,0 +1,462 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <net/nrf_cloud.h>
+#include <net/nrf_cloud_codec.h>
+#include <net/nrf_cloud_alert.h>
+#include <net/nrf_cloud_log.h>
+#include <net/nrf_cloud_os.h>
+#include <cJSON.h>
+
+#include "nrf_cloud_codec_internal.h"
+#include "nrf_cloud_shadow_scan.h"
+
+#define BENCH_CONFIG_KEYS 40
+/* Keeps allocations aligned for the double in cJSON items */
+#define HDR_SIZE 8
+
+static size_t alloc_count;
+static size_t heap_used;
+static size_t heap_peak;
+
+static void *counting_malloc(size_t size)
+{
+	uint8_t *ptr = k_malloc(size + HDR_SIZE);
+
+	if (!ptr) {
+		return NULL;
+	}
+
+	*(size_t *)ptr = size;
+	alloc_count++;
+	heap_used += size;
+	heap_peak = MAX(heap_peak, heap_used);
+
+	return ptr + HDR_SIZE;
+}
+
+static void *counting_calloc(size_t count, size_t size)
+{
+	void *ptr = counting_malloc(count * size);
+
+	if (ptr) {
+		memset(ptr, 0, count * size);
+	}
+
+	return ptr;
+}
+
+static void counting_free(void *ptr)
+{
+	uint8_t *hdr = (uint8_t *)ptr - HDR_SIZE;
+
+	if (!ptr) {
+		return;
+	}
+
+	heap_used -= *(size_t *)hdr;
+	k_free(hdr);
+}
+
+static struct nrf_cloud_os_mem_hooks hooks = {
+	.malloc_fn = counting_malloc,
+	.calloc_fn = counting_calloc,
+	.free_fn = counting_free,
+};
+
+/* Shadow documents as received from nRF Cloud */
+struct shadow_doc {
+	enum nrf_cloud_shadow_scan_doc type;
+	const char *json;
+};
+
+static const struct shadow_doc docs[] = {
+	/* Control delta, as sent when the log level is changed in the portal */
+	{ NRF_CLOUD_SHADOW_SCAN_DOC_DELTA,
+	  "{\"version\":153,\"timestamp\":1700000123,"
+	  "\"state\":{\"control\":{\"logLvl\":3}},"
+	  "\"metadata\":{\"control\":{\"logLvl\":{\"timestamp\":1700000123}}}}" },
+	/* Control delta with both settings */
+	{ NRF_CLOUD_SHADOW_SCAN_DOC_DELTA,
+	  "{\"version\":154,\"timestamp\":1700000200,"
+	  "\"state\":{\"control\":{\"alertsEn\":true,\"logLvl\":1}},"
+	  "\"metadata\":{\"control\":{\"alertsEn\":{\"timestamp\":1700000200},"
+	  "\"logLvl\":{\"timestamp\":1700000200}}}}" },
+	/* Control delta with invalid values */
+	{ NRF_CLOUD_SHADOW_SCAN_DOC_DELTA,
+	  "{\"version\":155,\"timestamp\":1700000300,"
+	  "\"state\":{\"control\":{\"alertsEn\":\"yes\",\"logLvl\":2}}}" },
+	{ NRF_CLOUD_SHADOW_SCAN_DOC_DELTA,
+	  "{\"version\":156,\"timestamp\":1700000400,"
+	  "\"state\":{\"control\":{\"logLvl\":7}}}" },
+	/* Association complete */
+	{ NRF_CLOUD_SHADOW_SCAN_DOC_DELTA,
+	  "{\"version\":2,\"timestamp\":1700000010,\"state\":{"
+	  "\"pairing\":{\"state\":\"paired\",\"topics\":{"
+	  "\"d2c\":\"prod/a1b2c3d4/m/d/nrf-352656100000000/d2c\","
+	  "\"c2d\":\"prod/a1b2c3d4/m/d/nrf-352656100000000/+/r\"}},"
+	  "\"nrfcloud_mqtt_topic_prefix\":\"prod/a1b2c3d4/\"}}" },
+	/* Application config delta */
+	{ NRF_CLOUD_SHADOW_SCAN_DOC_DELTA,
+	  "{ \"version\" : 7, \"timestamp\" : 1700000500, \"state\" : {\n"
+	  "  \"config\" : { \"activeMode\" : true, \"locationTimeout\" : 300,\n"
+	  "    \"name\" : \"tracker \\\"A\\\" \\u00e4\", \"nod\" : [ ],\n"
+	  "    \"thresholds\" : [ 1.5, -2, 3e2, { \"x\" : null } ] },\n"
+	  "  \"led\" : { \"on\" : false } } }" },
+	/* CoAP delta without the state object */
+	{ NRF_CLOUD_SHADOW_SCAN_DOC_DELTA_STATE,
+	  "{\"control\":{\"alertsEn\":false,\"logLvl\":4}}" },
+	{ NRF_CLOUD_SHADOW_SCAN_DOC_DELTA_STATE,
+	  "{\"config\":{\"activeMode\":true,\"activeWaitTime\":120,\"movementResolution\":120,"
+	  "\"movementTimeout\":3600,\"accThreshAct\":4,\"accThreshInact\":4,"
+	  "\"accTimeoutInact\":60,\"nod\":[\"gnss\"]},\"control\":{\"alertsEn\":true}}" },
+	/* The first "control" key is used, regardless of case */
+	{ NRF_CLOUD_SHADOW_SCAN_DOC_DELTA_STATE,
+	  "{\"Control\":{\"logLvl\":2},\"control\":{\"logLvl\":3}}" },
+	/* Accepted trimmed shadow */
+	{ NRF_CLOUD_SHADOW_SCAN_DOC_ACCEPTED,
+	  "{\"desired\":{\"control\":{\"alertsEn\":false,\"logLvl\":4},\"led\":{\"on\":true}},"
+	  "\"reported\":{\"device\":{\"deviceInfo\":{\"appVersion\":\"1.0.0\","
+	  "\"modemFirmware\":\"mfw_nrf9160_1.3.5\"},\"networkInfo\":{\"currentBand\":20}},"
+	  "\"control\":{\"alertsEn\":true,\"logLvl\":0}},"
+	  "\"config\":{\"activeMode\":false,\"locationTimeout\":300}}" },
+	/* Control only in the reported section */
+	{ NRF_CLOUD_SHADOW_SCAN_DOC_ACCEPTED,
+	  "{\"desired\":{},\"reported\":{\"control\":{\"alertsEn\":true,\"logLvl\":2}}}" },
+};
+
+/* Decode the shadow document like the MQTT and CoAP transports do */
+static void tree_decode(const struct shadow_doc *doc,
+			struct nrf_cloud_obj_shadow_accepted *accepted,
+			struct nrf_cloud_obj_shadow_delta *delta,
+			struct nrf_cloud_obj_shadow_data *data)
+{
+	const struct nrf_cloud_data in = { .ptr = doc->json, .len = strlen(doc->json) };
+
+	NRF_CLOUD_OBJ_JSON_DEFINE(obj);
+
+	memset(accepted, 0, sizeof(*accepted));
+	memset(delta, 0, sizeof(*delta));
+
+	if (doc->type == NRF_CLOUD_SHADOW_SCAN_DOC_DELTA_STATE) {
+		delta->state.type = NRF_CLOUD_OBJ_TYPE_JSON;
+		zassert_ok(nrf_cloud_obj_input_decode(&delta->state, &in));
+		data->type = NRF_CLOUD_OBJ_SHADOW_TYPE_DELTA;
+		data->delta = delta;
+		return;
+	}
+
+	zassert_ok(nrf_cloud_obj_input_decode(&obj, &in));
+
+	if (doc->type == NRF_CLOUD_SHADOW_SCAN_DOC_DELTA) {
+		zassert_ok(nrf_cloud_obj_shadow_delta_decode(&obj, delta));
+		data->type = NRF_CLOUD_OBJ_SHADOW_TYPE_DELTA;
+		data->delta = delta;
+	} else {
+		zassert_ok(nrf_cloud_obj_shadow_accepted_decode(&obj, accepted));
+		data->type = NRF_CLOUD_OBJ_SHADOW_TYPE_ACCEPTED;
+		data->accepted = accepted;
+	}
+
+	(void)nrf_cloud_obj_free(&obj);
+}
+
+static void tree_free(struct nrf_cloud_obj_shadow_accepted *accepted,
+		      struct nrf_cloud_obj_shadow_delta *delta)
+{
+	nrf_cloud_obj_shadow_accepted_free(accepted);
+	nrf_cloud_obj_shadow_delta_free(delta);
+}
+
+static void result_check(const struct shadow_doc *doc,
+			 const struct nrf_cloud_shadow_scan_result *scan)
+{
+	struct nrf_cloud_obj_shadow_accepted accepted;
+	struct nrf_cloud_obj_shadow_delta delta;
+	struct nrf_cloud_obj_shadow_data data;
+	struct nrf_cloud_ctrl_data ctrl = { .alerts_enabled = false, .log_level = -1 };
+	struct nrf_cloud_obj ctrl_obj = {0};
+	const cJSON *state;
+	int err;
+
+	tree_decode(doc, &accepted, &delta, &data);
+
+	if (doc->type == NRF_CLOUD_SHADOW_SCAN_DOC_DELTA) {
+		zassert_true(scan->ver_found && scan->ts_found);
+		zassert_equal(scan->ver, delta.ver);
+		zassert_equal(scan->ts, delta.ts);
+	}
+
+	err = nrf_cloud_shadow_control_get(&data, &ctrl_obj);
+	zassert_equal(scan->ctrl_found, (err == 0), "%s", doc->json);
+
+	if (!err) {
+		err = nrf_cloud_shadow_control_decode(&ctrl_obj, &ctrl);
+		zassert_equal(scan->ctrl_invalid, (err == -EINVAL), "%s", doc->json);
+
+		if (!err) {
+			zassert_equal(scan->log_found, (ctrl.log_level != -1));
+			if (scan->log_found) {
+				zassert_equal(scan->log_level, ctrl.log_level);
+			}
+			if (scan->alerts_found) {
+				zassert_equal(scan->alerts_enabled, ctrl.alerts_enabled);
+			}
+		}
+
+		(void)nrf_cloud_obj_free(&ctrl_obj);
+	}
+
+	/* The control section has been detached from the state */
+	state = (data.type == NRF_CLOUD_OBJ_SHADOW_TYPE_DELTA) ? delta.state.json :
+								 accepted.desired.json;
+	zassert_equal(scan->state_found, (state != NULL));
+	zassert_equal(scan->state_items, cJSON_GetArraySize(state), "%s", doc->json);
+
+	tree_free(&accepted, &delta);
+}
+
+static void device_control_reset(void)
+{
+	nrf_cloud_alert_control_set(false);
+	nrf_cloud_log_control_set(LOG_LEVEL_WRN);
+}
+
+static void control_process_check(const struct shadow_doc *doc,
+				  const struct nrf_cloud_shadow_scan_result *scan)
+{
+	struct nrf_cloud_obj_shadow_accepted accepted;
+	struct nrf_cloud_obj_shadow_delta delta;
+	struct nrf_cloud_obj_shadow_data data;
+	struct nrf_cloud_data tree_out = {0};
+	struct nrf_cloud_data scan_out = {0};
+	struct nrf_cloud_ctrl_data tree_ctrl;
+	struct nrf_cloud_ctrl_data scan_ctrl;
+	int tree_err;
+	int scan_err;
+
+	tree_decode(doc, &accepted, &delta, &data);
+	device_control_reset();
+	tree_err = nrf_cloud_shadow_control_process(&data, &tree_out);
+	nrf_cloud_device_control_get(&tree_ctrl);
+	tree_free(&accepted, &delta);
+
+	device_control_reset();
+	scan_err = nrf_cloud_shadow_control_scan_process(
+		scan, (doc->type != NRF_CLOUD_SHADOW_SCAN_DOC_ACCEPTED), &scan_out);
+	nrf_cloud_device_control_get(&scan_ctrl);
+
+	zassert_equal(scan_err, tree_err, "%s", doc->json);
+	zassert_equal(scan_ctrl.alerts_enabled, tree_ctrl.alerts_enabled);
+	zassert_equal(scan_ctrl.log_level, tree_ctrl.log_level);
+
+	if (tree_out.ptr) {
+		zassert_not_null(scan_out.ptr);
+		zassert_str_equal(scan_out.ptr, tree_out.ptr);
+	} else {
+		zassert_is_null(scan_out.ptr);
+	}
+
+	nrf_cloud_free((void *)tree_out.ptr);
+	nrf_cloud_free((void *)scan_out.ptr);
+}
+
+static void *setup(void)
+{
+	/* Count the allocations made by cJSON and the library */
+	nrf_cloud_os_mem_hooks_init(&hooks);
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	alloc_count = 0;
+	heap_peak = heap_used;
+}
+
+ZTEST_SUITE(nrf_cloud_shadow_scan, NULL, setup, before, NULL, NULL);
+
+ZTEST(nrf_cloud_shadow_scan, test_captured_docs)
+{
+	struct nrf_cloud_shadow_scan_result scan;
+
+	for (size_t i = 0; i < ARRAY_SIZE(docs); i++) {
+		alloc_count = 0;
+
+		zassert_ok(nrf_cloud_shadow_scan(docs[i].json, strlen(docs[i].json), docs[i].type,
+						 &scan));
+		zassert_equal(alloc_count, 0);
+
+		result_check(&docs[i], &scan);
+		control_process_check(&docs[i], &scan);
+	}
+}
+
+ZTEST(nrf_cloud_shadow_scan, test_not_null_terminated)
+{
+	const char *json = docs[1].json;
+	char *copy = k_malloc(strlen(json));
+	struct nrf_cloud_shadow_scan_result scan;
+
+	zassert_not_null(copy);
+	memcpy(copy, json, strlen(json));
+
+	zassert_ok(nrf_cloud_shadow_scan(copy, strlen(json), NRF_CLOUD_SHADOW_SCAN_DOC_DELTA, &scan));
+	zassert_true(scan.ctrl_found);
+	zassert_equal(scan.log_level, 1);
+
+	/* Truncated document */
+	zassert_equal(nrf_cloud_shadow_scan(copy, strlen(json) - 1,
+					    NRF_CLOUD_SHADOW_SCAN_DOC_DELTA, &scan),
+		      -EBADMSG);
+
+	k_free(copy);
+}
+
+ZTEST(nrf_cloud_shadow_scan, test_invalid_docs)
+{
+	const char *invalid[] = {
+		"",
+		"   ",
+		"{",
+		"{\"a\":1,}",
+		"{\"a\" 1}",
+		"{\"a\":[1 2]}",
+		"{\"a\":tru}",
+		"{\"a\":\"\\x\"}",
+		"{\"a\":\"\\ud800\"}",
+		"{\"a\":\"\\udc00\"}",
+		"{\"a\":\"unterminated}",
+		"{\"a\":}",
+		"[1,]",
+		"{\"a\":1]",
+	};
+	struct nrf_cloud_shadow_scan_result scan;
+
+	for (size_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+		cJSON *root = cJSON_Parse(invalid[i]);
+
+		/* Invalid for both, so the scan never handles what cJSON rejects */
+		zassert_is_null(root, "%s", invalid[i]);
+		zassert_equal(nrf_cloud_shadow_scan(invalid[i], strlen(invalid[i]),
+						    NRF_CLOUD_SHADOW_SCAN_DOC_DELTA_STATE, &scan),
+			      -EBADMSG, "%s", invalid[i]);
+	}
+}
+
+ZTEST(nrf_cloud_shadow_scan, test_limits)
+{
+	const char *escaped_key = "{\"contr\\u006fl\":{}}";
+	char json[2 * (NRF_CLOUD_SHADOW_SCAN_DEPTH_MAX + 1) + 1];
+	struct nrf_cloud_shadow_scan_result scan;
+
+	/* Maximum nesting depth */
+	for (int depth = NRF_CLOUD_SHADOW_SCAN_DEPTH_MAX;
+	     depth <= NRF_CLOUD_SHADOW_SCAN_DEPTH_MAX + 1; depth++) {
+		memset(json, '[', depth);
+		memset(&json[depth], ']', depth);
+		json[2 * depth] = '\0';
+
+		if (depth == NRF_CLOUD_SHADOW_SCAN_DEPTH_MAX) {
+			zassert_ok(nrf_cloud_shadow_scan(json, strlen(json),
+							 NRF_CLOUD_SHADOW_SCAN_DOC_DELTA, &scan));
+			zassert_equal(scan.depth_max, NRF_CLOUD_SHADOW_SCAN_DEPTH_MAX);
+		} else {
+			zassert_equal(nrf_cloud_shadow_scan(json, strlen(json),
+							    NRF_CLOUD_SHADOW_SCAN_DOC_DELTA, &scan),
+				      -E2BIG);
+		}
+	}
+
+	/* Keys with escape sequences are matched by cJSON, but not compared by the scan */
+	zassert_equal(nrf_cloud_shadow_scan(escaped_key, strlen(escaped_key),
+					    NRF_CLOUD_SHADOW_SCAN_DOC_DELTA_STATE, &scan),
+		      -ENOTSUP);
+}
+
+/* Delta with many config keys and per-key metadata, as for a large application config */
+static char *large_delta_create(bool config)
+{
+	const size_t size = 6144;
+	char *json = k_malloc(size);
+	size_t len;
+
+	zassert_not_null(json);
+
+	len = snprintf(json, size, "{\"version\":812,\"timestamp\":1700001000,\"state\":{%s",
+		       config ? "\"config\":{" : "");
+	for (int i = 0; config && (i < BENCH_CONFIG_KEYS); i++) {
+		len += snprintf(&json[len], size - len, "%s\"setting%02d\":%d", i ? "," : "",
+				i, i * 10);
+	}
+	len += snprintf(&json[len], size - len,
+			"%s\"control\":{\"alertsEn\":true,\"logLvl\":3}},\"metadata\":{",
+			config ? "}," : "");
+	for (int i = 0; i < BENCH_CONFIG_KEYS; i++) {
+		len += snprintf(&json[len], size - len,
+				"%s\"setting%02d\":{\"timestamp\":1700001000}", i ? "," : "", i);
+	}
+	len += snprintf(&json[len], size - len, "}}");
+	zassert_true(len < size);
+
+	return json;
+}
+
+ZTEST(nrf_cloud_shadow_scan, test_memory)
+{
+	struct nrf_cloud_obj_shadow_accepted accepted;
+	struct nrf_cloud_obj_shadow_delta delta;
+	struct nrf_cloud_obj_shadow_data data;
+	struct nrf_cloud_shadow_scan_result scan;
+	size_t tree_allocs;
+	size_t tree_peak;
+	uint32_t tree_cycles;
+	uint32_t scan_cycles;
+	uint32_t start;
+
+	for (int i = 0; i < 2; i++) {
+		char *json = large_delta_create(i == 1);
+		const struct shadow_doc doc = { NRF_CLOUD_SHADOW_SCAN_DOC_DELTA, json };
+		size_t base = heap_used;
+
+		alloc_count = 0;
+		heap_peak = base;
+		start = k_cycle_get_32();
+		tree_decode(&doc, &accepted, &delta, &data);
+		tree_cycles = k_cycle_get_32() - start;
+		tree_free(&accepted, &delta);
+		tree_allocs = alloc_count;
+		tree_peak = heap_peak - base;
+
+		alloc_count = 0;
+		heap_peak = base;
+		start = k_cycle_get_32();
+		zassert_ok(nrf_cloud_shadow_scan(json, strlen(json), doc.type, &scan));
+		scan_cycles = k_cycle_get_32() - start;
+
+		TC_PRINT("%zu byte delta: cJSON: %zu allocs, %zu bytes peak, %u cycles; "
+			 "scan: %zu allocs, %zu bytes peak, %u cycles\n",
+			 strlen(json), tree_allocs, tree_peak, tree_cycles,
+			 alloc_count, heap_peak - base, scan_cycles);
+
+		zassert_equal(alloc_count, 0);
+		zassert_equal(heap_peak, base);
+		zassert_true(tree_allocs > BENCH_CONFIG_KEYS);
+		zassert_true(scan.ctrl_found);
+		/* Only the control delta can be handled without decoding it */
+		zassert_equal(scan.state_items, (i == 1) ? 1 : 0);
+		zassert_equal(scan.depth_max, 3);
+
+		k_free(json);
+	}
+}
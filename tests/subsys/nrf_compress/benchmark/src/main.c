@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <nrf_compress/implementation.h>
+#include <nrf_compress/lz4.h>
+
+#if defined(CONFIG_EXTERNAL_LIBC)
+#include <time.h>
+#endif
+
+#define BENCHMARK_ROUNDS 10
+#define LARGE_CHUNK_SIZE 4096
+
+/* The image is optimized for size like a bootloader, so comparing the results with and without
+ * CONFIG_NRF_COMPRESS_LZMA_OPTIMIZE_SPEED shows the gain of building the decoder with -O2.
+ */
+#if defined(CONFIG_NRF_COMPRESS_LZMA_OPTIMIZE_SPEED)
+#define LZMA_DECODER_BUILD "-O2 decoder"
+#else
+#define LZMA_DECODER_BUILD "-Os decoder"
+#endif
+
+/* Input valid lzma2 compressed data, the decompressed text is the corpus for all benchmarks */
+static const uint8_t lzma_input[] = {
+#include "dummy_data_input.inc"
+};
+
+#define CORPUS_SIZE 66477
+
+static uint8_t corpus[CORPUS_SIZE];
+static uint8_t lz4_input[NRF_COMPRESS_LZ4_COMPRESS_BOUND(CORPUS_SIZE)];
+static size_t lz4_input_size;
+static uint8_t output_data[NRF_COMPRESS_LZ4_COMPRESS_BOUND(CORPUS_SIZE)];
+
+static uint64_t benchmark_time_ns(void)
+{
+#if defined(CONFIG_EXTERNAL_LIBC)
+	/* Simulated time does not advance while code runs on native_sim, use the host clock */
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+#else
+	return k_cyc_to_ns_floor64(k_cycle_get_64());
+#endif
+}
+
+/* The RAM figure is not measured. For LZ4 it is the size of the buffers allocated on
+ * initialization. The LZMA decoder sizes its buffers from the stream properties, so the minimum
+ * heap size required in malloc mode is reported instead.
+ */
+static void report(const char *name, size_t bytes, uint64_t ns, const char *ram_name, size_t ram)
+{
+	uint64_t rate;
+
+	if (ns == 0) {
+		TC_PRINT("%s: %zu bytes in less than 1 ns, %s %zu bytes\n", name, bytes, ram_name,
+			 ram);
+		return;
+	}
+
+	/* In hundredths of MB/s */
+	rate = (uint64_t)bytes * 100000 / ns;
+
+	TC_PRINT("%s: %llu.%02llu MB/s, %s %zu bytes\n", name, rate / 100, rate % 100, ram_name,
+		 ram);
+}
+
+static size_t stream(uint16_t type, bool compress, const uint8_t *input, size_t input_size,
+		     size_t chunk_size, size_t output_limit, uint8_t *output,
+		     size_t output_capacity)
+{
+	struct nrf_compress_implementation *implementation;
+	size_t total_output_size = 0;
+	size_t pos = 0;
+	uint32_t offset;
+	uint8_t *data;
+	size_t data_size;
+	bool last_part;
+	int rc;
+
+	implementation = nrf_compress_implementation_find(type);
+	zassert_not_null(implementation, "Expected implementation to not be NULL");
+
+	rc = implementation->init(NULL, output_limit);
+	zassert_ok(rc, "Expected init to be successful");
+
+	while (pos < input_size) {
+		size_t size = MIN(chunk_size, input_size - pos);
+
+		last_part = (pos + size) == input_size;
+
+		if (compress) {
+			rc = implementation->compress(NULL, &input[pos], size, last_part, &offset,
+						      &data, &data_size);
+		} else {
+			rc = implementation->decompress(NULL, &input[pos], size, last_part,
+							&offset, &data, &data_size);
+		}
+
+		zassert_ok(rc, "Expected data to be processed at %zu", pos);
+
+		if (data_size > 0) {
+			zassert_true(total_output_size + data_size <= output_capacity,
+				     "Expected output to fit in the buffer");
+			memcpy(&output[total_output_size], data, data_size);
+			total_output_size += data_size;
+		}
+
+		pos += offset;
+	}
+
+	rc = implementation->deinit(NULL);
+	zassert_ok(rc, "Expected deinit to be successful");
+
+	return total_output_size;
+}
+
+static void *benchmark_setup(void)
+{
+	size_t size;
+
+	size = stream(NRF_COMPRESS_TYPE_LZMA, false, lzma_input, sizeof(lzma_input),
+		      LARGE_CHUNK_SIZE, sizeof(corpus), corpus, sizeof(corpus));
+	zassert_equal(size, sizeof(corpus), "Expected decompressed corpus size to match");
+
+	lz4_input_size = stream(NRF_COMPRESS_TYPE_LZ4, true, corpus, sizeof(corpus),
+				LARGE_CHUNK_SIZE, sizeof(corpus), lz4_input, sizeof(lz4_input));
+
+	return NULL;
+}
+
+static void lzma_decompression_run(size_t chunk_size)
+{
+	char name[64];
+	uint64_t start;
+	uint64_t ns;
+	size_t size;
+
+	start = benchmark_time_ns();
+
+	for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+		size = stream(NRF_COMPRESS_TYPE_LZMA, false, lzma_input, sizeof(lzma_input),
+			      chunk_size, sizeof(corpus), output_data, sizeof(output_data));
+		zassert_equal(size, sizeof(corpus), "Expected decompressed size to match");
+	}
+
+	ns = benchmark_time_ns() - start;
+
+	zassert_mem_equal(output_data, corpus, sizeof(corpus), "Expected data to match");
+
+	snprintk(name, sizeof(name), "LZMA decompression, " LZMA_DECODER_BUILD ", %zu byte chunks",
+		 chunk_size);
+	report(name, BENCHMARK_ROUNDS * sizeof(corpus), ns, "malloc mode minimum heap",
+	       CONFIG_NRF_COMPRESS_MIN_MEMORY_REQUIRED);
+}
+
+ZTEST(nrf_compress_benchmark, test_lzma_decompression)
+{
+	lzma_decompression_run(CONFIG_NRF_COMPRESS_CHUNK_SIZE);
+	lzma_decompression_run(LARGE_CHUNK_SIZE);
+}
+
+ZTEST(nrf_compress_benchmark, test_lz4_compression)
+{
+	uint64_t start;
+	uint64_t ns;
+	size_t size;
+
+	start = benchmark_time_ns();
+
+	for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+		size = stream(NRF_COMPRESS_TYPE_LZ4, true, corpus, sizeof(corpus),
+			      CONFIG_NRF_COMPRESS_CHUNK_SIZE, sizeof(corpus), output_data,
+			      sizeof(output_data));
+		zassert_equal(size, lz4_input_size, "Expected compressed size to match");
+	}
+
+	ns = benchmark_time_ns() - start;
+
+	/* The output must not depend on how the input is split */
+	zassert_mem_equal(output_data, lz4_input, lz4_input_size, "Expected data to match");
+	zassert_true(lz4_input_size < sizeof(corpus), "Expected corpus to be compressed");
+
+	TC_PRINT("LZ4 compression ratio: %zu -> %zu bytes (%zu%%), %d byte blocks\n",
+		 sizeof(corpus), lz4_input_size, lz4_input_size * 100 / sizeof(corpus),
+		 CONFIG_NRF_COMPRESS_LZ4_BLOCK_SIZE);
+	report("LZ4 compression", BENCHMARK_ROUNDS * sizeof(corpus), ns, "buffer RAM",
+	       NRF_COMPRESS_LZ4_COMPRESS_MEMORY_SIZE);
+}
+
+ZTEST(nrf_compress_benchmark, test_lz4_decompression)
+{
+	uint64_t start;
+	uint64_t ns;
+	size_t size;
+
+	start = benchmark_time_ns();
+
+	for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+		size = stream(NRF_COMPRESS_TYPE_LZ4, false, lz4_input, lz4_input_size,
+			      CONFIG_NRF_COMPRESS_CHUNK_SIZE, sizeof(corpus), output_data,
+			      sizeof(output_data));
+		zassert_equal(size, sizeof(corpus), "Expected decompressed size to match");
+	}
+
+	ns = benchmark_time_ns() - start;
+
+	zassert_mem_equal(output_data, corpus, sizeof(corpus), "Expected data to match");
+	report("LZ4 decompression", BENCHMARK_ROUNDS * sizeof(corpus), ns, "buffer RAM",
+	       NRF_COMPRESS_LZ4_DECOMPRESS_MEMORY_SIZE);
+}
+
+ZTEST_SUITE(nrf_compress_benchmark, NULL, benchmark_setup, NULL, NULL, NULL);
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <nrf_compress/implementation.h>
+#include <nrf_compress/lz4.h>
+
+#define INCOMPRESSIBLE_SIZE (2 * CONFIG_NRF_COMPRESS_LZ4_BLOCK_SIZE + 1000)
+#define BLOCK_UNCOMPRESSED  BIT(31)
+
+/* Uncompressed test data */
+static const uint8_t dummy_data[] = {
+#include "dummy_data_input.inc"
+};
+
+/* Frame of dummy_data compressed with the lz4 tool */
+static const uint8_t dummy_data_lz4[] = {
+#include "dummy_data_input_lz4.inc"
+};
+
+/* Frame of dummy_data compressed with the lz4 tool, with the content size field */
+static const uint8_t dummy_data_content_size_lz4[] = {
+#include "dummy_data_input_content_size_lz4.inc"
+};
+
+/* Frame with a single block, holding a literal followed by a match beyond the start of the data */
+static const uint8_t invalid_match_offset_lz4[] = {
+	0x04, 0x22, 0x4d, 0x18, 0x60, 0x40, 0x82,
+	0x04, 0x00, 0x00, 0x00,
+	0x10, 'a', 0x02, 0x00,
+	0x00, 0x00, 0x00, 0x00
+};
+
+static uint8_t frame[NRF_COMPRESS_LZ4_COMPRESS_BOUND(INCOMPRESSIBLE_SIZE)];
+static uint8_t output_data[INCOMPRESSIBLE_SIZE];
+static uint8_t incompressible_data[INCOMPRESSIBLE_SIZE];
+
+static struct nrf_compress_implementation *lz4_implementation_get(void)
+{
+	struct nrf_compress_implementation *implementation;
+
+	implementation = nrf_compress_implementation_find(NRF_COMPRESS_TYPE_LZ4);
+	zassert_not_null(implementation, "Expected implementation to not be NULL");
+
+	return implementation;
+}
+
+static int frame_compress(const uint8_t *input, size_t input_size, size_t chunk_size,
+			  uint8_t *output, size_t output_capacity, size_t *output_size)
+{
+	struct nrf_compress_implementation *implementation = lz4_implementation_get();
+	size_t pos = 0;
+	uint32_t offset;
+	uint8_t *data;
+	size_t data_size;
+	bool last_part;
+	int rc;
+
+	*output_size = 0;
+
+	rc = implementation->init(NULL, 0);
+	zassert_ok(rc, "Expected init to be successful");
+
+	do {
+		size_t size = MIN(chunk_size, input_size - pos);
+
+		last_part = (pos + size) == input_size;
+
+		rc = implementation->compress(NULL, &input[pos], size, last_part, &offset, &data,
+					      &data_size);
+
+		if (rc) {
+			break;
+		}
+
+		zassert_true(*output_size + data_size <= output_capacity,
+			     "Expected output to fit in the buffer");
+		memcpy(&output[*output_size], data, data_size);
+		*output_size += data_size;
+		pos += offset;
+	} while (pos < input_size);
+
+	zassert_ok(implementation->deinit(NULL), "Expected deinit to be successful");
+
+	return rc;
+}
+
+/* A chunk size of 0 provides the amount of data requested by the implementation */
+static int frame_decompress(const uint8_t *input, size_t input_size, size_t chunk_size,
+			    size_t decompressed_size, size_t *output_size)
+{
+	struct nrf_compress_implementation *implementation = lz4_implementation_get();
+	size_t pos = 0;
+	uint32_t offset;
+	uint8_t *data;
+	size_t data_size;
+	bool last_part;
+	int rc;
+
+	*output_size = 0;
+
+	rc = implementation->init(NULL, decompressed_size);
+	zassert_ok(rc, "Expected init to be successful");
+
+	while (pos < input_size) {
+		size_t size = chunk_size != 0 ? chunk_size :
+						implementation->decompress_bytes_needed(NULL);
+
+		size = MIN(size, input_size - pos);
+		last_part = (pos + size) == input_size;
+
+		rc = implementation->decompress(NULL, &input[pos], size, last_part, &offset,
+						&data, &data_size);
+
+		if (rc) {
+			break;
+		}
+
+		zassert_true(*output_size + data_size <= sizeof(output_data),
+			     "Expected output to fit in the buffer");
+		memcpy(&output_data[*output_size], data, data_size);
+		*output_size += data_size;
+		pos += offset;
+	}
+
+	zassert_ok(implementation->deinit(NULL), "Expected deinit to be successful");
+
+	return rc;
+}
+
+ZTEST(nrf_compress_lz4, test_fixed_vector)
+{
+	const size_t chunk_sizes[] = {0, 1, 7, CONFIG_NRF_COMPRESS_CHUNK_SIZE,
+				      sizeof(dummy_data_lz4)};
+	size_t size;
+	int rc;
+
+	for (size_t i = 0; i < ARRAY_SIZE(chunk_sizes); i++) {
+		memset(output_data, 0, sizeof(output_data));
+
+		rc = frame_decompress(dummy_data_lz4, sizeof(dummy_data_lz4), chunk_sizes[i], 0,
+				      &size);
+		zassert_ok(rc, "Expected decompression to be successful");
+		zassert_equal(size, sizeof(dummy_data), "Expected decompressed size to match");
+		zassert_mem_equal(output_data, dummy_data, sizeof(dummy_data),
+				  "Expected data to match with %zu byte chunks", chunk_sizes[i]);
+	}
+}
+
+ZTEST(nrf_compress_lz4, test_content_size)
+{
+	size_t size;
+	int rc;
+
+	rc = frame_decompress(dummy_data_content_size_lz4, sizeof(dummy_data_content_size_lz4),
+			      CONFIG_NRF_COMPRESS_CHUNK_SIZE, sizeof(dummy_data), &size);
+	zassert_ok(rc, "Expected decompression to be successful");
+	zassert_equal(size, sizeof(dummy_data), "Expected decompressed size to match");
+	zassert_mem_equal(output_data, dummy_data, sizeof(dummy_data), "Expected data to match");
+
+	/* Output beyond the expected decompressed size is rejected */
+	rc = frame_decompress(dummy_data_content_size_lz4, sizeof(dummy_data_content_size_lz4),
+			      CONFIG_NRF_COMPRESS_CHUNK_SIZE, sizeof(dummy_data) - 1, &size);
+	zassert_equal(rc, -EINVAL, "Expected decompression to fail");
+}
+
+ZTEST(nrf_compress_lz4, test_round_trip)
+{
+	size_t frame_size;
+	size_t size;
+	int rc;
+
+	rc = frame_compress(dummy_data, sizeof(dummy_data), 100, frame, sizeof(frame), &frame_size);
+	zassert_ok(rc, "Expected compression to be successful");
+	zassert_true(frame_size < sizeof(dummy_data), "Expected data to be compressed");
+
+	rc = frame_decompress(frame, frame_size, CONFIG_NRF_COMPRESS_CHUNK_SIZE, sizeof(dummy_data),
+			      &size);
+	zassert_ok(rc, "Expected decompression to be successful");
+	zassert_equal(size, sizeof(dummy_data), "Expected decompressed size to match");
+	zassert_mem_equal(output_data, dummy_data, sizeof(dummy_data), "Expected data to match");
+}
+
+ZTEST(nrf_compress_lz4, test_incompressible)
+{
+	uint32_t state = 0x12345678;
+	size_t frame_size;
+	size_t pos;
+	size_t size;
+	int rc;
+
+	/* Xorshift sequence, which has no repetitions for the compressor to find */
+	for (size_t i = 0; i < sizeof(incompressible_data); i++) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		incompressible_data[i] = (uint8_t)state;
+	}
+
+	rc = frame_compress(incompressible_data, sizeof(incompressible_data),
+			    CONFIG_NRF_COMPRESS_CHUNK_SIZE, frame, sizeof(frame), &frame_size);
+	zassert_ok(rc, "Expected compression to be successful");
+	zassert_equal(frame_size, NRF_COMPRESS_LZ4_COMPRESS_BOUND(sizeof(incompressible_data)),
+		      "Expected the worst case compressed size");
+
+	/* All blocks are stored uncompressed */
+	pos = NRF_COMPRESS_LZ4_FRAME_HEADER_SIZE;
+
+	while (sys_get_le32(&frame[pos]) != 0) {
+		uint32_t block_size = sys_get_le32(&frame[pos]);
+
+		zassert_true(block_size & BLOCK_UNCOMPRESSED, "Expected an uncompressed block");
+		pos += NRF_COMPRESS_LZ4_BLOCK_HEADER_SIZE + (block_size & ~BLOCK_UNCOMPRESSED);
+		zassert_true(pos < frame_size, "Expected block to be within the frame");
+	}
+
+	zassert_equal(pos + NRF_COMPRESS_LZ4_END_MARK_SIZE, frame_size,
+		      "Expected end mark at the end of the frame");
+
+	rc = frame_decompress(frame, frame_size, CONFIG_NRF_COMPRESS_CHUNK_SIZE,
+			      sizeof(incompressible_data), &size);
+	zassert_ok(rc, "Expected decompression to be successful");
+	zassert_equal(size, sizeof(incompressible_data), "Expected decompressed size to match");
+	zassert_mem_equal(output_data, incompressible_data, sizeof(incompressible_data),
+			  "Expected data to match");
+}
+
+ZTEST(nrf_compress_lz4, test_corrupt_frames)
+{
+	size_t size;
+	int rc;
+
+	/* Magic number */
+	memcpy(frame, dummy_data_lz4, sizeof(dummy_data_lz4));
+	frame[0] ^= 0x01;
+	rc = frame_decompress(frame, sizeof(dummy_data_lz4), 0, 0, &size);
+	zassert_equal(rc, -EINVAL, "Expected invalid magic number to fail");
+
+	/* Header checksum */
+	memcpy(frame, dummy_data_lz4, sizeof(dummy_data_lz4));
+	frame[NRF_COMPRESS_LZ4_FRAME_HEADER_SIZE - 1] ^= 0x01;
+	rc = frame_decompress(frame, sizeof(dummy_data_lz4), 0, 0, &size);
+	zassert_equal(rc, -EINVAL, "Expected invalid header checksum to fail");
+
+	/* Block checksums are not supported */
+	memcpy(frame, dummy_data_lz4, sizeof(dummy_data_lz4));
+	frame[4] |= BIT(4);
+	rc = frame_decompress(frame, sizeof(dummy_data_lz4), 0, 0, &size);
+	zassert_equal(rc, -ENOTSUP, "Expected block checksum flag to fail");
+
+	/* Block larger than the supported block size */
+	memcpy(frame, dummy_data_lz4, sizeof(dummy_data_lz4));
+	sys_put_le32(CONFIG_NRF_COMPRESS_LZ4_BLOCK_SIZE + 1,
+		     &frame[NRF_COMPRESS_LZ4_FRAME_HEADER_SIZE]);
+	rc = frame_decompress(frame, sizeof(dummy_data_lz4), 0, 0, &size);
+	zassert_equal(rc, -EINVAL, "Expected oversized block to fail");
+
+	/* Match before the start of the decompressed data */
+	rc = frame_decompress(invalid_match_offset_lz4, sizeof(invalid_match_offset_lz4), 0, 0,
+			      &size);
+	zassert_equal(rc, -EINVAL, "Expected invalid match offset to fail");
+}
+
+ZTEST(nrf_compress_lz4, test_truncated_frames)
+{
+	size_t size;
+	int rc;
+
+	/* Missing end mark */
+	rc = frame_decompress(dummy_data_lz4,
+			      sizeof(dummy_data_lz4) - NRF_COMPRESS_LZ4_END_MARK_SIZE,
+			      CONFIG_NRF_COMPRESS_CHUNK_SIZE, 0, &size);
+	zassert_equal(rc, -EINVAL, "Expected missing end mark to fail");
+
+	/* Frame ending within a block */
+	rc = frame_decompress(dummy_data_lz4, sizeof(dummy_data_lz4) / 2,
+			      CONFIG_NRF_COMPRESS_CHUNK_SIZE, 0, &size);
+	zassert_equal(rc, -EINVAL, "Expected truncated block to fail");
+
+	/* Frame ending within the header */
+	rc = frame_decompress(dummy_data_lz4, NRF_COMPRESS_LZ4_FRAME_HEADER_SIZE - 1, 0, 0, &size);
+	zassert_equal(rc, -EINVAL, "Expected truncated header to fail");
+}
+
+ZTEST_SUITE(nrf_compress_lz4, NULL, NULL, NULL, NULL, NULL);
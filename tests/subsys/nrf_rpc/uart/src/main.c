@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <nrf_rpc/nrf_rpc_uart.h>
+
+#include <zephyr/drivers/uart.h>
+#include <zephyr/drivers/serial/uart_emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define UART_A_NODE DT_NODELABEL(uart_a)
+#define UART_B_NODE DT_NODELABEL(uart_b)
+#define UART_C_NODE DT_NODELABEL(uart_c)
+
+#define PACKET_SIZE	64
+#define CALL_CNT	1000
+#define PIPELINED_CNT	200
+#define RESTART_CALL_CNT 20
+#define RESPONSE_TIMEOUT K_MSEC(1000)
+
+static const struct device *const uart_a = DEVICE_DT_GET(UART_A_NODE);
+static const struct device *const uart_b = DEVICE_DT_GET(UART_B_NODE);
+static const struct device *const uart_c = DEVICE_DT_GET(UART_C_NODE);
+static const struct nrf_rpc_tr *const tr_a = &NRF_RPC_UART_TRANSPORT(UART_A_NODE);
+static const struct nrf_rpc_tr *const tr_b = &NRF_RPC_UART_TRANSPORT(UART_B_NODE);
+
+/* UART connected with the first one, replaced when the peer restarts. */
+static atomic_ptr_t peer_a = ATOMIC_PTR_INIT((void *)DEVICE_DT_GET(UART_B_NODE));
+static const struct nrf_rpc_tr *tr_peer = &NRF_RPC_UART_TRANSPORT(UART_B_NODE);
+
+static K_SEM_DEFINE(response_sem, 0, PIPELINED_CNT);
+static uint32_t response_cnt;
+static uint32_t response_errors;
+static atomic_t corrupt_next;
+static atomic_t drop_all;
+
+/* Moves data sent by one UART to the receiver of the other one. */
+static void tx_data_ready(const struct device *dev, size_t size, void *user_data)
+{
+	const struct device *peer = dev == uart_a ? atomic_ptr_get(&peer_a) : user_data;
+	uint8_t buf[64];
+	uint32_t len;
+
+	while ((len = uart_emul_get_tx_data(dev, buf, sizeof(buf))) > 0) {
+		/* The peer replaced after the restart no longer exists. */
+		if (dev != uart_a && dev != atomic_ptr_get(&peer_a)) {
+			continue;
+		}
+
+		if (dev == uart_a && atomic_get(&drop_all)) {
+			continue;
+		}
+
+		/* Skip short chunks to corrupt a packet rather than an ack. */
+		if (dev == uart_a && len >= 16 && atomic_cas(&corrupt_next, 1, 0)) {
+			buf[len / 2] ^= 0x01;
+		}
+
+		uart_emul_put_rx_data(peer, buf, len);
+	}
+}
+
+static void packet_fill(uint8_t *data, uint32_t id)
+{
+	for (size_t i = 0; i < PACKET_SIZE; i++) {
+		data[i] = (uint8_t)(id + i);
+	}
+}
+
+static int packet_send(const struct nrf_rpc_tr *tr, const uint8_t *packet, size_t len)
+{
+	size_t size = len;
+	uint8_t *buf = tr->api->tx_buf_alloc(tr, &size);
+
+	zassert_not_null(buf);
+	memcpy(buf, packet, len);
+
+	return tr->api->send(tr, buf, len);
+}
+
+static int request_send(uint32_t id)
+{
+	uint8_t packet[PACKET_SIZE];
+
+	packet_fill(packet, id);
+
+	return packet_send(tr_a, packet, sizeof(packet));
+}
+
+/* Responder side: echo every packet back. */
+static void receive_b(const struct nrf_rpc_tr *transport, const uint8_t *packet, size_t len,
+		      void *context)
+{
+	zassert_ok(packet_send(transport, packet, len));
+}
+
+/* Requester side: check that the responses come back in order. */
+static void receive_a(const struct nrf_rpc_tr *transport, const uint8_t *packet, size_t len,
+		      void *context)
+{
+	uint8_t expected[PACKET_SIZE];
+
+	packet_fill(expected, response_cnt++);
+
+	if (len != sizeof(expected) || memcmp(packet, expected, len) != 0) {
+		response_errors++;
+	}
+
+	k_sem_give(&response_sem);
+}
+
+static void *uart_setup(void)
+{
+	zassert_true(device_is_ready(uart_a));
+	zassert_true(device_is_ready(uart_b));
+	zassert_true(device_is_ready(uart_c));
+
+	uart_emul_callback_tx_data_ready_set(uart_a, tx_data_ready, NULL);
+	uart_emul_callback_tx_data_ready_set(uart_b, tx_data_ready, (void *)uart_a);
+	uart_emul_callback_tx_data_ready_set(uart_c, tx_data_ready, (void *)uart_a);
+
+	zassert_ok(tr_a->api->init(tr_a, receive_a, NULL));
+	zassert_ok(tr_b->api->init(tr_b, receive_b, NULL));
+
+	return NULL;
+}
+
+static void uart_before(void *fixture)
+{
+	struct nrf_rpc_uart_stats stats;
+
+	ARG_UNUSED(fixture);
+
+	k_sem_reset(&response_sem);
+	response_cnt = 0;
+	response_errors = 0;
+	atomic_set(&corrupt_next, 0);
+	atomic_set(&drop_all, 0);
+
+	zassert_ok(nrf_rpc_uart_stats_get(tr_a, &stats, true));
+	zassert_ok(nrf_rpc_uart_stats_get(tr_peer, &stats, true));
+}
+
+ZTEST(nrf_rpc_uart, test_calls_per_second)
+{
+	struct nrf_rpc_uart_stats stats;
+	int64_t start = k_uptime_get();
+	int64_t duration;
+
+	for (uint32_t i = 0; i < CALL_CNT; i++) {
+		zassert_ok(request_send(i));
+		zassert_ok(k_sem_take(&response_sem, RESPONSE_TIMEOUT), "No response to call %u", i);
+	}
+
+	duration = MAX(k_uptime_get() - start, 1);
+
+	zassert_equal(response_errors, 0, "Invalid responses received");
+
+	zassert_ok(nrf_rpc_uart_stats_get(tr_a, &stats, false));
+	zassert_equal(stats.tx_frames, CALL_CNT);
+	zassert_equal(stats.tx_bytes, CALL_CNT * PACKET_SIZE);
+	zassert_equal(stats.rx_frames, CALL_CNT);
+	zassert_equal(stats.crc_errors, 0);
+
+	printk("%u calls in %lld ms, %lld calls/s\n", CALL_CNT, duration,
+	       CALL_CNT * MSEC_PER_SEC / duration);
+}
+
+ZTEST(nrf_rpc_uart, test_pipelined_calls)
+{
+	int64_t start = k_uptime_get();
+	int64_t duration;
+
+	for (uint32_t i = 0; i < PIPELINED_CNT; i++) {
+		zassert_ok(request_send(i));
+	}
+
+	for (uint32_t i = 0; i < PIPELINED_CNT; i++) {
+		zassert_ok(k_sem_take(&response_sem, RESPONSE_TIMEOUT), "No response to call %u", i);
+	}
+
+	duration = MAX(k_uptime_get() - start, 1);
+
+	zassert_equal(response_errors, 0, "Responses out of order or invalid");
+
+	printk("%u pipelined calls in %lld ms, %lld calls/s\n", PIPELINED_CNT, duration,
+	       PIPELINED_CNT * MSEC_PER_SEC / duration);
+}
+
+#if CONFIG_NRF_RPC_UART_RELIABLE
+ZTEST(nrf_rpc_uart, test_retransmit)
+{
+	struct nrf_rpc_uart_stats stats_a;
+	struct nrf_rpc_uart_stats stats_b;
+
+	atomic_set(&corrupt_next, 1);
+
+	for (uint32_t i = 0; i < CONFIG_NRF_RPC_UART_WINDOW_SIZE + 1; i++) {
+		zassert_ok(request_send(i));
+	}
+
+	for (uint32_t i = 0; i < CONFIG_NRF_RPC_UART_WINDOW_SIZE + 1; i++) {
+		zassert_ok(k_sem_take(&response_sem, RESPONSE_TIMEOUT), "No response to call %u", i);
+	}
+
+	zassert_equal(response_errors, 0, "Responses out of order or invalid");
+
+	zassert_ok(nrf_rpc_uart_stats_get(tr_a, &stats_a, false));
+	zassert_ok(nrf_rpc_uart_stats_get(tr_peer, &stats_b, false));
+
+	zassert_true(stats_b.crc_errors > 0, "Packet not corrupted");
+	zassert_true(stats_a.retransmits > 0, "Corrupted packet not retransmitted");
+	zassert_equal(stats_a.tx_failures, 0);
+	zassert_equal(stats_b.rx_frames, CONFIG_NRF_RPC_UART_WINDOW_SIZE + 1);
+}
+
+ZTEST(nrf_rpc_uart, test_tx_failure)
+{
+	struct nrf_rpc_uart_stats stats;
+
+	/* The peer never receives the packet, so it is not acknowledged. */
+	atomic_set(&drop_all, 1);
+
+	zassert_ok(request_send(0));
+
+	k_sleep(K_MSEC(CONFIG_NRF_RPC_UART_ACK_WAITING_TIME * (CONFIG_NRF_RPC_UART_TX_ATTEMPTS + 1)));
+
+	zassert_ok(nrf_rpc_uart_stats_get(tr_a, &stats, false));
+	zassert_equal(stats.retransmits, CONFIG_NRF_RPC_UART_TX_ATTEMPTS - 1);
+	zassert_equal(stats.tx_failures, 1, "Lost packet not reported");
+
+	/* The window slot of the lost packet is released. */
+	atomic_set(&drop_all, 0);
+
+	for (uint32_t i = 0; i < CONFIG_NRF_RPC_UART_WINDOW_SIZE; i++) {
+		zassert_ok(request_send(i));
+	}
+
+	for (uint32_t i = 0; i < CONFIG_NRF_RPC_UART_WINDOW_SIZE; i++) {
+		zassert_ok(k_sem_take(&response_sem, RESPONSE_TIMEOUT), "No response to call %u", i);
+	}
+
+	zassert_equal(response_errors, 0, "Responses out of order or invalid");
+}
+
+ZTEST(nrf_rpc_uart, test_peer_restart)
+{
+	struct nrf_rpc_uart_stats stats_a;
+	struct nrf_rpc_uart_stats stats_c;
+	const struct nrf_rpc_tr *tr_c = &NRF_RPC_UART_TRANSPORT(UART_C_NODE);
+	uint32_t id = 0;
+
+	/* Move the sequence numbers of both sides away from the initial values. */
+	for (; id < RESTART_CALL_CNT; id++) {
+		zassert_ok(request_send(id));
+		zassert_ok(k_sem_take(&response_sem, RESPONSE_TIMEOUT), "No response to call %u", id);
+	}
+
+	/* The peer goes down, so the requests sent in the meantime are not acknowledged. */
+	atomic_set(&drop_all, 1);
+
+	for (; id < RESTART_CALL_CNT + CONFIG_NRF_RPC_UART_WINDOW_SIZE; id++) {
+		zassert_ok(request_send(id));
+	}
+
+	/* The peer starts over with a transport instance that has no state of the previous one. */
+	atomic_ptr_set(&peer_a, (void *)uart_c);
+	tr_peer = tr_c;
+	atomic_set(&drop_all, 0);
+
+	zassert_ok(tr_c->api->init(tr_c, receive_b, NULL));
+
+	for (; id < 2 * RESTART_CALL_CNT + CONFIG_NRF_RPC_UART_WINDOW_SIZE; id++) {
+		zassert_ok(request_send(id));
+	}
+
+	for (uint32_t i = RESTART_CALL_CNT; i < id; i++) {
+		zassert_ok(k_sem_take(&response_sem, RESPONSE_TIMEOUT), "No response to call %u", i);
+	}
+
+	zassert_equal(response_errors, 0, "Responses lost, out of order or invalid");
+
+	zassert_ok(nrf_rpc_uart_stats_get(tr_a, &stats_a, false));
+	zassert_ok(nrf_rpc_uart_stats_get(tr_c, &stats_c, false));
+
+	zassert_equal(stats_a.tx_failures, 0);
+	zassert_equal(stats_c.rx_frames, id - RESTART_CALL_CNT, "Requests lost or duplicated");
+}
+#endif /* CONFIG_NRF_RPC_UART_RELIABLE */
+
+ZTEST_SUITE(nrf_rpc_uart, NULL, uart_setup, uart_before, NULL, NULL);